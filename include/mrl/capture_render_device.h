@@ -0,0 +1,269 @@
+#ifndef MRL_CAPTURE_RENDER_DEVICE_H
+#define MRL_CAPTURE_RENDER_DEVICE_H
+#ifdef __cplusplus
+extern "C" {
+#endif 
+
+#include <mrl/render_device.h>
+
+	// ------- Trace format -------
+
+#define MRL_TRACE_MAGIC "MRLT"
+#define MRL_TRACE_VERSION 1
+
+	/// <summary>
+	///		Opcodes of the records stored in trace files.
+	///		A trace starts with a 16 byte header: the magic MRL_TRACE_MAGIC, a u32 version (MRL_TRACE_VERSION) and 8 reserved bytes.
+	///		It is followed by records, each made of:
+	///		- A 16 byte record header: a u32 opcode, a u32 argument count and a u64 payload size;
+	///		- The arguments, as u64 values, in the same order as the parameters of the render device function;
+	///		- The payload bytes, padded with zeros to a multiple of 8 bytes.
+	///		Every field is stored in host byte order and is 8 byte aligned, so traces can be replayed in place from mapped memory.
+	///		Arguments are encoded as follows:
+	///		- Signed integers are sign extended, and floats are stored as their 32-bit pattern;
+	///		- Object handles and binding points are stored as IDs, unique during the capture (0 is NULL);
+	///		- Descriptions are stored as their members, with handles replaced by IDs, and hint lists are dropped;
+	///		- Vertex array elements are stored as their type, size, stride, offset and buffer index, followed by the instance step rates of every element;
+	///		- Framebuffers store the ID of their depth stencil texture array and its layer after the render targets;
+	///		- Create functions store the ID of the created object first, and get_shader_binding_point functions store the ID of the result after the pipeline.
+	///		Payloads hold the data referenced by the call:
+	///		- Initial texture data and texture updates store the texels of every mip level (and face or layer), tightly packed;
+	///		- Uploads through upload queues are stored as the equivalent texture updates, and upload queues aren't stored;
+	///		- Initial buffer data and buffer updates store the written bytes;
+	///		- Buffer unmaps store the contents of the mapped range, and explicit flushes store the flushed bytes;
+	///		- Stream allocation unmaps store the contents of the allocation;
+	///		- Shader stages store their source string, and get_shader_binding_point stores the binding point name;
+	///		- Vertex arrays store the names of their elements, MRL_MAX_VERTEX_ELEMENT_NAME_SIZE bytes each;
+	///		- Multi draws store their offset and count arrays, followed by the base vertex array if there is one, as u64 values.
+	/// </summary>
+	enum
+	{
+		MRL_CAPTURE_COMMAND_CREATE_FRAMEBUFFER,
+		MRL_CAPTURE_COMMAND_DESTROY_FRAMEBUFFER,
+		MRL_CAPTURE_COMMAND_SET_FRAMEBUFFER,
+		MRL_CAPTURE_COMMAND_CREATE_RASTER_STATE,
+		MRL_CAPTURE_COMMAND_DESTROY_RASTER_STATE,
+		MRL_CAPTURE_COMMAND_SET_RASTER_STATE,
+		MRL_CAPTURE_COMMAND_CREATE_DEPTH_STENCIL_STATE,
+		MRL_CAPTURE_COMMAND_DESTROY_DEPTH_STENCIL_STATE,
+		MRL_CAPTURE_COMMAND_SET_DEPTH_STENCIL_STATE,
+		MRL_CAPTURE_COMMAND_CREATE_BLEND_STATE,
+		MRL_CAPTURE_COMMAND_DESTROY_BLEND_STATE,
+		MRL_CAPTURE_COMMAND_SET_BLEND_STATE,
+		MRL_CAPTURE_COMMAND_CREATE_SAMPLER,
+		MRL_CAPTURE_COMMAND_DESTROY_SAMPLER,
+		MRL_CAPTURE_COMMAND_BIND_SAMPLER,
+		MRL_CAPTURE_COMMAND_CREATE_TEXTURE_1D,
+		MRL_CAPTURE_COMMAND_DESTROY_TEXTURE_1D,
+		MRL_CAPTURE_COMMAND_GENERATE_TEXTURE_1D_MIPMAPS,
+		MRL_CAPTURE_COMMAND_BIND_TEXTURE_1D,
+		MRL_CAPTURE_COMMAND_UPDATE_TEXTURE_1D,
+		MRL_CAPTURE_COMMAND_CREATE_TEXTURE_2D,
+		MRL_CAPTURE_COMMAND_DESTROY_TEXTURE_2D,
+		MRL_CAPTURE_COMMAND_GENERATE_TEXTURE_2D_MIPMAPS,
+		MRL_CAPTURE_COMMAND_BIND_TEXTURE_2D,
+		MRL_CAPTURE_COMMAND_UPDATE_TEXTURE_2D,
+		MRL_CAPTURE_COMMAND_CREATE_TEXTURE_3D,
+		MRL_CAPTURE_COMMAND_DESTROY_TEXTURE_3D,
+		MRL_CAPTURE_COMMAND_GENERATE_TEXTURE_3D_MIPMAPS,
+		MRL_CAPTURE_COMMAND_BIND_TEXTURE_3D,
+		MRL_CAPTURE_COMMAND_UPDATE_TEXTURE_3D,
+		MRL_CAPTURE_COMMAND_CREATE_CUBE_MAP,
+		MRL_CAPTURE_COMMAND_DESTROY_CUBE_MAP,
+		MRL_CAPTURE_COMMAND_GENERATE_CUBE_MAP_MIPMAPS,
+		MRL_CAPTURE_COMMAND_BIND_CUBE_MAP,
+		MRL_CAPTURE_COMMAND_UPDATE_CUBE_MAP,
+		MRL_CAPTURE_COMMAND_CREATE_CONSTANT_BUFFER,
+		MRL_CAPTURE_COMMAND_DESTROY_CONSTANT_BUFFER,
+		MRL_CAPTURE_COMMAND_BIND_CONSTANT_BUFFER,
+		MRL_CAPTURE_COMMAND_BIND_CONSTANT_BUFFER_RANGE,
+		MRL_CAPTURE_COMMAND_MAP_CONSTANT_BUFFER,
+		MRL_CAPTURE_COMMAND_UNMAP_CONSTANT_BUFFER,
+		MRL_CAPTURE_COMMAND_MAP_CONSTANT_BUFFER_RANGE,
+		MRL_CAPTURE_COMMAND_FLUSH_CONSTANT_BUFFER_RANGE,
+		MRL_CAPTURE_COMMAND_UPDATE_CONSTANT_BUFFER,
+		MRL_CAPTURE_COMMAND_QUERY_CONSTANT_BUFFER_STRUCTURE,
+		MRL_CAPTURE_COMMAND_CREATE_INDEX_BUFFER,
+		MRL_CAPTURE_COMMAND_DESTROY_INDEX_BUFFER,
+		MRL_CAPTURE_COMMAND_SET_INDEX_BUFFER,
+		MRL_CAPTURE_COMMAND_MAP_INDEX_BUFFER,
+		MRL_CAPTURE_COMMAND_UNMAP_INDEX_BUFFER,
+		MRL_CAPTURE_COMMAND_MAP_INDEX_BUFFER_RANGE,
+		MRL_CAPTURE_COMMAND_FLUSH_INDEX_BUFFER_RANGE,
+		MRL_CAPTURE_COMMAND_UPDATE_INDEX_BUFFER,
+		MRL_CAPTURE_COMMAND_CREATE_VERTEX_BUFFER,
+		MRL_CAPTURE_COMMAND_DESTROY_VERTEX_BUFFER,
+		MRL_CAPTURE_COMMAND_MAP_VERTEX_BUFFER,
+		MRL_CAPTURE_COMMAND_UNMAP_VERTEX_BUFFER,
+		MRL_CAPTURE_COMMAND_MAP_VERTEX_BUFFER_RANGE,
+		MRL_CAPTURE_COMMAND_FLUSH_VERTEX_BUFFER_RANGE,
+		MRL_CAPTURE_COMMAND_UPDATE_VERTEX_BUFFER,
+		MRL_CAPTURE_COMMAND_CREATE_VERTEX_ARRAY,
+		MRL_CAPTURE_COMMAND_DESTROY_VERTEX_ARRAY,
+		MRL_CAPTURE_COMMAND_SET_VERTEX_ARRAY,
+		MRL_CAPTURE_COMMAND_CREATE_STREAM_ALLOCATOR,
+		MRL_CAPTURE_COMMAND_DESTROY_STREAM_ALLOCATOR,
+		MRL_CAPTURE_COMMAND_MAP_STREAM_ALLOCATION,
+		MRL_CAPTURE_COMMAND_UNMAP_STREAM_ALLOCATION,
+		MRL_CAPTURE_COMMAND_END_STREAM_ALLOCATOR_FRAME,
+		MRL_CAPTURE_COMMAND_CREATE_SHADER_STAGE,
+		MRL_CAPTURE_COMMAND_DESTROY_SHADER_STAGE,
+		MRL_CAPTURE_COMMAND_CREATE_SHADER_PIPELINE,
+		MRL_CAPTURE_COMMAND_DESTROY_SHADER_PIPELINE,
+		MRL_CAPTURE_COMMAND_SET_SHADER_PIPELINE,
+		MRL_CAPTURE_COMMAND_GET_SHADER_BINDING_POINT,
+		MRL_CAPTURE_COMMAND_GET_SHADER_BINDING_POINT_BY_ID,
+		MRL_CAPTURE_COMMAND_CLEAR_COLOR,
+		MRL_CAPTURE_COMMAND_CLEAR_DEPTH,
+		MRL_CAPTURE_COMMAND_CLEAR_STENCIL,
+		MRL_CAPTURE_COMMAND_SWAP_BUFFERS,
+		MRL_CAPTURE_COMMAND_DRAW_TRIANGLES,
+		MRL_CAPTURE_COMMAND_DRAW_TRIANGLES_INDEXED,
+		MRL_CAPTURE_COMMAND_DRAW_TRIANGLES_INSTANCED,
+		MRL_CAPTURE_COMMAND_DRAW_TRIANGLES_INDEXED_INSTANCED,
+		MRL_CAPTURE_COMMAND_SET_VIEWPORT,
+		MRL_CAPTURE_COMMAND_CREATE_INDIRECT_BUFFER,
+		MRL_CAPTURE_COMMAND_DESTROY_INDIRECT_BUFFER,
+		MRL_CAPTURE_COMMAND_UPDATE_INDIRECT_BUFFER,
+		MRL_CAPTURE_COMMAND_MULTI_DRAW_TRIANGLES,
+		MRL_CAPTURE_COMMAND_MULTI_DRAW_TRIANGLES_INDEXED,
+		MRL_CAPTURE_COMMAND_DRAW_TRIANGLES_INDIRECT,
+		MRL_CAPTURE_COMMAND_DRAW_TRIANGLES_INDEXED_INDIRECT,
+		MRL_CAPTURE_COMMAND_DRAW_TRIANGLES_INDEXED_BASE_VERTEX,
+		MRL_CAPTURE_COMMAND_DRAW_TRIANGLES_INDEXED_INSTANCED_BASE_VERTEX,
+		MRL_CAPTURE_COMMAND_CREATE_TEXTURE_2D_ARRAY,
+		MRL_CAPTURE_COMMAND_DESTROY_TEXTURE_2D_ARRAY,
+		MRL_CAPTURE_COMMAND_GENERATE_TEXTURE_2D_ARRAY_MIPMAPS,
+		MRL_CAPTURE_COMMAND_BIND_TEXTURE_2D_ARRAY,
+		MRL_CAPTURE_COMMAND_UPDATE_TEXTURE_2D_ARRAY,
+		MRL_CAPTURE_COMMAND_CREATE_CUBE_MAP_ARRAY,
+		MRL_CAPTURE_COMMAND_DESTROY_CUBE_MAP_ARRAY,
+		MRL_CAPTURE_COMMAND_GENERATE_CUBE_MAP_ARRAY_MIPMAPS,
+		MRL_CAPTURE_COMMAND_BIND_CUBE_MAP_ARRAY,
+		MRL_CAPTURE_COMMAND_UPDATE_CUBE_MAP_ARRAY,
+	};
+
+	// ------- Capture render device -------
+
+	/// <summary>
+	///		Function called to write captured trace data.
+	///		Returns MRL_ERROR_NONE on success. If writing fails, the capture stops.
+	/// </summary>
+	typedef mrl_error_t(*mrl_capture_write_func_t)(void* user_data, const void* data, mgl_u64_t size);
+
+	typedef struct
+	{
+		/// <summary>
+		///		Render device which receives every call made to the capture render device.
+		///		Must be kept alive until the capture render device is terminated.
+		/// </summary>
+		mrl_render_device_t* target;
+
+		/// <summary>
+		///		Function which writes the trace (to a file, a socket, etc).
+		/// </summary>
+		mrl_capture_write_func_t write;
+
+		/// <summary>
+		///		User data passed to the write function.
+		/// </summary>
+		void* user_data;
+
+		/// <summary>
+		///		Size of the chunks in which trace data is buffered before being written.
+		///		The buffered data is also written on every swap_buffers call, so that the trace always ends on whole frames.
+		/// </summary>
+		mgl_u64_t buffer_size;
+	} mrl_capture_desc_t;
+
+#define MRL_DEFAULT_CAPTURE_DESC ((mrl_capture_desc_t) {\
+	NULL,\
+	NULL,\
+	NULL,\
+	1048576,\
+})
+
+	/// <summary>
+	///		Initializes a capture render device, which forwards every call to a target render device and writes it into a trace.
+	///		The trace can be replayed later against any render device with mrl_replay_trace.
+	///		Shader stages with binary or native sources (MRL_SHADER_SOURCE_SPIRV, MRL_SHADER_SOURCE_NATIVE) can't be captured.
+	///		The window of the render device description is ignored, since the target device already owns it.
+	///		The typename and properties reported are the ones of the target render device.
+	///		Hints with the device type 'capture' are also accepted.
+	/// </summary>
+	/// <param name="desc">Render device description</param>
+	/// <param name="capture">Capture description</param>
+	/// <param name="out_rd">Out render device pointer</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_init_capture_render_device(const mrl_render_device_desc_t* desc, const mrl_capture_desc_t* capture, mrl_render_device_t** out_rd);
+
+	/// <summary>
+	///		Terminates a capture render device, writing any buffered trace data.
+	///		The target render device isn't terminated.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	MRL_API void mrl_terminate_capture_render_device(mrl_render_device_t* rd);
+
+	/// <summary>
+	///		Writes any trace data buffered by a capture render device.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_flush_capture_render_device(mrl_render_device_t* rd);
+
+	// ------- Trace replay -------
+
+	/// <summary>
+	///		Function called by mrl_replay_trace after each replayed swap_buffers call.
+	/// </summary>
+	typedef void(*mrl_replay_frame_callback_t)(void* user_data, mgl_u64_t frame);
+
+	typedef struct
+	{
+		/// <summary>
+		///		Allocator used for the replay state.
+		/// </summary>
+		void* allocator;
+
+		/// <summary>
+		///		Function called after each frame.
+		///		Optional (can be NULL).
+		/// </summary>
+		mrl_replay_frame_callback_t frame_callback;
+
+		/// <summary>
+		///		Function called when the replay diverges from the capture, e.g. when an object fails to be created.
+		///		Commands which use an object that failed to be created are skipped.
+		///		Optional (can be NULL).
+		/// </summary>
+		mrl_render_device_hint_warning_callback_t warning_callback;
+
+		/// <summary>
+		///		User data passed to the frame callback.
+		/// </summary>
+		void* user_data;
+	} mrl_replay_desc_t;
+
+#define MRL_DEFAULT_REPLAY_DESC ((mrl_replay_desc_t) {\
+	NULL,\
+	NULL,\
+	NULL,\
+	NULL,\
+})
+
+	/// <summary>
+	///		Replays a trace against a render device, as fast as possible.
+	///		The trace is read in place, and must be 8 byte aligned.
+	///		Objects left alive by the trace are destroyed when the replay ends.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="data">Trace data</param>
+	/// <param name="size">Trace size in bytes</param>
+	/// <param name="desc">Replay description</param>
+	/// <returns>Error code (MRL_ERROR_INVALID_PARAMS if the trace is malformed)</returns>
+	MRL_API mrl_error_t mrl_replay_trace(mrl_render_device_t* rd, const void* data, mgl_u64_t size, const mrl_replay_desc_t* desc);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
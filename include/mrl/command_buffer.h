@@ -0,0 +1,387 @@
+#ifndef MRL_COMMAND_BUFFER_H
+#define MRL_COMMAND_BUFFER_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <mrl/pipeline_state.h>
+
+	typedef struct mrl_command_buffer_desc_t mrl_command_buffer_desc_t;
+
+	typedef void mrl_command_buffer_t;
+
+	// ---- Command buffer ----
+
+	struct mrl_command_buffer_desc_t
+	{
+		/// <summary>
+		///		Allocator used to allocate the command buffer and its memory chunks.
+		/// </summary>
+		void* allocator;
+
+		/// <summary>
+		///		Size in bytes of each memory chunk where commands are recorded.
+		///		Commands which don't fit in a single chunk get a dedicated chunk.
+		/// </summary>
+		mgl_u64_t chunk_size;
+	};
+
+#define MRL_DEFAULT_COMMAND_BUFFER_DESC ((mrl_command_buffer_desc_t) {\
+	NULL,\
+	64 * 1024,\
+})
+
+	// ------- Command buffer functions -------
+
+	/// <summary>
+	///		Creates a new command buffer.
+	///		Command buffers record commands into a linear memory arena, without touching any render device.
+	///		This means that different command buffers can be recorded on different threads at the same time.
+	///		The recorded commands are only executed when the command buffer is submitted to a render device.
+	/// </summary>
+	/// <param name="desc">Description</param>
+	/// <param name="cb">Out command buffer handle</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_create_command_buffer(const mrl_command_buffer_desc_t* desc, mrl_command_buffer_t** cb);
+
+	/// <summary>
+	///		Destroys a command buffer.
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	MRL_API void mrl_destroy_command_buffer(mrl_command_buffer_t* cb);
+
+	/// <summary>
+	///		Clears all of the commands recorded on a command buffer.
+	///		The memory chunks are kept, so recording again doesn't allocate any memory.
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	MRL_API void mrl_reset_command_buffer(mrl_command_buffer_t* cb);
+
+	/// <summary>
+	///		Gets the first error which occurred while recording commands into a command buffer.
+	///		Resetting the command buffer clears the error.
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_get_command_buffer_error(mrl_command_buffer_t* cb);
+
+	/// <summary>
+	///		Executes the commands recorded on a number of command buffers, in order.
+	///		This must be called on the thread which owns the render device.
+	///		Command buffers aren't reset after being submitted, so static command lists can be submitted again on later frames.
+	///		If any of the command buffers failed recording, nothing is executed and its error is returned.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="cbs">Command buffer handles</param>
+	/// <param name="count">Number of command buffers</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_submit_command_buffers(mrl_render_device_t* rd, mrl_command_buffer_t** cbs, mgl_u64_t count);
+
+	// ------- Recording functions -------
+
+	/// <summary>
+	///		Records a framebuffer set command (see mrl_set_framebuffer).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="fb">Framebuffer handle</param>
+	MRL_API void mrl_cmd_set_framebuffer(mrl_command_buffer_t* cb, mrl_framebuffer_t* fb);
+
+	/// <summary>
+	///		Records a raster state set command (see mrl_set_raster_state).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="s">Raster state handle</param>
+	MRL_API void mrl_cmd_set_raster_state(mrl_command_buffer_t* cb, mrl_raster_state_t* s);
+
+	/// <summary>
+	///		Records a depth stencil state set command (see mrl_set_depth_stencil_state).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="s">Depth stencil state handle</param>
+	MRL_API void mrl_cmd_set_depth_stencil_state(mrl_command_buffer_t* cb, mrl_depth_stencil_state_t* s);
+
+	/// <summary>
+	///		Records a blend state set command (see mrl_set_blend_state).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="s">Blend state handle</param>
+	MRL_API void mrl_cmd_set_blend_state(mrl_command_buffer_t* cb, mrl_blend_state_t* s);
+
+	/// <summary>
+	///		Records a sampler bind command (see mrl_bind_sampler).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="bp">Binding point</param>
+	/// <param name="s">Sampler handle</param>
+	MRL_API void mrl_cmd_bind_sampler(mrl_command_buffer_t* cb, mrl_shader_binding_point_t* bp, mrl_sampler_t* s);
+
+	/// <summary>
+	///		Records a texture 1D bind command (see mrl_bind_texture_1d).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="bp">Binding point</param>
+	/// <param name="tex">Texture 1D handle</param>
+	MRL_API void mrl_cmd_bind_texture_1d(mrl_command_buffer_t* cb, mrl_shader_binding_point_t* bp, mrl_texture_1d_t* tex);
+
+	/// <summary>
+	///		Records a texture 2D bind command (see mrl_bind_texture_2d).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="bp">Binding point</param>
+	/// <param name="tex">Texture 2D handle</param>
+	MRL_API void mrl_cmd_bind_texture_2d(mrl_command_buffer_t* cb, mrl_shader_binding_point_t* bp, mrl_texture_2d_t* tex);
+
+	/// <summary>
+	///		Records a texture 3D bind command (see mrl_bind_texture_3d).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="bp">Binding point</param>
+	/// <param name="tex">Texture 3D handle</param>
+	MRL_API void mrl_cmd_bind_texture_3d(mrl_command_buffer_t* cb, mrl_shader_binding_point_t* bp, mrl_texture_3d_t* tex);
+
+	/// <summary>
+	///		Records a cube map bind command (see mrl_bind_cube_map).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="bp">Binding point</param>
+	/// <param name="cm">Cube map handle</param>
+	MRL_API void mrl_cmd_bind_cube_map(mrl_command_buffer_t* cb, mrl_shader_binding_point_t* bp, mrl_cube_map_t* cm);
+
+	/// <summary>
+	///		Records a texture 2D array bind command (see mrl_bind_texture_2d_array).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="bp">Binding point</param>
+	/// <param name="tex">Texture 2D array handle</param>
+	MRL_API void mrl_cmd_bind_texture_2d_array(mrl_command_buffer_t* cb, mrl_shader_binding_point_t* bp, mrl_texture_2d_array_t* tex);
+
+	/// <summary>
+	///		Records a cube map array bind command (see mrl_bind_cube_map_array).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="bp">Binding point</param>
+	/// <param name="tex">Cube map array handle</param>
+	MRL_API void mrl_cmd_bind_cube_map_array(mrl_command_buffer_t* cb, mrl_shader_binding_point_t* bp, mrl_cube_map_array_t* tex);
+
+	/// <summary>
+	///		Records a constant buffer bind command (see mrl_bind_constant_buffer).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="bp">Binding point</param>
+	/// <param name="buf">Constant buffer handle</param>
+	MRL_API void mrl_cmd_bind_constant_buffer(mrl_command_buffer_t* cb, mrl_shader_binding_point_t* bp, mrl_constant_buffer_t* buf);
+
+	/// <summary>
+	///		Records a constant buffer range bind command (see mrl_bind_constant_buffer_range).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="bp">Binding point</param>
+	/// <param name="buf">Constant buffer handle</param>
+	/// <param name="offset">Range offset</param>
+	/// <param name="size">Range size</param>
+	MRL_API void mrl_cmd_bind_constant_buffer_range(mrl_command_buffer_t* cb, mrl_shader_binding_point_t* bp, mrl_constant_buffer_t* buf, mgl_u64_t offset, mgl_u64_t size);
+
+	/// <summary>
+	///		Records a constant buffer update command (see mrl_update_constant_buffer).
+	///		The data is copied into the command buffer.
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="buf">Constant buffer handle</param>
+	/// <param name="offset">Offset in bytes where the data will be written</param>
+	/// <param name="size">Data size in bytes</param>
+	/// <param name="data">Data</param>
+	MRL_API void mrl_cmd_update_constant_buffer(mrl_command_buffer_t* cb, mrl_constant_buffer_t* buf, mgl_u64_t offset, mgl_u64_t size, const void* data);
+
+	/// <summary>
+	///		Records an index buffer set command (see mrl_set_index_buffer).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="ib">Index buffer handle</param>
+	MRL_API void mrl_cmd_set_index_buffer(mrl_command_buffer_t* cb, mrl_index_buffer_t* ib);
+
+	/// <summary>
+	///		Records an index buffer update command (see mrl_update_index_buffer).
+	///		The data is copied into the command buffer.
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="ib">Index buffer handle</param>
+	/// <param name="offset">Offset in bytes where the data will be written</param>
+	/// <param name="size">Data size in bytes</param>
+	/// <param name="data">Data</param>
+	MRL_API void mrl_cmd_update_index_buffer(mrl_command_buffer_t* cb, mrl_index_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size, const void* data);
+
+	/// <summary>
+	///		Records an indirect buffer update command (see mrl_update_indirect_buffer).
+	///		The data is copied into the command buffer.
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="ib">Indirect buffer handle</param>
+	/// <param name="offset">Offset in bytes where the data will be written</param>
+	/// <param name="size">Data size in bytes</param>
+	/// <param name="data">Data</param>
+	MRL_API void mrl_cmd_update_indirect_buffer(mrl_command_buffer_t* cb, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size, const void* data);
+
+	/// <summary>
+	///		Records a vertex buffer update command (see mrl_update_vertex_buffer).
+	///		The data is copied into the command buffer.
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="vb">Vertex buffer handle</param>
+	/// <param name="offset">Offset in bytes where the data will be written</param>
+	/// <param name="size">Data size in bytes</param>
+	/// <param name="data">Data</param>
+	MRL_API void mrl_cmd_update_vertex_buffer(mrl_command_buffer_t* cb, mrl_vertex_buffer_t* vb, mgl_u64_t offset, mgl_u64_t size, const void* data);
+
+	/// <summary>
+	///		Records a vertex array set command (see mrl_set_vertex_array).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="va">Vertex array handle</param>
+	MRL_API void mrl_cmd_set_vertex_array(mrl_command_buffer_t* cb, mrl_vertex_array_t* va);
+
+	/// <summary>
+	///		Records a shader pipeline set command (see mrl_set_shader_pipeline).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="pipeline">Shader pipeline handle</param>
+	MRL_API void mrl_cmd_set_shader_pipeline(mrl_command_buffer_t* cb, mrl_shader_pipeline_t* pipeline);
+
+	/// <summary>
+	///		Records a pipeline state set command (see mrl_set_pipeline_state).
+	///		The states are only diffed against the last pipeline state when the command buffer is submitted.
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="cache">Pipeline state cache handle</param>
+	/// <param name="pso">Pipeline state handle</param>
+	MRL_API void mrl_cmd_set_pipeline_state(mrl_command_buffer_t* cb, mrl_pipeline_state_cache_t* cache, mrl_pipeline_state_t* pso);
+
+	/// <summary>
+	///		Records a color clear command (see mrl_clear_color).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="r">Red component</param>
+	/// <param name="g">Green component</param>
+	/// <param name="b">Blue component</param>
+	/// <param name="a">Alpha component</param>
+	MRL_API void mrl_cmd_clear_color(mrl_command_buffer_t* cb, mgl_f32_t r, mgl_f32_t g, mgl_f32_t b, mgl_f32_t a);
+
+	/// <summary>
+	///		Records a depth clear command (see mrl_clear_depth).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="depth">Depth value</param>
+	MRL_API void mrl_cmd_clear_depth(mrl_command_buffer_t* cb, mgl_f32_t depth);
+
+	/// <summary>
+	///		Records a stencil clear command (see mrl_clear_stencil).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="stencil">Stencil value</param>
+	MRL_API void mrl_cmd_clear_stencil(mrl_command_buffer_t* cb, mgl_i32_t stencil);
+
+	/// <summary>
+	///		Records a triangle draw command (see mrl_draw_triangles).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="offset">First vertex offset</param>
+	/// <param name="count">Number of vertexes to render</param>
+	MRL_API void mrl_cmd_draw_triangles(mrl_command_buffer_t* cb, mgl_u64_t offset, mgl_u64_t count);
+
+	/// <summary>
+	///		Records an indexed triangle draw command (see mrl_draw_triangles_indexed).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="offset">First index offset</param>
+	/// <param name="count">Number of indexes to render</param>
+	MRL_API void mrl_cmd_draw_triangles_indexed(mrl_command_buffer_t* cb, mgl_u64_t offset, mgl_u64_t count);
+
+	/// <summary>
+	///		Records an instanced triangle draw command (see mrl_draw_triangles_instanced).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="offset">First vertex offset</param>
+	/// <param name="count">Number of vertexes to render</param>
+	/// <param name="instance_count">Number of instances to render</param>
+	MRL_API void mrl_cmd_draw_triangles_instanced(mrl_command_buffer_t* cb, mgl_u64_t offset, mgl_u64_t count, mgl_u64_t instance_count);
+
+	/// <summary>
+	///		Records an indexed instanced triangle draw command (see mrl_draw_triangles_indexed_instanced).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="offset">First index offset</param>
+	/// <param name="count">Number of indexes to render</param>
+	/// <param name="instance_count">Number of instances to render</param>
+	MRL_API void mrl_cmd_draw_triangles_indexed_instanced(mrl_command_buffer_t* cb, mgl_u64_t offset, mgl_u64_t count, mgl_u64_t instance_count);
+
+	/// <summary>
+	///		Records an indexed base vertex triangle draw command (see mrl_draw_triangles_indexed_base_vertex).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="offset">First index offset, in bytes</param>
+	/// <param name="count">Number of indexes to render</param>
+	/// <param name="base_vertex">Value added to the indices before fetching vertices</param>
+	MRL_API void mrl_cmd_draw_triangles_indexed_base_vertex(mrl_command_buffer_t* cb, mgl_u64_t offset, mgl_u64_t count, mgl_i64_t base_vertex);
+
+	/// <summary>
+	///		Records an indexed instanced base vertex triangle draw command (see mrl_draw_triangles_indexed_instanced_base_vertex).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="offset">First index offset, in bytes</param>
+	/// <param name="count">Number of indexes to render</param>
+	/// <param name="instance_count">Number of instances to render</param>
+	/// <param name="base_vertex">Value added to the indices before fetching vertices</param>
+	MRL_API void mrl_cmd_draw_triangles_indexed_instanced_base_vertex(mrl_command_buffer_t* cb, mgl_u64_t offset, mgl_u64_t count, mgl_u64_t instance_count, mgl_i64_t base_vertex);
+
+	/// <summary>
+	///		Records a multi triangle draw command (see mrl_multi_draw_triangles).
+	///		The arrays are copied into the command buffer.
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="offsets">First vertex offset of each range</param>
+	/// <param name="counts">Number of vertexes to render in each range</param>
+	/// <param name="draw_count">Number of ranges</param>
+	MRL_API void mrl_cmd_multi_draw_triangles(mrl_command_buffer_t* cb, const mgl_u64_t* offsets, const mgl_u64_t* counts, mgl_u64_t draw_count);
+
+	/// <summary>
+	///		Records an indexed multi triangle draw command (see mrl_multi_draw_triangles_indexed).
+	///		The arrays are copied into the command buffer.
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="offsets">First index offset of each range</param>
+	/// <param name="counts">Number of indexes to render in each range</param>
+	/// <param name="base_vertices">Base vertex of each range. Optional (can be NULL)</param>
+	/// <param name="draw_count">Number of ranges</param>
+	MRL_API void mrl_cmd_multi_draw_triangles_indexed(mrl_command_buffer_t* cb, const mgl_u64_t* offsets, const mgl_u64_t* counts, const mgl_i64_t* base_vertices, mgl_u64_t draw_count);
+
+	/// <summary>
+	///		Records an indirect triangle draw command (see mrl_draw_triangles_indirect).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="ib">Indirect buffer handle</param>
+	/// <param name="offset">Offset of the first argument structure, in bytes</param>
+	/// <param name="draw_count">Number of draws</param>
+	MRL_API void mrl_cmd_draw_triangles_indirect(mrl_command_buffer_t* cb, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t draw_count);
+
+	/// <summary>
+	///		Records an indexed indirect triangle draw command (see mrl_draw_triangles_indexed_indirect).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="ib">Indirect buffer handle</param>
+	/// <param name="offset">Offset of the first argument structure, in bytes</param>
+	/// <param name="draw_count">Number of draws</param>
+	MRL_API void mrl_cmd_draw_triangles_indexed_indirect(mrl_command_buffer_t* cb, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t draw_count);
+
+	/// <summary>
+	///		Records a viewport set command (see mrl_set_viewport).
+	/// </summary>
+	/// <param name="cb">Command buffer handle</param>
+	/// <param name="x">Bottom left viewport corner X coordinate</param>
+	/// <param name="y">Bottom left viewport corner Y coordinate</param>
+	/// <param name="w">Viewport width</param>
+	/// <param name="h">Viewport height</param>
+	MRL_API void mrl_cmd_set_viewport(mrl_command_buffer_t* cb, mgl_i32_t x, mgl_i32_t y, mgl_i32_t w, mgl_i32_t h);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,107 @@
+#ifndef MRL_COMMAND_SCHEDULER_H
+#define MRL_COMMAND_SCHEDULER_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <mrl/command_buffer.h>
+
+	typedef struct mrl_command_scheduler_desc_t mrl_command_scheduler_desc_t;
+
+	typedef void mrl_command_scheduler_t;
+
+	/// <summary>
+	///		Function called by the command scheduler to record a job.
+	///		The job must record the commands for the items in the range [first, first + count) into the command buffer.
+	///		Jobs run on different threads at the same time, so they must not access the render device.
+	/// </summary>
+	typedef void(*mrl_command_job_func_t)(mrl_command_buffer_t* cb, mgl_u64_t first, mgl_u64_t count, void* user_data);
+
+	// ---- Command scheduler ----
+
+	struct mrl_command_scheduler_desc_t
+	{
+		/// <summary>
+		///		Allocator used by the scheduler and its recording arenas (usually the render device allocator).
+		///		Arenas grow on the worker threads, so the allocator must be thread safe.
+		/// </summary>
+		void* allocator;
+
+		/// <summary>
+		///		Number of worker threads created by the scheduler.
+		///		The thread which records the jobs also works on them, so 0 records everything on the calling thread.
+		///		If set to MRL_COMMAND_SCHEDULER_AUTO_THREAD_COUNT, one worker is created per extra hardware thread.
+		/// </summary>
+		mgl_u32_t thread_count;
+
+		/// <summary>
+		///		Maximum number of jobs a recording can be split into.
+		///		If more jobs would be needed, the jobs are made bigger.
+		/// </summary>
+		mgl_u64_t max_job_count;
+
+		/// <summary>
+		///		Size in bytes of each memory chunk of the per-thread recording arenas.
+		/// </summary>
+		mgl_u64_t chunk_size;
+
+		/// <summary>
+		///		Hints.
+		/// </summary>
+		mrl_hint_t* hints;
+	};
+
+#define MRL_COMMAND_SCHEDULER_AUTO_THREAD_COUNT ((mgl_u32_t)-1)
+
+#define MRL_DEFAULT_COMMAND_SCHEDULER_DESC ((mrl_command_scheduler_desc_t) {\
+	NULL,\
+	MRL_COMMAND_SCHEDULER_AUTO_THREAD_COUNT,\
+	4096,\
+	256 * 1024,\
+	NULL,\
+})
+
+	// ------- Command scheduler functions -------
+
+	/// <summary>
+	///		Creates a new command scheduler.
+	///		Command schedulers split a list of items (usually draws) into jobs, which are recorded in parallel by a pool
+	///		of worker threads. Each worker records into its own arena, and idle workers steal jobs from busy ones.
+	/// </summary>
+	/// <param name="desc">Description</param>
+	/// <param name="s">Out command scheduler handle</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_create_command_scheduler(const mrl_command_scheduler_desc_t* desc, mrl_command_scheduler_t** s);
+
+	/// <summary>
+	///		Destroys a command scheduler, stopping its worker threads.
+	/// </summary>
+	/// <param name="s">Command scheduler handle</param>
+	MRL_API void mrl_destroy_command_scheduler(mrl_command_scheduler_t* s);
+
+	/// <summary>
+	///		Records commands for a number of items in parallel, discarding the previously recorded commands.
+	///		The items are split into jobs of job_size items, and the function only returns after all of the jobs were recorded.
+	/// </summary>
+	/// <param name="s">Command scheduler handle</param>
+	/// <param name="item_count">Number of items</param>
+	/// <param name="job_size">Number of items per job</param>
+	/// <param name="func">Job function</param>
+	/// <param name="user_data">User data passed to the job function</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_record_command_jobs(mrl_command_scheduler_t* s, mgl_u64_t item_count, mgl_u64_t job_size, mrl_command_job_func_t func, void* user_data);
+
+	/// <summary>
+	///		Executes the commands recorded by the last call to mrl_record_command_jobs.
+	///		The jobs are executed in item order, independently of which threads recorded them.
+	///		This must be called on the thread which owns the render device.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="s">Command scheduler handle</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_submit_command_jobs(mrl_render_device_t* rd, mrl_command_scheduler_t* s);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
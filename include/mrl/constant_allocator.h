@@ -0,0 +1,99 @@
+#ifndef MRL_CONSTANT_ALLOCATOR_H
+#define MRL_CONSTANT_ALLOCATOR_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <mrl/render_device.h>
+
+	typedef struct mrl_constant_allocator_desc_t mrl_constant_allocator_desc_t;
+
+	typedef void mrl_constant_allocator_t;
+
+	// ---- Constant allocator ----
+
+	struct mrl_constant_allocator_desc_t
+	{
+		/// <summary>
+		///		Allocator used to allocate the constant allocator object.
+		/// </summary>
+		void* allocator;
+
+		/// <summary>
+		///		Size in bytes of the constant buffer shared by every allocation.
+		///		Should be big enough to hold a few frames of constants.
+		/// </summary>
+		mgl_u64_t size;
+
+		/// <summary>
+		///		Hints.
+		/// </summary>
+		mrl_hint_t* hints;
+	};
+
+#define MRL_DEFAULT_CONSTANT_ALLOCATOR_DESC ((mrl_constant_allocator_desc_t) {\
+	NULL,\
+	4 * 1024 * 1024,\
+	NULL,\
+})
+
+	// ------- Constant allocator functions -------
+
+	/// <summary>
+	///		Creates a new constant allocator.
+	///		Constant allocators linearly sub-allocate the constants of many objects from a single constant buffer,
+	///		which is used as a ring buffer across frames (see mrl_create_stream_allocator).
+	///		The allocations are bound with mrl_bind_constant_buffer_range.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="desc">Description</param>
+	/// <param name="ca">Out constant allocator handle</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_create_constant_allocator(mrl_render_device_t* rd, const mrl_constant_allocator_desc_t* desc, mrl_constant_allocator_t** ca);
+
+	/// <summary>
+	///		Destroys a constant allocator.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="ca">Constant allocator handle</param>
+	MRL_API void mrl_destroy_constant_allocator(mrl_render_device_t* rd, mrl_constant_allocator_t* ca);
+
+	/// <summary>
+	///		Starts the constant allocations of a frame, mapping a block of the constant buffer.
+	///		Must be called once per frame. The allocations of the previous frame are released once the GPU is done with them.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="ca">Constant allocator handle</param>
+	/// <param name="size">Maximum size in bytes of the frame allocations</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_begin_constant_allocations(mrl_render_device_t* rd, mrl_constant_allocator_t* ca, mgl_u64_t size);
+
+	/// <summary>
+	///		Allocates constants for the current frame.
+	///		The returned offset is aligned to the MRL_PROPERTY_CONSTANT_BUFFER_OFFSET_ALIGNMENT property.
+	/// </summary>
+	/// <param name="ca">Constant allocator handle</param>
+	/// <param name="size">Allocation size</param>
+	/// <param name="offset">Out allocation offset in the constant buffer</param>
+	/// <returns>Pointer to allocation data, or NULL if the frame block is full</returns>
+	MRL_API void* mrl_allocate_constants(mrl_constant_allocator_t* ca, mgl_u64_t size, mgl_u64_t* offset);
+
+	/// <summary>
+	///		Ends the constant allocations of a frame, unmapping the frame block.
+	///		Must be called before any draw call which uses the frame constants.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="ca">Constant allocator handle</param>
+	MRL_API void mrl_end_constant_allocations(mrl_render_device_t* rd, mrl_constant_allocator_t* ca);
+
+	/// <summary>
+	///		Gets the constant buffer which holds the allocations of a constant allocator.
+	/// </summary>
+	/// <param name="ca">Constant allocator handle</param>
+	/// <returns>Constant buffer handle</returns>
+	MRL_API mrl_constant_buffer_t* mrl_get_constant_allocator_buffer(mrl_constant_allocator_t* ca);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
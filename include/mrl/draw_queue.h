@@ -0,0 +1,222 @@
+#ifndef MRL_DRAW_QUEUE_H
+#define MRL_DRAW_QUEUE_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <mrl/pipeline_state.h>
+
+	typedef struct mrl_draw_queue_desc_t mrl_draw_queue_desc_t;
+	typedef struct mrl_draw_binding_t mrl_draw_binding_t;
+	typedef struct mrl_draw_packet_t mrl_draw_packet_t;
+
+	typedef void mrl_draw_queue_t;
+
+	// ---- Draw queue ----
+
+	struct mrl_draw_queue_desc_t
+	{
+		/// <summary>
+		///		Allocator used to allocate the draw queue and its packet arrays.
+		/// </summary>
+		void* allocator;
+
+		/// <summary>
+		///		Pipeline state cache through which the pipeline states of the packets are set.
+		/// </summary>
+		mrl_pipeline_state_cache_t* pipeline_state_cache;
+
+		/// <summary>
+		///		Number of packets for which memory is allocated up front.
+		///		The queue grows when more packets are pushed in a single frame.
+		/// </summary>
+		mgl_u64_t packet_capacity;
+
+		/// <summary>
+		///		Hints.
+		/// </summary>
+		mrl_hint_t* hints;
+	};
+
+#define MRL_DEFAULT_DRAW_QUEUE_DESC ((mrl_draw_queue_desc_t) {\
+	NULL,\
+	NULL,\
+	1024,\
+	NULL,\
+})
+
+	// ---- Draw packets ----
+
+#define MRL_MAX_DRAW_PACKET_BINDING_COUNT 8
+
+	enum
+	{
+		MRL_DRAW_BINDING_SAMPLER,
+		MRL_DRAW_BINDING_TEXTURE_1D,
+		MRL_DRAW_BINDING_TEXTURE_2D,
+		MRL_DRAW_BINDING_TEXTURE_3D,
+		MRL_DRAW_BINDING_CUBE_MAP,
+		MRL_DRAW_BINDING_CONSTANT_BUFFER,
+		MRL_DRAW_BINDING_CONSTANT_BUFFER_RANGE,
+		MRL_DRAW_BINDING_TEXTURE_2D_ARRAY,
+		MRL_DRAW_BINDING_CUBE_MAP_ARRAY,
+	};
+
+	struct mrl_draw_binding_t
+	{
+		/// <summary>
+		///		Binding type.
+		///		Valid values:
+		///		- MRL_DRAW_BINDING_SAMPLER;
+		///		- MRL_DRAW_BINDING_TEXTURE_1D;
+		///		- MRL_DRAW_BINDING_TEXTURE_2D;
+		///		- MRL_DRAW_BINDING_TEXTURE_3D;
+		///		- MRL_DRAW_BINDING_CUBE_MAP;
+		///		- MRL_DRAW_BINDING_CONSTANT_BUFFER;
+		///		- MRL_DRAW_BINDING_CONSTANT_BUFFER_RANGE;
+		///		- MRL_DRAW_BINDING_TEXTURE_2D_ARRAY;
+		///		- MRL_DRAW_BINDING_CUBE_MAP_ARRAY;
+		/// </summary>
+		mgl_enum_t type;
+
+		/// <summary>
+		///		Binding point, which must belong to the shader pipeline of the packet pipeline state.
+		/// </summary>
+		mrl_shader_binding_point_t* bp;
+
+		/// <summary>
+		///		Handle of the bound sampler, texture or constant buffer.
+		/// </summary>
+		void* handle;
+
+		/// <summary>
+		///		Offset of the bound range (only used by MRL_DRAW_BINDING_CONSTANT_BUFFER_RANGE).
+		/// </summary>
+		mgl_u64_t offset;
+
+		/// <summary>
+		///		Size of the bound range (only used by MRL_DRAW_BINDING_CONSTANT_BUFFER_RANGE).
+		/// </summary>
+		mgl_u64_t size;
+	};
+
+	struct mrl_draw_packet_t
+	{
+		/// <summary>
+		///		Key by which the packets are sorted, in ascending order. Packets with the same key are drawn in push order.
+		///		The most expensive state changes should go to the most significant bits, for example:
+		///		layer (8 bits), pipeline state (16 bits), textures (16 bits), depth (24 bits).
+		/// </summary>
+		mgl_u64_t sort_key;
+
+		/// <summary>
+		///		Pipeline state.
+		/// </summary>
+		mrl_pipeline_state_t* pso;
+
+		/// <summary>
+		///		Vertex array.
+		///		Must be NULL if the pipeline state has a vertex array, which is then used instead.
+		/// </summary>
+		mrl_vertex_array_t* vertex_array;
+
+		/// <summary>
+		///		Index buffer.
+		///		If NULL, the draw isn't indexed.
+		/// </summary>
+		mrl_index_buffer_t* index_buffer;
+
+		/// <summary>
+		///		Number of resource bindings.
+		///		Valid values: 0 - MRL_MAX_DRAW_PACKET_BINDING_COUNT.
+		/// </summary>
+		mgl_u32_t binding_count;
+
+		/// <summary>
+		///		Resource bindings.
+		/// </summary>
+		mrl_draw_binding_t bindings[MRL_MAX_DRAW_PACKET_BINDING_COUNT];
+
+		/// <summary>
+		///		First vertex drawn, or offset in bytes of the first index drawn.
+		/// </summary>
+		mgl_u64_t offset;
+
+		/// <summary>
+		///		Number of vertices or indices drawn.
+		/// </summary>
+		mgl_u64_t count;
+
+		/// <summary>
+		///		Number of instances drawn.
+		///		If 1, the draw isn't instanced.
+		/// </summary>
+		mgl_u64_t instance_count;
+
+		/// <summary>
+		///		Value added to the indices before fetching vertices (only used by indexed draws).
+		///		Lets packets draw meshes which share a vertex array (see mrl_create_mesh_heap).
+		/// </summary>
+		mgl_i64_t base_vertex;
+	};
+
+#define MRL_DEFAULT_DRAW_PACKET ((mrl_draw_packet_t) {\
+	0,\
+	NULL,\
+	NULL,\
+	NULL,\
+	0,\
+	{ { 0 } },\
+	0,\
+	0,\
+	1,\
+	0,\
+})
+
+	// ------- Draw queue functions -------
+
+	/// <summary>
+	///		Creates a new draw queue.
+	///		Draw queues collect the draws of a frame as packets, and sort them by key before submitting them,
+	///		so that draws which share state are submitted together and redundant state changes can be skipped.
+	/// </summary>
+	/// <param name="desc">Description</param>
+	/// <param name="dq">Out draw queue handle</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_create_draw_queue(const mrl_draw_queue_desc_t* desc, mrl_draw_queue_t** dq);
+
+	/// <summary>
+	///		Destroys a draw queue.
+	/// </summary>
+	/// <param name="dq">Draw queue handle</param>
+	MRL_API void mrl_destroy_draw_queue(mrl_draw_queue_t* dq);
+
+	/// <summary>
+	///		Pushes a packet into a draw queue. The packet is copied.
+	/// </summary>
+	/// <param name="dq">Draw queue handle</param>
+	/// <param name="packet">Draw packet</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_push_draw_packet(mrl_draw_queue_t* dq, const mrl_draw_packet_t* packet);
+
+	/// <summary>
+	///		Sorts the packets of a draw queue and draws them, only setting and binding the state which changes between packets.
+	///		The queue is cleared afterwards.
+	///		Since the queue doesn't know which states were set outside of it, the first packet sets every state,
+	///		except for the pipeline state, which is diffed by its cache.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="dq">Draw queue handle</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_submit_draw_queue(mrl_render_device_t* rd, mrl_draw_queue_t* dq);
+
+	/// <summary>
+	///		Removes every packet from a draw queue, without drawing them.
+	/// </summary>
+	/// <param name="dq">Draw queue handle</param>
+	MRL_API void mrl_clear_draw_queue(mrl_draw_queue_t* dq);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -22,6 +22,7 @@ extern "C" {
 		MRL_ERROR_INVALID_PARAMS					= 0x08,
 		MRL_ERROR_VERTEX_ELEMENT_NOT_FOUND			= 0x09,
 		MRL_ERROR_BINDING_POINT_NOT_FOUND			= 0x0A,
+		MRL_ERROR_MESH_HEAP_FULL					= 0x0B,
 	};
 
 	/// <summary>
@@ -0,0 +1,188 @@
+#ifndef MRL_MESH_HEAP_H
+#define MRL_MESH_HEAP_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <mrl/render_device.h>
+
+	typedef struct mrl_mesh_heap_desc_t mrl_mesh_heap_desc_t;
+	typedef struct mrl_mesh_t mrl_mesh_t;
+
+	typedef void mrl_mesh_heap_t;
+
+	// ---- Mesh heap ----
+
+	struct mrl_mesh_heap_desc_t
+	{
+		/// <summary>
+		///		Allocator used to allocate the mesh heap and its free lists.
+		/// </summary>
+		void* allocator;
+
+		/// <summary>
+		///		Vertex array description.
+		///		The buffer count and buffers members are ignored: every element reads from the heap vertex buffer,
+		///		so the vertices must be interleaved, and the element buffer indices must be 0.
+		/// </summary>
+		mrl_vertex_array_desc_t vertex_array;
+
+		/// <summary>
+		///		Size in bytes of each vertex.
+		/// </summary>
+		mgl_u64_t vertex_size;
+
+		/// <summary>
+		///		Number of vertices which fit in the heap vertex buffer.
+		/// </summary>
+		mgl_u64_t vertex_capacity;
+
+		/// <summary>
+		///		Number of indices which fit in the heap index buffer.
+		/// </summary>
+		mgl_u64_t index_capacity;
+
+		/// <summary>
+		///		Index data format.
+		///		Since indices are relative to the first vertex of their mesh, 16 bit indices can be used
+		///		as long as no single mesh has more than 65536 vertices, even if the heap is larger.
+		///		Valid values:
+		///		- MRL_INDEX_BUFFER_FORMAT_U16;
+		///		- MRL_INDEX_BUFFER_FORMAT_U32;
+		/// </summary>
+		mgl_enum_t index_format;
+
+		/// <summary>
+		///		Maximum number of meshes allocated at the same time.
+		/// </summary>
+		mgl_u64_t max_mesh_count;
+
+		/// <summary>
+		///		Hints.
+		/// </summary>
+		mrl_hint_t* hints;
+	};
+
+#define MRL_DEFAULT_MESH_HEAP_DESC ((mrl_mesh_heap_desc_t) {\
+	NULL,\
+	MRL_DEFAULT_VERTEX_ARRAY_DESC,\
+	0,\
+	1024 * 1024,\
+	3 * 1024 * 1024,\
+	MRL_INDEX_BUFFER_FORMAT_U32,\
+	4096,\
+	NULL,\
+})
+
+	struct mrl_mesh_t
+	{
+		/// <summary>
+		///		First vertex of the mesh in the heap vertex buffer.
+		///		Passed as the base vertex of the mesh draws.
+		/// </summary>
+		mgl_i64_t base_vertex;
+
+		/// <summary>
+		///		Number of vertices of the mesh.
+		/// </summary>
+		mgl_u64_t vertex_count;
+
+		/// <summary>
+		///		Offset in bytes of the first index of the mesh in the heap index buffer.
+		///		Passed as the offset of the mesh draws.
+		/// </summary>
+		mgl_u64_t index_offset;
+
+		/// <summary>
+		///		Number of indices of the mesh.
+		/// </summary>
+		mgl_u64_t index_count;
+	};
+
+	// ------- Mesh heap functions -------
+
+	/// <summary>
+	///		Creates a new mesh heap.
+	///		Mesh heaps pack the vertices and indices of many meshes with the same vertex layout into a single vertex buffer
+	///		and index buffer, which share a single vertex array. Meshes are drawn with base vertex draws, so switching
+	///		between meshes of the same heap doesn't require setting a different vertex array or index buffer.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="desc">Description</param>
+	/// <param name="heap">Out mesh heap handle</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_create_mesh_heap(mrl_render_device_t* rd, const mrl_mesh_heap_desc_t* desc, mrl_mesh_heap_t** heap);
+
+	/// <summary>
+	///		Destroys a mesh heap, along with its buffers and vertex array.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="heap">Mesh heap handle</param>
+	MRL_API void mrl_destroy_mesh_heap(mrl_render_device_t* rd, mrl_mesh_heap_t* heap);
+
+	/// <summary>
+	///		Allocates a mesh on a mesh heap, and uploads its data.
+	///		The indices are relative to the first vertex of the mesh.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="heap">Mesh heap handle</param>
+	/// <param name="vertex_count">Number of vertices</param>
+	/// <param name="vertices">Vertex data. Optional (can be NULL, and then uploaded with mrl_update_mesh)</param>
+	/// <param name="index_count">Number of indices</param>
+	/// <param name="indices">Index data. Optional (can be NULL, and then uploaded with mrl_update_mesh)</param>
+	/// <param name="mesh">Out mesh</param>
+	/// <returns>Error code (MRL_ERROR_MESH_HEAP_FULL if there isn't a large enough free range left)</returns>
+	MRL_API mrl_error_t mrl_allocate_mesh(mrl_render_device_t* rd, mrl_mesh_heap_t* heap, mgl_u64_t vertex_count, const void* vertices, mgl_u64_t index_count, const void* indices, mrl_mesh_t* mesh);
+
+	/// <summary>
+	///		Frees a mesh allocated on a mesh heap.
+	///		The mesh must not be drawn by any draw submitted afterwards.
+	/// </summary>
+	/// <param name="heap">Mesh heap handle</param>
+	/// <param name="mesh">Mesh</param>
+	MRL_API void mrl_free_mesh(mrl_mesh_heap_t* heap, const mrl_mesh_t* mesh);
+
+	/// <summary>
+	///		Uploads the whole vertex and index data of a mesh.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="heap">Mesh heap handle</param>
+	/// <param name="mesh">Mesh</param>
+	/// <param name="vertices">Vertex data. Optional (can be NULL to keep the current vertices)</param>
+	/// <param name="indices">Index data. Optional (can be NULL to keep the current indices)</param>
+	MRL_API void mrl_update_mesh(mrl_render_device_t* rd, mrl_mesh_heap_t* heap, const mrl_mesh_t* mesh, const void* vertices, const void* indices);
+
+	/// <summary>
+	///		Sets the vertex array and index buffer of a mesh heap.
+	///		Must be called before drawing meshes of the heap with mrl_draw_mesh.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="heap">Mesh heap handle</param>
+	MRL_API void mrl_set_mesh_heap(mrl_render_device_t* rd, mrl_mesh_heap_t* heap);
+
+	/// <summary>
+	///		Draws a mesh of the mesh heap which is currently set.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="mesh">Mesh</param>
+	/// <param name="instance_count">Number of instances to render</param>
+	MRL_API void mrl_draw_mesh(mrl_render_device_t* rd, const mrl_mesh_t* mesh, mgl_u64_t instance_count);
+
+	/// <summary>
+	///		Gets the vertex array of a mesh heap, for example to use it in draw packets.
+	/// </summary>
+	/// <param name="heap">Mesh heap handle</param>
+	/// <returns>Vertex array handle</returns>
+	MRL_API mrl_vertex_array_t* mrl_get_mesh_heap_vertex_array(mrl_mesh_heap_t* heap);
+
+	/// <summary>
+	///		Gets the index buffer of a mesh heap, for example to use it in draw packets.
+	/// </summary>
+	/// <param name="heap">Mesh heap handle</param>
+	/// <returns>Index buffer handle</returns>
+	MRL_API mrl_index_buffer_t* mrl_get_mesh_heap_index_buffer(mrl_mesh_heap_t* heap);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,174 @@
+#ifndef MRL_NULL_RENDER_DEVICE_H
+#define MRL_NULL_RENDER_DEVICE_H
+#ifdef __cplusplus
+extern "C" {
+#endif 
+
+#include <mrl/render_device.h>
+
+	// ------- Recorded commands -------
+
+	/// <summary>
+	///		Opcodes of the commands recorded by null render devices.
+	///		Each command is stored as its opcode (a single byte) followed by its arguments, in the same order as
+	///		the parameters of the render device function, skipping the render device itself:
+	///		- Unsigned integers, enums, booleans and object handles are stored as unsigned LEB128 varints;
+	///		- Signed integers are zigzag encoded and then stored as unsigned LEB128 varints;
+	///		- Floats are stored as 4 little endian bytes;
+	///		- Object handles are stored as their object ID, which is unique during the device lifetime (0 is NULL);
+	///		- Binding points are stored as their binding point ID (see mrl_get_shader_binding_point_id);
+	///		- Descriptions are not stored, create functions only store the ID of the created object;
+	///		- Texture update descriptions are stored as their members, in declaration order;
+	///		- Data pointers, arrays and out parameters are not stored.
+	///		Calls which fail are not recorded.
+	/// </summary>
+	enum
+	{
+		MRL_NULL_COMMAND_CREATE_FRAMEBUFFER,
+		MRL_NULL_COMMAND_DESTROY_FRAMEBUFFER,
+		MRL_NULL_COMMAND_SET_FRAMEBUFFER,
+		MRL_NULL_COMMAND_CREATE_RASTER_STATE,
+		MRL_NULL_COMMAND_DESTROY_RASTER_STATE,
+		MRL_NULL_COMMAND_SET_RASTER_STATE,
+		MRL_NULL_COMMAND_CREATE_DEPTH_STENCIL_STATE,
+		MRL_NULL_COMMAND_DESTROY_DEPTH_STENCIL_STATE,
+		MRL_NULL_COMMAND_SET_DEPTH_STENCIL_STATE,
+		MRL_NULL_COMMAND_CREATE_BLEND_STATE,
+		MRL_NULL_COMMAND_DESTROY_BLEND_STATE,
+		MRL_NULL_COMMAND_SET_BLEND_STATE,
+		MRL_NULL_COMMAND_CREATE_SAMPLER,
+		MRL_NULL_COMMAND_DESTROY_SAMPLER,
+		MRL_NULL_COMMAND_BIND_SAMPLER,
+		MRL_NULL_COMMAND_CREATE_TEXTURE_1D,
+		MRL_NULL_COMMAND_DESTROY_TEXTURE_1D,
+		MRL_NULL_COMMAND_GENERATE_TEXTURE_1D_MIPMAPS,
+		MRL_NULL_COMMAND_BIND_TEXTURE_1D,
+		MRL_NULL_COMMAND_UPDATE_TEXTURE_1D,
+		MRL_NULL_COMMAND_CREATE_TEXTURE_2D,
+		MRL_NULL_COMMAND_DESTROY_TEXTURE_2D,
+		MRL_NULL_COMMAND_GENERATE_TEXTURE_2D_MIPMAPS,
+		MRL_NULL_COMMAND_BIND_TEXTURE_2D,
+		MRL_NULL_COMMAND_UPDATE_TEXTURE_2D,
+		MRL_NULL_COMMAND_CREATE_TEXTURE_3D,
+		MRL_NULL_COMMAND_DESTROY_TEXTURE_3D,
+		MRL_NULL_COMMAND_GENERATE_TEXTURE_3D_MIPMAPS,
+		MRL_NULL_COMMAND_BIND_TEXTURE_3D,
+		MRL_NULL_COMMAND_UPDATE_TEXTURE_3D,
+		MRL_NULL_COMMAND_CREATE_CUBE_MAP,
+		MRL_NULL_COMMAND_DESTROY_CUBE_MAP,
+		MRL_NULL_COMMAND_GENERATE_CUBE_MAP_MIPMAPS,
+		MRL_NULL_COMMAND_BIND_CUBE_MAP,
+		MRL_NULL_COMMAND_UPDATE_CUBE_MAP,
+		MRL_NULL_COMMAND_CREATE_CONSTANT_BUFFER,
+		MRL_NULL_COMMAND_DESTROY_CONSTANT_BUFFER,
+		MRL_NULL_COMMAND_BIND_CONSTANT_BUFFER,
+		MRL_NULL_COMMAND_BIND_CONSTANT_BUFFER_RANGE,
+		MRL_NULL_COMMAND_MAP_CONSTANT_BUFFER,
+		MRL_NULL_COMMAND_UNMAP_CONSTANT_BUFFER,
+		MRL_NULL_COMMAND_MAP_CONSTANT_BUFFER_RANGE,
+		MRL_NULL_COMMAND_FLUSH_CONSTANT_BUFFER_RANGE,
+		MRL_NULL_COMMAND_UPDATE_CONSTANT_BUFFER,
+		MRL_NULL_COMMAND_QUERY_CONSTANT_BUFFER_STRUCTURE,
+		MRL_NULL_COMMAND_CREATE_INDEX_BUFFER,
+		MRL_NULL_COMMAND_DESTROY_INDEX_BUFFER,
+		MRL_NULL_COMMAND_SET_INDEX_BUFFER,
+		MRL_NULL_COMMAND_MAP_INDEX_BUFFER,
+		MRL_NULL_COMMAND_UNMAP_INDEX_BUFFER,
+		MRL_NULL_COMMAND_MAP_INDEX_BUFFER_RANGE,
+		MRL_NULL_COMMAND_FLUSH_INDEX_BUFFER_RANGE,
+		MRL_NULL_COMMAND_UPDATE_INDEX_BUFFER,
+		MRL_NULL_COMMAND_CREATE_VERTEX_BUFFER,
+		MRL_NULL_COMMAND_DESTROY_VERTEX_BUFFER,
+		MRL_NULL_COMMAND_MAP_VERTEX_BUFFER,
+		MRL_NULL_COMMAND_UNMAP_VERTEX_BUFFER,
+		MRL_NULL_COMMAND_MAP_VERTEX_BUFFER_RANGE,
+		MRL_NULL_COMMAND_FLUSH_VERTEX_BUFFER_RANGE,
+		MRL_NULL_COMMAND_UPDATE_VERTEX_BUFFER,
+		MRL_NULL_COMMAND_CREATE_VERTEX_ARRAY,
+		MRL_NULL_COMMAND_DESTROY_VERTEX_ARRAY,
+		MRL_NULL_COMMAND_SET_VERTEX_ARRAY,
+		MRL_NULL_COMMAND_CREATE_STREAM_ALLOCATOR,
+		MRL_NULL_COMMAND_DESTROY_STREAM_ALLOCATOR,
+		MRL_NULL_COMMAND_MAP_STREAM_ALLOCATION,
+		MRL_NULL_COMMAND_UNMAP_STREAM_ALLOCATION,
+		MRL_NULL_COMMAND_END_STREAM_ALLOCATOR_FRAME,
+		MRL_NULL_COMMAND_CREATE_SHADER_STAGE,
+		MRL_NULL_COMMAND_DESTROY_SHADER_STAGE,
+		MRL_NULL_COMMAND_CREATE_SHADER_PIPELINE,
+		MRL_NULL_COMMAND_DESTROY_SHADER_PIPELINE,
+		MRL_NULL_COMMAND_SET_SHADER_PIPELINE,
+		MRL_NULL_COMMAND_CLEAR_COLOR,
+		MRL_NULL_COMMAND_CLEAR_DEPTH,
+		MRL_NULL_COMMAND_CLEAR_STENCIL,
+		MRL_NULL_COMMAND_SWAP_BUFFERS,
+		MRL_NULL_COMMAND_DRAW_TRIANGLES,
+		MRL_NULL_COMMAND_DRAW_TRIANGLES_INDEXED,
+		MRL_NULL_COMMAND_DRAW_TRIANGLES_INSTANCED,
+		MRL_NULL_COMMAND_DRAW_TRIANGLES_INDEXED_INSTANCED,
+		MRL_NULL_COMMAND_SET_VIEWPORT,
+		MRL_NULL_COMMAND_CREATE_INDIRECT_BUFFER,
+		MRL_NULL_COMMAND_DESTROY_INDIRECT_BUFFER,
+		MRL_NULL_COMMAND_UPDATE_INDIRECT_BUFFER,
+		MRL_NULL_COMMAND_MULTI_DRAW_TRIANGLES,
+		MRL_NULL_COMMAND_MULTI_DRAW_TRIANGLES_INDEXED,
+		MRL_NULL_COMMAND_DRAW_TRIANGLES_INDIRECT,
+		MRL_NULL_COMMAND_DRAW_TRIANGLES_INDEXED_INDIRECT,
+		MRL_NULL_COMMAND_DRAW_TRIANGLES_INDEXED_BASE_VERTEX,
+		MRL_NULL_COMMAND_DRAW_TRIANGLES_INDEXED_INSTANCED_BASE_VERTEX,
+		MRL_NULL_COMMAND_CREATE_UPLOAD_QUEUE,
+		MRL_NULL_COMMAND_DESTROY_UPLOAD_QUEUE,
+		MRL_NULL_COMMAND_WAIT_UPLOAD,
+		MRL_NULL_COMMAND_CREATE_TEXTURE_2D_ARRAY,
+		MRL_NULL_COMMAND_DESTROY_TEXTURE_2D_ARRAY,
+		MRL_NULL_COMMAND_GENERATE_TEXTURE_2D_ARRAY_MIPMAPS,
+		MRL_NULL_COMMAND_BIND_TEXTURE_2D_ARRAY,
+		MRL_NULL_COMMAND_UPDATE_TEXTURE_2D_ARRAY,
+		MRL_NULL_COMMAND_CREATE_CUBE_MAP_ARRAY,
+		MRL_NULL_COMMAND_DESTROY_CUBE_MAP_ARRAY,
+		MRL_NULL_COMMAND_GENERATE_CUBE_MAP_ARRAY_MIPMAPS,
+		MRL_NULL_COMMAND_BIND_CUBE_MAP_ARRAY,
+		MRL_NULL_COMMAND_UPDATE_CUBE_MAP_ARRAY,
+	};
+
+	// ------- Null render device functions -------
+
+	/// <summary>
+	///		Initializes a null render device.
+	///		Every function is implemented with pool backed handles, but no rendering work is ever done, which makes it
+	///		useful to measure the CPU cost of submitting work, or to test applications without a GPU.
+	///		Buffers are backed by system memory, so that they can be mapped.
+	///		If the MRL_HINT_RENDER_DEVICE_RECORD_COMMANDS hint is set, every call is recorded into a binary command stream.
+	///		The window is ignored, and may be NULL.
+	///		The typename of this render device is 'null'.
+	/// </summary>
+	/// <param name="desc">Render device description</param>
+	/// <param name="out_rd">Out render device pointer</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_init_null_render_device(const mrl_render_device_desc_t* desc, mrl_render_device_t** out_rd);
+
+	/// <summary>
+	///		Terminates a null render device.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	MRL_API void mrl_terminate_null_render_device(mrl_render_device_t* rd);
+
+	/// <summary>
+	///		Gets the commands recorded by a null render device.
+	///		The returned pointer is invalidated by the next call to the render device.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="size">Out command stream size in bytes</param>
+	/// <returns>Pointer to the command stream, or NULL if recording is disabled or nothing was recorded</returns>
+	MRL_API const mgl_u8_t* mrl_get_null_render_device_commands(mrl_render_device_t* rd, mgl_u64_t* size);
+
+	/// <summary>
+	///		Clears the commands recorded by a null render device.
+	///		The memory used by the command stream is kept, to be reused by the next commands.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	MRL_API void mrl_clear_null_render_device_commands(mrl_render_device_t* rd);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
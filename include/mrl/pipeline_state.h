@@ -0,0 +1,153 @@
+#ifndef MRL_PIPELINE_STATE_H
+#define MRL_PIPELINE_STATE_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <mrl/render_device.h>
+
+	typedef struct mrl_pipeline_state_cache_desc_t mrl_pipeline_state_cache_desc_t;
+	typedef struct mrl_pipeline_state_desc_t mrl_pipeline_state_desc_t;
+
+	typedef void mrl_pipeline_state_cache_t;
+	typedef void mrl_pipeline_state_t;
+
+	// ---- Pipeline state cache ----
+
+	struct mrl_pipeline_state_cache_desc_t
+	{
+		/// <summary>
+		///		Allocator used to allocate the cache and its objects.
+		/// </summary>
+		void* allocator;
+
+		/// <summary>
+		///		Number of hash table buckets.
+		///		Should be close to the number of different pipeline states expected to be alive at the same time.
+		///		Valid values: powers of two.
+		/// </summary>
+		mgl_u64_t bucket_count;
+
+		/// <summary>
+		///		Hints.
+		/// </summary>
+		mrl_hint_t* hints;
+	};
+
+#define MRL_DEFAULT_PIPELINE_STATE_CACHE_DESC ((mrl_pipeline_state_cache_desc_t) {\
+	NULL,\
+	256,\
+	NULL,\
+})
+
+	// ---- Pipeline state ----
+
+	struct mrl_pipeline_state_desc_t
+	{
+		/// <summary>
+		///		Raster state description.
+		/// </summary>
+		mrl_raster_state_desc_t raster;
+
+		/// <summary>
+		///		Depth stencil state description.
+		/// </summary>
+		mrl_depth_stencil_state_desc_t depth_stencil;
+
+		/// <summary>
+		///		Blend state description.
+		/// </summary>
+		mrl_blend_state_desc_t blend;
+
+		/// <summary>
+		///		Shader pipeline description.
+		/// </summary>
+		mrl_shader_pipeline_desc_t shader_pipeline;
+
+		/// <summary>
+		///		Vertex array description.
+		///		The shader pipeline member is ignored, the pipeline state shader pipeline is used instead.
+		///		If both the element and buffer counts are 0, the pipeline state has no vertex array,
+		///		and applying it keeps the vertex array currently set.
+		/// </summary>
+		mrl_vertex_array_desc_t vertex_array;
+	};
+
+#define MRL_DEFAULT_PIPELINE_STATE_DESC ((mrl_pipeline_state_desc_t) {\
+	MRL_DEFAULT_RASTER_STATE_DESC,\
+	MRL_DEFAULT_DEPTH_STENCIL_STATE_DESC,\
+	MRL_DEFAULT_BLEND_STATE_DESC,\
+	MRL_DEFAULT_SHADER_PIPELINE_DESC,\
+	MRL_DEFAULT_VERTEX_ARRAY_DESC,\
+})
+
+	// ------- Pipeline state cache functions -------
+
+	/// <summary>
+	///		Creates a new pipeline state cache.
+	///		Pipeline state caches create pipeline states, which group the raster, depth stencil and blend states,
+	///		the shader pipeline and the vertex array used by draw calls into a single object.
+	///		Every state is deduplicated by the contents of its description, so states shared by many pipeline
+	///		states are only created once on the render device.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="desc">Description</param>
+	/// <param name="cache">Out pipeline state cache handle</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_create_pipeline_state_cache(mrl_render_device_t* rd, const mrl_pipeline_state_cache_desc_t* desc, mrl_pipeline_state_cache_t** cache);
+
+	/// <summary>
+	///		Destroys a pipeline state cache, along with every pipeline state which wasn't destroyed.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="cache">Pipeline state cache handle</param>
+	MRL_API void mrl_destroy_pipeline_state_cache(mrl_render_device_t* rd, mrl_pipeline_state_cache_t* cache);
+
+	/// <summary>
+	///		Creates a pipeline state, or returns an existing one if a pipeline state with the same description
+	///		already exists. Pipeline states are reference counted, so every successful call must be matched
+	///		by a call to mrl_destroy_pipeline_state.
+	///		The hints of the descriptions are compared by address.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="cache">Pipeline state cache handle</param>
+	/// <param name="pso">Out pipeline state handle</param>
+	/// <param name="desc">Description</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_create_pipeline_state(mrl_render_device_t* rd, mrl_pipeline_state_cache_t* cache, mrl_pipeline_state_t** pso, const mrl_pipeline_state_desc_t* desc);
+
+	/// <summary>
+	///		Releases a reference to a pipeline state, destroying it (and the states only it used) when none are left.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="cache">Pipeline state cache handle</param>
+	/// <param name="pso">Pipeline state handle</param>
+	MRL_API void mrl_destroy_pipeline_state(mrl_render_device_t* rd, mrl_pipeline_state_cache_t* cache, mrl_pipeline_state_t* pso);
+
+	/// <summary>
+	///		Sets the states of a pipeline state.
+	///		Only the states which differ from the last pipeline state set through the same cache are set on the render device.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="cache">Pipeline state cache handle</param>
+	/// <param name="pso">Pipeline state handle</param>
+	MRL_API void mrl_set_pipeline_state(mrl_render_device_t* rd, mrl_pipeline_state_cache_t* cache, mrl_pipeline_state_t* pso);
+
+	/// <summary>
+	///		Forgets the last pipeline state set through a cache, so that the next one is set in full.
+	///		Must be called after any of the states is set directly on the render device.
+	/// </summary>
+	/// <param name="cache">Pipeline state cache handle</param>
+	MRL_API void mrl_invalidate_pipeline_state(mrl_pipeline_state_cache_t* cache);
+
+	/// <summary>
+	///		Gets the shader pipeline of a pipeline state, which is used to query its binding points.
+	/// </summary>
+	/// <param name="pso">Pipeline state handle</param>
+	/// <returns>Shader pipeline handle</returns>
+	MRL_API mrl_shader_pipeline_t* mrl_get_pipeline_state_shader_pipeline(mrl_pipeline_state_t* pso);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -23,13 +23,22 @@ extern "C" {
 	typedef struct mrl_texture_3d_update_desc_t mrl_texture_3d_update_desc_t;
 	typedef struct mrl_cube_map_desc_t mrl_cube_map_desc_t;
 	typedef struct mrl_cube_map_update_desc_t mrl_cube_map_update_desc_t;
+	typedef struct mrl_texture_2d_array_desc_t mrl_texture_2d_array_desc_t;
+	typedef struct mrl_texture_2d_array_update_desc_t mrl_texture_2d_array_update_desc_t;
+	typedef struct mrl_cube_map_array_desc_t mrl_cube_map_array_desc_t;
+	typedef struct mrl_cube_map_array_update_desc_t mrl_cube_map_array_update_desc_t;
 	typedef struct mrl_constant_buffer_structure_element_t mrl_constant_buffer_structure_element_t;
 	typedef struct mrl_constant_buffer_structure_t mrl_constant_buffer_structure_t;
 	typedef struct mrl_constant_buffer_desc_t mrl_constant_buffer_desc_t;
 	typedef struct mrl_index_buffer_desc_t mrl_index_buffer_desc_t;
+	typedef struct mrl_indirect_buffer_desc_t mrl_indirect_buffer_desc_t;
+	typedef struct mrl_draw_indirect_args_t mrl_draw_indirect_args_t;
+	typedef struct mrl_draw_indexed_indirect_args_t mrl_draw_indexed_indirect_args_t;
 	typedef struct mrl_vertex_buffer_desc_t mrl_vertex_buffer_desc_t;
 	typedef struct mrl_vertex_element_t mrl_vertex_element_t;
 	typedef struct mrl_vertex_array_desc_t mrl_vertex_array_desc_t;
+	typedef struct mrl_stream_allocator_desc_t mrl_stream_allocator_desc_t;
+	typedef struct mrl_upload_queue_desc_t mrl_upload_queue_desc_t;
 	typedef struct mrl_shader_stage_desc_t mrl_shader_stage_desc_t;
 	typedef struct mrl_shader_pipeline_desc_t mrl_shader_pipeline_desc_t;
 	typedef struct mrl_render_device_desc_t mrl_render_device_desc_t;
@@ -43,10 +52,15 @@ extern "C" {
 	typedef void mrl_texture_2d_t;
 	typedef void mrl_texture_3d_t;
 	typedef void mrl_cube_map_t;
+	typedef void mrl_texture_2d_array_t;
+	typedef void mrl_cube_map_array_t;
 	typedef void mrl_constant_buffer_t;
 	typedef void mrl_index_buffer_t;
+	typedef void mrl_indirect_buffer_t;
 	typedef void mrl_vertex_buffer_t;
 	typedef void mrl_vertex_array_t;
+	typedef void mrl_stream_allocator_t;
+	typedef void mrl_upload_queue_t;
 	typedef void mrl_shader_stage_t;
 	typedef void mrl_shader_pipeline_t;
 	typedef void mrl_shader_binding_point_t;
@@ -55,7 +69,23 @@ extern "C" {
 	
 	enum
 	{
-		MRL_PROPERTY_MAX_ANISTROPY
+		MRL_PROPERTY_MAX_ANISTROPY,
+
+		/// <summary>
+		///		Alignment required for the offsets passed to mrl_bind_constant_buffer_range.
+		/// </summary>
+		MRL_PROPERTY_CONSTANT_BUFFER_OFFSET_ALIGNMENT,
+
+		/// <summary>
+		///		1 if indirect draws read their arguments on the GPU, 0 if the render device reads them on the CPU
+		///		and issues one draw per argument structure.
+		/// </summary>
+		MRL_PROPERTY_NATIVE_INDIRECT_DRAWS,
+
+		/// <summary>
+		///		1 if cube map arrays are supported, 0 if mrl_create_cube_map_array always fails.
+		/// </summary>
+		MRL_PROPERTY_CUBE_MAP_ARRAYS,
 	};
 
 	// ----- Hints -----
@@ -75,6 +105,35 @@ extern "C" {
 		/// The function pointer is of the type mrl_render_device_hint_error_callback_t.
 		/// </summary>
 		MRL_HINT_RENDER_DEVICE_ERROR_CALLBACK,
+
+		/// <summary>
+		///		Hints the size of the offscreen default framebuffer used by headless render devices.
+		///		The pointer to an array of two mgl_u32_t (width and height) is stored on the 'data' member of the hint.
+		///		Defaults to 1280x720 when not specified.
+		/// </summary>
+		MRL_HINT_RENDER_DEVICE_OFFSCREEN_SIZE,
+
+		/// <summary>
+		///		Hints the number of threads used by render devices which render on the CPU.
+		///		The pointer to a mgl_u32_t is stored on the 'data' member of the hint.
+		///		Defaults to the number of hardware threads when not specified.
+		/// </summary>
+		MRL_HINT_RENDER_DEVICE_THREAD_COUNT,
+
+		/// <summary>
+		///		Hints that render devices which support it (currently, only the null render device) should record
+		///		every call into a binary command stream.
+		///		The pointer to a mgl_u64_t with the initial command stream capacity, in bytes, is stored on the 'data' member of the hint.
+		/// </summary>
+		MRL_HINT_RENDER_DEVICE_RECORD_COMMANDS,
+
+		/// <summary>
+		///		Hints that the render device should check for errors after every call, even if that stalls the pipeline
+		///		(e.g. calling glGetError on OpenGL render devices). Without it, only errors which can be detected without
+		///		querying the driver are reported. The 'data' member of the hint is ignored.
+		///		For API usage errors, see the validation render device (mrl/validation_render_device.h).
+		/// </summary>
+		MRL_HINT_RENDER_DEVICE_DEBUG,
 	};
 
 	struct mrl_hint_t
@@ -117,13 +176,14 @@ extern "C" {
 	{
 		MRL_RENDER_TARGET_TYPE_TEXTURE_2D,
 		MRL_RENDER_TARGET_TYPE_CUBE_MAP,
+		MRL_RENDER_TARGET_TYPE_TEXTURE_2D_ARRAY,
 	};
 
 	struct mrl_framebuffer_desc_t
 	{
 		/// <summary>
 		///		Framebuffer render targets.
-		///		These textures/cube maps must have the usage set to MRL_TEXTURE_USAGE_RENDER_TARGET.
+		///		These textures/cube maps/texture arrays must have the usage set to MRL_TEXTURE_USAGE_RENDER_TARGET.
 		/// </summary>
 		struct
 		{
@@ -132,6 +192,7 @@ extern "C" {
 			///		Valid values:
 			///		- MRL_RENDER_TARGET_TYPE_TEXTURE_2D;
 			///		- MRL_RENDER_TARGET_TYPE_CUBE_MAP;
+			///		- MRL_RENDER_TARGET_TYPE_TEXTURE_2D_ARRAY;
 			/// </summary>
 			mgl_enum_t type;
 
@@ -162,6 +223,19 @@ extern "C" {
 					/// </summary>
 					mgl_enum_t face;
 				} cube_map;
+
+				struct
+				{
+					/// <summary>
+					///		Texture 2D array handle.
+					/// </summary>
+					mrl_texture_2d_array_t* handle;
+
+					/// <summary>
+					///		Texture array layer.
+					/// </summary>
+					mgl_u64_t layer;
+				} tex_2d_array;
 			};
 
 		} targets[MRL_MAX_FRAMEBUFFER_RENDER_TARGET_COUNT];
@@ -178,6 +252,19 @@ extern "C" {
 		/// </summary>
 		mrl_texture_2d_t* depth_stencil;
 
+		/// <summary>
+		///		Depth stencil texture array, whose layer depth_stencil_layer is used as the depth stencil target.
+		///		Must be NULL when depth_stencil isn't NULL.
+		///		Optional (can be NULL).
+		/// </summary>
+		mrl_texture_2d_array_t* depth_stencil_array;
+
+		/// <summary>
+		///		Depth stencil texture array layer.
+		///		Ignored if depth_stencil_array is NULL.
+		/// </summary>
+		mgl_u64_t depth_stencil_layer;
+
 		/// <summary>
 		///		Hint list.
 		///		Hints may be ignored by some render devices.
@@ -194,6 +281,8 @@ extern "C" {
 	0,\
 	NULL,\
 	NULL,\
+	0,\
+	NULL,\
 })
 
 	// ---- Raster state ----
@@ -973,6 +1062,83 @@ extern "C" {
 		/// </summary>
 		MRL_TEXTURE_FORMAT_D32S8,
 
+		/// <summary>
+		///		BC1 (DXT1) compressed RGBA color components, with 1-bit alpha.
+		///		8 bytes per 4x4 block. Compressed formats can only be used on 2D textures and cube maps.
+		/// </summary>
+		MRL_TEXTURE_FORMAT_BC1_UN,
+
+		/// <summary>
+		///		BC2 (DXT3) compressed RGBA color components, with explicit 4-bit alpha.
+		///		16 bytes per 4x4 block.
+		/// </summary>
+		MRL_TEXTURE_FORMAT_BC2_UN,
+
+		/// <summary>
+		///		BC3 (DXT5) compressed RGBA color components, with interpolated alpha.
+		///		16 bytes per 4x4 block.
+		/// </summary>
+		MRL_TEXTURE_FORMAT_BC3_UN,
+
+		/// <summary>
+		///		BC4 (RGTC1) compressed normalized unsigned R color component.
+		///		8 bytes per 4x4 block.
+		/// </summary>
+		MRL_TEXTURE_FORMAT_BC4_UN,
+
+		/// <summary>
+		///		BC4 (RGTC1) compressed normalized signed R color component.
+		///		8 bytes per 4x4 block.
+		/// </summary>
+		MRL_TEXTURE_FORMAT_BC4_SN,
+
+		/// <summary>
+		///		BC5 (RGTC2) compressed normalized unsigned RG color components.
+		///		16 bytes per 4x4 block.
+		/// </summary>
+		MRL_TEXTURE_FORMAT_BC5_UN,
+
+		/// <summary>
+		///		BC5 (RGTC2) compressed normalized signed RG color components.
+		///		16 bytes per 4x4 block.
+		/// </summary>
+		MRL_TEXTURE_FORMAT_BC5_SN,
+
+		/// <summary>
+		///		BC6H (BPTC) compressed unsigned floating point RGB color components.
+		///		16 bytes per 4x4 block.
+		/// </summary>
+		MRL_TEXTURE_FORMAT_BC6H_UF,
+
+		/// <summary>
+		///		BC6H (BPTC) compressed signed floating point RGB color components.
+		///		16 bytes per 4x4 block.
+		/// </summary>
+		MRL_TEXTURE_FORMAT_BC6H_SF,
+
+		/// <summary>
+		///		BC7 (BPTC) compressed RGBA color components.
+		///		16 bytes per 4x4 block.
+		/// </summary>
+		MRL_TEXTURE_FORMAT_BC7_UN,
+
+		/// <summary>
+		///		ETC2 compressed RGB color components.
+		///		8 bytes per 4x4 block.
+		/// </summary>
+		MRL_TEXTURE_FORMAT_ETC2_RGB8_UN,
+
+		/// <summary>
+		///		ETC2 compressed RGB color components, with punchthrough 1-bit alpha.
+		///		8 bytes per 4x4 block.
+		/// </summary>
+		MRL_TEXTURE_FORMAT_ETC2_RGB8A1_UN,
+
+		/// <summary>
+		///		ETC2 compressed RGB color components, with EAC compressed alpha.
+		///		16 bytes per 4x4 block.
+		/// </summary>
+		MRL_TEXTURE_FORMAT_ETC2_RGBA8_UN,
 	};
 
 	// ---- Texture usage modes ----
@@ -1002,13 +1168,14 @@ extern "C" {
 		///		Initial texture data.
 		///		To initialize a texture with NULL data, just set the pointer to NULL.
 		///		Each member of the array points to a mip level, being the first member the 0th mip level.
-		///		Each mip level has half of the side of the previous one.
+		///		Each mip level has half of the side of the previous one, rounded down, and never smaller than 1.
 		/// </summary>
 		const void* data[MRL_MAX_MIP_LEVEL_COUNT];
 
 		/// <summary>
 		///		Texture mip level count.
-		///		Valid values: 1 - MRL_MAX_MIP_LEVEL_COUNT;
+		///		Valid values: 1 - MRL_MAX_MIP_LEVEL_COUNT, and no more than the levels needed to reach a single texel;
+		///		The whole mip chain is allocated when the texture is created.
 		/// </summary>
 		mgl_u32_t mip_level_count;
 
@@ -1028,7 +1195,7 @@ extern "C" {
 		/// <summary>
 		///		Texture data format.
 		///		Valid values:
-		///			- All R, RG, RGBA formats except the depth and stencil component formats.
+		///			- All R, RG, RGBA formats except the depth, stencil and compressed formats.
 		/// </summary>
 		mgl_enum_t format;
 
@@ -1088,13 +1255,14 @@ extern "C" {
 		///		Initial texture data.
 		///		To initialize a texture with NULL data, just set the pointer to NULL.
 		///		Each member of the array points to a mip level, being the first member the 0th mip level.
-		///		Each mip level has half of the side of the previous one.
+		///		Each mip level has half of the side of the previous one, rounded down, and never smaller than 1.
 		/// </summary>
 		const void* data[MRL_MAX_MIP_LEVEL_COUNT];
 
 		/// <summary>
 		///		Texture mip level count.
-		///		Valid values: 1 - MRL_MAX_MIP_LEVEL_COUNT;
+		///		Valid values: 1 - MRL_MAX_MIP_LEVEL_COUNT, and no more than the levels needed to reach a single texel;
+		///		The whole mip chain is allocated when the texture is created.
 		/// </summary>
 		mgl_u32_t mip_level_count;
 
@@ -1119,7 +1287,7 @@ extern "C" {
 		/// <summary>
 		///		Texture data format.
 		///		Valid values:
-		///			- All texture formats.
+		///			- All texture formats (compressed formats require MRL_TEXTURE_USAGE_DEFAULT).
 		/// </summary>
 		mgl_enum_t format;
 
@@ -1145,6 +1313,8 @@ extern "C" {
 	{
 		/// <summary>
 		///		New texture data.
+		///		Compressed textures are updated in whole 4x4 blocks: the destination coordinates must be multiples of 4,
+		///		and so must the size, unless the region reaches the edge of the mip level.
 		/// </summary>
 		const void* data;
 
@@ -1192,13 +1362,14 @@ extern "C" {
 		///		Initial texture data.
 		///		To initialize a texture with NULL data, just set the pointer to NULL.
 		///		Each member of the array points to a mip level, being the first member the 0th mip level.
-		///		Each mip level has half of the side of the previous one.
+		///		Each mip level has half of the side of the previous one, rounded down, and never smaller than 1.
 		/// </summary>
 		const void* data[MRL_MAX_MIP_LEVEL_COUNT];
 
 		/// <summary>
 		///		Texture mip level count.
-		///		Valid values: 1 - MRL_MAX_MIP_LEVEL_COUNT;
+		///		Valid values: 1 - MRL_MAX_MIP_LEVEL_COUNT, and no more than the levels needed to reach a single texel;
+		///		The whole mip chain is allocated when the texture is created.
 		/// </summary>
 		mgl_u32_t mip_level_count;
 
@@ -1228,7 +1399,7 @@ extern "C" {
 		/// <summary>
 		///		Texture data format.
 		///		Valid values:
-		///			- All R, RG, RGBA formats except the depth and stencil component formats.
+		///			- All R, RG, RGBA formats except the depth, stencil and compressed formats.
 		/// </summary>
 		mgl_enum_t format;
 
@@ -1354,13 +1525,14 @@ extern "C" {
 		///			MRL_CUBE_MAP_FACE_NEGATIVE_Z;
 		///		To initialize a face with NULL data, just set the pointer to NULL.
 		///		Each member of the array of each face points to a mip level, being the first member the 0th mip level.
-		///		Each mip level has half of the side of the previous one.
+		///		Each mip level has half of the side of the previous one, rounded down, and never smaller than 1.
 		/// </summary>
 		const void* data[6][MRL_MAX_MIP_LEVEL_COUNT];
 
 		/// <summary>
 		///		Texture mip level count.
-		///		Valid values: 1 - MRL_MAX_MIP_LEVEL_COUNT;
+		///		Valid values: 1 - MRL_MAX_MIP_LEVEL_COUNT, and no more than the levels needed to reach a single texel;
+		///		The whole mip chain is allocated when the texture is created.
 		/// </summary>
 		mgl_u32_t mip_level_count;
 
@@ -1385,7 +1557,7 @@ extern "C" {
 		/// <summary>
 		///		Texture data format.
 		///		Valid values:
-		///			- All R, RG, RGBA formats except the depth and stencil component formats.
+		///			- All R, RG, RGBA and compressed formats except the depth and stencil component formats (compressed formats require MRL_TEXTURE_USAGE_DEFAULT).
 		/// </summary>
 		mgl_enum_t format;
 
@@ -1411,6 +1583,7 @@ extern "C" {
 	{
 		/// <summary>
 		///		New face data.
+		///		Compressed cube maps are updated in whole 4x4 blocks, like 2D textures.
 		/// </summary>
 		const void* data;
 
@@ -1463,192 +1636,489 @@ extern "C" {
 	1,\
 })
 
-	// ---- Constant buffers ----
+	// ---- Texture 2D array ----
 
-#define MRL_MAX_CONSTANT_BUFFER_ELEMENT_NAME_SIZE 64
-#define MRL_MAX_CONSTANT_BUFFER_ELEMENT_COUNT 32
+#define MRL_MAX_TEXTURE_2D_ARRAY_LAYER_COUNT 256
 
-	enum
+	struct mrl_texture_2d_array_desc_t
 	{
-		MRL_CONSTANT_BUFFER_MEMBER_I32,
-		MRL_CONSTANT_BUFFER_MEMBER_U32,
-		MRL_CONSTANT_BUFFER_MEMBER_F32,
-
-		MRL_CONSTANT_BUFFER_MEMBER_I32V2,
-		MRL_CONSTANT_BUFFER_MEMBER_I32V3,
-		MRL_CONSTANT_BUFFER_MEMBER_I32V4,
-		MRL_CONSTANT_BUFFER_MEMBER_U32V2,
-		MRL_CONSTANT_BUFFER_MEMBER_U32V3,
-		MRL_CONSTANT_BUFFER_MEMBER_U32V4,
-		MRL_CONSTANT_BUFFER_MEMBER_F32V2,
-		MRL_CONSTANT_BUFFER_MEMBER_F32V3,
-		MRL_CONSTANT_BUFFER_MEMBER_F32V4,
-
-		MRL_CONSTANT_BUFFER_MEMBER_F32M2X2,
-		MRL_CONSTANT_BUFFER_MEMBER_F32M2X3,
-		MRL_CONSTANT_BUFFER_MEMBER_F32M2X4,
-		MRL_CONSTANT_BUFFER_MEMBER_F32M3X2,
-		MRL_CONSTANT_BUFFER_MEMBER_F32M3X3,
-		MRL_CONSTANT_BUFFER_MEMBER_F32M3X4,
-		MRL_CONSTANT_BUFFER_MEMBER_F32M4X2,
-		MRL_CONSTANT_BUFFER_MEMBER_F32M4X3,
-		MRL_CONSTANT_BUFFER_MEMBER_F32M4X4,
-	};
+		/// <summary>
+		///		Initial texture data.
+		///		To initialize a texture with NULL data, just set the pointer to NULL.
+		///		Each member of the array points to a mip level, being the first member the 0th mip level.
+		///		Each mip level stores the data of every layer, one after the other, starting with the layer 0.
+		///		Each mip level has half of the width and height of the previous one, rounded down, and never smaller than 1.
+		/// </summary>
+		const void* data[MRL_MAX_MIP_LEVEL_COUNT];
 
-	struct mrl_constant_buffer_structure_element_t
-	{
 		/// <summary>
-		///		Name of the element.
+		///		Texture mip level count.
+		///		Valid values: 1 - MRL_MAX_MIP_LEVEL_COUNT, and no more than the levels needed to reach a single texel;
+		///		The whole mip chain is allocated when the texture is created.
 		/// </summary>
-		mgl_chr8_t name[MRL_MAX_CONSTANT_BUFFER_ELEMENT_NAME_SIZE];
+		mgl_u32_t mip_level_count;
 
 		/// <summary>
-		///		The byte offset into the beginning of the buffer for this element.
+		///		Texture width.
 		/// </summary>
-		mgl_u64_t offset;
+		mgl_u64_t width;
 
 		/// <summary>
-		///		Size of the element.
-		///		For non-arrays, this value is set to 1.
-		///		For arrays, this is the length of the array.
+		///		Texture height.
 		/// </summary>
-		mgl_u64_t size;
+		mgl_u64_t height;
 
 		/// <summary>
-		///		Stride between each array element.
+		///		Texture layer count.
+		///		Valid values: 1 - MRL_MAX_TEXTURE_2D_ARRAY_LAYER_COUNT;
 		/// </summary>
-		mgl_u64_t array_stride;
-	};
+		mgl_u64_t layer_count;
 
-	struct mrl_constant_buffer_structure_t
-	{
 		/// <summary>
-		///		Size of the buffer.
+		///		Texture usage mode.
+		///		Valid values:
+		///		- MRL_TEXTURE_USAGE_DEFAULT;
+		///		- MRL_TEXTURE_USAGE_RENDER_TARGET;
 		/// </summary>
-		mgl_u64_t size;
+		mgl_enum_t usage;
 
 		/// <summary>
-		///		Number of elements.
+		///		Texture data format.
+		///		Valid values:
+		///			- All texture formats (compressed formats require MRL_TEXTURE_USAGE_DEFAULT).
 		/// </summary>
-		mgl_u64_t element_count;
+		mgl_enum_t format;
 
 		/// <summary>
-		///		Buffer elements.
+		///		Hint list.
+		///		Hints may be ignored by some render devices.
+		///		Optional (can be NULL).
 		/// </summary>
-		mrl_constant_buffer_structure_element_t elements[MRL_MAX_CONSTANT_BUFFER_ELEMENT_COUNT];
+		const mrl_hint_t* hints;
 	};
 
-	enum
+#define MRL_DEFAULT_TEXTURE_2D_ARRAY_DESC ((mrl_texture_2d_array_desc_t) {\
+	{ NULL },\
+	1,\
+	256,\
+	256,\
+	1,\
+	MRL_TEXTURE_USAGE_DEFAULT,\
+	MRL_TEXTURE_FORMAT_RGBA32_F,\
+	NULL,\
+})
+
+	struct mrl_texture_2d_array_update_desc_t
 	{
 		/// <summary>
-		///		The buffer should be read a lot and writen to rarely.
+		///		New texture data, with the data of each layer stored one after the other.
+		///		Compressed textures are updated in whole 4x4 blocks: the destination coordinates must be multiples of 4,
+		///		and so must the size, unless the region reaches the edge of the mip level.
 		/// </summary>
-		MRL_CONSTANT_BUFFER_USAGE_DEFAULT,
+		const void* data;
 
 		/// <summary>
-		///		Static buffer, data is read-only and cannot be changed. 
+		///		New data width.
 		/// </summary>
-		MRL_CONSTANT_BUFFER_USAGE_STATIC,
+		mgl_u64_t width;
 
 		/// <summary>
-		///		The buffer can be written to frequently and read a lot of times.
-		///		Allows mrl_map_constant_buffer to be used to update the buffer.
+		///		New data height.
 		/// </summary>
-		MRL_CONSTANT_BUFFER_USAGE_DYNAMIC,
+		mgl_u64_t height;
 
 		/// <summary>
-		///		Used for buffers that are updated every frame.
+		///		Number of layers to update.
 		/// </summary>
-		MRL_CONSTANT_BUFFER_USAGE_STREAM,
-	};
+		mgl_u64_t layer_count;
 
-	struct mrl_constant_buffer_desc_t
-	{
 		/// <summary>
-		///		Initial constant buffer data.
-		///		When the usage mode is not set to MRL_CONSTANT_BUFFER_USAGE_STATIC, this pointer can be set to NULL to create an empty buffer.
+		///		Destination X coordinate.
 		/// </summary>
-		const void* data;
+		mgl_u64_t dst_x;
 
 		/// <summary>
-		///		Constant buffer size.
+		///		Destination Y coordinate.
 		/// </summary>
-		mgl_u64_t size;
+		mgl_u64_t dst_y;
 
 		/// <summary>
-		///		Constant buffer usage mode.
-		///		Valid values:
-		///		- MRL_CONSTANT_BUFFER_USAGE_DEFAULT;
-		///		- MRL_CONSTANT_BUFFER_USAGE_STATIC;
-		///		- MRL_CONSTANT_BUFFER_USAGE_DYNAMIC;
-		///		- MRL_CONSTANT_BUFFER_USAGE_STREAM;
+		///		First layer to update.
 		/// </summary>
-		mgl_enum_t usage;
+		mgl_u64_t dst_layer;
 
 		/// <summary>
-		///		Hint list.
-		///		Hints may be ignored by some render devices.
-		///		Optional (can be NULL).
+		///		Mip level to update.
+		///		Valid values: 1 - MRL_MAX_MIP_LEVEL_COUNT;
 		/// </summary>
-		const mrl_hint_t* hints;
+		mgl_u32_t mip_level;
 	};
 
-#define MRL_DEFAULT_CONSTANT_BUFFER_DESC ((mrl_constant_buffer_desc_t) {\
+#define MRL_DEFAULT_TEXTURE_2D_ARRAY_UPDATE_DESC ((mrl_texture_2d_array_update_desc_t) {\
 	NULL,\
+	1,\
+	1,\
+	1,\
 	0,\
-	MRL_CONSTANT_BUFFER_USAGE_DEFAULT,\
-	NULL,\
+	0,\
+	0,\
+	1,\
 })
 
-	// ---- Index buffers ----
+	// ---- Cube map array ----
 
-	enum
+#define MRL_MAX_CUBE_MAP_ARRAY_LAYER_COUNT 256
+
+	struct mrl_cube_map_array_desc_t
 	{
 		/// <summary>
-		///		The buffer should be read a lot and writen to rarely.
+		///		Initial texture data.
+		///		To initialize a texture with NULL data, just set the pointer to NULL.
+		///		Each member of the array points to a mip level, being the first member the 0th mip level.
+		///		Each mip level stores the 6 faces of every cube map, one after the other, starting with the faces of the layer 0.
+		///		The faces of each layer are ordered like the MRL_CUBE_MAP_FACE_* values, so face f of layer l is the face number l * 6 + f.
+		///		Each mip level has half of the side of the previous one, rounded down, and never smaller than 1.
 		/// </summary>
-		MRL_INDEX_BUFFER_USAGE_DEFAULT,
+		const void* data[MRL_MAX_MIP_LEVEL_COUNT];
 
 		/// <summary>
-		///		Static buffer, data is read-only and cannot be changed. 
+		///		Texture mip level count.
+		///		Valid values: 1 - MRL_MAX_MIP_LEVEL_COUNT, and no more than the levels needed to reach a single texel;
+		///		The whole mip chain is allocated when the texture is created.
 		/// </summary>
-		MRL_INDEX_BUFFER_USAGE_STATIC,
+		mgl_u32_t mip_level_count;
 
 		/// <summary>
-		///		The buffer can be written to frequently and read a lot of times.
-		///		Allows mrl_map_index_buffer to be used to update the buffer.
+		///		Cube map face width.
 		/// </summary>
-		MRL_INDEX_BUFFER_USAGE_DYNAMIC,
+		mgl_u64_t width;
 
 		/// <summary>
-		///		Used for buffers that are updated every frame.
+		///		Cube map face height.
 		/// </summary>
-		MRL_INDEX_BUFFER_USAGE_STREAM,
-	};
-
-	enum
-	{
-		MRL_INDEX_BUFFER_FORMAT_U16,
-		MRL_INDEX_BUFFER_FORMAT_U32,
-	};
+		mgl_u64_t height;
 
-	struct mrl_index_buffer_desc_t
-	{
 		/// <summary>
-		///		Initial index buffer data.
-		///		When the usage mode is not set to MRL_INDEX_BUFFER_USAGE_STATIC, this pointer can be set to NULL to create an empty buffer.
+		///		Number of cube maps in the array.
+		///		Valid values: 1 - MRL_MAX_CUBE_MAP_ARRAY_LAYER_COUNT;
 		/// </summary>
-		const void* data;
+		mgl_u64_t layer_count;
 
 		/// <summary>
-		///		Index buffer size.
+		///		Texture usage mode.
+		///		Valid values:
+		///		- MRL_TEXTURE_USAGE_DEFAULT;
 		/// </summary>
-		mgl_u64_t size;
+		mgl_enum_t usage;
 
 		/// <summary>
-		///		Index buffer usage mode.
+		///		Texture data format.
 		///		Valid values:
-		///		- MRL_INDEX_BUFFER_USAGE_DEFAULT;
+		///			- All R, RG, RGBA and compressed formats except the depth and stencil component formats.
+		/// </summary>
+		mgl_enum_t format;
+
+		/// <summary>
+		///		Hint list.
+		///		Hints may be ignored by some render devices.
+		///		Optional (can be NULL).
+		/// </summary>
+		const mrl_hint_t* hints;
+	};
+
+#define MRL_DEFAULT_CUBE_MAP_ARRAY_DESC ((mrl_cube_map_array_desc_t) {\
+	{ NULL },\
+	1,\
+	256,\
+	256,\
+	1,\
+	MRL_TEXTURE_USAGE_DEFAULT,\
+	MRL_TEXTURE_FORMAT_RGBA32_F,\
+	NULL,\
+})
+
+	struct mrl_cube_map_array_update_desc_t
+	{
+		/// <summary>
+		///		New face data, with the data of each face stored one after the other.
+		///		Compressed cube map arrays are updated in whole 4x4 blocks, like 2D textures.
+		/// </summary>
+		const void* data;
+
+		/// <summary>
+		///		New data width.
+		/// </summary>
+		mgl_u64_t width;
+
+		/// <summary>
+		///		New data height.
+		/// </summary>
+		mgl_u64_t height;
+
+		/// <summary>
+		///		Number of faces to update, which may span multiple layers.
+		/// </summary>
+		mgl_u64_t face_count;
+
+		/// <summary>
+		///		Destination X coordinate.
+		/// </summary>
+		mgl_u64_t dst_x;
+
+		/// <summary>
+		///		Destination Y coordinate.
+		/// </summary>
+		mgl_u64_t dst_y;
+
+		/// <summary>
+		///		First face to update, counting the faces of every layer (face f of layer l is the face number l * 6 + f).
+		/// </summary>
+		mgl_u64_t dst_face;
+
+		/// <summary>
+		///		Mip level to update.
+		///		Valid values: 1 - MRL_MAX_MIP_LEVEL_COUNT;
+		/// </summary>
+		mgl_u32_t mip_level;
+	};
+
+#define MRL_DEFAULT_CUBE_MAP_ARRAY_UPDATE_DESC ((mrl_cube_map_array_update_desc_t) {\
+	NULL,\
+	1,\
+	1,\
+	6,\
+	0,\
+	0,\
+	0,\
+	1,\
+})
+
+	// ---- Buffer map flags ----
+
+	enum
+	{
+		/// <summary>
+		///		The mapped range can be read from.
+		/// </summary>
+		MRL_MAP_READ = 0x01,
+
+		/// <summary>
+		///		The mapped range can be written to.
+		/// </summary>
+		MRL_MAP_WRITE = 0x02,
+
+		/// <summary>
+		///		The previous contents of the mapped range may be discarded.
+		///		Cannot be used with MRL_MAP_READ.
+		/// </summary>
+		MRL_MAP_DISCARD_RANGE = 0x04,
+
+		/// <summary>
+		///		The previous contents of the whole buffer may be discarded.
+		///		Cannot be used with MRL_MAP_READ.
+		/// </summary>
+		MRL_MAP_DISCARD_WHOLE = 0x08,
+
+		/// <summary>
+		///		The user guarantees that the mapped range isn't being used by pending draw calls,
+		///		so the device doesn't need to synchronize with the GPU.
+		///		Cannot be used with MRL_MAP_READ.
+		/// </summary>
+		MRL_MAP_NO_OVERWRITE = 0x10,
+
+		/// <summary>
+		///		Writes are only made visible when flushed with the mrl_flush_*_buffer_range functions.
+		///		Requires MRL_MAP_WRITE.
+		/// </summary>
+		MRL_MAP_FLUSH_EXPLICIT = 0x20,
+	};
+
+	// ---- Constant buffers ----
+
+#define MRL_MAX_CONSTANT_BUFFER_ELEMENT_NAME_SIZE 64
+#define MRL_MAX_CONSTANT_BUFFER_ELEMENT_COUNT 32
+
+	enum
+	{
+		MRL_CONSTANT_BUFFER_MEMBER_I32,
+		MRL_CONSTANT_BUFFER_MEMBER_U32,
+		MRL_CONSTANT_BUFFER_MEMBER_F32,
+
+		MRL_CONSTANT_BUFFER_MEMBER_I32V2,
+		MRL_CONSTANT_BUFFER_MEMBER_I32V3,
+		MRL_CONSTANT_BUFFER_MEMBER_I32V4,
+		MRL_CONSTANT_BUFFER_MEMBER_U32V2,
+		MRL_CONSTANT_BUFFER_MEMBER_U32V3,
+		MRL_CONSTANT_BUFFER_MEMBER_U32V4,
+		MRL_CONSTANT_BUFFER_MEMBER_F32V2,
+		MRL_CONSTANT_BUFFER_MEMBER_F32V3,
+		MRL_CONSTANT_BUFFER_MEMBER_F32V4,
+
+		MRL_CONSTANT_BUFFER_MEMBER_F32M2X2,
+		MRL_CONSTANT_BUFFER_MEMBER_F32M2X3,
+		MRL_CONSTANT_BUFFER_MEMBER_F32M2X4,
+		MRL_CONSTANT_BUFFER_MEMBER_F32M3X2,
+		MRL_CONSTANT_BUFFER_MEMBER_F32M3X3,
+		MRL_CONSTANT_BUFFER_MEMBER_F32M3X4,
+		MRL_CONSTANT_BUFFER_MEMBER_F32M4X2,
+		MRL_CONSTANT_BUFFER_MEMBER_F32M4X3,
+		MRL_CONSTANT_BUFFER_MEMBER_F32M4X4,
+	};
+
+	struct mrl_constant_buffer_structure_element_t
+	{
+		/// <summary>
+		///		Name of the element.
+		/// </summary>
+		mgl_chr8_t name[MRL_MAX_CONSTANT_BUFFER_ELEMENT_NAME_SIZE];
+
+		/// <summary>
+		///		The byte offset into the beginning of the buffer for this element.
+		/// </summary>
+		mgl_u64_t offset;
+
+		/// <summary>
+		///		Size of the element.
+		///		For non-arrays, this value is set to 1.
+		///		For arrays, this is the length of the array.
+		/// </summary>
+		mgl_u64_t size;
+
+		/// <summary>
+		///		Stride between each array element.
+		/// </summary>
+		mgl_u64_t array_stride;
+	};
+
+	struct mrl_constant_buffer_structure_t
+	{
+		/// <summary>
+		///		Size of the buffer.
+		/// </summary>
+		mgl_u64_t size;
+
+		/// <summary>
+		///		Number of elements.
+		/// </summary>
+		mgl_u64_t element_count;
+
+		/// <summary>
+		///		Buffer elements.
+		/// </summary>
+		mrl_constant_buffer_structure_element_t elements[MRL_MAX_CONSTANT_BUFFER_ELEMENT_COUNT];
+	};
+
+	enum
+	{
+		/// <summary>
+		///		The buffer should be read a lot and writen to rarely.
+		/// </summary>
+		MRL_CONSTANT_BUFFER_USAGE_DEFAULT,
+
+		/// <summary>
+		///		Static buffer, data is read-only and cannot be changed. 
+		/// </summary>
+		MRL_CONSTANT_BUFFER_USAGE_STATIC,
+
+		/// <summary>
+		///		The buffer can be written to frequently and read a lot of times.
+		///		Allows mrl_map_constant_buffer to be used to update the buffer.
+		/// </summary>
+		MRL_CONSTANT_BUFFER_USAGE_DYNAMIC,
+
+		/// <summary>
+		///		Used for buffers that are updated every frame.
+		/// </summary>
+		MRL_CONSTANT_BUFFER_USAGE_STREAM,
+	};
+
+	struct mrl_constant_buffer_desc_t
+	{
+		/// <summary>
+		///		Initial constant buffer data.
+		///		When the usage mode is not set to MRL_CONSTANT_BUFFER_USAGE_STATIC, this pointer can be set to NULL to create an empty buffer.
+		/// </summary>
+		const void* data;
+
+		/// <summary>
+		///		Constant buffer size.
+		/// </summary>
+		mgl_u64_t size;
+
+		/// <summary>
+		///		Constant buffer usage mode.
+		///		Valid values:
+		///		- MRL_CONSTANT_BUFFER_USAGE_DEFAULT;
+		///		- MRL_CONSTANT_BUFFER_USAGE_STATIC;
+		///		- MRL_CONSTANT_BUFFER_USAGE_DYNAMIC;
+		///		- MRL_CONSTANT_BUFFER_USAGE_STREAM;
+		/// </summary>
+		mgl_enum_t usage;
+
+		/// <summary>
+		///		Hint list.
+		///		Hints may be ignored by some render devices.
+		///		Optional (can be NULL).
+		/// </summary>
+		const mrl_hint_t* hints;
+	};
+
+#define MRL_DEFAULT_CONSTANT_BUFFER_DESC ((mrl_constant_buffer_desc_t) {\
+	NULL,\
+	0,\
+	MRL_CONSTANT_BUFFER_USAGE_DEFAULT,\
+	NULL,\
+})
+
+	// ---- Index buffers ----
+
+	enum
+	{
+		/// <summary>
+		///		The buffer should be read a lot and writen to rarely.
+		/// </summary>
+		MRL_INDEX_BUFFER_USAGE_DEFAULT,
+
+		/// <summary>
+		///		Static buffer, data is read-only and cannot be changed. 
+		/// </summary>
+		MRL_INDEX_BUFFER_USAGE_STATIC,
+
+		/// <summary>
+		///		The buffer can be written to frequently and read a lot of times.
+		///		Allows mrl_map_index_buffer to be used to update the buffer.
+		/// </summary>
+		MRL_INDEX_BUFFER_USAGE_DYNAMIC,
+
+		/// <summary>
+		///		Used for buffers that are updated every frame.
+		/// </summary>
+		MRL_INDEX_BUFFER_USAGE_STREAM,
+	};
+
+	enum
+	{
+		MRL_INDEX_BUFFER_FORMAT_U16,
+		MRL_INDEX_BUFFER_FORMAT_U32,
+	};
+
+	struct mrl_index_buffer_desc_t
+	{
+		/// <summary>
+		///		Initial index buffer data.
+		///		When the usage mode is not set to MRL_INDEX_BUFFER_USAGE_STATIC, this pointer can be set to NULL to create an empty buffer.
+		/// </summary>
+		const void* data;
+
+		/// <summary>
+		///		Index buffer size.
+		/// </summary>
+		mgl_u64_t size;
+
+		/// <summary>
+		///		Index buffer usage mode.
+		///		Valid values:
+		///		- MRL_INDEX_BUFFER_USAGE_DEFAULT;
 		///		- MRL_INDEX_BUFFER_USAGE_STATIC;
 		///		- MRL_INDEX_BUFFER_USAGE_DYNAMIC;
 		///		- MRL_INDEX_BUFFER_USAGE_STREAM;
@@ -1679,6 +2149,126 @@ extern "C" {
 	NULL,\
 })
 
+	// ---- Indirect buffers ----
+
+	enum
+	{
+		/// <summary>
+		///		The buffer should be read a lot and writen to rarely.
+		/// </summary>
+		MRL_INDIRECT_BUFFER_USAGE_DEFAULT,
+
+		/// <summary>
+		///		Static buffer, data is read-only and cannot be changed. 
+		/// </summary>
+		MRL_INDIRECT_BUFFER_USAGE_STATIC,
+
+		/// <summary>
+		///		The buffer can be written to frequently and read a lot of times.
+		/// </summary>
+		MRL_INDIRECT_BUFFER_USAGE_DYNAMIC,
+
+		/// <summary>
+		///		Used for buffers that are updated every frame.
+		/// </summary>
+		MRL_INDIRECT_BUFFER_USAGE_STREAM,
+	};
+
+	struct mrl_indirect_buffer_desc_t
+	{
+		/// <summary>
+		///		Initial indirect buffer data, made of mrl_draw_indirect_args_t or mrl_draw_indexed_indirect_args_t structures.
+		///		When the usage mode is not set to MRL_INDIRECT_BUFFER_USAGE_STATIC, this pointer can be set to NULL to create an empty buffer.
+		/// </summary>
+		const void* data;
+
+		/// <summary>
+		///		Indirect buffer size.
+		/// </summary>
+		mgl_u64_t size;
+
+		/// <summary>
+		///		Indirect buffer usage mode.
+		///		Valid values:
+		///		- MRL_INDIRECT_BUFFER_USAGE_DEFAULT;
+		///		- MRL_INDIRECT_BUFFER_USAGE_STATIC;
+		///		- MRL_INDIRECT_BUFFER_USAGE_DYNAMIC;
+		///		- MRL_INDIRECT_BUFFER_USAGE_STREAM;
+		/// </summary>
+		mgl_enum_t usage;
+
+		/// <summary>
+		///		Hint list.
+		///		Hints may be ignored by some render devices.
+		///		Optional (can be NULL).
+		/// </summary>
+		const mrl_hint_t* hints;
+	};
+
+#define MRL_DEFAULT_INDIRECT_BUFFER_DESC ((mrl_indirect_buffer_desc_t) {\
+	NULL,\
+	0,\
+	MRL_INDIRECT_BUFFER_USAGE_DEFAULT,\
+	NULL,\
+})
+
+	/// <summary>
+	///		Arguments of a non indexed indirect draw, with the same layout as the OpenGL DrawArraysIndirectCommand.
+	/// </summary>
+	struct mrl_draw_indirect_args_t
+	{
+		/// <summary>
+		///		Number of vertices drawn.
+		/// </summary>
+		mgl_u32_t count;
+
+		/// <summary>
+		///		Number of instances drawn.
+		/// </summary>
+		mgl_u32_t instance_count;
+
+		/// <summary>
+		///		First vertex drawn.
+		/// </summary>
+		mgl_u32_t first;
+
+		/// <summary>
+		///		Must be 0.
+		/// </summary>
+		mgl_u32_t reserved;
+	};
+
+	/// <summary>
+	///		Arguments of an indexed indirect draw, with the same layout as the OpenGL DrawElementsIndirectCommand.
+	/// </summary>
+	struct mrl_draw_indexed_indirect_args_t
+	{
+		/// <summary>
+		///		Number of indices drawn.
+		/// </summary>
+		mgl_u32_t count;
+
+		/// <summary>
+		///		Number of instances drawn.
+		/// </summary>
+		mgl_u32_t instance_count;
+
+		/// <summary>
+		///		First index drawn, counted in indices (not bytes).
+		/// </summary>
+		mgl_u32_t first_index;
+
+		/// <summary>
+		///		Value added to every index before fetching the vertex.
+		/// </summary>
+		mgl_i32_t base_vertex;
+
+		/// <summary>
+		///		Must be 0.
+		/// </summary>
+		mgl_u32_t reserved;
+	};
+
 	// ---- Vertex buffers ----
 
 	enum
@@ -1807,6 +2397,13 @@ extern "C" {
 			mgl_u32_t index;
 		} buffer;
 
+		/// <summary>
+		///		Number of instances drawn before the element advances to its next value.
+		///		If 0, the element advances once per vertex. Otherwise, it is an instance element, which allows
+		///		per instance data such as transforms to be read from vertex buffers on instanced draws.
+		/// </summary>
+		mgl_u32_t instance_step_rate;
+
 		/// <summary>
 		///		Hint list.
 		///		Hints may be ignored by some render devices.
@@ -1824,6 +2421,7 @@ extern "C" {
 		0,\
 		0,\
 	},\
+	0,\
 	NULL,\
 })
 
@@ -1850,9 +2448,77 @@ extern "C" {
 		mrl_vertex_buffer_t* buffers[MRL_MAX_VERTEX_ARRAY_BUFFER_COUNT];
 
 		/// <summary>
-		///		Shader pipeline used with this vertex array.
+		///		Shader pipeline used with this vertex array.
+		/// </summary>
+		mrl_shader_pipeline_t* shader_pipeline;
+
+		/// <summary>
+		///		Hint list.
+		///		Hints may be ignored by some render devices.
+		///		Optional (can be NULL).
+		/// </summary>
+		const mrl_hint_t* hints;
+	};
+
+#define MRL_DEFAULT_VERTEX_ARRAY_DESC ((mrl_vertex_array_desc_t) {\
+	0,\
+	0,\
+	{ MRL_DEFAULT_VERTEX_ELEMENT },\
+	{ NULL },\
+	NULL,\
+	NULL,\
+})
+
+	// ---- Stream allocators ----
+
+	enum
+	{
+		MRL_STREAM_ALLOCATOR_BUFFER_VERTEX,
+		MRL_STREAM_ALLOCATOR_BUFFER_INDEX,
+		MRL_STREAM_ALLOCATOR_BUFFER_CONSTANT,
+	};
+
+	struct mrl_stream_allocator_desc_t
+	{
+		/// <summary>
+		///		Type of the buffer the allocator sub-allocates from.
+		///		Valid values:
+		///		- MRL_STREAM_ALLOCATOR_BUFFER_VERTEX;
+		///		- MRL_STREAM_ALLOCATOR_BUFFER_INDEX;
+		///		- MRL_STREAM_ALLOCATOR_BUFFER_CONSTANT;
+		/// </summary>
+		mgl_enum_t buffer_type;
+
+		/// <summary>
+		///		Buffer used as the ring buffer (a vertex, index or constant buffer, depending on the buffer type).
+		///		The buffer should be created with the stream usage mode, and must outlive the allocator.
+		///		Its whole size is used by the allocator, so it must be big enough to hold a few frames of data.
+		/// </summary>
+		void* buffer;
+
+		/// <summary>
+		///		Hint list.
+		///		Hints may be ignored by some render devices.
+		///		Optional (can be NULL).
+		/// </summary>
+		const mrl_hint_t* hints;
+	};
+
+#define MRL_DEFAULT_STREAM_ALLOCATOR_DESC ((mrl_stream_allocator_desc_t) {\
+	MRL_STREAM_ALLOCATOR_BUFFER_VERTEX,\
+	NULL,\
+	NULL,\
+})
+
+	// ---- Upload queues ----
+
+	struct mrl_upload_queue_desc_t
+	{
+		/// <summary>
+		///		Size in bytes of the staging memory the texel data is copied to.
+		///		Uploads bigger than this size are still performed, but without staging (as with mrl_update_texture_2d).
 		/// </summary>
-		mrl_shader_pipeline_t* shader_pipeline;
+		mgl_u64_t size;
 
 		/// <summary>
 		///		Hint list.
@@ -1862,12 +2528,8 @@ extern "C" {
 		const mrl_hint_t* hints;
 	};
 
-#define MRL_DEFAULT_VERTEX_ARRAY_DESC ((mrl_vertex_array_desc_t) {\
-	0,\
-	0,\
-	{ MRL_DEFAULT_VERTEX_ELEMENT },\
-	{ NULL },\
-	NULL,\
+#define MRL_DEFAULT_UPLOAD_QUEUE_DESC ((mrl_upload_queue_desc_t) {\
+	16 * 1024 * 1024,\
 	NULL,\
 })
 
@@ -1914,6 +2576,12 @@ extern "C" {
 		///		MRSL shaders (Magma Rendering Shading Language).
 		/// </summary>
 		MRL_SHADER_SOURCE_MRSL,
+
+		/// <summary>
+		///		Native C functions (the source points to a mrl_sw_shader_desc_t).
+		///		Only supported by the software render device.
+		/// </summary>
+		MRL_SHADER_SOURCE_NATIVE,
 	};
 
 	struct mrl_shader_stage_desc_t
@@ -1934,6 +2602,7 @@ extern "C" {
 		///		- MRL_SHADER_SOURCE_HLSL;
 		///		- MRL_SHADER_SOURCE_MSL;
 		///		- MRL_SHADER_SOURCE_MRLS;
+		///		- MRL_SHADER_SOURCE_NATIVE;
 		/// 
 		///		Some source types may not be supported by a render device.
 		///		If a shader source type is not supported, the error MRL_ERROR_UNSUPPORTED_SHADER_SOURCE is returned.
@@ -2007,6 +2676,8 @@ extern "C" {
 		/// <summary>
 		///		Window where the render context will be created on.
 		///		If the window type is unsupported, MRL_ERROR_UNSUPPORTED_WINDOW is returned on device creation.
+		///		If NULL, a headless device is created, which renders to an offscreen default framebuffer
+		///		(see MRL_HINT_RENDER_DEVICE_OFFSCREEN_SIZE). Headless devices aren't supported on every platform.
 		/// </summary>
 		void* window;
 
@@ -2022,80 +2693,107 @@ extern "C" {
 		mgl_enum_t vsync_mode;
 
 		/// <summary>
-		///		Maximum number of framebuffers.
+		///		Number of framebuffers reserved when the device is created.
+		///		Objects are kept in pools which grow when they run out of space, so this isn't a hard limit.
+		///		The number of objects alive can be checked with mrl_get_object_pool_stats.
 		/// </summary>
 		mgl_u64_t max_framebuffer_count;
 
 		/// <summary>
-		///		Maximum number of raster states.
+		///		Number of raster states reserved when the device is created.
 		/// </summary>
 		mgl_u64_t max_raster_state_count;
 
 		/// <summary>
-		///		Maximum number of depth stencil states.
+		///		Number of depth stencil states reserved when the device is created.
 		/// </summary>
 		mgl_u64_t max_depth_stencil_state_count;
 
 		/// <summary>
-		///		Maximum number of blend states.
+		///		Number of blend states reserved when the device is created.
 		/// </summary>
 		mgl_u64_t max_blend_state_count;
 
 		/// <summary>
-		///		Maximum number of samplers.
+		///		Number of samplers reserved when the device is created.
 		/// </summary>
 		mgl_u64_t max_sampler_count;
 
 		/// <summary>
-		///		Maximum number of 1D textures.
+		///		Number of 1D textures reserved when the device is created.
 		/// </summary>
 		mgl_u64_t max_texture_1d_count;
 
 		/// <summary>
-		///		Maximum number of 2D textures.
+		///		Number of 2D textures reserved when the device is created.
 		/// </summary>
 		mgl_u64_t max_texture_2d_count;
 
 		/// <summary>
-		///		Maximum number of 3D textures.
+		///		Number of 3D textures reserved when the device is created.
 		/// </summary>
 		mgl_u64_t max_texture_3d_count;
 
 		/// <summary>
-		///		Maximum number of cube maps.
+		///		Number of cube maps reserved when the device is created.
 		/// </summary>
 		mgl_u64_t max_cube_map_count;
 
 		/// <summary>
-		///		Maximum number of constant buffers.
+		///		Number of constant buffers reserved when the device is created.
 		/// </summary>
 		mgl_u64_t max_constant_buffer_count;
 
 		/// <summary>
-		///		Maximum number of index buffers.
+		///		Number of index buffers reserved when the device is created.
 		/// </summary>
 		mgl_u64_t max_index_buffer_count;
 
 		/// <summary>
-		///		Maximum number of vertex buffers.
+		///		Number of vertex buffers reserved when the device is created.
 		/// </summary>
 		mgl_u64_t max_vertex_buffer_count;
 
 		/// <summary>
-		///		Maximum number of vertex arrays.
+		///		Number of vertex arrays reserved when the device is created.
 		/// </summary>
 		mgl_u64_t max_vertex_array_count;
 
 		/// <summary>
-		///		Maximum number of shader stages.
+		///		Number of shader stages reserved when the device is created.
 		/// </summary>
 		mgl_u64_t max_shader_stage_count;
 
 		/// <summary>
-		///		Maximum number of shader pipelines.
+		///		Number of shader pipelines reserved when the device is created.
 		/// </summary>
 		mgl_u64_t max_shader_pipeline_count;
 
+		/// <summary>
+		///		Number of stream allocators reserved when the device is created.
+		/// </summary>
+		mgl_u64_t max_stream_allocator_count;
+
+		/// <summary>
+		///		Number of indirect buffers reserved when the device is created.
+		/// </summary>
+		mgl_u64_t max_indirect_buffer_count;
+
+		/// <summary>
+		///		Number of upload queues reserved when the device is created.
+		/// </summary>
+		mgl_u64_t max_upload_queue_count;
+
+		/// <summary>
+		///		Number of 2D texture arrays reserved when the device is created.
+		/// </summary>
+		mgl_u64_t max_texture_2d_array_count;
+
+		/// <summary>
+		///		Number of cube map arrays reserved when the device is created.
+		/// </summary>
+		mgl_u64_t max_cube_map_array_count;
+
 		/// <summary>
 		///		Hint list.
 		///		Hints may be ignored by some render devices.
@@ -2123,9 +2821,59 @@ extern "C" {
 	256,\
 	1024,\
 	512,\
+	64,\
+	64,\
+	16,\
+	256,\
+	64,\
 	NULL,\
 })
 
+	// ---- Object pools ----
+
+	enum
+	{
+		MRL_OBJECT_FRAMEBUFFER,
+		MRL_OBJECT_RASTER_STATE,
+		MRL_OBJECT_DEPTH_STENCIL_STATE,
+		MRL_OBJECT_BLEND_STATE,
+		MRL_OBJECT_SAMPLER,
+		MRL_OBJECT_TEXTURE_1D,
+		MRL_OBJECT_TEXTURE_2D,
+		MRL_OBJECT_TEXTURE_3D,
+		MRL_OBJECT_CUBE_MAP,
+		MRL_OBJECT_CONSTANT_BUFFER,
+		MRL_OBJECT_INDEX_BUFFER,
+		MRL_OBJECT_VERTEX_BUFFER,
+		MRL_OBJECT_VERTEX_ARRAY,
+		MRL_OBJECT_SHADER_STAGE,
+		MRL_OBJECT_SHADER_PIPELINE,
+		MRL_OBJECT_STREAM_ALLOCATOR,
+		MRL_OBJECT_INDIRECT_BUFFER,
+		MRL_OBJECT_UPLOAD_QUEUE,
+		MRL_OBJECT_TEXTURE_2D_ARRAY,
+		MRL_OBJECT_CUBE_MAP_ARRAY,
+	};
+
+	typedef struct
+	{
+		/// <summary>
+		///		Number of objects currently alive.
+		/// </summary>
+		mgl_u64_t count;
+
+		/// <summary>
+		///		Highest number of objects alive at the same time since the device was created.
+		///		Useful to tune the reserved counts in the render device description.
+		/// </summary>
+		mgl_u64_t high_water_mark;
+
+		/// <summary>
+		///		Number of objects which fit in the memory currently owned by the pool.
+		/// </summary>
+		mgl_u64_t capacity;
+	} mrl_object_pool_stats_t;
+
 	typedef struct mrl_render_device_t mrl_render_device_t;
 	struct mrl_render_device_t
 	{
@@ -2182,12 +2930,29 @@ extern "C" {
 		void(*bind_cube_map)(mrl_render_device_t* rd, mrl_shader_binding_point_t* bp, mrl_cube_map_t* cb);
 		mrl_error_t(*update_cube_map)(mrl_render_device_t* rd, mrl_cube_map_t* cb, const mrl_cube_map_update_desc_t* desc);
 
+		// ------- Texture 2D array functions -------
+		mrl_error_t(*create_texture_2d_array)(mrl_render_device_t* rd, mrl_texture_2d_array_t** tex, const mrl_texture_2d_array_desc_t* desc);
+		void(*destroy_texture_2d_array)(mrl_render_device_t* rd, mrl_texture_2d_array_t* tex);
+		void(*generate_texture_2d_array_mipmaps)(mrl_render_device_t* rd, mrl_texture_2d_array_t* tex);
+		void(*bind_texture_2d_array)(mrl_render_device_t* rd, mrl_shader_binding_point_t* bp, mrl_texture_2d_array_t* tex);
+		mrl_error_t(*update_texture_2d_array)(mrl_render_device_t* rd, mrl_texture_2d_array_t* tex, const mrl_texture_2d_array_update_desc_t* desc);
+
+		// ------- Cube map array functions -------
+		mrl_error_t(*create_cube_map_array)(mrl_render_device_t* rd, mrl_cube_map_array_t** tex, const mrl_cube_map_array_desc_t* desc);
+		void(*destroy_cube_map_array)(mrl_render_device_t* rd, mrl_cube_map_array_t* tex);
+		void(*generate_cube_map_array_mipmaps)(mrl_render_device_t* rd, mrl_cube_map_array_t* tex);
+		void(*bind_cube_map_array)(mrl_render_device_t* rd, mrl_shader_binding_point_t* bp, mrl_cube_map_array_t* tex);
+		mrl_error_t(*update_cube_map_array)(mrl_render_device_t* rd, mrl_cube_map_array_t* tex, const mrl_cube_map_array_update_desc_t* desc);
+
 		// ------- Constant buffer functions -------
 		mrl_error_t(*create_constant_buffer)(mrl_render_device_t* rd, mrl_constant_buffer_t** cb, const mrl_constant_buffer_desc_t* desc);
 		void(*destroy_constant_buffer)(mrl_render_device_t* rd, mrl_constant_buffer_t* cb);
 		void(*bind_constant_buffer)(mrl_render_device_t* rd, mrl_shader_binding_point_t* bp, mrl_constant_buffer_t* cb);
+		void(*bind_constant_buffer_range)(mrl_render_device_t* rd, mrl_shader_binding_point_t* bp, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size);
 		void*(*map_constant_buffer)(mrl_render_device_t* rd, mrl_constant_buffer_t* cb);
 		void(*unmap_constant_buffer)(mrl_render_device_t* rd, mrl_constant_buffer_t* cb);
+		void*(*map_constant_buffer_range)(mrl_render_device_t* rd, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size, mgl_u32_t flags);
+		void(*flush_constant_buffer_range)(mrl_render_device_t* rd, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size);
 		void(*update_constant_buffer)(mrl_render_device_t* rd, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size, const void* data);
 		void(*query_constant_buffer_structure)(mrl_render_device_t* rd, mrl_shader_binding_point_t* bp, mrl_constant_buffer_structure_t* cbs);
 
@@ -2197,13 +2962,22 @@ extern "C" {
 		void(*set_index_buffer)(mrl_render_device_t* rd, mrl_index_buffer_t* ib);
 		void*(*map_index_buffer)(mrl_render_device_t* rd, mrl_index_buffer_t* ib);
 		void(*unmap_index_buffer)(mrl_render_device_t* rd, mrl_index_buffer_t* ib);
+		void*(*map_index_buffer_range)(mrl_render_device_t* rd, mrl_index_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size, mgl_u32_t flags);
+		void(*flush_index_buffer_range)(mrl_render_device_t* rd, mrl_index_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size);
 		void(*update_index_buffer)(mrl_render_device_t* rd, mrl_index_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size, const void* data);
 
+		// ------- Indirect buffer functions -------
+		mrl_error_t(*create_indirect_buffer)(mrl_render_device_t* rd, mrl_indirect_buffer_t** ib, const mrl_indirect_buffer_desc_t* desc);
+		void(*destroy_indirect_buffer)(mrl_render_device_t* rd, mrl_indirect_buffer_t* ib);
+		void(*update_indirect_buffer)(mrl_render_device_t* rd, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size, const void* data);
+
 		// ------- Vertex buffer functions -------
 		mrl_error_t(*create_vertex_buffer)(mrl_render_device_t* rd, mrl_vertex_buffer_t** vb, const mrl_vertex_buffer_desc_t* desc);
 		void(*destroy_vertex_buffer)(mrl_render_device_t* rd, mrl_vertex_buffer_t* vb);
 		void*(*map_vertex_buffer)(mrl_render_device_t* rd, mrl_vertex_buffer_t* vb);
 		void(*unmap_vertex_buffer)(mrl_render_device_t* rd, mrl_vertex_buffer_t* vb);
+		void*(*map_vertex_buffer_range)(mrl_render_device_t* rd, mrl_vertex_buffer_t* vb, mgl_u64_t offset, mgl_u64_t size, mgl_u32_t flags);
+		void(*flush_vertex_buffer_range)(mrl_render_device_t* rd, mrl_vertex_buffer_t* vb, mgl_u64_t offset, mgl_u64_t size);
 		void(*update_vertex_buffer)(mrl_render_device_t* rd, mrl_vertex_buffer_t* vb, mgl_u64_t offset, mgl_u64_t size, const void* data);
 
 		// ------- Vertex array functions -------
@@ -2211,6 +2985,23 @@ extern "C" {
 		void(*destroy_vertex_array)(mrl_render_device_t* rd, mrl_vertex_array_t* va);
 		void(*set_vertex_array)(mrl_render_device_t* rd, mrl_vertex_array_t* va);
 
+		// ------- Stream allocator functions -------
+		mrl_error_t(*create_stream_allocator)(mrl_render_device_t* rd, mrl_stream_allocator_t** sa, const mrl_stream_allocator_desc_t* desc);
+		void(*destroy_stream_allocator)(mrl_render_device_t* rd, mrl_stream_allocator_t* sa);
+		void*(*map_stream_allocation)(mrl_render_device_t* rd, mrl_stream_allocator_t* sa, mgl_u64_t size, mgl_u64_t alignment, mgl_u64_t* offset);
+		void(*unmap_stream_allocation)(mrl_render_device_t* rd, mrl_stream_allocator_t* sa);
+		void(*end_stream_allocator_frame)(mrl_render_device_t* rd, mrl_stream_allocator_t* sa);
+
+		// ------- Upload queue functions -------
+		mrl_error_t(*create_upload_queue)(mrl_render_device_t* rd, mrl_upload_queue_t** uq, const mrl_upload_queue_desc_t* desc);
+		void(*destroy_upload_queue)(mrl_render_device_t* rd, mrl_upload_queue_t* uq);
+		mrl_error_t(*upload_texture_1d)(mrl_render_device_t* rd, mrl_upload_queue_t* uq, mrl_texture_1d_t* tex, const mrl_texture_1d_update_desc_t* desc, mgl_u64_t* token);
+		mrl_error_t(*upload_texture_2d)(mrl_render_device_t* rd, mrl_upload_queue_t* uq, mrl_texture_2d_t* tex, const mrl_texture_2d_update_desc_t* desc, mgl_u64_t* token);
+		mrl_error_t(*upload_texture_3d)(mrl_render_device_t* rd, mrl_upload_queue_t* uq, mrl_texture_3d_t* tex, const mrl_texture_3d_update_desc_t* desc, mgl_u64_t* token);
+		mrl_error_t(*upload_cube_map)(mrl_render_device_t* rd, mrl_upload_queue_t* uq, mrl_cube_map_t* cb, const mrl_cube_map_update_desc_t* desc, mgl_u64_t* token);
+		mgl_bool_t(*is_upload_complete)(mrl_render_device_t* rd, mrl_upload_queue_t* uq, mgl_u64_t token);
+		void(*wait_upload)(mrl_render_device_t* rd, mrl_upload_queue_t* uq, mgl_u64_t token);
+
 		// ------- Shader functions -------
 		mrl_error_t(*create_shader_stage)(mrl_render_device_t* rd, mrl_shader_stage_t** stage, const mrl_shader_stage_desc_t* desc);
 		void(*destroy_shader_stage)(mrl_render_device_t* rd, mrl_shader_stage_t* stage);
@@ -2218,6 +3009,7 @@ extern "C" {
 		void(*destroy_shader_pipeline)(mrl_render_device_t* rd, mrl_shader_pipeline_t* pipeline);
 		void(*set_shader_pipeline)(mrl_render_device_t* rd, mrl_shader_pipeline_t* pipeline);
 		mrl_shader_binding_point_t*(*get_shader_binding_point)(mrl_render_device_t* rd, mrl_shader_pipeline_t* pipeline, const mgl_chr8_t* name);
+		mrl_shader_binding_point_t*(*get_shader_binding_point_by_id)(mrl_render_device_t* rd, mrl_shader_pipeline_t* pipeline, mgl_u64_t id);
 
 		// -------- Draw functions --------
 		void(*clear_color)(mrl_render_device_t* rd, mgl_f32_t r, mgl_f32_t g, mgl_f32_t b, mgl_f32_t a);
@@ -2228,12 +3020,19 @@ extern "C" {
 		void(*draw_triangles_indexed)(mrl_render_device_t* rd, mgl_u64_t offset, mgl_u64_t count);
 		void(*draw_triangles_instanced)(mrl_render_device_t* rd, mgl_u64_t offset, mgl_u64_t count, mgl_u64_t instance_count);
 		void(*draw_triangles_indexed_instanced)(mrl_render_device_t* rd, mgl_u64_t offset, mgl_u64_t count, mgl_u64_t instance_count);
+		void(*draw_triangles_indexed_base_vertex)(mrl_render_device_t* rd, mgl_u64_t offset, mgl_u64_t count, mgl_i64_t base_vertex);
+		void(*draw_triangles_indexed_instanced_base_vertex)(mrl_render_device_t* rd, mgl_u64_t offset, mgl_u64_t count, mgl_u64_t instance_count, mgl_i64_t base_vertex);
+		void(*multi_draw_triangles)(mrl_render_device_t* rd, const mgl_u64_t* offsets, const mgl_u64_t* counts, mgl_u64_t draw_count);
+		void(*multi_draw_triangles_indexed)(mrl_render_device_t* rd, const mgl_u64_t* offsets, const mgl_u64_t* counts, const mgl_i64_t* base_vertices, mgl_u64_t draw_count);
+		void(*draw_triangles_indirect)(mrl_render_device_t* rd, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t draw_count);
+		void(*draw_triangles_indexed_indirect)(mrl_render_device_t* rd, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t draw_count);
 		void(*set_viewport)(mrl_render_device_t* rd, mgl_i32_t x, mgl_i32_t y, mgl_i32_t w, mgl_i32_t h);
 
 		// ----------- Getters -----------
 		const mgl_chr8_t*(*get_type_name)(mrl_render_device_t* rd);
 		mgl_i64_t(*get_property_i)(mrl_render_device_t* rd, mgl_enum_t name);
 		mgl_f64_t(*get_property_f)(mrl_render_device_t* rd, mgl_enum_t name);
+		void(*get_object_pool_stats)(mrl_render_device_t* rd, mgl_enum_t type, mrl_object_pool_stats_t* stats);
 	};
 
 	// ------- Framebuffer functions -------
@@ -2382,6 +3181,9 @@ extern "C" {
 
 	/// <summary>
 	///		Generates mipmaps for a texture 1D.
+	///		Only the mip levels allocated on creation are generated, so the texture must be created with the
+	///		mip_level_count of the whole chain; calling this on a texture created with a single mip level reports
+	///		MRL_ERROR_INVALID_PARAMS through the error callback, unless the texture is 1x1.
 	/// </summary>
 	/// <param name="rd">Render device</param>
 	/// <param name="tex">Texture 1D handle</param>
@@ -2424,6 +3226,9 @@ extern "C" {
 
 	/// <summary>
 	///		Generates mipmaps for a texture 2D.
+	///		Only the mip levels allocated on creation are generated, so the texture must be created with the
+	///		mip_level_count of the whole chain; calling this on a texture created with a single mip level reports
+	///		MRL_ERROR_INVALID_PARAMS through the error callback, unless the texture is 1x1.
 	/// </summary>
 	/// <param name="rd">Render device</param>
 	/// <param name="tex">Texture 2D handle</param>
@@ -2466,6 +3271,9 @@ extern "C" {
 
 	/// <summary>
 	///		Generates mipmaps for a texture 3D.
+	///		Only the mip levels allocated on creation are generated, so the texture must be created with the
+	///		mip_level_count of the whole chain; calling this on a texture created with a single mip level reports
+	///		MRL_ERROR_INVALID_PARAMS through the error callback, unless the texture is 1x1.
 	/// </summary>
 	/// <param name="rd">Render device</param>
 	/// <param name="tex">Texture 3D handle</param>
@@ -2508,6 +3316,9 @@ extern "C" {
 
 	/// <summary>
 	///		Generates mipmaps for a cube map.
+	///		Only the mip levels allocated on creation are generated, so the texture must be created with the
+	///		mip_level_count of the whole chain; calling this on a texture created with a single mip level reports
+	///		MRL_ERROR_INVALID_PARAMS through the error callback, unless the texture is 1x1.
 	/// </summary>
 	/// <param name="rd">Render device</param>
 	/// <param name="cb">Cube map handle</param>
@@ -2530,6 +3341,98 @@ extern "C" {
 	/// <returns>Error code</returns>
 	MRL_API mrl_error_t mrl_update_cube_map(mrl_render_device_t* rd, mrl_cube_map_t* cb, const mrl_cube_map_update_desc_t* desc);
 
+	// ------- Texture 2D array functions -------
+
+	/// <summary>
+	///		Creates a new 2D texture array.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="tex">Out texture handle</param>
+	/// <param name="desc">Description</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_create_texture_2d_array(mrl_render_device_t* rd, mrl_texture_2d_array_t** tex, const mrl_texture_2d_array_desc_t* desc);
+
+	/// <summary>
+	///		Destroys a 2D texture array.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="tex">Texture handle</param>
+	MRL_API void mrl_destroy_texture_2d_array(mrl_render_device_t* rd, mrl_texture_2d_array_t* tex);
+
+	/// <summary>
+	///		Generates mipmaps for every layer of a 2D texture array.
+	///		Only the mip levels allocated on creation are generated, so the texture must be created with the
+	///		mip_level_count of the whole chain; calling this on a texture created with a single mip level reports
+	///		MRL_ERROR_INVALID_PARAMS through the error callback, unless the texture is 1x1.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="tex">Texture handle</param>
+	MRL_API void mrl_generate_texture_2d_array_mipmaps(mrl_render_device_t* rd, mrl_texture_2d_array_t* tex);
+
+	/// <summary>
+	///		Binds a 2D texture array to a shader binding point.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="bp">Binding point</param>
+	/// <param name="tex">Texture handle</param>
+	MRL_API void mrl_bind_texture_2d_array(mrl_render_device_t* rd, mrl_shader_binding_point_t* bp, mrl_texture_2d_array_t* tex);
+
+	/// <summary>
+	///		Updates a range of layers of a 2D texture array.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="tex">Texture handle</param>
+	/// <param name="desc">Update description</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_update_texture_2d_array(mrl_render_device_t* rd, mrl_texture_2d_array_t* tex, const mrl_texture_2d_array_update_desc_t* desc);
+
+	// ------- Cube map array functions -------
+
+	/// <summary>
+	///		Creates a new cube map array.
+	///		Not every render device supports cube map arrays, which can be checked with the MRL_PROPERTY_CUBE_MAP_ARRAYS property.
+	///		If they aren't supported, MRL_ERROR_UNSUPPORTED_DEVICE is returned.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="tex">Out texture handle</param>
+	/// <param name="desc">Description</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_create_cube_map_array(mrl_render_device_t* rd, mrl_cube_map_array_t** tex, const mrl_cube_map_array_desc_t* desc);
+
+	/// <summary>
+	///		Destroys a cube map array.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="tex">Texture handle</param>
+	MRL_API void mrl_destroy_cube_map_array(mrl_render_device_t* rd, mrl_cube_map_array_t* tex);
+
+	/// <summary>
+	///		Generates mipmaps for every face of every layer of a cube map array.
+	///		Only the mip levels allocated on creation are generated, so the texture must be created with the
+	///		mip_level_count of the whole chain; calling this on a texture created with a single mip level reports
+	///		MRL_ERROR_INVALID_PARAMS through the error callback, unless the texture is 1x1.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="tex">Texture handle</param>
+	MRL_API void mrl_generate_cube_map_array_mipmaps(mrl_render_device_t* rd, mrl_cube_map_array_t* tex);
+
+	/// <summary>
+	///		Binds a cube map array to a shader binding point.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="bp">Binding point</param>
+	/// <param name="tex">Texture handle</param>
+	MRL_API void mrl_bind_cube_map_array(mrl_render_device_t* rd, mrl_shader_binding_point_t* bp, mrl_cube_map_array_t* tex);
+
+	/// <summary>
+	///		Updates a range of faces of a cube map array.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="tex">Texture handle</param>
+	/// <param name="desc">Update description</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_update_cube_map_array(mrl_render_device_t* rd, mrl_cube_map_array_t* tex, const mrl_cube_map_array_update_desc_t* desc);
+
 	// ------- Constant buffer functions -------
 
 	/// <summary>
@@ -2556,6 +3459,18 @@ extern "C" {
 	/// <param name="cb">Constant buffer handle</param>
 	MRL_API void mrl_bind_constant_buffer(mrl_render_device_t* rd, mrl_shader_binding_point_t* bp, mrl_constant_buffer_t* cb);
 
+	/// <summary>
+	///		Binds a range of a constant buffer to a shader binding point.
+	///		This allows the constants of many objects to be stored in a single buffer.
+	///		The offset must be a multiple of the MRL_PROPERTY_CONSTANT_BUFFER_OFFSET_ALIGNMENT property.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="bp">Shader binding point handle</param>
+	/// <param name="cb">Constant buffer handle</param>
+	/// <param name="offset">Range offset</param>
+	/// <param name="size">Range size</param>
+	MRL_API void mrl_bind_constant_buffer_range(mrl_render_device_t* rd, mrl_shader_binding_point_t* bp, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size);
+
 	/// <summary>
 	///		Maps an constant buffer.
 	/// </summary>
@@ -2571,6 +3486,27 @@ extern "C" {
 	/// <param name="cb">Constant buffer handle</param>
 	MRL_API void mrl_unmap_constant_buffer(mrl_render_device_t* rd, mrl_constant_buffer_t* cb);
 
+	/// <summary>
+	///		Maps a range of a constant buffer.
+	///		The range is unmapped with mrl_unmap_constant_buffer.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="cb">Constant buffer handle</param>
+	/// <param name="offset">Range offset</param>
+	/// <param name="size">Range size</param>
+	/// <param name="flags">Map flags (MRL_MAP_*)</param>
+	/// <returns>Pointer to the range data, or NULL on failure</returns>
+	MRL_API void* mrl_map_constant_buffer_range(mrl_render_device_t* rd, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size, mgl_u32_t flags);
+
+	/// <summary>
+	///		Flushes writes to part of a range mapped with MRL_MAP_FLUSH_EXPLICIT.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="cb">Constant buffer handle</param>
+	/// <param name="offset">Offset relative to the start of the mapped range</param>
+	/// <param name="size">Size of the flushed data</param>
+	MRL_API void mrl_flush_constant_buffer_range(mrl_render_device_t* rd, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size);
+
 	/// <summary>
 	///		Updates an constant buffer data.
 	/// </summary>
@@ -2629,6 +3565,27 @@ extern "C" {
 	/// <param name="ib">Index buffer handle</param>
 	MRL_API void mrl_unmap_index_buffer(mrl_render_device_t* rd, mrl_index_buffer_t* ib);
 
+	/// <summary>
+	///		Maps a range of an index buffer.
+	///		The range is unmapped with mrl_unmap_index_buffer.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="ib">Index buffer handle</param>
+	/// <param name="offset">Range offset</param>
+	/// <param name="size">Range size</param>
+	/// <param name="flags">Map flags (MRL_MAP_*)</param>
+	/// <returns>Pointer to the range data, or NULL on failure</returns>
+	MRL_API void* mrl_map_index_buffer_range(mrl_render_device_t* rd, mrl_index_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size, mgl_u32_t flags);
+
+	/// <summary>
+	///		Flushes writes to part of a range mapped with MRL_MAP_FLUSH_EXPLICIT.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="ib">Index buffer handle</param>
+	/// <param name="offset">Offset relative to the start of the mapped range</param>
+	/// <param name="size">Size of the flushed data</param>
+	MRL_API void mrl_flush_index_buffer_range(mrl_render_device_t* rd, mrl_index_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size);
+
 	/// <summary>
 	///		Updates an index buffer data.
 	/// </summary>
@@ -2639,6 +3596,34 @@ extern "C" {
 	/// <param name="data">Pointer to data</param>
 	MRL_API void mrl_update_index_buffer(mrl_render_device_t* rd, mrl_index_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size, const void* data);
 
+	// ------- Indirect buffer functions -------
+
+	/// <summary>
+	///		Creates an indirect buffer, which holds the arguments of indirect draws.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="ib">Out indirect buffer handle</param>
+	/// <param name="desc">Indirect buffer description</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_create_indirect_buffer(mrl_render_device_t* rd, mrl_indirect_buffer_t** ib, const mrl_indirect_buffer_desc_t* desc);
+
+	/// <summary>
+	///		Destroys an indirect buffer.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="ib">Indirect buffer handle</param>
+	MRL_API void mrl_destroy_indirect_buffer(mrl_render_device_t* rd, mrl_indirect_buffer_t* ib);
+
+	/// <summary>
+	///		Updates an indirect buffer data.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="ib">Indirect buffer handle</param>
+	/// <param name="offset">Data offset</param>
+	/// <param name="size">Data size</param>
+	/// <param name="data">Pointer to data</param>
+	MRL_API void mrl_update_indirect_buffer(mrl_render_device_t* rd, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size, const void* data);
+
 	// ------- Vertex buffer functions -------
 
 	/// <summary>
@@ -2672,6 +3657,27 @@ extern "C" {
 	/// <param name="vb">Index buffer handle</param>
 	MRL_API void mrl_unmap_vertex_buffer(mrl_render_device_t* rd, mrl_vertex_buffer_t* vb);
 
+	/// <summary>
+	///		Maps a range of a vertex buffer.
+	///		The range is unmapped with mrl_unmap_vertex_buffer.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="vb">Vertex buffer handle</param>
+	/// <param name="offset">Range offset</param>
+	/// <param name="size">Range size</param>
+	/// <param name="flags">Map flags (MRL_MAP_*)</param>
+	/// <returns>Pointer to the range data, or NULL on failure</returns>
+	MRL_API void* mrl_map_vertex_buffer_range(mrl_render_device_t* rd, mrl_vertex_buffer_t* vb, mgl_u64_t offset, mgl_u64_t size, mgl_u32_t flags);
+
+	/// <summary>
+	///		Flushes writes to part of a range mapped with MRL_MAP_FLUSH_EXPLICIT.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="vb">Vertex buffer handle</param>
+	/// <param name="offset">Offset relative to the start of the mapped range</param>
+	/// <param name="size">Size of the flushed data</param>
+	MRL_API void mrl_flush_vertex_buffer_range(mrl_render_device_t* rd, mrl_vertex_buffer_t* vb, mgl_u64_t offset, mgl_u64_t size);
+
 	/// <summary>
 	///		Updates a vertex buffer data.
 	/// </summary>
@@ -2707,6 +3713,145 @@ extern "C" {
 	/// <param name="va">Vertex array handle</param>
 	MRL_API void mrl_set_vertex_array(mrl_render_device_t* rd, mrl_vertex_array_t* va);
 
+	// ------- Stream allocator functions -------
+
+	/// <summary>
+	///		Creates a stream allocator.
+	///		Stream allocators use a buffer as a ring buffer, and sub-allocate the data which is written every frame from it.
+	///		Allocations never wait for the GPU unless the ring buffer is full, in which case only the oldest frame is waited on.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="sa">Out stream allocator handle</param>
+	/// <param name="desc">Stream allocator description</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_create_stream_allocator(mrl_render_device_t* rd, mrl_stream_allocator_t** sa, const mrl_stream_allocator_desc_t* desc);
+
+	/// <summary>
+	///		Destroys a stream allocator.
+	///		The buffer used by the allocator isn't destroyed.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="sa">Stream allocator handle</param>
+	MRL_API void mrl_destroy_stream_allocator(mrl_render_device_t* rd, mrl_stream_allocator_t* sa);
+
+	/// <summary>
+	///		Allocates a region of the stream allocator buffer and maps it.
+	///		The allocation must be unmapped with mrl_unmap_stream_allocation before the next allocation or draw call.
+	///		Using the vertex size as the alignment makes offset / vertex size the first vertex of the allocation.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="sa">Stream allocator handle</param>
+	/// <param name="size">Allocation size</param>
+	/// <param name="alignment">Allocation offset alignment (0 means no alignment)</param>
+	/// <param name="offset">Out allocation offset in the buffer</param>
+	/// <returns>Pointer to allocation data, or NULL if the allocation doesn't fit in the buffer</returns>
+	MRL_API void* mrl_map_stream_allocation(mrl_render_device_t* rd, mrl_stream_allocator_t* sa, mgl_u64_t size, mgl_u64_t alignment, mgl_u64_t* offset);
+
+	/// <summary>
+	///		Unmaps the last allocation mapped by a stream allocator.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="sa">Stream allocator handle</param>
+	MRL_API void mrl_unmap_stream_allocation(mrl_render_device_t* rd, mrl_stream_allocator_t* sa);
+
+	/// <summary>
+	///		Marks the end of a frame on a stream allocator.
+	///		Must be called once per frame, after the draw calls which use the frame allocations were issued.
+	///		The memory allocated on the frame is reused once the GPU is done with it.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="sa">Stream allocator handle</param>
+	MRL_API void mrl_end_stream_allocator_frame(mrl_render_device_t* rd, mrl_stream_allocator_t* sa);
+
+	// ------- Upload queue functions -------
+
+	/// <summary>
+	///		Creates an upload queue.
+	///		Upload queues copy texel data into staging memory and let the GPU transfer it to the texture asynchronously,
+	///		so that texture uploads don't stall the CPU until the driver is done reading the client memory.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="uq">Out upload queue handle</param>
+	/// <param name="desc">Upload queue description</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_create_upload_queue(mrl_render_device_t* rd, mrl_upload_queue_t** uq, const mrl_upload_queue_desc_t* desc);
+
+	/// <summary>
+	///		Destroys an upload queue.
+	///		Pending uploads are still performed.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="uq">Upload queue handle</param>
+	MRL_API void mrl_destroy_upload_queue(mrl_render_device_t* rd, mrl_upload_queue_t* uq);
+
+	/// <summary>
+	///		Uploads data to a 1D texture through an upload queue.
+	///		The data is copied before the function returns, so it can be freed or reused right away.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="uq">Upload queue handle</param>
+	/// <param name="tex">Texture handle</param>
+	/// <param name="desc">Texture update description</param>
+	/// <param name="token">Out completion token, which can be passed to mrl_is_upload_complete and mrl_wait_upload</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_upload_texture_1d(mrl_render_device_t* rd, mrl_upload_queue_t* uq, mrl_texture_1d_t* tex, const mrl_texture_1d_update_desc_t* desc, mgl_u64_t* token);
+
+	/// <summary>
+	///		Uploads data to a 2D texture through an upload queue.
+	///		The data is copied before the function returns, so it can be freed or reused right away.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="uq">Upload queue handle</param>
+	/// <param name="tex">Texture handle</param>
+	/// <param name="desc">Texture update description</param>
+	/// <param name="token">Out completion token, which can be passed to mrl_is_upload_complete and mrl_wait_upload</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_upload_texture_2d(mrl_render_device_t* rd, mrl_upload_queue_t* uq, mrl_texture_2d_t* tex, const mrl_texture_2d_update_desc_t* desc, mgl_u64_t* token);
+
+	/// <summary>
+	///		Uploads data to a 3D texture through an upload queue.
+	///		The data is copied before the function returns, so it can be freed or reused right away.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="uq">Upload queue handle</param>
+	/// <param name="tex">Texture handle</param>
+	/// <param name="desc">Texture update description</param>
+	/// <param name="token">Out completion token, which can be passed to mrl_is_upload_complete and mrl_wait_upload</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_upload_texture_3d(mrl_render_device_t* rd, mrl_upload_queue_t* uq, mrl_texture_3d_t* tex, const mrl_texture_3d_update_desc_t* desc, mgl_u64_t* token);
+
+	/// <summary>
+	///		Uploads data to a cube map face through an upload queue.
+	///		The data is copied before the function returns, so it can be freed or reused right away.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="uq">Upload queue handle</param>
+	/// <param name="cb">Cube map handle</param>
+	/// <param name="desc">Cube map update description</param>
+	/// <param name="token">Out completion token, which can be passed to mrl_is_upload_complete and mrl_wait_upload</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_upload_cube_map(mrl_render_device_t* rd, mrl_upload_queue_t* uq, mrl_cube_map_t* cb, const mrl_cube_map_update_desc_t* desc, mgl_u64_t* token);
+
+	/// <summary>
+	///		Checks whether an upload is complete, without waiting.
+	///		Uploads complete in the order they were issued, so when an upload is complete, so are all the previous ones.
+	///		Draws issued after an upload always see its data, even if it isn't complete yet: completion only matters
+	///		for knowing when the texture data has reached the GPU, for example to stream in textures over several frames.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="uq">Upload queue handle</param>
+	/// <param name="token">Completion token</param>
+	/// <returns>MGL_TRUE if the upload is complete, otherwise MGL_FALSE</returns>
+	MRL_API mgl_bool_t mrl_is_upload_complete(mrl_render_device_t* rd, mrl_upload_queue_t* uq, mgl_u64_t token);
+
+	/// <summary>
+	///		Waits until an upload is complete.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="uq">Upload queue handle</param>
+	/// <param name="token">Completion token</param>
+	MRL_API void mrl_wait_upload(mrl_render_device_t* rd, mrl_upload_queue_t* uq, mgl_u64_t token);
+
 	// ------- Shader functions -------
 
 	/// <summary>
@@ -2757,6 +3902,24 @@ extern "C" {
 	/// <returns>Binding point handle</returns>
 	MRL_API mrl_shader_binding_point_t* mrl_get_shader_binding_point(mrl_render_device_t* rd, mrl_shader_pipeline_t* pipeline, const mgl_chr8_t* name);
 
+	/// <summary>
+	///		Gets the integer ID of a shader binding point name.
+	///		IDs don't depend on the render device or pipeline, so they can be computed once and used with any pipeline.
+	/// </summary>
+	/// <param name="name">Binding point name</param>
+	/// <returns>Binding point ID</returns>
+	MRL_API mgl_u64_t mrl_get_shader_binding_point_id(const mgl_chr8_t* name);
+
+	/// <summary>
+	///		Gets a shader binding point from its ID (see mrl_get_shader_binding_point_id).
+	///		Unlike mrl_get_shader_binding_point, no string comparisons are made.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="pipeline">Pipeline handle</param>
+	/// <param name="id">Binding point ID</param>
+	/// <returns>Binding point handle, or NULL if the pipeline has no binding point with the ID</returns>
+	MRL_API mrl_shader_binding_point_t* mrl_get_shader_binding_point_by_id(mrl_render_device_t* rd, mrl_shader_pipeline_t* pipeline, mgl_u64_t id);
+
 	// -------- Draw functions --------
 
 	/// <summary>
@@ -2801,7 +3964,7 @@ extern "C" {
 	///		Draws triangles using an index buffer.
 	/// </summary>
 	/// <param name="rd">Render device</param>
-	/// <param name="offset">First index offset</param>
+	/// <param name="offset">First index offset, in bytes</param>
 	/// <param name="count">Number of indexes to render</param>
 	MRL_API void mrl_draw_triangles_indexed(mrl_render_device_t* rd, mgl_u64_t offset, mgl_u64_t count);
 
@@ -2818,11 +3981,73 @@ extern "C" {
 	///		Draws triangles using an index buffer multiple times.
 	/// </summary>
 	/// <param name="rd">Render device</param>
-	/// <param name="offset">First index offset</param>
+	/// <param name="offset">First index offset, in bytes</param>
 	/// <param name="count">Number of indexes to render</param>
 	/// <param name="instance_count">Number of instances to render</param>
 	MRL_API void mrl_draw_triangles_indexed_instanced(mrl_render_device_t* rd, mgl_u64_t offset, mgl_u64_t count, mgl_u64_t instance_count);
 
+	/// <summary>
+	///		Draws triangles using an index buffer, adding a base vertex to every index before fetching vertices.
+	///		This allows the vertices and indices of many meshes to share the same buffers and vertex array,
+	///		with each mesh keeping indices relative to its first vertex (see mrl_create_mesh_heap).
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="offset">First index offset, in bytes</param>
+	/// <param name="count">Number of indexes to render</param>
+	/// <param name="base_vertex">Value added to the indices before fetching vertices</param>
+	MRL_API void mrl_draw_triangles_indexed_base_vertex(mrl_render_device_t* rd, mgl_u64_t offset, mgl_u64_t count, mgl_i64_t base_vertex);
+
+	/// <summary>
+	///		Draws triangles using an index buffer multiple times, adding a base vertex to every index before fetching vertices.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="offset">First index offset, in bytes</param>
+	/// <param name="count">Number of indexes to render</param>
+	/// <param name="instance_count">Number of instances to render</param>
+	/// <param name="base_vertex">Value added to the indices before fetching vertices</param>
+	MRL_API void mrl_draw_triangles_indexed_instanced_base_vertex(mrl_render_device_t* rd, mgl_u64_t offset, mgl_u64_t count, mgl_u64_t instance_count, mgl_i64_t base_vertex);
+
+	/// <summary>
+	///		Draws several ranges of vertices in a single call.
+	///		Equivalent to calling mrl_draw_triangles once for each range.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="offsets">First vertex offset of each range</param>
+	/// <param name="counts">Number of vertexes to render in each range</param>
+	/// <param name="draw_count">Number of ranges</param>
+	MRL_API void mrl_multi_draw_triangles(mrl_render_device_t* rd, const mgl_u64_t* offsets, const mgl_u64_t* counts, mgl_u64_t draw_count);
+
+	/// <summary>
+	///		Draws several ranges of indices in a single call.
+	///		Equivalent to calling mrl_draw_triangles_indexed once for each range.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="offsets">First index offset of each range, in bytes, like in mrl_draw_triangles_indexed</param>
+	/// <param name="counts">Number of indexes to render in each range</param>
+	/// <param name="base_vertices">Value added to the indices of each range before fetching vertices. Optional (can be NULL)</param>
+	/// <param name="draw_count">Number of ranges</param>
+	MRL_API void mrl_multi_draw_triangles_indexed(mrl_render_device_t* rd, const mgl_u64_t* offsets, const mgl_u64_t* counts, const mgl_i64_t* base_vertices, mgl_u64_t draw_count);
+
+	/// <summary>
+	///		Draws triangles with arguments read from an indirect buffer.
+	///		The buffer must contain draw_count consecutive mrl_draw_indirect_args_t structures starting at offset.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="ib">Indirect buffer handle</param>
+	/// <param name="offset">Offset of the first argument structure, in bytes (must be a multiple of 4)</param>
+	/// <param name="draw_count">Number of draws</param>
+	MRL_API void mrl_draw_triangles_indirect(mrl_render_device_t* rd, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t draw_count);
+
+	/// <summary>
+	///		Draws triangles using an index buffer with arguments read from an indirect buffer.
+	///		The buffer must contain draw_count consecutive mrl_draw_indexed_indirect_args_t structures starting at offset.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="ib">Indirect buffer handle</param>
+	/// <param name="offset">Offset of the first argument structure, in bytes (must be a multiple of 4)</param>
+	/// <param name="draw_count">Number of draws</param>
+	MRL_API void mrl_draw_triangles_indexed_indirect(mrl_render_device_t* rd, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t draw_count);
+
 	/// <summary>
 	///		Sets the current viewport.
 	/// </summary>
@@ -2858,6 +4083,14 @@ extern "C" {
 	/// <returns>Property value</returns>
 	MRL_API mgl_f64_t mrl_get_property_f(mrl_render_device_t* rd, mgl_enum_t name);
 
+	/// <summary>
+	///		Gets usage statistics from the pool which holds a type of render device object.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="type">Object type (MRL_OBJECT_*)</param>
+	/// <param name="stats">Out pool statistics</param>
+	MRL_API void mrl_get_object_pool_stats(mrl_render_device_t* rd, mgl_enum_t type, mrl_object_pool_stats_t* stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,213 @@
+#ifndef MRL_SW_RENDER_DEVICE_H
+#define MRL_SW_RENDER_DEVICE_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <mrl/render_device.h>
+
+	typedef struct mrl_sw_shader_desc_t mrl_sw_shader_desc_t;
+	typedef struct mrl_sw_shader_resources_t mrl_sw_shader_resources_t;
+
+	// ---- Software shaders ----
+
+#define MRL_SW_MAX_VARYING_COUNT 32
+#define MRL_SW_MAX_BINDING_POINT_COUNT 16
+
+	typedef struct
+	{
+		/// <summary>
+		///		Resources bound to the binding points of the shader stage.
+		/// </summary>
+		const mrl_sw_shader_resources_t* resources;
+
+		/// <summary>
+		///		Index of the vertex being processed.
+		/// </summary>
+		mgl_u32_t vertex_id;
+
+		/// <summary>
+		///		Index of the instance being processed.
+		/// </summary>
+		mgl_u32_t instance_id;
+
+		/// <summary>
+		///		Vertex inputs, in the order they were declared in the shader stage description.
+		///		Every vertex element is converted to floats, and missing components are set to (0, 0, 0, 1).
+		/// </summary>
+		mgl_f32_t inputs[MRL_MAX_VERTEX_ARRAY_ELEMENT_COUNT][4];
+	} mrl_sw_vertex_input_t;
+
+	typedef struct
+	{
+		/// <summary>
+		///		Clip space vertex position.
+		/// </summary>
+		mgl_f32_t position[4];
+
+		/// <summary>
+		///		Values interpolated across the triangle and passed to the pixel shader.
+		/// </summary>
+		mgl_f32_t varyings[MRL_SW_MAX_VARYING_COUNT];
+	} mrl_sw_vertex_output_t;
+
+	typedef struct
+	{
+		/// <summary>
+		///		Resources bound to the binding points of the shader stage.
+		/// </summary>
+		const mrl_sw_shader_resources_t* resources;
+
+		/// <summary>
+		///		Window coordinates of the pixel center (x, y), its depth (z) and the inverse of the clip space w (w).
+		/// </summary>
+		mgl_f32_t frag_coord[4];
+
+		/// <summary>
+		///		Is the triangle front facing?
+		/// </summary>
+		mgl_bool_t front_facing;
+
+		/// <summary>
+		///		Perspective correct interpolated vertex shader varyings.
+		/// </summary>
+		mgl_f32_t varyings[MRL_SW_MAX_VARYING_COUNT];
+	} mrl_sw_pixel_input_t;
+
+	typedef struct
+	{
+		/// <summary>
+		///		Colors written to each render target of the framebuffer.
+		/// </summary>
+		mgl_f32_t colors[MRL_MAX_FRAMEBUFFER_RENDER_TARGET_COUNT][4];
+	} mrl_sw_pixel_output_t;
+
+	/// <summary>
+	///		Vertex shader function.
+	///		Vertex shaders run on many threads at the same time, so they must not modify shared state.
+	/// </summary>
+	typedef void(*mrl_sw_vertex_shader_func_t)(const mrl_sw_vertex_input_t* in, mrl_sw_vertex_output_t* out);
+
+	/// <summary>
+	///		Pixel shader function.
+	///		Pixel shaders run on many threads at the same time, so they must not modify shared state.
+	///		Returns MGL_FALSE to discard the pixel.
+	/// </summary>
+	typedef mgl_bool_t(*mrl_sw_pixel_shader_func_t)(const mrl_sw_pixel_input_t* in, mrl_sw_pixel_output_t* out);
+
+	struct mrl_sw_shader_desc_t
+	{
+		/// <summary>
+		///		Vertex shader function.
+		///		Only used by vertex shader stages.
+		/// </summary>
+		mrl_sw_vertex_shader_func_t vertex;
+
+		/// <summary>
+		///		Pixel shader function.
+		///		Only used by pixel shader stages.
+		/// </summary>
+		mrl_sw_pixel_shader_func_t pixel;
+
+		/// <summary>
+		///		Names of the vertex inputs, matched against the vertex element names of the vertex arrays.
+		///		Only used by vertex shader stages.
+		/// </summary>
+		const mgl_chr8_t* inputs[MRL_MAX_VERTEX_ARRAY_ELEMENT_COUNT];
+
+		/// <summary>
+		///		Number of vertex inputs.
+		///		Valid values: 0 - MRL_MAX_VERTEX_ARRAY_ELEMENT_COUNT;
+		/// </summary>
+		mgl_u32_t input_count;
+
+		/// <summary>
+		///		Number of varyings written by the vertex shader.
+		///		Only used by vertex shader stages.
+		///		Valid values: 0 - MRL_SW_MAX_VARYING_COUNT;
+		/// </summary>
+		mgl_u32_t varying_count;
+
+		/// <summary>
+		///		Names of the binding points used by the stage.
+		///		The shader functions access the bound resources by their index in this array.
+		/// </summary>
+		const mgl_chr8_t* binding_points[MRL_SW_MAX_BINDING_POINT_COUNT];
+
+		/// <summary>
+		///		Number of binding points.
+		///		Valid values: 0 - MRL_SW_MAX_BINDING_POINT_COUNT;
+		/// </summary>
+		mgl_u32_t binding_point_count;
+	};
+
+#define MRL_DEFAULT_SW_SHADER_DESC ((mrl_sw_shader_desc_t) {\
+	NULL,\
+	NULL,\
+	{ NULL },\
+	0,\
+	0,\
+	{ NULL },\
+	0,\
+})
+
+	// ------- Software shader functions -------
+
+	/// <summary>
+	///		Gets the data of the constant buffer bound to a binding point of a shader stage.
+	///		Should only be called from shader functions.
+	/// </summary>
+	/// <param name="res">Shader resources</param>
+	/// <param name="binding_point">Index of the binding point on the stage description</param>
+	/// <returns>Pointer to the constant buffer data (or range), or NULL if none is bound</returns>
+	MRL_API const void* mrl_get_sw_shader_constants(const mrl_sw_shader_resources_t* res, mgl_u32_t binding_point);
+
+	/// <summary>
+	///		Samples the texture bound to a binding point of a shader stage, using the sampler bound to the same binding point.
+	///		Should only be called from shader functions.
+	///		1D textures use the first coordinate, 2D textures the first two, and 3D textures and cube maps use all three.
+	///		2D texture arrays use the first two, and the third selects the layer, rounded to the nearest index.
+	///		Cube map arrays use the first three as the direction, and the fourth selects the cube in the same way.
+	///		Integer formats return their values converted to floats.
+	/// </summary>
+	/// <param name="res">Shader resources</param>
+	/// <param name="binding_point">Index of the binding point on the stage description</param>
+	/// <param name="coords">Texture coordinates (or direction, for cube maps, or coordinates and layer, for texture and cube map arrays)</param>
+	/// <param name="lod">Mip level of detail (there are no derivatives, so shaders must compute it themselves)</param>
+	/// <param name="out">Out RGBA color</param>
+	MRL_API void mrl_sample_sw_shader_texture(const mrl_sw_shader_resources_t* res, mgl_u32_t binding_point, const mgl_f32_t* coords, mgl_f32_t lod, mgl_f32_t* out);
+
+	// ------- Software render device functions -------
+
+	/// <summary>
+	///		Initializes a software render device, which renders on the CPU.
+	///		Triangles are binned into screen tiles, which are rasterized in parallel by a pool of worker threads.
+	///		Shaders are native C functions (MRL_SHADER_SOURCE_NATIVE), and the output is deterministic.
+	///		Only headless devices are supported, so the window must be NULL.
+	///		The typename of this render device is 'sw'.
+	/// </summary>
+	/// <param name="desc">Render device description</param>
+	/// <param name="out_rd">Out render device pointer</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_init_sw_render_device(const mrl_render_device_desc_t* desc, mrl_render_device_t** out_rd);
+
+	/// <summary>
+	///		Terminates a software render device.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	MRL_API void mrl_terminate_sw_render_device(mrl_render_device_t* rd);
+
+	/// <summary>
+	///		Gets the pixels of the default framebuffer of a software render device.
+	///		Pixels are stored as MRL_TEXTURE_FORMAT_RGBA8_UN, row by row, starting from the bottom row.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	/// <param name="width">Out framebuffer width (optional)</param>
+	/// <param name="height">Out framebuffer height (optional)</param>
+	/// <returns>Pointer to the pixels, valid until the device is terminated</returns>
+	MRL_API const mgl_u8_t* mrl_get_sw_default_framebuffer_pixels(mrl_render_device_t* rd, mgl_u32_t* width, mgl_u32_t* height);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,167 @@
+#ifndef MRL_TEXTURE_BUILDER_H
+#define MRL_TEXTURE_BUILDER_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <mrl/render_device.h>
+
+	typedef struct mrl_mip_chain_desc_t mrl_mip_chain_desc_t;
+	typedef struct mrl_mip_chain_t mrl_mip_chain_t;
+
+	// ---- Mip filters ----
+
+	enum
+	{
+		MRL_MIP_FILTER_BOX,
+		MRL_MIP_FILTER_KAISER,
+	};
+
+	// ---- Mip chain ----
+
+	struct mrl_mip_chain_desc_t
+	{
+		/// <summary>
+		///		Allocator used to allocate the generated mip levels.
+		/// </summary>
+		void* allocator;
+
+		/// <summary>
+		///		Data of the 0th mip level, with the layers stored one after the other, starting with the layer 0.
+		/// </summary>
+		const void* data;
+
+		/// <summary>
+		///		Width of the 0th mip level.
+		/// </summary>
+		mgl_u64_t width;
+
+		/// <summary>
+		///		Height of the 0th mip level.
+		/// </summary>
+		mgl_u64_t height;
+
+		/// <summary>
+		///		Number of layers, which are filtered separately.
+		///		Set to 1 for 2D textures and cube map faces, to the layer count for 2D texture arrays, and to six times the
+		///		layer count for cube map arrays.
+		///		3D textures aren't supported, since the layer count is kept on every mip level instead of being halved.
+		/// </summary>
+		mgl_u64_t layer_count;
+
+		/// <summary>
+		///		Mip level count, including the 0th mip level.
+		///		Valid values: 0 - MRL_MAX_MIP_LEVEL_COUNT, and no more than the levels needed to reach a single texel;
+		///		If 0, the whole mip chain down to a single texel is built.
+		/// </summary>
+		mgl_u32_t mip_level_count;
+
+		/// <summary>
+		///		Texture data format.
+		///		Valid values:
+		///			- All uncompressed color formats (depth/stencil and compressed formats aren't supported).
+		/// </summary>
+		mgl_enum_t format;
+
+		/// <summary>
+		///		Filter used to downsample each mip level from the previous one.
+		///		Valid values:
+		///		- MRL_MIP_FILTER_BOX (averages each 2x2 texel quad);
+		///		- MRL_MIP_FILTER_KAISER (Kaiser windowed sinc, sharper but slower);
+		/// </summary>
+		mgl_enum_t filter;
+
+		/// <summary>
+		///		If true, the data is sRGB encoded, and is averaged in linear space.
+		///		The alpha channel of RGBA formats is always linear.
+		///		Only supported by 8 bit unsigned normalized formats.
+		/// </summary>
+		mgl_bool_t srgb;
+
+		/// <summary>
+		///		Maximum number of threads used to filter each mip level, including the calling thread.
+		///		If 0, up to one thread per hardware thread is used.
+		/// </summary>
+		mgl_u32_t max_thread_count;
+	};
+
+#define MRL_DEFAULT_MIP_CHAIN_DESC ((mrl_mip_chain_desc_t) {\
+	NULL,\
+	NULL,\
+	256,\
+	256,\
+	1,\
+	0,\
+	MRL_TEXTURE_FORMAT_RGBA8_UN,\
+	MRL_MIP_FILTER_BOX,\
+	MGL_FALSE,\
+	0,\
+})
+
+	struct mrl_mip_chain_t
+	{
+		/// <summary>
+		///		Data of each mip level, laid out like the data member of the texture descriptions,
+		///		so it can be copied to them directly.
+		///		The 0th mip level points to the data passed in the description, which isn't copied.
+		/// </summary>
+		const void* data[MRL_MAX_MIP_LEVEL_COUNT];
+
+		/// <summary>
+		///		Number of mip levels in the chain.
+		/// </summary>
+		mgl_u32_t mip_level_count;
+
+		/// <summary>
+		///		Allocator and memory which hold the generated mip levels.
+		/// </summary>
+		void* allocator;
+		void* memory;
+	};
+
+	// ------- Texture builder functions -------
+
+	/// <summary>
+	///		Gets the size in bytes of a texel of an uncompressed texture format.
+	/// </summary>
+	/// <param name="format">Texture format</param>
+	/// <returns>Texel size, or 0 if the format is compressed or invalid</returns>
+	MRL_API mgl_u64_t mrl_get_texel_size(mgl_enum_t format);
+
+	/// <summary>
+	///		Builds a mip chain on the CPU, which can be passed to the texture descriptions instead of generating mipmaps
+	///		on the render device. Unlike mrl_generate_texture_2d_mipmaps, this works with integer formats and doesn't
+	///		occupy the render thread.
+	///		Large mip levels are filtered on multiple threads, and box filtered 8 bit and float formats are vectorized.
+	///		3D textures aren't supported, since their depth isn't halved; use mrl_generate_texture_3d_mipmaps instead.
+	/// </summary>
+	/// <param name="desc">Description</param>
+	/// <param name="chain">Out mip chain, which must be freed with mrl_free_mip_chain</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_build_mip_chain(const mrl_mip_chain_desc_t* desc, mrl_mip_chain_t* chain);
+
+	/// <summary>
+	///		Frees the mip levels generated by mrl_build_mip_chain.
+	/// </summary>
+	/// <param name="chain">Mip chain</param>
+	MRL_API void mrl_free_mip_chain(mrl_mip_chain_t* chain);
+
+	/// <summary>
+	///		Converts texels between uncompressed color formats.
+	///		Normalized and float channels are converted by value, so 255 in a R8_UN texel becomes 1.0 in a R32_F texel,
+	///		and integer channels are converted by value too, saturating to the range of the destination format.
+	///		Channels missing from the source format are set to 0, except for alpha, which is set to 1.
+	///		Large conversions are split across multiple threads.
+	/// </summary>
+	/// <param name="src_format">Source texture format</param>
+	/// <param name="src">Source texels</param>
+	/// <param name="dst_format">Destination texture format</param>
+	/// <param name="dst">Destination texels</param>
+	/// <param name="texel_count">Number of texels to convert</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_convert_texels(mgl_enum_t src_format, const void* src, mgl_enum_t dst_format, void* dst, mgl_u64_t texel_count);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
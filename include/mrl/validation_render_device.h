@@ -0,0 +1,40 @@
+#ifndef MRL_VALIDATION_RENDER_DEVICE_H
+#define MRL_VALIDATION_RENDER_DEVICE_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <mrl/render_device.h>
+
+	/// <summary>
+	///		Initializes a validation render device, which checks every call before forwarding it to a target render device.
+	///		The following errors are detected:
+	///		- Invalid, destroyed or mistyped object handles and binding points;
+	///		- Invalid descriptions, e.g. depth formats used as color render targets or out of range mip levels and updates;
+	///		- Binding points used with resources of different kinds (e.g. a constant buffer and a texture, or a 2D texture and a cube map);
+	///		- Mismatched map/unmap calls, flushes outside of the mapped range and writes to mapped buffers;
+	///		- Draws without a shader pipeline, vertex array or index buffer set.
+	///		Errors are reported through the error callback hint, and the invalid calls aren't forwarded to the target device.
+	///		Validation devices can be stacked with other wrapping devices (e.g. the capture device), in any order.
+	///		When validation isn't needed, the target device can be used directly, with no overhead.
+	///		The window of the render device description is ignored, since the target device already owns it.
+	///		The typename and properties reported are the ones of the target render device.
+	///		Hints with the device type 'validation' are also accepted.
+	/// </summary>
+	/// <param name="desc">Render device description</param>
+	/// <param name="target">Target render device</param>
+	/// <param name="out_rd">Out render device pointer</param>
+	/// <returns>Error code</returns>
+	MRL_API mrl_error_t mrl_init_validation_render_device(const mrl_render_device_desc_t* desc, mrl_render_device_t* target, mrl_render_device_t** out_rd);
+
+	/// <summary>
+	///		Terminates a validation render device, warning about objects which weren't destroyed.
+	///		The target render device isn't terminated.
+	/// </summary>
+	/// <param name="rd">Render device</param>
+	MRL_API void mrl_terminate_validation_render_device(mrl_render_device_t* rd);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
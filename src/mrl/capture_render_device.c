@@ -0,0 +1,3374 @@
+#include <mrl/capture_render_device.h>
+#include <mrl/object_pool.h>
+#include <mrl/texture_decoder.h>
+
+#include <mgl/memory/allocator.h>
+#include <mgl/memory/manipulation.h>
+#include <mgl/string/manipulation.h>
+
+#define MRL_CAPTURE_OBJECT_POOL_COUNT 20
+#define MRL_CAPTURE_MAX_ARG_COUNT 64
+
+#ifdef near
+#undef near
+#endif
+#ifdef far
+#undef far
+#endif
+
+// Every object starts with its ID and the handle of the target device object
+typedef struct
+{
+	mgl_u32_t id;
+	void* handle;
+} mrl_capture_object_t;
+
+typedef struct
+{
+	mgl_u32_t id;
+	void* handle;
+
+	// Needed to know the size of updates
+	mgl_enum_t format;
+} mrl_capture_texture_t;
+
+typedef struct
+{
+	mgl_u32_t id;
+	void* handle;
+	mgl_u64_t size;
+
+	// Range currently mapped
+	mgl_u8_t* mapped;
+	mgl_u64_t map_size;
+	mgl_u32_t map_flags;
+} mrl_capture_buffer_t;
+
+typedef struct
+{
+	mgl_u32_t id;
+	void* handle;
+	mrl_capture_buffer_t* buffer;
+
+	// Allocation currently mapped
+	mgl_u8_t* mapped;
+	mgl_u64_t map_size;
+} mrl_capture_stream_allocator_t;
+
+typedef struct mrl_capture_binding_point_t mrl_capture_binding_point_t;
+
+struct mrl_capture_binding_point_t
+{
+	mgl_u32_t id;
+	void* handle;
+	mrl_capture_binding_point_t* next;
+};
+
+typedef struct
+{
+	mgl_u32_t id;
+	void* handle;
+
+	// Binding points queried so far, allocated from the binding point pool
+	mrl_capture_binding_point_t* bps;
+} mrl_capture_shader_pipeline_t;
+
+typedef struct
+{
+	mrl_render_device_t base;
+
+	void* allocator;
+	mrl_render_device_t* target;
+	mgl_u32_t next_id;
+
+	struct
+	{
+		mrl_object_pool_t framebuffer;
+		mrl_object_pool_t raster_state;
+		mrl_object_pool_t depth_stencil_state;
+		mrl_object_pool_t blend_state;
+		mrl_object_pool_t sampler;
+		mrl_object_pool_t texture_1d;
+		mrl_object_pool_t texture_2d;
+		mrl_object_pool_t texture_3d;
+		mrl_object_pool_t cube_map;
+		mrl_object_pool_t constant_buffer;
+		mrl_object_pool_t index_buffer;
+		mrl_object_pool_t vertex_buffer;
+		mrl_object_pool_t vertex_array;
+		mrl_object_pool_t shader_stage;
+		mrl_object_pool_t shader_pipeline;
+		mrl_object_pool_t stream_allocator;
+		mrl_object_pool_t indirect_buffer;
+		mrl_object_pool_t upload_queue;
+		mrl_object_pool_t texture_2d_array;
+		mrl_object_pool_t cube_map_array;
+
+		// Binding points belong to their pipelines, so they aren't indexed by object type
+		mrl_object_pool_t binding_point;
+	} memory;
+
+	// Buffered trace data
+	struct
+	{
+		mrl_capture_write_func_t write;
+		void* user_data;
+		mgl_u8_t* data;
+		mgl_u64_t size;
+		mgl_u64_t capacity;
+		mgl_bool_t failed;
+	} output;
+
+	mrl_render_device_hint_error_callback_t error_callback;
+	mrl_render_device_hint_error_callback_t warning_callback;
+} mrl_capture_render_device_t;
+
+// ---------- Output ----------
+
+static mrl_error_t flush_output(mrl_capture_render_device_t* rd)
+{
+	if (rd->output.failed)
+		return MRL_ERROR_EXTERNAL;
+	if (rd->output.size == 0)
+		return MRL_ERROR_NONE;
+
+	mrl_error_t err = rd->output.write(rd->output.user_data, rd->output.data, rd->output.size);
+	rd->output.size = 0;
+	if (err != MRL_ERROR_NONE)
+	{
+		// Stop capturing, since the trace would be left with a hole
+		rd->output.failed = MGL_TRUE;
+		if (rd->error_callback != NULL)
+			rd->error_callback(err, u8"Failed to write trace: the write function failed, the capture was stopped");
+	}
+
+	return err;
+}
+
+static void write_bytes(mrl_capture_render_device_t* rd, const void* data, mgl_u64_t size)
+{
+	if (rd->output.failed)
+		return;
+
+	if (rd->output.size + size > rd->output.capacity)
+	{
+		if (flush_output(rd) != MRL_ERROR_NONE)
+			return;
+
+		// Big payloads skip the buffer
+		if (size >= rd->output.capacity)
+		{
+			mrl_error_t err = rd->output.write(rd->output.user_data, data, size);
+			if (err != MRL_ERROR_NONE)
+			{
+				rd->output.failed = MGL_TRUE;
+				if (rd->error_callback != NULL)
+					rd->error_callback(err, u8"Failed to write trace: the write function failed, the capture was stopped");
+			}
+			return;
+		}
+	}
+
+	mgl_mem_copy(rd->output.data + rd->output.size, data, size);
+	rd->output.size += size;
+}
+
+static void begin_record(mrl_capture_render_device_t* rd, mgl_u32_t opcode, const mgl_u64_t* args, mgl_u32_t arg_count, mgl_u64_t payload_size)
+{
+	MGL_DEBUG_ASSERT(arg_count <= MRL_CAPTURE_MAX_ARG_COUNT);
+
+	mgl_u32_t header[4];
+	header[0] = opcode;
+	header[1] = arg_count;
+	mgl_mem_copy(&header[2], &payload_size, sizeof(mgl_u64_t));
+
+	write_bytes(rd, header, sizeof(header));
+	if (arg_count > 0)
+		write_bytes(rd, args, arg_count * sizeof(mgl_u64_t));
+}
+
+static void end_record(mrl_capture_render_device_t* rd, mgl_u64_t payload_size)
+{
+	// Keep the next record aligned
+	static const mgl_u8_t zeros[8] = { 0 };
+	if (payload_size % 8 != 0)
+		write_bytes(rd, zeros, 8 - payload_size % 8);
+}
+
+static void record(mrl_capture_render_device_t* rd, mgl_u32_t opcode, const mgl_u64_t* args, mgl_u32_t arg_count, const void* payload, mgl_u64_t payload_size)
+{
+	begin_record(rd, opcode, args, arg_count, payload_size);
+	if (payload_size > 0)
+		write_bytes(rd, payload, payload_size);
+	end_record(rd, payload_size);
+}
+
+static void record_0(mrl_capture_render_device_t* rd, mgl_u32_t opcode)
+{
+	record(rd, opcode, NULL, 0, NULL, 0);
+}
+
+static void record_1(mrl_capture_render_device_t* rd, mgl_u32_t opcode, mgl_u64_t a)
+{
+	const mgl_u64_t args[] = { a };
+	record(rd, opcode, args, 1, NULL, 0);
+}
+
+static void record_2(mrl_capture_render_device_t* rd, mgl_u32_t opcode, mgl_u64_t a, mgl_u64_t b)
+{
+	const mgl_u64_t args[] = { a, b };
+	record(rd, opcode, args, 2, NULL, 0);
+}
+
+static void record_3(mrl_capture_render_device_t* rd, mgl_u32_t opcode, mgl_u64_t a, mgl_u64_t b, mgl_u64_t c)
+{
+	const mgl_u64_t args[] = { a, b, c };
+	record(rd, opcode, args, 3, NULL, 0);
+}
+
+static void record_4(mrl_capture_render_device_t* rd, mgl_u32_t opcode, mgl_u64_t a, mgl_u64_t b, mgl_u64_t c, mgl_u64_t d)
+{
+	const mgl_u64_t args[] = { a, b, c, d };
+	record(rd, opcode, args, 4, NULL, 0);
+}
+
+static mgl_u64_t float_bits(mgl_f32_t v)
+{
+	mgl_u32_t bits;
+	mgl_mem_copy(&bits, &v, sizeof(bits));
+	return bits;
+}
+
+static mgl_u64_t get_id(const void* obj)
+{
+	return obj == NULL ? 0 : ((const mrl_capture_object_t*)obj)->id;
+}
+
+static void* get_handle(const void* obj)
+{
+	return obj == NULL ? NULL : ((const mrl_capture_object_t*)obj)->handle;
+}
+
+// ---------- Texel formats ----------
+
+static mgl_u64_t get_format_size(mgl_enum_t format)
+{
+	switch (format)
+	{
+		case MRL_TEXTURE_FORMAT_R8_UN:
+		case MRL_TEXTURE_FORMAT_R8_SN:
+		case MRL_TEXTURE_FORMAT_R8_UI:
+		case MRL_TEXTURE_FORMAT_R8_SI:
+			return 1;
+
+		case MRL_TEXTURE_FORMAT_RG8_UN:
+		case MRL_TEXTURE_FORMAT_RG8_SN:
+		case MRL_TEXTURE_FORMAT_RG8_UI:
+		case MRL_TEXTURE_FORMAT_RG8_SI:
+		case MRL_TEXTURE_FORMAT_R16_UN:
+		case MRL_TEXTURE_FORMAT_R16_SN:
+		case MRL_TEXTURE_FORMAT_R16_UI:
+		case MRL_TEXTURE_FORMAT_R16_SI:
+		case MRL_TEXTURE_FORMAT_D16:
+			return 2;
+
+		case MRL_TEXTURE_FORMAT_RGBA8_UN:
+		case MRL_TEXTURE_FORMAT_RGBA8_SN:
+		case MRL_TEXTURE_FORMAT_RGBA8_UI:
+		case MRL_TEXTURE_FORMAT_RGBA8_SI:
+		case MRL_TEXTURE_FORMAT_RG16_UN:
+		case MRL_TEXTURE_FORMAT_RG16_SN:
+		case MRL_TEXTURE_FORMAT_RG16_UI:
+		case MRL_TEXTURE_FORMAT_RG16_SI:
+		case MRL_TEXTURE_FORMAT_R32_UI:
+		case MRL_TEXTURE_FORMAT_R32_SI:
+		case MRL_TEXTURE_FORMAT_R32_F:
+		case MRL_TEXTURE_FORMAT_D32:
+		case MRL_TEXTURE_FORMAT_D24S8:
+			return 4;
+
+		case MRL_TEXTURE_FORMAT_RGBA16_UN:
+		case MRL_TEXTURE_FORMAT_RGBA16_SN:
+		case MRL_TEXTURE_FORMAT_RGBA16_UI:
+		case MRL_TEXTURE_FORMAT_RGBA16_SI:
+		case MRL_TEXTURE_FORMAT_RG32_UI:
+		case MRL_TEXTURE_FORMAT_RG32_SI:
+		case MRL_TEXTURE_FORMAT_RG32_F:
+		case MRL_TEXTURE_FORMAT_D32S8:
+			return 8;
+
+		case MRL_TEXTURE_FORMAT_RGBA32_UI:
+		case MRL_TEXTURE_FORMAT_RGBA32_SI:
+		case MRL_TEXTURE_FORMAT_RGBA32_F:
+			return 16;
+
+		default:
+			return 0;
+	}
+}
+
+static mgl_u64_t get_mip_size(mgl_u64_t size, mgl_u32_t level)
+{
+	size >>= level;
+	return size == 0 ? 1 : size;
+}
+
+// Size of a texture region, in bytes, or 0 if the format size isn't known
+static mgl_u64_t get_region_data_size(mgl_enum_t format, mgl_u64_t width, mgl_u64_t height, mgl_u64_t depth)
+{
+	if (mrl_is_compressed_format(format))
+		return mrl_get_compressed_data_size(format, width, height, depth);
+	return width * height * depth * get_format_size(format);
+}
+
+// Size of a mip level, in bytes
+static mgl_u64_t get_level_data_size(mgl_enum_t format, mgl_u64_t width, mgl_u64_t height, mgl_u64_t depth, mgl_u32_t level)
+{
+	return get_region_data_size(format, get_mip_size(width, level), get_mip_size(height, level), get_mip_size(depth, level));
+}
+
+// ---------- Objects ----------
+
+static mrl_error_t create_object(mrl_capture_render_device_t* rd, mrl_object_pool_t* pool, void** out)
+{
+	// Allocate object
+	mrl_capture_object_t* obj;
+	mgl_error_t err = mrl_allocate_object(pool, (void**)&obj);
+	if (err != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(err);
+
+	obj->id = rd->next_id++;
+	obj->handle = NULL;
+	*out = obj;
+
+	return MRL_ERROR_NONE;
+}
+
+// Keeps the object if the target device created it, or deallocates it otherwise
+static mrl_error_t finish_object(mrl_object_pool_t* pool, mrl_error_t target_err, void* obj, void** out)
+{
+	if (target_err != MRL_ERROR_NONE)
+	{
+		mrl_deallocate_object(pool, obj);
+		return target_err;
+	}
+
+	*out = obj;
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_object(mrl_capture_render_device_t* rd, mrl_object_pool_t* pool, mgl_u32_t opcode, void* obj)
+{
+	record_1(rd, opcode, get_id(obj));
+
+	// Deallocate object
+	mrl_deallocate_object(pool, obj);
+}
+
+// ---------- Framebuffers ----------
+
+static mrl_error_t create_framebuffer(mrl_render_device_t* brd, mrl_framebuffer_t** fb, const mrl_framebuffer_desc_t* desc)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+
+	// Replace the capture handles with the target handles
+	mrl_framebuffer_desc_t target_desc = *desc;
+	for (mgl_u32_t i = 0; i < desc->target_count; ++i)
+	{
+		if (desc->targets[i].type == MRL_RENDER_TARGET_TYPE_TEXTURE_2D)
+			target_desc.targets[i].tex_2d.handle = get_handle(desc->targets[i].tex_2d.handle);
+		else if (desc->targets[i].type == MRL_RENDER_TARGET_TYPE_TEXTURE_2D_ARRAY)
+			target_desc.targets[i].tex_2d_array.handle = get_handle(desc->targets[i].tex_2d_array.handle);
+		else
+			target_desc.targets[i].cube_map.handle = get_handle(desc->targets[i].cube_map.handle);
+	}
+	target_desc.depth_stencil = get_handle(desc->depth_stencil);
+	target_desc.depth_stencil_array = get_handle(desc->depth_stencil_array);
+
+	mrl_capture_object_t* obj;
+	mrl_error_t err = create_object(rd, &rd->memory.framebuffer, (void**)&obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.framebuffer, rd->target->create_framebuffer(rd->target, (mrl_framebuffer_t**)&obj->handle, &target_desc), obj, (void**)fb);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	mgl_u64_t args[5 + 4 * MRL_MAX_FRAMEBUFFER_RENDER_TARGET_COUNT];
+	mgl_u32_t arg_count = 0;
+	args[arg_count++] = get_id(*fb);
+	args[arg_count++] = desc->target_count;
+	args[arg_count++] = get_id(desc->depth_stencil);
+	for (mgl_u32_t i = 0; i < desc->target_count; ++i)
+	{
+		args[arg_count++] = desc->targets[i].type;
+		args[arg_count++] = desc->targets[i].mip_level;
+		if (desc->targets[i].type == MRL_RENDER_TARGET_TYPE_TEXTURE_2D)
+		{
+			args[arg_count++] = get_id(desc->targets[i].tex_2d.handle);
+			args[arg_count++] = 0;
+		}
+		else if (desc->targets[i].type == MRL_RENDER_TARGET_TYPE_TEXTURE_2D_ARRAY)
+		{
+			args[arg_count++] = get_id(desc->targets[i].tex_2d_array.handle);
+			args[arg_count++] = desc->targets[i].tex_2d_array.layer;
+		}
+		else
+		{
+			args[arg_count++] = get_id(desc->targets[i].cube_map.handle);
+			args[arg_count++] = desc->targets[i].cube_map.face;
+		}
+	}
+	args[arg_count++] = get_id(desc->depth_stencil_array);
+	args[arg_count++] = desc->depth_stencil_array != NULL ? desc->depth_stencil_layer : 0;
+	record(rd, MRL_CAPTURE_COMMAND_CREATE_FRAMEBUFFER, args, arg_count, NULL, 0);
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_framebuffer(mrl_render_device_t* brd, mrl_framebuffer_t* fb)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->destroy_framebuffer(rd->target, get_handle(fb));
+	destroy_object(rd, &rd->memory.framebuffer, MRL_CAPTURE_COMMAND_DESTROY_FRAMEBUFFER, fb);
+}
+
+static void set_framebuffer(mrl_render_device_t* brd, mrl_framebuffer_t* fb)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->set_framebuffer(rd->target, get_handle(fb));
+	record_1(rd, MRL_CAPTURE_COMMAND_SET_FRAMEBUFFER, get_id(fb));
+}
+
+// ---------- Raster states ----------
+
+static mrl_error_t create_raster_state(mrl_render_device_t* brd, mrl_raster_state_t** rs, const mrl_raster_state_desc_t* desc)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+
+	mrl_capture_object_t* obj;
+	mrl_error_t err = create_object(rd, &rd->memory.raster_state, (void**)&obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.raster_state, rd->target->create_raster_state(rd->target, (mrl_raster_state_t**)&obj->handle, desc), obj, (void**)rs);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	const mgl_u64_t args[] = {
+		get_id(*rs),
+		desc->cull_enabled,
+		desc->front_face,
+		desc->cull_face,
+		desc->raster_mode,
+	};
+	record(rd, MRL_CAPTURE_COMMAND_CREATE_RASTER_STATE, args, sizeof(args) / sizeof(args[0]), NULL, 0);
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_raster_state(mrl_render_device_t* brd, mrl_raster_state_t* rs)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->destroy_raster_state(rd->target, get_handle(rs));
+	destroy_object(rd, &rd->memory.raster_state, MRL_CAPTURE_COMMAND_DESTROY_RASTER_STATE, rs);
+}
+
+static void set_raster_state(mrl_render_device_t* brd, mrl_raster_state_t* rs)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->set_raster_state(rd->target, get_handle(rs));
+	record_1(rd, MRL_CAPTURE_COMMAND_SET_RASTER_STATE, get_id(rs));
+}
+
+// ---------- Depth stencil states ----------
+
+static mrl_error_t create_depth_stencil_state(mrl_render_device_t* brd, mrl_depth_stencil_state_t** dss, const mrl_depth_stencil_state_desc_t* desc)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+
+	mrl_capture_object_t* obj;
+	mrl_error_t err = create_object(rd, &rd->memory.depth_stencil_state, (void**)&obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.depth_stencil_state, rd->target->create_depth_stencil_state(rd->target, (mrl_depth_stencil_state_t**)&obj->handle, desc), obj, (void**)dss);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	const mgl_u64_t args[] = {
+		get_id(*dss),
+		desc->depth.enabled,
+		desc->depth.write_enabled,
+		float_bits(desc->depth.near),
+		float_bits(desc->depth.far),
+		desc->depth.compare,
+		(mgl_u64_t)desc->stencil.ref,
+		desc->stencil.enabled,
+		desc->stencil.read_mask,
+		desc->stencil.write_mask,
+		desc->stencil.front_face.compare,
+		desc->stencil.front_face.fail,
+		desc->stencil.front_face.pass,
+		desc->stencil.front_face.depth_fail,
+		desc->stencil.back_face.compare,
+		desc->stencil.back_face.fail,
+		desc->stencil.back_face.pass,
+		desc->stencil.back_face.depth_fail,
+	};
+	record(rd, MRL_CAPTURE_COMMAND_CREATE_DEPTH_STENCIL_STATE, args, sizeof(args) / sizeof(args[0]), NULL, 0);
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_depth_stencil_state(mrl_render_device_t* brd, mrl_depth_stencil_state_t* dss)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->destroy_depth_stencil_state(rd->target, get_handle(dss));
+	destroy_object(rd, &rd->memory.depth_stencil_state, MRL_CAPTURE_COMMAND_DESTROY_DEPTH_STENCIL_STATE, dss);
+}
+
+static void set_depth_stencil_state(mrl_render_device_t* brd, mrl_depth_stencil_state_t* dss)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->set_depth_stencil_state(rd->target, get_handle(dss));
+	record_1(rd, MRL_CAPTURE_COMMAND_SET_DEPTH_STENCIL_STATE, get_id(dss));
+}
+
+// ---------- Blend states ----------
+
+static mrl_error_t create_blend_state(mrl_render_device_t* brd, mrl_blend_state_t** bs, const mrl_blend_state_desc_t* desc)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+
+	mrl_capture_object_t* obj;
+	mrl_error_t err = create_object(rd, &rd->memory.blend_state, (void**)&obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.blend_state, rd->target->create_blend_state(rd->target, (mrl_blend_state_t**)&obj->handle, desc), obj, (void**)bs);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	const mgl_u64_t args[] = {
+		get_id(*bs),
+		desc->blend_enabled,
+		desc->color.src,
+		desc->color.dst,
+		desc->color.op,
+		desc->alpha.src,
+		desc->alpha.dst,
+		desc->alpha.op,
+	};
+	record(rd, MRL_CAPTURE_COMMAND_CREATE_BLEND_STATE, args, sizeof(args) / sizeof(args[0]), NULL, 0);
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_blend_state(mrl_render_device_t* brd, mrl_blend_state_t* bs)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->destroy_blend_state(rd->target, get_handle(bs));
+	destroy_object(rd, &rd->memory.blend_state, MRL_CAPTURE_COMMAND_DESTROY_BLEND_STATE, bs);
+}
+
+static void set_blend_state(mrl_render_device_t* brd, mrl_blend_state_t* bs)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->set_blend_state(rd->target, get_handle(bs));
+	record_1(rd, MRL_CAPTURE_COMMAND_SET_BLEND_STATE, get_id(bs));
+}
+
+// ---------- Samplers ----------
+
+static mrl_error_t create_sampler(mrl_render_device_t* brd, mrl_sampler_t** s, const mrl_sampler_desc_t* desc)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+
+	mrl_capture_object_t* obj;
+	mrl_error_t err = create_object(rd, &rd->memory.sampler, (void**)&obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.sampler, rd->target->create_sampler(rd->target, (mrl_sampler_t**)&obj->handle, desc), obj, (void**)s);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	const mgl_u64_t args[] = {
+		get_id(*s),
+		float_bits(desc->border_color[0]),
+		float_bits(desc->border_color[1]),
+		float_bits(desc->border_color[2]),
+		float_bits(desc->border_color[3]),
+		desc->min_filter,
+		desc->mag_filter,
+		desc->mip_filter,
+		desc->address_u,
+		desc->address_v,
+		desc->address_w,
+		desc->max_anisotropy,
+	};
+	record(rd, MRL_CAPTURE_COMMAND_CREATE_SAMPLER, args, sizeof(args) / sizeof(args[0]), NULL, 0);
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_sampler(mrl_render_device_t* brd, mrl_sampler_t* s)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->destroy_sampler(rd->target, get_handle(s));
+	destroy_object(rd, &rd->memory.sampler, MRL_CAPTURE_COMMAND_DESTROY_SAMPLER, s);
+}
+
+static void bind_sampler(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_sampler_t* s)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->bind_sampler(rd->target, get_handle(bp), get_handle(s));
+	record_2(rd, MRL_CAPTURE_COMMAND_BIND_SAMPLER, get_id(bp), get_id(s));
+}
+
+// ---------- Textures ----------
+
+// Records the creation of a texture, storing its initial data as the payload
+// Each mip level of a texture array holds all of its layers, whose count doesn't shrink with the mip level
+static void record_texture(mrl_capture_render_device_t* rd, mgl_u32_t opcode, const mgl_u64_t* args, mgl_u32_t arg_count, const void* const* data, mgl_u32_t face_count, mgl_u32_t mip_level_count, mgl_enum_t format, mgl_u64_t width, mgl_u64_t height, mgl_u64_t depth, mgl_u64_t layer_count)
+{
+	// Textures without initial data, or with formats whose size isn't known, have no payload
+	mgl_u64_t payload_size = 0;
+	if (data[0] != NULL && get_region_data_size(format, 1, 1, 1) != 0)
+		for (mgl_u32_t l = 0; l < mip_level_count; ++l)
+			payload_size += get_level_data_size(format, width, height, depth, l) * layer_count * face_count;
+	else if (data[0] != NULL && rd->warning_callback != NULL)
+		rd->warning_callback(MRL_ERROR_NONE, u8"Failed to capture texture data: unknown texture format size");
+
+	begin_record(rd, opcode, args, arg_count, payload_size);
+	if (payload_size > 0)
+		for (mgl_u32_t f = 0; f < face_count; ++f)
+			for (mgl_u32_t l = 0; l < mip_level_count; ++l)
+				write_bytes(rd, data[f * MRL_MAX_MIP_LEVEL_COUNT + l], get_level_data_size(format, width, height, depth, l) * layer_count);
+	end_record(rd, payload_size);
+}
+
+static void record_texture_update(mrl_capture_render_device_t* rd, mgl_u32_t opcode, const mgl_u64_t* args, mgl_u32_t arg_count, const void* data, mgl_enum_t format, mgl_u64_t width, mgl_u64_t height, mgl_u64_t depth)
+{
+	record(rd, opcode, args, arg_count, data, get_region_data_size(format, width, height, depth));
+}
+
+// ---------- 1D Textures ----------
+
+static mrl_error_t create_texture_1d(mrl_render_device_t* brd, mrl_texture_1d_t** tex, const mrl_texture_1d_desc_t* desc)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+
+	mrl_capture_texture_t* obj;
+	mrl_error_t err = create_object(rd, &rd->memory.texture_1d, (void**)&obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.texture_1d, rd->target->create_texture_1d(rd->target, (mrl_texture_1d_t**)&obj->handle, desc), obj, (void**)tex);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	obj->format = desc->format;
+
+	const mgl_u64_t args[] = {
+		get_id(*tex),
+		desc->mip_level_count,
+		desc->width,
+		desc->usage,
+		desc->format,
+	};
+	record_texture(rd, MRL_CAPTURE_COMMAND_CREATE_TEXTURE_1D, args, sizeof(args) / sizeof(args[0]), desc->data, 1, desc->mip_level_count, desc->format, desc->width, 1, 1, 1);
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_texture_1d(mrl_render_device_t* brd, mrl_texture_1d_t* tex)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->destroy_texture_1d(rd->target, get_handle(tex));
+	destroy_object(rd, &rd->memory.texture_1d, MRL_CAPTURE_COMMAND_DESTROY_TEXTURE_1D, tex);
+}
+
+static void generate_texture_1d_mipmaps(mrl_render_device_t* brd, mrl_texture_1d_t* tex)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->generate_texture_1d_mipmaps(rd->target, get_handle(tex));
+	record_1(rd, MRL_CAPTURE_COMMAND_GENERATE_TEXTURE_1D_MIPMAPS, get_id(tex));
+}
+
+static void bind_texture_1d(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_texture_1d_t* tex)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->bind_texture_1d(rd->target, get_handle(bp), get_handle(tex));
+	record_2(rd, MRL_CAPTURE_COMMAND_BIND_TEXTURE_1D, get_id(bp), get_id(tex));
+}
+
+static mrl_error_t update_texture_1d(mrl_render_device_t* brd, mrl_texture_1d_t* tex, const mrl_texture_1d_update_desc_t* desc)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	mrl_error_t err = rd->target->update_texture_1d(rd->target, get_handle(tex), desc);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	const mgl_u64_t args[] = { get_id(tex), desc->width, desc->dst_x, desc->mip_level };
+	record_texture_update(rd, MRL_CAPTURE_COMMAND_UPDATE_TEXTURE_1D, args, 4, desc->data, ((mrl_capture_texture_t*)tex)->format, desc->width, 1, 1);
+
+	return MRL_ERROR_NONE;
+}
+
+// ---------- 2D Textures ----------
+
+static mrl_error_t create_texture_2d(mrl_render_device_t* brd, mrl_texture_2d_t** tex, const mrl_texture_2d_desc_t* desc)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+
+	mrl_capture_texture_t* obj;
+	mrl_error_t err = create_object(rd, &rd->memory.texture_2d, (void**)&obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.texture_2d, rd->target->create_texture_2d(rd->target, (mrl_texture_2d_t**)&obj->handle, desc), obj, (void**)tex);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	obj->format = desc->format;
+
+	const mgl_u64_t args[] = {
+		get_id(*tex),
+		desc->mip_level_count,
+		desc->width,
+		desc->height,
+		desc->usage,
+		desc->format,
+	};
+	record_texture(rd, MRL_CAPTURE_COMMAND_CREATE_TEXTURE_2D, args, sizeof(args) / sizeof(args[0]), desc->data, 1, desc->mip_level_count, desc->format, desc->width, desc->height, 1, 1);
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_texture_2d(mrl_render_device_t* brd, mrl_texture_2d_t* tex)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->destroy_texture_2d(rd->target, get_handle(tex));
+	destroy_object(rd, &rd->memory.texture_2d, MRL_CAPTURE_COMMAND_DESTROY_TEXTURE_2D, tex);
+}
+
+static void generate_texture_2d_mipmaps(mrl_render_device_t* brd, mrl_texture_2d_t* tex)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->generate_texture_2d_mipmaps(rd->target, get_handle(tex));
+	record_1(rd, MRL_CAPTURE_COMMAND_GENERATE_TEXTURE_2D_MIPMAPS, get_id(tex));
+}
+
+static void bind_texture_2d(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_texture_2d_t* tex)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->bind_texture_2d(rd->target, get_handle(bp), get_handle(tex));
+	record_2(rd, MRL_CAPTURE_COMMAND_BIND_TEXTURE_2D, get_id(bp), get_id(tex));
+}
+
+static mrl_error_t update_texture_2d(mrl_render_device_t* brd, mrl_texture_2d_t* tex, const mrl_texture_2d_update_desc_t* desc)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	mrl_error_t err = rd->target->update_texture_2d(rd->target, get_handle(tex), desc);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	const mgl_u64_t args[] = { get_id(tex), desc->width, desc->height, desc->dst_x, desc->dst_y, desc->mip_level };
+	record_texture_update(rd, MRL_CAPTURE_COMMAND_UPDATE_TEXTURE_2D, args, 6, desc->data, ((mrl_capture_texture_t*)tex)->format, desc->width, desc->height, 1);
+
+	return MRL_ERROR_NONE;
+}
+
+// ---------- 3D Textures ----------
+
+static mrl_error_t create_texture_3d(mrl_render_device_t* brd, mrl_texture_3d_t** tex, const mrl_texture_3d_desc_t* desc)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+
+	mrl_capture_texture_t* obj;
+	mrl_error_t err = create_object(rd, &rd->memory.texture_3d, (void**)&obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.texture_3d, rd->target->create_texture_3d(rd->target, (mrl_texture_3d_t**)&obj->handle, desc), obj, (void**)tex);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	obj->format = desc->format;
+
+	const mgl_u64_t args[] = {
+		get_id(*tex),
+		desc->mip_level_count,
+		desc->width,
+		desc->height,
+		desc->depth,
+		desc->usage,
+		desc->format,
+	};
+	record_texture(rd, MRL_CAPTURE_COMMAND_CREATE_TEXTURE_3D, args, sizeof(args) / sizeof(args[0]), desc->data, 1, desc->mip_level_count, desc->format, desc->width, desc->height, desc->depth, 1);
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_texture_3d(mrl_render_device_t* brd, mrl_texture_3d_t* tex)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->destroy_texture_3d(rd->target, get_handle(tex));
+	destroy_object(rd, &rd->memory.texture_3d, MRL_CAPTURE_COMMAND_DESTROY_TEXTURE_3D, tex);
+}
+
+static void generate_texture_3d_mipmaps(mrl_render_device_t* brd, mrl_texture_3d_t* tex)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->generate_texture_3d_mipmaps(rd->target, get_handle(tex));
+	record_1(rd, MRL_CAPTURE_COMMAND_GENERATE_TEXTURE_3D_MIPMAPS, get_id(tex));
+}
+
+static void bind_texture_3d(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_texture_3d_t* tex)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->bind_texture_3d(rd->target, get_handle(bp), get_handle(tex));
+	record_2(rd, MRL_CAPTURE_COMMAND_BIND_TEXTURE_3D, get_id(bp), get_id(tex));
+}
+
+static mrl_error_t update_texture_3d(mrl_render_device_t* brd, mrl_texture_3d_t* tex, const mrl_texture_3d_update_desc_t* desc)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	mrl_error_t err = rd->target->update_texture_3d(rd->target, get_handle(tex), desc);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	const mgl_u64_t args[] = { get_id(tex), desc->width, desc->height, desc->depth, desc->dst_x, desc->dst_y, desc->dst_z, desc->mip_level };
+	record_texture_update(rd, MRL_CAPTURE_COMMAND_UPDATE_TEXTURE_3D, args, 8, desc->data, ((mrl_capture_texture_t*)tex)->format, desc->width, desc->height, desc->depth);
+
+	return MRL_ERROR_NONE;
+}
+
+// ---------- Cube maps ----------
+
+static mrl_error_t create_cube_map(mrl_render_device_t* brd, mrl_cube_map_t** cb, const mrl_cube_map_desc_t* desc)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+
+	mrl_capture_texture_t* obj;
+	mrl_error_t err = create_object(rd, &rd->memory.cube_map, (void**)&obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.cube_map, rd->target->create_cube_map(rd->target, (mrl_cube_map_t**)&obj->handle, desc), obj, (void**)cb);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	obj->format = desc->format;
+
+	const mgl_u64_t args[] = {
+		get_id(*cb),
+		desc->mip_level_count,
+		desc->width,
+		desc->height,
+		desc->usage,
+		desc->format,
+	};
+	record_texture(rd, MRL_CAPTURE_COMMAND_CREATE_CUBE_MAP, args, sizeof(args) / sizeof(args[0]), &desc->data[0][0], 6, desc->mip_level_count, desc->format, desc->width, desc->height, 1, 1);
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_cube_map(mrl_render_device_t* brd, mrl_cube_map_t* cb)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->destroy_cube_map(rd->target, get_handle(cb));
+	destroy_object(rd, &rd->memory.cube_map, MRL_CAPTURE_COMMAND_DESTROY_CUBE_MAP, cb);
+}
+
+static void generate_cube_map_mipmaps(mrl_render_device_t* brd, mrl_cube_map_t* cb)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->generate_cube_map_mipmaps(rd->target, get_handle(cb));
+	record_1(rd, MRL_CAPTURE_COMMAND_GENERATE_CUBE_MAP_MIPMAPS, get_id(cb));
+}
+
+static void bind_cube_map(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_cube_map_t* cb)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->bind_cube_map(rd->target, get_handle(bp), get_handle(cb));
+	record_2(rd, MRL_CAPTURE_COMMAND_BIND_CUBE_MAP, get_id(bp), get_id(cb));
+}
+
+static mrl_error_t update_cube_map(mrl_render_device_t* brd, mrl_cube_map_t* cb, const mrl_cube_map_update_desc_t* desc)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	mrl_error_t err = rd->target->update_cube_map(rd->target, get_handle(cb), desc);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	const mgl_u64_t args[] = { get_id(cb), desc->face, desc->width, desc->height, desc->dst_x, desc->dst_y, desc->mip_level };
+	record_texture_update(rd, MRL_CAPTURE_COMMAND_UPDATE_CUBE_MAP, args, 7, desc->data, ((mrl_capture_texture_t*)cb)->format, desc->width, desc->height, 1);
+
+	return MRL_ERROR_NONE;
+}
+
+// ---------- 2D Texture arrays ----------
+
+static mrl_error_t create_texture_2d_array(mrl_render_device_t* brd, mrl_texture_2d_array_t** tex, const mrl_texture_2d_array_desc_t* desc)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+
+	mrl_capture_texture_t* obj;
+	mrl_error_t err = create_object(rd, &rd->memory.texture_2d_array, (void**)&obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.texture_2d_array, rd->target->create_texture_2d_array(rd->target, (mrl_texture_2d_array_t**)&obj->handle, desc), obj, (void**)tex);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	obj->format = desc->format;
+
+	const mgl_u64_t args[] = {
+		get_id(*tex),
+		desc->mip_level_count,
+		desc->width,
+		desc->height,
+		desc->layer_count,
+		desc->usage,
+		desc->format,
+	};
+	record_texture(rd, MRL_CAPTURE_COMMAND_CREATE_TEXTURE_2D_ARRAY, args, sizeof(args) / sizeof(args[0]), desc->data, 1, desc->mip_level_count, desc->format, desc->width, desc->height, 1, desc->layer_count);
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_texture_2d_array(mrl_render_device_t* brd, mrl_texture_2d_array_t* tex)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->destroy_texture_2d_array(rd->target, get_handle(tex));
+	destroy_object(rd, &rd->memory.texture_2d_array, MRL_CAPTURE_COMMAND_DESTROY_TEXTURE_2D_ARRAY, tex);
+}
+
+static void generate_texture_2d_array_mipmaps(mrl_render_device_t* brd, mrl_texture_2d_array_t* tex)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->generate_texture_2d_array_mipmaps(rd->target, get_handle(tex));
+	record_1(rd, MRL_CAPTURE_COMMAND_GENERATE_TEXTURE_2D_ARRAY_MIPMAPS, get_id(tex));
+}
+
+static void bind_texture_2d_array(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_texture_2d_array_t* tex)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->bind_texture_2d_array(rd->target, get_handle(bp), get_handle(tex));
+	record_2(rd, MRL_CAPTURE_COMMAND_BIND_TEXTURE_2D_ARRAY, get_id(bp), get_id(tex));
+}
+
+static mrl_error_t update_texture_2d_array(mrl_render_device_t* brd, mrl_texture_2d_array_t* tex, const mrl_texture_2d_array_update_desc_t* desc)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	mrl_error_t err = rd->target->update_texture_2d_array(rd->target, get_handle(tex), desc);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	const mgl_u64_t args[] = { get_id(tex), desc->width, desc->height, desc->layer_count, desc->dst_x, desc->dst_y, desc->dst_layer, desc->mip_level };
+	record_texture_update(rd, MRL_CAPTURE_COMMAND_UPDATE_TEXTURE_2D_ARRAY, args, 8, desc->data, ((mrl_capture_texture_t*)tex)->format, desc->width, desc->height, desc->layer_count);
+
+	return MRL_ERROR_NONE;
+}
+
+// ---------- Cube map arrays ----------
+
+static mrl_error_t create_cube_map_array(mrl_render_device_t* brd, mrl_cube_map_array_t** tex, const mrl_cube_map_array_desc_t* desc)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+
+	mrl_capture_texture_t* obj;
+	mrl_error_t err = create_object(rd, &rd->memory.cube_map_array, (void**)&obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.cube_map_array, rd->target->create_cube_map_array(rd->target, (mrl_cube_map_array_t**)&obj->handle, desc), obj, (void**)tex);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	obj->format = desc->format;
+
+	// The faces of every layer are stored like the layers of a 2D texture array
+	const mgl_u64_t args[] = {
+		get_id(*tex),
+		desc->mip_level_count,
+		desc->width,
+		desc->height,
+		desc->layer_count,
+		desc->usage,
+		desc->format,
+	};
+	record_texture(rd, MRL_CAPTURE_COMMAND_CREATE_CUBE_MAP_ARRAY, args, sizeof(args) / sizeof(args[0]), desc->data, 1, desc->mip_level_count, desc->format, desc->width, desc->height, 1, desc->layer_count * 6);
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_cube_map_array(mrl_render_device_t* brd, mrl_cube_map_array_t* tex)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->destroy_cube_map_array(rd->target, get_handle(tex));
+	destroy_object(rd, &rd->memory.cube_map_array, MRL_CAPTURE_COMMAND_DESTROY_CUBE_MAP_ARRAY, tex);
+}
+
+static void generate_cube_map_array_mipmaps(mrl_render_device_t* brd, mrl_cube_map_array_t* tex)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->generate_cube_map_array_mipmaps(rd->target, get_handle(tex));
+	record_1(rd, MRL_CAPTURE_COMMAND_GENERATE_CUBE_MAP_ARRAY_MIPMAPS, get_id(tex));
+}
+
+static void bind_cube_map_array(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_cube_map_array_t* tex)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->bind_cube_map_array(rd->target, get_handle(bp), get_handle(tex));
+	record_2(rd, MRL_CAPTURE_COMMAND_BIND_CUBE_MAP_ARRAY, get_id(bp), get_id(tex));
+}
+
+static mrl_error_t update_cube_map_array(mrl_render_device_t* brd, mrl_cube_map_array_t* tex, const mrl_cube_map_array_update_desc_t* desc)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	mrl_error_t err = rd->target->update_cube_map_array(rd->target, get_handle(tex), desc);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	const mgl_u64_t args[] = { get_id(tex), desc->width, desc->height, desc->face_count, desc->dst_x, desc->dst_y, desc->dst_face, desc->mip_level };
+	record_texture_update(rd, MRL_CAPTURE_COMMAND_UPDATE_CUBE_MAP_ARRAY, args, 8, desc->data, ((mrl_capture_texture_t*)tex)->format, desc->width, desc->height, desc->face_count);
+
+	return MRL_ERROR_NONE;
+}
+
+// ---------- Buffers ----------
+
+static mrl_error_t create_buffer(mrl_capture_render_device_t* rd, mrl_object_pool_t* pool, mgl_u64_t size, mrl_capture_buffer_t** out)
+{
+	mrl_error_t err = create_object(rd, pool, (void**)out);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	(*out)->size = size;
+	(*out)->mapped = NULL;
+	(*out)->map_size = 0;
+	(*out)->map_flags = 0;
+
+	return MRL_ERROR_NONE;
+}
+
+static void* map_buffer(mrl_capture_buffer_t* buf, void* mapped, mgl_u64_t size, mgl_u32_t flags)
+{
+	// The contents of the mapped range are only known when it is unmapped
+	buf->mapped = mapped;
+	buf->map_size = mapped == NULL ? 0 : size;
+	buf->map_flags = flags;
+	return mapped;
+}
+
+static void record_unmap_buffer(mrl_capture_render_device_t* rd, mgl_u32_t opcode, mrl_capture_buffer_t* buf)
+{
+	// Explicitly flushed and read only ranges were already recorded (or don't need to be)
+	mgl_u64_t size = buf->map_size;
+	if ((buf->map_flags & MRL_MAP_FLUSH_EXPLICIT) || !(buf->map_flags & MRL_MAP_WRITE))
+		size = 0;
+
+	const mgl_u64_t args[] = { buf->id, size };
+	record(rd, opcode, args, 2, buf->mapped, size);
+	buf->mapped = NULL;
+	buf->map_size = 0;
+}
+
+static void record_flush_buffer(mrl_capture_render_device_t* rd, mgl_u32_t opcode, mrl_capture_buffer_t* buf, mgl_u64_t offset, mgl_u64_t size)
+{
+	MGL_DEBUG_ASSERT(buf->mapped != NULL && offset + size <= buf->map_size);
+	const mgl_u64_t args[] = { buf->id, offset, size };
+	record(rd, opcode, args, 3, buf->mapped + offset, size);
+}
+
+static void record_update_buffer(mrl_capture_render_device_t* rd, mgl_u32_t opcode, mrl_capture_buffer_t* buf, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	const mgl_u64_t args[] = { buf->id, offset, size };
+	record(rd, opcode, args, 3, data, size);
+}
+
+static void record_create_buffer(mrl_capture_render_device_t* rd, mgl_u32_t opcode, const mgl_u64_t* args, mgl_u32_t arg_count, const void* data, mgl_u64_t size)
+{
+	record(rd, opcode, args, arg_count, data, data == NULL ? 0 : size);
+}
+
+// ---------- Constant buffers ----------
+
+static mrl_error_t create_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t** cb, const mrl_constant_buffer_desc_t* desc)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+
+	mrl_capture_buffer_t* obj;
+	mrl_error_t err = create_buffer(rd, &rd->memory.constant_buffer, desc->size, &obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.constant_buffer, rd->target->create_constant_buffer(rd->target, (mrl_constant_buffer_t**)&obj->handle, desc), obj, (void**)cb);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	const mgl_u64_t args[] = { get_id(*cb), desc->size, desc->usage, desc->data != NULL };
+	record_create_buffer(rd, MRL_CAPTURE_COMMAND_CREATE_CONSTANT_BUFFER, args, 4, desc->data, desc->size);
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t* cb)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->destroy_constant_buffer(rd->target, get_handle(cb));
+	destroy_object(rd, &rd->memory.constant_buffer, MRL_CAPTURE_COMMAND_DESTROY_CONSTANT_BUFFER, cb);
+}
+
+static void bind_constant_buffer(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_constant_buffer_t* cb)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->bind_constant_buffer(rd->target, get_handle(bp), get_handle(cb));
+	record_2(rd, MRL_CAPTURE_COMMAND_BIND_CONSTANT_BUFFER, get_id(bp), get_id(cb));
+}
+
+static void bind_constant_buffer_range(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->bind_constant_buffer_range(rd->target, get_handle(bp), get_handle(cb), offset, size);
+	record_4(rd, MRL_CAPTURE_COMMAND_BIND_CONSTANT_BUFFER_RANGE, get_id(bp), get_id(cb), offset, size);
+}
+
+static void* map_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t* cb)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	mrl_capture_buffer_t* buf = (mrl_capture_buffer_t*)cb;
+	record_1(rd, MRL_CAPTURE_COMMAND_MAP_CONSTANT_BUFFER, buf->id);
+	return map_buffer(buf, rd->target->map_constant_buffer(rd->target, buf->handle), buf->size, MRL_MAP_READ | MRL_MAP_WRITE);
+}
+
+static void unmap_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t* cb)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	mrl_capture_buffer_t* buf = (mrl_capture_buffer_t*)cb;
+	record_unmap_buffer(rd, MRL_CAPTURE_COMMAND_UNMAP_CONSTANT_BUFFER, buf);
+	rd->target->unmap_constant_buffer(rd->target, buf->handle);
+}
+
+static void* map_constant_buffer_range(mrl_render_device_t* brd, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size, mgl_u32_t flags)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	mrl_capture_buffer_t* buf = (mrl_capture_buffer_t*)cb;
+	record_4(rd, MRL_CAPTURE_COMMAND_MAP_CONSTANT_BUFFER_RANGE, buf->id, offset, size, flags);
+	return map_buffer(buf, rd->target->map_constant_buffer_range(rd->target, buf->handle, offset, size, flags), size, flags);
+}
+
+static void flush_constant_buffer_range(mrl_render_device_t* brd, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	mrl_capture_buffer_t* buf = (mrl_capture_buffer_t*)cb;
+	record_flush_buffer(rd, MRL_CAPTURE_COMMAND_FLUSH_CONSTANT_BUFFER_RANGE, buf, offset, size);
+	rd->target->flush_constant_buffer_range(rd->target, buf->handle, offset, size);
+}
+
+static void update_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->update_constant_buffer(rd->target, get_handle(cb), offset, size, data);
+	record_update_buffer(rd, MRL_CAPTURE_COMMAND_UPDATE_CONSTANT_BUFFER, (mrl_capture_buffer_t*)cb, offset, size, data);
+}
+
+static void query_constant_buffer_structure(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_constant_buffer_structure_t* cbs)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->query_constant_buffer_structure(rd->target, get_handle(bp), cbs);
+	record_1(rd, MRL_CAPTURE_COMMAND_QUERY_CONSTANT_BUFFER_STRUCTURE, get_id(bp));
+}
+
+// ---------- Index buffers ----------
+
+static mrl_error_t create_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t** ib, const mrl_index_buffer_desc_t* desc)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+
+	mrl_capture_buffer_t* obj;
+	mrl_error_t err = create_buffer(rd, &rd->memory.index_buffer, desc->size, &obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.index_buffer, rd->target->create_index_buffer(rd->target, (mrl_index_buffer_t**)&obj->handle, desc), obj, (void**)ib);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	const mgl_u64_t args[] = { get_id(*ib), desc->size, desc->usage, desc->format, desc->data != NULL };
+	record_create_buffer(rd, MRL_CAPTURE_COMMAND_CREATE_INDEX_BUFFER, args, 5, desc->data, desc->size);
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->destroy_index_buffer(rd->target, get_handle(ib));
+	destroy_object(rd, &rd->memory.index_buffer, MRL_CAPTURE_COMMAND_DESTROY_INDEX_BUFFER, ib);
+}
+
+static void set_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->set_index_buffer(rd->target, get_handle(ib));
+	record_1(rd, MRL_CAPTURE_COMMAND_SET_INDEX_BUFFER, get_id(ib));
+}
+
+static void* map_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	mrl_capture_buffer_t* buf = (mrl_capture_buffer_t*)ib;
+	record_1(rd, MRL_CAPTURE_COMMAND_MAP_INDEX_BUFFER, buf->id);
+	return map_buffer(buf, rd->target->map_index_buffer(rd->target, buf->handle), buf->size, MRL_MAP_READ | MRL_MAP_WRITE);
+}
+
+static void unmap_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	mrl_capture_buffer_t* buf = (mrl_capture_buffer_t*)ib;
+	record_unmap_buffer(rd, MRL_CAPTURE_COMMAND_UNMAP_INDEX_BUFFER, buf);
+	rd->target->unmap_index_buffer(rd->target, buf->handle);
+}
+
+static void* map_index_buffer_range(mrl_render_device_t* brd, mrl_index_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size, mgl_u32_t flags)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	mrl_capture_buffer_t* buf = (mrl_capture_buffer_t*)ib;
+	record_4(rd, MRL_CAPTURE_COMMAND_MAP_INDEX_BUFFER_RANGE, buf->id, offset, size, flags);
+	return map_buffer(buf, rd->target->map_index_buffer_range(rd->target, buf->handle, offset, size, flags), size, flags);
+}
+
+static void flush_index_buffer_range(mrl_render_device_t* brd, mrl_index_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	mrl_capture_buffer_t* buf = (mrl_capture_buffer_t*)ib;
+	record_flush_buffer(rd, MRL_CAPTURE_COMMAND_FLUSH_INDEX_BUFFER_RANGE, buf, offset, size);
+	rd->target->flush_index_buffer_range(rd->target, buf->handle, offset, size);
+}
+
+static void update_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->update_index_buffer(rd->target, get_handle(ib), offset, size, data);
+	record_update_buffer(rd, MRL_CAPTURE_COMMAND_UPDATE_INDEX_BUFFER, (mrl_capture_buffer_t*)ib, offset, size, data);
+}
+
+// ---------- Indirect buffers ----------
+
+static mrl_error_t create_indirect_buffer(mrl_render_device_t* brd, mrl_indirect_buffer_t** ib, const mrl_indirect_buffer_desc_t* desc)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+
+	mrl_capture_buffer_t* obj;
+	mrl_error_t err = create_buffer(rd, &rd->memory.indirect_buffer, desc->size, &obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.indirect_buffer, rd->target->create_indirect_buffer(rd->target, (mrl_indirect_buffer_t**)&obj->handle, desc), obj, (void**)ib);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	const mgl_u64_t args[] = { get_id(*ib), desc->size, desc->usage, desc->data != NULL };
+	record_create_buffer(rd, MRL_CAPTURE_COMMAND_CREATE_INDIRECT_BUFFER, args, 4, desc->data, desc->size);
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_indirect_buffer(mrl_render_device_t* brd, mrl_indirect_buffer_t* ib)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->destroy_indirect_buffer(rd->target, get_handle(ib));
+	destroy_object(rd, &rd->memory.indirect_buffer, MRL_CAPTURE_COMMAND_DESTROY_INDIRECT_BUFFER, ib);
+}
+
+static void update_indirect_buffer(mrl_render_device_t* brd, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->update_indirect_buffer(rd->target, get_handle(ib), offset, size, data);
+	record_update_buffer(rd, MRL_CAPTURE_COMMAND_UPDATE_INDIRECT_BUFFER, (mrl_capture_buffer_t*)ib, offset, size, data);
+}
+
+// ---------- Vertex buffers ----------
+
+static mrl_error_t create_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t** vb, const mrl_vertex_buffer_desc_t* desc)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+
+	mrl_capture_buffer_t* obj;
+	mrl_error_t err = create_buffer(rd, &rd->memory.vertex_buffer, desc->size, &obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.vertex_buffer, rd->target->create_vertex_buffer(rd->target, (mrl_vertex_buffer_t**)&obj->handle, desc), obj, (void**)vb);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	const mgl_u64_t args[] = { get_id(*vb), desc->size, desc->usage, desc->data != NULL };
+	record_create_buffer(rd, MRL_CAPTURE_COMMAND_CREATE_VERTEX_BUFFER, args, 4, desc->data, desc->size);
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->destroy_vertex_buffer(rd->target, get_handle(vb));
+	destroy_object(rd, &rd->memory.vertex_buffer, MRL_CAPTURE_COMMAND_DESTROY_VERTEX_BUFFER, vb);
+}
+
+static void* map_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	mrl_capture_buffer_t* buf = (mrl_capture_buffer_t*)vb;
+	record_1(rd, MRL_CAPTURE_COMMAND_MAP_VERTEX_BUFFER, buf->id);
+	return map_buffer(buf, rd->target->map_vertex_buffer(rd->target, buf->handle), buf->size, MRL_MAP_READ | MRL_MAP_WRITE);
+}
+
+static void unmap_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	mrl_capture_buffer_t* buf = (mrl_capture_buffer_t*)vb;
+	record_unmap_buffer(rd, MRL_CAPTURE_COMMAND_UNMAP_VERTEX_BUFFER, buf);
+	rd->target->unmap_vertex_buffer(rd->target, buf->handle);
+}
+
+static void* map_vertex_buffer_range(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb, mgl_u64_t offset, mgl_u64_t size, mgl_u32_t flags)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	mrl_capture_buffer_t* buf = (mrl_capture_buffer_t*)vb;
+	record_4(rd, MRL_CAPTURE_COMMAND_MAP_VERTEX_BUFFER_RANGE, buf->id, offset, size, flags);
+	return map_buffer(buf, rd->target->map_vertex_buffer_range(rd->target, buf->handle, offset, size, flags), size, flags);
+}
+
+static void flush_vertex_buffer_range(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb, mgl_u64_t offset, mgl_u64_t size)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	mrl_capture_buffer_t* buf = (mrl_capture_buffer_t*)vb;
+	record_flush_buffer(rd, MRL_CAPTURE_COMMAND_FLUSH_VERTEX_BUFFER_RANGE, buf, offset, size);
+	rd->target->flush_vertex_buffer_range(rd->target, buf->handle, offset, size);
+}
+
+static void update_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->update_vertex_buffer(rd->target, get_handle(vb), offset, size, data);
+	record_update_buffer(rd, MRL_CAPTURE_COMMAND_UPDATE_VERTEX_BUFFER, (mrl_capture_buffer_t*)vb, offset, size, data);
+}
+
+// ---------- Vertex arrays ----------
+
+static mrl_error_t create_vertex_array(mrl_render_device_t* brd, mrl_vertex_array_t** va, const mrl_vertex_array_desc_t* desc)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+
+	// Replace the capture handles with the target handles
+	mrl_vertex_array_desc_t target_desc = *desc;
+	for (mgl_u32_t i = 0; i < desc->buffer_count; ++i)
+		target_desc.buffers[i] = get_handle(desc->buffers[i]);
+	target_desc.shader_pipeline = get_handle(desc->shader_pipeline);
+
+	mrl_capture_object_t* obj;
+	mrl_error_t err = create_object(rd, &rd->memory.vertex_array, (void**)&obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.vertex_array, rd->target->create_vertex_array(rd->target, (mrl_vertex_array_t**)&obj->handle, &target_desc), obj, (void**)va);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	mgl_u64_t args[4 + MRL_MAX_VERTEX_ARRAY_BUFFER_COUNT + 6 * MRL_MAX_VERTEX_ARRAY_ELEMENT_COUNT];
+	mgl_u32_t arg_count = 0;
+	args[arg_count++] = get_id(*va);
+	args[arg_count++] = desc->element_count;
+	args[arg_count++] = desc->buffer_count;
+	args[arg_count++] = get_id(desc->shader_pipeline);
+	for (mgl_u32_t i = 0; i < desc->buffer_count; ++i)
+		args[arg_count++] = get_id(desc->buffers[i]);
+	for (mgl_u32_t i = 0; i < desc->element_count; ++i)
+	{
+		args[arg_count++] = desc->elements[i].type;
+		args[arg_count++] = desc->elements[i].size;
+		args[arg_count++] = desc->elements[i].buffer.stride;
+		args[arg_count++] = desc->elements[i].buffer.offset;
+		args[arg_count++] = desc->elements[i].buffer.index;
+	}
+
+	// Stored after the other members, so that traces captured before step rates existed can still be replayed
+	for (mgl_u32_t i = 0; i < desc->element_count; ++i)
+		args[arg_count++] = desc->elements[i].instance_step_rate;
+
+	// The element names are stored in the payload
+	mgl_u64_t payload_size = (mgl_u64_t)desc->element_count * MRL_MAX_VERTEX_ELEMENT_NAME_SIZE;
+	begin_record(rd, MRL_CAPTURE_COMMAND_CREATE_VERTEX_ARRAY, args, arg_count, payload_size);
+	for (mgl_u32_t i = 0; i < desc->element_count; ++i)
+		write_bytes(rd, desc->elements[i].name, MRL_MAX_VERTEX_ELEMENT_NAME_SIZE);
+	end_record(rd, payload_size);
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_vertex_array(mrl_render_device_t* brd, mrl_vertex_array_t* va)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->destroy_vertex_array(rd->target, get_handle(va));
+	destroy_object(rd, &rd->memory.vertex_array, MRL_CAPTURE_COMMAND_DESTROY_VERTEX_ARRAY, va);
+}
+
+static void set_vertex_array(mrl_render_device_t* brd, mrl_vertex_array_t* va)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->set_vertex_array(rd->target, get_handle(va));
+	record_1(rd, MRL_CAPTURE_COMMAND_SET_VERTEX_ARRAY, get_id(va));
+}
+
+// ---------- Stream allocators ----------
+
+static mrl_error_t create_stream_allocator(mrl_render_device_t* brd, mrl_stream_allocator_t** sa, const mrl_stream_allocator_desc_t* desc)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	MGL_DEBUG_ASSERT(desc->buffer != NULL);
+
+	mrl_stream_allocator_desc_t target_desc = *desc;
+	target_desc.buffer = get_handle(desc->buffer);
+
+	mrl_capture_stream_allocator_t* obj;
+	mrl_error_t err = create_object(rd, &rd->memory.stream_allocator, (void**)&obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.stream_allocator, rd->target->create_stream_allocator(rd->target, (mrl_stream_allocator_t**)&obj->handle, &target_desc), obj, (void**)sa);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	obj->buffer = (mrl_capture_buffer_t*)desc->buffer;
+	obj->mapped = NULL;
+	obj->map_size = 0;
+
+	record_3(rd, MRL_CAPTURE_COMMAND_CREATE_STREAM_ALLOCATOR, obj->id, desc->buffer_type, obj->buffer->id);
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_stream_allocator(mrl_render_device_t* brd, mrl_stream_allocator_t* sa)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->destroy_stream_allocator(rd->target, get_handle(sa));
+	destroy_object(rd, &rd->memory.stream_allocator, MRL_CAPTURE_COMMAND_DESTROY_STREAM_ALLOCATOR, sa);
+}
+
+static void* map_stream_allocation(mrl_render_device_t* brd, mrl_stream_allocator_t* sa, mgl_u64_t size, mgl_u64_t alignment, mgl_u64_t* offset)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	mrl_capture_stream_allocator_t* obj = (mrl_capture_stream_allocator_t*)sa;
+
+	obj->mapped = rd->target->map_stream_allocation(rd->target, obj->handle, size, alignment, offset);
+	if (obj->mapped == NULL)
+		return NULL;
+	obj->map_size = size;
+
+	// The offset is stored so that the replay can check it gets the same one
+	record_4(rd, MRL_CAPTURE_COMMAND_MAP_STREAM_ALLOCATION, obj->id, size, alignment, *offset);
+
+	return obj->mapped;
+}
+
+static void unmap_stream_allocation(mrl_render_device_t* brd, mrl_stream_allocator_t* sa)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	mrl_capture_stream_allocator_t* obj = (mrl_capture_stream_allocator_t*)sa;
+
+	const mgl_u64_t args[] = { obj->id, obj->map_size };
+	record(rd, MRL_CAPTURE_COMMAND_UNMAP_STREAM_ALLOCATION, args, 2, obj->mapped, obj->map_size);
+	obj->mapped = NULL;
+	obj->map_size = 0;
+
+	rd->target->unmap_stream_allocation(rd->target, obj->handle);
+}
+
+static void end_stream_allocator_frame(mrl_render_device_t* brd, mrl_stream_allocator_t* sa)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->end_stream_allocator_frame(rd->target, get_handle(sa));
+	record_1(rd, MRL_CAPTURE_COMMAND_END_STREAM_ALLOCATOR_FRAME, get_id(sa));
+}
+
+// ---------- Upload queues ----------
+
+// Upload queues only change when the texture data reaches the GPU, so they aren't stored,
+// and uploads are stored as the equivalent texture updates
+static mrl_error_t create_upload_queue(mrl_render_device_t* brd, mrl_upload_queue_t** uq, const mrl_upload_queue_desc_t* desc)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+
+	mrl_capture_object_t* obj;
+	mrl_error_t err = create_object(rd, &rd->memory.upload_queue, (void**)&obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.upload_queue, rd->target->create_upload_queue(rd->target, (mrl_upload_queue_t**)&obj->handle, desc), obj, (void**)uq);
+	return err;
+}
+
+static void destroy_upload_queue(mrl_render_device_t* brd, mrl_upload_queue_t* uq)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->destroy_upload_queue(rd->target, get_handle(uq));
+
+	// Deallocate object
+	mrl_deallocate_object(&rd->memory.upload_queue, uq);
+}
+
+static mrl_error_t upload_texture_1d(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mrl_texture_1d_t* tex, const mrl_texture_1d_update_desc_t* desc, mgl_u64_t* token)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	mrl_error_t err = rd->target->upload_texture_1d(rd->target, get_handle(uq), get_handle(tex), desc, token);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	const mgl_u64_t args[] = { get_id(tex), desc->width, desc->dst_x, desc->mip_level };
+	record_texture_update(rd, MRL_CAPTURE_COMMAND_UPDATE_TEXTURE_1D, args, 4, desc->data, ((mrl_capture_texture_t*)tex)->format, desc->width, 1, 1);
+
+	return MRL_ERROR_NONE;
+}
+
+static mrl_error_t upload_texture_2d(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mrl_texture_2d_t* tex, const mrl_texture_2d_update_desc_t* desc, mgl_u64_t* token)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	mrl_error_t err = rd->target->upload_texture_2d(rd->target, get_handle(uq), get_handle(tex), desc, token);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	const mgl_u64_t args[] = { get_id(tex), desc->width, desc->height, desc->dst_x, desc->dst_y, desc->mip_level };
+	record_texture_update(rd, MRL_CAPTURE_COMMAND_UPDATE_TEXTURE_2D, args, 6, desc->data, ((mrl_capture_texture_t*)tex)->format, desc->width, desc->height, 1);
+
+	return MRL_ERROR_NONE;
+}
+
+static mrl_error_t upload_texture_3d(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mrl_texture_3d_t* tex, const mrl_texture_3d_update_desc_t* desc, mgl_u64_t* token)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	mrl_error_t err = rd->target->upload_texture_3d(rd->target, get_handle(uq), get_handle(tex), desc, token);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	const mgl_u64_t args[] = { get_id(tex), desc->width, desc->height, desc->depth, desc->dst_x, desc->dst_y, desc->dst_z, desc->mip_level };
+	record_texture_update(rd, MRL_CAPTURE_COMMAND_UPDATE_TEXTURE_3D, args, 8, desc->data, ((mrl_capture_texture_t*)tex)->format, desc->width, desc->height, desc->depth);
+
+	return MRL_ERROR_NONE;
+}
+
+static mrl_error_t upload_cube_map(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mrl_cube_map_t* cb, const mrl_cube_map_update_desc_t* desc, mgl_u64_t* token)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	mrl_error_t err = rd->target->upload_cube_map(rd->target, get_handle(uq), get_handle(cb), desc, token);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	const mgl_u64_t args[] = { get_id(cb), desc->face, desc->width, desc->height, desc->dst_x, desc->dst_y, desc->mip_level };
+	record_texture_update(rd, MRL_CAPTURE_COMMAND_UPDATE_CUBE_MAP, args, 7, desc->data, ((mrl_capture_texture_t*)cb)->format, desc->width, desc->height, 1);
+
+	return MRL_ERROR_NONE;
+}
+
+static mgl_bool_t is_upload_complete(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mgl_u64_t token)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	return rd->target->is_upload_complete(rd->target, get_handle(uq), token);
+}
+
+static void wait_upload(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mgl_u64_t token)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->wait_upload(rd->target, get_handle(uq), token);
+}
+
+// ---------- Shaders ----------
+
+static mrl_error_t create_shader_stage(mrl_render_device_t* brd, mrl_shader_stage_t** stage, const mrl_shader_stage_desc_t* desc)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+
+	// Only text sources can be stored, since the size of binary and native sources isn't known
+	if (desc->src_type == MRL_SHADER_SOURCE_SPIRV || desc->src_type == MRL_SHADER_SOURCE_NATIVE)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_UNSUPPORTED_SHADER_SOURCE, u8"Failed to create shader stage: binary and native shader sources can't be captured");
+		return MRL_ERROR_UNSUPPORTED_SHADER_SOURCE;
+	}
+
+	mrl_capture_object_t* obj;
+	mrl_error_t err = create_object(rd, &rd->memory.shader_stage, (void**)&obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.shader_stage, rd->target->create_shader_stage(rd->target, (mrl_shader_stage_t**)&obj->handle, desc), obj, (void**)stage);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	// Store the source with its null terminator
+	const mgl_chr8_t* src = (const mgl_chr8_t*)desc->src;
+	mgl_u64_t src_size = 0;
+	while (src[src_size] != 0)
+		++src_size;
+
+	const mgl_u64_t args[] = { get_id(*stage), desc->stage, desc->src_type };
+	record(rd, MRL_CAPTURE_COMMAND_CREATE_SHADER_STAGE, args, 3, src, src_size + 1);
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_shader_stage(mrl_render_device_t* brd, mrl_shader_stage_t* stage)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->destroy_shader_stage(rd->target, get_handle(stage));
+	destroy_object(rd, &rd->memory.shader_stage, MRL_CAPTURE_COMMAND_DESTROY_SHADER_STAGE, stage);
+}
+
+static mrl_error_t create_shader_pipeline(mrl_render_device_t* brd, mrl_shader_pipeline_t** pipeline, const mrl_shader_pipeline_desc_t* desc)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+
+	mrl_shader_pipeline_desc_t target_desc = *desc;
+	target_desc.vertex = get_handle(desc->vertex);
+	target_desc.pixel = get_handle(desc->pixel);
+
+	mrl_capture_shader_pipeline_t* obj;
+	mrl_error_t err = create_object(rd, &rd->memory.shader_pipeline, (void**)&obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.shader_pipeline, rd->target->create_shader_pipeline(rd->target, (mrl_shader_pipeline_t**)&obj->handle, &target_desc), obj, (void**)pipeline);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	// Binding points are added as they are queried
+	obj->bps = NULL;
+
+	record_3(rd, MRL_CAPTURE_COMMAND_CREATE_SHADER_PIPELINE, obj->id, get_id(desc->vertex), get_id(desc->pixel));
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_shader_pipeline(mrl_render_device_t* brd, mrl_shader_pipeline_t* pipeline)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->destroy_shader_pipeline(rd->target, get_handle(pipeline));
+
+	mrl_capture_binding_point_t* bp = ((mrl_capture_shader_pipeline_t*)pipeline)->bps;
+	while (bp != NULL)
+	{
+		mrl_capture_binding_point_t* next = bp->next;
+		mrl_deallocate_object(&rd->memory.binding_point, bp);
+		bp = next;
+	}
+
+	destroy_object(rd, &rd->memory.shader_pipeline, MRL_CAPTURE_COMMAND_DESTROY_SHADER_PIPELINE, pipeline);
+}
+
+static void set_shader_pipeline(mrl_render_device_t* brd, mrl_shader_pipeline_t* pipeline)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->set_shader_pipeline(rd->target, get_handle(pipeline));
+	record_1(rd, MRL_CAPTURE_COMMAND_SET_SHADER_PIPELINE, get_id(pipeline));
+}
+
+static mrl_capture_binding_point_t* wrap_binding_point(mrl_capture_render_device_t* rd, mrl_capture_shader_pipeline_t* pp, void* handle)
+{
+	if (handle == NULL)
+		return NULL;
+
+	for (mrl_capture_binding_point_t* bp = pp->bps; bp != NULL; bp = bp->next)
+		if (bp->handle == handle)
+			return bp;
+
+	mrl_capture_binding_point_t* bp;
+	mgl_error_t err = mrl_allocate_object(&rd->memory.binding_point, (void**)&bp);
+	if (err != MGL_ERROR_NONE)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(mrl_make_mgl_error(err), u8"Failed to get shader binding point: failed to allocate binding point");
+		return NULL;
+	}
+
+	bp->id = rd->next_id++;
+	bp->handle = handle;
+	bp->next = pp->bps;
+	pp->bps = bp;
+	return bp;
+}
+
+static mrl_shader_binding_point_t* get_shader_binding_point(mrl_render_device_t* brd, mrl_shader_pipeline_t* pipeline, const mgl_chr8_t* name)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	mrl_capture_shader_pipeline_t* pp = (mrl_capture_shader_pipeline_t*)pipeline;
+	mrl_capture_binding_point_t* bp = wrap_binding_point(rd, pp, rd->target->get_shader_binding_point(rd->target, pp->handle, name));
+
+	// Store the name with its null terminator
+	mgl_u64_t name_size = 0;
+	while (name[name_size] != 0)
+		++name_size;
+
+	const mgl_u64_t args[] = { pp->id, get_id(bp) };
+	record(rd, MRL_CAPTURE_COMMAND_GET_SHADER_BINDING_POINT, args, 2, name, name_size + 1);
+
+	return (mrl_shader_binding_point_t*)bp;
+}
+
+static mrl_shader_binding_point_t* get_shader_binding_point_by_id(mrl_render_device_t* brd, mrl_shader_pipeline_t* pipeline, mgl_u64_t id)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	mrl_capture_shader_pipeline_t* pp = (mrl_capture_shader_pipeline_t*)pipeline;
+	mrl_capture_binding_point_t* bp = wrap_binding_point(rd, pp, rd->target->get_shader_binding_point_by_id(rd->target, pp->handle, id));
+	record_3(rd, MRL_CAPTURE_COMMAND_GET_SHADER_BINDING_POINT_BY_ID, pp->id, get_id(bp), id);
+	return (mrl_shader_binding_point_t*)bp;
+}
+
+// ---------- Draw functions ----------
+
+static void clear_color(mrl_render_device_t* brd, mgl_f32_t r, mgl_f32_t g, mgl_f32_t b, mgl_f32_t a)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->clear_color(rd->target, r, g, b, a);
+	record_4(rd, MRL_CAPTURE_COMMAND_CLEAR_COLOR, float_bits(r), float_bits(g), float_bits(b), float_bits(a));
+}
+
+static void clear_depth(mrl_render_device_t* brd, mgl_f32_t depth)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->clear_depth(rd->target, depth);
+	record_1(rd, MRL_CAPTURE_COMMAND_CLEAR_DEPTH, float_bits(depth));
+}
+
+static void clear_stencil(mrl_render_device_t* brd, mgl_i32_t stencil)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->clear_stencil(rd->target, stencil);
+	record_1(rd, MRL_CAPTURE_COMMAND_CLEAR_STENCIL, (mgl_u64_t)(mgl_i64_t)stencil);
+}
+
+static void swap_buffers(mrl_render_device_t* brd)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->swap_buffers(rd->target);
+	record_0(rd, MRL_CAPTURE_COMMAND_SWAP_BUFFERS);
+
+	// Write every frame as soon as it ends, so that the trace is usable even if the application crashes
+	flush_output(rd);
+}
+
+static void draw_triangles(mrl_render_device_t* brd, mgl_u64_t offset, mgl_u64_t count)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->draw_triangles(rd->target, offset, count);
+	record_2(rd, MRL_CAPTURE_COMMAND_DRAW_TRIANGLES, offset, count);
+}
+
+static void draw_triangles_indexed(mrl_render_device_t* brd, mgl_u64_t offset, mgl_u64_t count)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->draw_triangles_indexed(rd->target, offset, count);
+	record_2(rd, MRL_CAPTURE_COMMAND_DRAW_TRIANGLES_INDEXED, offset, count);
+}
+
+static void draw_triangles_instanced(mrl_render_device_t* brd, mgl_u64_t offset, mgl_u64_t count, mgl_u64_t instance_count)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->draw_triangles_instanced(rd->target, offset, count, instance_count);
+	record_3(rd, MRL_CAPTURE_COMMAND_DRAW_TRIANGLES_INSTANCED, offset, count, instance_count);
+}
+
+static void draw_triangles_indexed_instanced(mrl_render_device_t* brd, mgl_u64_t offset, mgl_u64_t count, mgl_u64_t instance_count)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->draw_triangles_indexed_instanced(rd->target, offset, count, instance_count);
+	record_3(rd, MRL_CAPTURE_COMMAND_DRAW_TRIANGLES_INDEXED_INSTANCED, offset, count, instance_count);
+}
+
+static void draw_triangles_indexed_base_vertex(mrl_render_device_t* brd, mgl_u64_t offset, mgl_u64_t count, mgl_i64_t base_vertex)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->draw_triangles_indexed_base_vertex(rd->target, offset, count, base_vertex);
+	record_3(rd, MRL_CAPTURE_COMMAND_DRAW_TRIANGLES_INDEXED_BASE_VERTEX, offset, count, (mgl_u64_t)base_vertex);
+}
+
+static void draw_triangles_indexed_instanced_base_vertex(mrl_render_device_t* brd, mgl_u64_t offset, mgl_u64_t count, mgl_u64_t instance_count, mgl_i64_t base_vertex)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->draw_triangles_indexed_instanced_base_vertex(rd->target, offset, count, instance_count, base_vertex);
+	record_4(rd, MRL_CAPTURE_COMMAND_DRAW_TRIANGLES_INDEXED_INSTANCED_BASE_VERTEX, offset, count, instance_count, (mgl_u64_t)base_vertex);
+}
+
+static void record_multi_draw(mrl_capture_render_device_t* rd, mgl_u32_t opcode, const mgl_u64_t* offsets, const mgl_u64_t* counts, const mgl_i64_t* base_vertices, mgl_u64_t draw_count)
+{
+	const mgl_u64_t args[] = { draw_count, base_vertices != NULL };
+	mgl_u64_t array_size = draw_count * sizeof(mgl_u64_t);
+	mgl_u64_t payload_size = array_size * (base_vertices != NULL ? 3 : 2);
+
+	begin_record(rd, opcode, args, 2, payload_size);
+	if (draw_count > 0)
+	{
+		write_bytes(rd, offsets, array_size);
+		write_bytes(rd, counts, array_size);
+		if (base_vertices != NULL)
+			write_bytes(rd, base_vertices, array_size);
+	}
+	end_record(rd, payload_size);
+}
+
+static void multi_draw_triangles(mrl_render_device_t* brd, const mgl_u64_t* offsets, const mgl_u64_t* counts, mgl_u64_t draw_count)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->multi_draw_triangles(rd->target, offsets, counts, draw_count);
+	record_multi_draw(rd, MRL_CAPTURE_COMMAND_MULTI_DRAW_TRIANGLES, offsets, counts, NULL, draw_count);
+}
+
+static void multi_draw_triangles_indexed(mrl_render_device_t* brd, const mgl_u64_t* offsets, const mgl_u64_t* counts, const mgl_i64_t* base_vertices, mgl_u64_t draw_count)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->multi_draw_triangles_indexed(rd->target, offsets, counts, base_vertices, draw_count);
+	record_multi_draw(rd, MRL_CAPTURE_COMMAND_MULTI_DRAW_TRIANGLES_INDEXED, offsets, counts, base_vertices, draw_count);
+}
+
+static void draw_triangles_indirect(mrl_render_device_t* brd, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t draw_count)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->draw_triangles_indirect(rd->target, get_handle(ib), offset, draw_count);
+	record_3(rd, MRL_CAPTURE_COMMAND_DRAW_TRIANGLES_INDIRECT, get_id(ib), offset, draw_count);
+}
+
+static void draw_triangles_indexed_indirect(mrl_render_device_t* brd, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t draw_count)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->draw_triangles_indexed_indirect(rd->target, get_handle(ib), offset, draw_count);
+	record_3(rd, MRL_CAPTURE_COMMAND_DRAW_TRIANGLES_INDEXED_INDIRECT, get_id(ib), offset, draw_count);
+}
+
+static void set_viewport(mrl_render_device_t* brd, mgl_i32_t x, mgl_i32_t y, mgl_i32_t w, mgl_i32_t h)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->set_viewport(rd->target, x, y, w, h);
+	record_4(rd, MRL_CAPTURE_COMMAND_SET_VIEWPORT, (mgl_u64_t)(mgl_i64_t)x, (mgl_u64_t)(mgl_i64_t)y, (mgl_u64_t)(mgl_i64_t)w, (mgl_u64_t)(mgl_i64_t)h);
+}
+
+// ---------- Getter functions ----------
+
+// The capture device is transparent, so the application takes the same code paths as with the target device
+static const mgl_chr8_t* get_type_name(mrl_render_device_t* brd)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	return rd->target->get_type_name(rd->target);
+}
+
+static mgl_i64_t get_property_i(mrl_render_device_t* brd, mgl_enum_t name)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	return rd->target->get_property_i(rd->target, name);
+}
+
+static mgl_f64_t get_property_f(mrl_render_device_t* brd, mgl_enum_t name)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	return rd->target->get_property_f(rd->target, name);
+}
+
+static void get_object_pool_stats(mrl_render_device_t* brd, mgl_enum_t type, mrl_object_pool_stats_t* stats)
+{
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+	rd->target->get_object_pool_stats(rd->target, type, stats);
+}
+
+static mrl_object_pool_t* get_rd_pool(mrl_capture_render_device_t* rd, mgl_enum_t type)
+{
+	switch (type)
+	{
+		case MRL_OBJECT_FRAMEBUFFER: return &rd->memory.framebuffer;
+		case MRL_OBJECT_RASTER_STATE: return &rd->memory.raster_state;
+		case MRL_OBJECT_DEPTH_STENCIL_STATE: return &rd->memory.depth_stencil_state;
+		case MRL_OBJECT_BLEND_STATE: return &rd->memory.blend_state;
+		case MRL_OBJECT_SAMPLER: return &rd->memory.sampler;
+		case MRL_OBJECT_TEXTURE_1D: return &rd->memory.texture_1d;
+		case MRL_OBJECT_TEXTURE_2D: return &rd->memory.texture_2d;
+		case MRL_OBJECT_TEXTURE_3D: return &rd->memory.texture_3d;
+		case MRL_OBJECT_CUBE_MAP: return &rd->memory.cube_map;
+		case MRL_OBJECT_CONSTANT_BUFFER: return &rd->memory.constant_buffer;
+		case MRL_OBJECT_INDEX_BUFFER: return &rd->memory.index_buffer;
+		case MRL_OBJECT_VERTEX_BUFFER: return &rd->memory.vertex_buffer;
+		case MRL_OBJECT_VERTEX_ARRAY: return &rd->memory.vertex_array;
+		case MRL_OBJECT_SHADER_STAGE: return &rd->memory.shader_stage;
+		case MRL_OBJECT_SHADER_PIPELINE: return &rd->memory.shader_pipeline;
+		case MRL_OBJECT_STREAM_ALLOCATOR: return &rd->memory.stream_allocator;
+		case MRL_OBJECT_INDIRECT_BUFFER: return &rd->memory.indirect_buffer;
+		case MRL_OBJECT_UPLOAD_QUEUE: return &rd->memory.upload_queue;
+		case MRL_OBJECT_TEXTURE_2D_ARRAY: return &rd->memory.texture_2d_array;
+		case MRL_OBJECT_CUBE_MAP_ARRAY: return &rd->memory.cube_map_array;
+		default: return NULL;
+	}
+}
+
+static mrl_error_t create_rd_allocators(mrl_capture_render_device_t* rd, const mrl_render_device_desc_t* desc)
+{
+	// Object size and number of objects reserved up front, by object type
+	const mgl_u64_t sizes[MRL_CAPTURE_OBJECT_POOL_COUNT][2] = {
+		{ sizeof(mrl_capture_object_t), desc->max_framebuffer_count },
+		{ sizeof(mrl_capture_object_t), desc->max_raster_state_count },
+		{ sizeof(mrl_capture_object_t), desc->max_depth_stencil_state_count },
+		{ sizeof(mrl_capture_object_t), desc->max_blend_state_count },
+		{ sizeof(mrl_capture_object_t), desc->max_sampler_count },
+		{ sizeof(mrl_capture_texture_t), desc->max_texture_1d_count },
+		{ sizeof(mrl_capture_texture_t), desc->max_texture_2d_count },
+		{ sizeof(mrl_capture_texture_t), desc->max_texture_3d_count },
+		{ sizeof(mrl_capture_texture_t), desc->max_cube_map_count },
+		{ sizeof(mrl_capture_buffer_t), desc->max_constant_buffer_count },
+		{ sizeof(mrl_capture_buffer_t), desc->max_index_buffer_count },
+		{ sizeof(mrl_capture_buffer_t), desc->max_vertex_buffer_count },
+		{ sizeof(mrl_capture_object_t), desc->max_vertex_array_count },
+		{ sizeof(mrl_capture_object_t), desc->max_shader_stage_count },
+		{ sizeof(mrl_capture_shader_pipeline_t), desc->max_shader_pipeline_count },
+		{ sizeof(mrl_capture_stream_allocator_t), desc->max_stream_allocator_count },
+		{ sizeof(mrl_capture_buffer_t), desc->max_indirect_buffer_count },
+		{ sizeof(mrl_capture_object_t), desc->max_upload_queue_count },
+		{ sizeof(mrl_capture_texture_t), desc->max_texture_2d_array_count },
+		{ sizeof(mrl_capture_texture_t), desc->max_cube_map_array_count },
+	};
+
+	// Create object pools
+	for (mgl_enum_t i = 0; i < MRL_CAPTURE_OBJECT_POOL_COUNT; ++i)
+	{
+		mgl_error_t err = mrl_init_object_pool(get_rd_pool(rd, i), rd->allocator, sizes[i][0], sizes[i][1]);
+		if (err != MGL_ERROR_NONE)
+		{
+			while (i-- > 0)
+				mrl_terminate_object_pool(get_rd_pool(rd, i));
+			return mrl_make_mgl_error(err);
+		}
+	}
+
+	// Nothing is reserved for binding points, so initializing their pool can't fail
+	mrl_init_object_pool(&rd->memory.binding_point, rd->allocator, sizeof(mrl_capture_binding_point_t), 0);
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_rd_allocators(mrl_capture_render_device_t* rd)
+{
+	for (mgl_enum_t i = 0; i < MRL_CAPTURE_OBJECT_POOL_COUNT; ++i)
+		mrl_terminate_object_pool(get_rd_pool(rd, i));
+	mrl_terminate_object_pool(&rd->memory.binding_point);
+}
+
+static void set_rd_functions(mrl_capture_render_device_t* rd)
+{
+	// Framebuffer functions
+	rd->base.create_framebuffer = &create_framebuffer;
+	rd->base.destroy_framebuffer = &destroy_framebuffer;
+	rd->base.set_framebuffer = &set_framebuffer;
+
+	// Raster state functions
+	rd->base.create_raster_state = &create_raster_state;
+	rd->base.destroy_raster_state = &destroy_raster_state;
+	rd->base.set_raster_state = &set_raster_state;
+
+	// Depth stencil state functions
+	rd->base.create_depth_stencil_state = &create_depth_stencil_state;
+	rd->base.destroy_depth_stencil_state = &destroy_depth_stencil_state;
+	rd->base.set_depth_stencil_state = &set_depth_stencil_state;
+
+	// Blend state functions
+	rd->base.create_blend_state = &create_blend_state;
+	rd->base.destroy_blend_state = &destroy_blend_state;
+	rd->base.set_blend_state = &set_blend_state;
+
+	// Sampler functions
+	rd->base.create_sampler = &create_sampler;
+	rd->base.destroy_sampler = &destroy_sampler;
+	rd->base.bind_sampler = &bind_sampler;
+
+	// Texture 1D functions
+	rd->base.create_texture_1d = &create_texture_1d;
+	rd->base.destroy_texture_1d = &destroy_texture_1d;
+	rd->base.generate_texture_1d_mipmaps = &generate_texture_1d_mipmaps;
+	rd->base.bind_texture_1d = &bind_texture_1d;
+	rd->base.update_texture_1d = &update_texture_1d;
+
+	// Texture 2D functions
+	rd->base.create_texture_2d = &create_texture_2d;
+	rd->base.destroy_texture_2d = &destroy_texture_2d;
+	rd->base.generate_texture_2d_mipmaps = &generate_texture_2d_mipmaps;
+	rd->base.bind_texture_2d = &bind_texture_2d;
+	rd->base.update_texture_2d = &update_texture_2d;
+
+	// Texture 3D functions
+	rd->base.create_texture_3d = &create_texture_3d;
+	rd->base.destroy_texture_3d = &destroy_texture_3d;
+	rd->base.generate_texture_3d_mipmaps = &generate_texture_3d_mipmaps;
+	rd->base.bind_texture_3d = &bind_texture_3d;
+	rd->base.update_texture_3d = &update_texture_3d;
+
+	// Cube map functions
+	rd->base.create_cube_map = &create_cube_map;
+	rd->base.destroy_cube_map = &destroy_cube_map;
+	rd->base.generate_cube_map_mipmaps = &generate_cube_map_mipmaps;
+	rd->base.bind_cube_map = &bind_cube_map;
+	rd->base.update_cube_map = &update_cube_map;
+
+	// Texture 2D array functions
+	rd->base.create_texture_2d_array = &create_texture_2d_array;
+	rd->base.destroy_texture_2d_array = &destroy_texture_2d_array;
+	rd->base.generate_texture_2d_array_mipmaps = &generate_texture_2d_array_mipmaps;
+	rd->base.bind_texture_2d_array = &bind_texture_2d_array;
+	rd->base.update_texture_2d_array = &update_texture_2d_array;
+
+	// Cube map array functions
+	rd->base.create_cube_map_array = &create_cube_map_array;
+	rd->base.destroy_cube_map_array = &destroy_cube_map_array;
+	rd->base.generate_cube_map_array_mipmaps = &generate_cube_map_array_mipmaps;
+	rd->base.bind_cube_map_array = &bind_cube_map_array;
+	rd->base.update_cube_map_array = &update_cube_map_array;
+
+	// Constant buffer functions
+	rd->base.create_constant_buffer = &create_constant_buffer;
+	rd->base.destroy_constant_buffer = &destroy_constant_buffer;
+	rd->base.bind_constant_buffer = &bind_constant_buffer;
+	rd->base.bind_constant_buffer_range = &bind_constant_buffer_range;
+	rd->base.map_constant_buffer = &map_constant_buffer;
+	rd->base.unmap_constant_buffer = &unmap_constant_buffer;
+	rd->base.map_constant_buffer_range = &map_constant_buffer_range;
+	rd->base.flush_constant_buffer_range = &flush_constant_buffer_range;
+	rd->base.update_constant_buffer = &update_constant_buffer;
+	rd->base.query_constant_buffer_structure = &query_constant_buffer_structure;
+
+	// Index buffer functions
+	rd->base.create_index_buffer = &create_index_buffer;
+	rd->base.destroy_index_buffer = &destroy_index_buffer;
+	rd->base.set_index_buffer = &set_index_buffer;
+	rd->base.map_index_buffer = &map_index_buffer;
+	rd->base.unmap_index_buffer = &unmap_index_buffer;
+	rd->base.map_index_buffer_range = &map_index_buffer_range;
+	rd->base.flush_index_buffer_range = &flush_index_buffer_range;
+	rd->base.update_index_buffer = &update_index_buffer;
+
+	// Indirect buffer functions
+	rd->base.create_indirect_buffer = &create_indirect_buffer;
+	rd->base.destroy_indirect_buffer = &destroy_indirect_buffer;
+	rd->base.update_indirect_buffer = &update_indirect_buffer;
+
+	// Vertex buffer functions
+	rd->base.create_vertex_buffer = &create_vertex_buffer;
+	rd->base.destroy_vertex_buffer = &destroy_vertex_buffer;
+	rd->base.map_vertex_buffer = &map_vertex_buffer;
+	rd->base.unmap_vertex_buffer = &unmap_vertex_buffer;
+	rd->base.map_vertex_buffer_range = &map_vertex_buffer_range;
+	rd->base.flush_vertex_buffer_range = &flush_vertex_buffer_range;
+	rd->base.update_vertex_buffer = &update_vertex_buffer;
+
+	// Vertex array functions
+	rd->base.create_vertex_array = &create_vertex_array;
+	rd->base.destroy_vertex_array = &destroy_vertex_array;
+	rd->base.set_vertex_array = &set_vertex_array;
+
+	// Stream allocator functions
+	rd->base.create_stream_allocator = &create_stream_allocator;
+	rd->base.destroy_stream_allocator = &destroy_stream_allocator;
+	rd->base.map_stream_allocation = &map_stream_allocation;
+	rd->base.unmap_stream_allocation = &unmap_stream_allocation;
+	rd->base.end_stream_allocator_frame = &end_stream_allocator_frame;
+
+	// Upload queue functions
+	rd->base.create_upload_queue = &create_upload_queue;
+	rd->base.destroy_upload_queue = &destroy_upload_queue;
+	rd->base.upload_texture_1d = &upload_texture_1d;
+	rd->base.upload_texture_2d = &upload_texture_2d;
+	rd->base.upload_texture_3d = &upload_texture_3d;
+	rd->base.upload_cube_map = &upload_cube_map;
+	rd->base.is_upload_complete = &is_upload_complete;
+	rd->base.wait_upload = &wait_upload;
+
+	// Shader functions
+	rd->base.create_shader_stage = &create_shader_stage;
+	rd->base.destroy_shader_stage = &destroy_shader_stage;
+	rd->base.create_shader_pipeline = &create_shader_pipeline;
+	rd->base.destroy_shader_pipeline = &destroy_shader_pipeline;
+	rd->base.set_shader_pipeline = &set_shader_pipeline;
+	rd->base.get_shader_binding_point = &get_shader_binding_point;
+	rd->base.get_shader_binding_point_by_id = &get_shader_binding_point_by_id;
+
+	// Draw functions
+	rd->base.clear_color = &clear_color;
+	rd->base.clear_depth = &clear_depth;
+	rd->base.clear_stencil = &clear_stencil;
+	rd->base.swap_buffers = &swap_buffers;
+	rd->base.draw_triangles = &draw_triangles;
+	rd->base.draw_triangles_indexed = &draw_triangles_indexed;
+	rd->base.draw_triangles_instanced = &draw_triangles_instanced;
+	rd->base.draw_triangles_indexed_instanced = &draw_triangles_indexed_instanced;
+	rd->base.draw_triangles_indexed_base_vertex = &draw_triangles_indexed_base_vertex;
+	rd->base.draw_triangles_indexed_instanced_base_vertex = &draw_triangles_indexed_instanced_base_vertex;
+	rd->base.multi_draw_triangles = &multi_draw_triangles;
+	rd->base.multi_draw_triangles_indexed = &multi_draw_triangles_indexed;
+	rd->base.draw_triangles_indirect = &draw_triangles_indirect;
+	rd->base.draw_triangles_indexed_indirect = &draw_triangles_indexed_indirect;
+	rd->base.set_viewport = &set_viewport;
+
+	// Getter functions
+	rd->base.get_type_name = &get_type_name;
+	rd->base.get_property_i = &get_property_i;
+	rd->base.get_property_f = &get_property_f;
+	rd->base.get_object_pool_stats = &get_object_pool_stats;
+}
+
+static void extract_hints(mrl_capture_render_device_t* rd, const mrl_render_device_desc_t* desc)
+{
+	for (const mrl_hint_t* hint = desc->hints; hint != NULL; hint = hint->next)
+	{
+		// Check if the hint should be skipped
+		if (hint->device_type != NULL && !mgl_str_equal(hint->device_type, u8"capture"))
+			continue;
+
+		// Extract hint info
+		switch (hint->type)
+		{
+			case MRL_HINT_RENDER_DEVICE_WARNING_CALLBACK:
+				MGL_DEBUG_ASSERT(hint->data != NULL);
+				rd->warning_callback = *(const mrl_render_device_hint_warning_callback_t*)hint->data;
+				break;
+
+			case MRL_HINT_RENDER_DEVICE_ERROR_CALLBACK:
+				MGL_DEBUG_ASSERT(hint->data != NULL);
+				rd->error_callback = *(const mrl_render_device_hint_error_callback_t*)hint->data;
+				break;
+
+			default:
+				// Unsupported hint type, ignore it
+				continue;
+		}
+	}
+}
+
+MRL_API mrl_error_t mrl_init_capture_render_device(const mrl_render_device_desc_t* desc, const mrl_capture_desc_t* capture, mrl_render_device_t** out_rd)
+{
+	MGL_DEBUG_ASSERT(desc != NULL && capture != NULL && out_rd != NULL);
+	MGL_DEBUG_ASSERT(desc->allocator != NULL);
+	MGL_DEBUG_ASSERT(capture->target != NULL && capture->write != NULL && capture->buffer_size > 0);
+
+	// Allocate render device
+	mrl_capture_render_device_t* rd;
+	mgl_error_t mglerr = mgl_allocate(desc->allocator, sizeof(mrl_capture_render_device_t), (void**)&rd);
+	if (mglerr != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(mglerr);
+
+	rd->allocator = desc->allocator;
+	rd->target = capture->target;
+	rd->next_id = 1;
+	rd->error_callback = NULL;
+	rd->warning_callback = NULL;
+	rd->output.write = capture->write;
+	rd->output.user_data = capture->user_data;
+	rd->output.size = 0;
+	rd->output.capacity = capture->buffer_size;
+	rd->output.failed = MGL_FALSE;
+
+	// Extract hints
+	extract_hints(rd, desc);
+
+	// Create allocators
+	mrl_error_t err = create_rd_allocators(rd, desc);
+	if (err != MRL_ERROR_NONE)
+	{
+		mgl_deallocate(rd->allocator, rd);
+		return err;
+	}
+
+	// Allocate output buffer
+	mglerr = mgl_allocate(rd->allocator, rd->output.capacity, (void**)&rd->output.data);
+	if (mglerr != MGL_ERROR_NONE)
+	{
+		destroy_rd_allocators(rd);
+		mgl_deallocate(rd->allocator, rd);
+		return mrl_make_mgl_error(mglerr);
+	}
+
+	// Write trace header
+	mgl_u8_t header[16] = { 0 };
+	mgl_mem_copy(header, MRL_TRACE_MAGIC, 4);
+	mgl_u32_t version = MRL_TRACE_VERSION;
+	mgl_mem_copy(header + 4, &version, sizeof(version));
+	write_bytes(rd, header, sizeof(header));
+
+	// Set render device funcs
+	set_rd_functions(rd);
+
+	*out_rd = (mrl_render_device_t*)rd;
+
+	return MRL_ERROR_NONE;
+}
+
+MRL_API void mrl_terminate_capture_render_device(mrl_render_device_t* brd)
+{
+	MGL_DEBUG_ASSERT(brd != NULL);
+	mrl_capture_render_device_t* rd = (mrl_capture_render_device_t*)brd;
+
+	// Write remaining trace data
+	flush_output(rd);
+	mgl_deallocate(rd->allocator, rd->output.data);
+
+	// Destroy allocators
+	destroy_rd_allocators(rd);
+
+	// Deallocate
+	MGL_DEBUG_ASSERT(mgl_deallocate(rd->allocator, rd) == MRL_ERROR_NONE);
+}
+
+MRL_API mrl_error_t mrl_flush_capture_render_device(mrl_render_device_t* brd)
+{
+	MGL_DEBUG_ASSERT(brd != NULL);
+	return flush_output((mrl_capture_render_device_t*)brd);
+}
+
+// ---------- Replay ----------
+
+typedef struct
+{
+	void* handle;
+	mgl_u8_t* mapped;
+
+	// Size of buffers and of their mapped range, used to bound the recorded writes
+	mgl_u64_t size;
+	mgl_u64_t mapped_size;
+
+	// Format of textures, used to check the size of recorded updates
+	mgl_enum_t format;
+
+	// Opcode of the command which created the object
+	mgl_u32_t type;
+} mrl_replay_object_t;
+
+typedef struct
+{
+	mrl_render_device_t* rd;
+	const mrl_replay_desc_t* desc;
+	mrl_replay_object_t* objects;
+	mgl_u64_t object_capacity;
+	mgl_u64_t frame;
+} mrl_replay_state_t;
+
+static mrl_replay_object_t* get_replay_object(mrl_replay_state_t* state, mgl_u64_t id)
+{
+	if (id == 0 || id >= state->object_capacity)
+		return NULL;
+	return &state->objects[id];
+}
+
+static void* get_replay_handle(mrl_replay_state_t* state, mgl_u64_t id)
+{
+	mrl_replay_object_t* obj = get_replay_object(state, id);
+	return obj == NULL ? NULL : obj->handle;
+}
+
+static mrl_error_t add_replay_object(mrl_replay_state_t* state, mgl_u64_t id, mgl_u32_t type, mrl_error_t create_err, void* handle)
+{
+	if (create_err != MRL_ERROR_NONE)
+	{
+		// Keep going, the commands which use the object are skipped
+		if (state->desc->warning_callback != NULL)
+			state->desc->warning_callback(create_err, u8"Failed to replay trace: the render device failed to create an object");
+		return MRL_ERROR_NONE;
+	}
+
+	if (id == 0)
+		return MRL_ERROR_INVALID_PARAMS;
+
+	// IDs are given out sequentially, so the table is grown as needed
+	if (id >= state->object_capacity)
+	{
+		mgl_u64_t capacity = state->object_capacity == 0 ? 256 : state->object_capacity * 2;
+		while (capacity <= id)
+			capacity *= 2;
+
+		mrl_replay_object_t* objects;
+		mgl_error_t err = mgl_allocate(state->desc->allocator, capacity * sizeof(mrl_replay_object_t), (void**)&objects);
+		if (err != MGL_ERROR_NONE)
+			return mrl_make_mgl_error(err);
+		mgl_mem_set(objects, capacity * sizeof(mrl_replay_object_t), 0);
+
+		if (state->objects != NULL)
+		{
+			mgl_mem_copy(objects, state->objects, state->object_capacity * sizeof(mrl_replay_object_t));
+			mgl_deallocate(state->desc->allocator, state->objects);
+		}
+
+		state->objects = objects;
+		state->object_capacity = capacity;
+	}
+
+	state->objects[id].handle = handle;
+	state->objects[id].mapped = NULL;
+	state->objects[id].size = 0;
+	state->objects[id].mapped_size = 0;
+	state->objects[id].type = type;
+
+	return MRL_ERROR_NONE;
+}
+
+static mrl_error_t add_replay_buffer(mrl_replay_state_t* state, mgl_u64_t id, mgl_u32_t type, mrl_error_t create_err, void* handle, mgl_u64_t size)
+{
+	mrl_error_t err = add_replay_object(state, id, type, create_err, handle);
+	if (err == MRL_ERROR_NONE && create_err == MRL_ERROR_NONE)
+		state->objects[id].size = size;
+	return err;
+}
+
+static mrl_error_t add_replay_texture(mrl_replay_state_t* state, mgl_u64_t id, mgl_u32_t type, mrl_error_t create_err, void* handle, mgl_enum_t format)
+{
+	mrl_error_t err = add_replay_object(state, id, type, create_err, handle);
+	if (err == MRL_ERROR_NONE && create_err == MRL_ERROR_NONE)
+		state->objects[id].format = format;
+	return err;
+}
+
+// Checks if an object used by a command exists on the render device, which isn't the case if its creation failed.
+// Optional objects may also be recorded as NULL, which is passed through.
+static mgl_bool_t check_replay_object(mrl_replay_state_t* state, mgl_u64_t id, mgl_bool_t optional)
+{
+	if ((id == 0 && optional) || get_replay_handle(state, id) != NULL)
+		return MGL_TRUE;
+
+	if (state->desc->warning_callback != NULL)
+		state->desc->warning_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to replay trace: skipped a command which uses an object that wasn't created");
+	return MGL_FALSE;
+}
+
+// Gets the size of the data of a recorded texture update, or the maximum size if the region is too large to be valid
+static mgl_u64_t get_replay_region_size(mrl_replay_state_t* state, mgl_u64_t id, mgl_u64_t width, mgl_u64_t height, mgl_u64_t depth)
+{
+	// Bounding each dimension keeps the size from overflowing
+	if (width > 0xFFFF || height > 0xFFFF || depth > 0xFFFF)
+		return ~(mgl_u64_t)0;
+	return get_region_data_size(get_replay_object(state, id)->format, width, height, depth);
+}
+
+static void destroy_replay_object(mrl_replay_state_t* state, mgl_u64_t id)
+{
+	mrl_replay_object_t* obj = get_replay_object(state, id);
+	if (obj == NULL || obj->handle == NULL)
+		return;
+
+	mrl_render_device_t* rd = state->rd;
+	switch (obj->type)
+	{
+		case MRL_CAPTURE_COMMAND_CREATE_FRAMEBUFFER: rd->destroy_framebuffer(rd, obj->handle); break;
+		case MRL_CAPTURE_COMMAND_CREATE_RASTER_STATE: rd->destroy_raster_state(rd, obj->handle); break;
+		case MRL_CAPTURE_COMMAND_CREATE_DEPTH_STENCIL_STATE: rd->destroy_depth_stencil_state(rd, obj->handle); break;
+		case MRL_CAPTURE_COMMAND_CREATE_BLEND_STATE: rd->destroy_blend_state(rd, obj->handle); break;
+		case MRL_CAPTURE_COMMAND_CREATE_SAMPLER: rd->destroy_sampler(rd, obj->handle); break;
+		case MRL_CAPTURE_COMMAND_CREATE_TEXTURE_1D: rd->destroy_texture_1d(rd, obj->handle); break;
+		case MRL_CAPTURE_COMMAND_CREATE_TEXTURE_2D: rd->destroy_texture_2d(rd, obj->handle); break;
+		case MRL_CAPTURE_COMMAND_CREATE_TEXTURE_3D: rd->destroy_texture_3d(rd, obj->handle); break;
+		case MRL_CAPTURE_COMMAND_CREATE_CUBE_MAP: rd->destroy_cube_map(rd, obj->handle); break;
+		case MRL_CAPTURE_COMMAND_CREATE_TEXTURE_2D_ARRAY: rd->destroy_texture_2d_array(rd, obj->handle); break;
+		case MRL_CAPTURE_COMMAND_CREATE_CUBE_MAP_ARRAY: rd->destroy_cube_map_array(rd, obj->handle); break;
+		case MRL_CAPTURE_COMMAND_CREATE_CONSTANT_BUFFER: rd->destroy_constant_buffer(rd, obj->handle); break;
+		case MRL_CAPTURE_COMMAND_CREATE_INDEX_BUFFER: rd->destroy_index_buffer(rd, obj->handle); break;
+		case MRL_CAPTURE_COMMAND_CREATE_INDIRECT_BUFFER: rd->destroy_indirect_buffer(rd, obj->handle); break;
+		case MRL_CAPTURE_COMMAND_CREATE_VERTEX_BUFFER: rd->destroy_vertex_buffer(rd, obj->handle); break;
+		case MRL_CAPTURE_COMMAND_CREATE_VERTEX_ARRAY: rd->destroy_vertex_array(rd, obj->handle); break;
+		case MRL_CAPTURE_COMMAND_CREATE_STREAM_ALLOCATOR: rd->destroy_stream_allocator(rd, obj->handle); break;
+		case MRL_CAPTURE_COMMAND_CREATE_SHADER_STAGE: rd->destroy_shader_stage(rd, obj->handle); break;
+		case MRL_CAPTURE_COMMAND_CREATE_SHADER_PIPELINE: rd->destroy_shader_pipeline(rd, obj->handle); break;
+		default: break; // Binding points are owned by their pipelines
+	}
+
+	obj->handle = NULL;
+	obj->mapped = NULL;
+}
+
+// Points the mip level data pointers of a texture description into the payload
+static mrl_error_t set_replay_texture_data(const void** data, mgl_u32_t face_count, mgl_u32_t mip_level_count, mgl_enum_t format, mgl_u64_t width, mgl_u64_t height, mgl_u64_t depth, mgl_u64_t layer_count, const mgl_u8_t* payload, mgl_u64_t payload_size)
+{
+	if (payload_size == 0)
+		return MRL_ERROR_NONE;
+	if (mip_level_count > MRL_MAX_MIP_LEVEL_COUNT)
+		return MRL_ERROR_INVALID_PARAMS;
+
+	mgl_u64_t offset = 0;
+	for (mgl_u32_t f = 0; f < face_count; ++f)
+		for (mgl_u32_t l = 0; l < mip_level_count; ++l)
+		{
+			mgl_u64_t size = get_level_data_size(format, width, height, depth, l) * layer_count;
+			if (offset + size > payload_size)
+				return MRL_ERROR_INVALID_PARAMS;
+			data[f * MRL_MAX_MIP_LEVEL_COUNT + l] = payload + offset;
+			offset += size;
+		}
+
+	return MRL_ERROR_NONE;
+}
+
+static void map_replay_buffer(mrl_replay_object_t* obj, void* mapped, mgl_u64_t size)
+{
+	obj->mapped = (mgl_u8_t*)mapped;
+	obj->mapped_size = size;
+}
+
+// The buffer is always unmapped, even if the recorded data doesn't fit the mapped range
+static mrl_error_t unmap_replay_buffer(mrl_replay_object_t* obj, const mgl_u8_t* payload, mgl_u64_t payload_size)
+{
+	mrl_error_t err = MRL_ERROR_NONE;
+	if (obj->mapped != NULL && payload_size > obj->mapped_size)
+		err = MRL_ERROR_INVALID_PARAMS;
+	else if (obj->mapped != NULL && payload_size > 0)
+		mgl_mem_copy(obj->mapped, payload, payload_size);
+	obj->mapped = NULL;
+	return err;
+}
+
+static mrl_error_t flush_replay_buffer(mrl_replay_object_t* obj, mgl_u64_t offset, const mgl_u8_t* payload, mgl_u64_t payload_size)
+{
+	if (obj->mapped != NULL && (offset > obj->mapped_size || payload_size > obj->mapped_size - offset))
+		return MRL_ERROR_INVALID_PARAMS;
+	if (obj->mapped != NULL && payload_size > 0)
+		mgl_mem_copy(obj->mapped + offset, payload, payload_size);
+	return MRL_ERROR_NONE;
+}
+
+#define MRL_REPLAY_REQUIRE_ARGS(count) do { if (arg_count < (count)) return MRL_ERROR_INVALID_PARAMS; } while (0)
+#define MRL_REPLAY_REQUIRE_PAYLOAD(size) do { if (payload_size < (size)) return MRL_ERROR_INVALID_PARAMS; } while (0)
+
+// Commands which use an object whose creation failed are skipped, instead of passing NULL to the render device
+#define MRL_REPLAY_REQUIRE_OBJECT(id) do { if (!check_replay_object(state, (id), MGL_FALSE)) return MRL_ERROR_NONE; } while (0)
+#define MRL_REPLAY_OPTIONAL_OBJECT(id) do { if (!check_replay_object(state, (id), MGL_TRUE)) return MRL_ERROR_NONE; } while (0)
+
+static mrl_error_t replay_command(mrl_replay_state_t* state, mgl_u32_t opcode, const mgl_u64_t* args, mgl_u32_t arg_count, const mgl_u8_t* payload, mgl_u64_t payload_size)
+{
+	mrl_render_device_t* rd = state->rd;
+	mrl_replay_object_t* obj;
+	void* handle = NULL;
+	mrl_error_t err;
+
+	switch (opcode)
+	{
+		// Framebuffers
+		case MRL_CAPTURE_COMMAND_CREATE_FRAMEBUFFER:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(3);
+			mrl_framebuffer_desc_t desc = MRL_DEFAULT_FRAMEBUFFER_DESC;
+			desc.target_count = (mgl_u32_t)args[1];
+			if (desc.target_count > MRL_MAX_FRAMEBUFFER_RENDER_TARGET_COUNT)
+				return MRL_ERROR_INVALID_PARAMS;
+			MRL_REPLAY_REQUIRE_ARGS(3 + 4 * desc.target_count);
+			desc.depth_stencil = get_replay_handle(state, args[2]);
+
+			// Framebuffers which use a texture whose creation failed fail too
+			mgl_bool_t found = check_replay_object(state, args[2], MGL_TRUE);
+			for (mgl_u32_t i = 0; i < desc.target_count; ++i)
+			{
+				const mgl_u64_t* target = &args[3 + 4 * i];
+				found = found && check_replay_object(state, target[2], MGL_FALSE);
+				desc.targets[i].type = (mgl_enum_t)target[0];
+				desc.targets[i].mip_level = (mgl_u32_t)target[1];
+				if (desc.targets[i].type == MRL_RENDER_TARGET_TYPE_TEXTURE_2D)
+					desc.targets[i].tex_2d.handle = get_replay_handle(state, target[2]);
+				else if (desc.targets[i].type == MRL_RENDER_TARGET_TYPE_TEXTURE_2D_ARRAY)
+				{
+					desc.targets[i].tex_2d_array.handle = get_replay_handle(state, target[2]);
+					desc.targets[i].tex_2d_array.layer = target[3];
+				}
+				else
+				{
+					desc.targets[i].cube_map.handle = get_replay_handle(state, target[2]);
+					desc.targets[i].cube_map.face = (mgl_enum_t)target[3];
+				}
+			}
+			if (arg_count >= 5 + 4 * desc.target_count)
+			{
+				desc.depth_stencil_array = get_replay_handle(state, args[3 + 4 * desc.target_count]);
+				desc.depth_stencil_layer = args[4 + 4 * desc.target_count];
+				found = found && check_replay_object(state, args[3 + 4 * desc.target_count], MGL_TRUE);
+			}
+			err = found ? rd->create_framebuffer(rd, &handle, &desc) : MRL_ERROR_INVALID_PARAMS;
+			return add_replay_object(state, args[0], opcode, err, handle);
+		}
+		case MRL_CAPTURE_COMMAND_DESTROY_FRAMEBUFFER:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			destroy_replay_object(state, args[0]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_SET_FRAMEBUFFER:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			MRL_REPLAY_OPTIONAL_OBJECT(args[0]);
+			rd->set_framebuffer(rd, get_replay_handle(state, args[0]));
+			return MRL_ERROR_NONE;
+
+		// Raster states
+		case MRL_CAPTURE_COMMAND_CREATE_RASTER_STATE:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(5);
+			mrl_raster_state_desc_t desc = MRL_DEFAULT_RASTER_STATE_DESC;
+			desc.cull_enabled = (mgl_bool_t)args[1];
+			desc.front_face = (mgl_enum_t)args[2];
+			desc.cull_face = (mgl_enum_t)args[3];
+			desc.raster_mode = (mgl_enum_t)args[4];
+			err = rd->create_raster_state(rd, &handle, &desc);
+			return add_replay_object(state, args[0], opcode, err, handle);
+		}
+		case MRL_CAPTURE_COMMAND_DESTROY_RASTER_STATE:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			destroy_replay_object(state, args[0]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_SET_RASTER_STATE:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			MRL_REPLAY_OPTIONAL_OBJECT(args[0]);
+			rd->set_raster_state(rd, get_replay_handle(state, args[0]));
+			return MRL_ERROR_NONE;
+
+		// Depth stencil states
+		case MRL_CAPTURE_COMMAND_CREATE_DEPTH_STENCIL_STATE:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(18);
+			mrl_depth_stencil_state_desc_t desc = MRL_DEFAULT_DEPTH_STENCIL_STATE_DESC;
+			mgl_u32_t bits;
+			desc.depth.enabled = (mgl_bool_t)args[1];
+			desc.depth.write_enabled = (mgl_bool_t)args[2];
+			bits = (mgl_u32_t)args[3];
+			mgl_mem_copy(&desc.depth.near, &bits, sizeof(bits));
+			bits = (mgl_u32_t)args[4];
+			mgl_mem_copy(&desc.depth.far, &bits, sizeof(bits));
+			desc.depth.compare = (mgl_enum_t)args[5];
+			desc.stencil.ref = (mgl_u32_t)args[6];
+			desc.stencil.enabled = (mgl_bool_t)args[7];
+			desc.stencil.read_mask = (mgl_u32_t)args[8];
+			desc.stencil.write_mask = (mgl_u32_t)args[9];
+			desc.stencil.front_face.compare = (mgl_enum_t)args[10];
+			desc.stencil.front_face.fail = (mgl_enum_t)args[11];
+			desc.stencil.front_face.pass = (mgl_enum_t)args[12];
+			desc.stencil.front_face.depth_fail = (mgl_enum_t)args[13];
+			desc.stencil.back_face.compare = (mgl_enum_t)args[14];
+			desc.stencil.back_face.fail = (mgl_enum_t)args[15];
+			desc.stencil.back_face.pass = (mgl_enum_t)args[16];
+			desc.stencil.back_face.depth_fail = (mgl_enum_t)args[17];
+			err = rd->create_depth_stencil_state(rd, &handle, &desc);
+			return add_replay_object(state, args[0], opcode, err, handle);
+		}
+		case MRL_CAPTURE_COMMAND_DESTROY_DEPTH_STENCIL_STATE:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			destroy_replay_object(state, args[0]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_SET_DEPTH_STENCIL_STATE:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			MRL_REPLAY_OPTIONAL_OBJECT(args[0]);
+			rd->set_depth_stencil_state(rd, get_replay_handle(state, args[0]));
+			return MRL_ERROR_NONE;
+
+		// Blend states
+		case MRL_CAPTURE_COMMAND_CREATE_BLEND_STATE:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(8);
+			mrl_blend_state_desc_t desc = MRL_DEFAULT_BLEND_STATE_DESC;
+			desc.blend_enabled = (mgl_bool_t)args[1];
+			desc.color.src = (mgl_enum_t)args[2];
+			desc.color.dst = (mgl_enum_t)args[3];
+			desc.color.op = (mgl_enum_t)args[4];
+			desc.alpha.src = (mgl_enum_t)args[5];
+			desc.alpha.dst = (mgl_enum_t)args[6];
+			desc.alpha.op = (mgl_enum_t)args[7];
+			err = rd->create_blend_state(rd, &handle, &desc);
+			return add_replay_object(state, args[0], opcode, err, handle);
+		}
+		case MRL_CAPTURE_COMMAND_DESTROY_BLEND_STATE:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			destroy_replay_object(state, args[0]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_SET_BLEND_STATE:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			MRL_REPLAY_OPTIONAL_OBJECT(args[0]);
+			rd->set_blend_state(rd, get_replay_handle(state, args[0]));
+			return MRL_ERROR_NONE;
+
+		// Samplers
+		case MRL_CAPTURE_COMMAND_CREATE_SAMPLER:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(12);
+			mrl_sampler_desc_t desc = MRL_DEFAULT_SAMPLER_DESC;
+			for (mgl_u32_t i = 0; i < 4; ++i)
+			{
+				mgl_u32_t bits = (mgl_u32_t)args[1 + i];
+				mgl_mem_copy(&desc.border_color[i], &bits, sizeof(bits));
+			}
+			desc.min_filter = (mgl_enum_t)args[5];
+			desc.mag_filter = (mgl_enum_t)args[6];
+			desc.mip_filter = (mgl_enum_t)args[7];
+			desc.address_u = (mgl_enum_t)args[8];
+			desc.address_v = (mgl_enum_t)args[9];
+			desc.address_w = (mgl_enum_t)args[10];
+			desc.max_anisotropy = (mgl_u32_t)args[11];
+			err = rd->create_sampler(rd, &handle, &desc);
+			return add_replay_object(state, args[0], opcode, err, handle);
+		}
+		case MRL_CAPTURE_COMMAND_DESTROY_SAMPLER:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			destroy_replay_object(state, args[0]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_BIND_SAMPLER:
+			MRL_REPLAY_REQUIRE_ARGS(2);
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			MRL_REPLAY_OPTIONAL_OBJECT(args[1]);
+			rd->bind_sampler(rd, get_replay_handle(state, args[0]), get_replay_handle(state, args[1]));
+			return MRL_ERROR_NONE;
+
+		// 1D textures
+		case MRL_CAPTURE_COMMAND_CREATE_TEXTURE_1D:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(5);
+			mrl_texture_1d_desc_t desc = MRL_DEFAULT_TEXTURE_1D_DESC;
+			desc.mip_level_count = (mgl_u32_t)args[1];
+			desc.width = args[2];
+			desc.usage = (mgl_enum_t)args[3];
+			desc.format = (mgl_enum_t)args[4];
+			err = set_replay_texture_data(desc.data, 1, desc.mip_level_count, desc.format, desc.width, 1, 1, 1, payload, payload_size);
+			if (err != MRL_ERROR_NONE)
+				return err;
+			err = rd->create_texture_1d(rd, &handle, &desc);
+			return add_replay_texture(state, args[0], opcode, err, handle, desc.format);
+		}
+		case MRL_CAPTURE_COMMAND_DESTROY_TEXTURE_1D:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			destroy_replay_object(state, args[0]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_GENERATE_TEXTURE_1D_MIPMAPS:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			rd->generate_texture_1d_mipmaps(rd, get_replay_handle(state, args[0]));
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_BIND_TEXTURE_1D:
+			MRL_REPLAY_REQUIRE_ARGS(2);
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			MRL_REPLAY_OPTIONAL_OBJECT(args[1]);
+			rd->bind_texture_1d(rd, get_replay_handle(state, args[0]), get_replay_handle(state, args[1]));
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_UPDATE_TEXTURE_1D:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(4);
+			mrl_texture_1d_update_desc_t desc = MRL_DEFAULT_TEXTURE_1D_UPDATE_DESC;
+			desc.data = payload;
+			desc.width = args[1];
+			desc.dst_x = args[2];
+			desc.mip_level = (mgl_u32_t)args[3];
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			MRL_REPLAY_REQUIRE_PAYLOAD(get_replay_region_size(state, args[0], desc.width, 1, 1));
+			rd->update_texture_1d(rd, get_replay_handle(state, args[0]), &desc);
+			return MRL_ERROR_NONE;
+		}
+
+		// 2D textures
+		case MRL_CAPTURE_COMMAND_CREATE_TEXTURE_2D:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(6);
+			mrl_texture_2d_desc_t desc = MRL_DEFAULT_TEXTURE_2D_DESC;
+			desc.mip_level_count = (mgl_u32_t)args[1];
+			desc.width = args[2];
+			desc.height = args[3];
+			desc.usage = (mgl_enum_t)args[4];
+			desc.format = (mgl_enum_t)args[5];
+			err = set_replay_texture_data(desc.data, 1, desc.mip_level_count, desc.format, desc.width, desc.height, 1, 1, payload, payload_size);
+			if (err != MRL_ERROR_NONE)
+				return err;
+			err = rd->create_texture_2d(rd, &handle, &desc);
+			return add_replay_texture(state, args[0], opcode, err, handle, desc.format);
+		}
+		case MRL_CAPTURE_COMMAND_DESTROY_TEXTURE_2D:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			destroy_replay_object(state, args[0]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_GENERATE_TEXTURE_2D_MIPMAPS:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			rd->generate_texture_2d_mipmaps(rd, get_replay_handle(state, args[0]));
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_BIND_TEXTURE_2D:
+			MRL_REPLAY_REQUIRE_ARGS(2);
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			MRL_REPLAY_OPTIONAL_OBJECT(args[1]);
+			rd->bind_texture_2d(rd, get_replay_handle(state, args[0]), get_replay_handle(state, args[1]));
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_UPDATE_TEXTURE_2D:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(6);
+			mrl_texture_2d_update_desc_t desc = MRL_DEFAULT_TEXTURE_2D_UPDATE_DESC;
+			desc.data = payload;
+			desc.width = args[1];
+			desc.height = args[2];
+			desc.dst_x = args[3];
+			desc.dst_y = args[4];
+			desc.mip_level = (mgl_u32_t)args[5];
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			MRL_REPLAY_REQUIRE_PAYLOAD(get_replay_region_size(state, args[0], desc.width, desc.height, 1));
+			rd->update_texture_2d(rd, get_replay_handle(state, args[0]), &desc);
+			return MRL_ERROR_NONE;
+		}
+
+		// 3D textures
+		case MRL_CAPTURE_COMMAND_CREATE_TEXTURE_3D:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(7);
+			mrl_texture_3d_desc_t desc = MRL_DEFAULT_TEXTURE_3D_DESC;
+			desc.mip_level_count = (mgl_u32_t)args[1];
+			desc.width = args[2];
+			desc.height = args[3];
+			desc.depth = args[4];
+			desc.usage = (mgl_enum_t)args[5];
+			desc.format = (mgl_enum_t)args[6];
+			err = set_replay_texture_data(desc.data, 1, desc.mip_level_count, desc.format, desc.width, desc.height, desc.depth, 1, payload, payload_size);
+			if (err != MRL_ERROR_NONE)
+				return err;
+			err = rd->create_texture_3d(rd, &handle, &desc);
+			return add_replay_texture(state, args[0], opcode, err, handle, desc.format);
+		}
+		case MRL_CAPTURE_COMMAND_DESTROY_TEXTURE_3D:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			destroy_replay_object(state, args[0]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_GENERATE_TEXTURE_3D_MIPMAPS:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			rd->generate_texture_3d_mipmaps(rd, get_replay_handle(state, args[0]));
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_BIND_TEXTURE_3D:
+			MRL_REPLAY_REQUIRE_ARGS(2);
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			MRL_REPLAY_OPTIONAL_OBJECT(args[1]);
+			rd->bind_texture_3d(rd, get_replay_handle(state, args[0]), get_replay_handle(state, args[1]));
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_UPDATE_TEXTURE_3D:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(8);
+			mrl_texture_3d_update_desc_t desc = MRL_DEFAULT_TEXTURE_3D_UPDATE_DESC;
+			desc.data = payload;
+			desc.width = args[1];
+			desc.height = args[2];
+			desc.depth = args[3];
+			desc.dst_x = args[4];
+			desc.dst_y = args[5];
+			desc.dst_z = args[6];
+			desc.mip_level = (mgl_u32_t)args[7];
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			MRL_REPLAY_REQUIRE_PAYLOAD(get_replay_region_size(state, args[0], desc.width, desc.height, desc.depth));
+			rd->update_texture_3d(rd, get_replay_handle(state, args[0]), &desc);
+			return MRL_ERROR_NONE;
+		}
+
+		// Cube maps
+		case MRL_CAPTURE_COMMAND_CREATE_CUBE_MAP:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(6);
+			mrl_cube_map_desc_t desc = MRL_DEFAULT_CUBE_MAP_DESC;
+			desc.mip_level_count = (mgl_u32_t)args[1];
+			desc.width = args[2];
+			desc.height = args[3];
+			desc.usage = (mgl_enum_t)args[4];
+			desc.format = (mgl_enum_t)args[5];
+			err = set_replay_texture_data(&desc.data[0][0], 6, desc.mip_level_count, desc.format, desc.width, desc.height, 1, 1, payload, payload_size);
+			if (err != MRL_ERROR_NONE)
+				return err;
+			err = rd->create_cube_map(rd, &handle, &desc);
+			return add_replay_texture(state, args[0], opcode, err, handle, desc.format);
+		}
+		case MRL_CAPTURE_COMMAND_DESTROY_CUBE_MAP:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			destroy_replay_object(state, args[0]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_GENERATE_CUBE_MAP_MIPMAPS:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			rd->generate_cube_map_mipmaps(rd, get_replay_handle(state, args[0]));
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_BIND_CUBE_MAP:
+			MRL_REPLAY_REQUIRE_ARGS(2);
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			MRL_REPLAY_OPTIONAL_OBJECT(args[1]);
+			rd->bind_cube_map(rd, get_replay_handle(state, args[0]), get_replay_handle(state, args[1]));
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_UPDATE_CUBE_MAP:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(7);
+			mrl_cube_map_update_desc_t desc = MRL_DEFAULT_CUBE_MAP_UPDATE_DESC;
+			desc.data = payload;
+			desc.face = (mgl_enum_t)args[1];
+			desc.width = args[2];
+			desc.height = args[3];
+			desc.dst_x = args[4];
+			desc.dst_y = args[5];
+			desc.mip_level = (mgl_u32_t)args[6];
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			MRL_REPLAY_REQUIRE_PAYLOAD(get_replay_region_size(state, args[0], desc.width, desc.height, 1));
+			rd->update_cube_map(rd, get_replay_handle(state, args[0]), &desc);
+			return MRL_ERROR_NONE;
+		}
+
+		// 2D texture arrays
+		case MRL_CAPTURE_COMMAND_CREATE_TEXTURE_2D_ARRAY:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(7);
+			mrl_texture_2d_array_desc_t desc = MRL_DEFAULT_TEXTURE_2D_ARRAY_DESC;
+			desc.mip_level_count = (mgl_u32_t)args[1];
+			desc.width = args[2];
+			desc.height = args[3];
+			desc.layer_count = args[4];
+			desc.usage = (mgl_enum_t)args[5];
+			desc.format = (mgl_enum_t)args[6];
+			err = set_replay_texture_data(desc.data, 1, desc.mip_level_count, desc.format, desc.width, desc.height, 1, desc.layer_count, payload, payload_size);
+			if (err != MRL_ERROR_NONE)
+				return err;
+			err = rd->create_texture_2d_array(rd, &handle, &desc);
+			return add_replay_texture(state, args[0], opcode, err, handle, desc.format);
+		}
+		case MRL_CAPTURE_COMMAND_DESTROY_TEXTURE_2D_ARRAY:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			destroy_replay_object(state, args[0]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_GENERATE_TEXTURE_2D_ARRAY_MIPMAPS:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			rd->generate_texture_2d_array_mipmaps(rd, get_replay_handle(state, args[0]));
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_BIND_TEXTURE_2D_ARRAY:
+			MRL_REPLAY_REQUIRE_ARGS(2);
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			MRL_REPLAY_OPTIONAL_OBJECT(args[1]);
+			rd->bind_texture_2d_array(rd, get_replay_handle(state, args[0]), get_replay_handle(state, args[1]));
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_UPDATE_TEXTURE_2D_ARRAY:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(8);
+			mrl_texture_2d_array_update_desc_t desc = MRL_DEFAULT_TEXTURE_2D_ARRAY_UPDATE_DESC;
+			desc.data = payload;
+			desc.width = args[1];
+			desc.height = args[2];
+			desc.layer_count = args[3];
+			desc.dst_x = args[4];
+			desc.dst_y = args[5];
+			desc.dst_layer = args[6];
+			desc.mip_level = (mgl_u32_t)args[7];
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			MRL_REPLAY_REQUIRE_PAYLOAD(get_replay_region_size(state, args[0], desc.width, desc.height, desc.layer_count));
+			rd->update_texture_2d_array(rd, get_replay_handle(state, args[0]), &desc);
+			return MRL_ERROR_NONE;
+		}
+
+		// Cube map arrays
+		case MRL_CAPTURE_COMMAND_CREATE_CUBE_MAP_ARRAY:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(7);
+			mrl_cube_map_array_desc_t desc = MRL_DEFAULT_CUBE_MAP_ARRAY_DESC;
+			desc.mip_level_count = (mgl_u32_t)args[1];
+			desc.width = args[2];
+			desc.height = args[3];
+			desc.layer_count = args[4];
+			desc.usage = (mgl_enum_t)args[5];
+			desc.format = (mgl_enum_t)args[6];
+			err = set_replay_texture_data(desc.data, 1, desc.mip_level_count, desc.format, desc.width, desc.height, 1, desc.layer_count * 6, payload, payload_size);
+			if (err != MRL_ERROR_NONE)
+				return err;
+			err = rd->create_cube_map_array(rd, &handle, &desc);
+			return add_replay_texture(state, args[0], opcode, err, handle, desc.format);
+		}
+		case MRL_CAPTURE_COMMAND_DESTROY_CUBE_MAP_ARRAY:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			destroy_replay_object(state, args[0]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_GENERATE_CUBE_MAP_ARRAY_MIPMAPS:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			rd->generate_cube_map_array_mipmaps(rd, get_replay_handle(state, args[0]));
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_BIND_CUBE_MAP_ARRAY:
+			MRL_REPLAY_REQUIRE_ARGS(2);
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			MRL_REPLAY_OPTIONAL_OBJECT(args[1]);
+			rd->bind_cube_map_array(rd, get_replay_handle(state, args[0]), get_replay_handle(state, args[1]));
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_UPDATE_CUBE_MAP_ARRAY:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(8);
+			mrl_cube_map_array_update_desc_t desc = MRL_DEFAULT_CUBE_MAP_ARRAY_UPDATE_DESC;
+			desc.data = payload;
+			desc.width = args[1];
+			desc.height = args[2];
+			desc.face_count = args[3];
+			desc.dst_x = args[4];
+			desc.dst_y = args[5];
+			desc.dst_face = args[6];
+			desc.mip_level = (mgl_u32_t)args[7];
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			MRL_REPLAY_REQUIRE_PAYLOAD(get_replay_region_size(state, args[0], desc.width, desc.height, desc.face_count));
+			rd->update_cube_map_array(rd, get_replay_handle(state, args[0]), &desc);
+			return MRL_ERROR_NONE;
+		}
+
+		// Constant buffers
+		case MRL_CAPTURE_COMMAND_CREATE_CONSTANT_BUFFER:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(4);
+			mrl_constant_buffer_desc_t desc = MRL_DEFAULT_CONSTANT_BUFFER_DESC;
+			desc.size = args[1];
+			desc.usage = (mgl_enum_t)args[2];
+			if (args[3])
+				MRL_REPLAY_REQUIRE_PAYLOAD(desc.size);
+			desc.data = args[3] ? payload : NULL;
+			err = rd->create_constant_buffer(rd, &handle, &desc);
+			return add_replay_buffer(state, args[0], opcode, err, handle, desc.size);
+		}
+		case MRL_CAPTURE_COMMAND_DESTROY_CONSTANT_BUFFER:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			destroy_replay_object(state, args[0]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_BIND_CONSTANT_BUFFER:
+			MRL_REPLAY_REQUIRE_ARGS(2);
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			MRL_REPLAY_OPTIONAL_OBJECT(args[1]);
+			rd->bind_constant_buffer(rd, get_replay_handle(state, args[0]), get_replay_handle(state, args[1]));
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_BIND_CONSTANT_BUFFER_RANGE:
+			MRL_REPLAY_REQUIRE_ARGS(4);
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			MRL_REPLAY_REQUIRE_OBJECT(args[1]);
+			rd->bind_constant_buffer_range(rd, get_replay_handle(state, args[0]), get_replay_handle(state, args[1]), args[2], args[3]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_MAP_CONSTANT_BUFFER:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			if ((obj = get_replay_object(state, args[0])) != NULL && obj->handle != NULL)
+				map_replay_buffer(obj, rd->map_constant_buffer(rd, obj->handle), obj->size);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_UNMAP_CONSTANT_BUFFER:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			if ((obj = get_replay_object(state, args[0])) != NULL && obj->handle != NULL)
+			{
+				err = unmap_replay_buffer(obj, payload, payload_size);
+				rd->unmap_constant_buffer(rd, obj->handle);
+				return err;
+			}
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_MAP_CONSTANT_BUFFER_RANGE:
+			MRL_REPLAY_REQUIRE_ARGS(4);
+			if ((obj = get_replay_object(state, args[0])) != NULL && obj->handle != NULL)
+				map_replay_buffer(obj, rd->map_constant_buffer_range(rd, obj->handle, args[1], args[2], (mgl_u32_t)args[3]), args[2]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_FLUSH_CONSTANT_BUFFER_RANGE:
+			MRL_REPLAY_REQUIRE_ARGS(3);
+			if ((obj = get_replay_object(state, args[0])) != NULL && obj->handle != NULL)
+			{
+				if ((err = flush_replay_buffer(obj, args[1], payload, payload_size)) != MRL_ERROR_NONE)
+					return err;
+				rd->flush_constant_buffer_range(rd, obj->handle, args[1], args[2]);
+			}
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_UPDATE_CONSTANT_BUFFER:
+			MRL_REPLAY_REQUIRE_ARGS(3);
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			MRL_REPLAY_REQUIRE_PAYLOAD(args[2]);
+			rd->update_constant_buffer(rd, get_replay_handle(state, args[0]), args[1], args[2], payload);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_QUERY_CONSTANT_BUFFER_STRUCTURE:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			mrl_constant_buffer_structure_t cbs;
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			rd->query_constant_buffer_structure(rd, get_replay_handle(state, args[0]), &cbs);
+			return MRL_ERROR_NONE;
+		}
+
+		// Index buffers
+		case MRL_CAPTURE_COMMAND_CREATE_INDEX_BUFFER:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(5);
+			mrl_index_buffer_desc_t desc = MRL_DEFAULT_INDEX_BUFFER_DESC;
+			desc.size = args[1];
+			desc.usage = (mgl_enum_t)args[2];
+			desc.format = (mgl_enum_t)args[3];
+			if (args[4])
+				MRL_REPLAY_REQUIRE_PAYLOAD(desc.size);
+			desc.data = args[4] ? payload : NULL;
+			err = rd->create_index_buffer(rd, &handle, &desc);
+			return add_replay_buffer(state, args[0], opcode, err, handle, desc.size);
+		}
+		case MRL_CAPTURE_COMMAND_DESTROY_INDEX_BUFFER:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			destroy_replay_object(state, args[0]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_SET_INDEX_BUFFER:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			MRL_REPLAY_OPTIONAL_OBJECT(args[0]);
+			rd->set_index_buffer(rd, get_replay_handle(state, args[0]));
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_MAP_INDEX_BUFFER:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			if ((obj = get_replay_object(state, args[0])) != NULL && obj->handle != NULL)
+				map_replay_buffer(obj, rd->map_index_buffer(rd, obj->handle), obj->size);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_UNMAP_INDEX_BUFFER:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			if ((obj = get_replay_object(state, args[0])) != NULL && obj->handle != NULL)
+			{
+				err = unmap_replay_buffer(obj, payload, payload_size);
+				rd->unmap_index_buffer(rd, obj->handle);
+				return err;
+			}
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_MAP_INDEX_BUFFER_RANGE:
+			MRL_REPLAY_REQUIRE_ARGS(4);
+			if ((obj = get_replay_object(state, args[0])) != NULL && obj->handle != NULL)
+				map_replay_buffer(obj, rd->map_index_buffer_range(rd, obj->handle, args[1], args[2], (mgl_u32_t)args[3]), args[2]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_FLUSH_INDEX_BUFFER_RANGE:
+			MRL_REPLAY_REQUIRE_ARGS(3);
+			if ((obj = get_replay_object(state, args[0])) != NULL && obj->handle != NULL)
+			{
+				if ((err = flush_replay_buffer(obj, args[1], payload, payload_size)) != MRL_ERROR_NONE)
+					return err;
+				rd->flush_index_buffer_range(rd, obj->handle, args[1], args[2]);
+			}
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_UPDATE_INDEX_BUFFER:
+			MRL_REPLAY_REQUIRE_ARGS(3);
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			MRL_REPLAY_REQUIRE_PAYLOAD(args[2]);
+			rd->update_index_buffer(rd, get_replay_handle(state, args[0]), args[1], args[2], payload);
+			return MRL_ERROR_NONE;
+
+		// Indirect buffers
+		case MRL_CAPTURE_COMMAND_CREATE_INDIRECT_BUFFER:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(4);
+			mrl_indirect_buffer_desc_t desc = MRL_DEFAULT_INDIRECT_BUFFER_DESC;
+			desc.size = args[1];
+			desc.usage = (mgl_enum_t)args[2];
+			if (args[3])
+				MRL_REPLAY_REQUIRE_PAYLOAD(desc.size);
+			desc.data = args[3] ? payload : NULL;
+			err = rd->create_indirect_buffer(rd, &handle, &desc);
+			return add_replay_buffer(state, args[0], opcode, err, handle, desc.size);
+		}
+		case MRL_CAPTURE_COMMAND_DESTROY_INDIRECT_BUFFER:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			destroy_replay_object(state, args[0]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_UPDATE_INDIRECT_BUFFER:
+			MRL_REPLAY_REQUIRE_ARGS(3);
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			MRL_REPLAY_REQUIRE_PAYLOAD(args[2]);
+			rd->update_indirect_buffer(rd, get_replay_handle(state, args[0]), args[1], args[2], payload);
+			return MRL_ERROR_NONE;
+
+		// Vertex buffers
+		case MRL_CAPTURE_COMMAND_CREATE_VERTEX_BUFFER:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(4);
+			mrl_vertex_buffer_desc_t desc = MRL_DEFAULT_VERTEX_BUFFER_DESC;
+			desc.size = args[1];
+			desc.usage = (mgl_enum_t)args[2];
+			if (args[3])
+				MRL_REPLAY_REQUIRE_PAYLOAD(desc.size);
+			desc.data = args[3] ? payload : NULL;
+			err = rd->create_vertex_buffer(rd, &handle, &desc);
+			return add_replay_buffer(state, args[0], opcode, err, handle, desc.size);
+		}
+		case MRL_CAPTURE_COMMAND_DESTROY_VERTEX_BUFFER:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			destroy_replay_object(state, args[0]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_MAP_VERTEX_BUFFER:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			if ((obj = get_replay_object(state, args[0])) != NULL && obj->handle != NULL)
+				map_replay_buffer(obj, rd->map_vertex_buffer(rd, obj->handle), obj->size);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_UNMAP_VERTEX_BUFFER:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			if ((obj = get_replay_object(state, args[0])) != NULL && obj->handle != NULL)
+			{
+				err = unmap_replay_buffer(obj, payload, payload_size);
+				rd->unmap_vertex_buffer(rd, obj->handle);
+				return err;
+			}
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_MAP_VERTEX_BUFFER_RANGE:
+			MRL_REPLAY_REQUIRE_ARGS(4);
+			if ((obj = get_replay_object(state, args[0])) != NULL && obj->handle != NULL)
+				map_replay_buffer(obj, rd->map_vertex_buffer_range(rd, obj->handle, args[1], args[2], (mgl_u32_t)args[3]), args[2]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_FLUSH_VERTEX_BUFFER_RANGE:
+			MRL_REPLAY_REQUIRE_ARGS(3);
+			if ((obj = get_replay_object(state, args[0])) != NULL && obj->handle != NULL)
+			{
+				if ((err = flush_replay_buffer(obj, args[1], payload, payload_size)) != MRL_ERROR_NONE)
+					return err;
+				rd->flush_vertex_buffer_range(rd, obj->handle, args[1], args[2]);
+			}
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_UPDATE_VERTEX_BUFFER:
+			MRL_REPLAY_REQUIRE_ARGS(3);
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			MRL_REPLAY_REQUIRE_PAYLOAD(args[2]);
+			rd->update_vertex_buffer(rd, get_replay_handle(state, args[0]), args[1], args[2], payload);
+			return MRL_ERROR_NONE;
+
+		// Vertex arrays
+		case MRL_CAPTURE_COMMAND_CREATE_VERTEX_ARRAY:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(4);
+			mrl_vertex_array_desc_t desc = MRL_DEFAULT_VERTEX_ARRAY_DESC;
+			desc.element_count = (mgl_u32_t)args[1];
+			desc.buffer_count = (mgl_u32_t)args[2];
+			desc.shader_pipeline = get_replay_handle(state, args[3]);
+			if (desc.element_count > MRL_MAX_VERTEX_ARRAY_ELEMENT_COUNT || desc.buffer_count > MRL_MAX_VERTEX_ARRAY_BUFFER_COUNT)
+				return MRL_ERROR_INVALID_PARAMS;
+			MRL_REPLAY_REQUIRE_ARGS(4 + desc.buffer_count + 5 * desc.element_count);
+			if (payload_size < (mgl_u64_t)desc.element_count * MRL_MAX_VERTEX_ELEMENT_NAME_SIZE)
+				return MRL_ERROR_INVALID_PARAMS;
+
+			// Vertex arrays which use a pipeline or buffer whose creation failed fail too
+			mgl_bool_t found = check_replay_object(state, args[3], MGL_TRUE);
+			for (mgl_u32_t i = 0; i < desc.buffer_count; ++i)
+			{
+				desc.buffers[i] = get_replay_handle(state, args[4 + i]);
+				found = found && check_replay_object(state, args[4 + i], MGL_TRUE);
+			}
+			for (mgl_u32_t i = 0; i < desc.element_count; ++i)
+			{
+				const mgl_u64_t* element = &args[4 + desc.buffer_count + 5 * i];
+				desc.elements[i] = MRL_DEFAULT_VERTEX_ELEMENT;
+				desc.elements[i].type = (mgl_enum_u32_t)element[0];
+				desc.elements[i].size = (mgl_u8_t)element[1];
+				desc.elements[i].buffer.stride = element[2];
+				desc.elements[i].buffer.offset = element[3];
+				desc.elements[i].buffer.index = (mgl_u32_t)element[4];
+				if (arg_count >= 4 + desc.buffer_count + 6 * desc.element_count)
+					desc.elements[i].instance_step_rate = (mgl_u32_t)args[4 + desc.buffer_count + 5 * desc.element_count + i];
+				mgl_mem_copy(desc.elements[i].name, payload + i * MRL_MAX_VERTEX_ELEMENT_NAME_SIZE, MRL_MAX_VERTEX_ELEMENT_NAME_SIZE);
+			}
+			err = found ? rd->create_vertex_array(rd, &handle, &desc) : MRL_ERROR_INVALID_PARAMS;
+			return add_replay_object(state, args[0], opcode, err, handle);
+		}
+		case MRL_CAPTURE_COMMAND_DESTROY_VERTEX_ARRAY:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			destroy_replay_object(state, args[0]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_SET_VERTEX_ARRAY:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			MRL_REPLAY_OPTIONAL_OBJECT(args[0]);
+			rd->set_vertex_array(rd, get_replay_handle(state, args[0]));
+			return MRL_ERROR_NONE;
+
+		// Stream allocators
+		case MRL_CAPTURE_COMMAND_CREATE_STREAM_ALLOCATOR:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(3);
+			mrl_stream_allocator_desc_t desc = MRL_DEFAULT_STREAM_ALLOCATOR_DESC;
+			desc.buffer_type = (mgl_enum_t)args[1];
+			desc.buffer = get_replay_handle(state, args[2]);
+			if (desc.buffer == NULL)
+				err = MRL_ERROR_INVALID_PARAMS;
+			else
+				err = rd->create_stream_allocator(rd, &handle, &desc);
+			return add_replay_object(state, args[0], opcode, err, handle);
+		}
+		case MRL_CAPTURE_COMMAND_DESTROY_STREAM_ALLOCATOR:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			destroy_replay_object(state, args[0]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_MAP_STREAM_ALLOCATION:
+			MRL_REPLAY_REQUIRE_ARGS(4);
+			if ((obj = get_replay_object(state, args[0])) != NULL && obj->handle != NULL)
+			{
+				mgl_u64_t offset;
+				map_replay_buffer(obj, rd->map_stream_allocation(rd, obj->handle, args[1], args[2], &offset), args[1]);
+
+				// Draws and binds recorded after this refer to the captured offset
+				if (obj->mapped != NULL && offset != args[3] && state->desc->warning_callback != NULL)
+					state->desc->warning_callback(MRL_ERROR_NONE, u8"Failed to replay trace: stream allocation offset differs from the captured one");
+			}
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_UNMAP_STREAM_ALLOCATION:
+			MRL_REPLAY_REQUIRE_ARGS(2);
+			if ((obj = get_replay_object(state, args[0])) != NULL && obj->handle != NULL && obj->mapped != NULL)
+			{
+				err = unmap_replay_buffer(obj, payload, payload_size);
+				rd->unmap_stream_allocation(rd, obj->handle);
+				return err;
+			}
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_END_STREAM_ALLOCATOR_FRAME:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			rd->end_stream_allocator_frame(rd, get_replay_handle(state, args[0]));
+			return MRL_ERROR_NONE;
+
+		// Shaders
+		case MRL_CAPTURE_COMMAND_CREATE_SHADER_STAGE:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(3);
+			if (payload_size == 0 || payload[payload_size - 1] != 0)
+				return MRL_ERROR_INVALID_PARAMS;
+			mrl_shader_stage_desc_t desc = MRL_DEFAULT_SHADER_STAGE_DESC;
+			desc.stage = (mgl_enum_t)args[1];
+			desc.src_type = (mgl_enum_t)args[2];
+			desc.src = payload;
+			err = rd->create_shader_stage(rd, &handle, &desc);
+			return add_replay_object(state, args[0], opcode, err, handle);
+		}
+		case MRL_CAPTURE_COMMAND_DESTROY_SHADER_STAGE:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			destroy_replay_object(state, args[0]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_CREATE_SHADER_PIPELINE:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(3);
+			mrl_shader_pipeline_desc_t desc = MRL_DEFAULT_SHADER_PIPELINE_DESC;
+			desc.vertex = get_replay_handle(state, args[1]);
+			desc.pixel = get_replay_handle(state, args[2]);
+			if (check_replay_object(state, args[1], MGL_TRUE) && check_replay_object(state, args[2], MGL_TRUE))
+				err = rd->create_shader_pipeline(rd, &handle, &desc);
+			else
+				err = MRL_ERROR_INVALID_PARAMS;
+			return add_replay_object(state, args[0], opcode, err, handle);
+		}
+		case MRL_CAPTURE_COMMAND_DESTROY_SHADER_PIPELINE:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			destroy_replay_object(state, args[0]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_SET_SHADER_PIPELINE:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			MRL_REPLAY_OPTIONAL_OBJECT(args[0]);
+			rd->set_shader_pipeline(rd, get_replay_handle(state, args[0]));
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_GET_SHADER_BINDING_POINT:
+			MRL_REPLAY_REQUIRE_ARGS(2);
+			if (payload_size == 0 || payload[payload_size - 1] != 0)
+				return MRL_ERROR_INVALID_PARAMS;
+			if ((handle = get_replay_handle(state, args[0])) != NULL)
+				handle = rd->get_shader_binding_point(rd, handle, (const mgl_chr8_t*)payload);
+			return args[1] == 0 ? MRL_ERROR_NONE : add_replay_object(state, args[1], opcode, MRL_ERROR_NONE, handle);
+		case MRL_CAPTURE_COMMAND_GET_SHADER_BINDING_POINT_BY_ID:
+			MRL_REPLAY_REQUIRE_ARGS(3);
+			if ((handle = get_replay_handle(state, args[0])) != NULL)
+				handle = rd->get_shader_binding_point_by_id(rd, handle, args[2]);
+			return args[1] == 0 ? MRL_ERROR_NONE : add_replay_object(state, args[1], opcode, MRL_ERROR_NONE, handle);
+
+		// Draw functions
+		case MRL_CAPTURE_COMMAND_CLEAR_COLOR:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(4);
+			mgl_f32_t color[4];
+			for (mgl_u32_t i = 0; i < 4; ++i)
+			{
+				mgl_u32_t bits = (mgl_u32_t)args[i];
+				mgl_mem_copy(&color[i], &bits, sizeof(bits));
+			}
+			rd->clear_color(rd, color[0], color[1], color[2], color[3]);
+			return MRL_ERROR_NONE;
+		}
+		case MRL_CAPTURE_COMMAND_CLEAR_DEPTH:
+		{
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			mgl_f32_t depth;
+			mgl_u32_t bits = (mgl_u32_t)args[0];
+			mgl_mem_copy(&depth, &bits, sizeof(bits));
+			rd->clear_depth(rd, depth);
+			return MRL_ERROR_NONE;
+		}
+		case MRL_CAPTURE_COMMAND_CLEAR_STENCIL:
+			MRL_REPLAY_REQUIRE_ARGS(1);
+			rd->clear_stencil(rd, (mgl_i32_t)args[0]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_SWAP_BUFFERS:
+			rd->swap_buffers(rd);
+			if (state->desc->frame_callback != NULL)
+				state->desc->frame_callback(state->desc->user_data, state->frame);
+			state->frame += 1;
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_DRAW_TRIANGLES:
+			MRL_REPLAY_REQUIRE_ARGS(2);
+			rd->draw_triangles(rd, args[0], args[1]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_DRAW_TRIANGLES_INDEXED:
+			MRL_REPLAY_REQUIRE_ARGS(2);
+			rd->draw_triangles_indexed(rd, args[0], args[1]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_DRAW_TRIANGLES_INSTANCED:
+			MRL_REPLAY_REQUIRE_ARGS(3);
+			rd->draw_triangles_instanced(rd, args[0], args[1], args[2]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_DRAW_TRIANGLES_INDEXED_INSTANCED:
+			MRL_REPLAY_REQUIRE_ARGS(3);
+			rd->draw_triangles_indexed_instanced(rd, args[0], args[1], args[2]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_DRAW_TRIANGLES_INDEXED_BASE_VERTEX:
+			MRL_REPLAY_REQUIRE_ARGS(3);
+			rd->draw_triangles_indexed_base_vertex(rd, args[0], args[1], (mgl_i64_t)args[2]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_DRAW_TRIANGLES_INDEXED_INSTANCED_BASE_VERTEX:
+			MRL_REPLAY_REQUIRE_ARGS(4);
+			rd->draw_triangles_indexed_instanced_base_vertex(rd, args[0], args[1], args[2], (mgl_i64_t)args[3]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_SET_VIEWPORT:
+			MRL_REPLAY_REQUIRE_ARGS(4);
+			rd->set_viewport(rd, (mgl_i32_t)args[0], (mgl_i32_t)args[1], (mgl_i32_t)args[2], (mgl_i32_t)args[3]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_MULTI_DRAW_TRIANGLES:
+			MRL_REPLAY_REQUIRE_ARGS(2);
+			if (args[0] > payload_size / (2 * sizeof(mgl_u64_t)))
+				return MRL_ERROR_INVALID_PARAMS;
+			rd->multi_draw_triangles(rd, (const mgl_u64_t*)payload, (const mgl_u64_t*)payload + args[0], args[0]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_MULTI_DRAW_TRIANGLES_INDEXED:
+			MRL_REPLAY_REQUIRE_ARGS(2);
+			if (args[0] > payload_size / ((args[1] ? 3 : 2) * sizeof(mgl_u64_t)))
+				return MRL_ERROR_INVALID_PARAMS;
+			rd->multi_draw_triangles_indexed(rd, (const mgl_u64_t*)payload, (const mgl_u64_t*)payload + args[0], args[1] ? (const mgl_i64_t*)payload + 2 * args[0] : NULL, args[0]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_DRAW_TRIANGLES_INDIRECT:
+			MRL_REPLAY_REQUIRE_ARGS(3);
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			rd->draw_triangles_indirect(rd, get_replay_handle(state, args[0]), args[1], args[2]);
+			return MRL_ERROR_NONE;
+		case MRL_CAPTURE_COMMAND_DRAW_TRIANGLES_INDEXED_INDIRECT:
+			MRL_REPLAY_REQUIRE_ARGS(3);
+			MRL_REPLAY_REQUIRE_OBJECT(args[0]);
+			rd->draw_triangles_indexed_indirect(rd, get_replay_handle(state, args[0]), args[1], args[2]);
+			return MRL_ERROR_NONE;
+
+		default:
+			return MRL_ERROR_INVALID_PARAMS;
+	}
+}
+
+#undef MRL_REPLAY_REQUIRE_ARGS
+#undef MRL_REPLAY_REQUIRE_PAYLOAD
+#undef MRL_REPLAY_REQUIRE_OBJECT
+#undef MRL_REPLAY_OPTIONAL_OBJECT
+
+MRL_API mrl_error_t mrl_replay_trace(mrl_render_device_t* rd, const void* data, mgl_u64_t size, const mrl_replay_desc_t* desc)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && data != NULL && desc != NULL);
+	MGL_DEBUG_ASSERT(desc->allocator != NULL);
+
+	const mgl_u8_t* it = (const mgl_u8_t*)data;
+	const mgl_u8_t* end = it + size;
+
+	// Check trace header
+	if (size < 16)
+		return MRL_ERROR_INVALID_PARAMS;
+	for (mgl_u32_t i = 0; i < 4; ++i)
+		if (it[i] != (mgl_u8_t)MRL_TRACE_MAGIC[i])
+			return MRL_ERROR_INVALID_PARAMS;
+	mgl_u32_t version;
+	mgl_mem_copy(&version, it + 4, sizeof(version));
+	if (version != MRL_TRACE_VERSION)
+		return MRL_ERROR_INVALID_PARAMS;
+	it += 16;
+
+	mrl_replay_state_t state;
+	state.rd = rd;
+	state.desc = desc;
+	state.objects = NULL;
+	state.object_capacity = 0;
+	state.frame = 0;
+
+	mrl_error_t err = MRL_ERROR_NONE;
+	while (it < end)
+	{
+		// Read record header
+		if ((mgl_u64_t)(end - it) < 16)
+		{
+			err = MRL_ERROR_INVALID_PARAMS;
+			break;
+		}
+		const mgl_u32_t* header = (const mgl_u32_t*)it;
+		mgl_u64_t payload_size = *(const mgl_u64_t*)(it + 8);
+		mgl_u64_t args_size = (mgl_u64_t)header[1] * sizeof(mgl_u64_t);
+		mgl_u64_t padded_size = (payload_size + 7) & ~(mgl_u64_t)7;
+		if (payload_size > (mgl_u64_t)(end - it) || args_size + padded_size > (mgl_u64_t)(end - it) - 16)
+		{
+			err = MRL_ERROR_INVALID_PARAMS;
+			break;
+		}
+
+		const mgl_u64_t* args = (const mgl_u64_t*)(it + 16);
+		const mgl_u8_t* payload = it + 16 + args_size;
+		it = payload + padded_size;
+
+		err = replay_command(&state, header[0], args, header[1], payload, payload_size);
+		if (err != MRL_ERROR_NONE)
+			break;
+	}
+
+	// Destroy the objects left alive, newest first, so that objects are destroyed before the ones they reference
+	for (mgl_u64_t id = state.object_capacity; id-- > 1;)
+		destroy_replay_object(&state, id);
+	if (state.objects != NULL)
+		mgl_deallocate(desc->allocator, state.objects);
+
+	return err;
+}
@@ -0,0 +1,730 @@
+#include <mrl/command_buffer_internal.h>
+
+#include <mgl/memory/allocator.h>
+#include <mgl/memory/manipulation.h>
+
+enum
+{
+	MRL_COMMAND_SET_FRAMEBUFFER,
+	MRL_COMMAND_SET_RASTER_STATE,
+	MRL_COMMAND_SET_DEPTH_STENCIL_STATE,
+	MRL_COMMAND_SET_BLEND_STATE,
+	MRL_COMMAND_BIND_SAMPLER,
+	MRL_COMMAND_BIND_TEXTURE_1D,
+	MRL_COMMAND_BIND_TEXTURE_2D,
+	MRL_COMMAND_BIND_TEXTURE_3D,
+	MRL_COMMAND_BIND_CUBE_MAP,
+	MRL_COMMAND_BIND_TEXTURE_2D_ARRAY,
+	MRL_COMMAND_BIND_CUBE_MAP_ARRAY,
+	MRL_COMMAND_BIND_CONSTANT_BUFFER,
+	MRL_COMMAND_BIND_CONSTANT_BUFFER_RANGE,
+	MRL_COMMAND_UPDATE_CONSTANT_BUFFER,
+	MRL_COMMAND_SET_INDEX_BUFFER,
+	MRL_COMMAND_UPDATE_INDEX_BUFFER,
+	MRL_COMMAND_UPDATE_INDIRECT_BUFFER,
+	MRL_COMMAND_UPDATE_VERTEX_BUFFER,
+	MRL_COMMAND_SET_VERTEX_ARRAY,
+	MRL_COMMAND_SET_SHADER_PIPELINE,
+	MRL_COMMAND_SET_PIPELINE_STATE,
+	MRL_COMMAND_CLEAR_COLOR,
+	MRL_COMMAND_CLEAR_DEPTH,
+	MRL_COMMAND_CLEAR_STENCIL,
+	MRL_COMMAND_DRAW_TRIANGLES,
+	MRL_COMMAND_DRAW_TRIANGLES_INDEXED,
+	MRL_COMMAND_DRAW_TRIANGLES_INSTANCED,
+	MRL_COMMAND_DRAW_TRIANGLES_INDEXED_INSTANCED,
+	MRL_COMMAND_DRAW_TRIANGLES_INDEXED_BASE_VERTEX,
+	MRL_COMMAND_DRAW_TRIANGLES_INDEXED_INSTANCED_BASE_VERTEX,
+	MRL_COMMAND_MULTI_DRAW_TRIANGLES,
+	MRL_COMMAND_MULTI_DRAW_TRIANGLES_INDEXED,
+	MRL_COMMAND_DRAW_TRIANGLES_INDIRECT,
+	MRL_COMMAND_DRAW_TRIANGLES_INDEXED_INDIRECT,
+	MRL_COMMAND_SET_VIEWPORT,
+};
+
+#define MRL_COMMAND_ALIGNMENT 8
+#define MRL_COMMAND_ALIGN(x) (((x) + MRL_COMMAND_ALIGNMENT - 1) & ~(mgl_u64_t)(MRL_COMMAND_ALIGNMENT - 1))
+
+typedef struct mrl_command_chunk_t mrl_command_chunk_t;
+
+struct mrl_command_chunk_t
+{
+	mrl_command_chunk_t* next;
+	mgl_u64_t capacity;
+	mgl_u64_t used;
+};
+
+#define MRL_COMMAND_CHUNK_DATA(chunk) ((mgl_u8_t*)(chunk) + MRL_COMMAND_ALIGN(sizeof(mrl_command_chunk_t)))
+
+typedef struct
+{
+	mgl_u32_t type;
+	mgl_u32_t size;
+} mrl_command_header_t;
+
+typedef struct
+{
+	mrl_command_header_t header;
+	void* handle;
+} mrl_command_handle_t;
+
+typedef struct
+{
+	mrl_command_header_t header;
+	mrl_shader_binding_point_t* bp;
+	void* handle;
+} mrl_command_bind_t;
+
+typedef struct
+{
+	mrl_command_header_t header;
+	mrl_shader_binding_point_t* bp;
+	void* handle;
+	mgl_u64_t offset;
+	mgl_u64_t size;
+} mrl_command_bind_range_t;
+
+typedef struct
+{
+	mrl_command_header_t header;
+	void* handle;
+	mgl_u64_t offset;
+	mgl_u64_t size;
+} mrl_command_update_t;
+
+typedef struct
+{
+	mrl_command_header_t header;
+	mrl_pipeline_state_cache_t* cache;
+	mrl_pipeline_state_t* pso;
+} mrl_command_pipeline_state_t;
+
+typedef struct
+{
+	mrl_command_header_t header;
+	mgl_f32_t r, g, b, a;
+} mrl_command_clear_color_t;
+
+typedef struct
+{
+	mrl_command_header_t header;
+	mgl_f32_t depth;
+} mrl_command_clear_depth_t;
+
+typedef struct
+{
+	mrl_command_header_t header;
+	mgl_i32_t stencil;
+} mrl_command_clear_stencil_t;
+
+typedef struct
+{
+	mrl_command_header_t header;
+	mgl_u64_t offset;
+	mgl_u64_t count;
+	mgl_u64_t instance_count;
+	mgl_i64_t base_vertex;
+} mrl_command_draw_t;
+
+// Followed by the offset and count arrays, and by the base vertex array if there is one
+typedef struct
+{
+	mrl_command_header_t header;
+	mgl_u64_t draw_count;
+	mgl_bool_t base_vertices;
+} mrl_command_multi_draw_t;
+
+typedef struct
+{
+	mrl_command_header_t header;
+	void* handle;
+	mgl_u64_t offset;
+	mgl_u64_t draw_count;
+} mrl_command_draw_indirect_t;
+
+typedef struct
+{
+	mrl_command_header_t header;
+	mgl_i32_t x, y, w, h;
+} mrl_command_viewport_t;
+
+typedef struct
+{
+	void* allocator;
+	mgl_u64_t chunk_size;
+	mrl_command_chunk_t* first;
+	mrl_command_chunk_t* current;
+	mrl_error_t error;
+} mrl_command_buffer_obj_t;
+
+static mrl_command_chunk_t* allocate_chunk(mrl_command_buffer_obj_t* obj, mgl_u64_t capacity)
+{
+	mrl_command_chunk_t* chunk;
+	mgl_error_t err = mgl_allocate(
+		obj->allocator,
+		MRL_COMMAND_ALIGN(sizeof(mrl_command_chunk_t)) + capacity,
+		(void**)&chunk);
+	if (err != MGL_ERROR_NONE)
+	{
+		if (obj->error == MRL_ERROR_NONE)
+			obj->error = mrl_make_mgl_error(err);
+		return NULL;
+	}
+
+	chunk->next = NULL;
+	chunk->capacity = capacity;
+	chunk->used = 0;
+	return chunk;
+}
+
+static void* push_command(mrl_command_buffer_obj_t* obj, mgl_u32_t type, mgl_u64_t size)
+{
+	// Don't record anything else after an error, the command buffer won't be submitted anyway
+	if (obj->error != MRL_ERROR_NONE)
+		return NULL;
+
+	size = MRL_COMMAND_ALIGN(size);
+
+	// Find a chunk with enough space, reusing chunks left over from previous recordings
+	mrl_command_chunk_t* chunk = obj->current;
+	if (chunk == NULL || chunk->capacity - chunk->used < size)
+	{
+		if (chunk != NULL && chunk->next != NULL && chunk->next->capacity >= size)
+			chunk = chunk->next;
+		else
+		{
+			mrl_command_chunk_t* new_chunk = allocate_chunk(obj, size > obj->chunk_size ? size : obj->chunk_size);
+			if (new_chunk == NULL)
+				return NULL;
+
+			if (chunk == NULL)
+				obj->first = new_chunk;
+			else
+			{
+				new_chunk->next = chunk->next;
+				chunk->next = new_chunk;
+			}
+			chunk = new_chunk;
+		}
+
+		obj->current = chunk;
+	}
+
+	mrl_command_header_t* header = (mrl_command_header_t*)(MRL_COMMAND_CHUNK_DATA(chunk) + chunk->used);
+	header->type = type;
+	header->size = (mgl_u32_t)size;
+	chunk->used += size;
+	return header;
+}
+
+static void push_handle_command(mrl_command_buffer_t* cb, mgl_u32_t type, void* handle)
+{
+	MGL_DEBUG_ASSERT(cb != NULL);
+	mrl_command_handle_t* cmd = push_command((mrl_command_buffer_obj_t*)cb, type, sizeof(*cmd));
+	if (cmd != NULL)
+		cmd->handle = handle;
+}
+
+static void push_bind_command(mrl_command_buffer_t* cb, mgl_u32_t type, mrl_shader_binding_point_t* bp, void* handle)
+{
+	MGL_DEBUG_ASSERT(cb != NULL && bp != NULL);
+	mrl_command_bind_t* cmd = push_command((mrl_command_buffer_obj_t*)cb, type, sizeof(*cmd));
+	if (cmd != NULL)
+	{
+		cmd->bp = bp;
+		cmd->handle = handle;
+	}
+}
+
+static void push_update_command(mrl_command_buffer_t* cb, mgl_u32_t type, void* handle, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	MGL_DEBUG_ASSERT(cb != NULL && handle != NULL && (data != NULL || size == 0));
+	mrl_command_update_t* cmd = push_command((mrl_command_buffer_obj_t*)cb, type, sizeof(*cmd) + size);
+	if (cmd != NULL)
+	{
+		cmd->handle = handle;
+		cmd->offset = offset;
+		cmd->size = size;
+		mgl_mem_copy(cmd + 1, data, size);
+	}
+}
+
+static void push_draw_command(mrl_command_buffer_t* cb, mgl_u32_t type, mgl_u64_t offset, mgl_u64_t count, mgl_u64_t instance_count, mgl_i64_t base_vertex)
+{
+	MGL_DEBUG_ASSERT(cb != NULL);
+	mrl_command_draw_t* cmd = push_command((mrl_command_buffer_obj_t*)cb, type, sizeof(*cmd));
+	if (cmd != NULL)
+	{
+		cmd->offset = offset;
+		cmd->count = count;
+		cmd->instance_count = instance_count;
+		cmd->base_vertex = base_vertex;
+	}
+}
+
+static void push_multi_draw_command(mrl_command_buffer_t* cb, mgl_u32_t type, const mgl_u64_t* offsets, const mgl_u64_t* counts, const mgl_i64_t* base_vertices, mgl_u64_t draw_count)
+{
+	MGL_DEBUG_ASSERT(cb != NULL && (draw_count == 0 || (offsets != NULL && counts != NULL)));
+	mgl_u64_t array_size = draw_count * sizeof(mgl_u64_t);
+	mrl_command_multi_draw_t* cmd = push_command((mrl_command_buffer_obj_t*)cb, type, sizeof(*cmd) + array_size * (base_vertices != NULL ? 3 : 2));
+	if (cmd != NULL)
+	{
+		cmd->draw_count = draw_count;
+		cmd->base_vertices = base_vertices != NULL;
+		mgl_u64_t* arrays = (mgl_u64_t*)(cmd + 1);
+		mgl_mem_copy(arrays, offsets, array_size);
+		mgl_mem_copy(arrays + draw_count, counts, array_size);
+		if (base_vertices != NULL)
+			mgl_mem_copy(arrays + 2 * draw_count, base_vertices, array_size);
+	}
+}
+
+static void push_draw_indirect_command(mrl_command_buffer_t* cb, mgl_u32_t type, void* handle, mgl_u64_t offset, mgl_u64_t draw_count)
+{
+	MGL_DEBUG_ASSERT(cb != NULL && handle != NULL);
+	mrl_command_draw_indirect_t* cmd = push_command((mrl_command_buffer_obj_t*)cb, type, sizeof(*cmd));
+	if (cmd != NULL)
+	{
+		cmd->handle = handle;
+		cmd->offset = offset;
+		cmd->draw_count = draw_count;
+	}
+}
+
+static void execute_command(mrl_render_device_t* rd, const mrl_command_header_t* header)
+{
+	const mrl_command_handle_t* handle_cmd = (const mrl_command_handle_t*)header;
+	const mrl_command_bind_t* bind_cmd = (const mrl_command_bind_t*)header;
+	const mrl_command_update_t* update_cmd = (const mrl_command_update_t*)header;
+	const mrl_command_draw_t* draw_cmd = (const mrl_command_draw_t*)header;
+	const mrl_command_multi_draw_t* multi_draw_cmd = (const mrl_command_multi_draw_t*)header;
+	const mrl_command_draw_indirect_t* indirect_cmd = (const mrl_command_draw_indirect_t*)header;
+
+	switch (header->type)
+	{
+		case MRL_COMMAND_SET_FRAMEBUFFER: mrl_set_framebuffer(rd, handle_cmd->handle); break;
+		case MRL_COMMAND_SET_RASTER_STATE: mrl_set_raster_state(rd, handle_cmd->handle); break;
+		case MRL_COMMAND_SET_DEPTH_STENCIL_STATE: mrl_set_depth_stencil_state(rd, handle_cmd->handle); break;
+		case MRL_COMMAND_SET_BLEND_STATE: mrl_set_blend_state(rd, handle_cmd->handle); break;
+		case MRL_COMMAND_BIND_SAMPLER: mrl_bind_sampler(rd, bind_cmd->bp, bind_cmd->handle); break;
+		case MRL_COMMAND_BIND_TEXTURE_1D: mrl_bind_texture_1d(rd, bind_cmd->bp, bind_cmd->handle); break;
+		case MRL_COMMAND_BIND_TEXTURE_2D: mrl_bind_texture_2d(rd, bind_cmd->bp, bind_cmd->handle); break;
+		case MRL_COMMAND_BIND_TEXTURE_3D: mrl_bind_texture_3d(rd, bind_cmd->bp, bind_cmd->handle); break;
+		case MRL_COMMAND_BIND_CUBE_MAP: mrl_bind_cube_map(rd, bind_cmd->bp, bind_cmd->handle); break;
+		case MRL_COMMAND_BIND_TEXTURE_2D_ARRAY: mrl_bind_texture_2d_array(rd, bind_cmd->bp, bind_cmd->handle); break;
+		case MRL_COMMAND_BIND_CUBE_MAP_ARRAY: mrl_bind_cube_map_array(rd, bind_cmd->bp, bind_cmd->handle); break;
+		case MRL_COMMAND_BIND_CONSTANT_BUFFER: mrl_bind_constant_buffer(rd, bind_cmd->bp, bind_cmd->handle); break;
+
+		case MRL_COMMAND_BIND_CONSTANT_BUFFER_RANGE:
+		{
+			const mrl_command_bind_range_t* cmd = (const mrl_command_bind_range_t*)header;
+			mrl_bind_constant_buffer_range(rd, cmd->bp, cmd->handle, cmd->offset, cmd->size);
+			break;
+		}
+
+		case MRL_COMMAND_UPDATE_CONSTANT_BUFFER: mrl_update_constant_buffer(rd, update_cmd->handle, update_cmd->offset, update_cmd->size, update_cmd + 1); break;
+		case MRL_COMMAND_SET_INDEX_BUFFER: mrl_set_index_buffer(rd, handle_cmd->handle); break;
+		case MRL_COMMAND_UPDATE_INDEX_BUFFER: mrl_update_index_buffer(rd, update_cmd->handle, update_cmd->offset, update_cmd->size, update_cmd + 1); break;
+		case MRL_COMMAND_UPDATE_INDIRECT_BUFFER: mrl_update_indirect_buffer(rd, update_cmd->handle, update_cmd->offset, update_cmd->size, update_cmd + 1); break;
+		case MRL_COMMAND_UPDATE_VERTEX_BUFFER: mrl_update_vertex_buffer(rd, update_cmd->handle, update_cmd->offset, update_cmd->size, update_cmd + 1); break;
+		case MRL_COMMAND_SET_VERTEX_ARRAY: mrl_set_vertex_array(rd, handle_cmd->handle); break;
+		case MRL_COMMAND_SET_SHADER_PIPELINE: mrl_set_shader_pipeline(rd, handle_cmd->handle); break;
+
+		case MRL_COMMAND_SET_PIPELINE_STATE:
+		{
+			const mrl_command_pipeline_state_t* cmd = (const mrl_command_pipeline_state_t*)header;
+			mrl_set_pipeline_state(rd, cmd->cache, cmd->pso);
+			break;
+		}
+
+		case MRL_COMMAND_CLEAR_COLOR:
+		{
+			const mrl_command_clear_color_t* cmd = (const mrl_command_clear_color_t*)header;
+			mrl_clear_color(rd, cmd->r, cmd->g, cmd->b, cmd->a);
+			break;
+		}
+
+		case MRL_COMMAND_CLEAR_DEPTH: mrl_clear_depth(rd, ((const mrl_command_clear_depth_t*)header)->depth); break;
+		case MRL_COMMAND_CLEAR_STENCIL: mrl_clear_stencil(rd, ((const mrl_command_clear_stencil_t*)header)->stencil); break;
+		case MRL_COMMAND_DRAW_TRIANGLES: mrl_draw_triangles(rd, draw_cmd->offset, draw_cmd->count); break;
+		case MRL_COMMAND_DRAW_TRIANGLES_INDEXED: mrl_draw_triangles_indexed(rd, draw_cmd->offset, draw_cmd->count); break;
+		case MRL_COMMAND_DRAW_TRIANGLES_INSTANCED: mrl_draw_triangles_instanced(rd, draw_cmd->offset, draw_cmd->count, draw_cmd->instance_count); break;
+		case MRL_COMMAND_DRAW_TRIANGLES_INDEXED_INSTANCED: mrl_draw_triangles_indexed_instanced(rd, draw_cmd->offset, draw_cmd->count, draw_cmd->instance_count); break;
+		case MRL_COMMAND_DRAW_TRIANGLES_INDEXED_BASE_VERTEX: mrl_draw_triangles_indexed_base_vertex(rd, draw_cmd->offset, draw_cmd->count, draw_cmd->base_vertex); break;
+		case MRL_COMMAND_DRAW_TRIANGLES_INDEXED_INSTANCED_BASE_VERTEX: mrl_draw_triangles_indexed_instanced_base_vertex(rd, draw_cmd->offset, draw_cmd->count, draw_cmd->instance_count, draw_cmd->base_vertex); break;
+
+		case MRL_COMMAND_MULTI_DRAW_TRIANGLES:
+		{
+			const mgl_u64_t* arrays = (const mgl_u64_t*)(multi_draw_cmd + 1);
+			mrl_multi_draw_triangles(rd, arrays, arrays + multi_draw_cmd->draw_count, multi_draw_cmd->draw_count);
+			break;
+		}
+
+		case MRL_COMMAND_MULTI_DRAW_TRIANGLES_INDEXED:
+		{
+			const mgl_u64_t* arrays = (const mgl_u64_t*)(multi_draw_cmd + 1);
+			const mgl_i64_t* base_vertices = multi_draw_cmd->base_vertices ? (const mgl_i64_t*)(arrays + 2 * multi_draw_cmd->draw_count) : NULL;
+			mrl_multi_draw_triangles_indexed(rd, arrays, arrays + multi_draw_cmd->draw_count, base_vertices, multi_draw_cmd->draw_count);
+			break;
+		}
+
+		case MRL_COMMAND_DRAW_TRIANGLES_INDIRECT: mrl_draw_triangles_indirect(rd, indirect_cmd->handle, indirect_cmd->offset, indirect_cmd->draw_count); break;
+		case MRL_COMMAND_DRAW_TRIANGLES_INDEXED_INDIRECT: mrl_draw_triangles_indexed_indirect(rd, indirect_cmd->handle, indirect_cmd->offset, indirect_cmd->draw_count); break;
+
+		case MRL_COMMAND_SET_VIEWPORT:
+		{
+			const mrl_command_viewport_t* cmd = (const mrl_command_viewport_t*)header;
+			mrl_set_viewport(rd, cmd->x, cmd->y, cmd->w, cmd->h);
+			break;
+		}
+
+		default:
+			MGL_DEBUG_ASSERT(MGL_FALSE); // Unknown command type
+			break;
+	}
+}
+
+static void execute_chunk_range(mrl_render_device_t* rd, const mrl_command_chunk_t* chunk, mgl_u64_t begin, mgl_u64_t end)
+{
+	const mgl_u8_t* data = MRL_COMMAND_CHUNK_DATA(chunk);
+	for (mgl_u64_t offset = begin; offset < end;)
+	{
+		const mrl_command_header_t* header = (const mrl_command_header_t*)(data + offset);
+		execute_command(rd, header);
+		offset += header->size;
+	}
+}
+
+void mrl_get_command_buffer_mark(mrl_command_buffer_t* cb, mrl_command_buffer_mark_t* mark)
+{
+	MGL_DEBUG_ASSERT(cb != NULL && mark != NULL);
+	mrl_command_buffer_obj_t* obj = (mrl_command_buffer_obj_t*)cb;
+	mark->chunk = obj->current;
+	mark->offset = obj->current->used;
+}
+
+void mrl_execute_command_buffer_range(mrl_render_device_t* rd, const mrl_command_buffer_mark_t* begin, const mrl_command_buffer_mark_t* end)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && begin != NULL && end != NULL);
+
+	mgl_u64_t offset = begin->offset;
+	for (const mrl_command_chunk_t* chunk = begin->chunk; chunk != NULL; chunk = chunk->next)
+	{
+		if (chunk == end->chunk)
+		{
+			execute_chunk_range(rd, chunk, offset, end->offset);
+			break;
+		}
+
+		execute_chunk_range(rd, chunk, offset, chunk->used);
+		offset = 0;
+	}
+}
+
+MRL_API mrl_error_t mrl_create_command_buffer(const mrl_command_buffer_desc_t* desc, mrl_command_buffer_t** cb)
+{
+	MGL_DEBUG_ASSERT(desc != NULL && cb != NULL);
+	MGL_DEBUG_ASSERT(desc->allocator != NULL && desc->chunk_size > 0);
+
+	// Allocate object
+	mrl_command_buffer_obj_t* obj;
+	mgl_error_t err = mgl_allocate(desc->allocator, sizeof(*obj), (void**)&obj);
+	if (err != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(err);
+
+	// Store command buffer info
+	obj->allocator = desc->allocator;
+	obj->chunk_size = MRL_COMMAND_ALIGN(desc->chunk_size);
+	obj->first = NULL;
+	obj->current = NULL;
+	obj->error = MRL_ERROR_NONE;
+
+	// Allocate first chunk
+	obj->first = allocate_chunk(obj, obj->chunk_size);
+	if (obj->first == NULL)
+	{
+		mrl_error_t mrlerr = obj->error;
+		mgl_deallocate(desc->allocator, obj);
+		return mrlerr;
+	}
+	obj->current = obj->first;
+
+	*cb = (mrl_command_buffer_t*)obj;
+
+	return MRL_ERROR_NONE;
+}
+
+MRL_API void mrl_destroy_command_buffer(mrl_command_buffer_t* cb)
+{
+	MGL_DEBUG_ASSERT(cb != NULL);
+	mrl_command_buffer_obj_t* obj = (mrl_command_buffer_obj_t*)cb;
+
+	// Deallocate chunks
+	for (mrl_command_chunk_t* chunk = obj->first; chunk != NULL;)
+	{
+		mrl_command_chunk_t* next = chunk->next;
+		mgl_deallocate(obj->allocator, chunk);
+		chunk = next;
+	}
+
+	// Deallocate object
+	mgl_deallocate(obj->allocator, obj);
+}
+
+MRL_API void mrl_reset_command_buffer(mrl_command_buffer_t* cb)
+{
+	MGL_DEBUG_ASSERT(cb != NULL);
+	mrl_command_buffer_obj_t* obj = (mrl_command_buffer_obj_t*)cb;
+
+	for (mrl_command_chunk_t* chunk = obj->first; chunk != NULL; chunk = chunk->next)
+		chunk->used = 0;
+	obj->current = obj->first;
+	obj->error = MRL_ERROR_NONE;
+}
+
+MRL_API mrl_error_t mrl_get_command_buffer_error(mrl_command_buffer_t* cb)
+{
+	MGL_DEBUG_ASSERT(cb != NULL);
+	return ((mrl_command_buffer_obj_t*)cb)->error;
+}
+
+MRL_API mrl_error_t mrl_submit_command_buffers(mrl_render_device_t* rd, mrl_command_buffer_t** cbs, mgl_u64_t count)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && (cbs != NULL || count == 0));
+
+	// Check if any of the command buffers failed recording
+	for (mgl_u64_t i = 0; i < count; ++i)
+	{
+		MGL_DEBUG_ASSERT(cbs[i] != NULL);
+		mrl_command_buffer_obj_t* obj = (mrl_command_buffer_obj_t*)cbs[i];
+		if (obj->error != MRL_ERROR_NONE)
+			return obj->error;
+	}
+
+	// Execute commands
+	for (mgl_u64_t i = 0; i < count; ++i)
+	{
+		mrl_command_buffer_obj_t* obj = (mrl_command_buffer_obj_t*)cbs[i];
+		for (mrl_command_chunk_t* chunk = obj->first; chunk != NULL; chunk = chunk->next)
+		{
+			execute_chunk_range(rd, chunk, 0, chunk->used);
+
+			// Chunks after the current one are left over from previous recordings
+			if (chunk == obj->current)
+				break;
+		}
+	}
+
+	return MRL_ERROR_NONE;
+}
+
+MRL_API void mrl_cmd_set_framebuffer(mrl_command_buffer_t* cb, mrl_framebuffer_t* fb)
+{
+	push_handle_command(cb, MRL_COMMAND_SET_FRAMEBUFFER, fb);
+}
+
+MRL_API void mrl_cmd_set_raster_state(mrl_command_buffer_t* cb, mrl_raster_state_t* s)
+{
+	push_handle_command(cb, MRL_COMMAND_SET_RASTER_STATE, s);
+}
+
+MRL_API void mrl_cmd_set_depth_stencil_state(mrl_command_buffer_t* cb, mrl_depth_stencil_state_t* s)
+{
+	push_handle_command(cb, MRL_COMMAND_SET_DEPTH_STENCIL_STATE, s);
+}
+
+MRL_API void mrl_cmd_set_blend_state(mrl_command_buffer_t* cb, mrl_blend_state_t* s)
+{
+	push_handle_command(cb, MRL_COMMAND_SET_BLEND_STATE, s);
+}
+
+MRL_API void mrl_cmd_bind_sampler(mrl_command_buffer_t* cb, mrl_shader_binding_point_t* bp, mrl_sampler_t* s)
+{
+	push_bind_command(cb, MRL_COMMAND_BIND_SAMPLER, bp, s);
+}
+
+MRL_API void mrl_cmd_bind_texture_1d(mrl_command_buffer_t* cb, mrl_shader_binding_point_t* bp, mrl_texture_1d_t* tex)
+{
+	push_bind_command(cb, MRL_COMMAND_BIND_TEXTURE_1D, bp, tex);
+}
+
+MRL_API void mrl_cmd_bind_texture_2d(mrl_command_buffer_t* cb, mrl_shader_binding_point_t* bp, mrl_texture_2d_t* tex)
+{
+	push_bind_command(cb, MRL_COMMAND_BIND_TEXTURE_2D, bp, tex);
+}
+
+MRL_API void mrl_cmd_bind_texture_3d(mrl_command_buffer_t* cb, mrl_shader_binding_point_t* bp, mrl_texture_3d_t* tex)
+{
+	push_bind_command(cb, MRL_COMMAND_BIND_TEXTURE_3D, bp, tex);
+}
+
+MRL_API void mrl_cmd_bind_cube_map(mrl_command_buffer_t* cb, mrl_shader_binding_point_t* bp, mrl_cube_map_t* cm)
+{
+	push_bind_command(cb, MRL_COMMAND_BIND_CUBE_MAP, bp, cm);
+}
+
+MRL_API void mrl_cmd_bind_texture_2d_array(mrl_command_buffer_t* cb, mrl_shader_binding_point_t* bp, mrl_texture_2d_array_t* tex)
+{
+	push_bind_command(cb, MRL_COMMAND_BIND_TEXTURE_2D_ARRAY, bp, tex);
+}
+
+MRL_API void mrl_cmd_bind_cube_map_array(mrl_command_buffer_t* cb, mrl_shader_binding_point_t* bp, mrl_cube_map_array_t* tex)
+{
+	push_bind_command(cb, MRL_COMMAND_BIND_CUBE_MAP_ARRAY, bp, tex);
+}
+
+MRL_API void mrl_cmd_bind_constant_buffer(mrl_command_buffer_t* cb, mrl_shader_binding_point_t* bp, mrl_constant_buffer_t* buf)
+{
+	push_bind_command(cb, MRL_COMMAND_BIND_CONSTANT_BUFFER, bp, buf);
+}
+
+MRL_API void mrl_cmd_bind_constant_buffer_range(mrl_command_buffer_t* cb, mrl_shader_binding_point_t* bp, mrl_constant_buffer_t* buf, mgl_u64_t offset, mgl_u64_t size)
+{
+	MGL_DEBUG_ASSERT(cb != NULL && bp != NULL && buf != NULL);
+	mrl_command_bind_range_t* cmd = push_command((mrl_command_buffer_obj_t*)cb, MRL_COMMAND_BIND_CONSTANT_BUFFER_RANGE, sizeof(*cmd));
+	if (cmd != NULL)
+	{
+		cmd->bp = bp;
+		cmd->handle = buf;
+		cmd->offset = offset;
+		cmd->size = size;
+	}
+}
+
+MRL_API void mrl_cmd_update_constant_buffer(mrl_command_buffer_t* cb, mrl_constant_buffer_t* buf, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	push_update_command(cb, MRL_COMMAND_UPDATE_CONSTANT_BUFFER, buf, offset, size, data);
+}
+
+MRL_API void mrl_cmd_set_index_buffer(mrl_command_buffer_t* cb, mrl_index_buffer_t* ib)
+{
+	push_handle_command(cb, MRL_COMMAND_SET_INDEX_BUFFER, ib);
+}
+
+MRL_API void mrl_cmd_update_index_buffer(mrl_command_buffer_t* cb, mrl_index_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	push_update_command(cb, MRL_COMMAND_UPDATE_INDEX_BUFFER, ib, offset, size, data);
+}
+
+MRL_API void mrl_cmd_update_indirect_buffer(mrl_command_buffer_t* cb, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	push_update_command(cb, MRL_COMMAND_UPDATE_INDIRECT_BUFFER, ib, offset, size, data);
+}
+
+MRL_API void mrl_cmd_update_vertex_buffer(mrl_command_buffer_t* cb, mrl_vertex_buffer_t* vb, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	push_update_command(cb, MRL_COMMAND_UPDATE_VERTEX_BUFFER, vb, offset, size, data);
+}
+
+MRL_API void mrl_cmd_set_vertex_array(mrl_command_buffer_t* cb, mrl_vertex_array_t* va)
+{
+	push_handle_command(cb, MRL_COMMAND_SET_VERTEX_ARRAY, va);
+}
+
+MRL_API void mrl_cmd_set_shader_pipeline(mrl_command_buffer_t* cb, mrl_shader_pipeline_t* pipeline)
+{
+	push_handle_command(cb, MRL_COMMAND_SET_SHADER_PIPELINE, pipeline);
+}
+
+MRL_API void mrl_cmd_set_pipeline_state(mrl_command_buffer_t* cb, mrl_pipeline_state_cache_t* cache, mrl_pipeline_state_t* pso)
+{
+	MGL_DEBUG_ASSERT(cb != NULL && cache != NULL && pso != NULL);
+	mrl_command_pipeline_state_t* cmd = push_command((mrl_command_buffer_obj_t*)cb, MRL_COMMAND_SET_PIPELINE_STATE, sizeof(*cmd));
+	if (cmd != NULL)
+	{
+		cmd->cache = cache;
+		cmd->pso = pso;
+	}
+}
+
+MRL_API void mrl_cmd_clear_color(mrl_command_buffer_t* cb, mgl_f32_t r, mgl_f32_t g, mgl_f32_t b, mgl_f32_t a)
+{
+	MGL_DEBUG_ASSERT(cb != NULL);
+	mrl_command_clear_color_t* cmd = push_command((mrl_command_buffer_obj_t*)cb, MRL_COMMAND_CLEAR_COLOR, sizeof(*cmd));
+	if (cmd != NULL)
+	{
+		cmd->r = r;
+		cmd->g = g;
+		cmd->b = b;
+		cmd->a = a;
+	}
+}
+
+MRL_API void mrl_cmd_clear_depth(mrl_command_buffer_t* cb, mgl_f32_t depth)
+{
+	MGL_DEBUG_ASSERT(cb != NULL);
+	mrl_command_clear_depth_t* cmd = push_command((mrl_command_buffer_obj_t*)cb, MRL_COMMAND_CLEAR_DEPTH, sizeof(*cmd));
+	if (cmd != NULL)
+		cmd->depth = depth;
+}
+
+MRL_API void mrl_cmd_clear_stencil(mrl_command_buffer_t* cb, mgl_i32_t stencil)
+{
+	MGL_DEBUG_ASSERT(cb != NULL);
+	mrl_command_clear_stencil_t* cmd = push_command((mrl_command_buffer_obj_t*)cb, MRL_COMMAND_CLEAR_STENCIL, sizeof(*cmd));
+	if (cmd != NULL)
+		cmd->stencil = stencil;
+}
+
+MRL_API void mrl_cmd_draw_triangles(mrl_command_buffer_t* cb, mgl_u64_t offset, mgl_u64_t count)
+{
+	push_draw_command(cb, MRL_COMMAND_DRAW_TRIANGLES, offset, count, 1, 0);
+}
+
+MRL_API void mrl_cmd_draw_triangles_indexed(mrl_command_buffer_t* cb, mgl_u64_t offset, mgl_u64_t count)
+{
+	push_draw_command(cb, MRL_COMMAND_DRAW_TRIANGLES_INDEXED, offset, count, 1, 0);
+}
+
+MRL_API void mrl_cmd_draw_triangles_instanced(mrl_command_buffer_t* cb, mgl_u64_t offset, mgl_u64_t count, mgl_u64_t instance_count)
+{
+	push_draw_command(cb, MRL_COMMAND_DRAW_TRIANGLES_INSTANCED, offset, count, instance_count, 0);
+}
+
+MRL_API void mrl_cmd_draw_triangles_indexed_instanced(mrl_command_buffer_t* cb, mgl_u64_t offset, mgl_u64_t count, mgl_u64_t instance_count)
+{
+	push_draw_command(cb, MRL_COMMAND_DRAW_TRIANGLES_INDEXED_INSTANCED, offset, count, instance_count, 0);
+}
+
+MRL_API void mrl_cmd_draw_triangles_indexed_base_vertex(mrl_command_buffer_t* cb, mgl_u64_t offset, mgl_u64_t count, mgl_i64_t base_vertex)
+{
+	push_draw_command(cb, MRL_COMMAND_DRAW_TRIANGLES_INDEXED_BASE_VERTEX, offset, count, 1, base_vertex);
+}
+
+MRL_API void mrl_cmd_draw_triangles_indexed_instanced_base_vertex(mrl_command_buffer_t* cb, mgl_u64_t offset, mgl_u64_t count, mgl_u64_t instance_count, mgl_i64_t base_vertex)
+{
+	push_draw_command(cb, MRL_COMMAND_DRAW_TRIANGLES_INDEXED_INSTANCED_BASE_VERTEX, offset, count, instance_count, base_vertex);
+}
+
+MRL_API void mrl_cmd_multi_draw_triangles(mrl_command_buffer_t* cb, const mgl_u64_t* offsets, const mgl_u64_t* counts, mgl_u64_t draw_count)
+{
+	push_multi_draw_command(cb, MRL_COMMAND_MULTI_DRAW_TRIANGLES, offsets, counts, NULL, draw_count);
+}
+
+MRL_API void mrl_cmd_multi_draw_triangles_indexed(mrl_command_buffer_t* cb, const mgl_u64_t* offsets, const mgl_u64_t* counts, const mgl_i64_t* base_vertices, mgl_u64_t draw_count)
+{
+	push_multi_draw_command(cb, MRL_COMMAND_MULTI_DRAW_TRIANGLES_INDEXED, offsets, counts, base_vertices, draw_count);
+}
+
+MRL_API void mrl_cmd_draw_triangles_indirect(mrl_command_buffer_t* cb, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t draw_count)
+{
+	push_draw_indirect_command(cb, MRL_COMMAND_DRAW_TRIANGLES_INDIRECT, ib, offset, draw_count);
+}
+
+MRL_API void mrl_cmd_draw_triangles_indexed_indirect(mrl_command_buffer_t* cb, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t draw_count)
+{
+	push_draw_indirect_command(cb, MRL_COMMAND_DRAW_TRIANGLES_INDEXED_INDIRECT, ib, offset, draw_count);
+}
+
+MRL_API void mrl_cmd_set_viewport(mrl_command_buffer_t* cb, mgl_i32_t x, mgl_i32_t y, mgl_i32_t w, mgl_i32_t h)
+{
+	MGL_DEBUG_ASSERT(cb != NULL);
+	mrl_command_viewport_t* cmd = push_command((mrl_command_buffer_obj_t*)cb, MRL_COMMAND_SET_VIEWPORT, sizeof(*cmd));
+	if (cmd != NULL)
+	{
+		cmd->x = x;
+		cmd->y = y;
+		cmd->w = w;
+		cmd->h = h;
+	}
+}
@@ -0,0 +1,30 @@
+#ifndef MRL_COMMAND_BUFFER_INTERNAL_H
+#define MRL_COMMAND_BUFFER_INTERNAL_H
+
+#include <mrl/command_buffer.h>
+
+/// <summary>
+///		Position inside of a command buffer, used to delimit a range of recorded commands.
+/// </summary>
+typedef struct
+{
+	void* chunk;
+	mgl_u64_t offset;
+} mrl_command_buffer_mark_t;
+
+/// <summary>
+///		Gets the position where the next command recorded into a command buffer will be stored.
+/// </summary>
+/// <param name="cb">Command buffer handle</param>
+/// <param name="mark">Out mark</param>
+void mrl_get_command_buffer_mark(mrl_command_buffer_t* cb, mrl_command_buffer_mark_t* mark);
+
+/// <summary>
+///		Executes the commands recorded on a command buffer between two marks.
+/// </summary>
+/// <param name="rd">Render device</param>
+/// <param name="begin">Mark taken before the first command</param>
+/// <param name="end">Mark taken after the last command</param>
+void mrl_execute_command_buffer_range(mrl_render_device_t* rd, const mrl_command_buffer_mark_t* begin, const mrl_command_buffer_mark_t* end);
+
+#endif
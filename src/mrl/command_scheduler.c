@@ -0,0 +1,337 @@
+#include <mrl/command_scheduler.h>
+#include <mrl/command_buffer_internal.h>
+#include <mrl/thread.h>
+
+#include <mgl/memory/allocator.h>
+
+typedef struct mrl_command_scheduler_obj_t mrl_command_scheduler_obj_t;
+
+typedef struct
+{
+	mrl_command_scheduler_obj_t* s;
+	mgl_u32_t index;
+	mrl_thread_t thread;
+
+	// Per-thread recording arena
+	mrl_command_buffer_t* cb;
+
+	// Range of jobs which haven't been taken yet.
+	// The owner takes jobs from the front and thieves take them from the back.
+	mrl_mutex_t mutex;
+	mgl_u64_t begin;
+	mgl_u64_t end;
+} mrl_command_worker_t;
+
+typedef struct
+{
+	mrl_command_buffer_mark_t begin;
+	mrl_command_buffer_mark_t end;
+} mrl_command_job_t;
+
+struct mrl_command_scheduler_obj_t
+{
+	void* allocator;
+
+	// Worker 0 is the thread which records the jobs, the others have their own threads
+	mgl_u32_t worker_count;
+	mrl_command_worker_t* workers;
+
+	mgl_u64_t max_job_count;
+	mgl_u64_t job_count;
+	mrl_command_job_t* jobs;
+
+	// Current recording
+	mgl_u64_t item_count;
+	mgl_u64_t job_size;
+	mrl_command_job_func_t func;
+	void* user_data;
+
+	mrl_mutex_t mutex;
+	mrl_condition_t start_cond;
+	mrl_condition_t done_cond;
+	mgl_u64_t generation;
+	mgl_u32_t active_worker_count;
+	mgl_bool_t quit;
+};
+
+static mgl_bool_t pop_job(mrl_command_worker_t* w, mgl_u64_t* job)
+{
+	mgl_bool_t found = MGL_FALSE;
+	mrl_lock_mutex(&w->mutex);
+	if (w->begin < w->end)
+	{
+		*job = w->begin++;
+		found = MGL_TRUE;
+	}
+	mrl_unlock_mutex(&w->mutex);
+	return found;
+}
+
+static mgl_bool_t steal_job(mrl_command_worker_t* w, mgl_u64_t* job)
+{
+	mgl_bool_t found = MGL_FALSE;
+	mrl_lock_mutex(&w->mutex);
+	if (w->begin < w->end)
+	{
+		*job = --w->end;
+		found = MGL_TRUE;
+	}
+	mrl_unlock_mutex(&w->mutex);
+	return found;
+}
+
+static void run_jobs(mrl_command_worker_t* w)
+{
+	mrl_command_scheduler_obj_t* s = w->s;
+
+	for (;;)
+	{
+		// Take a job from our own range, or steal one from another worker
+		mgl_u64_t j;
+		mgl_bool_t found = pop_job(w, &j);
+		for (mgl_u32_t i = 1; !found && i < s->worker_count; ++i)
+			found = steal_job(&s->workers[(w->index + i) % s->worker_count], &j);
+		if (!found)
+			return;
+
+		// Record job
+		mgl_u64_t first = j * s->job_size;
+		mgl_u64_t count = s->item_count - first < s->job_size ? s->item_count - first : s->job_size;
+
+		mrl_command_job_t* job = &s->jobs[j];
+		mrl_get_command_buffer_mark(w->cb, &job->begin);
+		s->func(w->cb, first, count, s->user_data);
+		mrl_get_command_buffer_mark(w->cb, &job->end);
+	}
+}
+
+static void worker_main(void* arg)
+{
+	mrl_command_worker_t* w = (mrl_command_worker_t*)arg;
+	mrl_command_scheduler_obj_t* s = w->s;
+	mgl_u64_t generation = 0;
+
+	for (;;)
+	{
+		// Wait for a new recording
+		mrl_lock_mutex(&s->mutex);
+		while (s->generation == generation && !s->quit)
+			mrl_wait_condition(&s->start_cond, &s->mutex);
+		if (s->quit)
+		{
+			mrl_unlock_mutex(&s->mutex);
+			return;
+		}
+		generation = s->generation;
+		mrl_unlock_mutex(&s->mutex);
+
+		run_jobs(w);
+
+		// Notify the recording thread
+		mrl_lock_mutex(&s->mutex);
+		if (--s->active_worker_count == 0)
+			mrl_signal_condition(&s->done_cond);
+		mrl_unlock_mutex(&s->mutex);
+	}
+}
+
+static void stop_workers(mrl_command_scheduler_obj_t* s, mgl_u32_t started_count)
+{
+	mrl_lock_mutex(&s->mutex);
+	s->quit = MGL_TRUE;
+	mrl_broadcast_condition(&s->start_cond);
+	mrl_unlock_mutex(&s->mutex);
+
+	for (mgl_u32_t i = 1; i < started_count; ++i)
+		mrl_join_thread(&s->workers[i].thread);
+}
+
+static void destroy_workers(mrl_command_scheduler_obj_t* s, mgl_u32_t count)
+{
+	for (mgl_u32_t i = 0; i < count; ++i)
+	{
+		mrl_destroy_command_buffer(s->workers[i].cb);
+		mrl_terminate_mutex(&s->workers[i].mutex);
+	}
+}
+
+MRL_API mrl_error_t mrl_create_command_scheduler(const mrl_command_scheduler_desc_t* desc, mrl_command_scheduler_t** out_s)
+{
+	MGL_DEBUG_ASSERT(desc != NULL && out_s != NULL);
+	MGL_DEBUG_ASSERT(desc->allocator != NULL && desc->max_job_count > 0);
+
+	mgl_u32_t thread_count = desc->thread_count;
+	if (thread_count == MRL_COMMAND_SCHEDULER_AUTO_THREAD_COUNT)
+		thread_count = mrl_get_hardware_thread_count() - 1;
+
+	// Allocate object
+	mrl_command_scheduler_obj_t* s;
+	mgl_error_t mglerr = mgl_allocate(desc->allocator, sizeof(*s), (void**)&s);
+	if (mglerr != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(mglerr);
+
+	s->allocator = desc->allocator;
+	s->worker_count = thread_count + 1;
+	s->max_job_count = desc->max_job_count;
+	s->job_count = 0;
+	s->generation = 0;
+	s->active_worker_count = 0;
+	s->quit = MGL_FALSE;
+
+	mglerr = mgl_allocate(s->allocator, sizeof(mrl_command_job_t) * s->max_job_count, (void**)&s->jobs);
+	if (mglerr != MGL_ERROR_NONE)
+	{
+		mgl_deallocate(s->allocator, s);
+		return mrl_make_mgl_error(mglerr);
+	}
+
+	mglerr = mgl_allocate(s->allocator, sizeof(mrl_command_worker_t) * s->worker_count, (void**)&s->workers);
+	if (mglerr != MGL_ERROR_NONE)
+	{
+		mgl_deallocate(s->allocator, s->jobs);
+		mgl_deallocate(s->allocator, s);
+		return mrl_make_mgl_error(mglerr);
+	}
+
+	// Create per-thread arenas
+	mrl_command_buffer_desc_t cb_desc = MRL_DEFAULT_COMMAND_BUFFER_DESC;
+	cb_desc.allocator = s->allocator;
+	cb_desc.chunk_size = desc->chunk_size;
+
+	mrl_error_t err = MRL_ERROR_NONE;
+	mgl_u32_t worker_i = 0;
+	for (; worker_i < s->worker_count; ++worker_i)
+	{
+		mrl_command_worker_t* w = &s->workers[worker_i];
+		w->s = s;
+		w->index = worker_i;
+		w->begin = 0;
+		w->end = 0;
+		err = mrl_create_command_buffer(&cb_desc, &w->cb);
+		if (err != MRL_ERROR_NONE)
+			break;
+		mrl_init_mutex(&w->mutex);
+	}
+
+	if (err != MRL_ERROR_NONE)
+	{
+		destroy_workers(s, worker_i);
+		mgl_deallocate(s->allocator, s->workers);
+		mgl_deallocate(s->allocator, s->jobs);
+		mgl_deallocate(s->allocator, s);
+		return err;
+	}
+
+	// Start worker threads
+	mrl_init_mutex(&s->mutex);
+	mrl_init_condition(&s->start_cond);
+	mrl_init_condition(&s->done_cond);
+
+	mgl_u32_t thread_i = 1;
+	for (; thread_i < s->worker_count; ++thread_i)
+	{
+		err = mrl_start_thread(&s->workers[thread_i].thread, &worker_main, &s->workers[thread_i]);
+		if (err != MRL_ERROR_NONE)
+			break;
+	}
+
+	if (err != MRL_ERROR_NONE)
+	{
+		stop_workers(s, thread_i);
+		mrl_terminate_condition(&s->done_cond);
+		mrl_terminate_condition(&s->start_cond);
+		mrl_terminate_mutex(&s->mutex);
+		destroy_workers(s, s->worker_count);
+		mgl_deallocate(s->allocator, s->workers);
+		mgl_deallocate(s->allocator, s->jobs);
+		mgl_deallocate(s->allocator, s);
+		return err;
+	}
+
+	*out_s = (mrl_command_scheduler_t*)s;
+
+	return MRL_ERROR_NONE;
+}
+
+MRL_API void mrl_destroy_command_scheduler(mrl_command_scheduler_t* cs)
+{
+	MGL_DEBUG_ASSERT(cs != NULL);
+	mrl_command_scheduler_obj_t* s = (mrl_command_scheduler_obj_t*)cs;
+
+	stop_workers(s, s->worker_count);
+	mrl_terminate_condition(&s->done_cond);
+	mrl_terminate_condition(&s->start_cond);
+	mrl_terminate_mutex(&s->mutex);
+	destroy_workers(s, s->worker_count);
+	mgl_deallocate(s->allocator, s->workers);
+	mgl_deallocate(s->allocator, s->jobs);
+	mgl_deallocate(s->allocator, s);
+}
+
+MRL_API mrl_error_t mrl_record_command_jobs(mrl_command_scheduler_t* cs, mgl_u64_t item_count, mgl_u64_t job_size, mrl_command_job_func_t func, void* user_data)
+{
+	MGL_DEBUG_ASSERT(cs != NULL && func != NULL && job_size > 0);
+	mrl_command_scheduler_obj_t* s = (mrl_command_scheduler_obj_t*)cs;
+
+	// Split the items into jobs, making them bigger if there would be too many
+	if ((item_count + job_size - 1) / job_size > s->max_job_count)
+		job_size = (item_count + s->max_job_count - 1) / s->max_job_count;
+
+	s->item_count = item_count;
+	s->job_size = job_size;
+	s->job_count = (item_count + job_size - 1) / job_size;
+	s->func = func;
+	s->user_data = user_data;
+
+	// Distribute the jobs evenly across the workers, in contiguous ranges
+	for (mgl_u32_t i = 0; i < s->worker_count; ++i)
+	{
+		mrl_command_worker_t* w = &s->workers[i];
+		mrl_reset_command_buffer(w->cb);
+		w->begin = s->job_count * i / s->worker_count;
+		w->end = s->job_count * (i + 1) / s->worker_count;
+	}
+
+	if (s->job_count == 0)
+		return MRL_ERROR_NONE;
+
+	// Wake up the workers and work on the jobs on this thread too
+	mrl_lock_mutex(&s->mutex);
+	s->active_worker_count = s->worker_count - 1;
+	s->generation += 1;
+	mrl_broadcast_condition(&s->start_cond);
+	mrl_unlock_mutex(&s->mutex);
+
+	run_jobs(&s->workers[0]);
+
+	// Wait for the other workers to finish
+	mrl_lock_mutex(&s->mutex);
+	while (s->active_worker_count > 0)
+		mrl_wait_condition(&s->done_cond, &s->mutex);
+	mrl_unlock_mutex(&s->mutex);
+
+	// Check for recording errors
+	for (mgl_u32_t i = 0; i < s->worker_count; ++i)
+	{
+		mrl_error_t err = mrl_get_command_buffer_error(s->workers[i].cb);
+		if (err != MRL_ERROR_NONE)
+		{
+			s->job_count = 0;
+			return err;
+		}
+	}
+
+	return MRL_ERROR_NONE;
+}
+
+MRL_API mrl_error_t mrl_submit_command_jobs(mrl_render_device_t* rd, mrl_command_scheduler_t* cs)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && cs != NULL);
+	mrl_command_scheduler_obj_t* s = (mrl_command_scheduler_obj_t*)cs;
+
+	// Merge the per-thread lists by executing the jobs in order
+	for (mgl_u64_t i = 0; i < s->job_count; ++i)
+		mrl_execute_command_buffer_range(rd, &s->jobs[i].begin, &s->jobs[i].end);
+
+	return MRL_ERROR_NONE;
+}
@@ -0,0 +1,135 @@
+#include <mrl/constant_allocator.h>
+
+#include <mgl/memory/allocator.h>
+
+typedef struct
+{
+	void* allocator;
+	mrl_constant_buffer_t* buffer;
+	mrl_stream_allocator_t* stream;
+	mgl_u64_t alignment;
+
+	// Block mapped for the current frame
+	mgl_u8_t* data;
+	mgl_u64_t offset;
+	mgl_u64_t size;
+	mgl_u64_t used;
+	mgl_bool_t frame_pending;
+} mrl_constant_allocator_obj_t;
+
+MRL_API mrl_error_t mrl_create_constant_allocator(mrl_render_device_t* rd, const mrl_constant_allocator_desc_t* desc, mrl_constant_allocator_t** ca)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && desc != NULL && ca != NULL);
+	MGL_DEBUG_ASSERT(desc->allocator != NULL && desc->size > 0);
+
+	// Allocate object
+	mrl_constant_allocator_obj_t* obj;
+	mgl_error_t mglerr = mgl_allocate(desc->allocator, sizeof(*obj), (void**)&obj);
+	if (mglerr != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(mglerr);
+
+	obj->allocator = desc->allocator;
+	obj->data = NULL;
+	obj->offset = 0;
+	obj->size = 0;
+	obj->used = 0;
+	obj->frame_pending = MGL_FALSE;
+
+	mgl_i64_t alignment = mrl_get_property_i(rd, MRL_PROPERTY_CONSTANT_BUFFER_OFFSET_ALIGNMENT);
+	obj->alignment = alignment > 0 ? (mgl_u64_t)alignment : 256;
+
+	// Create constant buffer
+	mrl_constant_buffer_desc_t cb_desc = MRL_DEFAULT_CONSTANT_BUFFER_DESC;
+	cb_desc.size = desc->size;
+	cb_desc.usage = MRL_CONSTANT_BUFFER_USAGE_STREAM;
+	mrl_error_t err = mrl_create_constant_buffer(rd, &obj->buffer, &cb_desc);
+	if (err != MRL_ERROR_NONE)
+	{
+		mgl_deallocate(obj->allocator, obj);
+		return err;
+	}
+
+	// Create stream allocator
+	mrl_stream_allocator_desc_t sa_desc = MRL_DEFAULT_STREAM_ALLOCATOR_DESC;
+	sa_desc.buffer_type = MRL_STREAM_ALLOCATOR_BUFFER_CONSTANT;
+	sa_desc.buffer = obj->buffer;
+	err = mrl_create_stream_allocator(rd, &obj->stream, &sa_desc);
+	if (err != MRL_ERROR_NONE)
+	{
+		mrl_destroy_constant_buffer(rd, obj->buffer);
+		mgl_deallocate(obj->allocator, obj);
+		return err;
+	}
+
+	*ca = (mrl_constant_allocator_t*)obj;
+
+	return MRL_ERROR_NONE;
+}
+
+MRL_API void mrl_destroy_constant_allocator(mrl_render_device_t* rd, mrl_constant_allocator_t* ca)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && ca != NULL);
+	mrl_constant_allocator_obj_t* obj = (mrl_constant_allocator_obj_t*)ca;
+
+	if (obj->data != NULL)
+		mrl_unmap_stream_allocation(rd, obj->stream);
+	mrl_destroy_stream_allocator(rd, obj->stream);
+	mrl_destroy_constant_buffer(rd, obj->buffer);
+	mgl_deallocate(obj->allocator, obj);
+}
+
+MRL_API mrl_error_t mrl_begin_constant_allocations(mrl_render_device_t* rd, mrl_constant_allocator_t* ca, mgl_u64_t size)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && ca != NULL && size > 0);
+	mrl_constant_allocator_obj_t* obj = (mrl_constant_allocator_obj_t*)ca;
+	MGL_DEBUG_ASSERT(obj->data == NULL);
+
+	// The draws of the previous frame were already issued, so its block can be fenced now
+	if (obj->frame_pending)
+		mrl_end_stream_allocator_frame(rd, obj->stream);
+
+	// Map the frame block
+	obj->data = (mgl_u8_t*)mrl_map_stream_allocation(rd, obj->stream, size, obj->alignment, &obj->offset);
+	if (obj->data == NULL)
+		return MRL_ERROR_EXTERNAL;
+
+	obj->size = size;
+	obj->used = 0;
+	obj->frame_pending = MGL_TRUE;
+
+	return MRL_ERROR_NONE;
+}
+
+MRL_API void* mrl_allocate_constants(mrl_constant_allocator_t* ca, mgl_u64_t size, mgl_u64_t* offset)
+{
+	MGL_DEBUG_ASSERT(ca != NULL && offset != NULL);
+	mrl_constant_allocator_obj_t* obj = (mrl_constant_allocator_obj_t*)ca;
+	MGL_DEBUG_ASSERT(obj->data != NULL);
+
+	// The block offset is aligned, so aligning the position inside the block is enough
+	mgl_u64_t begin = (obj->used + obj->alignment - 1) / obj->alignment * obj->alignment;
+	if (begin + size > obj->size)
+		return NULL;
+
+	obj->used = begin + size;
+	*offset = obj->offset + begin;
+	return obj->data + begin;
+}
+
+MRL_API void mrl_end_constant_allocations(mrl_render_device_t* rd, mrl_constant_allocator_t* ca)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && ca != NULL);
+	mrl_constant_allocator_obj_t* obj = (mrl_constant_allocator_obj_t*)ca;
+
+	if (obj->data == NULL)
+		return;
+
+	mrl_unmap_stream_allocation(rd, obj->stream);
+	obj->data = NULL;
+}
+
+MRL_API mrl_constant_buffer_t* mrl_get_constant_allocator_buffer(mrl_constant_allocator_t* ca)
+{
+	MGL_DEBUG_ASSERT(ca != NULL);
+	return ((mrl_constant_allocator_obj_t*)ca)->buffer;
+}
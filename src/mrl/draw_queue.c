@@ -0,0 +1,317 @@
+#include <mrl/draw_queue.h>
+
+#include <mgl/memory/allocator.h>
+#include <mgl/memory/manipulation.h>
+
+// Number of bindings whose state is remembered while submitting
+#define MRL_DRAW_QUEUE_MAX_TRACKED_BINDING_COUNT 32
+
+// Marks states which aren't known, since NULL is a valid state
+#define MRL_DRAW_QUEUE_UNKNOWN ((void*)-1)
+
+typedef struct
+{
+	mgl_u64_t key;
+	mgl_u64_t index;
+} mrl_draw_sort_entry_t;
+
+typedef struct
+{
+	void* allocator;
+	mrl_pipeline_state_cache_t* cache;
+
+	mrl_draw_packet_t* packets;
+	mgl_u64_t count;
+	mgl_u64_t capacity;
+
+	// Twice the packet capacity, since the radix sort ping-pongs between two halves
+	mrl_draw_sort_entry_t* entries;
+
+	// Bindings set by the last packets
+	mrl_draw_binding_t bound[MRL_DRAW_QUEUE_MAX_TRACKED_BINDING_COUNT];
+	mgl_u32_t bound_count;
+} mrl_draw_queue_obj_t;
+
+static mgl_error_t reserve_packets(mrl_draw_queue_obj_t* obj, mgl_u64_t required)
+{
+	if (required <= obj->capacity)
+		return MGL_ERROR_NONE;
+
+	mgl_u64_t capacity = obj->capacity * 2;
+	if (capacity < required)
+		capacity = required;
+
+	mrl_draw_packet_t* packets;
+	mgl_error_t err = mgl_allocate(obj->allocator, capacity * sizeof(mrl_draw_packet_t), (void**)&packets);
+	if (err != MGL_ERROR_NONE)
+		return err;
+
+	mrl_draw_sort_entry_t* entries;
+	err = mgl_allocate(obj->allocator, 2 * capacity * sizeof(mrl_draw_sort_entry_t), (void**)&entries);
+	if (err != MGL_ERROR_NONE)
+	{
+		mgl_deallocate(obj->allocator, packets);
+		return err;
+	}
+
+	// Only the packets need to be kept, the entries are filled on submit
+	if (obj->packets != NULL)
+	{
+		mgl_mem_copy(packets, obj->packets, obj->count * sizeof(mrl_draw_packet_t));
+		mgl_deallocate(obj->allocator, obj->packets);
+		mgl_deallocate(obj->allocator, obj->entries);
+	}
+
+	obj->packets = packets;
+	obj->entries = entries;
+	obj->capacity = capacity;
+
+	return MGL_ERROR_NONE;
+}
+
+// ---------- Sorting ----------
+
+// Stable LSD radix sort on the 64 bit keys, one byte per pass.
+// Returns the half of the entries array which holds the sorted entries.
+static mrl_draw_sort_entry_t* sort_entries(mrl_draw_sort_entry_t* src, mrl_draw_sort_entry_t* dst, mgl_u64_t count)
+{
+	// Count every byte of every key in a single pass
+	mgl_u64_t histograms[8][256];
+	mgl_mem_set(histograms, sizeof(histograms), 0);
+	for (mgl_u64_t i = 0; i < count; ++i)
+		for (mgl_u32_t b = 0; b < 8; ++b)
+			histograms[b][(src[i].key >> (8 * b)) & 0xFF] += 1;
+
+	for (mgl_u32_t b = 0; b < 8; ++b)
+	{
+		// Skip passes where every key has the same byte, which is common for the unused bits of a key
+		mgl_u64_t* histogram = histograms[b];
+		if (histogram[(src[0].key >> (8 * b)) & 0xFF] == count)
+			continue;
+
+		// Turn counts into offsets
+		mgl_u64_t offset = 0;
+		for (mgl_u32_t i = 0; i < 256; ++i)
+		{
+			mgl_u64_t bucket_count = histogram[i];
+			histogram[i] = offset;
+			offset += bucket_count;
+		}
+
+		for (mgl_u64_t i = 0; i < count; ++i)
+			dst[histogram[(src[i].key >> (8 * b)) & 0xFF]++] = src[i];
+
+		mrl_draw_sort_entry_t* tmp = src;
+		src = dst;
+		dst = tmp;
+	}
+
+	return src;
+}
+
+// ---------- Submission ----------
+
+static void bind(mrl_render_device_t* rd, mrl_draw_queue_obj_t* obj, const mrl_draw_binding_t* binding)
+{
+	// Samplers and textures share binding points, so they are tracked separately
+	mgl_bool_t sampler = binding->type == MRL_DRAW_BINDING_SAMPLER;
+	mrl_draw_binding_t* bound = NULL;
+	for (mgl_u32_t i = 0; i < obj->bound_count; ++i)
+		if (obj->bound[i].bp == binding->bp && (obj->bound[i].type == MRL_DRAW_BINDING_SAMPLER) == sampler)
+		{
+			bound = &obj->bound[i];
+			break;
+		}
+
+	if (bound != NULL)
+	{
+		if (bound->type == binding->type &&
+			bound->handle == binding->handle &&
+			(binding->type != MRL_DRAW_BINDING_CONSTANT_BUFFER_RANGE || (bound->offset == binding->offset && bound->size == binding->size)))
+			return;
+	}
+	else
+	{
+		// Forget the oldest bindings when there is no space left
+		if (obj->bound_count == MRL_DRAW_QUEUE_MAX_TRACKED_BINDING_COUNT)
+			obj->bound_count = 0;
+		bound = &obj->bound[obj->bound_count++];
+	}
+	*bound = *binding;
+
+	switch (binding->type)
+	{
+		case MRL_DRAW_BINDING_SAMPLER: mrl_bind_sampler(rd, binding->bp, binding->handle); break;
+		case MRL_DRAW_BINDING_TEXTURE_1D: mrl_bind_texture_1d(rd, binding->bp, binding->handle); break;
+		case MRL_DRAW_BINDING_TEXTURE_2D: mrl_bind_texture_2d(rd, binding->bp, binding->handle); break;
+		case MRL_DRAW_BINDING_TEXTURE_3D: mrl_bind_texture_3d(rd, binding->bp, binding->handle); break;
+		case MRL_DRAW_BINDING_CUBE_MAP: mrl_bind_cube_map(rd, binding->bp, binding->handle); break;
+		case MRL_DRAW_BINDING_CONSTANT_BUFFER: mrl_bind_constant_buffer(rd, binding->bp, binding->handle); break;
+		case MRL_DRAW_BINDING_CONSTANT_BUFFER_RANGE: mrl_bind_constant_buffer_range(rd, binding->bp, binding->handle, binding->offset, binding->size); break;
+		case MRL_DRAW_BINDING_TEXTURE_2D_ARRAY: mrl_bind_texture_2d_array(rd, binding->bp, binding->handle); break;
+		case MRL_DRAW_BINDING_CUBE_MAP_ARRAY: mrl_bind_cube_map_array(rd, binding->bp, binding->handle); break;
+		default: MGL_DEBUG_ASSERT(MGL_FALSE); break;
+	}
+}
+
+static void draw(mrl_render_device_t* rd, const mrl_draw_packet_t* packet)
+{
+	if (packet->index_buffer != NULL && packet->base_vertex != 0)
+	{
+		if (packet->instance_count > 1)
+			mrl_draw_triangles_indexed_instanced_base_vertex(rd, packet->offset, packet->count, packet->instance_count, packet->base_vertex);
+		else
+			mrl_draw_triangles_indexed_base_vertex(rd, packet->offset, packet->count, packet->base_vertex);
+	}
+	else if (packet->index_buffer != NULL)
+	{
+		if (packet->instance_count > 1)
+			mrl_draw_triangles_indexed_instanced(rd, packet->offset, packet->count, packet->instance_count);
+		else
+			mrl_draw_triangles_indexed(rd, packet->offset, packet->count);
+	}
+	else
+	{
+		if (packet->instance_count > 1)
+			mrl_draw_triangles_instanced(rd, packet->offset, packet->count, packet->instance_count);
+		else
+			mrl_draw_triangles(rd, packet->offset, packet->count);
+	}
+}
+
+// ---------- Draw queue ----------
+
+MRL_API mrl_error_t mrl_create_draw_queue(const mrl_draw_queue_desc_t* desc, mrl_draw_queue_t** dq)
+{
+	MGL_DEBUG_ASSERT(desc != NULL && dq != NULL);
+	MGL_DEBUG_ASSERT(desc->allocator != NULL && desc->pipeline_state_cache != NULL);
+
+	// Allocate object
+	mrl_draw_queue_obj_t* obj;
+	mgl_error_t mglerr = mgl_allocate(desc->allocator, sizeof(*obj), (void**)&obj);
+	if (mglerr != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(mglerr);
+
+	obj->allocator = desc->allocator;
+	obj->cache = desc->pipeline_state_cache;
+	obj->packets = NULL;
+	obj->entries = NULL;
+	obj->count = 0;
+	obj->capacity = 0;
+	obj->bound_count = 0;
+
+	// Allocate packets
+	mglerr = reserve_packets(obj, desc->packet_capacity);
+	if (mglerr != MGL_ERROR_NONE)
+	{
+		mgl_deallocate(obj->allocator, obj);
+		return mrl_make_mgl_error(mglerr);
+	}
+
+	*dq = (mrl_draw_queue_t*)obj;
+
+	return MRL_ERROR_NONE;
+}
+
+MRL_API void mrl_destroy_draw_queue(mrl_draw_queue_t* dq)
+{
+	MGL_DEBUG_ASSERT(dq != NULL);
+	mrl_draw_queue_obj_t* obj = (mrl_draw_queue_obj_t*)dq;
+
+	if (obj->packets != NULL)
+	{
+		mgl_deallocate(obj->allocator, obj->packets);
+		mgl_deallocate(obj->allocator, obj->entries);
+	}
+	mgl_deallocate(obj->allocator, obj);
+}
+
+MRL_API mrl_error_t mrl_push_draw_packet(mrl_draw_queue_t* dq, const mrl_draw_packet_t* packet)
+{
+	MGL_DEBUG_ASSERT(dq != NULL && packet != NULL);
+	MGL_DEBUG_ASSERT(packet->pso != NULL && packet->binding_count <= MRL_MAX_DRAW_PACKET_BINDING_COUNT);
+	mrl_draw_queue_obj_t* obj = (mrl_draw_queue_obj_t*)dq;
+
+	mgl_error_t mglerr = reserve_packets(obj, obj->count + 1);
+	if (mglerr != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(mglerr);
+
+	obj->packets[obj->count++] = *packet;
+
+	return MRL_ERROR_NONE;
+}
+
+MRL_API mrl_error_t mrl_submit_draw_queue(mrl_render_device_t* rd, mrl_draw_queue_t* dq)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && dq != NULL);
+	mrl_draw_queue_obj_t* obj = (mrl_draw_queue_obj_t*)dq;
+
+	if (obj->count == 0)
+		return MRL_ERROR_NONE;
+
+	// Sort packets
+	for (mgl_u64_t i = 0; i < obj->count; ++i)
+	{
+		obj->entries[i].key = obj->packets[i].sort_key;
+		obj->entries[i].index = i;
+	}
+	const mrl_draw_sort_entry_t* sorted = sort_entries(obj->entries, obj->entries + obj->capacity, obj->count);
+
+	// Draw packets, skipping the state which didn't change since the previous packet
+	mrl_pipeline_state_t* pso = NULL;
+	mrl_shader_pipeline_t* pipeline = NULL;
+	mrl_vertex_array_t* va = MRL_DRAW_QUEUE_UNKNOWN;
+	mrl_index_buffer_t* ib = MRL_DRAW_QUEUE_UNKNOWN;
+	obj->bound_count = 0;
+
+	for (mgl_u64_t i = 0; i < obj->count; ++i)
+	{
+		const mrl_draw_packet_t* packet = &obj->packets[sorted[i].index];
+
+		if (packet->pso != pso)
+		{
+			pso = packet->pso;
+			mrl_set_pipeline_state(rd, obj->cache, pso);
+
+			// Binding points belong to shader pipelines, and different pipelines may share the same texture units
+			mrl_shader_pipeline_t* new_pipeline = mrl_get_pipeline_state_shader_pipeline(pso);
+			if (new_pipeline != pipeline)
+			{
+				pipeline = new_pipeline;
+				obj->bound_count = 0;
+			}
+
+			// The pipeline state may have set its own vertex array, and the index buffer binding belongs to the vertex array
+			va = MRL_DRAW_QUEUE_UNKNOWN;
+			ib = MRL_DRAW_QUEUE_UNKNOWN;
+		}
+
+		if (packet->vertex_array != NULL && packet->vertex_array != va)
+		{
+			va = packet->vertex_array;
+			mrl_set_vertex_array(rd, va);
+			ib = MRL_DRAW_QUEUE_UNKNOWN;
+		}
+
+		if (packet->index_buffer != NULL && packet->index_buffer != ib)
+		{
+			ib = packet->index_buffer;
+			mrl_set_index_buffer(rd, ib);
+		}
+
+		for (mgl_u32_t j = 0; j < packet->binding_count; ++j)
+			bind(rd, obj, &packet->bindings[j]);
+
+		draw(rd, packet);
+	}
+
+	obj->count = 0;
+
+	return MRL_ERROR_NONE;
+}
+
+MRL_API void mrl_clear_draw_queue(mrl_draw_queue_t* dq)
+{
+	MGL_DEBUG_ASSERT(dq != NULL);
+	((mrl_draw_queue_obj_t*)dq)->count = 0;
+}
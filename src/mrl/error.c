@@ -34,6 +34,7 @@ MRL_API const mgl_chr8_t * mrl_get_error_string(mrl_error_t err)
 		case MRL_ERROR_INVALID_PARAMS: return u8"MRL_ERROR_INVALID_PARAMS: Invalid params";
 		case MRL_ERROR_VERTEX_ELEMENT_NOT_FOUND: return u8"MRL_ERROR_VERTEX_ELEMENT_NOT_FOUND: Vertex element not found";
 		case MRL_ERROR_BINDING_POINT_NOT_FOUND: return u8"MRL_ERROR_BINDING_POINT_NOT_FOUND: Binding point not found";
+		case MRL_ERROR_MESH_HEAP_FULL: return u8"MRL_ERROR_MESH_HEAP_FULL: Not enough contiguous space left on the mesh heap";
 		default: return u8"???: Unknown error";
 	}
 	return NULL;
@@ -0,0 +1,303 @@
+#include <mrl/mesh_heap.h>
+
+#include <mgl/memory/allocator.h>
+
+typedef struct
+{
+	mgl_u64_t offset;
+	mgl_u64_t size;
+} mrl_mesh_heap_range_t;
+
+// Free ranges, sorted by offset and never adjacent to each other
+typedef struct
+{
+	mrl_mesh_heap_range_t* ranges;
+	mgl_u64_t count;
+	mgl_u64_t capacity;
+} mrl_mesh_heap_free_list_t;
+
+typedef struct
+{
+	void* allocator;
+	mrl_vertex_buffer_t* vb;
+	mrl_index_buffer_t* ib;
+	mrl_vertex_array_t* va;
+	mgl_u64_t vertex_size;
+	mgl_u64_t index_size;
+	mgl_u64_t mesh_count;
+	mgl_u64_t max_mesh_count;
+
+	mrl_mesh_heap_free_list_t vertices;
+	mrl_mesh_heap_free_list_t indices;
+} mrl_mesh_heap_obj_t;
+
+// ---------- Free lists ----------
+
+static mgl_error_t init_free_list(void* allocator, mrl_mesh_heap_free_list_t* list, mgl_u64_t size, mgl_u64_t max_mesh_count)
+{
+	// Every allocation splits at most one free range in two, so there can't be more free ranges than allocations plus one
+	list->capacity = max_mesh_count + 1;
+	mgl_error_t err = mgl_allocate(allocator, list->capacity * sizeof(mrl_mesh_heap_range_t), (void**)&list->ranges);
+	if (err != MGL_ERROR_NONE)
+		return err;
+
+	list->ranges[0].offset = 0;
+	list->ranges[0].size = size;
+	list->count = size > 0 ? 1 : 0;
+	return MGL_ERROR_NONE;
+}
+
+// First fit, which keeps the start of the buffers packed
+static mgl_bool_t allocate_range(mrl_mesh_heap_free_list_t* list, mgl_u64_t size, mgl_u64_t* offset)
+{
+	if (size == 0)
+	{
+		*offset = 0;
+		return MGL_TRUE;
+	}
+
+	for (mgl_u64_t i = 0; i < list->count; ++i)
+	{
+		mrl_mesh_heap_range_t* range = &list->ranges[i];
+		if (range->size < size)
+			continue;
+
+		*offset = range->offset;
+		range->offset += size;
+		range->size -= size;
+
+		// Remove the range if it was used up
+		if (range->size == 0)
+		{
+			for (mgl_u64_t j = i + 1; j < list->count; ++j)
+				list->ranges[j - 1] = list->ranges[j];
+			list->count -= 1;
+		}
+
+		return MGL_TRUE;
+	}
+
+	return MGL_FALSE;
+}
+
+static void free_range(mrl_mesh_heap_free_list_t* list, mgl_u64_t offset, mgl_u64_t size)
+{
+	if (size == 0)
+		return;
+
+	// Find the first free range after the freed one
+	mgl_u64_t i = 0;
+	while (i < list->count && list->ranges[i].offset < offset)
+		++i;
+
+	mgl_bool_t merge_prev = i > 0 && list->ranges[i - 1].offset + list->ranges[i - 1].size == offset;
+	mgl_bool_t merge_next = i < list->count && offset + size == list->ranges[i].offset;
+
+	if (merge_prev && merge_next)
+	{
+		list->ranges[i - 1].size += size + list->ranges[i].size;
+		for (mgl_u64_t j = i + 1; j < list->count; ++j)
+			list->ranges[j - 1] = list->ranges[j];
+		list->count -= 1;
+	}
+	else if (merge_prev)
+		list->ranges[i - 1].size += size;
+	else if (merge_next)
+	{
+		list->ranges[i].offset = offset;
+		list->ranges[i].size += size;
+	}
+	else
+	{
+		MGL_DEBUG_ASSERT(list->count < list->capacity);
+		for (mgl_u64_t j = list->count; j > i; --j)
+			list->ranges[j] = list->ranges[j - 1];
+		list->ranges[i].offset = offset;
+		list->ranges[i].size = size;
+		list->count += 1;
+	}
+}
+
+// ---------- Mesh heap ----------
+
+// Deallocates the free lists and the object itself
+static void destroy_free_lists(mrl_mesh_heap_obj_t* obj)
+{
+	mgl_deallocate(obj->allocator, obj->indices.ranges);
+	mgl_deallocate(obj->allocator, obj->vertices.ranges);
+	mgl_deallocate(obj->allocator, obj);
+}
+
+MRL_API mrl_error_t mrl_create_mesh_heap(mrl_render_device_t* rd, const mrl_mesh_heap_desc_t* desc, mrl_mesh_heap_t** heap)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && desc != NULL && heap != NULL);
+	MGL_DEBUG_ASSERT(desc->allocator != NULL && desc->vertex_size > 0 && desc->max_mesh_count > 0);
+	MGL_DEBUG_ASSERT(desc->index_format == MRL_INDEX_BUFFER_FORMAT_U16 || desc->index_format == MRL_INDEX_BUFFER_FORMAT_U32);
+
+	// Allocate object
+	mrl_mesh_heap_obj_t* obj;
+	mgl_error_t mglerr = mgl_allocate(desc->allocator, sizeof(*obj), (void**)&obj);
+	if (mglerr != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(mglerr);
+
+	obj->allocator = desc->allocator;
+	obj->vertex_size = desc->vertex_size;
+	obj->index_size = desc->index_format == MRL_INDEX_BUFFER_FORMAT_U16 ? 2 : 4;
+	obj->mesh_count = 0;
+	obj->max_mesh_count = desc->max_mesh_count;
+
+	// Allocate free lists
+	mglerr = init_free_list(obj->allocator, &obj->vertices, desc->vertex_capacity, desc->max_mesh_count);
+	if (mglerr != MGL_ERROR_NONE)
+	{
+		mgl_deallocate(obj->allocator, obj);
+		return mrl_make_mgl_error(mglerr);
+	}
+
+	mglerr = init_free_list(obj->allocator, &obj->indices, desc->index_capacity, desc->max_mesh_count);
+	if (mglerr != MGL_ERROR_NONE)
+	{
+		mgl_deallocate(obj->allocator, obj->vertices.ranges);
+		mgl_deallocate(obj->allocator, obj);
+		return mrl_make_mgl_error(mglerr);
+	}
+
+	// Create vertex buffer
+	mrl_vertex_buffer_desc_t vb_desc = MRL_DEFAULT_VERTEX_BUFFER_DESC;
+	vb_desc.size = desc->vertex_capacity * desc->vertex_size;
+	vb_desc.usage = MRL_VERTEX_BUFFER_USAGE_DEFAULT;
+	mrl_error_t err = mrl_create_vertex_buffer(rd, &obj->vb, &vb_desc);
+	if (err != MRL_ERROR_NONE)
+	{
+		destroy_free_lists(obj);
+		return err;
+	}
+
+	// Create index buffer
+	mrl_index_buffer_desc_t ib_desc = MRL_DEFAULT_INDEX_BUFFER_DESC;
+	ib_desc.size = desc->index_capacity * obj->index_size;
+	ib_desc.usage = MRL_INDEX_BUFFER_USAGE_DEFAULT;
+	ib_desc.format = desc->index_format;
+	err = mrl_create_index_buffer(rd, &obj->ib, &ib_desc);
+	if (err != MRL_ERROR_NONE)
+	{
+		mrl_destroy_vertex_buffer(rd, obj->vb);
+		destroy_free_lists(obj);
+		return err;
+	}
+
+	// Create vertex array, with every element reading from the heap vertex buffer
+	mrl_vertex_array_desc_t va_desc = desc->vertex_array;
+	va_desc.buffer_count = 1;
+	va_desc.buffers[0] = obj->vb;
+	for (mgl_u32_t i = 0; i < va_desc.element_count; ++i)
+	{
+		va_desc.elements[i].buffer.index = 0;
+		if (va_desc.elements[i].buffer.stride == 0)
+			va_desc.elements[i].buffer.stride = desc->vertex_size;
+	}
+	err = mrl_create_vertex_array(rd, &obj->va, &va_desc);
+	if (err != MRL_ERROR_NONE)
+	{
+		mrl_destroy_index_buffer(rd, obj->ib);
+		mrl_destroy_vertex_buffer(rd, obj->vb);
+		destroy_free_lists(obj);
+		return err;
+	}
+
+	*heap = (mrl_mesh_heap_t*)obj;
+
+	return MRL_ERROR_NONE;
+}
+
+MRL_API void mrl_destroy_mesh_heap(mrl_render_device_t* rd, mrl_mesh_heap_t* heap)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && heap != NULL);
+	mrl_mesh_heap_obj_t* obj = (mrl_mesh_heap_obj_t*)heap;
+
+	mrl_destroy_vertex_array(rd, obj->va);
+	mrl_destroy_index_buffer(rd, obj->ib);
+	mrl_destroy_vertex_buffer(rd, obj->vb);
+	destroy_free_lists(obj);
+}
+
+MRL_API mrl_error_t mrl_allocate_mesh(mrl_render_device_t* rd, mrl_mesh_heap_t* heap, mgl_u64_t vertex_count, const void* vertices, mgl_u64_t index_count, const void* indices, mrl_mesh_t* mesh)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && heap != NULL && mesh != NULL);
+	mrl_mesh_heap_obj_t* obj = (mrl_mesh_heap_obj_t*)heap;
+
+	// The free lists are sized for the maximum mesh count
+	if (obj->mesh_count == obj->max_mesh_count)
+		return MRL_ERROR_MESH_HEAP_FULL;
+
+	mgl_u64_t first_vertex, first_index;
+	if (!allocate_range(&obj->vertices, vertex_count, &first_vertex))
+		return MRL_ERROR_MESH_HEAP_FULL;
+	if (!allocate_range(&obj->indices, index_count, &first_index))
+	{
+		free_range(&obj->vertices, first_vertex, vertex_count);
+		return MRL_ERROR_MESH_HEAP_FULL;
+	}
+
+	mesh->base_vertex = (mgl_i64_t)first_vertex;
+	mesh->vertex_count = vertex_count;
+	mesh->index_offset = first_index * obj->index_size;
+	mesh->index_count = index_count;
+	obj->mesh_count += 1;
+
+	mrl_update_mesh(rd, heap, mesh, vertices, indices);
+
+	return MRL_ERROR_NONE;
+}
+
+MRL_API void mrl_free_mesh(mrl_mesh_heap_t* heap, const mrl_mesh_t* mesh)
+{
+	MGL_DEBUG_ASSERT(heap != NULL && mesh != NULL);
+	mrl_mesh_heap_obj_t* obj = (mrl_mesh_heap_obj_t*)heap;
+
+	free_range(&obj->vertices, (mgl_u64_t)mesh->base_vertex, mesh->vertex_count);
+	free_range(&obj->indices, mesh->index_offset / obj->index_size, mesh->index_count);
+	obj->mesh_count -= 1;
+}
+
+MRL_API void mrl_update_mesh(mrl_render_device_t* rd, mrl_mesh_heap_t* heap, const mrl_mesh_t* mesh, const void* vertices, const void* indices)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && heap != NULL && mesh != NULL);
+	mrl_mesh_heap_obj_t* obj = (mrl_mesh_heap_obj_t*)heap;
+
+	if (vertices != NULL && mesh->vertex_count > 0)
+		mrl_update_vertex_buffer(rd, obj->vb, (mgl_u64_t)mesh->base_vertex * obj->vertex_size, mesh->vertex_count * obj->vertex_size, vertices);
+	if (indices != NULL && mesh->index_count > 0)
+		mrl_update_index_buffer(rd, obj->ib, mesh->index_offset, mesh->index_count * obj->index_size, indices);
+}
+
+MRL_API void mrl_set_mesh_heap(mrl_render_device_t* rd, mrl_mesh_heap_t* heap)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && heap != NULL);
+	mrl_mesh_heap_obj_t* obj = (mrl_mesh_heap_obj_t*)heap;
+
+	mrl_set_vertex_array(rd, obj->va);
+	mrl_set_index_buffer(rd, obj->ib);
+}
+
+MRL_API void mrl_draw_mesh(mrl_render_device_t* rd, const mrl_mesh_t* mesh, mgl_u64_t instance_count)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && mesh != NULL);
+
+	if (instance_count > 1)
+		mrl_draw_triangles_indexed_instanced_base_vertex(rd, mesh->index_offset, mesh->index_count, instance_count, mesh->base_vertex);
+	else
+		mrl_draw_triangles_indexed_base_vertex(rd, mesh->index_offset, mesh->index_count, mesh->base_vertex);
+}
+
+MRL_API mrl_vertex_array_t* mrl_get_mesh_heap_vertex_array(mrl_mesh_heap_t* heap)
+{
+	MGL_DEBUG_ASSERT(heap != NULL);
+	return ((mrl_mesh_heap_obj_t*)heap)->va;
+}
+
+MRL_API mrl_index_buffer_t* mrl_get_mesh_heap_index_buffer(mrl_mesh_heap_t* heap)
+{
+	MGL_DEBUG_ASSERT(heap != NULL);
+	return ((mrl_mesh_heap_obj_t*)heap)->ib;
+}
@@ -0,0 +1,1518 @@
+#include <mrl/null_render_device.h>
+#include <mrl/object_pool.h>
+
+#include <mgl/memory/allocator.h>
+#include <mgl/memory/manipulation.h>
+#include <mgl/string/manipulation.h>
+
+#define MRL_NULL_OBJECT_POOL_COUNT 20
+#define MRL_NULL_MAX_COMMAND_SIZE 128
+
+// Mimics the alignment of most GPUs, so that applications take the same code paths
+#define MRL_NULL_CONSTANT_BUFFER_OFFSET_ALIGNMENT 256
+
+// Every object starts with its ID
+typedef struct
+{
+	mgl_u32_t id;
+} mrl_null_object_t;
+
+typedef struct
+{
+	mgl_u32_t id;
+	mgl_u8_t* data;
+	mgl_u64_t size;
+} mrl_null_buffer_t;
+
+typedef struct
+{
+	mgl_u32_t id;
+	mrl_null_buffer_t* buffer;
+	mgl_u64_t head;
+} mrl_null_stream_allocator_t;
+
+typedef struct
+{
+	mgl_u32_t id;
+	mgl_u64_t last_token;
+} mrl_null_upload_queue_t;
+
+typedef struct mrl_null_binding_point_t mrl_null_binding_point_t;
+
+struct mrl_null_binding_point_t
+{
+	mgl_u64_t id;
+	mrl_null_binding_point_t* next;
+};
+
+typedef struct
+{
+	mgl_u32_t id;
+
+	// Binding points queried so far, allocated from the binding point pool
+	mrl_null_binding_point_t* bps;
+} mrl_null_shader_pipeline_t;
+
+typedef struct
+{
+	mrl_render_device_t base;
+
+	void* allocator;
+	mgl_u32_t next_id;
+
+	struct
+	{
+		mrl_object_pool_t framebuffer;
+		mrl_object_pool_t raster_state;
+		mrl_object_pool_t depth_stencil_state;
+		mrl_object_pool_t blend_state;
+		mrl_object_pool_t sampler;
+		mrl_object_pool_t texture_1d;
+		mrl_object_pool_t texture_2d;
+		mrl_object_pool_t texture_3d;
+		mrl_object_pool_t cube_map;
+		mrl_object_pool_t constant_buffer;
+		mrl_object_pool_t index_buffer;
+		mrl_object_pool_t vertex_buffer;
+		mrl_object_pool_t vertex_array;
+		mrl_object_pool_t shader_stage;
+		mrl_object_pool_t shader_pipeline;
+		mrl_object_pool_t stream_allocator;
+		mrl_object_pool_t indirect_buffer;
+		mrl_object_pool_t upload_queue;
+		mrl_object_pool_t texture_2d_array;
+		mrl_object_pool_t cube_map_array;
+
+		// Binding points belong to their pipelines, so they aren't indexed by object type
+		mrl_object_pool_t binding_point;
+	} memory;
+
+	// Recorded command stream
+	struct
+	{
+		mgl_bool_t enabled;
+		mgl_u8_t* data;
+		mgl_u64_t size;
+		mgl_u64_t capacity;
+	} recording;
+
+	mrl_render_device_hint_error_callback_t error_callback;
+	mrl_render_device_hint_error_callback_t warning_callback;
+} mrl_null_render_device_t;
+
+// ---------- Recording ----------
+
+static mgl_u8_t* begin_command(mrl_null_render_device_t* rd, mgl_u8_t opcode)
+{
+	if (!rd->recording.enabled)
+		return NULL;
+
+	// Grow the stream so that the largest command fits
+	if (rd->recording.size + MRL_NULL_MAX_COMMAND_SIZE > rd->recording.capacity)
+	{
+		mgl_u64_t capacity = rd->recording.capacity * 2;
+		if (capacity < rd->recording.size + MRL_NULL_MAX_COMMAND_SIZE)
+			capacity = rd->recording.size + MRL_NULL_MAX_COMMAND_SIZE;
+
+		mgl_u8_t* data;
+		mgl_error_t err = mgl_allocate(rd->allocator, capacity, (void**)&data);
+		if (err != MGL_ERROR_NONE)
+		{
+			if (rd->error_callback != NULL)
+				rd->error_callback(mrl_make_mgl_error(err), u8"Failed to record command: failed to grow the command stream");
+			return NULL;
+		}
+
+		if (rd->recording.data != NULL)
+		{
+			mgl_mem_copy(data, rd->recording.data, rd->recording.size);
+			mgl_deallocate(rd->allocator, rd->recording.data);
+		}
+
+		rd->recording.data = data;
+		rd->recording.capacity = capacity;
+	}
+
+	mgl_u8_t* cmd = rd->recording.data + rd->recording.size;
+	*(cmd++) = opcode;
+	return cmd;
+}
+
+static void end_command(mrl_null_render_device_t* rd, mgl_u8_t* cmd)
+{
+	rd->recording.size = (mgl_u64_t)(cmd - rd->recording.data);
+}
+
+static mgl_u8_t* write_uint(mgl_u8_t* cmd, mgl_u64_t v)
+{
+	// Unsigned LEB128
+	while (v >= 0x80)
+	{
+		*(cmd++) = (mgl_u8_t)(v | 0x80);
+		v >>= 7;
+	}
+	*(cmd++) = (mgl_u8_t)v;
+	return cmd;
+}
+
+static mgl_u8_t* write_int(mgl_u8_t* cmd, mgl_i64_t v)
+{
+	// Zigzag encoding, so that small negative numbers stay small
+	return write_uint(cmd, ((mgl_u64_t)v << 1) ^ (mgl_u64_t)(v >> 63));
+}
+
+static mgl_u8_t* write_float(mgl_u8_t* cmd, mgl_f32_t v)
+{
+	mgl_u32_t bits;
+	mgl_mem_copy(&bits, &v, sizeof(bits));
+	cmd[0] = (mgl_u8_t)bits;
+	cmd[1] = (mgl_u8_t)(bits >> 8);
+	cmd[2] = (mgl_u8_t)(bits >> 16);
+	cmd[3] = (mgl_u8_t)(bits >> 24);
+	return cmd + 4;
+}
+
+static void record_0(mrl_null_render_device_t* rd, mgl_u8_t opcode)
+{
+	mgl_u8_t* cmd = begin_command(rd, opcode);
+	if (cmd != NULL)
+		end_command(rd, cmd);
+}
+
+static void record_1(mrl_null_render_device_t* rd, mgl_u8_t opcode, mgl_u64_t a)
+{
+	mgl_u8_t* cmd = begin_command(rd, opcode);
+	if (cmd != NULL)
+		end_command(rd, write_uint(cmd, a));
+}
+
+static void record_2(mrl_null_render_device_t* rd, mgl_u8_t opcode, mgl_u64_t a, mgl_u64_t b)
+{
+	mgl_u8_t* cmd = begin_command(rd, opcode);
+	if (cmd != NULL)
+		end_command(rd, write_uint(write_uint(cmd, a), b));
+}
+
+static void record_3(mrl_null_render_device_t* rd, mgl_u8_t opcode, mgl_u64_t a, mgl_u64_t b, mgl_u64_t c)
+{
+	mgl_u8_t* cmd = begin_command(rd, opcode);
+	if (cmd != NULL)
+		end_command(rd, write_uint(write_uint(write_uint(cmd, a), b), c));
+}
+
+static void record_4(mrl_null_render_device_t* rd, mgl_u8_t opcode, mgl_u64_t a, mgl_u64_t b, mgl_u64_t c, mgl_u64_t d)
+{
+	mgl_u8_t* cmd = begin_command(rd, opcode);
+	if (cmd != NULL)
+		end_command(rd, write_uint(write_uint(write_uint(write_uint(cmd, a), b), c), d));
+}
+
+static mgl_u64_t get_id(const void* obj)
+{
+	return obj == NULL ? 0 : ((const mrl_null_object_t*)obj)->id;
+}
+
+static mgl_u64_t get_bp_id(const void* bp)
+{
+	return bp == NULL ? 0 : ((const mrl_null_binding_point_t*)bp)->id;
+}
+
+// ---------- Objects ----------
+
+static mrl_error_t create_object(mrl_null_render_device_t* rd, mrl_object_pool_t* pool, mgl_u8_t opcode, void** out)
+{
+	// Allocate object
+	mrl_null_object_t* obj;
+	mgl_error_t err = mrl_allocate_object(pool, (void**)&obj);
+	if (err != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(err);
+
+	obj->id = rd->next_id++;
+	record_1(rd, opcode, obj->id);
+	*out = obj;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_object(mrl_null_render_device_t* rd, mrl_object_pool_t* pool, mgl_u8_t opcode, void* obj)
+{
+	record_1(rd, opcode, get_id(obj));
+
+	// Deallocate object
+	mrl_deallocate_object(pool, obj);
+}
+
+// ---------- Framebuffers ----------
+
+static mrl_error_t create_framebuffer(mrl_render_device_t* brd, mrl_framebuffer_t** fb, const mrl_framebuffer_desc_t* desc)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	return create_object(rd, &rd->memory.framebuffer, MRL_NULL_COMMAND_CREATE_FRAMEBUFFER, (void**)fb);
+}
+
+static void destroy_framebuffer(mrl_render_device_t* brd, mrl_framebuffer_t* fb)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	destroy_object(rd, &rd->memory.framebuffer, MRL_NULL_COMMAND_DESTROY_FRAMEBUFFER, fb);
+}
+
+static void set_framebuffer(mrl_render_device_t* brd, mrl_framebuffer_t* fb)
+{
+	record_1((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_SET_FRAMEBUFFER, get_id(fb));
+}
+
+// ---------- Raster states ----------
+
+static mrl_error_t create_raster_state(mrl_render_device_t* brd, mrl_raster_state_t** rs, const mrl_raster_state_desc_t* desc)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	return create_object(rd, &rd->memory.raster_state, MRL_NULL_COMMAND_CREATE_RASTER_STATE, (void**)rs);
+}
+
+static void destroy_raster_state(mrl_render_device_t* brd, mrl_raster_state_t* rs)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	destroy_object(rd, &rd->memory.raster_state, MRL_NULL_COMMAND_DESTROY_RASTER_STATE, rs);
+}
+
+static void set_raster_state(mrl_render_device_t* brd, mrl_raster_state_t* rs)
+{
+	record_1((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_SET_RASTER_STATE, get_id(rs));
+}
+
+// ---------- Depth stencil states ----------
+
+static mrl_error_t create_depth_stencil_state(mrl_render_device_t* brd, mrl_depth_stencil_state_t** dss, const mrl_depth_stencil_state_desc_t* desc)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	return create_object(rd, &rd->memory.depth_stencil_state, MRL_NULL_COMMAND_CREATE_DEPTH_STENCIL_STATE, (void**)dss);
+}
+
+static void destroy_depth_stencil_state(mrl_render_device_t* brd, mrl_depth_stencil_state_t* dss)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	destroy_object(rd, &rd->memory.depth_stencil_state, MRL_NULL_COMMAND_DESTROY_DEPTH_STENCIL_STATE, dss);
+}
+
+static void set_depth_stencil_state(mrl_render_device_t* brd, mrl_depth_stencil_state_t* dss)
+{
+	record_1((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_SET_DEPTH_STENCIL_STATE, get_id(dss));
+}
+
+// ---------- Blend states ----------
+
+static mrl_error_t create_blend_state(mrl_render_device_t* brd, mrl_blend_state_t** bs, const mrl_blend_state_desc_t* desc)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	return create_object(rd, &rd->memory.blend_state, MRL_NULL_COMMAND_CREATE_BLEND_STATE, (void**)bs);
+}
+
+static void destroy_blend_state(mrl_render_device_t* brd, mrl_blend_state_t* bs)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	destroy_object(rd, &rd->memory.blend_state, MRL_NULL_COMMAND_DESTROY_BLEND_STATE, bs);
+}
+
+static void set_blend_state(mrl_render_device_t* brd, mrl_blend_state_t* bs)
+{
+	record_1((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_SET_BLEND_STATE, get_id(bs));
+}
+
+// ---------- Samplers ----------
+
+static mrl_error_t create_sampler(mrl_render_device_t* brd, mrl_sampler_t** s, const mrl_sampler_desc_t* desc)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	return create_object(rd, &rd->memory.sampler, MRL_NULL_COMMAND_CREATE_SAMPLER, (void**)s);
+}
+
+static void destroy_sampler(mrl_render_device_t* brd, mrl_sampler_t* s)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	destroy_object(rd, &rd->memory.sampler, MRL_NULL_COMMAND_DESTROY_SAMPLER, s);
+}
+
+static void bind_sampler(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_sampler_t* s)
+{
+	record_2((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_BIND_SAMPLER, get_bp_id(bp), get_id(s));
+}
+
+// ---------- 1D Textures ----------
+
+static mrl_error_t create_texture_1d(mrl_render_device_t* brd, mrl_texture_1d_t** tex, const mrl_texture_1d_desc_t* desc)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	return create_object(rd, &rd->memory.texture_1d, MRL_NULL_COMMAND_CREATE_TEXTURE_1D, (void**)tex);
+}
+
+static void destroy_texture_1d(mrl_render_device_t* brd, mrl_texture_1d_t* tex)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	destroy_object(rd, &rd->memory.texture_1d, MRL_NULL_COMMAND_DESTROY_TEXTURE_1D, tex);
+}
+
+static void generate_texture_1d_mipmaps(mrl_render_device_t* brd, mrl_texture_1d_t* tex)
+{
+	record_1((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_GENERATE_TEXTURE_1D_MIPMAPS, get_id(tex));
+}
+
+static void bind_texture_1d(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_texture_1d_t* tex)
+{
+	record_2((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_BIND_TEXTURE_1D, get_bp_id(bp), get_id(tex));
+}
+
+static mrl_error_t update_texture_1d(mrl_render_device_t* brd, mrl_texture_1d_t* tex, const mrl_texture_1d_update_desc_t* desc)
+{
+	record_4((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_UPDATE_TEXTURE_1D, get_id(tex), desc->width, desc->dst_x, desc->mip_level);
+	return MRL_ERROR_NONE;
+}
+
+// ---------- 2D Textures ----------
+
+static mrl_error_t create_texture_2d(mrl_render_device_t* brd, mrl_texture_2d_t** tex, const mrl_texture_2d_desc_t* desc)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	return create_object(rd, &rd->memory.texture_2d, MRL_NULL_COMMAND_CREATE_TEXTURE_2D, (void**)tex);
+}
+
+static void destroy_texture_2d(mrl_render_device_t* brd, mrl_texture_2d_t* tex)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	destroy_object(rd, &rd->memory.texture_2d, MRL_NULL_COMMAND_DESTROY_TEXTURE_2D, tex);
+}
+
+static void generate_texture_2d_mipmaps(mrl_render_device_t* brd, mrl_texture_2d_t* tex)
+{
+	record_1((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_GENERATE_TEXTURE_2D_MIPMAPS, get_id(tex));
+}
+
+static void bind_texture_2d(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_texture_2d_t* tex)
+{
+	record_2((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_BIND_TEXTURE_2D, get_bp_id(bp), get_id(tex));
+}
+
+static mrl_error_t update_texture_2d(mrl_render_device_t* brd, mrl_texture_2d_t* tex, const mrl_texture_2d_update_desc_t* desc)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	mgl_u8_t* cmd = begin_command(rd, MRL_NULL_COMMAND_UPDATE_TEXTURE_2D);
+	if (cmd != NULL)
+	{
+		cmd = write_uint(cmd, get_id(tex));
+		cmd = write_uint(cmd, desc->width);
+		cmd = write_uint(cmd, desc->height);
+		cmd = write_uint(cmd, desc->dst_x);
+		cmd = write_uint(cmd, desc->dst_y);
+		cmd = write_uint(cmd, desc->mip_level);
+		end_command(rd, cmd);
+	}
+	return MRL_ERROR_NONE;
+}
+
+// ---------- 3D Textures ----------
+
+static mrl_error_t create_texture_3d(mrl_render_device_t* brd, mrl_texture_3d_t** tex, const mrl_texture_3d_desc_t* desc)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	return create_object(rd, &rd->memory.texture_3d, MRL_NULL_COMMAND_CREATE_TEXTURE_3D, (void**)tex);
+}
+
+static void destroy_texture_3d(mrl_render_device_t* brd, mrl_texture_3d_t* tex)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	destroy_object(rd, &rd->memory.texture_3d, MRL_NULL_COMMAND_DESTROY_TEXTURE_3D, tex);
+}
+
+static void generate_texture_3d_mipmaps(mrl_render_device_t* brd, mrl_texture_3d_t* tex)
+{
+	record_1((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_GENERATE_TEXTURE_3D_MIPMAPS, get_id(tex));
+}
+
+static void bind_texture_3d(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_texture_3d_t* tex)
+{
+	record_2((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_BIND_TEXTURE_3D, get_bp_id(bp), get_id(tex));
+}
+
+static mrl_error_t update_texture_3d(mrl_render_device_t* brd, mrl_texture_3d_t* tex, const mrl_texture_3d_update_desc_t* desc)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	mgl_u8_t* cmd = begin_command(rd, MRL_NULL_COMMAND_UPDATE_TEXTURE_3D);
+	if (cmd != NULL)
+	{
+		cmd = write_uint(cmd, get_id(tex));
+		cmd = write_uint(cmd, desc->width);
+		cmd = write_uint(cmd, desc->height);
+		cmd = write_uint(cmd, desc->depth);
+		cmd = write_uint(cmd, desc->dst_x);
+		cmd = write_uint(cmd, desc->dst_y);
+		cmd = write_uint(cmd, desc->dst_z);
+		cmd = write_uint(cmd, desc->mip_level);
+		end_command(rd, cmd);
+	}
+	return MRL_ERROR_NONE;
+}
+
+// ---------- Cube maps ----------
+
+static mrl_error_t create_cube_map(mrl_render_device_t* brd, mrl_cube_map_t** cb, const mrl_cube_map_desc_t* desc)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	return create_object(rd, &rd->memory.cube_map, MRL_NULL_COMMAND_CREATE_CUBE_MAP, (void**)cb);
+}
+
+static void destroy_cube_map(mrl_render_device_t* brd, mrl_cube_map_t* cb)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	destroy_object(rd, &rd->memory.cube_map, MRL_NULL_COMMAND_DESTROY_CUBE_MAP, cb);
+}
+
+static void generate_cube_map_mipmaps(mrl_render_device_t* brd, mrl_cube_map_t* cb)
+{
+	record_1((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_GENERATE_CUBE_MAP_MIPMAPS, get_id(cb));
+}
+
+static void bind_cube_map(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_cube_map_t* cb)
+{
+	record_2((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_BIND_CUBE_MAP, get_bp_id(bp), get_id(cb));
+}
+
+static mrl_error_t update_cube_map(mrl_render_device_t* brd, mrl_cube_map_t* cb, const mrl_cube_map_update_desc_t* desc)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	mgl_u8_t* cmd = begin_command(rd, MRL_NULL_COMMAND_UPDATE_CUBE_MAP);
+	if (cmd != NULL)
+	{
+		cmd = write_uint(cmd, get_id(cb));
+		cmd = write_uint(cmd, desc->face);
+		cmd = write_uint(cmd, desc->width);
+		cmd = write_uint(cmd, desc->height);
+		cmd = write_uint(cmd, desc->dst_x);
+		cmd = write_uint(cmd, desc->dst_y);
+		cmd = write_uint(cmd, desc->mip_level);
+		end_command(rd, cmd);
+	}
+	return MRL_ERROR_NONE;
+}
+
+// ---------- 2D Texture arrays ----------
+
+static mrl_error_t create_texture_2d_array(mrl_render_device_t* brd, mrl_texture_2d_array_t** tex, const mrl_texture_2d_array_desc_t* desc)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	return create_object(rd, &rd->memory.texture_2d_array, MRL_NULL_COMMAND_CREATE_TEXTURE_2D_ARRAY, (void**)tex);
+}
+
+static void destroy_texture_2d_array(mrl_render_device_t* brd, mrl_texture_2d_array_t* tex)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	destroy_object(rd, &rd->memory.texture_2d_array, MRL_NULL_COMMAND_DESTROY_TEXTURE_2D_ARRAY, tex);
+}
+
+static void generate_texture_2d_array_mipmaps(mrl_render_device_t* brd, mrl_texture_2d_array_t* tex)
+{
+	record_1((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_GENERATE_TEXTURE_2D_ARRAY_MIPMAPS, get_id(tex));
+}
+
+static void bind_texture_2d_array(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_texture_2d_array_t* tex)
+{
+	record_2((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_BIND_TEXTURE_2D_ARRAY, get_bp_id(bp), get_id(tex));
+}
+
+static mrl_error_t update_texture_2d_array(mrl_render_device_t* brd, mrl_texture_2d_array_t* tex, const mrl_texture_2d_array_update_desc_t* desc)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	mgl_u8_t* cmd = begin_command(rd, MRL_NULL_COMMAND_UPDATE_TEXTURE_2D_ARRAY);
+	if (cmd != NULL)
+	{
+		cmd = write_uint(cmd, get_id(tex));
+		cmd = write_uint(cmd, desc->width);
+		cmd = write_uint(cmd, desc->height);
+		cmd = write_uint(cmd, desc->layer_count);
+		cmd = write_uint(cmd, desc->dst_x);
+		cmd = write_uint(cmd, desc->dst_y);
+		cmd = write_uint(cmd, desc->dst_layer);
+		cmd = write_uint(cmd, desc->mip_level);
+		end_command(rd, cmd);
+	}
+	return MRL_ERROR_NONE;
+}
+
+// ---------- Cube map arrays ----------
+
+static mrl_error_t create_cube_map_array(mrl_render_device_t* brd, mrl_cube_map_array_t** tex, const mrl_cube_map_array_desc_t* desc)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	return create_object(rd, &rd->memory.cube_map_array, MRL_NULL_COMMAND_CREATE_CUBE_MAP_ARRAY, (void**)tex);
+}
+
+static void destroy_cube_map_array(mrl_render_device_t* brd, mrl_cube_map_array_t* tex)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	destroy_object(rd, &rd->memory.cube_map_array, MRL_NULL_COMMAND_DESTROY_CUBE_MAP_ARRAY, tex);
+}
+
+static void generate_cube_map_array_mipmaps(mrl_render_device_t* brd, mrl_cube_map_array_t* tex)
+{
+	record_1((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_GENERATE_CUBE_MAP_ARRAY_MIPMAPS, get_id(tex));
+}
+
+static void bind_cube_map_array(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_cube_map_array_t* tex)
+{
+	record_2((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_BIND_CUBE_MAP_ARRAY, get_bp_id(bp), get_id(tex));
+}
+
+static mrl_error_t update_cube_map_array(mrl_render_device_t* brd, mrl_cube_map_array_t* tex, const mrl_cube_map_array_update_desc_t* desc)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	mgl_u8_t* cmd = begin_command(rd, MRL_NULL_COMMAND_UPDATE_CUBE_MAP_ARRAY);
+	if (cmd != NULL)
+	{
+		cmd = write_uint(cmd, get_id(tex));
+		cmd = write_uint(cmd, desc->width);
+		cmd = write_uint(cmd, desc->height);
+		cmd = write_uint(cmd, desc->face_count);
+		cmd = write_uint(cmd, desc->dst_x);
+		cmd = write_uint(cmd, desc->dst_y);
+		cmd = write_uint(cmd, desc->dst_face);
+		cmd = write_uint(cmd, desc->mip_level);
+		end_command(rd, cmd);
+	}
+	return MRL_ERROR_NONE;
+}
+
+// ---------- Buffers ----------
+
+static mrl_error_t create_buffer(mrl_null_render_device_t* rd, mrl_object_pool_t* pool, mgl_u8_t opcode, const void* data, mgl_u64_t size, mrl_null_buffer_t** out)
+{
+	// Allocate object
+	mrl_null_buffer_t* obj;
+	mgl_error_t err = mrl_allocate_object(pool, (void**)&obj);
+	if (err != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(err);
+
+	// Buffers are kept in system memory, so that they can be mapped
+	err = mgl_allocate(rd->allocator, size, (void**)&obj->data);
+	if (err != MGL_ERROR_NONE)
+	{
+		mrl_deallocate_object(pool, obj);
+		return mrl_make_mgl_error(err);
+	}
+
+	if (data != NULL)
+		mgl_mem_copy(obj->data, data, size);
+	obj->size = size;
+	obj->id = rd->next_id++;
+	record_1(rd, opcode, obj->id);
+	*out = obj;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_buffer(mrl_null_render_device_t* rd, mrl_object_pool_t* pool, mgl_u8_t opcode, mrl_null_buffer_t* buf)
+{
+	record_1(rd, opcode, buf->id);
+	mgl_deallocate(rd->allocator, buf->data);
+
+	// Deallocate object
+	mrl_deallocate_object(pool, buf);
+}
+
+static void update_buffer(mrl_null_render_device_t* rd, mgl_u8_t opcode, mrl_null_buffer_t* buf, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	MGL_DEBUG_ASSERT(offset + size <= buf->size);
+	mgl_mem_copy(buf->data + offset, data, size);
+	record_3(rd, opcode, buf->id, offset, size);
+}
+
+// ---------- Constant buffers ----------
+
+static mrl_error_t create_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t** cb, const mrl_constant_buffer_desc_t* desc)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	return create_buffer(rd, &rd->memory.constant_buffer, MRL_NULL_COMMAND_CREATE_CONSTANT_BUFFER, desc->data, desc->size, (mrl_null_buffer_t**)cb);
+}
+
+static void destroy_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t* cb)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	destroy_buffer(rd, &rd->memory.constant_buffer, MRL_NULL_COMMAND_DESTROY_CONSTANT_BUFFER, (mrl_null_buffer_t*)cb);
+}
+
+static void bind_constant_buffer(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_constant_buffer_t* cb)
+{
+	record_2((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_BIND_CONSTANT_BUFFER, get_bp_id(bp), get_id(cb));
+}
+
+static void bind_constant_buffer_range(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size)
+{
+	record_4((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_BIND_CONSTANT_BUFFER_RANGE, get_bp_id(bp), get_id(cb), offset, size);
+}
+
+static void* map_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t* cb)
+{
+	record_1((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_MAP_CONSTANT_BUFFER, get_id(cb));
+	return ((mrl_null_buffer_t*)cb)->data;
+}
+
+static void unmap_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t* cb)
+{
+	record_1((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_UNMAP_CONSTANT_BUFFER, get_id(cb));
+}
+
+static void* map_constant_buffer_range(mrl_render_device_t* brd, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size, mgl_u32_t flags)
+{
+	MGL_DEBUG_ASSERT(offset + size <= ((mrl_null_buffer_t*)cb)->size);
+	record_4((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_MAP_CONSTANT_BUFFER_RANGE, get_id(cb), offset, size, flags);
+	return ((mrl_null_buffer_t*)cb)->data + offset;
+}
+
+static void flush_constant_buffer_range(mrl_render_device_t* brd, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size)
+{
+	record_3((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_FLUSH_CONSTANT_BUFFER_RANGE, get_id(cb), offset, size);
+}
+
+static void update_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	update_buffer((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_UPDATE_CONSTANT_BUFFER, (mrl_null_buffer_t*)cb, offset, size, data);
+}
+
+static void query_constant_buffer_structure(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_constant_buffer_structure_t* cbs)
+{
+	// There are no shaders to reflect
+	record_1((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_QUERY_CONSTANT_BUFFER_STRUCTURE, get_bp_id(bp));
+	cbs->size = 0;
+	cbs->element_count = 0;
+}
+
+// ---------- Index buffers ----------
+
+static mrl_error_t create_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t** ib, const mrl_index_buffer_desc_t* desc)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	return create_buffer(rd, &rd->memory.index_buffer, MRL_NULL_COMMAND_CREATE_INDEX_BUFFER, desc->data, desc->size, (mrl_null_buffer_t**)ib);
+}
+
+static void destroy_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	destroy_buffer(rd, &rd->memory.index_buffer, MRL_NULL_COMMAND_DESTROY_INDEX_BUFFER, (mrl_null_buffer_t*)ib);
+}
+
+static void set_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib)
+{
+	record_1((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_SET_INDEX_BUFFER, get_id(ib));
+}
+
+static void* map_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib)
+{
+	record_1((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_MAP_INDEX_BUFFER, get_id(ib));
+	return ((mrl_null_buffer_t*)ib)->data;
+}
+
+static void unmap_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib)
+{
+	record_1((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_UNMAP_INDEX_BUFFER, get_id(ib));
+}
+
+static void* map_index_buffer_range(mrl_render_device_t* brd, mrl_index_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size, mgl_u32_t flags)
+{
+	MGL_DEBUG_ASSERT(offset + size <= ((mrl_null_buffer_t*)ib)->size);
+	record_4((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_MAP_INDEX_BUFFER_RANGE, get_id(ib), offset, size, flags);
+	return ((mrl_null_buffer_t*)ib)->data + offset;
+}
+
+static void flush_index_buffer_range(mrl_render_device_t* brd, mrl_index_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size)
+{
+	record_3((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_FLUSH_INDEX_BUFFER_RANGE, get_id(ib), offset, size);
+}
+
+static void update_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	update_buffer((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_UPDATE_INDEX_BUFFER, (mrl_null_buffer_t*)ib, offset, size, data);
+}
+
+// ---------- Indirect buffers ----------
+
+static mrl_error_t create_indirect_buffer(mrl_render_device_t* brd, mrl_indirect_buffer_t** ib, const mrl_indirect_buffer_desc_t* desc)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	return create_buffer(rd, &rd->memory.indirect_buffer, MRL_NULL_COMMAND_CREATE_INDIRECT_BUFFER, desc->data, desc->size, (mrl_null_buffer_t**)ib);
+}
+
+static void destroy_indirect_buffer(mrl_render_device_t* brd, mrl_indirect_buffer_t* ib)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	destroy_buffer(rd, &rd->memory.indirect_buffer, MRL_NULL_COMMAND_DESTROY_INDIRECT_BUFFER, (mrl_null_buffer_t*)ib);
+}
+
+static void update_indirect_buffer(mrl_render_device_t* brd, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	update_buffer((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_UPDATE_INDIRECT_BUFFER, (mrl_null_buffer_t*)ib, offset, size, data);
+}
+
+// ---------- Vertex buffers ----------
+
+static mrl_error_t create_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t** vb, const mrl_vertex_buffer_desc_t* desc)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	return create_buffer(rd, &rd->memory.vertex_buffer, MRL_NULL_COMMAND_CREATE_VERTEX_BUFFER, desc->data, desc->size, (mrl_null_buffer_t**)vb);
+}
+
+static void destroy_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	destroy_buffer(rd, &rd->memory.vertex_buffer, MRL_NULL_COMMAND_DESTROY_VERTEX_BUFFER, (mrl_null_buffer_t*)vb);
+}
+
+static void* map_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb)
+{
+	record_1((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_MAP_VERTEX_BUFFER, get_id(vb));
+	return ((mrl_null_buffer_t*)vb)->data;
+}
+
+static void unmap_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb)
+{
+	record_1((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_UNMAP_VERTEX_BUFFER, get_id(vb));
+}
+
+static void* map_vertex_buffer_range(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb, mgl_u64_t offset, mgl_u64_t size, mgl_u32_t flags)
+{
+	MGL_DEBUG_ASSERT(offset + size <= ((mrl_null_buffer_t*)vb)->size);
+	record_4((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_MAP_VERTEX_BUFFER_RANGE, get_id(vb), offset, size, flags);
+	return ((mrl_null_buffer_t*)vb)->data + offset;
+}
+
+static void flush_vertex_buffer_range(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb, mgl_u64_t offset, mgl_u64_t size)
+{
+	record_3((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_FLUSH_VERTEX_BUFFER_RANGE, get_id(vb), offset, size);
+}
+
+static void update_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	update_buffer((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_UPDATE_VERTEX_BUFFER, (mrl_null_buffer_t*)vb, offset, size, data);
+}
+
+// ---------- Vertex arrays ----------
+
+static mrl_error_t create_vertex_array(mrl_render_device_t* brd, mrl_vertex_array_t** va, const mrl_vertex_array_desc_t* desc)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	return create_object(rd, &rd->memory.vertex_array, MRL_NULL_COMMAND_CREATE_VERTEX_ARRAY, (void**)va);
+}
+
+static void destroy_vertex_array(mrl_render_device_t* brd, mrl_vertex_array_t* va)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	destroy_object(rd, &rd->memory.vertex_array, MRL_NULL_COMMAND_DESTROY_VERTEX_ARRAY, va);
+}
+
+static void set_vertex_array(mrl_render_device_t* brd, mrl_vertex_array_t* va)
+{
+	record_1((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_SET_VERTEX_ARRAY, get_id(va));
+}
+
+// ---------- Stream allocators ----------
+
+static mrl_error_t create_stream_allocator(mrl_render_device_t* brd, mrl_stream_allocator_t** sa, const mrl_stream_allocator_desc_t* desc)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	MGL_DEBUG_ASSERT(desc->buffer != NULL);
+
+	mrl_null_stream_allocator_t* obj;
+	mrl_error_t err = create_object(rd, &rd->memory.stream_allocator, MRL_NULL_COMMAND_CREATE_STREAM_ALLOCATOR, (void**)&obj);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	// Every buffer type shares the same representation
+	obj->buffer = (mrl_null_buffer_t*)desc->buffer;
+	obj->head = 0;
+	*sa = (mrl_stream_allocator_t*)obj;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_stream_allocator(mrl_render_device_t* brd, mrl_stream_allocator_t* sa)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	destroy_object(rd, &rd->memory.stream_allocator, MRL_NULL_COMMAND_DESTROY_STREAM_ALLOCATOR, sa);
+}
+
+static void* map_stream_allocation(mrl_render_device_t* brd, mrl_stream_allocator_t* sa, mgl_u64_t size, mgl_u64_t alignment, mgl_u64_t* offset)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	mrl_null_stream_allocator_t* obj = (mrl_null_stream_allocator_t*)sa;
+
+	if (size > obj->buffer->size)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to map stream allocation: the allocation is bigger than the buffer");
+		return NULL;
+	}
+
+	// Nothing is ever in flight, so the ring only needs to wrap around
+	mgl_u64_t begin = obj->head;
+	if (alignment > 1 && begin % alignment != 0)
+		begin += alignment - begin % alignment;
+	if (begin + size > obj->buffer->size)
+		begin = 0;
+
+	obj->head = begin + size;
+	*offset = begin;
+	record_3(rd, MRL_NULL_COMMAND_MAP_STREAM_ALLOCATION, obj->id, size, alignment);
+
+	return obj->buffer->data + begin;
+}
+
+static void unmap_stream_allocation(mrl_render_device_t* brd, mrl_stream_allocator_t* sa)
+{
+	record_1((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_UNMAP_STREAM_ALLOCATION, get_id(sa));
+}
+
+static void end_stream_allocator_frame(mrl_render_device_t* brd, mrl_stream_allocator_t* sa)
+{
+	record_1((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_END_STREAM_ALLOCATOR_FRAME, get_id(sa));
+}
+
+// ---------- Upload queues ----------
+
+static mrl_error_t create_upload_queue(mrl_render_device_t* brd, mrl_upload_queue_t** uq, const mrl_upload_queue_desc_t* desc)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+
+	mrl_null_upload_queue_t* obj;
+	mrl_error_t err = create_object(rd, &rd->memory.upload_queue, MRL_NULL_COMMAND_CREATE_UPLOAD_QUEUE, (void**)&obj);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	obj->last_token = 0;
+	*uq = (mrl_upload_queue_t*)obj;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_upload_queue(mrl_render_device_t* brd, mrl_upload_queue_t* uq)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	destroy_object(rd, &rd->memory.upload_queue, MRL_NULL_COMMAND_DESTROY_UPLOAD_QUEUE, uq);
+}
+
+// Uploads are recorded as plain updates, and are complete as soon as they are issued
+static mrl_error_t finish_upload(mrl_upload_queue_t* uq, mrl_error_t err, mgl_u64_t* token)
+{
+	mrl_null_upload_queue_t* obj = (mrl_null_upload_queue_t*)uq;
+	if (err != MRL_ERROR_NONE)
+		return err;
+	*token = ++obj->last_token;
+	return MRL_ERROR_NONE;
+}
+
+static mrl_error_t upload_texture_1d(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mrl_texture_1d_t* tex, const mrl_texture_1d_update_desc_t* desc, mgl_u64_t* token)
+{
+	return finish_upload(uq, update_texture_1d(brd, tex, desc), token);
+}
+
+static mrl_error_t upload_texture_2d(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mrl_texture_2d_t* tex, const mrl_texture_2d_update_desc_t* desc, mgl_u64_t* token)
+{
+	return finish_upload(uq, update_texture_2d(brd, tex, desc), token);
+}
+
+static mrl_error_t upload_texture_3d(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mrl_texture_3d_t* tex, const mrl_texture_3d_update_desc_t* desc, mgl_u64_t* token)
+{
+	return finish_upload(uq, update_texture_3d(brd, tex, desc), token);
+}
+
+static mrl_error_t upload_cube_map(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mrl_cube_map_t* cb, const mrl_cube_map_update_desc_t* desc, mgl_u64_t* token)
+{
+	return finish_upload(uq, update_cube_map(brd, cb, desc), token);
+}
+
+static mgl_bool_t is_upload_complete(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mgl_u64_t token)
+{
+	return MGL_TRUE;
+}
+
+static void wait_upload(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mgl_u64_t token)
+{
+	record_2((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_WAIT_UPLOAD, get_id(uq), token);
+}
+
+// ---------- Shaders ----------
+
+static mrl_error_t create_shader_stage(mrl_render_device_t* brd, mrl_shader_stage_t** stage, const mrl_shader_stage_desc_t* desc)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+
+	// Every source type is accepted, since nothing is ever compiled
+	if (desc->stage != MRL_SHADER_STAGE_VERTEX && desc->stage != MRL_SHADER_STAGE_PIXEL)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_UNSUPPORTED_SHADER_STAGE, u8"Failed to create shader stage: unsupported shader stage");
+		return MRL_ERROR_UNSUPPORTED_SHADER_STAGE;
+	}
+
+	return create_object(rd, &rd->memory.shader_stage, MRL_NULL_COMMAND_CREATE_SHADER_STAGE, (void**)stage);
+}
+
+static void destroy_shader_stage(mrl_render_device_t* brd, mrl_shader_stage_t* stage)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	destroy_object(rd, &rd->memory.shader_stage, MRL_NULL_COMMAND_DESTROY_SHADER_STAGE, stage);
+}
+
+static mrl_error_t create_shader_pipeline(mrl_render_device_t* brd, mrl_shader_pipeline_t** pipeline, const mrl_shader_pipeline_desc_t* desc)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+
+	mrl_null_shader_pipeline_t* obj;
+	mrl_error_t err = create_object(rd, &rd->memory.shader_pipeline, MRL_NULL_COMMAND_CREATE_SHADER_PIPELINE, (void**)&obj);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	// Binding points are added as they are queried
+	obj->bps = NULL;
+	*pipeline = (mrl_shader_pipeline_t*)obj;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_shader_pipeline(mrl_render_device_t* brd, mrl_shader_pipeline_t* pipeline)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+
+	mrl_null_binding_point_t* bp = ((mrl_null_shader_pipeline_t*)pipeline)->bps;
+	while (bp != NULL)
+	{
+		mrl_null_binding_point_t* next = bp->next;
+		mrl_deallocate_object(&rd->memory.binding_point, bp);
+		bp = next;
+	}
+
+	destroy_object(rd, &rd->memory.shader_pipeline, MRL_NULL_COMMAND_DESTROY_SHADER_PIPELINE, pipeline);
+}
+
+static void set_shader_pipeline(mrl_render_device_t* brd, mrl_shader_pipeline_t* pipeline)
+{
+	record_1((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_SET_SHADER_PIPELINE, get_id(pipeline));
+}
+
+static mrl_shader_binding_point_t* get_shader_binding_point_by_id(mrl_render_device_t* brd, mrl_shader_pipeline_t* pipeline, mgl_u64_t id)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	mrl_null_shader_pipeline_t* pp = (mrl_null_shader_pipeline_t*)pipeline;
+
+	for (mrl_null_binding_point_t* bp = pp->bps; bp != NULL; bp = bp->next)
+		if (bp->id == id)
+			return (mrl_shader_binding_point_t*)bp;
+
+	// Every binding point exists, since there are no shaders to reflect
+	mrl_null_binding_point_t* bp;
+	mgl_error_t err = mrl_allocate_object(&rd->memory.binding_point, (void**)&bp);
+	if (err != MGL_ERROR_NONE)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(mrl_make_mgl_error(err), u8"Failed to get shader binding point: failed to allocate binding point");
+		return NULL;
+	}
+
+	bp->id = id;
+	bp->next = pp->bps;
+	pp->bps = bp;
+	return (mrl_shader_binding_point_t*)bp;
+}
+
+static mrl_shader_binding_point_t* get_shader_binding_point(mrl_render_device_t* brd, mrl_shader_pipeline_t* pipeline, const mgl_chr8_t* name)
+{
+	return get_shader_binding_point_by_id(brd, pipeline, mrl_get_shader_binding_point_id(name));
+}
+
+// ---------- Draw functions ----------
+
+static void clear_color(mrl_render_device_t* brd, mgl_f32_t r, mgl_f32_t g, mgl_f32_t b, mgl_f32_t a)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	mgl_u8_t* cmd = begin_command(rd, MRL_NULL_COMMAND_CLEAR_COLOR);
+	if (cmd != NULL)
+		end_command(rd, write_float(write_float(write_float(write_float(cmd, r), g), b), a));
+}
+
+static void clear_depth(mrl_render_device_t* brd, mgl_f32_t depth)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	mgl_u8_t* cmd = begin_command(rd, MRL_NULL_COMMAND_CLEAR_DEPTH);
+	if (cmd != NULL)
+		end_command(rd, write_float(cmd, depth));
+}
+
+static void clear_stencil(mrl_render_device_t* brd, mgl_i32_t stencil)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	mgl_u8_t* cmd = begin_command(rd, MRL_NULL_COMMAND_CLEAR_STENCIL);
+	if (cmd != NULL)
+		end_command(rd, write_int(cmd, stencil));
+}
+
+static void swap_buffers(mrl_render_device_t* brd)
+{
+	record_0((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_SWAP_BUFFERS);
+}
+
+static void draw_triangles(mrl_render_device_t* brd, mgl_u64_t offset, mgl_u64_t count)
+{
+	record_2((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_DRAW_TRIANGLES, offset, count);
+}
+
+static void draw_triangles_indexed(mrl_render_device_t* brd, mgl_u64_t offset, mgl_u64_t count)
+{
+	record_2((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_DRAW_TRIANGLES_INDEXED, offset, count);
+}
+
+static void draw_triangles_instanced(mrl_render_device_t* brd, mgl_u64_t offset, mgl_u64_t count, mgl_u64_t instance_count)
+{
+	record_3((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_DRAW_TRIANGLES_INSTANCED, offset, count, instance_count);
+}
+
+static void draw_triangles_indexed_instanced(mrl_render_device_t* brd, mgl_u64_t offset, mgl_u64_t count, mgl_u64_t instance_count)
+{
+	record_3((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_DRAW_TRIANGLES_INDEXED_INSTANCED, offset, count, instance_count);
+}
+
+static void draw_triangles_indexed_base_vertex(mrl_render_device_t* brd, mgl_u64_t offset, mgl_u64_t count, mgl_i64_t base_vertex)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	mgl_u8_t* cmd = begin_command(rd, MRL_NULL_COMMAND_DRAW_TRIANGLES_INDEXED_BASE_VERTEX);
+	if (cmd != NULL)
+		end_command(rd, write_int(write_uint(write_uint(cmd, offset), count), base_vertex));
+}
+
+static void draw_triangles_indexed_instanced_base_vertex(mrl_render_device_t* brd, mgl_u64_t offset, mgl_u64_t count, mgl_u64_t instance_count, mgl_i64_t base_vertex)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	mgl_u8_t* cmd = begin_command(rd, MRL_NULL_COMMAND_DRAW_TRIANGLES_INDEXED_INSTANCED_BASE_VERTEX);
+	if (cmd != NULL)
+		end_command(rd, write_int(write_uint(write_uint(write_uint(cmd, offset), count), instance_count), base_vertex));
+}
+
+static void multi_draw_triangles(mrl_render_device_t* brd, const mgl_u64_t* offsets, const mgl_u64_t* counts, mgl_u64_t draw_count)
+{
+	record_1((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_MULTI_DRAW_TRIANGLES, draw_count);
+}
+
+static void multi_draw_triangles_indexed(mrl_render_device_t* brd, const mgl_u64_t* offsets, const mgl_u64_t* counts, const mgl_i64_t* base_vertices, mgl_u64_t draw_count)
+{
+	record_1((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_MULTI_DRAW_TRIANGLES_INDEXED, draw_count);
+}
+
+static void draw_triangles_indirect(mrl_render_device_t* brd, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t draw_count)
+{
+	record_3((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_DRAW_TRIANGLES_INDIRECT, get_id(ib), offset, draw_count);
+}
+
+static void draw_triangles_indexed_indirect(mrl_render_device_t* brd, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t draw_count)
+{
+	record_3((mrl_null_render_device_t*)brd, MRL_NULL_COMMAND_DRAW_TRIANGLES_INDEXED_INDIRECT, get_id(ib), offset, draw_count);
+}
+
+static void set_viewport(mrl_render_device_t* brd, mgl_i32_t x, mgl_i32_t y, mgl_i32_t w, mgl_i32_t h)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	mgl_u8_t* cmd = begin_command(rd, MRL_NULL_COMMAND_SET_VIEWPORT);
+	if (cmd != NULL)
+		end_command(rd, write_int(write_int(write_int(write_int(cmd, x), y), w), h));
+}
+
+// ---------- Getter functions ----------
+
+static const mgl_chr8_t* get_type_name(mrl_render_device_t* brd)
+{
+	return u8"null";
+}
+
+static mgl_i64_t get_property_i(mrl_render_device_t* brd, mgl_enum_t name)
+{
+	if (name == MRL_PROPERTY_MAX_ANISTROPY)
+		return 1;
+	else if (name == MRL_PROPERTY_CONSTANT_BUFFER_OFFSET_ALIGNMENT)
+		return MRL_NULL_CONSTANT_BUFFER_OFFSET_ALIGNMENT;
+	else if (name == MRL_PROPERTY_NATIVE_INDIRECT_DRAWS)
+		return 1;
+	else if (name == MRL_PROPERTY_CUBE_MAP_ARRAYS)
+		return 1;
+
+	return -1;
+}
+
+static mgl_f64_t get_property_f(mrl_render_device_t* brd, mgl_enum_t name)
+{
+	if (name == MRL_PROPERTY_MAX_ANISTROPY)
+		return 1.0;
+
+	return MGL_F64_NAN;
+}
+
+static mrl_object_pool_t* get_rd_pool(mrl_null_render_device_t* rd, mgl_enum_t type)
+{
+	switch (type)
+	{
+		case MRL_OBJECT_FRAMEBUFFER: return &rd->memory.framebuffer;
+		case MRL_OBJECT_RASTER_STATE: return &rd->memory.raster_state;
+		case MRL_OBJECT_DEPTH_STENCIL_STATE: return &rd->memory.depth_stencil_state;
+		case MRL_OBJECT_BLEND_STATE: return &rd->memory.blend_state;
+		case MRL_OBJECT_SAMPLER: return &rd->memory.sampler;
+		case MRL_OBJECT_TEXTURE_1D: return &rd->memory.texture_1d;
+		case MRL_OBJECT_TEXTURE_2D: return &rd->memory.texture_2d;
+		case MRL_OBJECT_TEXTURE_3D: return &rd->memory.texture_3d;
+		case MRL_OBJECT_CUBE_MAP: return &rd->memory.cube_map;
+		case MRL_OBJECT_CONSTANT_BUFFER: return &rd->memory.constant_buffer;
+		case MRL_OBJECT_INDEX_BUFFER: return &rd->memory.index_buffer;
+		case MRL_OBJECT_VERTEX_BUFFER: return &rd->memory.vertex_buffer;
+		case MRL_OBJECT_VERTEX_ARRAY: return &rd->memory.vertex_array;
+		case MRL_OBJECT_SHADER_STAGE: return &rd->memory.shader_stage;
+		case MRL_OBJECT_SHADER_PIPELINE: return &rd->memory.shader_pipeline;
+		case MRL_OBJECT_STREAM_ALLOCATOR: return &rd->memory.stream_allocator;
+		case MRL_OBJECT_INDIRECT_BUFFER: return &rd->memory.indirect_buffer;
+		case MRL_OBJECT_UPLOAD_QUEUE: return &rd->memory.upload_queue;
+		case MRL_OBJECT_TEXTURE_2D_ARRAY: return &rd->memory.texture_2d_array;
+		case MRL_OBJECT_CUBE_MAP_ARRAY: return &rd->memory.cube_map_array;
+		default: return NULL;
+	}
+}
+
+static mrl_error_t create_rd_allocators(mrl_null_render_device_t* rd, const mrl_render_device_desc_t* desc)
+{
+	// Object size and number of objects reserved up front, by object type
+	const mgl_u64_t sizes[MRL_NULL_OBJECT_POOL_COUNT][2] = {
+		{ sizeof(mrl_null_object_t), desc->max_framebuffer_count },
+		{ sizeof(mrl_null_object_t), desc->max_raster_state_count },
+		{ sizeof(mrl_null_object_t), desc->max_depth_stencil_state_count },
+		{ sizeof(mrl_null_object_t), desc->max_blend_state_count },
+		{ sizeof(mrl_null_object_t), desc->max_sampler_count },
+		{ sizeof(mrl_null_object_t), desc->max_texture_1d_count },
+		{ sizeof(mrl_null_object_t), desc->max_texture_2d_count },
+		{ sizeof(mrl_null_object_t), desc->max_texture_3d_count },
+		{ sizeof(mrl_null_object_t), desc->max_cube_map_count },
+		{ sizeof(mrl_null_buffer_t), desc->max_constant_buffer_count },
+		{ sizeof(mrl_null_buffer_t), desc->max_index_buffer_count },
+		{ sizeof(mrl_null_buffer_t), desc->max_vertex_buffer_count },
+		{ sizeof(mrl_null_object_t), desc->max_vertex_array_count },
+		{ sizeof(mrl_null_object_t), desc->max_shader_stage_count },
+		{ sizeof(mrl_null_shader_pipeline_t), desc->max_shader_pipeline_count },
+		{ sizeof(mrl_null_stream_allocator_t), desc->max_stream_allocator_count },
+		{ sizeof(mrl_null_buffer_t), desc->max_indirect_buffer_count },
+		{ sizeof(mrl_null_upload_queue_t), desc->max_upload_queue_count },
+		{ sizeof(mrl_null_object_t), desc->max_texture_2d_array_count },
+		{ sizeof(mrl_null_object_t), desc->max_cube_map_array_count },
+	};
+
+	// Create object pools
+	for (mgl_enum_t i = 0; i < MRL_NULL_OBJECT_POOL_COUNT; ++i)
+	{
+		mgl_error_t err = mrl_init_object_pool(get_rd_pool(rd, i), rd->allocator, sizes[i][0], sizes[i][1]);
+		if (err != MGL_ERROR_NONE)
+		{
+			while (i-- > 0)
+				mrl_terminate_object_pool(get_rd_pool(rd, i));
+			return mrl_make_mgl_error(err);
+		}
+	}
+
+	// Nothing is reserved for binding points, so initializing their pool can't fail
+	mrl_init_object_pool(&rd->memory.binding_point, rd->allocator, sizeof(mrl_null_binding_point_t), 0);
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_rd_allocators(mrl_null_render_device_t* rd)
+{
+	for (mgl_enum_t i = 0; i < MRL_NULL_OBJECT_POOL_COUNT; ++i)
+		mrl_terminate_object_pool(get_rd_pool(rd, i));
+	mrl_terminate_object_pool(&rd->memory.binding_point);
+}
+
+static void get_object_pool_stats(mrl_render_device_t* brd, mgl_enum_t type, mrl_object_pool_stats_t* stats)
+{
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	mrl_object_pool_t* pool = get_rd_pool(rd, type);
+	MGL_DEBUG_ASSERT(pool != NULL);
+
+	stats->count = pool->count;
+	stats->high_water_mark = pool->high_water_mark;
+	stats->capacity = pool->capacity;
+}
+
+static void set_rd_functions(mrl_null_render_device_t* rd)
+{
+	// Framebuffer functions
+	rd->base.create_framebuffer = &create_framebuffer;
+	rd->base.destroy_framebuffer = &destroy_framebuffer;
+	rd->base.set_framebuffer = &set_framebuffer;
+
+	// Raster state functions
+	rd->base.create_raster_state = &create_raster_state;
+	rd->base.destroy_raster_state = &destroy_raster_state;
+	rd->base.set_raster_state = &set_raster_state;
+
+	// Depth stencil state functions
+	rd->base.create_depth_stencil_state = &create_depth_stencil_state;
+	rd->base.destroy_depth_stencil_state = &destroy_depth_stencil_state;
+	rd->base.set_depth_stencil_state = &set_depth_stencil_state;
+
+	// Blend state functions
+	rd->base.create_blend_state = &create_blend_state;
+	rd->base.destroy_blend_state = &destroy_blend_state;
+	rd->base.set_blend_state = &set_blend_state;
+
+	// Sampler functions
+	rd->base.create_sampler = &create_sampler;
+	rd->base.destroy_sampler = &destroy_sampler;
+	rd->base.bind_sampler = &bind_sampler;
+
+	// Texture 1D functions
+	rd->base.create_texture_1d = &create_texture_1d;
+	rd->base.destroy_texture_1d = &destroy_texture_1d;
+	rd->base.generate_texture_1d_mipmaps = &generate_texture_1d_mipmaps;
+	rd->base.bind_texture_1d = &bind_texture_1d;
+	rd->base.update_texture_1d = &update_texture_1d;
+
+	// Texture 2D functions
+	rd->base.create_texture_2d = &create_texture_2d;
+	rd->base.destroy_texture_2d = &destroy_texture_2d;
+	rd->base.generate_texture_2d_mipmaps = &generate_texture_2d_mipmaps;
+	rd->base.bind_texture_2d = &bind_texture_2d;
+	rd->base.update_texture_2d = &update_texture_2d;
+
+	// Texture 3D functions
+	rd->base.create_texture_3d = &create_texture_3d;
+	rd->base.destroy_texture_3d = &destroy_texture_3d;
+	rd->base.generate_texture_3d_mipmaps = &generate_texture_3d_mipmaps;
+	rd->base.bind_texture_3d = &bind_texture_3d;
+	rd->base.update_texture_3d = &update_texture_3d;
+
+	// Cube map functions
+	rd->base.create_cube_map = &create_cube_map;
+	rd->base.destroy_cube_map = &destroy_cube_map;
+	rd->base.generate_cube_map_mipmaps = &generate_cube_map_mipmaps;
+	rd->base.bind_cube_map = &bind_cube_map;
+	rd->base.update_cube_map = &update_cube_map;
+
+	// Texture 2D array functions
+	rd->base.create_texture_2d_array = &create_texture_2d_array;
+	rd->base.destroy_texture_2d_array = &destroy_texture_2d_array;
+	rd->base.generate_texture_2d_array_mipmaps = &generate_texture_2d_array_mipmaps;
+	rd->base.bind_texture_2d_array = &bind_texture_2d_array;
+	rd->base.update_texture_2d_array = &update_texture_2d_array;
+
+	// Cube map array functions
+	rd->base.create_cube_map_array = &create_cube_map_array;
+	rd->base.destroy_cube_map_array = &destroy_cube_map_array;
+	rd->base.generate_cube_map_array_mipmaps = &generate_cube_map_array_mipmaps;
+	rd->base.bind_cube_map_array = &bind_cube_map_array;
+	rd->base.update_cube_map_array = &update_cube_map_array;
+
+	// Constant buffer functions
+	rd->base.create_constant_buffer = &create_constant_buffer;
+	rd->base.destroy_constant_buffer = &destroy_constant_buffer;
+	rd->base.bind_constant_buffer = &bind_constant_buffer;
+	rd->base.bind_constant_buffer_range = &bind_constant_buffer_range;
+	rd->base.map_constant_buffer = &map_constant_buffer;
+	rd->base.unmap_constant_buffer = &unmap_constant_buffer;
+	rd->base.map_constant_buffer_range = &map_constant_buffer_range;
+	rd->base.flush_constant_buffer_range = &flush_constant_buffer_range;
+	rd->base.update_constant_buffer = &update_constant_buffer;
+	rd->base.query_constant_buffer_structure = &query_constant_buffer_structure;
+
+	// Index buffer functions
+	rd->base.create_index_buffer = &create_index_buffer;
+	rd->base.destroy_index_buffer = &destroy_index_buffer;
+	rd->base.set_index_buffer = &set_index_buffer;
+	rd->base.map_index_buffer = &map_index_buffer;
+	rd->base.unmap_index_buffer = &unmap_index_buffer;
+	rd->base.map_index_buffer_range = &map_index_buffer_range;
+	rd->base.flush_index_buffer_range = &flush_index_buffer_range;
+	rd->base.update_index_buffer = &update_index_buffer;
+
+	// Indirect buffer functions
+	rd->base.create_indirect_buffer = &create_indirect_buffer;
+	rd->base.destroy_indirect_buffer = &destroy_indirect_buffer;
+	rd->base.update_indirect_buffer = &update_indirect_buffer;
+
+	// Vertex buffer functions
+	rd->base.create_vertex_buffer = &create_vertex_buffer;
+	rd->base.destroy_vertex_buffer = &destroy_vertex_buffer;
+	rd->base.map_vertex_buffer = &map_vertex_buffer;
+	rd->base.unmap_vertex_buffer = &unmap_vertex_buffer;
+	rd->base.map_vertex_buffer_range = &map_vertex_buffer_range;
+	rd->base.flush_vertex_buffer_range = &flush_vertex_buffer_range;
+	rd->base.update_vertex_buffer = &update_vertex_buffer;
+
+	// Vertex array functions
+	rd->base.create_vertex_array = &create_vertex_array;
+	rd->base.destroy_vertex_array = &destroy_vertex_array;
+	rd->base.set_vertex_array = &set_vertex_array;
+
+	// Stream allocator functions
+	rd->base.create_stream_allocator = &create_stream_allocator;
+	rd->base.destroy_stream_allocator = &destroy_stream_allocator;
+	rd->base.map_stream_allocation = &map_stream_allocation;
+	rd->base.unmap_stream_allocation = &unmap_stream_allocation;
+	rd->base.end_stream_allocator_frame = &end_stream_allocator_frame;
+
+	// Upload queue functions
+	rd->base.create_upload_queue = &create_upload_queue;
+	rd->base.destroy_upload_queue = &destroy_upload_queue;
+	rd->base.upload_texture_1d = &upload_texture_1d;
+	rd->base.upload_texture_2d = &upload_texture_2d;
+	rd->base.upload_texture_3d = &upload_texture_3d;
+	rd->base.upload_cube_map = &upload_cube_map;
+	rd->base.is_upload_complete = &is_upload_complete;
+	rd->base.wait_upload = &wait_upload;
+
+	// Shader functions
+	rd->base.create_shader_stage = &create_shader_stage;
+	rd->base.destroy_shader_stage = &destroy_shader_stage;
+	rd->base.create_shader_pipeline = &create_shader_pipeline;
+	rd->base.destroy_shader_pipeline = &destroy_shader_pipeline;
+	rd->base.set_shader_pipeline = &set_shader_pipeline;
+	rd->base.get_shader_binding_point = &get_shader_binding_point;
+	rd->base.get_shader_binding_point_by_id = &get_shader_binding_point_by_id;
+
+	// Draw functions
+	rd->base.clear_color = &clear_color;
+	rd->base.clear_depth = &clear_depth;
+	rd->base.clear_stencil = &clear_stencil;
+	rd->base.swap_buffers = &swap_buffers;
+	rd->base.draw_triangles = &draw_triangles;
+	rd->base.draw_triangles_indexed = &draw_triangles_indexed;
+	rd->base.draw_triangles_instanced = &draw_triangles_instanced;
+	rd->base.draw_triangles_indexed_instanced = &draw_triangles_indexed_instanced;
+	rd->base.draw_triangles_indexed_base_vertex = &draw_triangles_indexed_base_vertex;
+	rd->base.draw_triangles_indexed_instanced_base_vertex = &draw_triangles_indexed_instanced_base_vertex;
+	rd->base.multi_draw_triangles = &multi_draw_triangles;
+	rd->base.multi_draw_triangles_indexed = &multi_draw_triangles_indexed;
+	rd->base.draw_triangles_indirect = &draw_triangles_indirect;
+	rd->base.draw_triangles_indexed_indirect = &draw_triangles_indexed_indirect;
+	rd->base.set_viewport = &set_viewport;
+
+	// Getter functions
+	rd->base.get_type_name = &get_type_name;
+	rd->base.get_property_i = &get_property_i;
+	rd->base.get_property_f = &get_property_f;
+	rd->base.get_object_pool_stats = &get_object_pool_stats;
+}
+
+static void extract_hints(mrl_null_render_device_t* rd, const mrl_render_device_desc_t* desc)
+{
+	for (const mrl_hint_t* hint = desc->hints; hint != NULL; hint = hint->next)
+	{
+		// Check if the hint should be skipped
+		if (hint->device_type != NULL && !mgl_str_equal(hint->device_type, u8"null"))
+			continue;
+
+		// Extract hint info
+		switch (hint->type)
+		{
+			case MRL_HINT_RENDER_DEVICE_WARNING_CALLBACK:
+				MGL_DEBUG_ASSERT(hint->data != NULL);
+				rd->warning_callback = *(const mrl_render_device_hint_warning_callback_t*)hint->data;
+				break;
+
+			case MRL_HINT_RENDER_DEVICE_ERROR_CALLBACK:
+				MGL_DEBUG_ASSERT(hint->data != NULL);
+				rd->error_callback = *(const mrl_render_device_hint_error_callback_t*)hint->data;
+				break;
+
+			case MRL_HINT_RENDER_DEVICE_RECORD_COMMANDS:
+				MGL_DEBUG_ASSERT(hint->data != NULL);
+				rd->recording.enabled = MGL_TRUE;
+				rd->recording.capacity = *(const mgl_u64_t*)hint->data;
+				break;
+
+			default:
+				// Unsupported hint type, ignore it
+				continue;
+		}
+	}
+}
+
+MRL_API mrl_error_t mrl_init_null_render_device(const mrl_render_device_desc_t* desc, mrl_render_device_t** out_rd)
+{
+	MGL_DEBUG_ASSERT(desc != NULL && out_rd != NULL);
+	MGL_DEBUG_ASSERT(desc->allocator != NULL);
+
+	// Allocate render device
+	mrl_null_render_device_t* rd;
+	mgl_error_t mglerr = mgl_allocate(desc->allocator, sizeof(mrl_null_render_device_t), (void**)&rd);
+	if (mglerr != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(mglerr);
+
+	rd->allocator = desc->allocator;
+	rd->next_id = 1;
+	rd->error_callback = NULL;
+	rd->warning_callback = NULL;
+	rd->recording.enabled = MGL_FALSE;
+	rd->recording.data = NULL;
+	rd->recording.size = 0;
+	rd->recording.capacity = 0;
+
+	// Extract hints
+	extract_hints(rd, desc);
+
+	// Create allocators
+	mrl_error_t err = create_rd_allocators(rd, desc);
+	if (err != MRL_ERROR_NONE)
+	{
+		mgl_deallocate(rd->allocator, rd);
+		return err;
+	}
+
+	// Reserve the command stream up front
+	if (rd->recording.enabled && rd->recording.capacity > 0)
+	{
+		mglerr = mgl_allocate(rd->allocator, rd->recording.capacity, (void**)&rd->recording.data);
+		if (mglerr != MGL_ERROR_NONE)
+		{
+			destroy_rd_allocators(rd);
+			mgl_deallocate(rd->allocator, rd);
+			return mrl_make_mgl_error(mglerr);
+		}
+	}
+	else
+		rd->recording.capacity = 0;
+
+	// Set render device funcs
+	set_rd_functions(rd);
+
+	*out_rd = (mrl_render_device_t*)rd;
+
+	return MRL_ERROR_NONE;
+}
+
+MRL_API void mrl_terminate_null_render_device(mrl_render_device_t* brd)
+{
+	MGL_DEBUG_ASSERT(brd != NULL);
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+
+	// Free command stream
+	if (rd->recording.data != NULL)
+		mgl_deallocate(rd->allocator, rd->recording.data);
+
+	// Destroy allocators
+	destroy_rd_allocators(rd);
+
+	// Deallocate
+	MGL_DEBUG_ASSERT(mgl_deallocate(rd->allocator, rd) == MRL_ERROR_NONE);
+}
+
+MRL_API const mgl_u8_t* mrl_get_null_render_device_commands(mrl_render_device_t* brd, mgl_u64_t* size)
+{
+	MGL_DEBUG_ASSERT(brd != NULL && size != NULL);
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+
+	*size = rd->recording.size;
+	return rd->recording.size > 0 ? rd->recording.data : NULL;
+}
+
+MRL_API void mrl_clear_null_render_device_commands(mrl_render_device_t* brd)
+{
+	MGL_DEBUG_ASSERT(brd != NULL);
+	mrl_null_render_device_t* rd = (mrl_null_render_device_t*)brd;
+	rd->recording.size = 0;
+}
@@ -0,0 +1,121 @@
+#include <mrl/object_pool.h>
+
+#include <mgl/memory/allocator.h>
+
+#include <stddef.h>
+
+typedef struct mrl_object_pool_slab_t mrl_object_pool_slab_t;
+
+struct mrl_object_pool_slab_t
+{
+	mrl_object_pool_slab_t* next;
+	void* memory;
+};
+
+#define MRL_OBJECT_POOL_ALIGN(x, a) (((x) + (a) - 1) & ~(mgl_u64_t)((a) - 1))
+
+static mgl_error_t allocate_slab(mrl_object_pool_t* pool, mgl_u64_t object_count)
+{
+	// The slab header is stored on the first cache line, and the objects start on the next one
+	mgl_u64_t header_size = MRL_OBJECT_POOL_ALIGN(sizeof(mrl_object_pool_slab_t), MRL_OBJECT_POOL_CACHE_LINE_SIZE);
+	mgl_u64_t size = header_size + pool->object_size * object_count + MRL_OBJECT_POOL_CACHE_LINE_SIZE - 1;
+
+	void* memory;
+	mgl_error_t err = mgl_allocate(pool->allocator, size, &memory);
+	if (err != MGL_ERROR_NONE)
+		return err;
+
+	mrl_object_pool_slab_t* slab = (mrl_object_pool_slab_t*)(size_t)MRL_OBJECT_POOL_ALIGN((mgl_u64_t)(size_t)memory, MRL_OBJECT_POOL_CACHE_LINE_SIZE);
+	slab->memory = memory;
+	slab->next = (mrl_object_pool_slab_t*)pool->slabs;
+	pool->slabs = slab;
+
+	// Objects from the new slab are handed out linearly, instead of being pushed to the free list
+	pool->next = (mgl_u8_t*)slab + header_size;
+	pool->next_count = object_count;
+	pool->capacity += object_count;
+
+	return MGL_ERROR_NONE;
+}
+
+mgl_error_t mrl_init_object_pool(mrl_object_pool_t* pool, void* allocator, mgl_u64_t object_size, mgl_u64_t reserve_count)
+{
+	MGL_DEBUG_ASSERT(pool != NULL && allocator != NULL && object_size > 0);
+
+	pool->allocator = allocator;
+	pool->object_size = MRL_OBJECT_POOL_ALIGN(object_size < sizeof(void*) ? sizeof(void*) : object_size, 8);
+	pool->slab_object_count = MRL_OBJECT_POOL_SLAB_SIZE / pool->object_size;
+	if (pool->slab_object_count == 0)
+		pool->slab_object_count = 1;
+	pool->slabs = NULL;
+	pool->free_list = NULL;
+	pool->next = NULL;
+	pool->next_count = 0;
+	pool->count = 0;
+	pool->capacity = 0;
+	pool->high_water_mark = 0;
+
+	if (reserve_count == 0)
+		return MGL_ERROR_NONE;
+	return allocate_slab(pool, reserve_count);
+}
+
+void mrl_terminate_object_pool(mrl_object_pool_t* pool)
+{
+	MGL_DEBUG_ASSERT(pool != NULL);
+
+	mrl_object_pool_slab_t* slab = (mrl_object_pool_slab_t*)pool->slabs;
+	while (slab != NULL)
+	{
+		mrl_object_pool_slab_t* next = slab->next;
+		mgl_deallocate(pool->allocator, slab->memory);
+		slab = next;
+	}
+
+	pool->slabs = NULL;
+	pool->free_list = NULL;
+	pool->next = NULL;
+	pool->next_count = 0;
+	pool->capacity = 0;
+}
+
+mgl_error_t mrl_allocate_object(mrl_object_pool_t* pool, void** obj)
+{
+	MGL_DEBUG_ASSERT(pool != NULL && obj != NULL);
+
+	if (pool->free_list != NULL)
+	{
+		// Reuse a freed object
+		*obj = pool->free_list;
+		pool->free_list = *(void**)pool->free_list;
+	}
+	else
+	{
+		// Take an object which was never used, growing the pool if needed
+		if (pool->next_count == 0)
+		{
+			mgl_error_t err = allocate_slab(pool, pool->slab_object_count);
+			if (err != MGL_ERROR_NONE)
+				return err;
+		}
+
+		*obj = pool->next;
+		pool->next += pool->object_size;
+		pool->next_count -= 1;
+	}
+
+	pool->count += 1;
+	if (pool->count > pool->high_water_mark)
+		pool->high_water_mark = pool->count;
+
+	return MGL_ERROR_NONE;
+}
+
+void mrl_deallocate_object(mrl_object_pool_t* pool, void* obj)
+{
+	MGL_DEBUG_ASSERT(pool != NULL && obj != NULL && pool->count > 0);
+
+	*(void**)obj = pool->free_list;
+	pool->free_list = obj;
+	pool->count -= 1;
+}
@@ -0,0 +1,60 @@
+#ifndef MRL_OBJECT_POOL_H
+#define MRL_OBJECT_POOL_H
+
+#include <mrl/error.h>
+
+#define MRL_OBJECT_POOL_CACHE_LINE_SIZE 64
+#define MRL_OBJECT_POOL_SLAB_SIZE 4096
+
+/// <summary>
+///		Pool of fixed size objects which grows in cache line aligned slabs.
+///		Freed objects are kept on an intrusive free list, and new slabs are handed out linearly, so allocating is O(1).
+/// </summary>
+typedef struct
+{
+	void* allocator;
+	mgl_u64_t object_size;
+	mgl_u64_t slab_object_count;
+
+	void* slabs;
+	void* free_list;
+	mgl_u8_t* next;
+	mgl_u64_t next_count;
+
+	mgl_u64_t count;
+	mgl_u64_t capacity;
+	mgl_u64_t high_water_mark;
+} mrl_object_pool_t;
+
+/// <summary>
+///		Initializes an object pool.
+/// </summary>
+/// <param name="pool">Pool</param>
+/// <param name="allocator">Allocator used to allocate the slabs</param>
+/// <param name="object_size">Object size</param>
+/// <param name="reserve_count">Number of objects for which memory is allocated up front (can be 0)</param>
+/// <returns>Error code</returns>
+mgl_error_t mrl_init_object_pool(mrl_object_pool_t* pool, void* allocator, mgl_u64_t object_size, mgl_u64_t reserve_count);
+
+/// <summary>
+///		Terminates an object pool, freeing every slab.
+/// </summary>
+/// <param name="pool">Pool</param>
+void mrl_terminate_object_pool(mrl_object_pool_t* pool);
+
+/// <summary>
+///		Allocates an object from a pool, allocating a new slab if there are no free objects left.
+/// </summary>
+/// <param name="pool">Pool</param>
+/// <param name="obj">Out object pointer</param>
+/// <returns>Error code</returns>
+mgl_error_t mrl_allocate_object(mrl_object_pool_t* pool, void** obj);
+
+/// <summary>
+///		Returns an object to its pool.
+/// </summary>
+/// <param name="pool">Pool</param>
+/// <param name="obj">Object pointer</param>
+void mrl_deallocate_object(mrl_object_pool_t* pool, void* obj);
+
+#endif
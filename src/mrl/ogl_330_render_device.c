@@ -1,8 +1,10 @@
 #include <mrl/ogl_330_render_device.h>
+#include <mrl/object_pool.h>
+#include <mrl/texture_decoder.h>
+#include <mrl/thread.h>
 
 #include <mgl/memory/allocator.h>
 #include <mgl/memory/manipulation.h>
-#include <mgl/memory/pool_allocator.h>
 #include <mgl/string/manipulation.h>
 #include <mgl/stream/buffer_stream.h>
 #include <mgl/input/window.h>
@@ -14,6 +16,10 @@
 #		define GLEW_STATIC
 #		include <GL/glew.h>
 #		include <GL/wglew.h>
+#	else
+#		include <GL/glew.h>
+#		include <EGL/egl.h>
+#		include <EGL/eglext.h>
 #	endif
 
 static const mgl_chr8_t* opengl_error_code_to_str(GLenum err)
@@ -90,13 +96,16 @@ typedef struct
 {
 	GLenum internal_format, format, type;
 	mgl_u64_t width;
+	mgl_u32_t mip_level_count;
 	GLuint id;
 } mrl_ogl_330_texture_1d_t;
 
 typedef struct
 {
 	GLenum internal_format, format, type;
+	mgl_enum_t texture_format;
 	mgl_u64_t width, height;
+	mgl_u32_t mip_level_count;
 	GLuint id;
 } mrl_ogl_330_texture_2d_t;
 
@@ -104,16 +113,37 @@ typedef struct
 {
 	GLenum internal_format, format, type;
 	mgl_u64_t width, height, depth;
+	mgl_u32_t mip_level_count;
 	GLuint id;
 } mrl_ogl_330_texture_3d_t;
 
 typedef struct
 {
 	GLenum internal_format, format, type;
+	mgl_enum_t texture_format;
 	mgl_u64_t width, height;
+	mgl_u32_t mip_level_count;
 	GLuint id;
 } mrl_ogl_330_cube_map_t;
 
+typedef struct
+{
+	GLenum internal_format, format, type;
+	mgl_enum_t texture_format;
+	mgl_u64_t width, height, layer_count;
+	mgl_u32_t mip_level_count;
+	GLuint id;
+} mrl_ogl_330_texture_2d_array_t;
+
+typedef struct
+{
+	GLenum internal_format, format, type;
+	mgl_enum_t texture_format;
+	mgl_u64_t width, height, layer_count;
+	mgl_u32_t mip_level_count;
+	GLuint id;
+} mrl_ogl_330_cube_map_array_t;
+
 typedef struct
 {
 	GLuint id;
@@ -125,6 +155,15 @@ typedef struct
 	GLenum format;
 } mrl_ogl_330_index_buffer_t;
 
+typedef struct
+{
+	GLuint id;
+
+	// Without ARB_draw_indirect the arguments are kept in system memory and read on the CPU
+	mgl_u8_t* data;
+	mgl_u64_t size;
+} mrl_ogl_330_indirect_buffer_t;
+
 typedef struct
 {
 	GLuint id;
@@ -135,29 +174,105 @@ typedef struct
 	GLuint id;
 } mrl_ogl_330_vertex_array_t;
 
+#define MRL_OGL_330_MAX_STREAM_FRAME_COUNT 8
+
 typedef struct
 {
 	GLuint id;
-} mrl_ogl_330_shader_stage_t;
+	mgl_u64_t size;
+
+	// Ring buffer state, 'used' counts the bytes between the oldest pending frame and the head
+	mgl_u64_t head;
+	mgl_u64_t used;
+	mgl_u64_t frame_used;
+
+	// Frames which may still be in use by the GPU, oldest first
+	struct
+	{
+		GLsync fence;
+		mgl_u64_t size;
+	} frames[MRL_OGL_330_MAX_STREAM_FRAME_COUNT];
+	mgl_u32_t first_frame;
+	mgl_u32_t frame_count;
+} mrl_ogl_330_stream_allocator_t;
+
+#define MRL_OGL_330_MAX_PENDING_UPLOAD_COUNT 64
+
+typedef struct
+{
+	GLuint id;
+	mgl_u64_t size;
+
+	// Ring buffer state, 'used' counts the bytes between the oldest pending upload and the head
+	mgl_u64_t head;
+	mgl_u64_t used;
+
+	// Tokens are given out sequentially, and uploads complete in order
+	mgl_u64_t last_token;
+	mgl_u64_t completed_token;
+
+	// Uploads which may still be in use by the GPU, oldest first
+	struct
+	{
+		GLsync fence;
+		mgl_u64_t size;
+		mgl_u64_t token;
+	} uploads[MRL_OGL_330_MAX_PENDING_UPLOAD_COUNT];
+	mgl_u32_t first_upload;
+	mgl_u32_t upload_count;
+} mrl_ogl_330_upload_queue_t;
 
-#define MRL_OGL_330_SHADER_BINDING_POINT_MAX_NAME_SIZE 32
-#define MRL_OGL_330_SHADER_MAX_BINDING_POINT_COUNT 32
+typedef struct
+{
+	GLuint id;
+} mrl_ogl_330_shader_stage_t;
 
 typedef struct mrl_ogl_330_shader_pipeline_t mrl_ogl_330_shader_pipeline_t;
 
 typedef struct
 {
-	mgl_chr8_t name[MRL_OGL_330_SHADER_BINDING_POINT_MAX_NAME_SIZE];
-	GLint loc;
+	const mgl_chr8_t* name;
+	mgl_u64_t id;
+	GLint loc; // Uniform location or uniform block index
+	GLint unit; // Texture unit assigned to sampler uniforms on link, -1 for other binding points
+	mgl_bool_t is_block;
 	mrl_ogl_330_shader_pipeline_t* pp;
 } mrl_ogl_330_shader_binding_point_t;
 
 struct mrl_ogl_330_shader_pipeline_t
 {
 	GLuint id;
-	mrl_ogl_330_shader_binding_point_t bps[MRL_OGL_330_SHADER_MAX_BINDING_POINT_COUNT];
+
+	// Binding points reflected on link, indexed by an open addressing hash table on their IDs.
+	// The table stores binding point indices plus one, with zero marking empty slots.
+	// The binding points, the table and the names share a single allocation, pointed to by 'bps'.
+	mgl_u32_t bp_count;
+	mrl_ogl_330_shader_binding_point_t* bps;
+	mgl_u32_t table_mask;
+	mgl_u32_t* table;
+
+	mgl_u32_t texture_unit_count;
 };
 
+#define MRL_OGL_330_MAX_CACHED_TEXTURE_UNIT_COUNT 32
+#define MRL_OGL_330_TEXTURE_TARGET_COUNT 6
+#define MRL_OGL_330_UNKNOWN_BINDING ((GLuint)-1)
+
+// Number of ranges converted to GL types on the stack for each multi draw call
+#define MRL_OGL_330_MULTI_DRAW_BATCH_SIZE 64
+
+// Must be a power of two
+#define MRL_OGL_330_DEBUG_MESSAGE_QUEUE_SIZE 64
+#define MRL_OGL_330_MAX_DEBUG_MESSAGE_SIZE 256
+
+typedef struct
+{
+	// Equal to the queue position + 1 when the message is ready to be read
+	mrl_atomic_u32_t sequence;
+	mgl_bool_t error;
+	mgl_chr8_t message[MRL_OGL_330_MAX_DEBUG_MESSAGE_SIZE];
+} mrl_ogl_330_debug_message_t;
+
 typedef struct
 {
 	mrl_render_device_t base;
@@ -171,113 +286,398 @@ typedef struct
 		HDC hdc;
 		HGLRC hrc;
 	} win32;
+#	else
+	struct
+	{
+		EGLDisplay display;
+		EGLContext context;
+		EGLSurface surface;
+	} egl;
 #	endif
 
 	struct
 	{
-		struct
-		{
-			mgl_pool_allocator_t pool;
-			mgl_u8_t* data;
-		} framebuffer;
+		GLuint fbo;
+		GLuint color_rbo;
+		GLuint depth_stencil_rbo;
+		mgl_u32_t width;
+		mgl_u32_t height;
+	} offscreen;
 
-		struct
-		{
-			mgl_pool_allocator_t pool;
-			mgl_u8_t* data;
-		} raster_state;
+	struct
+	{
+		mrl_object_pool_t framebuffer;
+		mrl_object_pool_t raster_state;
+		mrl_object_pool_t depth_stencil_state;
+		mrl_object_pool_t blend_state;
+		mrl_object_pool_t sampler;
+		mrl_object_pool_t texture_1d;
+		mrl_object_pool_t texture_2d;
+		mrl_object_pool_t texture_3d;
+		mrl_object_pool_t cube_map;
+		mrl_object_pool_t constant_buffer;
+		mrl_object_pool_t index_buffer;
+		mrl_object_pool_t vertex_buffer;
+		mrl_object_pool_t vertex_array;
+		mrl_object_pool_t shader_stage;
+		mrl_object_pool_t shader_pipeline;
+		mrl_object_pool_t stream_allocator;
+		mrl_object_pool_t indirect_buffer;
+		mrl_object_pool_t upload_queue;
+		mrl_object_pool_t texture_2d_array;
+		mrl_object_pool_t cube_map_array;
+	} memory;
 
-		struct
-		{
-			mgl_pool_allocator_t pool;
-			mgl_u8_t* data;
-		} depth_stencil_state;
+	struct
+	{
+		GLenum index_buffer_format;
+	} state;
 
+	struct
+	{
+		GLint uniform_buffer_offset_alignment;
+		GLint max_texture_units;
+		mgl_bool_t draw_indirect;
+		mgl_bool_t multi_draw_indirect;
+		mgl_bool_t texture_storage;
+		mgl_bool_t texture_cube_map_array;
+		mgl_bool_t texture_compression_s3tc;
+		mgl_bool_t texture_compression_bptc;
+		mgl_bool_t texture_compression_etc2;
+	} limits;
+
+	// Shadow copy of the GL state, used to skip redundant driver calls
+	struct
+	{
+		const mrl_ogl_330_raster_state_t* raster_state;
+		const mrl_ogl_330_depth_stencil_state_t* depth_stencil_state;
+		const mrl_ogl_330_blend_state_t* blend_state;
+
+		GLboolean cull_enabled;
+		GLenum cull_face;
+		GLenum front_face;
+		GLenum polygon_mode;
+
+		GLboolean depth_enabled;
+		mgl_bool_t depth_valid;
+		GLenum depth_func;
+		GLboolean depth_write_enabled;
+		GLfloat depth_near;
+		GLfloat depth_far;
+
+		GLboolean stencil_enabled;
+		mgl_bool_t stencil_valid;
 		struct
 		{
-			mgl_pool_allocator_t pool;
-			mgl_u8_t* data;
-		} blend_state;
+			GLenum func;
+			GLuint ref;
+			GLuint read_mask;
+			GLuint write_mask;
+			GLenum stencil_fail;
+			GLenum depth_fail;
+			GLenum stencil_pass;
+		} stencil[2];
+
+		GLboolean blend_enabled;
+		mgl_bool_t blend_valid;
+		GLenum src_factor;
+		GLenum dst_factor;
+		GLenum src_alpha_factor;
+		GLenum dst_alpha_factor;
+		GLenum blend_op;
+		GLenum alpha_blend_op;
+
+		GLuint framebuffer;
+		GLuint program;
+		GLuint vertex_array;
+		GLuint index_buffer;
+		GLuint indirect_buffer;
+		GLuint active_texture_unit;
+		GLuint textures[MRL_OGL_330_MAX_CACHED_TEXTURE_UNIT_COUNT][MRL_OGL_330_TEXTURE_TARGET_COUNT];
+		GLuint samplers[MRL_OGL_330_MAX_CACHED_TEXTURE_UNIT_COUNT];
+	} cache;
 
-		struct
-		{
-			mgl_pool_allocator_t pool;
-			mgl_u8_t* data;
-		} sampler;
+	mrl_ogl_330_raster_state_t default_raster_state;
+	mrl_ogl_330_depth_stencil_state_t default_depth_stencil_state;
+	mrl_ogl_330_blend_state_t default_blend_state;
 
-		struct
-		{
-			mgl_pool_allocator_t pool;
-			mgl_u8_t* data;
-		} texture_1d;
+	// Set by MRL_HINT_RENDER_DEVICE_DEBUG
+	mgl_bool_t debug;
 
-		struct
-		{
-			mgl_pool_allocator_t pool;
-			mgl_u8_t* data;
-		} texture_2d;
+	// Messages from the KHR_debug callback, which may be called from driver threads.
+	// Written by any thread, and only read on swap_buffers.
+	struct
+	{
+		mgl_bool_t enabled;
+		mrl_atomic_u32_t tail;
+		mgl_u32_t head;
+		mrl_atomic_u32_t dropped_count;
+		mrl_ogl_330_debug_message_t messages[MRL_OGL_330_DEBUG_MESSAGE_QUEUE_SIZE];
+	} debug_output;
 
-		struct
-		{
-			mgl_pool_allocator_t pool;
-			mgl_u8_t* data;
-		} texture_3d;
+	mrl_render_device_hint_error_callback_t error_callback;
+	mrl_render_device_hint_error_callback_t warning_callback;
+} mrl_ogl_330_render_device_t;
 
-		struct
-		{
-			mgl_pool_allocator_t pool;
-			mgl_u8_t* data;
-		} cube_map;
+// ---------- Errors ----------
 
-		struct
-		{
-			mgl_pool_allocator_t pool;
-			mgl_u8_t* data;
-		} constant_buffer;
+// glGetError forces the driver to synchronize with its command queue on most implementations,
+// so errors are only checked after every call when debugging
+static GLenum get_gl_error(mrl_ogl_330_render_device_t* rd)
+{
+	if (!rd->debug)
+		return GL_NO_ERROR;
+	return glGetError();
+}
 
-		struct
-		{
-			mgl_pool_allocator_t pool;
-			mgl_u8_t* data;
-		} index_buffer;
+// ---------- Debug output ----------
 
-		struct
-		{
-			mgl_pool_allocator_t pool;
-			mgl_u8_t* data;
-		} vertex_buffer;
+static void GLAPIENTRY debug_message_callback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, const void* user_param)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)user_param;
 
-		struct
+	// Reserve a slot on the queue
+	mgl_u32_t pos = mrl_atomic_load(&rd->debug_output.tail);
+	mrl_ogl_330_debug_message_t* msg;
+	for (;;)
+	{
+		msg = &rd->debug_output.messages[pos & (MRL_OGL_330_DEBUG_MESSAGE_QUEUE_SIZE - 1)];
+		mgl_i32_t diff = (mgl_i32_t)(mrl_atomic_load(&msg->sequence) - pos);
+		if (diff == 0)
 		{
-			mgl_pool_allocator_t pool;
-			mgl_u8_t* data;
-		} vertex_array;
-
-		struct
+			if (mrl_atomic_compare_exchange(&rd->debug_output.tail, pos, pos + 1))
+				break;
+		}
+		else if (diff < 0)
 		{
-			mgl_pool_allocator_t pool;
-			mgl_u8_t* data;
-		} shader_stage;
+			// The queue is full, the message is lost
+			mrl_atomic_fetch_add(&rd->debug_output.dropped_count, 1);
+			return;
+		}
+		pos = mrl_atomic_load(&rd->debug_output.tail);
+	}
 
-		struct
-		{
-			mgl_pool_allocator_t pool;
-			mgl_u8_t* data;
-		} shader_pipeline;
-	} memory;
+	// Copy the message, truncating it if needed
+	if (length < 0)
+		length = (GLsizei)mgl_str_size((const mgl_chr8_t*)message);
+	if (length > MRL_OGL_330_MAX_DEBUG_MESSAGE_SIZE - 1)
+		length = MRL_OGL_330_MAX_DEBUG_MESSAGE_SIZE - 1;
+	mgl_mem_copy(msg->message, message, (mgl_u64_t)length);
+	msg->message[length] = '\0';
+	msg->error = severity == GL_DEBUG_SEVERITY_HIGH || type == GL_DEBUG_TYPE_ERROR;
+
+	// Publish it
+	mrl_atomic_store(&msg->sequence, pos + 1);
+}
 
-	struct
+static void enable_debug_output(mrl_ogl_330_render_device_t* rd)
+{
+	rd->debug_output.enabled = MGL_FALSE;
+	if (!GLEW_KHR_debug || (rd->error_callback == NULL && rd->warning_callback == NULL))
+		return;
+
+	rd->debug_output.head = 0;
+	mrl_atomic_store(&rd->debug_output.tail, 0);
+	mrl_atomic_store(&rd->debug_output.dropped_count, 0);
+	for (mgl_u32_t i = 0; i < MRL_OGL_330_DEBUG_MESSAGE_QUEUE_SIZE; ++i)
+		mrl_atomic_store(&rd->debug_output.messages[i].sequence, i);
+
+	// Notifications are never reported, and low severity messages only when debugging
+	glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, NULL, GL_FALSE);
+	glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_LOW, 0, NULL, rd->debug ? GL_TRUE : GL_FALSE);
+
+	// When debugging, messages are generated inside the call which caused them, making them easier to trace
+	if (rd->debug)
+		glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+	glDebugMessageCallback(&debug_message_callback, rd);
+	glEnable(GL_DEBUG_OUTPUT);
+
+	rd->debug_output.enabled = MGL_TRUE;
+}
+
+static void disable_debug_output(mrl_ogl_330_render_device_t* rd)
+{
+	if (!rd->debug_output.enabled)
+		return;
+	glDisable(GL_DEBUG_OUTPUT);
+	glDebugMessageCallback(NULL, NULL);
+	rd->debug_output.enabled = MGL_FALSE;
+}
+
+// Reports the queued debug messages through the error and warning callbacks
+static void flush_debug_messages(mrl_ogl_330_render_device_t* rd)
+{
+	if (!rd->debug_output.enabled)
+		return;
+
+	for (;;)
 	{
-		GLenum index_buffer_format;
-	} state;
+		mrl_ogl_330_debug_message_t* msg = &rd->debug_output.messages[rd->debug_output.head & (MRL_OGL_330_DEBUG_MESSAGE_QUEUE_SIZE - 1)];
+		if (mrl_atomic_load(&msg->sequence) != rd->debug_output.head + 1)
+			break;
 
-	mrl_ogl_330_raster_state_t default_raster_state;
-	mrl_ogl_330_depth_stencil_state_t default_depth_stencil_state;
-	mrl_ogl_330_blend_state_t default_blend_state;
+		if (msg->error && rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_EXTERNAL, msg->message);
+		else if (!msg->error && rd->warning_callback != NULL)
+			rd->warning_callback(MRL_ERROR_NONE, msg->message);
 
-	mrl_render_device_hint_error_callback_t error_callback;
-	mrl_render_device_hint_error_callback_t warning_callback;
-} mrl_ogl_330_render_device_t;
+		// Free the slot for the next lap
+		mrl_atomic_store(&msg->sequence, rd->debug_output.head + MRL_OGL_330_DEBUG_MESSAGE_QUEUE_SIZE);
+		rd->debug_output.head += 1;
+	}
+
+	if (mrl_atomic_load(&rd->debug_output.dropped_count) > 0)
+	{
+		mrl_atomic_store(&rd->debug_output.dropped_count, 0);
+		if (rd->warning_callback != NULL)
+			rd->warning_callback(MRL_ERROR_NONE, u8"OpenGL debug message queue overflowed, some messages were lost");
+	}
+}
+
+// ---------- State cache ----------
+
+static void invalidate_state_cache(mrl_ogl_330_render_device_t* rd)
+{
+	rd->cache.raster_state = NULL;
+	rd->cache.depth_stencil_state = NULL;
+	rd->cache.blend_state = NULL;
+
+	// GLboolean fields are set to a value which is neither GL_TRUE nor GL_FALSE
+	rd->cache.cull_enabled = 0xFF;
+	rd->cache.cull_face = GL_NONE;
+	rd->cache.front_face = GL_NONE;
+	rd->cache.polygon_mode = GL_NONE;
+	rd->cache.depth_enabled = 0xFF;
+	rd->cache.depth_valid = MGL_FALSE;
+	rd->cache.stencil_enabled = 0xFF;
+	rd->cache.stencil_valid = MGL_FALSE;
+	rd->cache.blend_enabled = 0xFF;
+	rd->cache.blend_valid = MGL_FALSE;
+
+	rd->cache.framebuffer = MRL_OGL_330_UNKNOWN_BINDING;
+	rd->cache.program = MRL_OGL_330_UNKNOWN_BINDING;
+	rd->cache.vertex_array = MRL_OGL_330_UNKNOWN_BINDING;
+	rd->cache.index_buffer = MRL_OGL_330_UNKNOWN_BINDING;
+	rd->cache.indirect_buffer = MRL_OGL_330_UNKNOWN_BINDING;
+	rd->cache.active_texture_unit = MRL_OGL_330_UNKNOWN_BINDING;
+	for (mgl_u32_t i = 0; i < MRL_OGL_330_MAX_CACHED_TEXTURE_UNIT_COUNT; ++i)
+	{
+		for (mgl_u32_t j = 0; j < MRL_OGL_330_TEXTURE_TARGET_COUNT; ++j)
+			rd->cache.textures[i][j] = MRL_OGL_330_UNKNOWN_BINDING;
+		rd->cache.samplers[i] = MRL_OGL_330_UNKNOWN_BINDING;
+	}
+}
+
+static mgl_u32_t get_texture_target_index(GLenum target)
+{
+	switch (target)
+	{
+		case GL_TEXTURE_1D: return 0;
+		case GL_TEXTURE_2D: return 1;
+		case GL_TEXTURE_3D: return 2;
+		case GL_TEXTURE_CUBE_MAP: return 3;
+		case GL_TEXTURE_2D_ARRAY: return 4;
+		case GL_TEXTURE_CUBE_MAP_ARRAY: return 5;
+		default: MGL_DEBUG_ASSERT(MGL_FALSE); return 0;
+	}
+}
+
+static void bind_framebuffer(mrl_ogl_330_render_device_t* rd, GLuint id)
+{
+	if (rd->cache.framebuffer == id)
+		return;
+	glBindFramebuffer(GL_FRAMEBUFFER, id);
+	rd->cache.framebuffer = id;
+}
+
+static void use_program(mrl_ogl_330_render_device_t* rd, GLuint id)
+{
+	if (rd->cache.program == id)
+		return;
+	glUseProgram(id);
+	rd->cache.program = id;
+}
+
+static void bind_vertex_array(mrl_ogl_330_render_device_t* rd, GLuint id)
+{
+	if (rd->cache.vertex_array == id)
+		return;
+	glBindVertexArray(id);
+	rd->cache.vertex_array = id;
+
+	// The element array buffer binding is part of the vertex array state
+	rd->cache.index_buffer = MRL_OGL_330_UNKNOWN_BINDING;
+}
+
+static void bind_index_buffer(mrl_ogl_330_render_device_t* rd, GLuint id)
+{
+	if (rd->cache.index_buffer == id)
+		return;
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, id);
+	rd->cache.index_buffer = id;
+}
+
+static void bind_indirect_buffer(mrl_ogl_330_render_device_t* rd, GLuint id)
+{
+	if (rd->cache.indirect_buffer == id)
+		return;
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, id);
+	rd->cache.indirect_buffer = id;
+}
+
+static void set_active_texture_unit(mrl_ogl_330_render_device_t* rd, GLuint unit)
+{
+	if (rd->cache.active_texture_unit == unit)
+		return;
+	glActiveTexture(GL_TEXTURE0 + unit);
+	rd->cache.active_texture_unit = unit;
+}
+
+static void bind_texture(mrl_ogl_330_render_device_t* rd, GLenum target, GLuint id)
+{
+	// Binds the texture to the active texture unit
+	GLuint unit = rd->cache.active_texture_unit;
+	if (unit >= MRL_OGL_330_MAX_CACHED_TEXTURE_UNIT_COUNT)
+	{
+		glBindTexture(target, id);
+		return;
+	}
+
+	GLuint* cached = &rd->cache.textures[unit][get_texture_target_index(target)];
+	if (*cached == id)
+		return;
+	glBindTexture(target, id);
+	*cached = id;
+}
+
+static void bind_texture_unit(mrl_ogl_330_render_device_t* rd, GLuint unit, GLenum target, GLuint id)
+{
+	// Only switch the active texture unit if the texture isn't already bound to it
+	if (unit < MRL_OGL_330_MAX_CACHED_TEXTURE_UNIT_COUNT && rd->cache.textures[unit][get_texture_target_index(target)] == id)
+		return;
+	set_active_texture_unit(rd, unit);
+	bind_texture(rd, target, id);
+}
+
+static void bind_sampler_unit(mrl_ogl_330_render_device_t* rd, GLuint unit, GLuint id)
+{
+	if (unit < MRL_OGL_330_MAX_CACHED_TEXTURE_UNIT_COUNT)
+	{
+		if (rd->cache.samplers[unit] == id)
+			return;
+		rd->cache.samplers[unit] = id;
+	}
+	glBindSampler(unit, id);
+}
+
+static void forget_texture(mrl_ogl_330_render_device_t* rd, GLenum target, GLuint id)
+{
+	// Deleted textures are unbound from every texture unit
+	mgl_u32_t index = get_texture_target_index(target);
+	for (mgl_u32_t i = 0; i < MRL_OGL_330_MAX_CACHED_TEXTURE_UNIT_COUNT; ++i)
+		if (rd->cache.textures[i][index] == id)
+			rd->cache.textures[i][index] = 0;
+}
 
 // ---------- Framebuffers ----------
 
@@ -302,7 +702,8 @@ static mrl_error_t create_framebuffer(mrl_render_device_t* brd, mrl_framebuffer_
 	for (mgl_u32_t i = 0; i < desc->target_count; ++i)
 	{
 		if ((desc->targets[i].type == MRL_RENDER_TARGET_TYPE_TEXTURE_2D && desc->targets[i].tex_2d.handle == NULL) ||
-			(desc->targets[i].type == MRL_RENDER_TARGET_TYPE_CUBE_MAP && desc->targets[i].cube_map.handle == NULL))
+			(desc->targets[i].type == MRL_RENDER_TARGET_TYPE_CUBE_MAP && desc->targets[i].cube_map.handle == NULL) ||
+			(desc->targets[i].type == MRL_RENDER_TARGET_TYPE_TEXTURE_2D_ARRAY && desc->targets[i].tex_2d_array.handle == NULL))
 		{
 			if (rd->error_callback != NULL)
 				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create framebuffer: defined target cannot be NULL");
@@ -317,8 +718,17 @@ static mrl_error_t create_framebuffer(mrl_render_device_t* brd, mrl_framebuffer_
 			return MRL_ERROR_INVALID_PARAMS;
 		}
 
+		if (desc->targets[i].type == MRL_RENDER_TARGET_TYPE_TEXTURE_2D_ARRAY &&
+			desc->targets[i].tex_2d_array.layer >= ((mrl_ogl_330_texture_2d_array_t*)desc->targets[i].tex_2d_array.handle)->layer_count)
+		{
+			if (rd->error_callback != NULL)
+				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create framebuffer: texture array target layer out of bounds");
+			return MRL_ERROR_INVALID_PARAMS;
+		}
+
 		if (desc->targets[i].type != MRL_RENDER_TARGET_TYPE_TEXTURE_2D &&
-			desc->targets[i].type != MRL_RENDER_TARGET_TYPE_CUBE_MAP)
+			desc->targets[i].type != MRL_RENDER_TARGET_TYPE_CUBE_MAP &&
+			desc->targets[i].type != MRL_RENDER_TARGET_TYPE_TEXTURE_2D_ARRAY)
 		{
 			if (rd->error_callback != NULL)
 				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create framebuffer: invalid target type");
@@ -326,10 +736,26 @@ static mrl_error_t create_framebuffer(mrl_render_device_t* brd, mrl_framebuffer_
 		}
 	}
 
+	if (desc->depth_stencil != NULL && desc->depth_stencil_array != NULL)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create framebuffer: depth stencil texture and texture array can't be both set");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	if (desc->depth_stencil_array != NULL && desc->depth_stencil_layer >= ((mrl_ogl_330_texture_2d_array_t*)desc->depth_stencil_array)->layer_count)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create framebuffer: depth stencil layer out of bounds");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
 	// Initialize framebuffer
+	GLuint previous_id = rd->cache.framebuffer;
 	GLuint id;
 	glGenFramebuffers(1, &id);
 	glBindFramebuffer(GL_FRAMEBUFFER, id);
+	rd->cache.framebuffer = MRL_OGL_330_UNKNOWN_BINDING;
 
 	for (mgl_u32_t i = 0; i < desc->target_count; ++i)
 	{
@@ -355,6 +781,11 @@ static mrl_error_t create_framebuffer(mrl_render_device_t* brd, mrl_framebuffer_
 
 			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, face, cb->id, 0);
 		}
+		else if (desc->targets[i].type == MRL_RENDER_TARGET_TYPE_TEXTURE_2D_ARRAY)
+		{
+			mrl_ogl_330_texture_2d_array_t* tex = (mrl_ogl_330_texture_2d_array_t*)desc->targets[i].tex_2d_array.handle;
+			glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, tex->id, 0, (GLint)desc->targets[i].tex_2d_array.layer);
+		}
 	}
 
 	if (desc->depth_stencil != NULL)
@@ -373,9 +804,25 @@ static mrl_error_t create_framebuffer(mrl_render_device_t* brd, mrl_framebuffer_
 			return MRL_ERROR_INVALID_PARAMS;
 		}
 	}
+	else if (desc->depth_stencil_array != NULL)
+	{
+		mrl_ogl_330_texture_2d_array_t* tex = (mrl_ogl_330_texture_2d_array_t*)desc->depth_stencil_array;
+
+		if (tex->format == GL_DEPTH_COMPONENT)
+			glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, tex->id, 0, (GLint)desc->depth_stencil_layer);
+		else if (tex->format == GL_DEPTH_STENCIL)
+			glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, tex->id, 0, (GLint)desc->depth_stencil_layer);
+		else
+		{
+			glDeleteFramebuffers(1, &id);
+			if (rd->error_callback != NULL)
+				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create framebuffer: invalid depth/stencil texture format");
+			return MRL_ERROR_INVALID_PARAMS;
+		}
+	}
 
 	// Check errors
-	GLenum gl_err = glGetError();
+	GLenum gl_err = get_gl_error(rd);
 	if (gl_err != 0)
 	{
 		glDeleteFramebuffers(1, &id);
@@ -394,9 +841,8 @@ static mrl_error_t create_framebuffer(mrl_render_device_t* brd, mrl_framebuffer_
 
 	// Allocate object
 	mrl_ogl_330_framebuffer_t* obj;
-	mgl_error_t err = mgl_allocate(
-		&rd->memory.framebuffer.pool,
-		sizeof(*obj),
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.framebuffer,
 		(void**)&obj);
 	if (err != MGL_ERROR_NONE)
 	{
@@ -408,7 +854,8 @@ static mrl_error_t create_framebuffer(mrl_render_device_t* brd, mrl_framebuffer_
 	obj->id = id;
 	*fb = (mrl_framebuffer_t*)obj;
 
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	// Restore the previously bound framebuffer
+	bind_framebuffer(rd, previous_id == MRL_OGL_330_UNKNOWN_BINDING ? rd->offscreen.fbo : previous_id);
 
 	return MRL_ERROR_NONE;
 }
@@ -420,10 +867,12 @@ static void destroy_framebuffer(mrl_render_device_t* brd, mrl_framebuffer_t* fb)
 
 	// Delete framebuffer
 	glDeleteFramebuffers(1, &obj->id);
+	if (rd->cache.framebuffer == obj->id)
+		rd->cache.framebuffer = 0;
 
 	// Deallocate object
-	mgl_deallocate(
-		&rd->memory.framebuffer.pool,
+	mrl_deallocate_object(
+		&rd->memory.framebuffer,
 		obj);
 }
 
@@ -434,9 +883,9 @@ static void set_framebuffer(mrl_render_device_t* brd, mrl_framebuffer_t* fb)
 
 	// Set framebuffer
 	if (obj == NULL)
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		bind_framebuffer(rd, rd->offscreen.fbo);
 	else
-		glBindFramebuffer(GL_FRAMEBUFFER, obj->id);
+		bind_framebuffer(rd, obj->id);
 }
 
 // ---------- Raster states ----------
@@ -447,9 +896,8 @@ static mrl_error_t create_raster_state(mrl_render_device_t* brd, mrl_raster_stat
 
 	// Allocate object
 	mrl_ogl_330_raster_state_t* obj;
-	mgl_error_t err = mgl_allocate(
-		&rd->memory.raster_state.pool,
-		sizeof(*obj),
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.raster_state,
 		(void**)&obj);
 	if (err != MGL_ERROR_NONE)
 		return mrl_make_mgl_error(err);
@@ -465,7 +913,7 @@ static mrl_error_t create_raster_state(mrl_render_device_t* brd, mrl_raster_stat
 		obj->cull_face = GL_FRONT_AND_BACK;
 	else
 	{
-		mgl_deallocate(&rd->memory.raster_state.pool, obj);
+		mrl_deallocate_object(&rd->memory.raster_state, obj);
 		if (rd->error_callback != NULL)
 			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create raster state: invalid cull face");
 		return MRL_ERROR_INVALID_PARAMS;
@@ -477,19 +925,19 @@ static mrl_error_t create_raster_state(mrl_render_device_t* brd, mrl_raster_stat
 		obj->front_face = GL_CCW;
 	else
 	{
-		mgl_deallocate(&rd->memory.raster_state.pool, obj);
+		mrl_deallocate_object(&rd->memory.raster_state, obj);
 		if (rd->error_callback != NULL)
 			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create raster state: invalid front face winding order");
 		return MRL_ERROR_INVALID_PARAMS;
 	}
 
 	if (desc->raster_mode == MRL_RASTER_MODE_FILL)
-		obj->front_face = GL_FILL;
+		obj->polygon_mode = GL_FILL;
 	else  if (desc->raster_mode == MRL_RASTER_MODE_WIREFRAME)
-		obj->front_face = GL_LINE;
+		obj->polygon_mode = GL_LINE;
 	else
 	{
-		mgl_deallocate(&rd->memory.raster_state.pool, obj);
+		mrl_deallocate_object(&rd->memory.raster_state, obj);
 		if (rd->error_callback != NULL)
 			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create raster state: invalid rasterizer mode");
 		return MRL_ERROR_INVALID_PARAMS;
@@ -505,9 +953,13 @@ static void destroy_raster_state(mrl_render_device_t* brd, mrl_raster_state_t* r
 	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
 	mrl_ogl_330_raster_state_t* obj = (mrl_ogl_330_raster_state_t*)rs;
 
+	// The same address may be reused by a different state object
+	if (rd->cache.raster_state == obj)
+		rd->cache.raster_state = NULL;
+
 	// Deallocate object
-	mgl_deallocate(
-		&rd->memory.raster_state.pool,
+	mrl_deallocate_object(
+		&rd->memory.raster_state,
 		obj);
 }
 
@@ -519,18 +971,43 @@ static void set_raster_state(mrl_render_device_t* brd, mrl_raster_state_t* rs)
 	if (obj == NULL)
 		obj = &rd->default_raster_state;
 
-	// Set raster state
+	// Skip if the state is already set
+	if (rd->cache.raster_state == obj)
+		return;
+	rd->cache.raster_state = obj;
+
+	// Set raster state, only changing what differs from the current state
 	if (obj->cull_enabled)
 	{
-		glEnable(GL_CULL_FACE);
+		if (rd->cache.cull_enabled != GL_TRUE)
+		{
+			glEnable(GL_CULL_FACE);
+			rd->cache.cull_enabled = GL_TRUE;
+		}
+
+		if (rd->cache.cull_face != obj->cull_face)
+		{
+			glCullFace(obj->cull_face);
+			rd->cache.cull_face = obj->cull_face;
+		}
 
-		glCullFace(obj->cull_face);
-		glFrontFace(obj->front_face);
+		if (rd->cache.front_face != obj->front_face)
+		{
+			glFrontFace(obj->front_face);
+			rd->cache.front_face = obj->front_face;
+		}
 	}
-	else 
+	else if (rd->cache.cull_enabled != GL_FALSE)
+	{
 		glDisable(GL_CULL_FACE);
+		rd->cache.cull_enabled = GL_FALSE;
+	}
 
-	glPolygonMode(GL_FRONT_AND_BACK, obj->polygon_mode);
+	if (rd->cache.polygon_mode != obj->polygon_mode)
+	{
+		glPolygonMode(GL_FRONT_AND_BACK, obj->polygon_mode);
+		rd->cache.polygon_mode = obj->polygon_mode;
+	}
 }
 
 // ---------- Depth stencil states ----------
@@ -544,9 +1021,8 @@ static mrl_error_t create_depth_stencil_state(mrl_render_device_t* brd, mrl_dept
 
 	// Allocate object
 	mrl_ogl_330_depth_stencil_state_t* obj;
-	mgl_error_t err = mgl_allocate(
-		&rd->memory.depth_stencil_state.pool,
-		sizeof(*obj),
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.depth_stencil_state,
 		(void**)&obj);
 	if (err != MGL_ERROR_NONE)
 		return mrl_make_mgl_error(err);
@@ -568,7 +1044,7 @@ static mrl_error_t create_depth_stencil_state(mrl_render_device_t* brd, mrl_dept
 		case MRL_COMPARE_NEQUAL: obj->depth_func = GL_NOTEQUAL; break;
 		case MRL_COMPARE_ALWAYS: obj->depth_func = GL_ALWAYS; break;
 		default:
-			mgl_deallocate(&rd->memory.depth_stencil_state.pool, obj);
+			mrl_deallocate_object(&rd->memory.depth_stencil_state, obj);
 			if (rd->error_callback != NULL)
 				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create depth stencil state: invalid depth compare function");
 			return MRL_ERROR_INVALID_PARAMS;
@@ -591,7 +1067,7 @@ static mrl_error_t create_depth_stencil_state(mrl_render_device_t* brd, mrl_dept
 		case MRL_COMPARE_NEQUAL: obj->front_stencil_func = GL_NOTEQUAL; break;
 		case MRL_COMPARE_ALWAYS: obj->front_stencil_func = GL_ALWAYS; break;
 		default:
-			mgl_deallocate(&rd->memory.depth_stencil_state.pool, obj);
+			mrl_deallocate_object(&rd->memory.depth_stencil_state, obj);
 			if (rd->error_callback != NULL)
 				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create depth stencil state: invalid front face stencil compare function");
 			return MRL_ERROR_INVALID_PARAMS;
@@ -608,7 +1084,7 @@ static mrl_error_t create_depth_stencil_state(mrl_render_device_t* brd, mrl_dept
 		case MRL_ACTION_DECREMENT_WRAP: obj->front_face_stencil_fail = GL_DECR_WRAP; break;
 		case MRL_ACTION_INVERT: obj->front_face_stencil_fail = GL_INVERT; break;
 		default:
-			mgl_deallocate(&rd->memory.depth_stencil_state.pool, obj);
+			mrl_deallocate_object(&rd->memory.depth_stencil_state, obj);
 			if (rd->error_callback != NULL)
 				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create depth stencil state: invalid front face stencil fail action");
 			return MRL_ERROR_INVALID_PARAMS;
@@ -625,7 +1101,7 @@ static mrl_error_t create_depth_stencil_state(mrl_render_device_t* brd, mrl_dept
 		case MRL_ACTION_DECREMENT_WRAP: obj->front_face_stencil_pass = GL_DECR_WRAP; break;
 		case MRL_ACTION_INVERT: obj->front_face_stencil_pass = GL_INVERT; break;
 		default:
-			mgl_deallocate(&rd->memory.depth_stencil_state.pool, obj);
+			mrl_deallocate_object(&rd->memory.depth_stencil_state, obj);
 			if (rd->error_callback != NULL)
 				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create depth stencil state: invalid front face stencil pass action");
 			return MRL_ERROR_INVALID_PARAMS;
@@ -642,7 +1118,7 @@ static mrl_error_t create_depth_stencil_state(mrl_render_device_t* brd, mrl_dept
 		case MRL_ACTION_DECREMENT_WRAP: obj->front_face_depth_fail = GL_DECR_WRAP; break;
 		case MRL_ACTION_INVERT: obj->front_face_depth_fail = GL_INVERT; break;
 		default:
-			mgl_deallocate(&rd->memory.depth_stencil_state.pool, obj);
+			mrl_deallocate_object(&rd->memory.depth_stencil_state, obj);
 			if (rd->error_callback != NULL)
 				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create depth stencil state: invalid front face depth fail action");
 			return MRL_ERROR_INVALID_PARAMS;
@@ -659,7 +1135,7 @@ static mrl_error_t create_depth_stencil_state(mrl_render_device_t* brd, mrl_dept
 		case MRL_COMPARE_NEQUAL: obj->back_stencil_func = GL_NOTEQUAL; break;
 		case MRL_COMPARE_ALWAYS: obj->back_stencil_func = GL_ALWAYS; break;
 		default:
-			mgl_deallocate(&rd->memory.depth_stencil_state.pool, obj);
+			mrl_deallocate_object(&rd->memory.depth_stencil_state, obj);
 			if (rd->error_callback != NULL)
 				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create depth stencil state: invalid back face stencil compare function");
 			return MRL_ERROR_INVALID_PARAMS;
@@ -676,7 +1152,7 @@ static mrl_error_t create_depth_stencil_state(mrl_render_device_t* brd, mrl_dept
 		case MRL_ACTION_DECREMENT_WRAP: obj->back_face_stencil_fail = GL_DECR_WRAP; break;
 		case MRL_ACTION_INVERT: obj->back_face_stencil_fail = GL_INVERT; break;
 		default:
-			mgl_deallocate(&rd->memory.depth_stencil_state.pool, obj);
+			mrl_deallocate_object(&rd->memory.depth_stencil_state, obj);
 			if (rd->error_callback != NULL)
 				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create depth stencil state: invalid back face stencil fail action");
 			return MRL_ERROR_INVALID_PARAMS;
@@ -693,7 +1169,7 @@ static mrl_error_t create_depth_stencil_state(mrl_render_device_t* brd, mrl_dept
 		case MRL_ACTION_DECREMENT_WRAP: obj->back_face_stencil_pass = GL_DECR_WRAP; break;
 		case MRL_ACTION_INVERT: obj->back_face_stencil_pass = GL_INVERT; break;
 		default:
-			mgl_deallocate(&rd->memory.depth_stencil_state.pool, obj);
+			mrl_deallocate_object(&rd->memory.depth_stencil_state, obj);
 			if (rd->error_callback != NULL)
 				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create depth stencil state: invalid back face stencil pass action");
 			return MRL_ERROR_INVALID_PARAMS;
@@ -710,7 +1186,7 @@ static mrl_error_t create_depth_stencil_state(mrl_render_device_t* brd, mrl_dept
 		case MRL_ACTION_DECREMENT_WRAP: obj->back_face_depth_fail = GL_DECR_WRAP; break;
 		case MRL_ACTION_INVERT: obj->back_face_depth_fail = GL_INVERT; break;
 		default:
-			mgl_deallocate(&rd->memory.depth_stencil_state.pool, obj);
+			mrl_deallocate_object(&rd->memory.depth_stencil_state, obj);
 			if (rd->error_callback != NULL)
 				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create depth stencil state: invalid back face depth fail action");
 			return MRL_ERROR_INVALID_PARAMS;
@@ -726,49 +1202,117 @@ static void destroy_depth_stencil_state(mrl_render_device_t* brd, mrl_depth_sten
 	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
 	mrl_ogl_330_depth_stencil_state_t* obj = (mrl_ogl_330_depth_stencil_state_t*)dss;
 
+	// The same address may be reused by a different state object
+	if (rd->cache.depth_stencil_state == obj)
+		rd->cache.depth_stencil_state = NULL;
+
 	// Deallocate object
-	mgl_deallocate(
-		&rd->memory.depth_stencil_state.pool,
+	mrl_deallocate_object(
+		&rd->memory.depth_stencil_state,
 		obj);
 }
 
+static void set_stencil_face_state(
+	mrl_ogl_330_render_device_t* rd,
+	GLenum face,
+	mgl_u32_t index,
+	GLenum func,
+	GLuint ref,
+	GLuint read_mask,
+	GLuint write_mask,
+	GLenum stencil_fail,
+	GLenum depth_fail,
+	GLenum stencil_pass)
+{
+	mgl_bool_t valid = rd->cache.stencil_valid;
+
+	if (!valid ||
+		rd->cache.stencil[index].func != func ||
+		rd->cache.stencil[index].ref != ref ||
+		rd->cache.stencil[index].read_mask != read_mask)
+		glStencilFuncSeparate(face, func, (GLint)ref, read_mask);
+
+	if (!valid || rd->cache.stencil[index].write_mask != write_mask)
+		glStencilMaskSeparate(face, write_mask);
+
+	if (!valid ||
+		rd->cache.stencil[index].stencil_fail != stencil_fail ||
+		rd->cache.stencil[index].depth_fail != depth_fail ||
+		rd->cache.stencil[index].stencil_pass != stencil_pass)
+		glStencilOpSeparate(face, stencil_fail, depth_fail, stencil_pass);
+
+	rd->cache.stencil[index].func = func;
+	rd->cache.stencil[index].ref = ref;
+	rd->cache.stencil[index].read_mask = read_mask;
+	rd->cache.stencil[index].write_mask = write_mask;
+	rd->cache.stencil[index].stencil_fail = stencil_fail;
+	rd->cache.stencil[index].depth_fail = depth_fail;
+	rd->cache.stencil[index].stencil_pass = stencil_pass;
+}
+
 static void set_depth_stencil_state(mrl_render_device_t* brd, mrl_depth_stencil_state_t* dss)
 {
 	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
 	mrl_ogl_330_depth_stencil_state_t* obj = (mrl_ogl_330_depth_stencil_state_t*)dss;
 
-	// Set depth state
-
 	if (obj == NULL)
 		obj = &rd->default_depth_stencil_state;
 
+	// Skip if the state is already set
+	if (rd->cache.depth_stencil_state == obj)
+		return;
+	rd->cache.depth_stencil_state = obj;
+
+	// Set depth state, only changing what differs from the current state
 	if (obj->depth_enabled)
 	{
-		glEnable(GL_DEPTH_TEST);
+		if (rd->cache.depth_enabled != GL_TRUE)
+		{
+			glEnable(GL_DEPTH_TEST);
+			rd->cache.depth_enabled = GL_TRUE;
+		}
 
-		glDepthFunc(obj->depth_func);
-		glDepthMask(obj->depth_write_enabled ? GL_TRUE : GL_FALSE);
-		glDepthRange(obj->depth_near, obj->depth_far);
+		GLboolean depth_write_enabled = obj->depth_write_enabled ? GL_TRUE : GL_FALSE;
+
+		if (!rd->cache.depth_valid || rd->cache.depth_func != obj->depth_func)
+			glDepthFunc(obj->depth_func);
+		if (!rd->cache.depth_valid || rd->cache.depth_write_enabled != depth_write_enabled)
+			glDepthMask(depth_write_enabled);
+		if (!rd->cache.depth_valid || rd->cache.depth_near != obj->depth_near || rd->cache.depth_far != obj->depth_far)
+			glDepthRange(obj->depth_near, obj->depth_far);
+
+		rd->cache.depth_valid = MGL_TRUE;
+		rd->cache.depth_func = obj->depth_func;
+		rd->cache.depth_write_enabled = depth_write_enabled;
+		rd->cache.depth_near = obj->depth_near;
+		rd->cache.depth_far = obj->depth_far;
 	}
-	else
+	else if (rd->cache.depth_enabled != GL_FALSE)
+	{
 		glDisable(GL_DEPTH_TEST);
+		rd->cache.depth_enabled = GL_FALSE;
+	}
 
-	// Set stencil state
-
+	// Set stencil state, only changing what differs from the current state
 	if (obj->stencil_enabled)
 	{
-		glEnable(GL_STENCIL_TEST);
-
-		glStencilFuncSeparate(GL_FRONT, obj->front_stencil_func, obj->stencil_ref, obj->stencil_read_mask);
-		glStencilMaskSeparate(GL_FRONT, obj->stencil_write_mask);
-		glStencilOpSeparate(GL_FRONT, obj->front_face_stencil_fail, obj->front_face_depth_fail, obj->front_face_stencil_pass);
+		if (rd->cache.stencil_enabled != GL_TRUE)
+		{
+			glEnable(GL_STENCIL_TEST);
+			rd->cache.stencil_enabled = GL_TRUE;
+		}
 
-		glStencilFuncSeparate(GL_BACK, obj->back_stencil_func, obj->stencil_ref, obj->stencil_read_mask);
-		glStencilMaskSeparate(GL_BACK, obj->stencil_write_mask);
-		glStencilOpSeparate(GL_BACK, obj->back_face_stencil_fail, obj->back_face_depth_fail, obj->back_face_stencil_pass);
+		set_stencil_face_state(rd, GL_FRONT, 0, obj->front_stencil_func, obj->stencil_ref, obj->stencil_read_mask, obj->stencil_write_mask,
+							   obj->front_face_stencil_fail, obj->front_face_depth_fail, obj->front_face_stencil_pass);
+		set_stencil_face_state(rd, GL_BACK, 1, obj->back_stencil_func, obj->stencil_ref, obj->stencil_read_mask, obj->stencil_write_mask,
+							   obj->back_face_stencil_fail, obj->back_face_depth_fail, obj->back_face_stencil_pass);
+		rd->cache.stencil_valid = MGL_TRUE;
 	}
-	else
+	else if (rd->cache.stencil_enabled != GL_FALSE)
+	{
 		glDisable(GL_STENCIL_TEST);
+		rd->cache.stencil_enabled = GL_FALSE;
+	}
 }
 
 // ---------- Blend states ----------
@@ -779,9 +1323,8 @@ static mrl_error_t create_blend_state(mrl_render_device_t* brd, mrl_blend_state_
 
 	// Allocate object
 	mrl_ogl_330_blend_state_t* obj;
-	mgl_error_t err = mgl_allocate(
-		&rd->memory.blend_state.pool,
-		sizeof(*obj),
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.blend_state,
 		(void**)&obj);
 	if (err != MGL_ERROR_NONE)
 		return mrl_make_mgl_error(err);
@@ -802,7 +1345,7 @@ static mrl_error_t create_blend_state(mrl_render_device_t* brd, mrl_blend_state_
 		case MRL_BLEND_FACTOR_DST_ALPHA: obj->src_alpha_factor = GL_DST_ALPHA; break;
 		case MRL_BLEND_FACTOR_INV_DST_ALPHA: obj->src_alpha_factor = GL_ONE_MINUS_DST_ALPHA; break;
 		default:
-			mgl_deallocate(&rd->memory.blend_state.pool, obj);
+			mrl_deallocate_object(&rd->memory.blend_state, obj);
 			if (rd->error_callback != NULL)
 				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create blend state: invalid alpha source factor");
 			return MRL_ERROR_INVALID_PARAMS;
@@ -821,7 +1364,7 @@ static mrl_error_t create_blend_state(mrl_render_device_t* brd, mrl_blend_state_
 		case MRL_BLEND_FACTOR_DST_ALPHA: obj->dst_alpha_factor = GL_DST_ALPHA; break;
 		case MRL_BLEND_FACTOR_INV_DST_ALPHA: obj->dst_alpha_factor = GL_ONE_MINUS_DST_ALPHA; break;
 		default:
-			mgl_deallocate(&rd->memory.blend_state.pool, obj);
+			mrl_deallocate_object(&rd->memory.blend_state, obj);
 			if (rd->error_callback != NULL)
 				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create blend state: invalid alpha destination factor");
 			return MRL_ERROR_INVALID_PARAMS;
@@ -835,7 +1378,7 @@ static mrl_error_t create_blend_state(mrl_render_device_t* brd, mrl_blend_state_
 		case MRL_BLEND_OP_MAX: obj->alpha_blend_op = GL_MAX; break;
 		case MRL_BLEND_OP_MIN: obj->alpha_blend_op = GL_MIN; break;
 		default:
-			mgl_deallocate(&rd->memory.blend_state.pool, obj);
+			mrl_deallocate_object(&rd->memory.blend_state, obj);
 			if (rd->error_callback != NULL)
 				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create blend state: invalid alpha blend operation");
 			return MRL_ERROR_INVALID_PARAMS;
@@ -854,7 +1397,7 @@ static mrl_error_t create_blend_state(mrl_render_device_t* brd, mrl_blend_state_
 		case MRL_BLEND_FACTOR_DST_ALPHA: obj->src_factor = GL_DST_ALPHA; break;
 		case MRL_BLEND_FACTOR_INV_DST_ALPHA: obj->src_factor = GL_ONE_MINUS_DST_ALPHA; break;
 		default:
-			mgl_deallocate(&rd->memory.blend_state.pool, obj);
+			mrl_deallocate_object(&rd->memory.blend_state, obj);
 			if (rd->error_callback != NULL)
 				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create blend state: invalid color source factor");
 			return MRL_ERROR_INVALID_PARAMS;
@@ -873,7 +1416,7 @@ static mrl_error_t create_blend_state(mrl_render_device_t* brd, mrl_blend_state_
 		case MRL_BLEND_FACTOR_DST_ALPHA: obj->dst_factor = GL_DST_ALPHA; break;
 		case MRL_BLEND_FACTOR_INV_DST_ALPHA: obj->dst_factor = GL_ONE_MINUS_DST_ALPHA; break;
 		default:
-			mgl_deallocate(&rd->memory.blend_state.pool, obj);
+			mrl_deallocate_object(&rd->memory.blend_state, obj);
 			if (rd->error_callback != NULL)
 				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create blend state: invalid color destination factor");
 			return MRL_ERROR_INVALID_PARAMS;
@@ -887,7 +1430,7 @@ static mrl_error_t create_blend_state(mrl_render_device_t* brd, mrl_blend_state_
 		case MRL_BLEND_OP_MAX: obj->blend_op = GL_MAX; break;
 		case MRL_BLEND_OP_MIN: obj->blend_op = GL_MIN; break;
 		default:
-			mgl_deallocate(&rd->memory.blend_state.pool, obj);
+			mrl_deallocate_object(&rd->memory.blend_state, obj);
 			if (rd->error_callback != NULL)
 				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create blend state: invalid color blend operation");
 			return MRL_ERROR_INVALID_PARAMS;
@@ -903,9 +1446,13 @@ static void destroy_blend_state(mrl_render_device_t* brd, mrl_blend_state_t* bs)
 	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
 	mrl_ogl_330_blend_state_t* obj = (mrl_ogl_330_blend_state_t*)bs;
 
+	// The same address may be reused by a different state object
+	if (rd->cache.blend_state == obj)
+		rd->cache.blend_state = NULL;
+
 	// Deallocate object
-	mgl_deallocate(
-		&rd->memory.blend_state.pool,
+	mrl_deallocate_object(
+		&rd->memory.blend_state,
 		obj);
 }
 
@@ -917,22 +1464,53 @@ static void set_blend_state(mrl_render_device_t* brd, mrl_blend_state_t* bs)
 	if (obj == NULL)
 		obj = &rd->default_blend_state;
 
-	// Set blend state
+	// Skip if the state is already set
+	if (rd->cache.blend_state == obj)
+		return;
+	rd->cache.blend_state = obj;
+
+	// Set blend state, only changing what differs from the current state
 	if (!obj->blend_enabled)
-		glDisable(GL_BLEND);
+	{
+		if (rd->cache.blend_enabled != GL_FALSE)
+		{
+			glDisable(GL_BLEND);
+			rd->cache.blend_enabled = GL_FALSE;
+		}
+	}
 	else
 	{
-		glEnable(GL_BLEND);
-
-		glBlendFuncSeparate(
-			obj->src_factor,
-			obj->dst_factor,
-			obj->src_alpha_factor,
-			obj->dst_alpha_factor);
+		if (rd->cache.blend_enabled != GL_TRUE)
+		{
+			glEnable(GL_BLEND);
+			rd->cache.blend_enabled = GL_TRUE;
+		}
 
-		glBlendEquationSeparate(
-			obj->blend_op,
-			obj->alpha_blend_op);
+		if (!rd->cache.blend_valid ||
+			rd->cache.src_factor != obj->src_factor ||
+			rd->cache.dst_factor != obj->dst_factor ||
+			rd->cache.src_alpha_factor != obj->src_alpha_factor ||
+			rd->cache.dst_alpha_factor != obj->dst_alpha_factor)
+			glBlendFuncSeparate(
+				obj->src_factor,
+				obj->dst_factor,
+				obj->src_alpha_factor,
+				obj->dst_alpha_factor);
+
+		if (!rd->cache.blend_valid ||
+			rd->cache.blend_op != obj->blend_op ||
+			rd->cache.alpha_blend_op != obj->alpha_blend_op)
+			glBlendEquationSeparate(
+				obj->blend_op,
+				obj->alpha_blend_op);
+
+		rd->cache.blend_valid = MGL_TRUE;
+		rd->cache.src_factor = obj->src_factor;
+		rd->cache.dst_factor = obj->dst_factor;
+		rd->cache.src_alpha_factor = obj->src_alpha_factor;
+		rd->cache.dst_alpha_factor = obj->dst_alpha_factor;
+		rd->cache.blend_op = obj->blend_op;
+		rd->cache.alpha_blend_op = obj->alpha_blend_op;
 	}
 }
 
@@ -1046,7 +1624,7 @@ static mrl_error_t create_sampler(mrl_render_device_t* brd, mrl_sampler_t** s, c
 	glSamplerParameterfv(id, GL_TEXTURE_BORDER_COLOR, desc->border_color);
 
 	// Check errors
-	GLenum gl_err = glGetError();
+	GLenum gl_err = get_gl_error(rd);
 	if (gl_err != 0)
 	{
 		glDeleteBuffers(1, &id);
@@ -1057,9 +1635,8 @@ static mrl_error_t create_sampler(mrl_render_device_t* brd, mrl_sampler_t** s, c
 
 	// Allocate object
 	mrl_ogl_330_sampler_t* obj;
-	mgl_error_t err = mgl_allocate(
-		&rd->memory.sampler.pool,
-		sizeof(*obj),
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.sampler,
 		(void**)&obj);
 	if (err != MGL_ERROR_NONE)
 	{
@@ -1080,11 +1657,14 @@ static void destroy_sampler(mrl_render_device_t* brd, mrl_sampler_t* s)
 	mrl_ogl_330_sampler_t* obj = (mrl_ogl_330_sampler_t*)s;
 
 	// Delete sampler
-	glDeleteBuffers(1, &obj->id);
+	glDeleteSamplers(1, &obj->id);
+	for (mgl_u32_t i = 0; i < MRL_OGL_330_MAX_CACHED_TEXTURE_UNIT_COUNT; ++i)
+		if (rd->cache.samplers[i] == obj->id)
+			rd->cache.samplers[i] = 0;
 
 	// Deallocate object
-	mgl_deallocate(
-		&rd->memory.sampler.pool,
+	mrl_deallocate_object(
+		&rd->memory.sampler,
 		obj);
 }
 
@@ -1094,11 +1674,215 @@ static void bind_sampler(mrl_render_device_t* brd, mrl_shader_binding_point_t* b
 	mrl_ogl_330_sampler_t* obj = (mrl_ogl_330_sampler_t*)s;
 	mrl_ogl_330_shader_binding_point_t* rbp = (mrl_ogl_330_shader_binding_point_t*)bp;
 
-	// Bind sampler
+	// Bind sampler to the unit assigned to the sampler uniform
+	MGL_DEBUG_ASSERT(rbp->unit >= 0);
 	if (s == NULL)
-		glBindSampler(rbp->loc, 0);
+		bind_sampler_unit(rd, (GLuint)rbp->unit, 0);
 	else
-		glBindSampler(rbp->loc, obj->id);
+		bind_sampler_unit(rd, (GLuint)rbp->unit, obj->id);
+}
+
+// ---------- Textures ----------
+
+// Size of a mip level, which is never smaller than 1 texel
+static GLsizei get_mip_size(mgl_u64_t size, mgl_u32_t level)
+{
+	size >>= level;
+	return size == 0 ? 1 : (GLsizei)size;
+}
+
+// Checks if the mip chain fits the texture size, so that it can be allocated all at once
+static mgl_bool_t check_mip_chain(mrl_ogl_330_render_device_t* rd, mgl_u32_t mip_level_count, mgl_u64_t width, mgl_u64_t height, mgl_u64_t depth, const mgl_chr8_t* msg)
+{
+	mgl_u64_t max_size = width;
+	if (height > max_size)
+		max_size = height;
+	if (depth > max_size)
+		max_size = depth;
+
+	// Number of levels down to 1x1x1
+	mgl_u32_t max_mip_level_count = 1;
+	while (max_size > 1)
+	{
+		max_size >>= 1;
+		++max_mip_level_count;
+	}
+
+	if (width == 0 || height == 0 || depth == 0 || mip_level_count == 0 || mip_level_count > MRL_MAX_MIP_LEVEL_COUNT || mip_level_count > max_mip_level_count)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, msg);
+		return MGL_FALSE;
+	}
+
+	return MGL_TRUE;
+}
+
+// Immutable storage can't grow, so a texture created with a single mip level never gets a mip chain
+static mgl_bool_t check_mip_generation(mrl_ogl_330_render_device_t* rd, mgl_u32_t mip_level_count, mgl_u64_t width, mgl_u64_t height, mgl_u64_t depth, const mgl_chr8_t* msg)
+{
+	if (mip_level_count == 1 && (width > 1 || height > 1 || depth > 1))
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, msg);
+		return MGL_FALSE;
+	}
+
+	return MGL_TRUE;
+}
+
+// Limits sampling to the allocated mip levels, so that textures with partial chains are still complete
+static void set_texture_mip_range(GLenum target, mgl_u32_t mip_level_count)
+{
+	glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, 0);
+	glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, (GLint)mip_level_count - 1);
+}
+
+// Gets the internal format of a compressed format, with a zero format and type, which marks the data as compressed.
+// Formats the driver doesn't support are decoded on the CPU, and get the internal format, format and type of the decoded data.
+static void get_compressed_format(mrl_ogl_330_render_device_t* rd, mgl_enum_t texture_format, GLenum* internal_format, GLenum* format, GLenum* type)
+{
+	*internal_format = 0;
+	*format = 0;
+	*type = 0;
+
+	// RGTC is core since OpenGL 3.0
+	switch (texture_format)
+	{
+		case MRL_TEXTURE_FORMAT_BC1_UN: if (rd->limits.texture_compression_s3tc) *internal_format = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT; break;
+		case MRL_TEXTURE_FORMAT_BC2_UN: if (rd->limits.texture_compression_s3tc) *internal_format = GL_COMPRESSED_RGBA_S3TC_DXT3_EXT; break;
+		case MRL_TEXTURE_FORMAT_BC3_UN: if (rd->limits.texture_compression_s3tc) *internal_format = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; break;
+		case MRL_TEXTURE_FORMAT_BC4_UN: *internal_format = GL_COMPRESSED_RED_RGTC1; break;
+		case MRL_TEXTURE_FORMAT_BC4_SN: *internal_format = GL_COMPRESSED_SIGNED_RED_RGTC1; break;
+		case MRL_TEXTURE_FORMAT_BC5_UN: *internal_format = GL_COMPRESSED_RG_RGTC2; break;
+		case MRL_TEXTURE_FORMAT_BC5_SN: *internal_format = GL_COMPRESSED_SIGNED_RG_RGTC2; break;
+		case MRL_TEXTURE_FORMAT_BC6H_UF: if (rd->limits.texture_compression_bptc) *internal_format = GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT; break;
+		case MRL_TEXTURE_FORMAT_BC6H_SF: if (rd->limits.texture_compression_bptc) *internal_format = GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT; break;
+		case MRL_TEXTURE_FORMAT_BC7_UN: if (rd->limits.texture_compression_bptc) *internal_format = GL_COMPRESSED_RGBA_BPTC_UNORM; break;
+		case MRL_TEXTURE_FORMAT_ETC2_RGB8_UN: if (rd->limits.texture_compression_etc2) *internal_format = GL_COMPRESSED_RGB8_ETC2; break;
+		case MRL_TEXTURE_FORMAT_ETC2_RGB8A1_UN: if (rd->limits.texture_compression_etc2) *internal_format = GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2; break;
+		case MRL_TEXTURE_FORMAT_ETC2_RGBA8_UN: if (rd->limits.texture_compression_etc2) *internal_format = GL_COMPRESSED_RGBA8_ETC2_EAC; break;
+		default: break;
+	}
+
+	if (*internal_format != 0)
+		return;
+
+	// Only BC6H decodes to floats, BC4 and BC5 are always supported
+	if (mrl_get_decoded_format(texture_format) == MRL_TEXTURE_FORMAT_RGBA32_F)
+	{
+		*internal_format = GL_RGBA16F;
+		*format = GL_RGBA;
+		*type = GL_FLOAT;
+	}
+	else
+	{
+		*internal_format = GL_RGBA8;
+		*format = GL_RGBA;
+		*type = GL_UNSIGNED_BYTE;
+	}
+}
+
+// Checks if a texture stores compressed data which the driver reads as is
+static mgl_bool_t is_native_compressed_format(mgl_enum_t texture_format, GLenum format)
+{
+	return mrl_is_compressed_format(texture_format) && format == 0;
+}
+
+// Allocates a mip level of a 2D image without immutable storage
+static void allocate_image_2d(GLenum target, mgl_u32_t level, mgl_enum_t texture_format, GLenum internal_format, GLenum format, GLenum type, GLsizei width, GLsizei height)
+{
+	if (is_native_compressed_format(texture_format, format))
+		glCompressedTexImage2D(target, level, internal_format, width, height, 0, (GLsizei)mrl_get_compressed_data_size(texture_format, width, height, 1), NULL);
+	else
+		glTexImage2D(target, level, internal_format, width, height, 0, format, type, NULL);
+}
+
+// Gets the pixels passed to a 2D image transfer. Compressed data the driver doesn't support is decoded into a temporary image,
+// with rows padded to the default unpack alignment, which must be freed with release_image_2d
+static mrl_error_t prepare_image_2d(mrl_ogl_330_render_device_t* rd, mgl_enum_t texture_format, GLenum format, mgl_u64_t width, mgl_u64_t height, const void* data, const void** pixels)
+{
+	*pixels = data;
+	if (!mrl_is_compressed_format(texture_format) || format == 0)
+		return MRL_ERROR_NONE;
+
+	mgl_u64_t row_pitch = (width * mrl_get_decoded_texel_size(texture_format) + 3) & ~(mgl_u64_t)3;
+	void* decoded;
+	mgl_error_t err = mgl_allocate(rd->allocator, row_pitch * height, &decoded);
+	if (err != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(err);
+
+	mrl_decode_texture(texture_format, width, height, data, decoded, row_pitch);
+	*pixels = decoded;
+	return MRL_ERROR_NONE;
+}
+
+static void release_image_2d(mrl_ogl_330_render_device_t* rd, const void* data, const void* pixels)
+{
+	if (pixels != data)
+		mgl_deallocate(rd->allocator, (void*)pixels);
+}
+
+// Transfers prepared pixels to a region of a 2D image
+static void transfer_image_2d(GLenum target, mgl_u32_t level, mgl_enum_t texture_format, GLenum internal_format, GLenum format, GLenum type, mgl_u64_t x, mgl_u64_t y, mgl_u64_t width, mgl_u64_t height, const void* pixels)
+{
+	if (is_native_compressed_format(texture_format, format))
+		glCompressedTexSubImage2D(target, level, (GLint)x, (GLint)y, (GLsizei)width, (GLsizei)height, internal_format, (GLsizei)mrl_get_compressed_data_size(texture_format, width, height, 1), pixels);
+	else
+		glTexSubImage2D(target, level, (GLint)x, (GLint)y, (GLsizei)width, (GLsizei)height, format, type, pixels);
+}
+
+// Updates a region of a 2D image from client memory
+static mrl_error_t update_image_2d(mrl_ogl_330_render_device_t* rd, GLenum target, mgl_u32_t level, mgl_enum_t texture_format, GLenum internal_format, GLenum format, GLenum type, mgl_u64_t x, mgl_u64_t y, mgl_u64_t width, mgl_u64_t height, const void* data)
+{
+	const void* pixels;
+	mrl_error_t err = prepare_image_2d(rd, texture_format, format, width, height, data, &pixels);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	transfer_image_2d(target, level, texture_format, internal_format, format, type, x, y, width, height, pixels);
+	release_image_2d(rd, data, pixels);
+	return MRL_ERROR_NONE;
+}
+
+// Allocates a mip level of a layered 2D image without immutable storage
+static void allocate_image_layers(GLenum target, mgl_u32_t level, mgl_enum_t texture_format, GLenum internal_format, GLenum format, GLenum type, GLsizei width, GLsizei height, GLsizei layer_count)
+{
+	if (is_native_compressed_format(texture_format, format))
+		glCompressedTexImage3D(target, level, internal_format, width, height, layer_count, 0, (GLsizei)mrl_get_compressed_data_size(texture_format, width, height, layer_count), NULL);
+	else
+		glTexImage3D(target, level, internal_format, width, height, layer_count, 0, format, type, NULL);
+}
+
+// Updates a region of a range of layers of a layered 2D image from client memory.
+// Compressed data the driver doesn't support is decoded one layer at a time, the rest is transferred at once
+static mrl_error_t update_image_layers(mrl_ogl_330_render_device_t* rd, GLenum target, mgl_u32_t level, mgl_enum_t texture_format, GLenum internal_format, GLenum format, GLenum type, mgl_u64_t x, mgl_u64_t y, mgl_u64_t layer, mgl_u64_t width, mgl_u64_t height, mgl_u64_t layer_count, const void* data)
+{
+	if (is_native_compressed_format(texture_format, format))
+	{
+		glCompressedTexSubImage3D(target, level, (GLint)x, (GLint)y, (GLint)layer, (GLsizei)width, (GLsizei)height, (GLsizei)layer_count, internal_format, (GLsizei)mrl_get_compressed_data_size(texture_format, width, height, layer_count), data);
+		return MRL_ERROR_NONE;
+	}
+	else if (!mrl_is_compressed_format(texture_format))
+	{
+		glTexSubImage3D(target, level, (GLint)x, (GLint)y, (GLint)layer, (GLsizei)width, (GLsizei)height, (GLsizei)layer_count, format, type, data);
+		return MRL_ERROR_NONE;
+	}
+
+	mgl_u64_t layer_size = mrl_get_compressed_data_size(texture_format, width, height, 1);
+	for (mgl_u64_t i = 0; i < layer_count; ++i)
+	{
+		const void* layer_data = (const mgl_u8_t*)data + i * layer_size;
+		const void* pixels;
+		mrl_error_t err = prepare_image_2d(rd, texture_format, format, width, height, layer_data, &pixels);
+		if (err != MRL_ERROR_NONE)
+			return err;
+
+		glTexSubImage3D(target, level, (GLint)x, (GLint)y, (GLint)(layer + i), (GLsizei)width, (GLsizei)height, 1, format, type, pixels);
+		release_image_2d(rd, layer_data, pixels);
+	}
+
+	return MRL_ERROR_NONE;
 }
 
 // ---------- Texture 1D ----------
@@ -1112,8 +1896,8 @@ static mrl_error_t create_texture_1d(mrl_render_device_t* brd, mrl_texture_1d_t*
 
 	switch (desc->format)
 	{
-		case MRL_TEXTURE_FORMAT_R8_UN: internal_format = GL_R8; format = GL_R; type = GL_UNSIGNED_BYTE; break;
-		case MRL_TEXTURE_FORMAT_R8_SN: internal_format = GL_R8_SNORM; format = GL_R; type = GL_BYTE; break;
+		case MRL_TEXTURE_FORMAT_R8_UN: internal_format = GL_R8; format = GL_RED; type = GL_UNSIGNED_BYTE; break;
+		case MRL_TEXTURE_FORMAT_R8_SN: internal_format = GL_R8_SNORM; format = GL_RED; type = GL_BYTE; break;
 		case MRL_TEXTURE_FORMAT_R8_UI: internal_format = GL_R8UI; format = GL_RED_INTEGER; type = GL_UNSIGNED_BYTE; break;
 		case MRL_TEXTURE_FORMAT_R8_SI: internal_format = GL_R8I; format = GL_RED_INTEGER; type = GL_BYTE; break;
 		case MRL_TEXTURE_FORMAT_RG8_UN: internal_format = GL_RG8; format = GL_RG; type = GL_UNSIGNED_BYTE; break;
@@ -1125,8 +1909,8 @@ static mrl_error_t create_texture_1d(mrl_render_device_t* brd, mrl_texture_1d_t*
 		case MRL_TEXTURE_FORMAT_RGBA8_UI: internal_format = GL_RGBA8UI; format = GL_RGBA_INTEGER; type = GL_UNSIGNED_BYTE; break;
 		case MRL_TEXTURE_FORMAT_RGBA8_SI: internal_format = GL_RGBA8I; format = GL_RGBA_INTEGER; type = GL_BYTE; break;
 
-		case MRL_TEXTURE_FORMAT_R16_UN: internal_format = GL_R16; format = GL_R; type = GL_UNSIGNED_SHORT; break;
-		case MRL_TEXTURE_FORMAT_R16_SN: internal_format = GL_R16_SNORM; format = GL_R; type = GL_SHORT; break;
+		case MRL_TEXTURE_FORMAT_R16_UN: internal_format = GL_R16; format = GL_RED; type = GL_UNSIGNED_SHORT; break;
+		case MRL_TEXTURE_FORMAT_R16_SN: internal_format = GL_R16_SNORM; format = GL_RED; type = GL_SHORT; break;
 		case MRL_TEXTURE_FORMAT_R16_UI: internal_format = GL_R16UI; format = GL_RED_INTEGER; type = GL_UNSIGNED_SHORT; break;
 		case MRL_TEXTURE_FORMAT_R16_SI: internal_format = GL_R16I; format = GL_RED_INTEGER; type = GL_SHORT; break;
 		case MRL_TEXTURE_FORMAT_RG16_UN: internal_format = GL_RG16; format = GL_RG; type = GL_UNSIGNED_SHORT; break;
@@ -1140,7 +1924,7 @@ static mrl_error_t create_texture_1d(mrl_render_device_t* brd, mrl_texture_1d_t*
 
 		case MRL_TEXTURE_FORMAT_R32_UI: internal_format = GL_R32UI; format = GL_RED_INTEGER; type = GL_UNSIGNED_INT; break;
 		case MRL_TEXTURE_FORMAT_R32_SI: internal_format = GL_R32I; format = GL_RED_INTEGER; type = GL_INT; break;
-		case MRL_TEXTURE_FORMAT_R32_F: internal_format = GL_R32F; format = GL_R; type = GL_FLOAT; break;
+		case MRL_TEXTURE_FORMAT_R32_F: internal_format = GL_R32F; format = GL_RED; type = GL_FLOAT; break;
 		case MRL_TEXTURE_FORMAT_RG32_UI: internal_format = GL_RG32UI; format = GL_RG_INTEGER; type = GL_UNSIGNED_INT; break;
 		case MRL_TEXTURE_FORMAT_RG32_SI: internal_format = GL_RG32I; format = GL_RG_INTEGER; type = GL_INT; break;
 		case MRL_TEXTURE_FORMAT_RG32_F: internal_format = GL_RG32F; format = GL_RG; type = GL_FLOAT; break;
@@ -1162,12 +1946,26 @@ static mrl_error_t create_texture_1d(mrl_render_device_t* brd, mrl_texture_1d_t*
 			return MRL_ERROR_INVALID_PARAMS;
 	}
 
-	// Initialize texture
+	if (!check_mip_chain(rd, desc->mip_level_count, desc->width, 1, 1, u8"Failed to create 1D texture: invalid mip level count"))
+		return MRL_ERROR_INVALID_PARAMS;
+
+	// Initialize texture, with immutable storage if supported
 	GLuint id;
 	glGenTextures(1, &id);
-	glBindTexture(GL_TEXTURE_1D, id);
-	for (mgl_u32_t i = 0, div = 1; i < desc->mip_level_count; ++i, div *= 2)
-		glTexImage1D(GL_TEXTURE_1D, i, internal_format, (GLsizei)(desc->width / div), 0, format, type, desc->data[i]);
+	bind_texture(rd, GL_TEXTURE_1D, id);
+	if (rd->limits.texture_storage)
+	{
+		glTexStorage1D(GL_TEXTURE_1D, (GLsizei)desc->mip_level_count, internal_format, (GLsizei)desc->width);
+		for (mgl_u32_t i = 0; i < desc->mip_level_count; ++i)
+			if (desc->data[i] != NULL)
+				glTexSubImage1D(GL_TEXTURE_1D, i, 0, get_mip_size(desc->width, i), format, type, desc->data[i]);
+	}
+	else
+	{
+		for (mgl_u32_t i = 0; i < desc->mip_level_count; ++i)
+			glTexImage1D(GL_TEXTURE_1D, i, internal_format, get_mip_size(desc->width, i), 0, format, type, desc->data[i]);
+		set_texture_mip_range(GL_TEXTURE_1D, desc->mip_level_count);
+	}
 
 	glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -1176,10 +1974,11 @@ static mrl_error_t create_texture_1d(mrl_render_device_t* brd, mrl_texture_1d_t*
 	glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 
 	// Check errors
-	GLenum gl_err = glGetError();
+	GLenum gl_err = get_gl_error(rd);
 	if (gl_err != 0)
 	{
 		glDeleteTextures(1, &id);
+		forget_texture(rd, GL_TEXTURE_1D, id);
 		if (rd->error_callback != NULL)
 			rd->error_callback(MRL_ERROR_EXTERNAL, opengl_error_code_to_str(gl_err));
 		return MRL_ERROR_EXTERNAL;
@@ -1187,19 +1986,20 @@ static mrl_error_t create_texture_1d(mrl_render_device_t* brd, mrl_texture_1d_t*
 
 	// Allocate object
 	mrl_ogl_330_texture_1d_t* obj;
-	mgl_error_t err = mgl_allocate(
-		&rd->memory.texture_1d.pool,
-		sizeof(*obj),
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.texture_1d,
 		(void**)&obj);
 	if (err != MGL_ERROR_NONE)
 	{
 		glDeleteTextures(1, &id);
+		forget_texture(rd, GL_TEXTURE_1D, id);
 		return mrl_make_mgl_error(err);
 	}
 
 	// Store texture info
 	obj->id = id;
 	obj->width = desc->width;
+	obj->mip_level_count = desc->mip_level_count;
 	obj->internal_format = internal_format;
 	obj->format = format;
 	obj->type = type;
@@ -1215,10 +2015,11 @@ static void destroy_texture_1d(mrl_render_device_t* brd, mrl_texture_1d_t* tex)
 
 	// Delete texture
 	glDeleteTextures(1, &obj->id);
+	forget_texture(rd, GL_TEXTURE_1D, obj->id);
 
 	// Deallocate object
-	mgl_deallocate(
-		&rd->memory.texture_1d.pool,
+	mrl_deallocate_object(
+		&rd->memory.texture_1d,
 		obj);
 }
 
@@ -1227,7 +2028,10 @@ static void generate_texture_1d_mipmaps(mrl_render_device_t* brd, mrl_texture_2d
 	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
 	mrl_ogl_330_texture_1d_t* obj = (mrl_ogl_330_texture_1d_t*)tex;
 
-	glBindTexture(GL_TEXTURE_1D, obj->id);
+	if (!check_mip_generation(rd, obj->mip_level_count, obj->width, 1, 1, u8"Failed to generate 1D texture mipmaps: the texture was created with a single mip level"))
+		return;
+
+	bind_texture(rd, GL_TEXTURE_1D, obj->id);
 	glGenerateMipmap(GL_TEXTURE_1D);
 }
 
@@ -1237,13 +2041,12 @@ static void bind_texture_1d(mrl_render_device_t* brd, mrl_shader_binding_point_t
 	mrl_ogl_330_texture_1d_t* obj = (mrl_ogl_330_texture_1d_t*)tex;
 	mrl_ogl_330_shader_binding_point_t* rbp = (mrl_ogl_330_shader_binding_point_t*)bp;
 
-	// Bind texture
-	glActiveTexture(GL_TEXTURE0 + rbp->loc);
+	// Bind texture to the unit assigned to the sampler uniform
+	MGL_DEBUG_ASSERT(rbp->unit >= 0);
 	if (tex == NULL)
-		glBindTexture(GL_TEXTURE_1D, 0);
+		bind_texture_unit(rd, (GLuint)rbp->unit, GL_TEXTURE_1D, 0);
 	else
-		glBindTexture(GL_TEXTURE_1D, obj->id);
-	glUniform1i(rbp->loc, rbp->loc);
+		bind_texture_unit(rd, (GLuint)rbp->unit, GL_TEXTURE_1D, obj->id);
 }
 
 static mrl_error_t update_texture_1d(mrl_render_device_t* brd, mrl_texture_1d_t* tex, const mrl_texture_1d_update_desc_t* desc)
@@ -1252,11 +2055,11 @@ static mrl_error_t update_texture_1d(mrl_render_device_t* brd, mrl_texture_1d_t*
 	mrl_ogl_330_texture_1d_t* obj = (mrl_ogl_330_texture_1d_t*)tex;
 
 	// Update texture
-	glBindTexture(GL_TEXTURE_1D, obj->id);
+	bind_texture(rd, GL_TEXTURE_1D, obj->id);
 	glTexSubImage1D(GL_TEXTURE_1D, desc->mip_level, (GLint)desc->dst_x, (GLsizei)desc->width, obj->format, obj->type, desc->data);
 
 	// Check errors
-	GLenum gl_err = glGetError();
+	GLenum gl_err = get_gl_error(rd);
 	if (gl_err != 0)
 	{
 		if (rd->error_callback != NULL)
@@ -1278,8 +2081,8 @@ static mrl_error_t create_texture_2d(mrl_render_device_t* brd, mrl_texture_2d_t*
 
 	switch (desc->format)
 	{
-		case MRL_TEXTURE_FORMAT_R8_UN: internal_format = GL_R8; format = GL_R; type = GL_UNSIGNED_BYTE; break;
-		case MRL_TEXTURE_FORMAT_R8_SN: internal_format = GL_R8_SNORM; format = GL_R; type = GL_BYTE; break;
+		case MRL_TEXTURE_FORMAT_R8_UN: internal_format = GL_R8; format = GL_RED; type = GL_UNSIGNED_BYTE; break;
+		case MRL_TEXTURE_FORMAT_R8_SN: internal_format = GL_R8_SNORM; format = GL_RED; type = GL_BYTE; break;
 		case MRL_TEXTURE_FORMAT_R8_UI: internal_format = GL_R8UI; format = GL_RED_INTEGER; type = GL_UNSIGNED_BYTE; break;
 		case MRL_TEXTURE_FORMAT_R8_SI: internal_format = GL_R8I; format = GL_RED_INTEGER; type = GL_BYTE; break;
 		case MRL_TEXTURE_FORMAT_RG8_UN: internal_format = GL_RG8; format = GL_RG; type = GL_UNSIGNED_BYTE; break;
@@ -1291,8 +2094,8 @@ static mrl_error_t create_texture_2d(mrl_render_device_t* brd, mrl_texture_2d_t*
 		case MRL_TEXTURE_FORMAT_RGBA8_UI: internal_format = GL_RGBA8UI; format = GL_RGBA_INTEGER; type = GL_UNSIGNED_BYTE; break;
 		case MRL_TEXTURE_FORMAT_RGBA8_SI: internal_format = GL_RGBA8I; format = GL_RGBA_INTEGER; type = GL_BYTE; break;
 
-		case MRL_TEXTURE_FORMAT_R16_UN: internal_format = GL_R16; format = GL_R; type = GL_UNSIGNED_SHORT; break;
-		case MRL_TEXTURE_FORMAT_R16_SN: internal_format = GL_R16_SNORM; format = GL_R; type = GL_SHORT; break;
+		case MRL_TEXTURE_FORMAT_R16_UN: internal_format = GL_R16; format = GL_RED; type = GL_UNSIGNED_SHORT; break;
+		case MRL_TEXTURE_FORMAT_R16_SN: internal_format = GL_R16_SNORM; format = GL_RED; type = GL_SHORT; break;
 		case MRL_TEXTURE_FORMAT_R16_UI: internal_format = GL_R16UI; format = GL_RED_INTEGER; type = GL_UNSIGNED_SHORT; break;
 		case MRL_TEXTURE_FORMAT_R16_SI: internal_format = GL_R16I; format = GL_RED_INTEGER; type = GL_SHORT; break;
 		case MRL_TEXTURE_FORMAT_RG16_UN: internal_format = GL_RG16; format = GL_RG; type = GL_UNSIGNED_SHORT; break;
@@ -1306,7 +2109,7 @@ static mrl_error_t create_texture_2d(mrl_render_device_t* brd, mrl_texture_2d_t*
 
 		case MRL_TEXTURE_FORMAT_R32_UI: internal_format = GL_R32UI; format = GL_RED_INTEGER; type = GL_UNSIGNED_INT; break;
 		case MRL_TEXTURE_FORMAT_R32_SI: internal_format = GL_R32I; format = GL_RED_INTEGER; type = GL_INT; break;
-		case MRL_TEXTURE_FORMAT_R32_F: internal_format = GL_R32F; format = GL_R; type = GL_FLOAT; break;
+		case MRL_TEXTURE_FORMAT_R32_F: internal_format = GL_R32F; format = GL_RED; type = GL_FLOAT; break;
 		case MRL_TEXTURE_FORMAT_RG32_UI: internal_format = GL_RG32UI; format = GL_RG_INTEGER; type = GL_UNSIGNED_INT; break;
 		case MRL_TEXTURE_FORMAT_RG32_SI: internal_format = GL_RG32I; format = GL_RG_INTEGER; type = GL_INT; break;
 		case MRL_TEXTURE_FORMAT_RG32_F: internal_format = GL_RG32F; format = GL_RG; type = GL_FLOAT; break;
@@ -1314,10 +2117,26 @@ static mrl_error_t create_texture_2d(mrl_render_device_t* brd, mrl_texture_2d_t*
 		case MRL_TEXTURE_FORMAT_RGBA32_SI: internal_format = GL_RGBA32I; format = GL_RGBA_INTEGER; type = GL_INT; break;
 		case MRL_TEXTURE_FORMAT_RGBA32_F: internal_format = GL_RGBA32F; format = GL_RGBA; type = GL_FLOAT; break;
 
-		case MRL_TEXTURE_FORMAT_D16: internal_format = GL_DEPTH; format = GL_DEPTH_COMPONENT; type = GL_FLOAT; break;
-		case MRL_TEXTURE_FORMAT_D32: internal_format = GL_DEPTH; format = GL_DEPTH_COMPONENT; type = GL_FLOAT; break;
-		case MRL_TEXTURE_FORMAT_D24S8: internal_format = GL_DEPTH24_STENCIL8; format = GL_DEPTH_STENCIL; type = GL_FLOAT; break;
-		case MRL_TEXTURE_FORMAT_D32S8: internal_format = GL_DEPTH32F_STENCIL8; format = GL_DEPTH_STENCIL; type = GL_FLOAT; break;
+		case MRL_TEXTURE_FORMAT_D16: internal_format = GL_DEPTH_COMPONENT16; format = GL_DEPTH_COMPONENT; type = GL_FLOAT; break;
+		case MRL_TEXTURE_FORMAT_D32: internal_format = GL_DEPTH_COMPONENT32F; format = GL_DEPTH_COMPONENT; type = GL_FLOAT; break;
+		case MRL_TEXTURE_FORMAT_D24S8: internal_format = GL_DEPTH24_STENCIL8; format = GL_DEPTH_STENCIL; type = GL_UNSIGNED_INT_24_8; break;
+		case MRL_TEXTURE_FORMAT_D32S8: internal_format = GL_DEPTH32F_STENCIL8; format = GL_DEPTH_STENCIL; type = GL_FLOAT_32_UNSIGNED_INT_24_8_REV; break;
+
+		case MRL_TEXTURE_FORMAT_BC1_UN:
+		case MRL_TEXTURE_FORMAT_BC2_UN:
+		case MRL_TEXTURE_FORMAT_BC3_UN:
+		case MRL_TEXTURE_FORMAT_BC4_UN:
+		case MRL_TEXTURE_FORMAT_BC4_SN:
+		case MRL_TEXTURE_FORMAT_BC5_UN:
+		case MRL_TEXTURE_FORMAT_BC5_SN:
+		case MRL_TEXTURE_FORMAT_BC6H_UF:
+		case MRL_TEXTURE_FORMAT_BC6H_SF:
+		case MRL_TEXTURE_FORMAT_BC7_UN:
+		case MRL_TEXTURE_FORMAT_ETC2_RGB8_UN:
+		case MRL_TEXTURE_FORMAT_ETC2_RGB8A1_UN:
+		case MRL_TEXTURE_FORMAT_ETC2_RGBA8_UN:
+			get_compressed_format(rd, desc->format, &internal_format, &format, &type);
+			break;
 
 		default:
 			if (rd->error_callback != NULL)
@@ -1325,12 +2144,27 @@ static mrl_error_t create_texture_2d(mrl_render_device_t* brd, mrl_texture_2d_t*
 			return MRL_ERROR_INVALID_PARAMS;
 	}
 
-	// Initialize texture
+	if (!check_mip_chain(rd, desc->mip_level_count, desc->width, desc->height, 1, u8"Failed to create 2D texture: invalid mip level count"))
+		return MRL_ERROR_INVALID_PARAMS;
+
+	// Initialize texture, with immutable storage if supported
 	GLuint id;
 	glGenTextures(1, &id);
-	glBindTexture(GL_TEXTURE_2D, id);
-	for (mgl_u32_t i = 0, div = 1; i < desc->mip_level_count; ++i, div *= 2)
-		glTexImage2D(GL_TEXTURE_2D, i, internal_format, (GLsizei)(desc->width / div), (GLsizei)(desc->height / div), 0, format, type, desc->data[i]);
+	bind_texture(rd, GL_TEXTURE_2D, id);
+	if (rd->limits.texture_storage)
+		glTexStorage2D(GL_TEXTURE_2D, (GLsizei)desc->mip_level_count, internal_format, (GLsizei)desc->width, (GLsizei)desc->height);
+	else
+	{
+		for (mgl_u32_t i = 0; i < desc->mip_level_count; ++i)
+			allocate_image_2d(GL_TEXTURE_2D, i, desc->format, internal_format, format, type, get_mip_size(desc->width, i), get_mip_size(desc->height, i));
+		set_texture_mip_range(GL_TEXTURE_2D, desc->mip_level_count);
+	}
+
+	// Upload initial data
+	mrl_error_t upload_err = MRL_ERROR_NONE;
+	for (mgl_u32_t i = 0; i < desc->mip_level_count && upload_err == MRL_ERROR_NONE; ++i)
+		if (desc->data[i] != NULL)
+			upload_err = update_image_2d(rd, GL_TEXTURE_2D, i, desc->format, internal_format, format, type, 0, 0, (mgl_u64_t)get_mip_size(desc->width, i), (mgl_u64_t)get_mip_size(desc->height, i), desc->data[i]);
 
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -1339,10 +2173,13 @@ static mrl_error_t create_texture_2d(mrl_render_device_t* brd, mrl_texture_2d_t*
 	glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 
 	// Check errors
-	GLenum gl_err = glGetError();
-	if (gl_err != 0)
+	GLenum gl_err = get_gl_error(rd);
+	if (gl_err != 0 || upload_err != MRL_ERROR_NONE)
 	{
 		glDeleteTextures(1, &id);
+		forget_texture(rd, GL_TEXTURE_2D, id);
+		if (upload_err != MRL_ERROR_NONE)
+			return upload_err;
 		if (rd->error_callback != NULL)
 			rd->error_callback(MRL_ERROR_EXTERNAL, opengl_error_code_to_str(gl_err));
 		return MRL_ERROR_EXTERNAL;
@@ -1350,23 +2187,25 @@ static mrl_error_t create_texture_2d(mrl_render_device_t* brd, mrl_texture_2d_t*
 
 	// Allocate object
 	mrl_ogl_330_texture_2d_t* obj;
-	mgl_error_t err = mgl_allocate(
-		&rd->memory.texture_2d.pool,
-		sizeof(*obj),
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.texture_2d,
 		(void**)&obj);
 	if (err != MGL_ERROR_NONE)
 	{
 		glDeleteTextures(1, &id);
+		forget_texture(rd, GL_TEXTURE_2D, id);
 		return mrl_make_mgl_error(err);
 	}
 
 	// Store texture info
 	obj->id = id;
 	obj->width = desc->width;
+	obj->mip_level_count = desc->mip_level_count;
 	obj->height = desc->height;
 	obj->internal_format = internal_format;
 	obj->format = format;
 	obj->type = type;
+	obj->texture_format = desc->format;
 	*tex = (mrl_texture_2d_t*)obj;
 
 	return MRL_ERROR_NONE;
@@ -1379,10 +2218,11 @@ static void destroy_texture_2d(mrl_render_device_t* brd, mrl_texture_2d_t* tex)
 
 	// Delete texture
 	glDeleteTextures(1, &obj->id);
+	forget_texture(rd, GL_TEXTURE_2D, obj->id);
 
 	// Deallocate object
-	mgl_deallocate(
-		&rd->memory.texture_2d.pool,
+	mrl_deallocate_object(
+		&rd->memory.texture_2d,
 		obj);
 }
 
@@ -1391,7 +2231,10 @@ static void generate_texture_2d_mipmaps(mrl_render_device_t* brd, mrl_texture_2d
 	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
 	mrl_ogl_330_texture_2d_t* obj = (mrl_ogl_330_texture_2d_t*)tex;
 
-	glBindTexture(GL_TEXTURE_2D, obj->id);
+	if (!check_mip_generation(rd, obj->mip_level_count, obj->width, obj->height, 1, u8"Failed to generate 2D texture mipmaps: the texture was created with a single mip level"))
+		return;
+
+	bind_texture(rd, GL_TEXTURE_2D, obj->id);
 	glGenerateMipmap(GL_TEXTURE_2D);
 }
 
@@ -1401,13 +2244,12 @@ static void bind_texture_2d(mrl_render_device_t* brd, mrl_shader_binding_point_t
 	mrl_ogl_330_texture_2d_t* obj = (mrl_ogl_330_texture_2d_t*)tex;
 	mrl_ogl_330_shader_binding_point_t* rbp = (mrl_ogl_330_shader_binding_point_t*)bp;
 
-	// Bind texture
-	glActiveTexture(GL_TEXTURE0 + rbp->loc);
+	// Bind texture to the unit assigned to the sampler uniform
+	MGL_DEBUG_ASSERT(rbp->unit >= 0);
 	if (tex == NULL)
-		glBindTexture(GL_TEXTURE_2D, 0);
+		bind_texture_unit(rd, (GLuint)rbp->unit, GL_TEXTURE_2D, 0);
 	else
-		glBindTexture(GL_TEXTURE_2D, obj->id);
-	glUniform1i(rbp->loc, rbp->loc);
+		bind_texture_unit(rd, (GLuint)rbp->unit, GL_TEXTURE_2D, obj->id);
 }
 
 static mrl_error_t update_texture_2d(mrl_render_device_t* brd, mrl_texture_2d_t* tex, const mrl_texture_2d_update_desc_t* desc)
@@ -1416,11 +2258,13 @@ static mrl_error_t update_texture_2d(mrl_render_device_t* brd, mrl_texture_2d_t*
 	mrl_ogl_330_texture_2d_t* obj = (mrl_ogl_330_texture_2d_t*)tex;
 
 	// Update texture
-	glBindTexture(GL_TEXTURE_2D, obj->id);
-	glTexSubImage2D(GL_TEXTURE_2D, desc->mip_level, (GLint)desc->dst_x, (GLint)desc->dst_y, (GLsizei)desc->width, (GLsizei)desc->height, obj->format, obj->type, desc->data);
+	bind_texture(rd, GL_TEXTURE_2D, obj->id);
+	mrl_error_t err = update_image_2d(rd, GL_TEXTURE_2D, desc->mip_level, obj->texture_format, obj->internal_format, obj->format, obj->type, desc->dst_x, desc->dst_y, desc->width, desc->height, desc->data);
+	if (err != MRL_ERROR_NONE)
+		return err;
 
 	// Check errors
-	GLenum gl_err = glGetError();
+	GLenum gl_err = get_gl_error(rd);
 	if (gl_err != 0)
 	{
 		if (rd->error_callback != NULL)
@@ -1442,8 +2286,8 @@ static mrl_error_t create_texture_3d(mrl_render_device_t* brd, mrl_texture_3d_t*
 
 	switch (desc->format)
 	{
-		case MRL_TEXTURE_FORMAT_R8_UN: internal_format = GL_R8; format = GL_R; type = GL_UNSIGNED_BYTE; break;
-		case MRL_TEXTURE_FORMAT_R8_SN: internal_format = GL_R8_SNORM; format = GL_R; type = GL_BYTE; break;
+		case MRL_TEXTURE_FORMAT_R8_UN: internal_format = GL_R8; format = GL_RED; type = GL_UNSIGNED_BYTE; break;
+		case MRL_TEXTURE_FORMAT_R8_SN: internal_format = GL_R8_SNORM; format = GL_RED; type = GL_BYTE; break;
 		case MRL_TEXTURE_FORMAT_R8_UI: internal_format = GL_R8UI; format = GL_RED_INTEGER; type = GL_UNSIGNED_BYTE; break;
 		case MRL_TEXTURE_FORMAT_R8_SI: internal_format = GL_R8I; format = GL_RED_INTEGER; type = GL_BYTE; break;
 		case MRL_TEXTURE_FORMAT_RG8_UN: internal_format = GL_RG8; format = GL_RG; type = GL_UNSIGNED_BYTE; break;
@@ -1455,8 +2299,8 @@ static mrl_error_t create_texture_3d(mrl_render_device_t* brd, mrl_texture_3d_t*
 		case MRL_TEXTURE_FORMAT_RGBA8_UI: internal_format = GL_RGBA8UI; format = GL_RGBA_INTEGER; type = GL_UNSIGNED_BYTE; break;
 		case MRL_TEXTURE_FORMAT_RGBA8_SI: internal_format = GL_RGBA8I; format = GL_RGBA_INTEGER; type = GL_BYTE; break;
 	
-		case MRL_TEXTURE_FORMAT_R16_UN: internal_format = GL_R16; format = GL_R; type = GL_UNSIGNED_SHORT; break;
-		case MRL_TEXTURE_FORMAT_R16_SN: internal_format = GL_R16_SNORM; format = GL_R; type = GL_SHORT; break;
+		case MRL_TEXTURE_FORMAT_R16_UN: internal_format = GL_R16; format = GL_RED; type = GL_UNSIGNED_SHORT; break;
+		case MRL_TEXTURE_FORMAT_R16_SN: internal_format = GL_R16_SNORM; format = GL_RED; type = GL_SHORT; break;
 		case MRL_TEXTURE_FORMAT_R16_UI: internal_format = GL_R16UI; format = GL_RED_INTEGER; type = GL_UNSIGNED_SHORT; break;
 		case MRL_TEXTURE_FORMAT_R16_SI: internal_format = GL_R16I; format = GL_RED_INTEGER; type = GL_SHORT; break;
 		case MRL_TEXTURE_FORMAT_RG16_UN: internal_format = GL_RG16; format = GL_RG; type = GL_UNSIGNED_SHORT; break;
@@ -1470,7 +2314,7 @@ static mrl_error_t create_texture_3d(mrl_render_device_t* brd, mrl_texture_3d_t*
 
 		case MRL_TEXTURE_FORMAT_R32_UI: internal_format = GL_R32UI; format = GL_RED_INTEGER; type = GL_UNSIGNED_INT; break;
 		case MRL_TEXTURE_FORMAT_R32_SI: internal_format = GL_R32I; format = GL_RED_INTEGER; type = GL_INT; break;
-		case MRL_TEXTURE_FORMAT_R32_F: internal_format = GL_R32F; format = GL_R; type = GL_FLOAT; break;
+		case MRL_TEXTURE_FORMAT_R32_F: internal_format = GL_R32F; format = GL_RED; type = GL_FLOAT; break;
 		case MRL_TEXTURE_FORMAT_RG32_UI: internal_format = GL_RG32UI; format = GL_RG_INTEGER; type = GL_UNSIGNED_INT; break;
 		case MRL_TEXTURE_FORMAT_RG32_SI: internal_format = GL_RG32I; format = GL_RG_INTEGER; type = GL_INT; break;
 		case MRL_TEXTURE_FORMAT_RG32_F: internal_format = GL_RG32F; format = GL_RG; type = GL_FLOAT; break;
@@ -1492,12 +2336,26 @@ static mrl_error_t create_texture_3d(mrl_render_device_t* brd, mrl_texture_3d_t*
 			return MRL_ERROR_INVALID_PARAMS;
 	}
 
-	// Initialize texture
+	if (!check_mip_chain(rd, desc->mip_level_count, desc->width, desc->height, desc->depth, u8"Failed to create 3D texture: invalid mip level count"))
+		return MRL_ERROR_INVALID_PARAMS;
+
+	// Initialize texture, with immutable storage if supported
 	GLuint id;
 	glGenTextures(1, &id);
-	glBindTexture(GL_TEXTURE_3D, id);
-	for (mgl_u32_t i = 0, div = 1; i < desc->mip_level_count; ++i, div *= 2)
-		glTexImage3D(GL_TEXTURE_3D, i, internal_format, (GLsizei)(desc->width / div), (GLsizei)(desc->height / div), (GLsizei)(desc->depth / div), 0, format, type, desc->data[i]);
+	bind_texture(rd, GL_TEXTURE_3D, id);
+	if (rd->limits.texture_storage)
+	{
+		glTexStorage3D(GL_TEXTURE_3D, (GLsizei)desc->mip_level_count, internal_format, (GLsizei)desc->width, (GLsizei)desc->height, (GLsizei)desc->depth);
+		for (mgl_u32_t i = 0; i < desc->mip_level_count; ++i)
+			if (desc->data[i] != NULL)
+				glTexSubImage3D(GL_TEXTURE_3D, i, 0, 0, 0, get_mip_size(desc->width, i), get_mip_size(desc->height, i), get_mip_size(desc->depth, i), format, type, desc->data[i]);
+	}
+	else
+	{
+		for (mgl_u32_t i = 0; i < desc->mip_level_count; ++i)
+			glTexImage3D(GL_TEXTURE_3D, i, internal_format, get_mip_size(desc->width, i), get_mip_size(desc->height, i), get_mip_size(desc->depth, i), 0, format, type, desc->data[i]);
+		set_texture_mip_range(GL_TEXTURE_3D, desc->mip_level_count);
+	}
 
 	glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -1506,10 +2364,11 @@ static mrl_error_t create_texture_3d(mrl_render_device_t* brd, mrl_texture_3d_t*
 	glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 
 	// Check errors
-	GLenum gl_err = glGetError();
+	GLenum gl_err = get_gl_error(rd);
 	if (gl_err != 0)
 	{
 		glDeleteTextures(1, &id);
+		forget_texture(rd, GL_TEXTURE_3D, id);
 		if (rd->error_callback != NULL)
 			rd->error_callback(MRL_ERROR_EXTERNAL, opengl_error_code_to_str(gl_err));
 		return MRL_ERROR_EXTERNAL;
@@ -1517,19 +2376,20 @@ static mrl_error_t create_texture_3d(mrl_render_device_t* brd, mrl_texture_3d_t*
 
 	// Allocate object
 	mrl_ogl_330_texture_3d_t* obj;
-	mgl_error_t err = mgl_allocate(
-		&rd->memory.texture_3d.pool,
-		sizeof(*obj),
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.texture_3d,
 		(void**)&obj);
 	if (err != MGL_ERROR_NONE)
 	{
 		glDeleteTextures(1, &id);
+		forget_texture(rd, GL_TEXTURE_3D, id);
 		return mrl_make_mgl_error(err);
 	}
 
 	// Store texture info
 	obj->id = id;
 	obj->width = desc->width;
+	obj->mip_level_count = desc->mip_level_count;
 	obj->height = desc->height;
 	obj->depth = desc->depth;
 	obj->internal_format = internal_format;
@@ -1547,10 +2407,11 @@ static void destroy_texture_3d(mrl_render_device_t* brd, mrl_texture_3d_t* tex)
 
 	// Delete texture
 	glDeleteTextures(1, &obj->id);
+	forget_texture(rd, GL_TEXTURE_3D, obj->id);
 
 	// Deallocate object
-	mgl_deallocate(
-		&rd->memory.texture_3d.pool,
+	mrl_deallocate_object(
+		&rd->memory.texture_3d,
 		obj);
 }
 
@@ -1559,7 +2420,10 @@ static void generate_texture_3d_mipmaps(mrl_render_device_t* brd, mrl_texture_2d
 	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
 	mrl_ogl_330_texture_3d_t* obj = (mrl_ogl_330_texture_3d_t*)tex;
 
-	glBindTexture(GL_TEXTURE_3D, obj->id);
+	if (!check_mip_generation(rd, obj->mip_level_count, obj->width, obj->height, obj->depth, u8"Failed to generate 3D texture mipmaps: the texture was created with a single mip level"))
+		return;
+
+	bind_texture(rd, GL_TEXTURE_3D, obj->id);
 	glGenerateMipmap(GL_TEXTURE_3D);
 }
 
@@ -1569,13 +2433,12 @@ static void bind_texture_3d(mrl_render_device_t* brd, mrl_shader_binding_point_t
 	mrl_ogl_330_texture_3d_t* obj = (mrl_ogl_330_texture_3d_t*)tex;
 	mrl_ogl_330_shader_binding_point_t* rbp = (mrl_ogl_330_shader_binding_point_t*)bp;
 
-	// Bind texture
-	glActiveTexture(GL_TEXTURE0 + rbp->loc);
+	// Bind texture to the unit assigned to the sampler uniform
+	MGL_DEBUG_ASSERT(rbp->unit >= 0);
 	if (tex == NULL)
-		glBindTexture(GL_TEXTURE_3D, 0);
+		bind_texture_unit(rd, (GLuint)rbp->unit, GL_TEXTURE_3D, 0);
 	else
-		glBindTexture(GL_TEXTURE_3D, obj->id);
-	glUniform1i(rbp->loc, rbp->loc);
+		bind_texture_unit(rd, (GLuint)rbp->unit, GL_TEXTURE_3D, obj->id);
 }
 
 static mrl_error_t update_texture_3d(mrl_render_device_t* brd, mrl_texture_3d_t* tex, const mrl_texture_3d_update_desc_t* desc)
@@ -1584,11 +2447,11 @@ static mrl_error_t update_texture_3d(mrl_render_device_t* brd, mrl_texture_3d_t*
 	mrl_ogl_330_texture_3d_t* obj = (mrl_ogl_330_texture_3d_t*)tex;
 
 	// Update texture
-	glBindTexture(GL_TEXTURE_3D, obj->id);
+	bind_texture(rd, GL_TEXTURE_3D, obj->id);
 	glTexSubImage3D(GL_TEXTURE_3D, desc->mip_level, (GLint)desc->dst_x, (GLint)desc->dst_y, (GLint)desc->dst_z, (GLsizei)desc->width, (GLsizei)desc->height, (GLsizei)desc->depth, obj->format, obj->type, desc->data);
 
 	// Check errors
-	GLenum gl_err = glGetError();
+	GLenum gl_err = get_gl_error(rd);
 	if (gl_err != 0)
 	{
 		if (rd->error_callback != NULL)
@@ -1610,8 +2473,8 @@ static mrl_error_t create_cube_map(mrl_render_device_t* brd, mrl_cube_map_t** te
 
 	switch (desc->format)
 	{
-		case MRL_TEXTURE_FORMAT_R8_UN: internal_format = GL_R8; format = GL_R; type = GL_UNSIGNED_BYTE; break;
-		case MRL_TEXTURE_FORMAT_R8_SN: internal_format = GL_R8_SNORM; format = GL_R; type = GL_BYTE; break;
+		case MRL_TEXTURE_FORMAT_R8_UN: internal_format = GL_R8; format = GL_RED; type = GL_UNSIGNED_BYTE; break;
+		case MRL_TEXTURE_FORMAT_R8_SN: internal_format = GL_R8_SNORM; format = GL_RED; type = GL_BYTE; break;
 		case MRL_TEXTURE_FORMAT_R8_UI: internal_format = GL_R8UI; format = GL_RED_INTEGER; type = GL_UNSIGNED_BYTE; break;
 		case MRL_TEXTURE_FORMAT_R8_SI: internal_format = GL_R8I; format = GL_RED_INTEGER; type = GL_BYTE; break;
 		case MRL_TEXTURE_FORMAT_RG8_UN: internal_format = GL_RG8; format = GL_RG; type = GL_UNSIGNED_BYTE; break;
@@ -1623,8 +2486,8 @@ static mrl_error_t create_cube_map(mrl_render_device_t* brd, mrl_cube_map_t** te
 		case MRL_TEXTURE_FORMAT_RGBA8_UI: internal_format = GL_RGBA8UI; format = GL_RGBA_INTEGER; type = GL_UNSIGNED_BYTE; break;
 		case MRL_TEXTURE_FORMAT_RGBA8_SI: internal_format = GL_RGBA8I; format = GL_RGBA_INTEGER; type = GL_BYTE; break;
 
-		case MRL_TEXTURE_FORMAT_R16_UN: internal_format = GL_R16; format = GL_R; type = GL_UNSIGNED_SHORT; break;
-		case MRL_TEXTURE_FORMAT_R16_SN: internal_format = GL_R16_SNORM; format = GL_R; type = GL_SHORT; break;
+		case MRL_TEXTURE_FORMAT_R16_UN: internal_format = GL_R16; format = GL_RED; type = GL_UNSIGNED_SHORT; break;
+		case MRL_TEXTURE_FORMAT_R16_SN: internal_format = GL_R16_SNORM; format = GL_RED; type = GL_SHORT; break;
 		case MRL_TEXTURE_FORMAT_R16_UI: internal_format = GL_R16UI; format = GL_RED_INTEGER; type = GL_UNSIGNED_SHORT; break;
 		case MRL_TEXTURE_FORMAT_R16_SI: internal_format = GL_R16I; format = GL_RED_INTEGER; type = GL_SHORT; break;
 		case MRL_TEXTURE_FORMAT_RG16_UN: internal_format = GL_RG16; format = GL_RG; type = GL_UNSIGNED_SHORT; break;
@@ -1638,7 +2501,7 @@ static mrl_error_t create_cube_map(mrl_render_device_t* brd, mrl_cube_map_t** te
 
 		case MRL_TEXTURE_FORMAT_R32_UI: internal_format = GL_R32UI; format = GL_RED_INTEGER; type = GL_UNSIGNED_INT; break;
 		case MRL_TEXTURE_FORMAT_R32_SI: internal_format = GL_R32I; format = GL_RED_INTEGER; type = GL_INT; break;
-		case MRL_TEXTURE_FORMAT_R32_F: internal_format = GL_R32F; format = GL_R; type = GL_FLOAT; break;
+		case MRL_TEXTURE_FORMAT_R32_F: internal_format = GL_R32F; format = GL_RED; type = GL_FLOAT; break;
 		case MRL_TEXTURE_FORMAT_RG32_UI: internal_format = GL_RG32UI; format = GL_RG_INTEGER; type = GL_UNSIGNED_INT; break;
 		case MRL_TEXTURE_FORMAT_RG32_SI: internal_format = GL_RG32I; format = GL_RG_INTEGER; type = GL_INT; break;
 		case MRL_TEXTURE_FORMAT_RG32_F: internal_format = GL_RG32F; format = GL_RG; type = GL_FLOAT; break;
@@ -1646,10 +2509,26 @@ static mrl_error_t create_cube_map(mrl_render_device_t* brd, mrl_cube_map_t** te
 		case MRL_TEXTURE_FORMAT_RGBA32_SI: internal_format = GL_RGBA32I; format = GL_RGBA_INTEGER; type = GL_INT; break;
 		case MRL_TEXTURE_FORMAT_RGBA32_F: internal_format = GL_RGBA32F; format = GL_RGBA; type = GL_FLOAT; break;
 
-		case MRL_TEXTURE_FORMAT_D16: internal_format = GL_DEPTH; format = GL_DEPTH_COMPONENT; type = GL_FLOAT; break;
-		case MRL_TEXTURE_FORMAT_D32: internal_format = GL_DEPTH; format = GL_DEPTH_COMPONENT; type = GL_FLOAT; break;
-		case MRL_TEXTURE_FORMAT_D24S8: internal_format = GL_R32UI; format = GL_DEPTH_STENCIL; type = GL_FLOAT; break;
-		case MRL_TEXTURE_FORMAT_D32S8: internal_format = GL_R32UI; format = GL_DEPTH_STENCIL; type = GL_FLOAT; break;
+		case MRL_TEXTURE_FORMAT_D16: internal_format = GL_DEPTH_COMPONENT16; format = GL_DEPTH_COMPONENT; type = GL_FLOAT; break;
+		case MRL_TEXTURE_FORMAT_D32: internal_format = GL_DEPTH_COMPONENT32F; format = GL_DEPTH_COMPONENT; type = GL_FLOAT; break;
+		case MRL_TEXTURE_FORMAT_D24S8: internal_format = GL_DEPTH24_STENCIL8; format = GL_DEPTH_STENCIL; type = GL_UNSIGNED_INT_24_8; break;
+		case MRL_TEXTURE_FORMAT_D32S8: internal_format = GL_DEPTH32F_STENCIL8; format = GL_DEPTH_STENCIL; type = GL_FLOAT_32_UNSIGNED_INT_24_8_REV; break;
+
+		case MRL_TEXTURE_FORMAT_BC1_UN:
+		case MRL_TEXTURE_FORMAT_BC2_UN:
+		case MRL_TEXTURE_FORMAT_BC3_UN:
+		case MRL_TEXTURE_FORMAT_BC4_UN:
+		case MRL_TEXTURE_FORMAT_BC4_SN:
+		case MRL_TEXTURE_FORMAT_BC5_UN:
+		case MRL_TEXTURE_FORMAT_BC5_SN:
+		case MRL_TEXTURE_FORMAT_BC6H_UF:
+		case MRL_TEXTURE_FORMAT_BC6H_SF:
+		case MRL_TEXTURE_FORMAT_BC7_UN:
+		case MRL_TEXTURE_FORMAT_ETC2_RGB8_UN:
+		case MRL_TEXTURE_FORMAT_ETC2_RGB8A1_UN:
+		case MRL_TEXTURE_FORMAT_ETC2_RGBA8_UN:
+			get_compressed_format(rd, desc->format, &internal_format, &format, &type);
+			break;
 
 		default:
 			if (rd->error_callback != NULL)
@@ -1657,20 +2536,29 @@ static mrl_error_t create_cube_map(mrl_render_device_t* brd, mrl_cube_map_t** te
 			return MRL_ERROR_INVALID_PARAMS;
 	}
 
-	// Initialize texture
+	if (!check_mip_chain(rd, desc->mip_level_count, desc->width, desc->height, 1, u8"Failed to create cube map: invalid mip level count"))
+		return MRL_ERROR_INVALID_PARAMS;
+
+	// Initialize texture, with immutable storage if supported
 	GLuint id;
 	glGenTextures(1, &id);
-	glBindTexture(GL_TEXTURE_CUBE_MAP, id);
+	bind_texture(rd, GL_TEXTURE_CUBE_MAP, id);
+	if (rd->limits.texture_storage)
+		glTexStorage2D(GL_TEXTURE_CUBE_MAP, (GLsizei)desc->mip_level_count, internal_format, (GLsizei)desc->width, (GLsizei)desc->height);
+	else
+		set_texture_mip_range(GL_TEXTURE_CUBE_MAP, desc->mip_level_count);
 
-	for (mgl_u32_t i = 0, div = 1; i < desc->mip_level_count; ++i, div *= 2)
-	{
-		glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X, i, internal_format, (GLsizei)(desc->width / div), (GLsizei)(desc->height / div), 0, format, type, desc->data[MRL_CUBE_MAP_FACE_POSITIVE_X][i]);
-		glTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_X, i, internal_format, (GLsizei)(desc->width / div), (GLsizei)(desc->height / div), 0, format, type, desc->data[MRL_CUBE_MAP_FACE_NEGATIVE_X][i]);
-		glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_Y, i, internal_format, (GLsizei)(desc->width / div), (GLsizei)(desc->height / div), 0, format, type, desc->data[MRL_CUBE_MAP_FACE_POSITIVE_Y][i]);
-		glTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_Y, i, internal_format, (GLsizei)(desc->width / div), (GLsizei)(desc->height / div), 0, format, type, desc->data[MRL_CUBE_MAP_FACE_NEGATIVE_Y][i]);
-		glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_Z, i, internal_format, (GLsizei)(desc->width / div), (GLsizei)(desc->height / div), 0, format, type, desc->data[MRL_CUBE_MAP_FACE_POSITIVE_Z][i]);
-		glTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_Z, i, internal_format, (GLsizei)(desc->width / div), (GLsizei)(desc->height / div), 0, format, type, desc->data[MRL_CUBE_MAP_FACE_NEGATIVE_Z][i]);
-	}
+	mrl_error_t upload_err = MRL_ERROR_NONE;
+	for (mgl_u32_t i = 0; i < desc->mip_level_count; ++i)
+		for (mgl_u32_t f = 0; f < 6; ++f)
+		{
+			// The cube map face enums are in the same order as the OpenGL face targets
+			GLenum target = GL_TEXTURE_CUBE_MAP_POSITIVE_X + f;
+			if (!rd->limits.texture_storage)
+				allocate_image_2d(target, i, desc->format, internal_format, format, type, get_mip_size(desc->width, i), get_mip_size(desc->height, i));
+			if (desc->data[f][i] != NULL && upload_err == MRL_ERROR_NONE)
+				upload_err = update_image_2d(rd, target, i, desc->format, internal_format, format, type, 0, 0, (mgl_u64_t)get_mip_size(desc->width, i), (mgl_u64_t)get_mip_size(desc->height, i), desc->data[f][i]);
+		}
 
 	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -1679,10 +2567,13 @@ static mrl_error_t create_cube_map(mrl_render_device_t* brd, mrl_cube_map_t** te
 	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 
 	// Check errors
-	GLenum gl_err = glGetError();
-	if (gl_err != 0)
+	GLenum gl_err = get_gl_error(rd);
+	if (gl_err != 0 || upload_err != MRL_ERROR_NONE)
 	{
 		glDeleteTextures(1, &id);
+		forget_texture(rd, GL_TEXTURE_CUBE_MAP, id);
+		if (upload_err != MRL_ERROR_NONE)
+			return upload_err;
 		if (rd->error_callback != NULL)
 			rd->error_callback(MRL_ERROR_EXTERNAL, opengl_error_code_to_str(gl_err));
 		return MRL_ERROR_EXTERNAL;
@@ -1690,23 +2581,25 @@ static mrl_error_t create_cube_map(mrl_render_device_t* brd, mrl_cube_map_t** te
 
 	// Allocate object
 	mrl_ogl_330_cube_map_t* obj;
-	mgl_error_t err = mgl_allocate(
-		&rd->memory.cube_map.pool,
-		sizeof(*obj),
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.cube_map,
 		(void**)&obj);
 	if (err != MGL_ERROR_NONE)
 	{
 		glDeleteTextures(1, &id);
+		forget_texture(rd, GL_TEXTURE_CUBE_MAP, id);
 		return mrl_make_mgl_error(err);
 	}
 
 	// Store texture info
 	obj->id = id;
 	obj->width = desc->width;
+	obj->mip_level_count = desc->mip_level_count;
 	obj->height = desc->height;
 	obj->internal_format = internal_format;
 	obj->format = format;
 	obj->type = type;
+	obj->texture_format = desc->format;
 	*tex = (mrl_cube_map_t*)obj;
 
 	return MRL_ERROR_NONE;
@@ -1719,10 +2612,11 @@ static void destroy_cube_map(mrl_render_device_t* brd, mrl_cube_map_t* tex)
 
 	// Delete texture
 	glDeleteTextures(1, &obj->id);
+	forget_texture(rd, GL_TEXTURE_CUBE_MAP, obj->id);
 
 	// Deallocate object
-	mgl_deallocate(
-		&rd->memory.cube_map.pool,
+	mrl_deallocate_object(
+		&rd->memory.cube_map,
 		obj);
 }
 
@@ -1731,7 +2625,10 @@ static void generate_cube_map_mipmaps(mrl_render_device_t* brd, mrl_cube_map_t*
 	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
 	mrl_ogl_330_cube_map_t* obj = (mrl_ogl_330_cube_map_t*)tex;
 
-	glBindTexture(GL_TEXTURE_CUBE_MAP, obj->id);
+	if (!check_mip_generation(rd, obj->mip_level_count, obj->width, obj->height, 1, u8"Failed to generate cube map mipmaps: the texture was created with a single mip level"))
+		return;
+
+	bind_texture(rd, GL_TEXTURE_CUBE_MAP, obj->id);
 	glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
 }
 
@@ -1741,13 +2638,12 @@ static void bind_cube_map(mrl_render_device_t* brd, mrl_shader_binding_point_t*
 	mrl_ogl_330_cube_map_t* obj = (mrl_ogl_330_cube_map_t*)tex;
 	mrl_ogl_330_shader_binding_point_t* rbp = (mrl_ogl_330_shader_binding_point_t*)bp;
 
-	// Bind texture
-	glActiveTexture(GL_TEXTURE0 + rbp->loc);
+	// Bind texture to the unit assigned to the sampler uniform
+	MGL_DEBUG_ASSERT(rbp->unit >= 0);
 	if (tex == NULL)
-		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+		bind_texture_unit(rd, (GLuint)rbp->unit, GL_TEXTURE_CUBE_MAP, 0);
 	else
-		glBindTexture(GL_TEXTURE_CUBE_MAP, obj->id);
-	glUniform1i(rbp->loc, rbp->loc);
+		bind_texture_unit(rd, (GLuint)rbp->unit, GL_TEXTURE_CUBE_MAP, obj->id);
 }
 
 static mrl_error_t update_cube_map(mrl_render_device_t* brd, mrl_cube_map_t* tex, const mrl_cube_map_update_desc_t* desc)
@@ -1772,11 +2668,13 @@ static mrl_error_t update_cube_map(mrl_render_device_t* brd, mrl_cube_map_t* tex
 	}
 
 	// Update texture
-	glBindTexture(GL_TEXTURE_CUBE_MAP, obj->id);
-	glTexSubImage2D(face, desc->mip_level, (GLint)desc->dst_x, (GLint)desc->dst_y, (GLsizei)desc->width, (GLsizei)desc->height, obj->format, obj->type, desc->data);
+	bind_texture(rd, GL_TEXTURE_CUBE_MAP, obj->id);
+	mrl_error_t err = update_image_2d(rd, face, desc->mip_level, obj->texture_format, obj->internal_format, obj->format, obj->type, desc->dst_x, desc->dst_y, desc->width, desc->height, desc->data);
+	if (err != MRL_ERROR_NONE)
+		return err;
 
 	// Check errors
-	GLenum gl_err = glGetError();
+	GLenum gl_err = get_gl_error(rd);
 	if (gl_err != 0)
 	{
 		if (rd->error_callback != NULL)
@@ -1787,397 +2685,557 @@ static mrl_error_t update_cube_map(mrl_render_device_t* brd, mrl_cube_map_t* tex
 	return MRL_ERROR_NONE;
 }
 
-// ---------- Constant buffers ----------
+// ---------- Texture 2D array ----------
 
-static mrl_error_t create_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t** cb, const mrl_constant_buffer_desc_t* desc)
+static mrl_error_t create_texture_2d_array(mrl_render_device_t* brd, mrl_texture_2d_array_t** tex, const mrl_texture_2d_array_desc_t* desc)
 {
 	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
 
-	// Check for invalid input
-	if (desc->usage == MRL_CONSTANT_BUFFER_USAGE_STATIC && desc->data == NULL)
+	// Get internal format, format and type
+	GLenum internal_format, format, type;
+
+	switch (desc->format)
 	{
-		if (rd->error_callback != NULL)
-			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create constant buffer: when the usage mode is set to static, the pointer to the initial data must not be NULL");
-		return MRL_ERROR_INVALID_PARAMS;
+		case MRL_TEXTURE_FORMAT_R8_UN: internal_format = GL_R8; format = GL_RED; type = GL_UNSIGNED_BYTE; break;
+		case MRL_TEXTURE_FORMAT_R8_SN: internal_format = GL_R8_SNORM; format = GL_RED; type = GL_BYTE; break;
+		case MRL_TEXTURE_FORMAT_R8_UI: internal_format = GL_R8UI; format = GL_RED_INTEGER; type = GL_UNSIGNED_BYTE; break;
+		case MRL_TEXTURE_FORMAT_R8_SI: internal_format = GL_R8I; format = GL_RED_INTEGER; type = GL_BYTE; break;
+		case MRL_TEXTURE_FORMAT_RG8_UN: internal_format = GL_RG8; format = GL_RG; type = GL_UNSIGNED_BYTE; break;
+		case MRL_TEXTURE_FORMAT_RG8_SN: internal_format = GL_RG8_SNORM; format = GL_RG; type = GL_BYTE; break;
+		case MRL_TEXTURE_FORMAT_RG8_UI: internal_format = GL_RG8UI; format = GL_RG_INTEGER; type = GL_UNSIGNED_BYTE; break;
+		case MRL_TEXTURE_FORMAT_RG8_SI: internal_format = GL_RG8I; format = GL_RG_INTEGER; type = GL_BYTE; break;
+		case MRL_TEXTURE_FORMAT_RGBA8_UN: internal_format = GL_RGBA8; format = GL_RGBA; type = GL_UNSIGNED_BYTE; break;
+		case MRL_TEXTURE_FORMAT_RGBA8_SN: internal_format = GL_RGBA8_SNORM; format = GL_RGBA; type = GL_BYTE; break;
+		case MRL_TEXTURE_FORMAT_RGBA8_UI: internal_format = GL_RGBA8UI; format = GL_RGBA_INTEGER; type = GL_UNSIGNED_BYTE; break;
+		case MRL_TEXTURE_FORMAT_RGBA8_SI: internal_format = GL_RGBA8I; format = GL_RGBA_INTEGER; type = GL_BYTE; break;
+
+		case MRL_TEXTURE_FORMAT_R16_UN: internal_format = GL_R16; format = GL_RED; type = GL_UNSIGNED_SHORT; break;
+		case MRL_TEXTURE_FORMAT_R16_SN: internal_format = GL_R16_SNORM; format = GL_RED; type = GL_SHORT; break;
+		case MRL_TEXTURE_FORMAT_R16_UI: internal_format = GL_R16UI; format = GL_RED_INTEGER; type = GL_UNSIGNED_SHORT; break;
+		case MRL_TEXTURE_FORMAT_R16_SI: internal_format = GL_R16I; format = GL_RED_INTEGER; type = GL_SHORT; break;
+		case MRL_TEXTURE_FORMAT_RG16_UN: internal_format = GL_RG16; format = GL_RG; type = GL_UNSIGNED_SHORT; break;
+		case MRL_TEXTURE_FORMAT_RG16_SN: internal_format = GL_RG16_SNORM; format = GL_RG; type = GL_SHORT; break;
+		case MRL_TEXTURE_FORMAT_RG16_UI: internal_format = GL_RG16UI; format = GL_RG_INTEGER; type = GL_UNSIGNED_SHORT; break;
+		case MRL_TEXTURE_FORMAT_RG16_SI: internal_format = GL_RG16I; format = GL_RG_INTEGER; type = GL_SHORT; break;
+		case MRL_TEXTURE_FORMAT_RGBA16_UN: internal_format = GL_RGBA16; format = GL_RGBA; type = GL_UNSIGNED_SHORT; break;
+		case MRL_TEXTURE_FORMAT_RGBA16_SN: internal_format = GL_RGBA16_SNORM; format = GL_RGBA; type = GL_SHORT; break;
+		case MRL_TEXTURE_FORMAT_RGBA16_UI: internal_format = GL_RGBA16UI; format = GL_RGBA_INTEGER; type = GL_UNSIGNED_SHORT; break;
+		case MRL_TEXTURE_FORMAT_RGBA16_SI: internal_format = GL_RGBA16I; format = GL_RGBA_INTEGER; type = GL_SHORT; break;
+
+		case MRL_TEXTURE_FORMAT_R32_UI: internal_format = GL_R32UI; format = GL_RED_INTEGER; type = GL_UNSIGNED_INT; break;
+		case MRL_TEXTURE_FORMAT_R32_SI: internal_format = GL_R32I; format = GL_RED_INTEGER; type = GL_INT; break;
+		case MRL_TEXTURE_FORMAT_R32_F: internal_format = GL_R32F; format = GL_RED; type = GL_FLOAT; break;
+		case MRL_TEXTURE_FORMAT_RG32_UI: internal_format = GL_RG32UI; format = GL_RG_INTEGER; type = GL_UNSIGNED_INT; break;
+		case MRL_TEXTURE_FORMAT_RG32_SI: internal_format = GL_RG32I; format = GL_RG_INTEGER; type = GL_INT; break;
+		case MRL_TEXTURE_FORMAT_RG32_F: internal_format = GL_RG32F; format = GL_RG; type = GL_FLOAT; break;
+		case MRL_TEXTURE_FORMAT_RGBA32_UI: internal_format = GL_RGBA32UI; format = GL_RGBA_INTEGER; type = GL_UNSIGNED_INT; break;
+		case MRL_TEXTURE_FORMAT_RGBA32_SI: internal_format = GL_RGBA32I; format = GL_RGBA_INTEGER; type = GL_INT; break;
+		case MRL_TEXTURE_FORMAT_RGBA32_F: internal_format = GL_RGBA32F; format = GL_RGBA; type = GL_FLOAT; break;
+
+		case MRL_TEXTURE_FORMAT_D16: internal_format = GL_DEPTH_COMPONENT16; format = GL_DEPTH_COMPONENT; type = GL_FLOAT; break;
+		case MRL_TEXTURE_FORMAT_D32: internal_format = GL_DEPTH_COMPONENT32F; format = GL_DEPTH_COMPONENT; type = GL_FLOAT; break;
+		case MRL_TEXTURE_FORMAT_D24S8: internal_format = GL_DEPTH24_STENCIL8; format = GL_DEPTH_STENCIL; type = GL_UNSIGNED_INT_24_8; break;
+		case MRL_TEXTURE_FORMAT_D32S8: internal_format = GL_DEPTH32F_STENCIL8; format = GL_DEPTH_STENCIL; type = GL_FLOAT_32_UNSIGNED_INT_24_8_REV; break;
+
+		case MRL_TEXTURE_FORMAT_BC1_UN:
+		case MRL_TEXTURE_FORMAT_BC2_UN:
+		case MRL_TEXTURE_FORMAT_BC3_UN:
+		case MRL_TEXTURE_FORMAT_BC4_UN:
+		case MRL_TEXTURE_FORMAT_BC4_SN:
+		case MRL_TEXTURE_FORMAT_BC5_UN:
+		case MRL_TEXTURE_FORMAT_BC5_SN:
+		case MRL_TEXTURE_FORMAT_BC6H_UF:
+		case MRL_TEXTURE_FORMAT_BC6H_SF:
+		case MRL_TEXTURE_FORMAT_BC7_UN:
+		case MRL_TEXTURE_FORMAT_ETC2_RGB8_UN:
+		case MRL_TEXTURE_FORMAT_ETC2_RGB8A1_UN:
+		case MRL_TEXTURE_FORMAT_ETC2_RGBA8_UN:
+			get_compressed_format(rd, desc->format, &internal_format, &format, &type);
+			break;
+
+		default:
+			if (rd->error_callback != NULL)
+				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create 2D texture array: invalid format");
+			return MRL_ERROR_INVALID_PARAMS;
 	}
 
-	// Get usage
-	GLenum usage;
+	if (!check_mip_chain(rd, desc->mip_level_count, desc->width, desc->height, 1, u8"Failed to create 2D texture array: invalid mip level count"))
+		return MRL_ERROR_INVALID_PARAMS;
 
-	if (desc->usage == MRL_CONSTANT_BUFFER_USAGE_DEFAULT)
-		usage = GL_STATIC_DRAW;
-	else if (desc->usage == MRL_CONSTANT_BUFFER_USAGE_STATIC)
-		usage = GL_STATIC_DRAW;
-	else if (desc->usage == MRL_CONSTANT_BUFFER_USAGE_DYNAMIC)
-		usage = GL_DYNAMIC_DRAW;
-	else if (desc->usage == MRL_CONSTANT_BUFFER_USAGE_STREAM)
-		usage = GL_STREAM_DRAW;
-	else
+	if (desc->layer_count == 0 || desc->layer_count > MRL_MAX_TEXTURE_2D_ARRAY_LAYER_COUNT)
 	{
 		if (rd->error_callback != NULL)
-			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create constant buffer: invalid usage mode");
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create 2D texture array: invalid layer count");
 		return MRL_ERROR_INVALID_PARAMS;
 	}
 
-	// Initialize constant buffer
+	// Initialize texture, with immutable storage if supported.
+	// Layers aren't halved between mip levels
 	GLuint id;
-	glGenBuffers(1, &id);
-	glBindBuffer(GL_UNIFORM_BUFFER, id);
-	if (desc->data == NULL)
-		glBufferData(GL_UNIFORM_BUFFER, desc->size, NULL, usage);
+	glGenTextures(1, &id);
+	bind_texture(rd, GL_TEXTURE_2D_ARRAY, id);
+	if (rd->limits.texture_storage)
+		glTexStorage3D(GL_TEXTURE_2D_ARRAY, (GLsizei)desc->mip_level_count, internal_format, (GLsizei)desc->width, (GLsizei)desc->height, (GLsizei)desc->layer_count);
 	else
-		glBufferData(GL_UNIFORM_BUFFER, desc->size, desc->data, usage);
+	{
+		for (mgl_u32_t i = 0; i < desc->mip_level_count; ++i)
+			allocate_image_layers(GL_TEXTURE_2D_ARRAY, i, desc->format, internal_format, format, type, get_mip_size(desc->width, i), get_mip_size(desc->height, i), (GLsizei)desc->layer_count);
+		set_texture_mip_range(GL_TEXTURE_2D_ARRAY, desc->mip_level_count);
+	}
+
+	// Upload initial data
+	mrl_error_t upload_err = MRL_ERROR_NONE;
+	for (mgl_u32_t i = 0; i < desc->mip_level_count && upload_err == MRL_ERROR_NONE; ++i)
+		if (desc->data[i] != NULL)
+			upload_err = update_image_layers(rd, GL_TEXTURE_2D_ARRAY, i, desc->format, internal_format, format, type, 0, 0, 0, (mgl_u64_t)get_mip_size(desc->width, i), (mgl_u64_t)get_mip_size(desc->height, i), desc->layer_count, desc->data[i]);
+
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
 	// Check errors
-	GLenum gl_err = glGetError();
-	if (gl_err != 0)
+	GLenum gl_err = get_gl_error(rd);
+	if (gl_err != 0 || upload_err != MRL_ERROR_NONE)
 	{
-		glDeleteBuffers(1, &id);
+		glDeleteTextures(1, &id);
+		forget_texture(rd, GL_TEXTURE_2D_ARRAY, id);
+		if (upload_err != MRL_ERROR_NONE)
+			return upload_err;
 		if (rd->error_callback != NULL)
 			rd->error_callback(MRL_ERROR_EXTERNAL, opengl_error_code_to_str(gl_err));
 		return MRL_ERROR_EXTERNAL;
 	}
 
 	// Allocate object
-	mrl_ogl_330_constant_buffer_t* obj;
-	mgl_error_t err = mgl_allocate(
-		&rd->memory.constant_buffer.pool,
-		sizeof(*obj),
+	mrl_ogl_330_texture_2d_array_t* obj;
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.texture_2d_array,
 		(void**)&obj);
 	if (err != MGL_ERROR_NONE)
 	{
-		glDeleteBuffers(1, &id);
+		glDeleteTextures(1, &id);
+		forget_texture(rd, GL_TEXTURE_2D_ARRAY, id);
 		return mrl_make_mgl_error(err);
 	}
 
-	// Store constant buffer info
+	// Store texture info
 	obj->id = id;
-	*cb = (mrl_constant_buffer_t*)obj;
+	obj->width = desc->width;
+	obj->mip_level_count = desc->mip_level_count;
+	obj->height = desc->height;
+	obj->layer_count = desc->layer_count;
+	obj->internal_format = internal_format;
+	obj->format = format;
+	obj->type = type;
+	obj->texture_format = desc->format;
+	*tex = (mrl_texture_2d_array_t*)obj;
 
 	return MRL_ERROR_NONE;
 }
 
-static void destroy_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t* cb)
+static void destroy_texture_2d_array(mrl_render_device_t* brd, mrl_texture_2d_array_t* tex)
 {
 	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
-	mrl_ogl_330_constant_buffer_t* obj = (mrl_ogl_330_constant_buffer_t*)cb;
+	mrl_ogl_330_texture_2d_array_t* obj = (mrl_ogl_330_texture_2d_array_t*)tex;
 
-	// Delete constant buffer
-	glDeleteBuffers(1, &obj->id);
+	// Delete texture
+	glDeleteTextures(1, &obj->id);
+	forget_texture(rd, GL_TEXTURE_2D_ARRAY, obj->id);
 
 	// Deallocate object
-	mgl_deallocate(
-		&rd->memory.constant_buffer.pool,
+	mrl_deallocate_object(
+		&rd->memory.texture_2d_array,
 		obj);
 }
 
-static void bind_constant_buffer(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_constant_buffer_t* cb)
+static void generate_texture_2d_array_mipmaps(mrl_render_device_t* brd, mrl_texture_2d_array_t* tex)
 {
 	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
-	mrl_ogl_330_constant_buffer_t* obj = (mrl_ogl_330_constant_buffer_t*)cb;
-	mrl_ogl_330_shader_binding_point_t* rbp = (mrl_ogl_330_shader_binding_point_t*)bp;
-
-	// Bind constant buffer
-	if (cb == NULL)
-		glBindBufferBase(GL_UNIFORM_BUFFER, rbp->loc, 0);
-	else
-		glBindBufferBase(GL_UNIFORM_BUFFER, rbp->loc, obj->id);
-}
+	mrl_ogl_330_texture_2d_array_t* obj = (mrl_ogl_330_texture_2d_array_t*)tex;
 
-static void* map_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t* cb)
-{
-	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
-	mrl_ogl_330_constant_buffer_t* obj = (mrl_ogl_330_constant_buffer_t*)cb;
+	if (!check_mip_generation(rd, obj->mip_level_count, obj->width, obj->height, 1, u8"Failed to generate 2D texture array mipmaps: the texture was created with a single mip level"))
+		return;
 
-	// Map UBO
-	glBindBuffer(GL_UNIFORM_BUFFER, obj->id);
-	return glMapBuffer(GL_UNIFORM_BUFFER, GL_WRITE_ONLY);
+	bind_texture(rd, GL_TEXTURE_2D_ARRAY, obj->id);
+	glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
 }
 
-static void unmap_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t* cb)
+static void bind_texture_2d_array(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_texture_2d_array_t* tex)
 {
 	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
-	mrl_ogl_330_constant_buffer_t* obj = (mrl_ogl_330_constant_buffer_t*)cb;
+	mrl_ogl_330_texture_2d_array_t* obj = (mrl_ogl_330_texture_2d_array_t*)tex;
+	mrl_ogl_330_shader_binding_point_t* rbp = (mrl_ogl_330_shader_binding_point_t*)bp;
 
-	// Unmap UBO
-	glBindBuffer(GL_UNIFORM_BUFFER, obj->id);
-	glUnmapBuffer(GL_UNIFORM_BUFFER);
+	// Bind texture to the unit assigned to the sampler uniform
+	MGL_DEBUG_ASSERT(rbp->unit >= 0);
+	if (tex == NULL)
+		bind_texture_unit(rd, (GLuint)rbp->unit, GL_TEXTURE_2D_ARRAY, 0);
+	else
+		bind_texture_unit(rd, (GLuint)rbp->unit, GL_TEXTURE_2D_ARRAY, obj->id);
 }
 
-static void update_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size, const void* data)
+static mrl_error_t update_texture_2d_array(mrl_render_device_t* brd, mrl_texture_2d_array_t* tex, const mrl_texture_2d_array_update_desc_t* desc)
 {
 	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
-	mrl_ogl_330_constant_buffer_t* obj = (mrl_ogl_330_constant_buffer_t*)cb;
-
-	// Update UBO
-	glBindBuffer(GL_UNIFORM_BUFFER, obj->id);
-	glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+	mrl_ogl_330_texture_2d_array_t* obj = (mrl_ogl_330_texture_2d_array_t*)tex;
 
-	// Check errors
-	GLenum gl_err = glGetError();
-	if (gl_err != 0)
+	// Check for input errors
+	if (desc->layer_count == 0 || desc->dst_layer + desc->layer_count > obj->layer_count)
 	{
 		if (rd->error_callback != NULL)
-			rd->error_callback(MRL_ERROR_EXTERNAL, opengl_error_code_to_str(gl_err));
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to update 2D texture array: layers out of bounds");
+		return MRL_ERROR_INVALID_PARAMS;
 	}
-}
-
-static void query_constant_buffer_structure(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_constant_buffer_structure_t* cbs)
-{
-	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
-	mrl_ogl_330_shader_binding_point_t* obj = (mrl_ogl_330_shader_binding_point_t*)bp;
-
-	cbs->element_count = 0;
-
-	GLint data_size = 0;
-	glGetActiveUniformBlockiv(obj->pp->id, obj->loc, GL_UNIFORM_BLOCK_DATA_SIZE, &data_size);
-	cbs->size = data_size;
-
-	GLint element_count = 0;
-	glGetActiveUniformBlockiv(obj->pp->id, obj->loc, GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS, &element_count);
-	cbs->element_count = element_count;
-	
-	MGL_DEBUG_ASSERT(cbs->element_count <= MRL_MAX_CONSTANT_BUFFER_ELEMENT_COUNT);
-
-	GLint element_indices[MRL_MAX_CONSTANT_BUFFER_ELEMENT_COUNT];
-	glGetActiveUniformBlockiv(obj->pp->id, obj->loc, GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES, element_indices);
-
-	for (mgl_u64_t i = 0; i < element_count; ++i)
-	{
-		// Get name
-		mgl_chr8_t element_name[128];
-
-		GLint name_len;
-		glGetActiveUniformsiv(obj->pp->id, 1, &element_indices[i], GL_UNIFORM_NAME_LENGTH, &name_len);
-		MGL_DEBUG_ASSERT(name_len <= 128);
-		glGetActiveUniformName(obj->pp->id, element_indices[i], sizeof(element_name), NULL, element_name);
-
-		mgl_u64_t name_offset;
-		for (name_offset = 0; name_offset < 128; ++name_offset)
-			if (element_name[name_offset] == '.')
-				break;
-		name_offset += 1;
-
-		mgl_u64_t name_max_size;
-		for (name_max_size = 0; name_max_size < MRL_MAX_CONSTANT_BUFFER_ELEMENT_NAME_SIZE; ++name_max_size)
-			if (element_name[name_offset + name_max_size] == '[')
-				break;
-		name_max_size += 1;
-		mgl_str_copy(element_name + name_offset, cbs->elements[i].name, name_max_size);
-
-		// Get array stride, buffer offset and array size
-		GLint stride, offset, size;
-		glGetActiveUniformsiv(obj->pp->id, 1, &element_indices[i], GL_UNIFORM_ARRAY_STRIDE, &stride);
-		glGetActiveUniformsiv(obj->pp->id, 1, &element_indices[i], GL_UNIFORM_OFFSET, &offset);
-		glGetActiveUniformsiv(obj->pp->id, 1, &element_indices[i], GL_UNIFORM_SIZE, &size);
 
-		cbs->elements[i].array_stride = stride;
-		cbs->elements[i].offset = offset;
-		cbs->elements[i].size = size;
-	}
+	// Update texture
+	bind_texture(rd, GL_TEXTURE_2D_ARRAY, obj->id);
+	mrl_error_t err = update_image_layers(rd, GL_TEXTURE_2D_ARRAY, desc->mip_level, obj->texture_format, obj->internal_format, obj->format, obj->type, desc->dst_x, desc->dst_y, desc->dst_layer, desc->width, desc->height, desc->layer_count, desc->data);
+	if (err != MRL_ERROR_NONE)
+		return err;
 
 	// Check errors
-	GLenum gl_err = glGetError();
+	GLenum gl_err = get_gl_error(rd);
 	if (gl_err != 0)
 	{
 		if (rd->error_callback != NULL)
 			rd->error_callback(MRL_ERROR_EXTERNAL, opengl_error_code_to_str(gl_err));
+		return MRL_ERROR_EXTERNAL;
 	}
+
+	return MRL_ERROR_NONE;
 }
 
-// ---------- Index buffers ----------
+// ---------- Cube map array ----------
 
-static mrl_error_t create_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t** ib, const mrl_index_buffer_desc_t* desc)
+static mrl_error_t create_cube_map_array(mrl_render_device_t* brd, mrl_cube_map_array_t** tex, const mrl_cube_map_array_desc_t* desc)
 {
 	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
 
-	// Check for invalid input
-	if (desc->usage == MRL_INDEX_BUFFER_USAGE_STATIC && desc->data == NULL)
+	// Cube map arrays aren't core in OpenGL 3.3
+	if (!rd->limits.texture_cube_map_array)
 	{
 		if (rd->error_callback != NULL)
-			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create index buffer: when the usage mode is set to static, the pointer to the initial data must not be NULL");
-		return MRL_ERROR_INVALID_PARAMS;
+			rd->error_callback(MRL_ERROR_UNSUPPORTED_DEVICE, u8"Failed to create cube map array: ARB_texture_cube_map_array isn't supported");
+		return MRL_ERROR_UNSUPPORTED_DEVICE;
 	}
 
-	// Get format
-	GLenum format;
+	// Get internal format, format and type
+	GLenum internal_format, format, type;
 
-	if (desc->format == MRL_INDEX_BUFFER_FORMAT_U16)
-		format = GL_UNSIGNED_SHORT;
-	else if (desc->format == MRL_INDEX_BUFFER_FORMAT_U32)
-		format = GL_UNSIGNED_INT;
-	else
+	switch (desc->format)
 	{
-		if (rd->error_callback != NULL)
-			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create index buffer: invalid index format");
-		return MRL_ERROR_INVALID_PARAMS;
+		case MRL_TEXTURE_FORMAT_R8_UN: internal_format = GL_R8; format = GL_RED; type = GL_UNSIGNED_BYTE; break;
+		case MRL_TEXTURE_FORMAT_R8_SN: internal_format = GL_R8_SNORM; format = GL_RED; type = GL_BYTE; break;
+		case MRL_TEXTURE_FORMAT_R8_UI: internal_format = GL_R8UI; format = GL_RED_INTEGER; type = GL_UNSIGNED_BYTE; break;
+		case MRL_TEXTURE_FORMAT_R8_SI: internal_format = GL_R8I; format = GL_RED_INTEGER; type = GL_BYTE; break;
+		case MRL_TEXTURE_FORMAT_RG8_UN: internal_format = GL_RG8; format = GL_RG; type = GL_UNSIGNED_BYTE; break;
+		case MRL_TEXTURE_FORMAT_RG8_SN: internal_format = GL_RG8_SNORM; format = GL_RG; type = GL_BYTE; break;
+		case MRL_TEXTURE_FORMAT_RG8_UI: internal_format = GL_RG8UI; format = GL_RG_INTEGER; type = GL_UNSIGNED_BYTE; break;
+		case MRL_TEXTURE_FORMAT_RG8_SI: internal_format = GL_RG8I; format = GL_RG_INTEGER; type = GL_BYTE; break;
+		case MRL_TEXTURE_FORMAT_RGBA8_UN: internal_format = GL_RGBA8; format = GL_RGBA; type = GL_UNSIGNED_BYTE; break;
+		case MRL_TEXTURE_FORMAT_RGBA8_SN: internal_format = GL_RGBA8_SNORM; format = GL_RGBA; type = GL_BYTE; break;
+		case MRL_TEXTURE_FORMAT_RGBA8_UI: internal_format = GL_RGBA8UI; format = GL_RGBA_INTEGER; type = GL_UNSIGNED_BYTE; break;
+		case MRL_TEXTURE_FORMAT_RGBA8_SI: internal_format = GL_RGBA8I; format = GL_RGBA_INTEGER; type = GL_BYTE; break;
+
+		case MRL_TEXTURE_FORMAT_R16_UN: internal_format = GL_R16; format = GL_RED; type = GL_UNSIGNED_SHORT; break;
+		case MRL_TEXTURE_FORMAT_R16_SN: internal_format = GL_R16_SNORM; format = GL_RED; type = GL_SHORT; break;
+		case MRL_TEXTURE_FORMAT_R16_UI: internal_format = GL_R16UI; format = GL_RED_INTEGER; type = GL_UNSIGNED_SHORT; break;
+		case MRL_TEXTURE_FORMAT_R16_SI: internal_format = GL_R16I; format = GL_RED_INTEGER; type = GL_SHORT; break;
+		case MRL_TEXTURE_FORMAT_RG16_UN: internal_format = GL_RG16; format = GL_RG; type = GL_UNSIGNED_SHORT; break;
+		case MRL_TEXTURE_FORMAT_RG16_SN: internal_format = GL_RG16_SNORM; format = GL_RG; type = GL_SHORT; break;
+		case MRL_TEXTURE_FORMAT_RG16_UI: internal_format = GL_RG16UI; format = GL_RG_INTEGER; type = GL_UNSIGNED_SHORT; break;
+		case MRL_TEXTURE_FORMAT_RG16_SI: internal_format = GL_RG16I; format = GL_RG_INTEGER; type = GL_SHORT; break;
+		case MRL_TEXTURE_FORMAT_RGBA16_UN: internal_format = GL_RGBA16; format = GL_RGBA; type = GL_UNSIGNED_SHORT; break;
+		case MRL_TEXTURE_FORMAT_RGBA16_SN: internal_format = GL_RGBA16_SNORM; format = GL_RGBA; type = GL_SHORT; break;
+		case MRL_TEXTURE_FORMAT_RGBA16_UI: internal_format = GL_RGBA16UI; format = GL_RGBA_INTEGER; type = GL_UNSIGNED_SHORT; break;
+		case MRL_TEXTURE_FORMAT_RGBA16_SI: internal_format = GL_RGBA16I; format = GL_RGBA_INTEGER; type = GL_SHORT; break;
+
+		case MRL_TEXTURE_FORMAT_R32_UI: internal_format = GL_R32UI; format = GL_RED_INTEGER; type = GL_UNSIGNED_INT; break;
+		case MRL_TEXTURE_FORMAT_R32_SI: internal_format = GL_R32I; format = GL_RED_INTEGER; type = GL_INT; break;
+		case MRL_TEXTURE_FORMAT_R32_F: internal_format = GL_R32F; format = GL_RED; type = GL_FLOAT; break;
+		case MRL_TEXTURE_FORMAT_RG32_UI: internal_format = GL_RG32UI; format = GL_RG_INTEGER; type = GL_UNSIGNED_INT; break;
+		case MRL_TEXTURE_FORMAT_RG32_SI: internal_format = GL_RG32I; format = GL_RG_INTEGER; type = GL_INT; break;
+		case MRL_TEXTURE_FORMAT_RG32_F: internal_format = GL_RG32F; format = GL_RG; type = GL_FLOAT; break;
+		case MRL_TEXTURE_FORMAT_RGBA32_UI: internal_format = GL_RGBA32UI; format = GL_RGBA_INTEGER; type = GL_UNSIGNED_INT; break;
+		case MRL_TEXTURE_FORMAT_RGBA32_SI: internal_format = GL_RGBA32I; format = GL_RGBA_INTEGER; type = GL_INT; break;
+		case MRL_TEXTURE_FORMAT_RGBA32_F: internal_format = GL_RGBA32F; format = GL_RGBA; type = GL_FLOAT; break;
+
+		case MRL_TEXTURE_FORMAT_BC1_UN:
+		case MRL_TEXTURE_FORMAT_BC2_UN:
+		case MRL_TEXTURE_FORMAT_BC3_UN:
+		case MRL_TEXTURE_FORMAT_BC4_UN:
+		case MRL_TEXTURE_FORMAT_BC4_SN:
+		case MRL_TEXTURE_FORMAT_BC5_UN:
+		case MRL_TEXTURE_FORMAT_BC5_SN:
+		case MRL_TEXTURE_FORMAT_BC6H_UF:
+		case MRL_TEXTURE_FORMAT_BC6H_SF:
+		case MRL_TEXTURE_FORMAT_BC7_UN:
+		case MRL_TEXTURE_FORMAT_ETC2_RGB8_UN:
+		case MRL_TEXTURE_FORMAT_ETC2_RGB8A1_UN:
+		case MRL_TEXTURE_FORMAT_ETC2_RGBA8_UN:
+			get_compressed_format(rd, desc->format, &internal_format, &format, &type);
+			break;
+
+		default:
+			if (rd->error_callback != NULL)
+				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create cube map array: invalid format");
+			return MRL_ERROR_INVALID_PARAMS;
 	}
 
-	// Get usage
-	GLenum usage;
+	if (!check_mip_chain(rd, desc->mip_level_count, desc->width, desc->height, 1, u8"Failed to create cube map array: invalid mip level count"))
+		return MRL_ERROR_INVALID_PARAMS;
 
-	if (desc->usage == MRL_INDEX_BUFFER_USAGE_DEFAULT)
-		usage = GL_STATIC_DRAW;
-	else if (desc->usage == MRL_INDEX_BUFFER_USAGE_STATIC)
-		usage = GL_STATIC_DRAW;
-	else if (desc->usage == MRL_INDEX_BUFFER_USAGE_DYNAMIC)
-		usage = GL_DYNAMIC_DRAW;
-	else if (desc->usage == MRL_INDEX_BUFFER_USAGE_STREAM)
-		usage = GL_STREAM_DRAW;
-	else
+	if (desc->layer_count == 0 || desc->layer_count > MRL_MAX_CUBE_MAP_ARRAY_LAYER_COUNT)
 	{
 		if (rd->error_callback != NULL)
-			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create index buffer: invalid usage mode");
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create cube map array: invalid layer count");
 		return MRL_ERROR_INVALID_PARAMS;
 	}
 
-	// Initialize index buffer
+	// Initialize texture, with immutable storage if supported.
+	// Every cube is stored as six layer-faces, which aren't halved between mip levels
+	GLsizei face_count = (GLsizei)desc->layer_count * 6;
 	GLuint id;
-	glGenBuffers(1, &id);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, id);
-	if (desc->data == NULL)
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, desc->size, NULL, usage);
+	glGenTextures(1, &id);
+	bind_texture(rd, GL_TEXTURE_CUBE_MAP_ARRAY, id);
+	if (rd->limits.texture_storage)
+		glTexStorage3D(GL_TEXTURE_CUBE_MAP_ARRAY, (GLsizei)desc->mip_level_count, internal_format, (GLsizei)desc->width, (GLsizei)desc->height, face_count);
 	else
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, desc->size, desc->data, usage);
+	{
+		for (mgl_u32_t i = 0; i < desc->mip_level_count; ++i)
+			allocate_image_layers(GL_TEXTURE_CUBE_MAP_ARRAY, i, desc->format, internal_format, format, type, get_mip_size(desc->width, i), get_mip_size(desc->height, i), face_count);
+		set_texture_mip_range(GL_TEXTURE_CUBE_MAP_ARRAY, desc->mip_level_count);
+	}
+
+	// Upload initial data
+	mrl_error_t upload_err = MRL_ERROR_NONE;
+	for (mgl_u32_t i = 0; i < desc->mip_level_count && upload_err == MRL_ERROR_NONE; ++i)
+		if (desc->data[i] != NULL)
+			upload_err = update_image_layers(rd, GL_TEXTURE_CUBE_MAP_ARRAY, i, desc->format, internal_format, format, type, 0, 0, 0, (mgl_u64_t)get_mip_size(desc->width, i), (mgl_u64_t)get_mip_size(desc->height, i), (mgl_u64_t)face_count, desc->data[i]);
+
+	glTexParameteri(GL_TEXTURE_CUBE_MAP_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP_ARRAY, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 
 	// Check errors
-	GLenum gl_err = glGetError();
-	if (gl_err != 0)
+	GLenum gl_err = get_gl_error(rd);
+	if (gl_err != 0 || upload_err != MRL_ERROR_NONE)
 	{
-		glDeleteBuffers(1, &id);
+		glDeleteTextures(1, &id);
+		forget_texture(rd, GL_TEXTURE_CUBE_MAP_ARRAY, id);
+		if (upload_err != MRL_ERROR_NONE)
+			return upload_err;
 		if (rd->error_callback != NULL)
 			rd->error_callback(MRL_ERROR_EXTERNAL, opengl_error_code_to_str(gl_err));
 		return MRL_ERROR_EXTERNAL;
 	}
 
 	// Allocate object
-	mrl_ogl_330_index_buffer_t* obj;
-	mgl_error_t err = mgl_allocate(
-		&rd->memory.index_buffer.pool,
-		sizeof(*obj),
+	mrl_ogl_330_cube_map_array_t* obj;
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.cube_map_array,
 		(void**)&obj);
 	if (err != MGL_ERROR_NONE)
 	{
-		glDeleteBuffers(1, &id);
+		glDeleteTextures(1, &id);
+		forget_texture(rd, GL_TEXTURE_CUBE_MAP_ARRAY, id);
 		return mrl_make_mgl_error(err);
 	}
 
-	// Store index buffer info
+	// Store texture info
 	obj->id = id;
+	obj->width = desc->width;
+	obj->mip_level_count = desc->mip_level_count;
+	obj->height = desc->height;
+	obj->layer_count = desc->layer_count;
+	obj->internal_format = internal_format;
 	obj->format = format;
-	*ib = (mrl_index_buffer_t*)obj;
+	obj->type = type;
+	obj->texture_format = desc->format;
+	*tex = (mrl_cube_map_array_t*)obj;
 
 	return MRL_ERROR_NONE;
 }
 
-static void destroy_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib)
+static void destroy_cube_map_array(mrl_render_device_t* brd, mrl_cube_map_array_t* tex)
 {
 	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
-	mrl_ogl_330_index_buffer_t* obj = (mrl_ogl_330_index_buffer_t*)ib;
+	mrl_ogl_330_cube_map_array_t* obj = (mrl_ogl_330_cube_map_array_t*)tex;
 
-	// Delete index buffer
-	glDeleteBuffers(1, &obj->id);
+	// Delete texture
+	glDeleteTextures(1, &obj->id);
+	forget_texture(rd, GL_TEXTURE_CUBE_MAP_ARRAY, obj->id);
 
 	// Deallocate object
-	mgl_deallocate(
-		&rd->memory.index_buffer.pool,
+	mrl_deallocate_object(
+		&rd->memory.cube_map_array,
 		obj);
 }
 
-static void set_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib)
+static void generate_cube_map_array_mipmaps(mrl_render_device_t* brd, mrl_cube_map_array_t* tex)
 {
 	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
-	mrl_ogl_330_index_buffer_t* obj = (mrl_ogl_330_index_buffer_t*)ib;
+	mrl_ogl_330_cube_map_array_t* obj = (mrl_ogl_330_cube_map_array_t*)tex;
 
-	// Set index buffer
-	if (obj == NULL)
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-	else
-	{
-		rd->state.index_buffer_format = obj->format;
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, obj->id);
-	}
+	if (!check_mip_generation(rd, obj->mip_level_count, obj->width, obj->height, 1, u8"Failed to generate cube map array mipmaps: the texture was created with a single mip level"))
+		return;
+
+	bind_texture(rd, GL_TEXTURE_CUBE_MAP_ARRAY, obj->id);
+	glGenerateMipmap(GL_TEXTURE_CUBE_MAP_ARRAY);
 }
 
-static void* map_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib)
+static void bind_cube_map_array(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_cube_map_array_t* tex)
 {
 	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
-	mrl_ogl_330_index_buffer_t* obj = (mrl_ogl_330_index_buffer_t*)ib;
+	mrl_ogl_330_cube_map_array_t* obj = (mrl_ogl_330_cube_map_array_t*)tex;
+	mrl_ogl_330_shader_binding_point_t* rbp = (mrl_ogl_330_shader_binding_point_t*)bp;
 
-	// Map IBO
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, obj->id);
-	return glMapBuffer(GL_ELEMENT_ARRAY_BUFFER, GL_WRITE_ONLY);
+	// Bind texture to the unit assigned to the sampler uniform
+	MGL_DEBUG_ASSERT(rbp->unit >= 0);
+	if (tex == NULL)
+		bind_texture_unit(rd, (GLuint)rbp->unit, GL_TEXTURE_CUBE_MAP_ARRAY, 0);
+	else
+		bind_texture_unit(rd, (GLuint)rbp->unit, GL_TEXTURE_CUBE_MAP_ARRAY, obj->id);
 }
 
-static void unmap_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib)
+static mrl_error_t update_cube_map_array(mrl_render_device_t* brd, mrl_cube_map_array_t* tex, const mrl_cube_map_array_update_desc_t* desc)
 {
 	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
-	mrl_ogl_330_index_buffer_t* obj = (mrl_ogl_330_index_buffer_t*)ib;
+	mrl_ogl_330_cube_map_array_t* obj = (mrl_ogl_330_cube_map_array_t*)tex;
 
-	// Unmap IBO
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, obj->id);
-	glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+	// Check for input errors, faces are indexed by layer * 6 + face
+	if (desc->face_count == 0 || desc->dst_face + desc->face_count > obj->layer_count * 6)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to update cube map array: faces out of bounds");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	// Update texture
+	bind_texture(rd, GL_TEXTURE_CUBE_MAP_ARRAY, obj->id);
+	mrl_error_t err = update_image_layers(rd, GL_TEXTURE_CUBE_MAP_ARRAY, desc->mip_level, obj->texture_format, obj->internal_format, obj->format, obj->type, desc->dst_x, desc->dst_y, desc->dst_face, desc->width, desc->height, desc->face_count, desc->data);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	// Check errors
+	GLenum gl_err = get_gl_error(rd);
+	if (gl_err != 0)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_EXTERNAL, opengl_error_code_to_str(gl_err));
+		return MRL_ERROR_EXTERNAL;
+	}
+
+	return MRL_ERROR_NONE;
 }
 
-static void update_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size, const void* data)
+// ---------- Buffer mapping ----------
+
+static void* map_buffer_range(mrl_ogl_330_render_device_t* rd, GLenum target, mgl_u64_t offset, mgl_u64_t size, mgl_u32_t flags)
 {
-	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
-	mrl_ogl_330_index_buffer_t* obj = (mrl_ogl_330_index_buffer_t*)ib;
+	// Check for invalid input
+	if ((flags & (MRL_MAP_READ | MRL_MAP_WRITE)) == 0)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to map buffer range: either MRL_MAP_READ or MRL_MAP_WRITE must be set");
+		return NULL;
+	}
 
-	// Update IBO
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, obj->id);
-	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset, size, data);
+	if ((flags & MRL_MAP_READ) && (flags & (MRL_MAP_DISCARD_RANGE | MRL_MAP_DISCARD_WHOLE)))
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to map buffer range: discard flags cannot be used with MRL_MAP_READ");
+		return NULL;
+	}
+
+	if ((flags & MRL_MAP_READ) && (flags & MRL_MAP_NO_OVERWRITE))
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to map buffer range: MRL_MAP_NO_OVERWRITE cannot be used with MRL_MAP_READ");
+		return NULL;
+	}
+
+	if ((flags & MRL_MAP_FLUSH_EXPLICIT) && !(flags & MRL_MAP_WRITE))
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to map buffer range: MRL_MAP_FLUSH_EXPLICIT requires MRL_MAP_WRITE");
+		return NULL;
+	}
+
+	// Get access
+	GLbitfield access = 0;
+	if (flags & MRL_MAP_READ)
+		access |= GL_MAP_READ_BIT;
+	if (flags & MRL_MAP_WRITE)
+		access |= GL_MAP_WRITE_BIT;
+	if (flags & MRL_MAP_DISCARD_RANGE)
+		access |= GL_MAP_INVALIDATE_RANGE_BIT;
+	if (flags & MRL_MAP_DISCARD_WHOLE)
+		access |= GL_MAP_INVALIDATE_BUFFER_BIT;
+	if (flags & MRL_MAP_NO_OVERWRITE)
+		access |= GL_MAP_UNSYNCHRONIZED_BIT;
+	if (flags & MRL_MAP_FLUSH_EXPLICIT)
+		access |= GL_MAP_FLUSH_EXPLICIT_BIT;
+
+	// Map range
+	void* data = glMapBufferRange(target, (GLintptr)offset, (GLsizeiptr)size, access);
 
 	// Check errors
-	GLenum gl_err = glGetError();
-	if (gl_err != 0)
+	if (data == NULL)
 	{
 		if (rd->error_callback != NULL)
-			rd->error_callback(MRL_ERROR_EXTERNAL, opengl_error_code_to_str(gl_err));
+			rd->error_callback(MRL_ERROR_EXTERNAL, opengl_error_code_to_str(glGetError()));
 	}
+
+	return data;
 }
 
-static mrl_error_t create_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t** vb, const mrl_vertex_buffer_desc_t* desc)
+// ---------- Constant buffers ----------
+
+static mrl_error_t create_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t** cb, const mrl_constant_buffer_desc_t* desc)
 {
 	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
 
 	// Check for invalid input
-	if (desc->usage == MRL_VERTEX_BUFFER_USAGE_STATIC && desc->data == NULL)
+	if (desc->usage == MRL_CONSTANT_BUFFER_USAGE_STATIC && desc->data == NULL)
 	{
 		if (rd->error_callback != NULL)
-			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create vertex buffer: when the usage mode is set to static, the pointer to the initial data must not be NULL");
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create constant buffer: when the usage mode is set to static, the pointer to the initial data must not be NULL");
 		return MRL_ERROR_INVALID_PARAMS;
 	}
 
 	// Get usage
 	GLenum usage;
 
-	if (desc->usage == MRL_VERTEX_BUFFER_USAGE_DEFAULT)
+	if (desc->usage == MRL_CONSTANT_BUFFER_USAGE_DEFAULT)
 		usage = GL_STATIC_DRAW;
-	else if (desc->usage == MRL_VERTEX_BUFFER_USAGE_STATIC)
+	else if (desc->usage == MRL_CONSTANT_BUFFER_USAGE_STATIC)
 		usage = GL_STATIC_DRAW;
-	else if (desc->usage == MRL_VERTEX_BUFFER_USAGE_DYNAMIC)
+	else if (desc->usage == MRL_CONSTANT_BUFFER_USAGE_DYNAMIC)
 		usage = GL_DYNAMIC_DRAW;
-	else if (desc->usage == MRL_VERTEX_BUFFER_USAGE_STREAM)
+	else if (desc->usage == MRL_CONSTANT_BUFFER_USAGE_STREAM)
 		usage = GL_STREAM_DRAW;
 	else
 	{
 		if (rd->error_callback != NULL)
-			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create vertex buffer: invalid usage mode");
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create constant buffer: invalid usage mode");
 		return MRL_ERROR_INVALID_PARAMS;
 	}
 
-	// Initialize vertex buffer
+	// Initialize constant buffer
 	GLuint id;
 	glGenBuffers(1, &id);
-	glBindBuffer(GL_ARRAY_BUFFER, id);
+	glBindBuffer(GL_UNIFORM_BUFFER, id);
 	if (desc->data == NULL)
-		glBufferData(GL_ARRAY_BUFFER, desc->size, NULL, usage);
+		glBufferData(GL_UNIFORM_BUFFER, desc->size, NULL, usage);
 	else
-		glBufferData(GL_ARRAY_BUFFER, desc->size, desc->data, usage);
+		glBufferData(GL_UNIFORM_BUFFER, desc->size, desc->data, usage);
 
 	// Check errors
-	GLenum gl_err = glGetError();
+	GLenum gl_err = get_gl_error(rd);
 	if (gl_err != 0)
 	{
 		glDeleteBuffers(1, &id);
@@ -2187,10 +3245,9 @@ static mrl_error_t create_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buf
 	}
 
 	// Allocate object
-	mrl_ogl_330_vertex_buffer_t* obj;
-	mgl_error_t err = mgl_allocate(
-		&rd->memory.vertex_buffer.pool,
-		sizeof(*obj),
+	mrl_ogl_330_constant_buffer_t* obj;
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.constant_buffer,
 		(void**)&obj);
 	if (err != MGL_ERROR_NONE)
 	{
@@ -2198,193 +3255,1266 @@ static mrl_error_t create_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buf
 		return mrl_make_mgl_error(err);
 	}
 
-	// Store vertex buffer info
+	// Store constant buffer info
+	obj->id = id;
+	*cb = (mrl_constant_buffer_t*)obj;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t* cb)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_constant_buffer_t* obj = (mrl_ogl_330_constant_buffer_t*)cb;
+
+	// Delete constant buffer
+	glDeleteBuffers(1, &obj->id);
+
+	// Deallocate object
+	mrl_deallocate_object(
+		&rd->memory.constant_buffer,
+		obj);
+}
+
+static void bind_constant_buffer(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_constant_buffer_t* cb)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_constant_buffer_t* obj = (mrl_ogl_330_constant_buffer_t*)cb;
+	mrl_ogl_330_shader_binding_point_t* rbp = (mrl_ogl_330_shader_binding_point_t*)bp;
+
+	// Bind constant buffer
+	if (cb == NULL)
+		glBindBufferBase(GL_UNIFORM_BUFFER, rbp->loc, 0);
+	else
+		glBindBufferBase(GL_UNIFORM_BUFFER, rbp->loc, obj->id);
+}
+
+static void bind_constant_buffer_range(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_constant_buffer_t* obj = (mrl_ogl_330_constant_buffer_t*)cb;
+	mrl_ogl_330_shader_binding_point_t* rbp = (mrl_ogl_330_shader_binding_point_t*)bp;
+
+	// Check for invalid input
+	if (offset % (mgl_u64_t)rd->limits.uniform_buffer_offset_alignment != 0)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to bind constant buffer range: the offset isn't aligned to MRL_PROPERTY_CONSTANT_BUFFER_OFFSET_ALIGNMENT");
+		return;
+	}
+
+	// Bind constant buffer range
+	glBindBufferRange(GL_UNIFORM_BUFFER, rbp->loc, obj->id, (GLintptr)offset, (GLsizeiptr)size);
+}
+
+static void* map_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t* cb)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_constant_buffer_t* obj = (mrl_ogl_330_constant_buffer_t*)cb;
+
+	// Map UBO
+	glBindBuffer(GL_UNIFORM_BUFFER, obj->id);
+	return glMapBuffer(GL_UNIFORM_BUFFER, GL_WRITE_ONLY);
+}
+
+static void unmap_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t* cb)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_constant_buffer_t* obj = (mrl_ogl_330_constant_buffer_t*)cb;
+
+	// Unmap UBO
+	glBindBuffer(GL_UNIFORM_BUFFER, obj->id);
+	glUnmapBuffer(GL_UNIFORM_BUFFER);
+}
+
+static void* map_constant_buffer_range(mrl_render_device_t* brd, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size, mgl_u32_t flags)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_constant_buffer_t* obj = (mrl_ogl_330_constant_buffer_t*)cb;
+
+	// Map UBO range
+	glBindBuffer(GL_UNIFORM_BUFFER, obj->id);
+	return map_buffer_range(rd, GL_UNIFORM_BUFFER, offset, size, flags);
+}
+
+static void flush_constant_buffer_range(mrl_render_device_t* brd, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_constant_buffer_t* obj = (mrl_ogl_330_constant_buffer_t*)cb;
+
+	// Flush UBO range
+	glBindBuffer(GL_UNIFORM_BUFFER, obj->id);
+	glFlushMappedBufferRange(GL_UNIFORM_BUFFER, (GLintptr)offset, (GLsizeiptr)size);
+}
+
+static void update_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_constant_buffer_t* obj = (mrl_ogl_330_constant_buffer_t*)cb;
+
+	// Update UBO
+	glBindBuffer(GL_UNIFORM_BUFFER, obj->id);
+	glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+
+	// Check errors
+	GLenum gl_err = get_gl_error(rd);
+	if (gl_err != 0)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_EXTERNAL, opengl_error_code_to_str(gl_err));
+	}
+}
+
+static void query_constant_buffer_structure(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_constant_buffer_structure_t* cbs)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_shader_binding_point_t* obj = (mrl_ogl_330_shader_binding_point_t*)bp;
+
+	cbs->element_count = 0;
+
+	GLint data_size = 0;
+	glGetActiveUniformBlockiv(obj->pp->id, obj->loc, GL_UNIFORM_BLOCK_DATA_SIZE, &data_size);
+	cbs->size = data_size;
+
+	GLint element_count = 0;
+	glGetActiveUniformBlockiv(obj->pp->id, obj->loc, GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS, &element_count);
+	cbs->element_count = element_count;
+	
+	MGL_DEBUG_ASSERT(cbs->element_count <= MRL_MAX_CONSTANT_BUFFER_ELEMENT_COUNT);
+
+	GLint element_indices[MRL_MAX_CONSTANT_BUFFER_ELEMENT_COUNT];
+	glGetActiveUniformBlockiv(obj->pp->id, obj->loc, GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES, element_indices);
+
+	for (mgl_u64_t i = 0; i < element_count; ++i)
+	{
+		// Get name
+		mgl_chr8_t element_name[128];
+
+		GLint name_len;
+		glGetActiveUniformsiv(obj->pp->id, 1, &element_indices[i], GL_UNIFORM_NAME_LENGTH, &name_len);
+		MGL_DEBUG_ASSERT(name_len <= 128);
+		glGetActiveUniformName(obj->pp->id, element_indices[i], sizeof(element_name), NULL, element_name);
+
+		mgl_u64_t name_offset;
+		for (name_offset = 0; name_offset < 128; ++name_offset)
+			if (element_name[name_offset] == '.')
+				break;
+		name_offset += 1;
+
+		mgl_u64_t name_max_size;
+		for (name_max_size = 0; name_max_size < MRL_MAX_CONSTANT_BUFFER_ELEMENT_NAME_SIZE; ++name_max_size)
+			if (element_name[name_offset + name_max_size] == '[')
+				break;
+		name_max_size += 1;
+		mgl_str_copy(element_name + name_offset, cbs->elements[i].name, name_max_size);
+
+		// Get array stride, buffer offset and array size
+		GLint stride, offset, size;
+		glGetActiveUniformsiv(obj->pp->id, 1, &element_indices[i], GL_UNIFORM_ARRAY_STRIDE, &stride);
+		glGetActiveUniformsiv(obj->pp->id, 1, &element_indices[i], GL_UNIFORM_OFFSET, &offset);
+		glGetActiveUniformsiv(obj->pp->id, 1, &element_indices[i], GL_UNIFORM_SIZE, &size);
+
+		cbs->elements[i].array_stride = stride;
+		cbs->elements[i].offset = offset;
+		cbs->elements[i].size = size;
+	}
+
+	// Check errors
+	GLenum gl_err = get_gl_error(rd);
+	if (gl_err != 0)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_EXTERNAL, opengl_error_code_to_str(gl_err));
+	}
+}
+
+// ---------- Index buffers ----------
+
+static mrl_error_t create_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t** ib, const mrl_index_buffer_desc_t* desc)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+
+	// Check for invalid input
+	if (desc->usage == MRL_INDEX_BUFFER_USAGE_STATIC && desc->data == NULL)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create index buffer: when the usage mode is set to static, the pointer to the initial data must not be NULL");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	// Get format
+	GLenum format;
+
+	if (desc->format == MRL_INDEX_BUFFER_FORMAT_U16)
+		format = GL_UNSIGNED_SHORT;
+	else if (desc->format == MRL_INDEX_BUFFER_FORMAT_U32)
+		format = GL_UNSIGNED_INT;
+	else
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create index buffer: invalid index format");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	// Get usage
+	GLenum usage;
+
+	if (desc->usage == MRL_INDEX_BUFFER_USAGE_DEFAULT)
+		usage = GL_STATIC_DRAW;
+	else if (desc->usage == MRL_INDEX_BUFFER_USAGE_STATIC)
+		usage = GL_STATIC_DRAW;
+	else if (desc->usage == MRL_INDEX_BUFFER_USAGE_DYNAMIC)
+		usage = GL_DYNAMIC_DRAW;
+	else if (desc->usage == MRL_INDEX_BUFFER_USAGE_STREAM)
+		usage = GL_STREAM_DRAW;
+	else
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create index buffer: invalid usage mode");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	// Initialize index buffer
+	GLuint id;
+	glGenBuffers(1, &id);
+	bind_index_buffer(rd, id);
+	if (desc->data == NULL)
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, desc->size, NULL, usage);
+	else
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, desc->size, desc->data, usage);
+
+	// Check errors
+	GLenum gl_err = get_gl_error(rd);
+	if (gl_err != 0)
+	{
+		glDeleteBuffers(1, &id);
+		rd->cache.index_buffer = 0;
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_EXTERNAL, opengl_error_code_to_str(gl_err));
+		return MRL_ERROR_EXTERNAL;
+	}
+
+	// Allocate object
+	mrl_ogl_330_index_buffer_t* obj;
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.index_buffer,
+		(void**)&obj);
+	if (err != MGL_ERROR_NONE)
+	{
+		glDeleteBuffers(1, &id);
+		rd->cache.index_buffer = 0;
+		return mrl_make_mgl_error(err);
+	}
+
+	// Store index buffer info
+	obj->id = id;
+	obj->format = format;
+	*ib = (mrl_index_buffer_t*)obj;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_index_buffer_t* obj = (mrl_ogl_330_index_buffer_t*)ib;
+
+	// Delete index buffer
+	glDeleteBuffers(1, &obj->id);
+	if (rd->cache.index_buffer == obj->id)
+		rd->cache.index_buffer = 0;
+
+	// Deallocate object
+	mrl_deallocate_object(
+		&rd->memory.index_buffer,
+		obj);
+}
+
+static void set_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_index_buffer_t* obj = (mrl_ogl_330_index_buffer_t*)ib;
+
+	// Set index buffer
+	if (obj == NULL)
+		bind_index_buffer(rd, 0);
+	else
+	{
+		rd->state.index_buffer_format = obj->format;
+		bind_index_buffer(rd, obj->id);
+	}
+}
+
+static void* map_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_index_buffer_t* obj = (mrl_ogl_330_index_buffer_t*)ib;
+
+	// Map IBO
+	bind_index_buffer(rd, obj->id);
+	return glMapBuffer(GL_ELEMENT_ARRAY_BUFFER, GL_WRITE_ONLY);
+}
+
+static void unmap_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_index_buffer_t* obj = (mrl_ogl_330_index_buffer_t*)ib;
+
+	// Unmap IBO
+	bind_index_buffer(rd, obj->id);
+	glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+}
+
+static void* map_index_buffer_range(mrl_render_device_t* brd, mrl_index_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size, mgl_u32_t flags)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_index_buffer_t* obj = (mrl_ogl_330_index_buffer_t*)ib;
+
+	// Map IBO range
+	bind_index_buffer(rd, obj->id);
+	return map_buffer_range(rd, GL_ELEMENT_ARRAY_BUFFER, offset, size, flags);
+}
+
+static void flush_index_buffer_range(mrl_render_device_t* brd, mrl_index_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_index_buffer_t* obj = (mrl_ogl_330_index_buffer_t*)ib;
+
+	// Flush IBO range
+	bind_index_buffer(rd, obj->id);
+	glFlushMappedBufferRange(GL_ELEMENT_ARRAY_BUFFER, (GLintptr)offset, (GLsizeiptr)size);
+}
+
+static void update_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_index_buffer_t* obj = (mrl_ogl_330_index_buffer_t*)ib;
+
+	// Update IBO
+	bind_index_buffer(rd, obj->id);
+	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset, size, data);
+
+	// Check errors
+	GLenum gl_err = get_gl_error(rd);
+	if (gl_err != 0)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_EXTERNAL, opengl_error_code_to_str(gl_err));
+	}
+}
+
+// ---------- Indirect buffers ----------
+
+static mrl_error_t create_indirect_buffer(mrl_render_device_t* brd, mrl_indirect_buffer_t** ib, const mrl_indirect_buffer_desc_t* desc)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+
+	// Check for invalid input
+	if (desc->usage == MRL_INDIRECT_BUFFER_USAGE_STATIC && desc->data == NULL)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create indirect buffer: when the usage mode is set to static, the pointer to the initial data must not be NULL");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	// Get usage
+	GLenum usage;
+
+	if (desc->usage == MRL_INDIRECT_BUFFER_USAGE_DEFAULT)
+		usage = GL_STATIC_DRAW;
+	else if (desc->usage == MRL_INDIRECT_BUFFER_USAGE_STATIC)
+		usage = GL_STATIC_DRAW;
+	else if (desc->usage == MRL_INDIRECT_BUFFER_USAGE_DYNAMIC)
+		usage = GL_DYNAMIC_DRAW;
+	else if (desc->usage == MRL_INDIRECT_BUFFER_USAGE_STREAM)
+		usage = GL_STREAM_DRAW;
+	else
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create indirect buffer: invalid usage mode");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	// Allocate object
+	mrl_ogl_330_indirect_buffer_t* obj;
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.indirect_buffer,
+		(void**)&obj);
+	if (err != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(err);
+
+	obj->id = 0;
+	obj->data = NULL;
+	obj->size = desc->size;
+
+	if (!rd->limits.draw_indirect)
+	{
+		// Keep the arguments in system memory
+		if (desc->size > 0)
+		{
+			err = mgl_allocate(rd->allocator, desc->size, (void**)&obj->data);
+			if (err != MGL_ERROR_NONE)
+			{
+				mrl_deallocate_object(&rd->memory.indirect_buffer, obj);
+				return mrl_make_mgl_error(err);
+			}
+
+			if (desc->data != NULL)
+				mgl_mem_copy(obj->data, desc->data, desc->size);
+			else
+				mgl_mem_set(obj->data, desc->size, 0);
+		}
+
+		*ib = (mrl_indirect_buffer_t*)obj;
+		return MRL_ERROR_NONE;
+	}
+
+	// Initialize indirect buffer
+	glGenBuffers(1, &obj->id);
+	bind_indirect_buffer(rd, obj->id);
+	glBufferData(GL_DRAW_INDIRECT_BUFFER, desc->size, desc->data, usage);
+
+	// Check errors
+	GLenum gl_err = get_gl_error(rd);
+	if (gl_err != 0)
+	{
+		glDeleteBuffers(1, &obj->id);
+		rd->cache.indirect_buffer = 0;
+		mrl_deallocate_object(&rd->memory.indirect_buffer, obj);
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_EXTERNAL, opengl_error_code_to_str(gl_err));
+		return MRL_ERROR_EXTERNAL;
+	}
+
+	*ib = (mrl_indirect_buffer_t*)obj;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_indirect_buffer(mrl_render_device_t* brd, mrl_indirect_buffer_t* ib)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_indirect_buffer_t* obj = (mrl_ogl_330_indirect_buffer_t*)ib;
+
+	// Delete indirect buffer
+	if (obj->id != 0)
+	{
+		glDeleteBuffers(1, &obj->id);
+		if (rd->cache.indirect_buffer == obj->id)
+			rd->cache.indirect_buffer = 0;
+	}
+	if (obj->data != NULL)
+		mgl_deallocate(rd->allocator, obj->data);
+
+	// Deallocate object
+	mrl_deallocate_object(
+		&rd->memory.indirect_buffer,
+		obj);
+}
+
+static void update_indirect_buffer(mrl_render_device_t* brd, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_indirect_buffer_t* obj = (mrl_ogl_330_indirect_buffer_t*)ib;
+
+	if (obj->id == 0)
+	{
+		if (offset > obj->size || size > obj->size - offset)
+		{
+			if (rd->error_callback != NULL)
+				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to update indirect buffer: the range is out of bounds");
+			return;
+		}
+
+		mgl_mem_copy(obj->data + offset, data, size);
+		return;
+	}
+
+	// Update indirect buffer
+	bind_indirect_buffer(rd, obj->id);
+	glBufferSubData(GL_DRAW_INDIRECT_BUFFER, offset, size, data);
+
+	// Check errors
+	GLenum gl_err = get_gl_error(rd);
+	if (gl_err != 0)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_EXTERNAL, opengl_error_code_to_str(gl_err));
+	}
+}
+
+static mrl_error_t create_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t** vb, const mrl_vertex_buffer_desc_t* desc)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+
+	// Check for invalid input
+	if (desc->usage == MRL_VERTEX_BUFFER_USAGE_STATIC && desc->data == NULL)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create vertex buffer: when the usage mode is set to static, the pointer to the initial data must not be NULL");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	// Get usage
+	GLenum usage;
+
+	if (desc->usage == MRL_VERTEX_BUFFER_USAGE_DEFAULT)
+		usage = GL_STATIC_DRAW;
+	else if (desc->usage == MRL_VERTEX_BUFFER_USAGE_STATIC)
+		usage = GL_STATIC_DRAW;
+	else if (desc->usage == MRL_VERTEX_BUFFER_USAGE_DYNAMIC)
+		usage = GL_DYNAMIC_DRAW;
+	else if (desc->usage == MRL_VERTEX_BUFFER_USAGE_STREAM)
+		usage = GL_STREAM_DRAW;
+	else
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create vertex buffer: invalid usage mode");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	// Initialize vertex buffer
+	GLuint id;
+	glGenBuffers(1, &id);
+	glBindBuffer(GL_ARRAY_BUFFER, id);
+	if (desc->data == NULL)
+		glBufferData(GL_ARRAY_BUFFER, desc->size, NULL, usage);
+	else
+		glBufferData(GL_ARRAY_BUFFER, desc->size, desc->data, usage);
+
+	// Check errors
+	GLenum gl_err = get_gl_error(rd);
+	if (gl_err != 0)
+	{
+		glDeleteBuffers(1, &id);
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_EXTERNAL, opengl_error_code_to_str(gl_err));
+		return MRL_ERROR_EXTERNAL;
+	}
+
+	// Allocate object
+	mrl_ogl_330_vertex_buffer_t* obj;
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.vertex_buffer,
+		(void**)&obj);
+	if (err != MGL_ERROR_NONE)
+	{
+		glDeleteBuffers(1, &id);
+		return mrl_make_mgl_error(err);
+	}
+
+	// Store vertex buffer info
+	obj->id = id;
+	*vb = (mrl_vertex_buffer_t*)obj;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_vertex_buffer_t* obj = (mrl_ogl_330_vertex_buffer_t*)vb;
+
+	// Delete vertex buffer
+	glDeleteBuffers(1, &obj->id);
+
+	// Deallocate object
+	mrl_deallocate_object(
+		&rd->memory.vertex_buffer,
+		obj);
+}
+
+static void* map_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_vertex_buffer_t* obj = (mrl_ogl_330_vertex_buffer_t*)vb;
+
+	// Map VBO
+	glBindBuffer(GL_ARRAY_BUFFER, obj->id);
+	return glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
+}
+
+static void unmap_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_vertex_buffer_t* obj = (mrl_ogl_330_vertex_buffer_t*)vb;
+
+	// Unmap VBO
+	glBindBuffer(GL_ARRAY_BUFFER, obj->id);
+	glUnmapBuffer(GL_ARRAY_BUFFER);
+}
+
+static void* map_vertex_buffer_range(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb, mgl_u64_t offset, mgl_u64_t size, mgl_u32_t flags)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_vertex_buffer_t* obj = (mrl_ogl_330_vertex_buffer_t*)vb;
+
+	// Map VBO range
+	glBindBuffer(GL_ARRAY_BUFFER, obj->id);
+	return map_buffer_range(rd, GL_ARRAY_BUFFER, offset, size, flags);
+}
+
+static void flush_vertex_buffer_range(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb, mgl_u64_t offset, mgl_u64_t size)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_vertex_buffer_t* obj = (mrl_ogl_330_vertex_buffer_t*)vb;
+
+	// Flush VBO range
+	glBindBuffer(GL_ARRAY_BUFFER, obj->id);
+	glFlushMappedBufferRange(GL_ARRAY_BUFFER, (GLintptr)offset, (GLsizeiptr)size);
+}
+
+static void update_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_vertex_buffer_t* obj = (mrl_ogl_330_vertex_buffer_t*)vb;
+
+	// Update VBO
+	glBindBuffer(GL_ARRAY_BUFFER, obj->id);
+	glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+
+	// Check errors
+	GLenum gl_err = get_gl_error(rd);
+	if (gl_err != 0)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_EXTERNAL, opengl_error_code_to_str(gl_err));
+	}
+}
+
+static mrl_error_t create_vertex_array(mrl_render_device_t* brd, mrl_vertex_array_t** va, const mrl_vertex_array_desc_t* desc)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+
+	MGL_DEBUG_ASSERT(desc->shader_pipeline != NULL);
+	mrl_ogl_330_shader_pipeline_t* pp = (mrl_ogl_330_shader_pipeline_t*)desc->shader_pipeline;
+
+	// Initialize vertex array
+	GLuint id;
+	glGenVertexArrays(1, &id);
+	bind_vertex_array(rd, id);
+	
+	// Link elements
+	MGL_DEBUG_ASSERT(desc->element_count <= MRL_MAX_VERTEX_ARRAY_ELEMENT_COUNT);
+	MGL_DEBUG_ASSERT(desc->buffer_count <= MRL_MAX_VERTEX_ARRAY_BUFFER_COUNT);
+	for (mgl_u32_t i = 0; i < desc->element_count; ++i)
+	{
+		// Get buffer
+		MGL_DEBUG_ASSERT(desc->elements[i].buffer.index < desc->buffer_count);
+		mrl_ogl_330_vertex_buffer_t* vbo = (mrl_ogl_330_vertex_buffer_t*)desc->buffers[desc->elements[i].buffer.index];
+		MGL_DEBUG_ASSERT(vbo != NULL);
+		glBindBuffer(GL_ARRAY_BUFFER, vbo->id);
+
+		// Get attribute location
+		GLint loc = glGetAttribLocation(pp->id, desc->elements[i].name);
+		if (loc == -1)
+		{
+			if (rd->error_callback != NULL)
+			{
+				mgl_chr8_t msg[512] = { 0 };
+				mgl_buffer_stream_t stream;
+				mgl_init_buffer_stream(&stream, msg, sizeof(msg));
+				mgl_print(&stream, u8"Failed to create vertex array, couldn't find vertex element \"");
+				mgl_print(&stream, desc->elements[i].name);
+				mgl_print(&stream, u8"\"");
+				rd->error_callback(MRL_ERROR_VERTEX_ELEMENT_NOT_FOUND, msg);
+			}
+			glDeleteVertexArrays(1, &id);
+			rd->cache.vertex_array = 0;
+			return MRL_ERROR_VERTEX_ELEMENT_NOT_FOUND;
+		}
+		
+		// Get type
+		GLenum type;
+		GLboolean normalized;
+		GLboolean integer;
+
+		switch (desc->elements[i].type)
+		{
+			case MRL_VERTEX_ELEMENT_TYPE_I8: type = GL_BYTE; normalized = GL_FALSE; integer = MGL_TRUE; break;
+			case MRL_VERTEX_ELEMENT_TYPE_I16: type = GL_SHORT; normalized = GL_FALSE; integer = MGL_TRUE; break;
+			case MRL_VERTEX_ELEMENT_TYPE_I32: type = GL_INT; normalized = GL_FALSE; integer = MGL_TRUE; break;
+			case MRL_VERTEX_ELEMENT_TYPE_U8: type = GL_UNSIGNED_BYTE; normalized = GL_FALSE; integer = MGL_TRUE; break;
+			case MRL_VERTEX_ELEMENT_TYPE_U16: type = GL_UNSIGNED_SHORT; normalized = GL_FALSE; integer = MGL_TRUE; break;
+			case MRL_VERTEX_ELEMENT_TYPE_U32: type = GL_UNSIGNED_INT; normalized = GL_FALSE; integer = MGL_TRUE; break;
+			case MRL_VERTEX_ELEMENT_TYPE_N8: type = GL_BYTE; normalized = GL_TRUE; integer = MGL_FALSE; break;
+			case MRL_VERTEX_ELEMENT_TYPE_N16: type = GL_SHORT; normalized = GL_TRUE; integer = MGL_FALSE; break;
+			case MRL_VERTEX_ELEMENT_TYPE_NU8: type = GL_UNSIGNED_BYTE; normalized = GL_TRUE; integer = MGL_FALSE; break;
+			case MRL_VERTEX_ELEMENT_TYPE_NU16: type = GL_UNSIGNED_SHORT; normalized = GL_TRUE; integer = MGL_FALSE; break;
+			case MRL_VERTEX_ELEMENT_TYPE_F32: type = GL_FLOAT; normalized = GL_FALSE; integer = MGL_FALSE; break;
+			default:
+				if (rd->error_callback != NULL)
+					rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create vertex array, invalid vertex element type");
+				glDeleteVertexArrays(1, &id);
+				rd->cache.vertex_array = 0;
+				return MRL_ERROR_INVALID_PARAMS;
+		}
+
+		MGL_DEBUG_ASSERT(desc->elements[i].size >= 1 && desc->elements[i].size <= 4);
+		
+		glEnableVertexAttribArray(loc);
+		if (!integer)
+			glVertexAttribPointer(loc, (GLint)desc->elements[i].size, type, normalized, (GLsizei)desc->elements[i].buffer.stride, (const void*)desc->elements[i].buffer.offset);
+		else
+			glVertexAttribIPointer(loc, (GLint)desc->elements[i].size, type, (GLsizei)desc->elements[i].buffer.stride, (const void*)desc->elements[i].buffer.offset);
+		glVertexAttribDivisor(loc, (GLuint)desc->elements[i].instance_step_rate);
+	}
+
+	// Check errors
+	GLenum gl_err = get_gl_error(rd);
+	if (gl_err != 0)
+	{
+		glDeleteVertexArrays(1, &id);
+		rd->cache.vertex_array = 0;
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_EXTERNAL, opengl_error_code_to_str(gl_err));
+		return MRL_ERROR_EXTERNAL;
+	}
+
+	// Allocate object
+	mrl_ogl_330_vertex_array_t* obj;
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.vertex_array,
+		(void**)&obj);
+	if (err != MGL_ERROR_NONE)
+	{
+		glDeleteVertexArrays(1, &id);
+		rd->cache.vertex_array = 0;
+		return mrl_make_mgl_error(err);
+	}
+
+	// Store vertex array info
 	obj->id = id;
-	*vb = (mrl_vertex_buffer_t*)obj;
+	*va = (mrl_vertex_array_t*)obj;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_vertex_array(mrl_render_device_t* brd, mrl_shader_pipeline_t* va)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_vertex_array_t* obj = (mrl_ogl_330_vertex_array_t*)va;
+
+	// Delete vertex array
+	glDeleteVertexArrays(1, &obj->id);
+	if (rd->cache.vertex_array == obj->id)
+	{
+		rd->cache.vertex_array = 0;
+		rd->cache.index_buffer = MRL_OGL_330_UNKNOWN_BINDING;
+	}
+
+	// Deallocate object
+	mrl_deallocate_object(
+		&rd->memory.vertex_array,
+		obj);
+}
+
+static void set_vertex_array(mrl_render_device_t* brd, mrl_shader_pipeline_t* va)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_vertex_array_t* obj = (mrl_ogl_330_vertex_array_t*)va;
+
+	// Set vertex array
+	if (va == NULL)
+		bind_vertex_array(rd, 0);
+	else
+		bind_vertex_array(rd, obj->id);
+}
+
+// ---------- Stream allocators ----------
+
+static mrl_error_t create_stream_allocator(mrl_render_device_t* brd, mrl_stream_allocator_t** sa, const mrl_stream_allocator_desc_t* desc)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+
+	// Get buffer
+	GLuint id;
+
+	if (desc->buffer == NULL)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create stream allocator: the buffer must not be NULL");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+	else if (desc->buffer_type == MRL_STREAM_ALLOCATOR_BUFFER_VERTEX)
+		id = ((mrl_ogl_330_vertex_buffer_t*)desc->buffer)->id;
+	else if (desc->buffer_type == MRL_STREAM_ALLOCATOR_BUFFER_INDEX)
+		id = ((mrl_ogl_330_index_buffer_t*)desc->buffer)->id;
+	else if (desc->buffer_type == MRL_STREAM_ALLOCATOR_BUFFER_CONSTANT)
+		id = ((mrl_ogl_330_constant_buffer_t*)desc->buffer)->id;
+	else
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create stream allocator: invalid buffer type");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	// Get buffer size (through the copy target, so that the cached bindings aren't touched)
+	GLint64 size = 0;
+	glBindBuffer(GL_COPY_WRITE_BUFFER, id);
+	glGetBufferParameteri64v(GL_COPY_WRITE_BUFFER, GL_BUFFER_SIZE, &size);
+
+	// Check errors
+	GLenum gl_err = get_gl_error(rd);
+	if (gl_err != 0)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_EXTERNAL, opengl_error_code_to_str(gl_err));
+		return MRL_ERROR_EXTERNAL;
+	}
+
+	// Allocate object
+	mrl_ogl_330_stream_allocator_t* obj;
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.stream_allocator,
+		(void**)&obj);
+	if (err != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(err);
+
+	// Store stream allocator info
+	obj->id = id;
+	obj->size = (mgl_u64_t)size;
+	obj->head = 0;
+	obj->used = 0;
+	obj->frame_used = 0;
+	obj->first_frame = 0;
+	obj->frame_count = 0;
+	*sa = (mrl_stream_allocator_t*)obj;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_stream_allocator(mrl_render_device_t* brd, mrl_stream_allocator_t* sa)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_stream_allocator_t* obj = (mrl_ogl_330_stream_allocator_t*)sa;
+
+	// Delete pending fences
+	for (mgl_u32_t i = 0; i < obj->frame_count; ++i)
+		glDeleteSync(obj->frames[(obj->first_frame + i) % MRL_OGL_330_MAX_STREAM_FRAME_COUNT].fence);
+
+	// Deallocate object
+	mrl_deallocate_object(
+		&rd->memory.stream_allocator,
+		obj);
+}
+
+static void release_oldest_stream_frame(mrl_ogl_330_stream_allocator_t* obj)
+{
+	// Wait until the GPU is done with the oldest frame
+	GLsync fence = obj->frames[obj->first_frame].fence;
+	GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+	for (;;)
+	{
+		GLenum res = glClientWaitSync(fence, flags, 1000000000);
+		if (res != GL_TIMEOUT_EXPIRED)
+			break;
+		flags = 0;
+	}
+	glDeleteSync(fence);
+
+	// Free its region
+	obj->used -= obj->frames[obj->first_frame].size;
+	obj->first_frame = (obj->first_frame + 1) % MRL_OGL_330_MAX_STREAM_FRAME_COUNT;
+	obj->frame_count -= 1;
+}
+
+static void* map_stream_allocation(mrl_render_device_t* brd, mrl_stream_allocator_t* sa, mgl_u64_t size, mgl_u64_t alignment, mgl_u64_t* offset)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_stream_allocator_t* obj = (mrl_ogl_330_stream_allocator_t*)sa;
+
+	// Align head, wrapping around if the allocation doesn't fit on the end of the buffer
+	mgl_u64_t begin = obj->head;
+	if (alignment > 1 && begin % alignment != 0)
+		begin += alignment - begin % alignment;
+	if (begin + size > obj->size)
+		begin = 0;
+
+	// The skipped bytes are only freed with the rest of the frame
+	mgl_u64_t advance = (begin >= obj->head ? begin - obj->head : obj->size - obj->head) + size;
+	if (size > obj->size || obj->frame_used + advance > obj->size)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to map stream allocation: the frame allocations don't fit on the buffer");
+		return NULL;
+	}
+
+	// Wait for old frames until there is enough free space
+	while (obj->used + advance > obj->size)
+		release_oldest_stream_frame(obj);
+
+	// Map region, the GPU isn't using it so there's no need to synchronize
+	glBindBuffer(GL_COPY_WRITE_BUFFER, obj->id);
+	void* data = glMapBufferRange(
+		GL_COPY_WRITE_BUFFER,
+		(GLintptr)begin,
+		(GLsizeiptr)size,
+		GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+
+	// Check errors
+	if (data == NULL)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_EXTERNAL, opengl_error_code_to_str(glGetError()));
+		return NULL;
+	}
+
+	obj->head = begin + size;
+	obj->used += advance;
+	obj->frame_used += advance;
+	*offset = begin;
+
+	return data;
+}
+
+static void unmap_stream_allocation(mrl_render_device_t* brd, mrl_stream_allocator_t* sa)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_stream_allocator_t* obj = (mrl_ogl_330_stream_allocator_t*)sa;
+
+	// Unmap region
+	glBindBuffer(GL_COPY_WRITE_BUFFER, obj->id);
+	glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+}
+
+static void end_stream_allocator_frame(mrl_render_device_t* brd, mrl_stream_allocator_t* sa)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_stream_allocator_t* obj = (mrl_ogl_330_stream_allocator_t*)sa;
+
+	if (obj->frame_used == 0)
+		return;
+
+	// Make room for a new frame
+	if (obj->frame_count == MRL_OGL_330_MAX_STREAM_FRAME_COUNT)
+		release_oldest_stream_frame(obj);
+
+	// Fence the frame region
+	mgl_u32_t i = (obj->first_frame + obj->frame_count) % MRL_OGL_330_MAX_STREAM_FRAME_COUNT;
+	obj->frames[i].fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	obj->frames[i].size = obj->frame_used;
+	obj->frame_count += 1;
+	obj->frame_used = 0;
+}
+
+// ---------- Upload queues ----------
+
+static mrl_error_t create_upload_queue(mrl_render_device_t* brd, mrl_upload_queue_t** uq, const mrl_upload_queue_desc_t* desc)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+
+	// Create pixel buffer, it is only bound while uploading so that other pixel transfers keep reading client memory
+	GLuint id;
+	glGenBuffers(1, &id);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, id);
+	glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)desc->size, NULL, GL_STREAM_DRAW);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	// Check errors
+	GLenum gl_err = get_gl_error(rd);
+	if (gl_err != 0)
+	{
+		glDeleteBuffers(1, &id);
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_EXTERNAL, opengl_error_code_to_str(gl_err));
+		return MRL_ERROR_EXTERNAL;
+	}
+
+	// Allocate object
+	mrl_ogl_330_upload_queue_t* obj;
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.upload_queue,
+		(void**)&obj);
+	if (err != MGL_ERROR_NONE)
+	{
+		glDeleteBuffers(1, &id);
+		return mrl_make_mgl_error(err);
+	}
+
+	// Store upload queue info
+	obj->id = id;
+	obj->size = desc->size;
+	obj->head = 0;
+	obj->used = 0;
+	obj->last_token = 0;
+	obj->completed_token = 0;
+	obj->first_upload = 0;
+	obj->upload_count = 0;
+	*uq = (mrl_upload_queue_t*)obj;
 
 	return MRL_ERROR_NONE;
 }
 
-static void destroy_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb)
+static void destroy_upload_queue(mrl_render_device_t* brd, mrl_upload_queue_t* uq)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_upload_queue_t* obj = (mrl_ogl_330_upload_queue_t*)uq;
+
+	// Delete pending fences, the buffer is only freed by the driver once the pending uploads are done
+	for (mgl_u32_t i = 0; i < obj->upload_count; ++i)
+		glDeleteSync(obj->uploads[(obj->first_upload + i) % MRL_OGL_330_MAX_PENDING_UPLOAD_COUNT].fence);
+	glDeleteBuffers(1, &obj->id);
+
+	// Deallocate object
+	mrl_deallocate_object(
+		&rd->memory.upload_queue,
+		obj);
+}
+
+static void release_oldest_upload(mrl_ogl_330_upload_queue_t* obj)
+{
+	// Wait until the GPU is done with the oldest upload
+	GLsync fence = obj->uploads[obj->first_upload].fence;
+	GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+	for (;;)
+	{
+		GLenum res = glClientWaitSync(fence, flags, 1000000000);
+		if (res != GL_TIMEOUT_EXPIRED)
+			break;
+		flags = 0;
+	}
+	glDeleteSync(fence);
+
+	// Free its region
+	obj->used -= obj->uploads[obj->first_upload].size;
+	obj->completed_token = obj->uploads[obj->first_upload].token;
+	obj->first_upload = (obj->first_upload + 1) % MRL_OGL_330_MAX_PENDING_UPLOAD_COUNT;
+	obj->upload_count -= 1;
+}
+
+// Size in bytes of the client data read by a pixel transfer, with the default unpack alignment of 4
+static mgl_u64_t get_pixel_transfer_size(GLenum format, GLenum type, mgl_u64_t width, mgl_u64_t height, mgl_u64_t depth)
+{
+	mgl_u64_t component_count;
+	switch (format)
+	{
+		case GL_RED: case GL_RED_INTEGER: case GL_DEPTH_COMPONENT: component_count = 1; break;
+		case GL_RG: case GL_RG_INTEGER: component_count = 2; break;
+		default: component_count = 4; break;
+	}
+
+	// Packed depth stencil types store the whole texel in a single value
+	mgl_u64_t texel_size;
+	switch (type)
+	{
+		case GL_BYTE: case GL_UNSIGNED_BYTE: texel_size = component_count; break;
+		case GL_SHORT: case GL_UNSIGNED_SHORT: texel_size = component_count * 2; break;
+		case GL_UNSIGNED_INT_24_8: texel_size = 4; break;
+		case GL_FLOAT_32_UNSIGNED_INT_24_8_REV: texel_size = 8; break;
+		default: texel_size = component_count * 4; break;
+	}
+
+	// Every row but the last one is padded
+	mgl_u64_t row_size = width * texel_size;
+	mgl_u64_t row_pitch = (row_size + 3) & ~(mgl_u64_t)3;
+	return row_pitch * (height * depth - 1) + row_size;
+}
+
+// Size in bytes of the client data read by a 2D image transfer, compressed data is read as is
+static mgl_u64_t get_image_2d_size(mgl_enum_t texture_format, GLenum format, GLenum type, mgl_u64_t width, mgl_u64_t height)
+{
+	if (is_native_compressed_format(texture_format, format))
+		return mrl_get_compressed_data_size(texture_format, width, height, 1);
+	return get_pixel_transfer_size(format, type, width, height, 1);
+}
+
+// Copies the texel data to the pixel buffer and leaves it bound, so that the next pixel transfer reads from it.
+// Returns the pointer which must be passed to the pixel transfer, and the number of bytes used on the ring buffer.
+static const void* stage_upload(mrl_ogl_330_render_device_t* rd, mrl_ogl_330_upload_queue_t* obj, const void* data, mgl_u64_t size, mgl_u64_t* advance)
 {
-	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
-	mrl_ogl_330_vertex_buffer_t* obj = (mrl_ogl_330_vertex_buffer_t*)vb;
+	// Data which doesn't fit is read straight from client memory
+	*advance = 0;
+	if (size > obj->size)
+		return data;
+
+	// Wait for old uploads until there is enough free space, the offset must be aligned to the component size
+	mgl_u64_t begin;
+	for (;;)
+	{
+		begin = (obj->head + 3) & ~(mgl_u64_t)3;
+		if (begin + size > obj->size)
+			begin = 0;
 
-	// Delete vertex buffer
-	glDeleteBuffers(1, &obj->id);
+		// The skipped bytes are only freed with the upload
+		*advance = (begin >= obj->head ? begin - obj->head : obj->size - obj->head) + size;
+		if (obj->used + *advance <= obj->size)
+			break;
 
-	// Deallocate object
-	mgl_deallocate(
-		&rd->memory.vertex_buffer.pool,
-		obj);
-}
+		if (obj->upload_count == 0)
+			obj->head = 0;
+		else
+			release_oldest_upload(obj);
+	}
 
-static void* map_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb)
-{
-	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
-	mrl_ogl_330_vertex_buffer_t* obj = (mrl_ogl_330_vertex_buffer_t*)vb;
+	// Map region, the GPU isn't using it so there's no need to synchronize
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, obj->id);
+	void* staging = glMapBufferRange(
+		GL_PIXEL_UNPACK_BUFFER,
+		(GLintptr)begin,
+		(GLsizeiptr)size,
+		GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
 
-	// Map VBO
-	glBindBuffer(GL_ARRAY_BUFFER, obj->id);
-	return glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
-}
+	// Fall back to client memory if the buffer can't be mapped
+	if (staging == NULL)
+	{
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		get_gl_error(rd);
+		*advance = 0;
+		return data;
+	}
 
-static void unmap_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb)
-{
-	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
-	mrl_ogl_330_vertex_buffer_t* obj = (mrl_ogl_330_vertex_buffer_t*)vb;
+	mgl_mem_copy(staging, data, size);
+	glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
 
-	// Unmap VBO
-	glBindBuffer(GL_ARRAY_BUFFER, obj->id);
-	glUnmapBuffer(GL_ARRAY_BUFFER);
+	obj->head = begin + size;
+	obj->used += *advance;
+
+	return (const void*)begin;
 }
 
-static void update_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb, mgl_u64_t offset, mgl_u64_t size, const void* data)
+// Unbinds the pixel buffer and fences the upload, which is issued even if it wasn't staged, so that tokens complete in order
+static mrl_error_t finish_upload(mrl_ogl_330_render_device_t* rd, mrl_ogl_330_upload_queue_t* obj, mgl_u64_t advance, mgl_u64_t* token)
 {
-	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
-	mrl_ogl_330_vertex_buffer_t* obj = (mrl_ogl_330_vertex_buffer_t*)vb;
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 
-	// Update VBO
-	glBindBuffer(GL_ARRAY_BUFFER, obj->id);
-	glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+	// Make room for a new upload
+	if (obj->upload_count == MRL_OGL_330_MAX_PENDING_UPLOAD_COUNT)
+		release_oldest_upload(obj);
+
+	mgl_u32_t i = (obj->first_upload + obj->upload_count) % MRL_OGL_330_MAX_PENDING_UPLOAD_COUNT;
+	obj->uploads[i].fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	obj->uploads[i].size = advance;
+	obj->uploads[i].token = ++obj->last_token;
+	obj->upload_count += 1;
 
 	// Check errors
-	GLenum gl_err = glGetError();
+	GLenum gl_err = get_gl_error(rd);
 	if (gl_err != 0)
 	{
 		if (rd->error_callback != NULL)
 			rd->error_callback(MRL_ERROR_EXTERNAL, opengl_error_code_to_str(gl_err));
+		return MRL_ERROR_EXTERNAL;
 	}
+
+	*token = obj->last_token;
+	return MRL_ERROR_NONE;
 }
 
-static mrl_error_t create_vertex_array(mrl_render_device_t* brd, mrl_vertex_array_t** va, const mrl_vertex_array_desc_t* desc)
+static mrl_error_t upload_texture_1d(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mrl_texture_1d_t* tex, const mrl_texture_1d_update_desc_t* desc, mgl_u64_t* token)
 {
 	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_upload_queue_t* obj = (mrl_ogl_330_upload_queue_t*)uq;
+	mrl_ogl_330_texture_1d_t* tex_obj = (mrl_ogl_330_texture_1d_t*)tex;
 
-	MGL_DEBUG_ASSERT(desc->shader_pipeline != NULL);
-	mrl_ogl_330_shader_pipeline_t* pp = (mrl_ogl_330_shader_pipeline_t*)desc->shader_pipeline;
+	// Update texture from the pixel buffer
+	mgl_u64_t advance;
+	const void* pixels = stage_upload(rd, obj, desc->data, get_pixel_transfer_size(tex_obj->format, tex_obj->type, desc->width, 1, 1), &advance);
+	bind_texture(rd, GL_TEXTURE_1D, tex_obj->id);
+	glTexSubImage1D(GL_TEXTURE_1D, desc->mip_level, (GLint)desc->dst_x, (GLsizei)desc->width, tex_obj->format, tex_obj->type, pixels);
 
-	// Initialize vertex array
-	GLuint id;
-	glGenVertexArrays(1, &id);
-	glBindVertexArray(id);
-	
-	// Link elements
-	MGL_DEBUG_ASSERT(desc->element_count <= MRL_MAX_VERTEX_ARRAY_ELEMENT_COUNT);
-	MGL_DEBUG_ASSERT(desc->buffer_count <= MRL_MAX_VERTEX_ARRAY_BUFFER_COUNT);
-	for (mgl_u32_t i = 0; i < desc->element_count; ++i)
-	{
-		// Get buffer
-		MGL_DEBUG_ASSERT(desc->elements[i].buffer.index < desc->buffer_count);
-		mrl_ogl_330_vertex_buffer_t* vbo = (mrl_ogl_330_vertex_buffer_t*)desc->buffers[desc->elements[i].buffer.index];
-		MGL_DEBUG_ASSERT(vbo != NULL);
-		glBindBuffer(GL_ARRAY_BUFFER, vbo->id);
+	return finish_upload(rd, obj, advance, token);
+}
 
-		// Get attribute location
-		GLint loc = glGetAttribLocation(pp->id, desc->elements[i].name);
-		if (loc == -1)
-		{
-			if (rd->error_callback != NULL)
-			{
-				mgl_chr8_t msg[512] = { 0 };
-				mgl_buffer_stream_t stream;
-				mgl_init_buffer_stream(&stream, msg, sizeof(msg));
-				mgl_print(&stream, u8"Failed to create vertex array, couldn't find vertex element \"");
-				mgl_print(&stream, desc->elements[i].name);
-				mgl_print(&stream, u8"\"");
-				rd->error_callback(MRL_ERROR_VERTEX_ELEMENT_NOT_FOUND, msg);
-			}
-			glDeleteVertexArrays(1, &id);
-			return MRL_ERROR_VERTEX_ELEMENT_NOT_FOUND;
-		}
-		
-		// Get type
-		GLenum type;
-		GLboolean normalized;
-		GLboolean integer;
+static mrl_error_t upload_texture_2d(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mrl_texture_2d_t* tex, const mrl_texture_2d_update_desc_t* desc, mgl_u64_t* token)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_upload_queue_t* obj = (mrl_ogl_330_upload_queue_t*)uq;
+	mrl_ogl_330_texture_2d_t* tex_obj = (mrl_ogl_330_texture_2d_t*)tex;
 
-		switch (desc->elements[i].type)
-		{
-			case MRL_VERTEX_ELEMENT_TYPE_I8: type = GL_BYTE; normalized = GL_FALSE; integer = MGL_TRUE; break;
-			case MRL_VERTEX_ELEMENT_TYPE_I16: type = GL_SHORT; normalized = GL_FALSE; integer = MGL_TRUE; break;
-			case MRL_VERTEX_ELEMENT_TYPE_I32: type = GL_INT; normalized = GL_FALSE; integer = MGL_TRUE; break;
-			case MRL_VERTEX_ELEMENT_TYPE_U8: type = GL_UNSIGNED_BYTE; normalized = GL_FALSE; integer = MGL_TRUE; break;
-			case MRL_VERTEX_ELEMENT_TYPE_U16: type = GL_UNSIGNED_SHORT; normalized = GL_FALSE; integer = MGL_TRUE; break;
-			case MRL_VERTEX_ELEMENT_TYPE_U32: type = GL_UNSIGNED_INT; normalized = GL_FALSE; integer = MGL_TRUE; break;
-			case MRL_VERTEX_ELEMENT_TYPE_N8: type = GL_BYTE; normalized = GL_TRUE; integer = MGL_FALSE; break;
-			case MRL_VERTEX_ELEMENT_TYPE_N16: type = GL_SHORT; normalized = GL_TRUE; integer = MGL_FALSE; break;
-			case MRL_VERTEX_ELEMENT_TYPE_NU8: type = GL_UNSIGNED_BYTE; normalized = GL_TRUE; integer = MGL_FALSE; break;
-			case MRL_VERTEX_ELEMENT_TYPE_NU16: type = GL_UNSIGNED_SHORT; normalized = GL_TRUE; integer = MGL_FALSE; break;
-			case MRL_VERTEX_ELEMENT_TYPE_F32: type = GL_FLOAT; normalized = GL_FALSE; integer = MGL_FALSE; break;
-			default:
-				if (rd->error_callback != NULL)
-					rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create vertex array, invalid vertex element type");
-				glDeleteVertexArrays(1, &id);
-				return MRL_ERROR_INVALID_PARAMS;
-		}
+	// Compressed data the driver doesn't support is decoded before it is staged
+	const void* data;
+	mrl_error_t err = prepare_image_2d(rd, tex_obj->texture_format, tex_obj->format, desc->width, desc->height, desc->data, &data);
+	if (err != MRL_ERROR_NONE)
+		return err;
 
-		MGL_DEBUG_ASSERT(desc->elements[i].size >= 1 && desc->elements[i].size <= 4);
-		
-		glEnableVertexAttribArray(loc);
-		if (!integer)
-			glVertexAttribPointer(loc, (GLint)desc->elements[i].size, type, normalized, (GLsizei)desc->elements[i].buffer.stride, (const void*)desc->elements[i].buffer.offset);
-		else
-			glVertexAttribIPointer(loc, (GLint)desc->elements[i].size, type, (GLsizei)desc->elements[i].buffer.stride, (const void*)desc->elements[i].buffer.offset);
-	}
+	// Update texture from the pixel buffer
+	mgl_u64_t advance;
+	const void* pixels = stage_upload(rd, obj, data, get_image_2d_size(tex_obj->texture_format, tex_obj->format, tex_obj->type, desc->width, desc->height), &advance);
+	bind_texture(rd, GL_TEXTURE_2D, tex_obj->id);
+	transfer_image_2d(GL_TEXTURE_2D, desc->mip_level, tex_obj->texture_format, tex_obj->internal_format, tex_obj->format, tex_obj->type, desc->dst_x, desc->dst_y, desc->width, desc->height, pixels);
 
-	// Check errors
-	GLenum gl_err = glGetError();
-	if (gl_err != 0)
-	{
-		glDeleteVertexArrays(1, &id);
-		if (rd->error_callback != NULL)
-			rd->error_callback(MRL_ERROR_EXTERNAL, opengl_error_code_to_str(gl_err));
-		return MRL_ERROR_EXTERNAL;
-	}
+	err = finish_upload(rd, obj, advance, token);
+	release_image_2d(rd, desc->data, data);
+	return err;
+}
 
-	// Allocate object
-	mrl_ogl_330_vertex_array_t* obj;
-	mgl_error_t err = mgl_allocate(
-		&rd->memory.vertex_array.pool,
-		sizeof(*obj),
-		(void**)&obj);
-	if (err != MGL_ERROR_NONE)
+static mrl_error_t upload_texture_3d(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mrl_texture_3d_t* tex, const mrl_texture_3d_update_desc_t* desc, mgl_u64_t* token)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_upload_queue_t* obj = (mrl_ogl_330_upload_queue_t*)uq;
+	mrl_ogl_330_texture_3d_t* tex_obj = (mrl_ogl_330_texture_3d_t*)tex;
+
+	// Update texture from the pixel buffer
+	mgl_u64_t advance;
+	const void* pixels = stage_upload(rd, obj, desc->data, get_pixel_transfer_size(tex_obj->format, tex_obj->type, desc->width, desc->height, desc->depth), &advance);
+	bind_texture(rd, GL_TEXTURE_3D, tex_obj->id);
+	glTexSubImage3D(GL_TEXTURE_3D, desc->mip_level, (GLint)desc->dst_x, (GLint)desc->dst_y, (GLint)desc->dst_z, (GLsizei)desc->width, (GLsizei)desc->height, (GLsizei)desc->depth, tex_obj->format, tex_obj->type, pixels);
+
+	return finish_upload(rd, obj, advance, token);
+}
+
+static mrl_error_t upload_cube_map(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mrl_cube_map_t* cb, const mrl_cube_map_update_desc_t* desc, mgl_u64_t* token)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_upload_queue_t* obj = (mrl_ogl_330_upload_queue_t*)uq;
+	mrl_ogl_330_cube_map_t* tex_obj = (mrl_ogl_330_cube_map_t*)cb;
+
+	// Get face
+	GLenum face;
+	switch (desc->face)
 	{
-		glDeleteVertexArrays(1, &id);
-		return mrl_make_mgl_error(err);
+		case MRL_CUBE_MAP_FACE_POSITIVE_X: face = GL_TEXTURE_CUBE_MAP_POSITIVE_X; break;
+		case MRL_CUBE_MAP_FACE_NEGATIVE_X: face = GL_TEXTURE_CUBE_MAP_NEGATIVE_X; break;
+		case MRL_CUBE_MAP_FACE_POSITIVE_Y: face = GL_TEXTURE_CUBE_MAP_POSITIVE_Y; break;
+		case MRL_CUBE_MAP_FACE_NEGATIVE_Y: face = GL_TEXTURE_CUBE_MAP_NEGATIVE_Y; break;
+		case MRL_CUBE_MAP_FACE_POSITIVE_Z: face = GL_TEXTURE_CUBE_MAP_POSITIVE_Z; break;
+		case MRL_CUBE_MAP_FACE_NEGATIVE_Z: face = GL_TEXTURE_CUBE_MAP_NEGATIVE_Z; break;
+		default:
+			if (rd->error_callback != NULL)
+				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to upload cube map: invalid face");
+			return MRL_ERROR_INVALID_PARAMS;
 	}
 
-	// Store vertex array info
-	obj->id = id;
-	*va = (mrl_vertex_array_t*)obj;
+	// Compressed data the driver doesn't support is decoded before it is staged
+	const void* data;
+	mrl_error_t err = prepare_image_2d(rd, tex_obj->texture_format, tex_obj->format, desc->width, desc->height, desc->data, &data);
+	if (err != MRL_ERROR_NONE)
+		return err;
 
-	return MRL_ERROR_NONE;
+	// Update texture from the pixel buffer
+	mgl_u64_t advance;
+	const void* pixels = stage_upload(rd, obj, data, get_image_2d_size(tex_obj->texture_format, tex_obj->format, tex_obj->type, desc->width, desc->height), &advance);
+	bind_texture(rd, GL_TEXTURE_CUBE_MAP, tex_obj->id);
+	transfer_image_2d(face, desc->mip_level, tex_obj->texture_format, tex_obj->internal_format, tex_obj->format, tex_obj->type, desc->dst_x, desc->dst_y, desc->width, desc->height, pixels);
+
+	err = finish_upload(rd, obj, advance, token);
+	release_image_2d(rd, desc->data, data);
+	return err;
 }
 
-static void destroy_vertex_array(mrl_render_device_t* brd, mrl_shader_pipeline_t* va)
+static mgl_bool_t is_upload_complete(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mgl_u64_t token)
 {
-	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
-	mrl_ogl_330_vertex_array_t* obj = (mrl_ogl_330_vertex_array_t*)va;
+	mrl_ogl_330_upload_queue_t* obj = (mrl_ogl_330_upload_queue_t*)uq;
 
-	// Delete vertex array
-	glDeleteVertexArrays(1, &obj->id);
+	// Release the uploads which are already done, without waiting
+	while (token > obj->completed_token && obj->upload_count > 0)
+	{
+		GLenum res = glClientWaitSync(obj->uploads[obj->first_upload].fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+		if (res != GL_ALREADY_SIGNALED && res != GL_CONDITION_SATISFIED)
+			break;
+		release_oldest_upload(obj);
+	}
 
-	// Deallocate object
-	mgl_deallocate(
-		&rd->memory.vertex_array.pool,
-		obj);
+	return token <= obj->completed_token ? MGL_TRUE : MGL_FALSE;
 }
 
-static void set_vertex_array(mrl_render_device_t* brd, mrl_shader_pipeline_t* va)
+static void wait_upload(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mgl_u64_t token)
 {
-	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
-	mrl_ogl_330_vertex_array_t* obj = (mrl_ogl_330_vertex_array_t*)va;
+	mrl_ogl_330_upload_queue_t* obj = (mrl_ogl_330_upload_queue_t*)uq;
 
-	// Set vertex array
-	if (va == NULL)
-		glBindVertexArray(0);
-	else
-		glBindVertexArray(obj->id);
+	while (token > obj->completed_token && obj->upload_count > 0)
+		release_oldest_upload(obj);
 }
 
 // -------- Shaders ----------
@@ -2426,7 +4556,7 @@ static mrl_error_t create_shader_stage(mrl_render_device_t* brd, mrl_shader_stag
 		return MRL_ERROR_FAILED_TO_COMPILE_SHADER_STAGE;
 	}
 
-	GLenum gl_err = glGetError();
+	GLenum gl_err = get_gl_error(rd);
 	if (gl_err != 0)
 	{
 		glDeleteShader(id);
@@ -2437,37 +4567,298 @@ static mrl_error_t create_shader_stage(mrl_render_device_t* brd, mrl_shader_stag
 
 	// Allocate object
 	mrl_ogl_330_shader_stage_t* obj;
-	mgl_error_t err = mgl_allocate(
-		&rd->memory.shader_stage.pool,
-		sizeof(*obj),
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.shader_stage,
 		(void**)&obj);
 	if (err != MGL_ERROR_NONE)
 	{
-		glDeleteShader(id);
-		return mrl_make_mgl_error(err);
+		glDeleteShader(id);
+		return mrl_make_mgl_error(err);
+	}
+
+	// Store stage info
+	obj->id = id;
+	*stage = (mrl_shader_stage_t*)obj;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_shader_stage(mrl_render_device_t* brd, mrl_shader_stage_t* stage)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_shader_stage_t* obj = (mrl_ogl_330_shader_stage_t*)stage;
+
+	// Delete shader
+	glDeleteShader(obj->id);
+
+	// Deallocate object
+	mrl_deallocate_object(
+		&rd->memory.shader_stage,
+		obj);
+}
+
+static mrl_ogl_330_shader_binding_point_t* find_binding_point(mrl_ogl_330_shader_pipeline_t* pp, mgl_u64_t id, const mgl_chr8_t* name)
+{
+	if (pp->bp_count == 0)
+		return NULL;
+
+	for (mgl_u32_t slot = (mgl_u32_t)id & pp->table_mask;; slot = (slot + 1) & pp->table_mask)
+	{
+		if (pp->table[slot] == 0)
+			return NULL;
+
+		mrl_ogl_330_shader_binding_point_t* bp = &pp->bps[pp->table[slot] - 1];
+		if (bp->id == id && (name == NULL || mgl_str_equal(name, bp->name)))
+			return bp;
+	}
+}
+
+static mgl_bool_t is_sampler_type(GLenum type)
+{
+	switch (type)
+	{
+		case GL_SAMPLER_1D:
+		case GL_SAMPLER_2D:
+		case GL_SAMPLER_3D:
+		case GL_SAMPLER_CUBE:
+		case GL_SAMPLER_1D_SHADOW:
+		case GL_SAMPLER_2D_SHADOW:
+		case GL_SAMPLER_1D_ARRAY:
+		case GL_SAMPLER_2D_ARRAY:
+		case GL_SAMPLER_1D_ARRAY_SHADOW:
+		case GL_SAMPLER_2D_ARRAY_SHADOW:
+		case GL_SAMPLER_2D_MULTISAMPLE:
+		case GL_SAMPLER_2D_MULTISAMPLE_ARRAY:
+		case GL_SAMPLER_CUBE_SHADOW:
+		case GL_SAMPLER_CUBE_MAP_ARRAY:
+		case GL_SAMPLER_CUBE_MAP_ARRAY_SHADOW:
+		case GL_SAMPLER_BUFFER:
+		case GL_SAMPLER_2D_RECT:
+		case GL_SAMPLER_2D_RECT_SHADOW:
+		case GL_INT_SAMPLER_1D:
+		case GL_INT_SAMPLER_2D:
+		case GL_INT_SAMPLER_3D:
+		case GL_INT_SAMPLER_CUBE:
+		case GL_INT_SAMPLER_1D_ARRAY:
+		case GL_INT_SAMPLER_2D_ARRAY:
+		case GL_INT_SAMPLER_2D_MULTISAMPLE:
+		case GL_INT_SAMPLER_2D_MULTISAMPLE_ARRAY:
+		case GL_INT_SAMPLER_BUFFER:
+		case GL_INT_SAMPLER_2D_RECT:
+		case GL_INT_SAMPLER_CUBE_MAP_ARRAY:
+		case GL_UNSIGNED_INT_SAMPLER_1D:
+		case GL_UNSIGNED_INT_SAMPLER_2D:
+		case GL_UNSIGNED_INT_SAMPLER_3D:
+		case GL_UNSIGNED_INT_SAMPLER_CUBE:
+		case GL_UNSIGNED_INT_SAMPLER_1D_ARRAY:
+		case GL_UNSIGNED_INT_SAMPLER_2D_ARRAY:
+		case GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE:
+		case GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE_ARRAY:
+		case GL_UNSIGNED_INT_SAMPLER_BUFFER:
+		case GL_UNSIGNED_INT_SAMPLER_2D_RECT:
+		case GL_UNSIGNED_INT_SAMPLER_CUBE_MAP_ARRAY:
+			return MGL_TRUE;
+		default:
+			return MGL_FALSE;
+	}
+}
+
+static mrl_ogl_330_shader_binding_point_t* add_binding_point(mrl_ogl_330_render_device_t* rd, mrl_ogl_330_shader_pipeline_t* pp, mgl_chr8_t* name, GLint loc, mgl_bool_t is_block)
+{
+	mrl_ogl_330_shader_binding_point_t* bp = &pp->bps[pp->bp_count];
+	bp->name = name;
+	bp->id = mrl_get_shader_binding_point_id(name);
+	bp->loc = loc;
+	bp->unit = -1;
+	bp->is_block = is_block;
+	bp->pp = pp;
+
+	if (find_binding_point(pp, bp->id, NULL) != NULL && rd->warning_callback != NULL)
+		rd->warning_callback(MRL_ERROR_EXTERNAL, u8"Shader binding point ID collision, mrl_get_shader_binding_point_by_id may return the wrong binding point");
+
+	pp->bp_count += 1;
+
+	mgl_u32_t slot = (mgl_u32_t)bp->id & pp->table_mask;
+	while (pp->table[slot] != 0)
+		slot = (slot + 1) & pp->table_mask;
+	pp->table[slot] = pp->bp_count;
+
+	return bp;
+}
+
+static GLsizei write_array_element_name(mgl_chr8_t* out, const mgl_chr8_t* base, GLsizei base_size, GLint index)
+{
+	// Writes 'base[index]', returning the name size without the null terminator
+	mgl_chr8_t digits[10];
+	GLsizei digit_count = 0;
+	do
+	{
+		digits[digit_count++] = (mgl_chr8_t)('0' + index % 10);
+		index /= 10;
+	} while (index != 0);
+
+	GLsizei size = 0;
+	for (GLsizei i = 0; i < base_size; ++i)
+		out[size++] = base[i];
+	out[size++] = '[';
+	while (digit_count > 0)
+		out[size++] = digits[--digit_count];
+	out[size++] = ']';
+	out[size] = 0;
+	return size;
+}
+
+static mrl_error_t reflect_shader_pipeline(mrl_ogl_330_render_device_t* rd, mrl_ogl_330_shader_pipeline_t* pp)
+{
+	pp->bp_count = 0;
+	pp->bps = NULL;
+	pp->table_mask = 0;
+	pp->table = NULL;
+	pp->texture_unit_count = 0;
+
+	// Count the uniforms outside of blocks, and the uniform blocks
+	GLint uniform_count = 0, uniform_max_name_size = 0;
+	GLint block_count = 0, block_max_name_size = 0;
+	glGetProgramiv(pp->id, GL_ACTIVE_UNIFORMS, &uniform_count);
+	glGetProgramiv(pp->id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &uniform_max_name_size);
+	glGetProgramiv(pp->id, GL_ACTIVE_UNIFORM_BLOCKS, &block_count);
+	glGetProgramiv(pp->id, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &block_max_name_size);
+
+	// Array uniforms may also get a binding point per element, so reserve room for them
+	mgl_u32_t bp_count = (mgl_u32_t)block_count;
+	mgl_u64_t element_count = 0;
+	for (GLuint i = 0; i < (GLuint)uniform_count; ++i)
+	{
+		GLint block_index, size;
+		glGetActiveUniformsiv(pp->id, 1, &i, GL_UNIFORM_BLOCK_INDEX, &block_index);
+		glGetActiveUniformsiv(pp->id, 1, &i, GL_UNIFORM_SIZE, &size);
+		if (block_index == -1)
+		{
+			bp_count += 1 + (mgl_u32_t)size;
+			element_count += (mgl_u64_t)size;
+		}
+	}
+
+	if (bp_count == 0)
+		return MRL_ERROR_NONE;
+
+	// Keep the table at most half full
+	mgl_u32_t table_size = 1;
+	while (table_size < bp_count * 2)
+		table_size *= 2;
+
+	// Allocate binding points, table and names
+	mgl_u64_t bps_size = sizeof(mrl_ogl_330_shader_binding_point_t) * bp_count;
+	mgl_u64_t table_size_bytes = sizeof(mgl_u32_t) * table_size;
+	mgl_u64_t names_size = (mgl_u64_t)uniform_count * (mgl_u64_t)uniform_max_name_size + (mgl_u64_t)block_count * (mgl_u64_t)block_max_name_size;
+	names_size += element_count * ((mgl_u64_t)uniform_max_name_size + 10); // Element names swap '0' for up to 10 digits
+	mgl_error_t err = mgl_allocate(
+		rd->allocator,
+		bps_size + table_size_bytes + names_size,
+		(void**)&pp->bps);
+	if (err != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(err);
+
+	pp->table = (mgl_u32_t*)((mgl_u8_t*)pp->bps + bps_size);
+	pp->table_mask = table_size - 1;
+	mgl_mem_set(pp->table, table_size_bytes, 0);
+	mgl_chr8_t* names = (mgl_chr8_t*)pp->table + table_size_bytes;
+
+	// Add uniforms
+	for (GLuint i = 0; i < (GLuint)uniform_count; ++i)
+	{
+		GLint block_index;
+		glGetActiveUniformsiv(pp->id, 1, &i, GL_UNIFORM_BLOCK_INDEX, &block_index);
+		if (block_index != -1)
+			continue;
+
+		GLsizei name_size = 0;
+		GLint size;
+		GLenum type;
+		glGetActiveUniform(pp->id, i, uniform_max_name_size, &name_size, &size, &type, names);
+		GLint loc = glGetUniformLocation(pp->id, names);
+
+		// Array uniforms are reflected as 'name[0]', but are looked up both as 'name' and as 'name[i]'
+		mgl_bool_t is_array = name_size > 3 && mgl_str_equal(names + name_size - 3, u8"[0]");
+		if (is_array)
+			names[name_size - 3] = 0;
+		mrl_ogl_330_shader_binding_point_t* bp = add_binding_point(rd, pp, names, loc, MGL_FALSE);
+		names += name_size + 1;
+
+		// Assign texture units to samplers, setting the sampler uniforms only once
+		if (is_sampler_type(type))
+		{
+			if (pp->texture_unit_count + (mgl_u32_t)size > (mgl_u32_t)rd->limits.max_texture_units)
+			{
+				mgl_deallocate(rd->allocator, pp->bps);
+				pp->bp_count = 0;
+				pp->bps = NULL;
+				if (rd->error_callback != NULL)
+					rd->error_callback(MRL_ERROR_FAILED_TO_LINK_SHADER_PIPELINE, u8"Failed to create shader pipeline: the pipeline uses more samplers than there are texture units");
+				return MRL_ERROR_FAILED_TO_LINK_SHADER_PIPELINE;
+			}
+
+			bp->unit = (GLint)pp->texture_unit_count;
+			pp->texture_unit_count += (mgl_u32_t)size;
+			use_program(rd, pp->id);
+			if (size == 1)
+				glUniform1i(bp->loc, bp->unit);
+			else
+			{
+				// Sampler arrays get one unit per element
+				GLint* units;
+				err = mgl_allocate(rd->allocator, sizeof(GLint) * size, (void**)&units);
+				if (err != MGL_ERROR_NONE)
+				{
+					mgl_deallocate(rd->allocator, pp->bps);
+					pp->bp_count = 0;
+					pp->bps = NULL;
+					return mrl_make_mgl_error(err);
+				}
+				for (GLint j = 0; j < size; ++j)
+					units[j] = bp->unit + j;
+				glUniform1iv(bp->loc, size, units);
+				mgl_deallocate(rd->allocator, units);
+			}
+		}
+
+		// Add a binding point per array element, with its own texture unit if it's a sampler
+		if (is_array)
+			for (GLint j = 0; j < size; ++j)
+			{
+				GLsizei element_name_size = write_array_element_name(names, bp->name, name_size - 3, j);
+				mrl_ogl_330_shader_binding_point_t* element_bp = add_binding_point(rd, pp, names, glGetUniformLocation(pp->id, names), MGL_FALSE);
+				if (bp->unit != -1)
+					element_bp->unit = bp->unit + j;
+				names += element_name_size + 1;
+			}
+	}
+
+	// Add uniform blocks, binding each block to the buffer binding with the same index
+	for (GLuint i = 0; i < (GLuint)block_count; ++i)
+	{
+		GLsizei name_size = 0;
+		glGetActiveUniformBlockName(pp->id, i, block_max_name_size, &name_size, names);
+		glUniformBlockBinding(pp->id, i, i);
+		add_binding_point(rd, pp, names, (GLint)i, MGL_TRUE);
+		names += name_size + 1;
 	}
 
-	// Store stage info
-	obj->id = id;
-	*stage = (mrl_shader_stage_t*)obj;
+	// Check errors
+	GLenum gl_err = get_gl_error(rd);
+	if (gl_err != 0)
+	{
+		mgl_deallocate(rd->allocator, pp->bps);
+		pp->bp_count = 0;
+		pp->bps = NULL;
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_EXTERNAL, opengl_error_code_to_str(gl_err));
+		return MRL_ERROR_EXTERNAL;
+	}
 
 	return MRL_ERROR_NONE;
 }
 
-static void destroy_shader_stage(mrl_render_device_t* brd, mrl_shader_stage_t* stage)
-{
-	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
-	mrl_ogl_330_shader_stage_t* obj = (mrl_ogl_330_shader_stage_t*)stage;
-
-	// Delete shader
-	glDeleteShader(obj->id);
-
-	// Deallocate object
-	mgl_deallocate(
-		&rd->memory.shader_stage.pool,
-		obj);
-}
-
 static mrl_error_t create_shader_pipeline(mrl_render_device_t* brd, mrl_shader_pipeline_t** pipeline, const mrl_shader_pipeline_desc_t* desc)
 {
 	MGL_DEBUG_ASSERT(desc->vertex != NULL && desc->pixel != NULL);
@@ -2495,7 +4886,7 @@ static mrl_error_t create_shader_pipeline(mrl_render_device_t* brd, mrl_shader_p
 		return MRL_ERROR_FAILED_TO_LINK_SHADER_PIPELINE;
 	}
 
-	GLenum gl_err = glGetError();
+	GLenum gl_err = get_gl_error(rd);
 	if (gl_err != 0)
 	{
 		glDeleteProgram(id);
@@ -2506,9 +4897,8 @@ static mrl_error_t create_shader_pipeline(mrl_render_device_t* brd, mrl_shader_p
 
 	// Allocate object
 	mrl_ogl_330_shader_pipeline_t* obj;
-	mgl_error_t err = mgl_allocate(
-		&rd->memory.shader_pipeline.pool,
-		sizeof(*obj),
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.shader_pipeline,
 		(void**)&obj);
 	if (err != MGL_ERROR_NONE)
 	{
@@ -2518,13 +4908,18 @@ static mrl_error_t create_shader_pipeline(mrl_render_device_t* brd, mrl_shader_p
 
 	// Store pipeline info
 	obj->id = id;
-	*pipeline = (mrl_shader_pipeline_t*)obj;
-	for (mgl_u64_t i = 0; i < MRL_OGL_330_SHADER_MAX_BINDING_POINT_COUNT; ++i)
+
+	// Reflect binding points
+	mrl_error_t mrlerr = reflect_shader_pipeline(rd, obj);
+	if (mrlerr != MRL_ERROR_NONE)
 	{
-		obj->bps[i].pp = obj;
-		obj->bps[i].loc = -1;
+		glDeleteProgram(id);
+		mrl_deallocate_object(&rd->memory.shader_pipeline, obj);
+		return mrlerr;
 	}
 
+	*pipeline = (mrl_shader_pipeline_t*)obj;
+
 	return MRL_ERROR_NONE;
 }
 
@@ -2535,10 +4930,14 @@ static void destroy_shader_pipeline(mrl_render_device_t* brd, mrl_shader_pipelin
 
 	// Delete program
 	glDeleteProgram(obj->id);
+	if (rd->cache.program == obj->id)
+		rd->cache.program = MRL_OGL_330_UNKNOWN_BINDING;
 
 	// Deallocate object
-	mgl_deallocate(
-		&rd->memory.shader_pipeline.pool,
+	if (obj->bps != NULL)
+		mgl_deallocate(rd->allocator, obj->bps);
+	mrl_deallocate_object(
+		&rd->memory.shader_pipeline,
 		obj);
 }
 
@@ -2549,9 +4948,9 @@ static void set_shader_pipeline(mrl_render_device_t* brd, mrl_shader_pipeline_t*
 
 	// Set program
 	if (pipeline == NULL)
-		glUseProgram(0);
+		use_program(rd, 0);
 	else
-		glUseProgram(obj->id);
+		use_program(rd, obj->id);
 }
 
 static mrl_shader_binding_point_t* get_shader_binding_point(mrl_render_device_t* brd, mrl_shader_pipeline_t* pipeline, const mgl_chr8_t* name)
@@ -2560,63 +4959,31 @@ static mrl_shader_binding_point_t* get_shader_binding_point(mrl_render_device_t*
 	mrl_ogl_330_shader_pipeline_t* obj = (mrl_ogl_330_shader_pipeline_t*)pipeline;
 
 	// Get binding point
-	mrl_ogl_330_shader_binding_point_t* free_bp = NULL;
-	for (mgl_u64_t i = 0; i < MRL_OGL_330_SHADER_MAX_BINDING_POINT_COUNT; ++i)
-	{
-		if (obj->bps[i].loc == -1)
-		{
-			free_bp = &obj->bps[i];
-			continue;
-		}
-
-		if (mgl_str_equal(name, obj->bps[i].name))
-			return (mrl_shader_binding_point_t*)&obj->bps[i];
-	}
-
-	// Add binding point
-	GLint loc = glGetUniformLocation(obj->id, name);
-	if (loc == -1)
-	{
-		loc = (GLint)glGetUniformBlockIndex(obj->id, name);
-		glUniformBlockBinding(obj->id, (GLuint)loc, (GLuint)loc);
-		if (loc == GL_INVALID_INDEX)
-		{
-			GLenum gl_err = glGetError();
-			mgl_chr8_t msg[512] = { 0 };
-			mgl_buffer_stream_t stream;
-			mgl_init_buffer_stream(&stream, msg, sizeof(msg));
-			mgl_print(&stream, u8"Couldn't find any binding point with the name \"");
-			mgl_print(&stream, name);
-			mgl_print(&stream, u8"\" (OpenGL error '");
-			mgl_print(&stream, opengl_error_code_to_str(gl_err));
-			mgl_print(&stream, u8"')");
-
-			if (rd->warning_callback != NULL)
-				rd->warning_callback(MRL_ERROR_BINDING_POINT_NOT_FOUND, msg);
-			return NULL;
-		}
-	}
-
-	// Check if there are still free binding points
-	if (free_bp == NULL)
+	mrl_ogl_330_shader_binding_point_t* bp = find_binding_point(obj, mrl_get_shader_binding_point_id(name), name);
+	if (bp == NULL)
 	{
-		MGL_DEBUG_ASSERT(MGL_FALSE); // Too many binding points
+		mgl_chr8_t msg[512] = { 0 };
+		mgl_buffer_stream_t stream;
+		mgl_init_buffer_stream(&stream, msg, sizeof(msg));
+		mgl_print(&stream, u8"Couldn't find any binding point with the name \"");
+		mgl_print(&stream, name);
+		mgl_print(&stream, u8"\"");
+
+		if (rd->warning_callback != NULL)
+			rd->warning_callback(MRL_ERROR_BINDING_POINT_NOT_FOUND, msg);
 		return NULL;
 	}
 
-	// Check errors
-	GLenum gl_err = glGetError();
-	if (gl_err != 0)
-	{
-		if (rd->error_callback != NULL)
-			rd->error_callback(MRL_ERROR_EXTERNAL, opengl_error_code_to_str(gl_err));
-		return NULL;
-	}
+	return (mrl_shader_binding_point_t*)bp;
+}
 
-	mgl_str_copy(name, free_bp->name, MRL_OGL_330_SHADER_BINDING_POINT_MAX_NAME_SIZE);
-	free_bp->loc = loc;
+static mrl_shader_binding_point_t* get_shader_binding_point_by_id(mrl_render_device_t* brd, mrl_shader_pipeline_t* pipeline, mgl_u64_t id)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_shader_pipeline_t* obj = (mrl_ogl_330_shader_pipeline_t*)pipeline;
 
-	return (mrl_shader_binding_point_t*)free_bp;
+	// Get binding point
+	return (mrl_shader_binding_point_t*)find_binding_point(obj, id, NULL);
 }
 
 // --------- Draw functions ----------
@@ -2644,10 +5011,19 @@ static void clear_stencil(mrl_render_device_t* brd, mgl_i32_t stencil)
 
 static void swap_buffers(mrl_render_device_t* brd)
 {
-#	ifdef MGL_SYSTEM_WINDOWS
 	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+#	ifdef MGL_SYSTEM_WINDOWS
 	SwapBuffers(rd->win32.hdc);
 #	endif
+	flush_debug_messages(rd);
+}
+
+static void swap_offscreen_buffers(mrl_render_device_t* brd)
+{
+	// There is nothing to present, just make sure the frame is submitted
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	glFlush();
+	flush_debug_messages(rd);
 }
 
 static void draw_triangles(mrl_render_device_t* brd, mgl_u64_t offset, mgl_u64_t count)
@@ -2674,6 +5050,111 @@ static void draw_triangles_indexed_instanced(mrl_render_device_t* brd, mgl_u64_t
 	glDrawElementsInstanced(GL_TRIANGLES, (GLsizei)count, rd->state.index_buffer_format, (const void*)offset, (GLsizei)instance_count);
 }
 
+static void draw_triangles_indexed_base_vertex(mrl_render_device_t* brd, mgl_u64_t offset, mgl_u64_t count, mgl_i64_t base_vertex)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)count, rd->state.index_buffer_format, (const void*)offset, (GLint)base_vertex);
+}
+
+static void draw_triangles_indexed_instanced_base_vertex(mrl_render_device_t* brd, mgl_u64_t offset, mgl_u64_t count, mgl_u64_t instance_count, mgl_i64_t base_vertex)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	glDrawElementsInstancedBaseVertex(GL_TRIANGLES, (GLsizei)count, rd->state.index_buffer_format, (const void*)offset, (GLsizei)instance_count, (GLint)base_vertex);
+}
+
+static void multi_draw_triangles(mrl_render_device_t* brd, const mgl_u64_t* offsets, const mgl_u64_t* counts, mgl_u64_t draw_count)
+{
+	GLint gl_firsts[MRL_OGL_330_MULTI_DRAW_BATCH_SIZE];
+	GLsizei gl_counts[MRL_OGL_330_MULTI_DRAW_BATCH_SIZE];
+
+	for (mgl_u64_t i = 0; i < draw_count; i += MRL_OGL_330_MULTI_DRAW_BATCH_SIZE)
+	{
+		mgl_u64_t batch_count = draw_count - i < MRL_OGL_330_MULTI_DRAW_BATCH_SIZE ? draw_count - i : MRL_OGL_330_MULTI_DRAW_BATCH_SIZE;
+		for (mgl_u64_t j = 0; j < batch_count; ++j)
+		{
+			gl_firsts[j] = (GLint)offsets[i + j];
+			gl_counts[j] = (GLsizei)counts[i + j];
+		}
+		glMultiDrawArrays(GL_TRIANGLES, gl_firsts, gl_counts, (GLsizei)batch_count);
+	}
+}
+
+static void multi_draw_triangles_indexed(mrl_render_device_t* brd, const mgl_u64_t* offsets, const mgl_u64_t* counts, const mgl_i64_t* base_vertices, mgl_u64_t draw_count)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	const void* gl_offsets[MRL_OGL_330_MULTI_DRAW_BATCH_SIZE];
+	GLsizei gl_counts[MRL_OGL_330_MULTI_DRAW_BATCH_SIZE];
+	GLint gl_base_vertices[MRL_OGL_330_MULTI_DRAW_BATCH_SIZE];
+
+	for (mgl_u64_t i = 0; i < draw_count; i += MRL_OGL_330_MULTI_DRAW_BATCH_SIZE)
+	{
+		mgl_u64_t batch_count = draw_count - i < MRL_OGL_330_MULTI_DRAW_BATCH_SIZE ? draw_count - i : MRL_OGL_330_MULTI_DRAW_BATCH_SIZE;
+		for (mgl_u64_t j = 0; j < batch_count; ++j)
+		{
+			gl_offsets[j] = (const void*)offsets[i + j];
+			gl_counts[j] = (GLsizei)counts[i + j];
+		}
+
+		if (base_vertices == NULL)
+			glMultiDrawElements(GL_TRIANGLES, gl_counts, rd->state.index_buffer_format, gl_offsets, (GLsizei)batch_count);
+		else
+		{
+			for (mgl_u64_t j = 0; j < batch_count; ++j)
+				gl_base_vertices[j] = (GLint)base_vertices[i + j];
+			glMultiDrawElementsBaseVertex(GL_TRIANGLES, gl_counts, rd->state.index_buffer_format, gl_offsets, (GLsizei)batch_count, gl_base_vertices);
+		}
+	}
+}
+
+static void draw_triangles_indirect(mrl_render_device_t* brd, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t draw_count)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_indirect_buffer_t* obj = (mrl_ogl_330_indirect_buffer_t*)ib;
+
+	if (obj->id == 0)
+	{
+		// Emulate the indirect draws with the arguments kept in system memory
+		for (mgl_u64_t i = 0; i < draw_count; ++i)
+		{
+			mrl_draw_indirect_args_t args;
+			mgl_mem_copy(&args, obj->data + offset + i * sizeof(args), sizeof(args));
+			glDrawArraysInstanced(GL_TRIANGLES, (GLint)args.first, (GLsizei)args.count, (GLsizei)args.instance_count);
+		}
+		return;
+	}
+
+	bind_indirect_buffer(rd, obj->id);
+	if (rd->limits.multi_draw_indirect)
+		glMultiDrawArraysIndirect(GL_TRIANGLES, (const void*)offset, (GLsizei)draw_count, 0);
+	else for (mgl_u64_t i = 0; i < draw_count; ++i)
+		glDrawArraysIndirect(GL_TRIANGLES, (const void*)(offset + i * sizeof(mrl_draw_indirect_args_t)));
+}
+
+static void draw_triangles_indexed_indirect(mrl_render_device_t* brd, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t draw_count)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_ogl_330_indirect_buffer_t* obj = (mrl_ogl_330_indirect_buffer_t*)ib;
+
+	if (obj->id == 0)
+	{
+		// Emulate the indirect draws with the arguments kept in system memory
+		mgl_u64_t index_size = rd->state.index_buffer_format == GL_UNSIGNED_SHORT ? 2 : 4;
+		for (mgl_u64_t i = 0; i < draw_count; ++i)
+		{
+			mrl_draw_indexed_indirect_args_t args;
+			mgl_mem_copy(&args, obj->data + offset + i * sizeof(args), sizeof(args));
+			glDrawElementsInstancedBaseVertex(GL_TRIANGLES, (GLsizei)args.count, rd->state.index_buffer_format, (const void*)(args.first_index * index_size), (GLsizei)args.instance_count, (GLint)args.base_vertex);
+		}
+		return;
+	}
+
+	bind_indirect_buffer(rd, obj->id);
+	if (rd->limits.multi_draw_indirect)
+		glMultiDrawElementsIndirect(GL_TRIANGLES, rd->state.index_buffer_format, (const void*)offset, (GLsizei)draw_count, 0);
+	else for (mgl_u64_t i = 0; i < draw_count; ++i)
+		glDrawElementsIndirect(GL_TRIANGLES, rd->state.index_buffer_format, (const void*)(offset + i * sizeof(mrl_draw_indexed_indirect_args_t)));
+}
+
 static void set_viewport(mrl_render_device_t* brd, mgl_i32_t x, mgl_i32_t y, mgl_i32_t w, mgl_i32_t h)
 {
 	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
@@ -2699,6 +5180,12 @@ static mgl_i64_t get_property_i(mrl_render_device_t* brd, mgl_enum_t name)
 		}
 		else return 1;
 	}
+	else if (name == MRL_PROPERTY_CONSTANT_BUFFER_OFFSET_ALIGNMENT)
+		return rd->limits.uniform_buffer_offset_alignment;
+	else if (name == MRL_PROPERTY_NATIVE_INDIRECT_DRAWS)
+		return rd->limits.draw_indirect ? 1 : 0;
+	else if (name == MRL_PROPERTY_CUBE_MAP_ARRAYS)
+		return rd->limits.texture_cube_map_array ? 1 : 0;
 
 	return -1;
 }
@@ -2721,271 +5208,92 @@ static mgl_f64_t get_property_f(mrl_render_device_t* brd, mgl_enum_t name)
 	return MGL_F64_NAN;
 }
 
-static mrl_error_t create_rd_allocators(mrl_ogl_330_render_device_t* rd, const mrl_render_device_desc_t* desc)
+#define MRL_OGL_330_OBJECT_POOL_COUNT 20
+
+static mrl_object_pool_t* get_rd_pool(mrl_ogl_330_render_device_t* rd, mgl_enum_t type)
 {
-	mgl_error_t err;
+	switch (type)
+	{
+		case MRL_OBJECT_FRAMEBUFFER: return &rd->memory.framebuffer;
+		case MRL_OBJECT_RASTER_STATE: return &rd->memory.raster_state;
+		case MRL_OBJECT_DEPTH_STENCIL_STATE: return &rd->memory.depth_stencil_state;
+		case MRL_OBJECT_BLEND_STATE: return &rd->memory.blend_state;
+		case MRL_OBJECT_SAMPLER: return &rd->memory.sampler;
+		case MRL_OBJECT_TEXTURE_1D: return &rd->memory.texture_1d;
+		case MRL_OBJECT_TEXTURE_2D: return &rd->memory.texture_2d;
+		case MRL_OBJECT_TEXTURE_3D: return &rd->memory.texture_3d;
+		case MRL_OBJECT_CUBE_MAP: return &rd->memory.cube_map;
+		case MRL_OBJECT_CONSTANT_BUFFER: return &rd->memory.constant_buffer;
+		case MRL_OBJECT_INDEX_BUFFER: return &rd->memory.index_buffer;
+		case MRL_OBJECT_VERTEX_BUFFER: return &rd->memory.vertex_buffer;
+		case MRL_OBJECT_VERTEX_ARRAY: return &rd->memory.vertex_array;
+		case MRL_OBJECT_SHADER_STAGE: return &rd->memory.shader_stage;
+		case MRL_OBJECT_SHADER_PIPELINE: return &rd->memory.shader_pipeline;
+		case MRL_OBJECT_STREAM_ALLOCATOR: return &rd->memory.stream_allocator;
+		case MRL_OBJECT_INDIRECT_BUFFER: return &rd->memory.indirect_buffer;
+		case MRL_OBJECT_UPLOAD_QUEUE: return &rd->memory.upload_queue;
+		case MRL_OBJECT_TEXTURE_2D_ARRAY: return &rd->memory.texture_2d_array;
+		case MRL_OBJECT_CUBE_MAP_ARRAY: return &rd->memory.cube_map_array;
+		default: return NULL;
+	}
+}
 
-	// Create shader stage pool
-	err = mgl_allocate(
-		rd->allocator,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_shader_stage_count, sizeof(mrl_ogl_330_shader_stage_t)),
-		(void**)&rd->memory.shader_stage.data);
-	if (err != MGL_ERROR_NONE)
-		goto mgl_error_1;
-	mgl_init_pool_allocator(
-		&rd->memory.shader_stage.pool,
-		desc->max_shader_stage_count,
-		sizeof(mrl_ogl_330_shader_stage_t),
-		rd->memory.shader_stage.data,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_shader_stage_count, sizeof(mrl_ogl_330_shader_stage_t)));
-
-	// Create shader stage pool
-	err = mgl_allocate(
-		rd->allocator,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_shader_pipeline_count, sizeof(mrl_ogl_330_shader_pipeline_t)),
-		(void**)&rd->memory.shader_pipeline.data);
-	if (err != MGL_ERROR_NONE)
-		goto mgl_error_2;
-	mgl_init_pool_allocator(
-		&rd->memory.shader_pipeline.pool,
-		desc->max_shader_pipeline_count,
-		sizeof(mrl_ogl_330_shader_pipeline_t),
-		rd->memory.shader_pipeline.data,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_shader_pipeline_count, sizeof(mrl_ogl_330_shader_pipeline_t)));
-
-	// Create vertex buffer pool
-	err = mgl_allocate(
-		rd->allocator,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_vertex_buffer_count, sizeof(mrl_ogl_330_vertex_buffer_t)),
-		(void**)&rd->memory.vertex_buffer.data);
-	if (err != MGL_ERROR_NONE)
-		goto mgl_error_3;
-	mgl_init_pool_allocator(
-		&rd->memory.vertex_buffer.pool,
-		desc->max_vertex_buffer_count,
-		sizeof(mrl_ogl_330_vertex_buffer_t),
-		rd->memory.vertex_buffer.data,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_vertex_buffer_count, sizeof(mrl_ogl_330_vertex_buffer_t)));
-
-	// Create vertex array pool
-	err = mgl_allocate(
-		rd->allocator,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_vertex_array_count, sizeof(mrl_ogl_330_vertex_array_t)),
-		(void**)&rd->memory.vertex_array.data);
-	if (err != MGL_ERROR_NONE)
-		goto mgl_error_4;
-	mgl_init_pool_allocator(
-		&rd->memory.vertex_array.pool,
-		desc->max_vertex_array_count,
-		sizeof(mrl_ogl_330_vertex_array_t),
-		rd->memory.vertex_array.data,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_vertex_array_count, sizeof(mrl_ogl_330_vertex_array_t)));
-
-	// Create index buffer pool
-	err = mgl_allocate(
-		rd->allocator,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_index_buffer_count, sizeof(mrl_ogl_330_index_buffer_t)),
-		(void**)&rd->memory.index_buffer.data);
-	if (err != MGL_ERROR_NONE)
-		goto mgl_error_5;
-	mgl_init_pool_allocator(
-		&rd->memory.index_buffer.pool,
-		desc->max_index_buffer_count,
-		sizeof(mrl_ogl_330_index_buffer_t),
-		rd->memory.index_buffer.data,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_index_buffer_count, sizeof(mrl_ogl_330_index_buffer_t)));
-
-	// Create constant buffer pool
-	err = mgl_allocate(
-		rd->allocator,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_constant_buffer_count, sizeof(mrl_ogl_330_constant_buffer_t)),
-		(void**)&rd->memory.constant_buffer.data);
-	if (err != MGL_ERROR_NONE)
-		goto mgl_error_6;
-	mgl_init_pool_allocator(
-		&rd->memory.constant_buffer.pool,
-		desc->max_constant_buffer_count,
-		sizeof(mrl_ogl_330_constant_buffer_t),
-		rd->memory.constant_buffer.data,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_constant_buffer_count, sizeof(mrl_ogl_330_constant_buffer_t)));
-
-	// Create cube map pool
-	err = mgl_allocate(
-		rd->allocator,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_cube_map_count, sizeof(mrl_ogl_330_cube_map_t)),
-		(void**)&rd->memory.cube_map.data);
-	if (err != MGL_ERROR_NONE)
-		goto mgl_error_7;
-	mgl_init_pool_allocator(
-		&rd->memory.cube_map.pool,
-		desc->max_cube_map_count,
-		sizeof(mrl_ogl_330_cube_map_t),
-		rd->memory.cube_map.data,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_cube_map_count, sizeof(mrl_ogl_330_cube_map_t)));
-
-	// Create texture 3D pool
-	err = mgl_allocate(
-		rd->allocator,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_texture_3d_count, sizeof(mrl_ogl_330_texture_3d_t)),
-		(void**)&rd->memory.texture_3d.data);
-	if (err != MGL_ERROR_NONE)
-		goto mgl_error_8;
-	mgl_init_pool_allocator(
-		&rd->memory.texture_3d.pool,
-		desc->max_texture_3d_count,
-		sizeof(mrl_ogl_330_texture_3d_t),
-		rd->memory.texture_3d.data,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_texture_3d_count, sizeof(mrl_ogl_330_texture_3d_t)));
-
-	// Create texture 2D pool
-	err = mgl_allocate(
-		rd->allocator,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_texture_2d_count, sizeof(mrl_ogl_330_texture_2d_t)),
-		(void**)&rd->memory.texture_2d.data);
-	if (err != MGL_ERROR_NONE)
-		goto mgl_error_9;
-	mgl_init_pool_allocator(
-		&rd->memory.texture_2d.pool,
-		desc->max_texture_2d_count,
-		sizeof(mrl_ogl_330_texture_2d_t),
-		rd->memory.texture_2d.data,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_texture_2d_count, sizeof(mrl_ogl_330_texture_2d_t)));
-
-	// Create texture 1D pool
-	err = mgl_allocate(
-		rd->allocator,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_texture_1d_count, sizeof(mrl_ogl_330_texture_1d_t)),
-		(void**)&rd->memory.texture_1d.data);
-	if (err != MGL_ERROR_NONE)
-		goto mgl_error_10;
-	mgl_init_pool_allocator(
-		&rd->memory.texture_1d.pool,
-		desc->max_texture_1d_count,
-		sizeof(mrl_ogl_330_texture_1d_t),
-		rd->memory.texture_1d.data,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_texture_1d_count, sizeof(mrl_ogl_330_texture_1d_t)));
-
-	// Create sampler pool
-	err = mgl_allocate(
-		rd->allocator,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_sampler_count, sizeof(mrl_ogl_330_sampler_t)),
-		(void**)&rd->memory.sampler.data);
-	if (err != MGL_ERROR_NONE)
-		goto mgl_error_11;
-	mgl_init_pool_allocator(
-		&rd->memory.sampler.pool,
-		desc->max_sampler_count,
-		sizeof(mrl_ogl_330_sampler_t),
-		rd->memory.sampler.data,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_sampler_count, sizeof(mrl_ogl_330_sampler_t)));
-
-	// Create blend state pool
-	err = mgl_allocate(
-		rd->allocator,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_blend_state_count, sizeof(mrl_ogl_330_blend_state_t)),
-		(void**)&rd->memory.blend_state.data);
-	if (err != MGL_ERROR_NONE)
-		goto mgl_error_12;
-	mgl_init_pool_allocator(
-		&rd->memory.blend_state.pool,
-		desc->max_blend_state_count,
-		sizeof(mrl_ogl_330_blend_state_t),
-		rd->memory.blend_state.data,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_blend_state_count, sizeof(mrl_ogl_330_blend_state_t)));
-
-	// Create depth stencil state pool
-	err = mgl_allocate(
-		rd->allocator,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_depth_stencil_state_count, sizeof(mrl_ogl_330_depth_stencil_state_t)),
-		(void**)&rd->memory.depth_stencil_state.data);
-	if (err != MGL_ERROR_NONE)
-		goto mgl_error_13;
-	mgl_init_pool_allocator(
-		&rd->memory.depth_stencil_state.pool,
-		desc->max_depth_stencil_state_count,
-		sizeof(mrl_ogl_330_depth_stencil_state_t),
-		rd->memory.depth_stencil_state.data,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_depth_stencil_state_count, sizeof(mrl_ogl_330_depth_stencil_state_t)));
-
-	// Create raster state pool
-	err = mgl_allocate(
-		rd->allocator,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_raster_state_count, sizeof(mrl_ogl_330_raster_state_t)),
-		(void**)&rd->memory.raster_state.data);
-	if (err != MGL_ERROR_NONE)
-		goto mgl_error_14;
-	mgl_init_pool_allocator(
-		&rd->memory.raster_state.pool,
-		desc->max_raster_state_count,
-		sizeof(mrl_ogl_330_raster_state_t),
-		rd->memory.raster_state.data,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_raster_state_count, sizeof(mrl_ogl_330_raster_state_t)));
-
-	// Create framebuffer pool
-	err = mgl_allocate(
-		rd->allocator,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_framebuffer_count, sizeof(mrl_ogl_330_framebuffer_t)),
-		(void**)&rd->memory.framebuffer.data);
-	if (err != MGL_ERROR_NONE)
-		goto mgl_error_15;
-	mgl_init_pool_allocator(
-		&rd->memory.framebuffer.pool,
-		desc->max_framebuffer_count,
-		sizeof(mrl_ogl_330_framebuffer_t),
-		rd->memory.framebuffer.data,
-		MGL_POOL_ALLOCATOR_SIZE(desc->max_framebuffer_count, sizeof(mrl_ogl_330_framebuffer_t)));
+static mrl_error_t create_rd_allocators(mrl_ogl_330_render_device_t* rd, const mrl_render_device_desc_t* desc)
+{
+	// Object size and number of objects reserved up front, by object type
+	const mgl_u64_t sizes[MRL_OGL_330_OBJECT_POOL_COUNT][2] = {
+		{ sizeof(mrl_ogl_330_framebuffer_t), desc->max_framebuffer_count },
+		{ sizeof(mrl_ogl_330_raster_state_t), desc->max_raster_state_count },
+		{ sizeof(mrl_ogl_330_depth_stencil_state_t), desc->max_depth_stencil_state_count },
+		{ sizeof(mrl_ogl_330_blend_state_t), desc->max_blend_state_count },
+		{ sizeof(mrl_ogl_330_sampler_t), desc->max_sampler_count },
+		{ sizeof(mrl_ogl_330_texture_1d_t), desc->max_texture_1d_count },
+		{ sizeof(mrl_ogl_330_texture_2d_t), desc->max_texture_2d_count },
+		{ sizeof(mrl_ogl_330_texture_3d_t), desc->max_texture_3d_count },
+		{ sizeof(mrl_ogl_330_cube_map_t), desc->max_cube_map_count },
+		{ sizeof(mrl_ogl_330_constant_buffer_t), desc->max_constant_buffer_count },
+		{ sizeof(mrl_ogl_330_index_buffer_t), desc->max_index_buffer_count },
+		{ sizeof(mrl_ogl_330_vertex_buffer_t), desc->max_vertex_buffer_count },
+		{ sizeof(mrl_ogl_330_vertex_array_t), desc->max_vertex_array_count },
+		{ sizeof(mrl_ogl_330_shader_stage_t), desc->max_shader_stage_count },
+		{ sizeof(mrl_ogl_330_shader_pipeline_t), desc->max_shader_pipeline_count },
+		{ sizeof(mrl_ogl_330_stream_allocator_t), desc->max_stream_allocator_count },
+		{ sizeof(mrl_ogl_330_indirect_buffer_t), desc->max_indirect_buffer_count },
+		{ sizeof(mrl_ogl_330_upload_queue_t), desc->max_upload_queue_count },
+		{ sizeof(mrl_ogl_330_texture_2d_array_t), desc->max_texture_2d_array_count },
+		{ sizeof(mrl_ogl_330_cube_map_array_t), desc->max_cube_map_array_count },
+	};
+
+	// Create object pools
+	for (mgl_enum_t i = 0; i < MRL_OGL_330_OBJECT_POOL_COUNT; ++i)
+	{
+		mgl_error_t err = mrl_init_object_pool(get_rd_pool(rd, i), rd->allocator, sizes[i][0], sizes[i][1]);
+		if (err != MGL_ERROR_NONE)
+		{
+			while (i-- > 0)
+				mrl_terminate_object_pool(get_rd_pool(rd, i));
+			return mrl_make_mgl_error(err);
+		}
+	}
 
 	return MRL_ERROR_NONE;
-
-mgl_error_15:
-	mgl_deallocate(rd->allocator, rd->memory.raster_state.data);
-mgl_error_14:
-	mgl_deallocate(rd->allocator, rd->memory.depth_stencil_state.data);
-mgl_error_13:
-	mgl_deallocate(rd->allocator, rd->memory.blend_state.data);
-mgl_error_12:
-	mgl_deallocate(rd->allocator, rd->memory.sampler.data);
-mgl_error_11:
-	mgl_deallocate(rd->allocator, rd->memory.texture_1d.data);
-mgl_error_10:
-	mgl_deallocate(rd->allocator, rd->memory.texture_2d.data);
-mgl_error_9:
-	mgl_deallocate(rd->allocator, rd->memory.texture_3d.data);
-mgl_error_8:
-	mgl_deallocate(rd->allocator, rd->memory.cube_map.data);
-mgl_error_7:
-	mgl_deallocate(rd->allocator, rd->memory.constant_buffer.data);
-mgl_error_6:
-	mgl_deallocate(rd->allocator, rd->memory.index_buffer.data);
-mgl_error_5:
-	mgl_deallocate(rd->allocator, rd->memory.vertex_array.data);
-mgl_error_4:
-	mgl_deallocate(rd->allocator, rd->memory.vertex_buffer.data);
-mgl_error_3:
-	mgl_deallocate(rd->allocator, rd->memory.shader_pipeline.data);
-mgl_error_2:
-	mgl_deallocate(rd->allocator, rd->memory.shader_stage.data);
-mgl_error_1:
-	return mrl_make_mgl_error(err);
 }
 
 static void destroy_rd_allocators(mrl_ogl_330_render_device_t* rd)
 {
-	mgl_deallocate(rd->allocator, rd->memory.framebuffer.data);
-	mgl_deallocate(rd->allocator, rd->memory.raster_state.data);
-	mgl_deallocate(rd->allocator, rd->memory.depth_stencil_state.data);
-	mgl_deallocate(rd->allocator, rd->memory.blend_state.data);
-	mgl_deallocate(rd->allocator, rd->memory.sampler.data);
-	mgl_deallocate(rd->allocator, rd->memory.texture_1d.data);
-	mgl_deallocate(rd->allocator, rd->memory.texture_2d.data);
-	mgl_deallocate(rd->allocator, rd->memory.texture_3d.data);
-	mgl_deallocate(rd->allocator, rd->memory.cube_map.data);
-	mgl_deallocate(rd->allocator, rd->memory.constant_buffer.data);
-	mgl_deallocate(rd->allocator, rd->memory.index_buffer.data);
-	mgl_deallocate(rd->allocator, rd->memory.vertex_buffer.data);
-	mgl_deallocate(rd->allocator, rd->memory.vertex_array.data);
-	mgl_deallocate(rd->allocator, rd->memory.shader_stage.data);
-	mgl_deallocate(rd->allocator, rd->memory.shader_pipeline.data);
+	for (mgl_enum_t i = 0; i < MRL_OGL_330_OBJECT_POOL_COUNT; ++i)
+		mrl_terminate_object_pool(get_rd_pool(rd, i));
+}
+
+static void get_object_pool_stats(mrl_render_device_t* brd, mgl_enum_t type, mrl_object_pool_stats_t* stats)
+{
+	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
+	mrl_object_pool_t* pool = get_rd_pool(rd, type);
+	MGL_DEBUG_ASSERT(pool != NULL);
+
+	stats->count = pool->count;
+	stats->high_water_mark = pool->high_water_mark;
+	stats->capacity = pool->capacity;
 }
 
 static void set_rd_functions(mrl_ogl_330_render_device_t* rd)
@@ -3043,12 +5351,29 @@ static void set_rd_functions(mrl_ogl_330_render_device_t* rd)
 	rd->base.bind_cube_map = &bind_cube_map;
 	rd->base.update_cube_map = &update_cube_map;
 
+	// Texture 2D array functions
+	rd->base.create_texture_2d_array = &create_texture_2d_array;
+	rd->base.destroy_texture_2d_array = &destroy_texture_2d_array;
+	rd->base.generate_texture_2d_array_mipmaps = &generate_texture_2d_array_mipmaps;
+	rd->base.bind_texture_2d_array = &bind_texture_2d_array;
+	rd->base.update_texture_2d_array = &update_texture_2d_array;
+
+	// Cube map array functions
+	rd->base.create_cube_map_array = &create_cube_map_array;
+	rd->base.destroy_cube_map_array = &destroy_cube_map_array;
+	rd->base.generate_cube_map_array_mipmaps = &generate_cube_map_array_mipmaps;
+	rd->base.bind_cube_map_array = &bind_cube_map_array;
+	rd->base.update_cube_map_array = &update_cube_map_array;
+
 	// Constant buffer functions
 	rd->base.create_constant_buffer = &create_constant_buffer;
 	rd->base.destroy_constant_buffer = &destroy_constant_buffer;
 	rd->base.bind_constant_buffer = &bind_constant_buffer;
+	rd->base.bind_constant_buffer_range = &bind_constant_buffer_range;
 	rd->base.map_constant_buffer = &map_constant_buffer;
 	rd->base.unmap_constant_buffer = &unmap_constant_buffer;
+	rd->base.map_constant_buffer_range = &map_constant_buffer_range;
+	rd->base.flush_constant_buffer_range = &flush_constant_buffer_range;
 	rd->base.update_constant_buffer = &update_constant_buffer;
 	rd->base.query_constant_buffer_structure = &query_constant_buffer_structure;
 
@@ -3058,13 +5383,22 @@ static void set_rd_functions(mrl_ogl_330_render_device_t* rd)
 	rd->base.set_index_buffer = &set_index_buffer;
 	rd->base.map_index_buffer = &map_index_buffer;
 	rd->base.unmap_index_buffer = &unmap_index_buffer;
+	rd->base.map_index_buffer_range = &map_index_buffer_range;
+	rd->base.flush_index_buffer_range = &flush_index_buffer_range;
 	rd->base.update_index_buffer = &update_index_buffer;
 
+	// Indirect buffer functions
+	rd->base.create_indirect_buffer = &create_indirect_buffer;
+	rd->base.destroy_indirect_buffer = &destroy_indirect_buffer;
+	rd->base.update_indirect_buffer = &update_indirect_buffer;
+
 	// Vertex buffer functions
 	rd->base.create_vertex_buffer = &create_vertex_buffer;
 	rd->base.destroy_vertex_buffer = &destroy_vertex_buffer;
 	rd->base.map_vertex_buffer = &map_vertex_buffer;
 	rd->base.unmap_vertex_buffer = &unmap_vertex_buffer;
+	rd->base.map_vertex_buffer_range = &map_vertex_buffer_range;
+	rd->base.flush_vertex_buffer_range = &flush_vertex_buffer_range;
 	rd->base.update_vertex_buffer = &update_vertex_buffer;
 
 	// Vertex array functions
@@ -3072,6 +5406,23 @@ static void set_rd_functions(mrl_ogl_330_render_device_t* rd)
 	rd->base.destroy_vertex_array = &destroy_vertex_array;
 	rd->base.set_vertex_array = &set_vertex_array;
 
+	// Stream allocator functions
+	rd->base.create_stream_allocator = &create_stream_allocator;
+	rd->base.destroy_stream_allocator = &destroy_stream_allocator;
+	rd->base.map_stream_allocation = &map_stream_allocation;
+	rd->base.unmap_stream_allocation = &unmap_stream_allocation;
+	rd->base.end_stream_allocator_frame = &end_stream_allocator_frame;
+
+	// Upload queue functions
+	rd->base.create_upload_queue = &create_upload_queue;
+	rd->base.destroy_upload_queue = &destroy_upload_queue;
+	rd->base.upload_texture_1d = &upload_texture_1d;
+	rd->base.upload_texture_2d = &upload_texture_2d;
+	rd->base.upload_texture_3d = &upload_texture_3d;
+	rd->base.upload_cube_map = &upload_cube_map;
+	rd->base.is_upload_complete = &is_upload_complete;
+	rd->base.wait_upload = &wait_upload;
+
 	// Shader functions
 	rd->base.create_shader_stage = &create_shader_stage;
 	rd->base.destroy_shader_stage = &destroy_shader_stage;
@@ -3079,6 +5430,7 @@ static void set_rd_functions(mrl_ogl_330_render_device_t* rd)
 	rd->base.destroy_shader_pipeline = &destroy_shader_pipeline;
 	rd->base.set_shader_pipeline = &set_shader_pipeline;
 	rd->base.get_shader_binding_point = &get_shader_binding_point;
+	rd->base.get_shader_binding_point_by_id = &get_shader_binding_point_by_id;
 
 	// Draw functions
 	rd->base.clear_color = &clear_color;
@@ -3088,15 +5440,24 @@ static void set_rd_functions(mrl_ogl_330_render_device_t* rd)
 	rd->base.draw_triangles_indexed = &draw_triangles_indexed;
 	rd->base.draw_triangles_instanced = &draw_triangles_instanced;
 	rd->base.draw_triangles_indexed_instanced = &draw_triangles_indexed_instanced;
+	rd->base.draw_triangles_indexed_base_vertex = &draw_triangles_indexed_base_vertex;
+	rd->base.draw_triangles_indexed_instanced_base_vertex = &draw_triangles_indexed_instanced_base_vertex;
+	rd->base.multi_draw_triangles = &multi_draw_triangles;
+	rd->base.multi_draw_triangles_indexed = &multi_draw_triangles_indexed;
+	rd->base.draw_triangles_indirect = &draw_triangles_indirect;
+	rd->base.draw_triangles_indexed_indirect = &draw_triangles_indexed_indirect;
 	rd->base.set_viewport = &set_viewport;
 
 	// Getter functions
 	rd->base.get_type_name = &get_type_name;
 	rd->base.get_property_i = &get_property_i;
 	rd->base.get_property_f = &get_property_f;
+	rd->base.get_object_pool_stats = &get_object_pool_stats;
 
 	// Swap buffers
-	if (mgl_str_equal(u8"win32", mgl_get_window_type(rd->window)))
+	if (rd->window == NULL)
+		rd->base.swap_buffers = &swap_offscreen_buffers;
+	else if (mgl_str_equal(u8"win32", mgl_get_window_type(rd->window)))
 	{
 #	ifndef MGL_SYSTEM_WINDOWS
 		mgl_abort();
@@ -3128,6 +5489,16 @@ static void extract_hints(mrl_ogl_330_render_device_t* rd, const mrl_render_devi
 				rd->error_callback = *(const mrl_render_device_hint_error_callback_t*)hint->data;
 				break;
 
+			case MRL_HINT_RENDER_DEVICE_OFFSCREEN_SIZE:
+				MGL_DEBUG_ASSERT(hint->data != NULL);
+				rd->offscreen.width = ((const mgl_u32_t*)hint->data)[0];
+				rd->offscreen.height = ((const mgl_u32_t*)hint->data)[1];
+				break;
+
+			case MRL_HINT_RENDER_DEVICE_DEBUG:
+				rd->debug = MGL_TRUE;
+				break;
+
 			default:
 				// Unsupported hint type, ignore it
 				continue;
@@ -3135,9 +5506,215 @@ static void extract_hints(mrl_ogl_330_render_device_t* rd, const mrl_render_devi
 	}
 }
 
+static mrl_error_t create_offscreen_framebuffer(mrl_ogl_330_render_device_t* rd)
+{
+	// Create color and depth/stencil storage
+	glGenRenderbuffers(1, &rd->offscreen.color_rbo);
+	glBindRenderbuffer(GL_RENDERBUFFER, rd->offscreen.color_rbo);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, (GLsizei)rd->offscreen.width, (GLsizei)rd->offscreen.height);
+
+	glGenRenderbuffers(1, &rd->offscreen.depth_stencil_rbo);
+	glBindRenderbuffer(GL_RENDERBUFFER, rd->offscreen.depth_stencil_rbo);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, (GLsizei)rd->offscreen.width, (GLsizei)rd->offscreen.height);
+
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	// Create framebuffer
+	glGenFramebuffers(1, &rd->offscreen.fbo);
+	glBindFramebuffer(GL_FRAMEBUFFER, rd->offscreen.fbo);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, rd->offscreen.color_rbo);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, rd->offscreen.depth_stencil_rbo);
+
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glDeleteFramebuffers(1, &rd->offscreen.fbo);
+		glDeleteRenderbuffers(1, &rd->offscreen.color_rbo);
+		glDeleteRenderbuffers(1, &rd->offscreen.depth_stencil_rbo);
+		rd->offscreen.fbo = 0;
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_EXTERNAL, u8"Failed to create offscreen framebuffer: glCheckFramebufferStatus didn't return GL_FRAMEBUFFER_COMPLETE");
+		return MRL_ERROR_EXTERNAL;
+	}
+
+	glViewport(0, 0, (GLsizei)rd->offscreen.width, (GLsizei)rd->offscreen.height);
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_offscreen_framebuffer(mrl_ogl_330_render_device_t* rd)
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glDeleteFramebuffers(1, &rd->offscreen.fbo);
+	glDeleteRenderbuffers(1, &rd->offscreen.color_rbo);
+	glDeleteRenderbuffers(1, &rd->offscreen.depth_stencil_rbo);
+	rd->offscreen.fbo = 0;
+}
+
+#	ifndef MGL_SYSTEM_WINDOWS
+static mgl_bool_t has_egl_extension(const char* extensions, const mgl_chr8_t* name)
+{
+	if (extensions == NULL)
+		return MGL_FALSE;
+
+	// Search for the name in the space separated extension list
+	mgl_u64_t name_size = mgl_str_size(name);
+	for (const char* it = extensions; *it != '\0';)
+	{
+		mgl_u64_t ext_size = 0;
+		while (it[ext_size] != ' ' && it[ext_size] != '\0')
+			++ext_size;
+		if (ext_size == name_size && mgl_mem_equal(it, name, name_size))
+			return MGL_TRUE;
+		it += ext_size;
+		while (*it == ' ')
+			++it;
+	}
+
+	return MGL_FALSE;
+}
+
+static mrl_error_t create_egl_context(mrl_ogl_330_render_device_t* rd, const mrl_render_device_desc_t* desc)
+{
+	// Get display, prefer the surfaceless platform so no display server is required
+	rd->egl.display = EGL_NO_DISPLAY;
+	if (has_egl_extension(eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS), u8"EGL_MESA_platform_surfaceless"))
+	{
+		PFNEGLGETPLATFORMDISPLAYEXTPROC get_platform_display = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+		if (get_platform_display != NULL)
+			rd->egl.display = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+	}
+	if (rd->egl.display == EGL_NO_DISPLAY)
+		rd->egl.display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+	if (rd->egl.display == EGL_NO_DISPLAY)
+		return MRL_ERROR_EXTERNAL;
+
+	EGLint major, minor;
+	if (!eglInitialize(rd->egl.display, &major, &minor))
+		return MRL_ERROR_EXTERNAL;
+
+	if (!eglBindAPI(EGL_OPENGL_API))
+	{
+		eglTerminate(rd->egl.display);
+		return MRL_ERROR_UNSUPPORTED_DEVICE;
+	}
+
+	// Choose config, pbuffers are only needed when surfaceless contexts aren't supported
+	mgl_bool_t surfaceless = has_egl_extension(eglQueryString(rd->egl.display, EGL_EXTENSIONS), u8"EGL_KHR_surfaceless_context");
+
+	EGLint config_attribs[] =
+	{
+		EGL_SURFACE_TYPE, surfaceless ? 0 : EGL_PBUFFER_BIT,
+		EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+		EGL_RED_SIZE, 8,
+		EGL_GREEN_SIZE, 8,
+		EGL_BLUE_SIZE, 8,
+		EGL_ALPHA_SIZE, 8,
+		EGL_NONE,
+	};
+
+	EGLConfig config;
+	EGLint config_count = 0;
+	if (!eglChooseConfig(rd->egl.display, config_attribs, &config, 1, &config_count) || config_count == 0)
+	{
+		eglTerminate(rd->egl.display);
+		return MRL_ERROR_UNSUPPORTED_DEVICE;
+	}
+
+	// Create context
+	EGLint context_attribs[] =
+	{
+		EGL_CONTEXT_MAJOR_VERSION, 3,
+		EGL_CONTEXT_MINOR_VERSION, 3,
+		EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+		EGL_NONE,
+	};
+
+	rd->egl.context = eglCreateContext(rd->egl.display, config, EGL_NO_CONTEXT, context_attribs);
+	if (rd->egl.context == EGL_NO_CONTEXT)
+	{
+		eglTerminate(rd->egl.display);
+		return MRL_ERROR_UNSUPPORTED_DEVICE;
+	}
+
+	// Create surface
+	rd->egl.surface = EGL_NO_SURFACE;
+	if (!surfaceless)
+	{
+		EGLint pbuffer_attribs[] =
+		{
+			EGL_WIDTH, 1,
+			EGL_HEIGHT, 1,
+			EGL_NONE,
+		};
+
+		rd->egl.surface = eglCreatePbufferSurface(rd->egl.display, config, pbuffer_attribs);
+		if (rd->egl.surface == EGL_NO_SURFACE)
+		{
+			eglDestroyContext(rd->egl.display, rd->egl.context);
+			eglTerminate(rd->egl.display);
+			return MRL_ERROR_EXTERNAL;
+		}
+	}
+
+	if (!eglMakeCurrent(rd->egl.display, rd->egl.surface, rd->egl.surface, rd->egl.context))
+	{
+		if (rd->egl.surface != EGL_NO_SURFACE)
+			eglDestroySurface(rd->egl.display, rd->egl.surface);
+		eglDestroyContext(rd->egl.display, rd->egl.context);
+		eglTerminate(rd->egl.display);
+		return MRL_ERROR_EXTERNAL;
+	}
+
+	// GLEW reports a missing GLX display even though the GL entry points were loaded
+	glewExperimental = GL_TRUE;
+	GLenum glew_err = glewInit();
+	if (glew_err != GLEW_OK && glew_err != GLEW_ERROR_NO_GLX_DISPLAY)
+	{
+		eglMakeCurrent(rd->egl.display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+		if (rd->egl.surface != EGL_NO_SURFACE)
+			eglDestroySurface(rd->egl.display, rd->egl.surface);
+		eglDestroyContext(rd->egl.display, rd->egl.context);
+		eglTerminate(rd->egl.display);
+		return MRL_ERROR_EXTERNAL;
+	}
+	glGetError(); // Clear errors caused by glewInit on core contexts
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_egl_context(mrl_ogl_330_render_device_t* rd)
+{
+	eglMakeCurrent(rd->egl.display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+	if (rd->egl.surface != EGL_NO_SURFACE)
+		eglDestroySurface(rd->egl.display, rd->egl.surface);
+	eglDestroyContext(rd->egl.display, rd->egl.context);
+	eglTerminate(rd->egl.display);
+}
+#	endif
+
 static mrl_error_t create_gl_context(mrl_ogl_330_render_device_t* rd, const mrl_render_device_desc_t* desc)
 {
-	if (mgl_str_equal(u8"win32", mgl_get_window_type(rd->window)))
+	if (rd->window == NULL)
+	{
+#	ifdef MGL_SYSTEM_WINDOWS
+		return MRL_ERROR_UNSUPPORTED_WINDOW;
+#	else
+		mrl_error_t err = create_egl_context(rd, desc);
+		if (err != MRL_ERROR_NONE)
+			return err;
+
+		err = create_offscreen_framebuffer(rd);
+		if (err != MRL_ERROR_NONE)
+		{
+			destroy_egl_context(rd);
+			return err;
+		}
+
+		return MRL_ERROR_NONE;
+#	endif
+	}
+	else if (mgl_str_equal(u8"win32", mgl_get_window_type(rd->window)))
 	{
 #	ifndef MGL_SYSTEM_WINDOWS
 		return MRL_ERROR_UNSUPPORTED_WINDOW;
@@ -3205,7 +5782,16 @@ static mrl_error_t create_gl_context(mrl_ogl_330_render_device_t* rd, const mrl_
 
 static void destroy_gl_context(mrl_ogl_330_render_device_t* rd)
 {
-	if (mgl_str_equal(u8"win32", mgl_get_window_type(rd->window)))
+	if (rd->window == NULL)
+	{
+#	ifdef MGL_SYSTEM_WINDOWS
+		mgl_abort();
+#	else
+		destroy_offscreen_framebuffer(rd);
+		destroy_egl_context(rd);
+#	endif
+	}
+	else if (mgl_str_equal(u8"win32", mgl_get_window_type(rd->window)))
 	{
 #	ifndef MGL_SYSTEM_WINDOWS
 		mgl_abort();
@@ -3222,7 +5808,7 @@ static void destroy_gl_context(mrl_ogl_330_render_device_t* rd)
 MRL_API mrl_error_t mrl_init_ogl_330_render_device(const mrl_render_device_desc_t* desc, mrl_render_device_t ** out_rd)
 {
 	MGL_DEBUG_ASSERT(desc != NULL && out_rd != NULL);
-	MGL_DEBUG_ASSERT(desc->allocator != NULL && desc->window != NULL);
+	MGL_DEBUG_ASSERT(desc->allocator != NULL);
 
 #ifndef MRL_BUILD_OGL_330
 	return MRL_ERROR_UNSUPPORTED_DEVICE;
@@ -3236,6 +5822,14 @@ MRL_API mrl_error_t mrl_init_ogl_330_render_device(const mrl_render_device_desc_
 
 	rd->allocator = desc->allocator;
 	rd->window = desc->window;
+	rd->error_callback = NULL;
+	rd->warning_callback = NULL;
+	rd->debug = MGL_FALSE;
+	rd->offscreen.fbo = 0;
+	rd->offscreen.color_rbo = 0;
+	rd->offscreen.depth_stencil_rbo = 0;
+	rd->offscreen.width = 1280;
+	rd->offscreen.height = 720;
 
 	// Extract hints
 	extract_hints(rd, desc);
@@ -3259,6 +5853,27 @@ MRL_API mrl_error_t mrl_init_ogl_330_render_device(const mrl_render_device_desc_
 
 	glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
 
+	// Route driver messages to the error and warning callbacks
+	enable_debug_output(rd);
+
+	// Query limits
+	rd->limits.uniform_buffer_offset_alignment = 256;
+	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &rd->limits.uniform_buffer_offset_alignment);
+	if (rd->limits.uniform_buffer_offset_alignment < 1)
+		rd->limits.uniform_buffer_offset_alignment = 1;
+	rd->limits.max_texture_units = 16;
+	glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &rd->limits.max_texture_units);
+	rd->limits.draw_indirect = GLEW_ARB_draw_indirect ? MGL_TRUE : MGL_FALSE;
+	rd->limits.multi_draw_indirect = rd->limits.draw_indirect && GLEW_ARB_multi_draw_indirect ? MGL_TRUE : MGL_FALSE;
+	rd->limits.texture_storage = GLEW_ARB_texture_storage ? MGL_TRUE : MGL_FALSE;
+	rd->limits.texture_cube_map_array = GLEW_ARB_texture_cube_map_array ? MGL_TRUE : MGL_FALSE;
+	rd->limits.texture_compression_s3tc = GLEW_EXT_texture_compression_s3tc ? MGL_TRUE : MGL_FALSE;
+	rd->limits.texture_compression_bptc = GLEW_ARB_texture_compression_bptc ? MGL_TRUE : MGL_FALSE;
+	rd->limits.texture_compression_etc2 = GLEW_ARB_ES3_compatibility ? MGL_TRUE : MGL_FALSE;
+
+	// Nothing is known about the context state yet
+	invalidate_state_cache(rd);
+
 	// Set render device funcs
 	set_rd_functions(rd);
 
@@ -3289,6 +5904,10 @@ MRL_API void mrl_terminate_ogl_330_render_device(mrl_render_device_t * brd)
 #else
 	mrl_ogl_330_render_device_t* rd = (mrl_ogl_330_render_device_t*)brd;
 
+	// Report the last debug messages
+	flush_debug_messages(rd);
+	disable_debug_output(rd);
+
 	// Terminate context
 	destroy_gl_context(rd);
 
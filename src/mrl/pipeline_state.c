@@ -0,0 +1,448 @@
+#include <mrl/pipeline_state.h>
+#include <mrl/object_pool.h>
+
+#include <mgl/memory/allocator.h>
+#include <mgl/memory/manipulation.h>
+
+// States which make up a pipeline state, in the order they are set
+enum
+{
+	MRL_PIPELINE_STATE_PART_RASTER,
+	MRL_PIPELINE_STATE_PART_DEPTH_STENCIL,
+	MRL_PIPELINE_STATE_PART_BLEND,
+	MRL_PIPELINE_STATE_PART_SHADER_PIPELINE,
+	MRL_PIPELINE_STATE_PART_VERTEX_ARRAY,
+	MRL_PIPELINE_STATE_PART_COUNT,
+};
+
+// Descriptions are copied field by field into zeroed memory, so that padding and unused
+// array elements don't affect their hashes and comparisons
+typedef union
+{
+	mrl_raster_state_desc_t raster;
+	mrl_depth_stencil_state_desc_t depth_stencil;
+	mrl_blend_state_desc_t blend;
+	mrl_shader_pipeline_desc_t shader_pipeline;
+	mrl_vertex_array_desc_t vertex_array;
+} mrl_pipeline_state_part_desc_t;
+
+typedef struct mrl_pipeline_state_part_t mrl_pipeline_state_part_t;
+
+struct mrl_pipeline_state_part_t
+{
+	mrl_pipeline_state_part_t* next;
+	mgl_u64_t hash;
+	mgl_u64_t ref_count;
+	mgl_enum_t type;
+	void* handle;
+	mrl_pipeline_state_part_desc_t desc;
+};
+
+typedef struct mrl_pipeline_state_obj_t mrl_pipeline_state_obj_t;
+
+struct mrl_pipeline_state_obj_t
+{
+	mrl_pipeline_state_obj_t* next;
+	mgl_u64_t hash;
+	mgl_u64_t ref_count;
+
+	// Parts are deduplicated, so two pipeline states are equal if their parts are the same.
+	// The vertex array part is NULL when the pipeline state has no vertex array.
+	mrl_pipeline_state_part_t* parts[MRL_PIPELINE_STATE_PART_COUNT];
+};
+
+typedef struct
+{
+	void* allocator;
+	mgl_u64_t bucket_mask;
+	mrl_pipeline_state_part_t** part_buckets;
+	mrl_pipeline_state_obj_t** pso_buckets;
+	mrl_object_pool_t part_pool;
+	mrl_object_pool_t pso_pool;
+
+	// Last pipeline state set through the cache
+	mrl_pipeline_state_obj_t* applied;
+} mrl_pipeline_state_cache_obj_t;
+
+// ---------- Hashing ----------
+
+// 64 bit FNV-1a
+static mgl_u64_t hash_bytes(mgl_u64_t hash, const void* data, mgl_u64_t size)
+{
+	const mgl_u8_t* bytes = (const mgl_u8_t*)data;
+	for (mgl_u64_t i = 0; i < size; ++i)
+	{
+		hash ^= bytes[i];
+		hash *= 0x100000001B3;
+	}
+	return hash;
+}
+
+#define MRL_PIPELINE_STATE_HASH_SEED 0xCBF29CE484222325
+
+static void canonicalize_part_desc(mgl_enum_t type, const mrl_pipeline_state_desc_t* src, mrl_shader_pipeline_t* pipeline, mrl_pipeline_state_part_desc_t* dst)
+{
+	mgl_mem_set(dst, sizeof(*dst), 0);
+
+	switch (type)
+	{
+		case MRL_PIPELINE_STATE_PART_RASTER:
+			dst->raster.cull_enabled = src->raster.cull_enabled;
+			dst->raster.front_face = src->raster.front_face;
+			dst->raster.cull_face = src->raster.cull_face;
+			dst->raster.raster_mode = src->raster.raster_mode;
+			dst->raster.hints = src->raster.hints;
+			break;
+
+		case MRL_PIPELINE_STATE_PART_DEPTH_STENCIL:
+			dst->depth_stencil.depth.enabled = src->depth_stencil.depth.enabled;
+			dst->depth_stencil.depth.write_enabled = src->depth_stencil.depth.write_enabled;
+			dst->depth_stencil.depth.near = src->depth_stencil.depth.near;
+			dst->depth_stencil.depth.far = src->depth_stencil.depth.far;
+			dst->depth_stencil.depth.compare = src->depth_stencil.depth.compare;
+			dst->depth_stencil.stencil.ref = src->depth_stencil.stencil.ref;
+			dst->depth_stencil.stencil.enabled = src->depth_stencil.stencil.enabled;
+			dst->depth_stencil.stencil.read_mask = src->depth_stencil.stencil.read_mask;
+			dst->depth_stencil.stencil.write_mask = src->depth_stencil.stencil.write_mask;
+			dst->depth_stencil.stencil.front_face.compare = src->depth_stencil.stencil.front_face.compare;
+			dst->depth_stencil.stencil.front_face.fail = src->depth_stencil.stencil.front_face.fail;
+			dst->depth_stencil.stencil.front_face.pass = src->depth_stencil.stencil.front_face.pass;
+			dst->depth_stencil.stencil.front_face.depth_fail = src->depth_stencil.stencil.front_face.depth_fail;
+			dst->depth_stencil.stencil.back_face.compare = src->depth_stencil.stencil.back_face.compare;
+			dst->depth_stencil.stencil.back_face.fail = src->depth_stencil.stencil.back_face.fail;
+			dst->depth_stencil.stencil.back_face.pass = src->depth_stencil.stencil.back_face.pass;
+			dst->depth_stencil.stencil.back_face.depth_fail = src->depth_stencil.stencil.back_face.depth_fail;
+			dst->depth_stencil.hints = src->depth_stencil.hints;
+			break;
+
+		case MRL_PIPELINE_STATE_PART_BLEND:
+			dst->blend.blend_enabled = src->blend.blend_enabled;
+			dst->blend.color.src = src->blend.color.src;
+			dst->blend.color.dst = src->blend.color.dst;
+			dst->blend.color.op = src->blend.color.op;
+			dst->blend.alpha.src = src->blend.alpha.src;
+			dst->blend.alpha.dst = src->blend.alpha.dst;
+			dst->blend.alpha.op = src->blend.alpha.op;
+			dst->blend.hints = src->blend.hints;
+			break;
+
+		case MRL_PIPELINE_STATE_PART_SHADER_PIPELINE:
+			dst->shader_pipeline.vertex = src->shader_pipeline.vertex;
+			dst->shader_pipeline.pixel = src->shader_pipeline.pixel;
+			dst->shader_pipeline.hints = src->shader_pipeline.hints;
+			break;
+
+		case MRL_PIPELINE_STATE_PART_VERTEX_ARRAY:
+		{
+			const mrl_vertex_array_desc_t* va = &src->vertex_array;
+			dst->vertex_array.element_count = va->element_count;
+			dst->vertex_array.buffer_count = va->buffer_count;
+			for (mgl_u32_t i = 0; i < va->element_count && i < MRL_MAX_VERTEX_ARRAY_ELEMENT_COUNT; ++i)
+			{
+				mrl_vertex_element_t* e = &dst->vertex_array.elements[i];
+				e->type = va->elements[i].type;
+				for (mgl_u32_t j = 0; j < MRL_MAX_VERTEX_ELEMENT_NAME_SIZE && va->elements[i].name[j] != '\0'; ++j)
+					e->name[j] = va->elements[i].name[j];
+				e->size = va->elements[i].size;
+				e->buffer.stride = va->elements[i].buffer.stride;
+				e->buffer.offset = va->elements[i].buffer.offset;
+				e->buffer.index = va->elements[i].buffer.index;
+				e->instance_step_rate = va->elements[i].instance_step_rate;
+				e->hints = va->elements[i].hints;
+			}
+			for (mgl_u32_t i = 0; i < va->buffer_count && i < MRL_MAX_VERTEX_ARRAY_BUFFER_COUNT; ++i)
+				dst->vertex_array.buffers[i] = va->buffers[i];
+			dst->vertex_array.shader_pipeline = pipeline;
+			dst->vertex_array.hints = va->hints;
+			break;
+		}
+
+		default:
+			MGL_DEBUG_ASSERT(MGL_FALSE);
+			break;
+	}
+}
+
+// ---------- Parts ----------
+
+static mrl_error_t create_part_object(mrl_render_device_t* rd, mrl_pipeline_state_part_t* part)
+{
+	switch (part->type)
+	{
+		case MRL_PIPELINE_STATE_PART_RASTER: return mrl_create_raster_state(rd, (mrl_raster_state_t**)&part->handle, &part->desc.raster);
+		case MRL_PIPELINE_STATE_PART_DEPTH_STENCIL: return mrl_create_depth_stencil_state(rd, (mrl_depth_stencil_state_t**)&part->handle, &part->desc.depth_stencil);
+		case MRL_PIPELINE_STATE_PART_BLEND: return mrl_create_blend_state(rd, (mrl_blend_state_t**)&part->handle, &part->desc.blend);
+		case MRL_PIPELINE_STATE_PART_SHADER_PIPELINE: return mrl_create_shader_pipeline(rd, (mrl_shader_pipeline_t**)&part->handle, &part->desc.shader_pipeline);
+		case MRL_PIPELINE_STATE_PART_VERTEX_ARRAY: return mrl_create_vertex_array(rd, (mrl_vertex_array_t**)&part->handle, &part->desc.vertex_array);
+		default: MGL_DEBUG_ASSERT(MGL_FALSE); return MRL_ERROR_INVALID_PARAMS;
+	}
+}
+
+static void destroy_part_object(mrl_render_device_t* rd, mrl_pipeline_state_part_t* part)
+{
+	switch (part->type)
+	{
+		case MRL_PIPELINE_STATE_PART_RASTER: mrl_destroy_raster_state(rd, part->handle); break;
+		case MRL_PIPELINE_STATE_PART_DEPTH_STENCIL: mrl_destroy_depth_stencil_state(rd, part->handle); break;
+		case MRL_PIPELINE_STATE_PART_BLEND: mrl_destroy_blend_state(rd, part->handle); break;
+		case MRL_PIPELINE_STATE_PART_SHADER_PIPELINE: mrl_destroy_shader_pipeline(rd, part->handle); break;
+		case MRL_PIPELINE_STATE_PART_VERTEX_ARRAY: mrl_destroy_vertex_array(rd, part->handle); break;
+		default: MGL_DEBUG_ASSERT(MGL_FALSE); break;
+	}
+}
+
+static void set_part_object(mrl_render_device_t* rd, const mrl_pipeline_state_part_t* part)
+{
+	switch (part->type)
+	{
+		case MRL_PIPELINE_STATE_PART_RASTER: mrl_set_raster_state(rd, part->handle); break;
+		case MRL_PIPELINE_STATE_PART_DEPTH_STENCIL: mrl_set_depth_stencil_state(rd, part->handle); break;
+		case MRL_PIPELINE_STATE_PART_BLEND: mrl_set_blend_state(rd, part->handle); break;
+		case MRL_PIPELINE_STATE_PART_SHADER_PIPELINE: mrl_set_shader_pipeline(rd, part->handle); break;
+		case MRL_PIPELINE_STATE_PART_VERTEX_ARRAY: mrl_set_vertex_array(rd, part->handle); break;
+		default: MGL_DEBUG_ASSERT(MGL_FALSE); break;
+	}
+}
+
+// Gets a reference to the part with the given description, creating it if it doesn't exist yet
+static mrl_error_t acquire_part(mrl_render_device_t* rd, mrl_pipeline_state_cache_obj_t* obj, mgl_enum_t type, const mrl_pipeline_state_part_desc_t* desc, mrl_pipeline_state_part_t** out)
+{
+	mgl_u64_t hash = hash_bytes(hash_bytes(MRL_PIPELINE_STATE_HASH_SEED, &type, sizeof(type)), desc, sizeof(*desc));
+	mrl_pipeline_state_part_t** bucket = &obj->part_buckets[hash & obj->bucket_mask];
+
+	// Search for an existing part
+	for (mrl_pipeline_state_part_t* part = *bucket; part != NULL; part = part->next)
+		if (part->hash == hash && part->type == type && mgl_mem_equal(&part->desc, desc, sizeof(*desc)))
+		{
+			part->ref_count += 1;
+			*out = part;
+			return MRL_ERROR_NONE;
+		}
+
+	// Create a new one
+	mrl_pipeline_state_part_t* part;
+	mgl_error_t mglerr = mrl_allocate_object(&obj->part_pool, (void**)&part);
+	if (mglerr != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(mglerr);
+
+	part->hash = hash;
+	part->ref_count = 1;
+	part->type = type;
+	mgl_mem_copy(&part->desc, desc, sizeof(*desc));
+
+	mrl_error_t err = create_part_object(rd, part);
+	if (err != MRL_ERROR_NONE)
+	{
+		mrl_deallocate_object(&obj->part_pool, part);
+		return err;
+	}
+
+	part->next = *bucket;
+	*bucket = part;
+	*out = part;
+
+	return MRL_ERROR_NONE;
+}
+
+static void release_part(mrl_render_device_t* rd, mrl_pipeline_state_cache_obj_t* obj, mrl_pipeline_state_part_t* part)
+{
+	if (--part->ref_count > 0)
+		return;
+
+	// Remove it from its bucket
+	mrl_pipeline_state_part_t** it = &obj->part_buckets[part->hash & obj->bucket_mask];
+	while (*it != part)
+		it = &(*it)->next;
+	*it = part->next;
+
+	destroy_part_object(rd, part);
+	mrl_deallocate_object(&obj->part_pool, part);
+}
+
+// ---------- Pipeline state cache ----------
+
+MRL_API mrl_error_t mrl_create_pipeline_state_cache(mrl_render_device_t* rd, const mrl_pipeline_state_cache_desc_t* desc, mrl_pipeline_state_cache_t** cache)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && desc != NULL && cache != NULL);
+	MGL_DEBUG_ASSERT(desc->allocator != NULL);
+	MGL_DEBUG_ASSERT(desc->bucket_count > 0 && (desc->bucket_count & (desc->bucket_count - 1)) == 0);
+
+	// Allocate object
+	mrl_pipeline_state_cache_obj_t* obj;
+	mgl_error_t mglerr = mgl_allocate(desc->allocator, sizeof(*obj), (void**)&obj);
+	if (mglerr != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(mglerr);
+
+	obj->allocator = desc->allocator;
+	obj->bucket_mask = desc->bucket_count - 1;
+	obj->applied = NULL;
+
+	// Allocate hash tables
+	mglerr = mgl_allocate(obj->allocator, 2 * desc->bucket_count * sizeof(void*), (void**)&obj->part_buckets);
+	if (mglerr != MGL_ERROR_NONE)
+	{
+		mgl_deallocate(obj->allocator, obj);
+		return mrl_make_mgl_error(mglerr);
+	}
+	obj->pso_buckets = (mrl_pipeline_state_obj_t**)(obj->part_buckets + desc->bucket_count);
+	for (mgl_u64_t i = 0; i < desc->bucket_count; ++i)
+	{
+		obj->part_buckets[i] = NULL;
+		obj->pso_buckets[i] = NULL;
+	}
+
+	// Create pools
+	mglerr = mrl_init_object_pool(&obj->part_pool, obj->allocator, sizeof(mrl_pipeline_state_part_t), 0);
+	if (mglerr == MGL_ERROR_NONE)
+	{
+		mglerr = mrl_init_object_pool(&obj->pso_pool, obj->allocator, sizeof(mrl_pipeline_state_obj_t), 0);
+		if (mglerr != MGL_ERROR_NONE)
+			mrl_terminate_object_pool(&obj->part_pool);
+	}
+	if (mglerr != MGL_ERROR_NONE)
+	{
+		mgl_deallocate(obj->allocator, obj->part_buckets);
+		mgl_deallocate(obj->allocator, obj);
+		return mrl_make_mgl_error(mglerr);
+	}
+
+	*cache = (mrl_pipeline_state_cache_t*)obj;
+
+	return MRL_ERROR_NONE;
+}
+
+MRL_API void mrl_destroy_pipeline_state_cache(mrl_render_device_t* rd, mrl_pipeline_state_cache_t* cache)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && cache != NULL);
+	mrl_pipeline_state_cache_obj_t* obj = (mrl_pipeline_state_cache_obj_t*)cache;
+
+	// Destroy the pipeline states which are still alive, which releases their parts
+	for (mgl_u64_t i = 0; i <= obj->bucket_mask; ++i)
+		while (obj->pso_buckets[i] != NULL)
+		{
+			mrl_pipeline_state_obj_t* pso = obj->pso_buckets[i];
+			pso->ref_count = 1;
+			mrl_destroy_pipeline_state(rd, cache, pso);
+		}
+
+	mrl_terminate_object_pool(&obj->pso_pool);
+	mrl_terminate_object_pool(&obj->part_pool);
+	mgl_deallocate(obj->allocator, obj->part_buckets);
+	mgl_deallocate(obj->allocator, obj);
+}
+
+MRL_API mrl_error_t mrl_create_pipeline_state(mrl_render_device_t* rd, mrl_pipeline_state_cache_t* cache, mrl_pipeline_state_t** pso, const mrl_pipeline_state_desc_t* desc)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && cache != NULL && pso != NULL && desc != NULL);
+	mrl_pipeline_state_cache_obj_t* obj = (mrl_pipeline_state_cache_obj_t*)cache;
+
+	// Get the parts, in order, since the vertex array depends on the shader pipeline
+	mrl_pipeline_state_part_t* parts[MRL_PIPELINE_STATE_PART_COUNT] = { NULL };
+	mgl_enum_t part_count = MRL_PIPELINE_STATE_PART_COUNT;
+	if (desc->vertex_array.element_count == 0 && desc->vertex_array.buffer_count == 0)
+		part_count = MRL_PIPELINE_STATE_PART_VERTEX_ARRAY;
+
+	for (mgl_enum_t i = 0; i < part_count; ++i)
+	{
+		mrl_pipeline_state_part_desc_t part_desc;
+		mrl_shader_pipeline_t* pipeline = i == MRL_PIPELINE_STATE_PART_VERTEX_ARRAY ? parts[MRL_PIPELINE_STATE_PART_SHADER_PIPELINE]->handle : NULL;
+		canonicalize_part_desc(i, desc, pipeline, &part_desc);
+		mrl_error_t err = acquire_part(rd, obj, i, &part_desc, &parts[i]);
+		if (err != MRL_ERROR_NONE)
+		{
+			while (i-- > 0)
+				release_part(rd, obj, parts[i]);
+			return err;
+		}
+	}
+
+	mgl_u64_t hash = hash_bytes(MRL_PIPELINE_STATE_HASH_SEED, parts, sizeof(parts));
+	mrl_pipeline_state_obj_t** bucket = &obj->pso_buckets[hash & obj->bucket_mask];
+
+	// Search for an existing pipeline state, which already holds references to the parts
+	for (mrl_pipeline_state_obj_t* it = *bucket; it != NULL; it = it->next)
+		if (it->hash == hash && mgl_mem_equal(it->parts, parts, sizeof(parts)))
+		{
+			for (mgl_enum_t i = 0; i < part_count; ++i)
+				release_part(rd, obj, parts[i]);
+			it->ref_count += 1;
+			*pso = it;
+			return MRL_ERROR_NONE;
+		}
+
+	// Create a new one
+	mrl_pipeline_state_obj_t* new_pso;
+	mgl_error_t mglerr = mrl_allocate_object(&obj->pso_pool, (void**)&new_pso);
+	if (mglerr != MGL_ERROR_NONE)
+	{
+		for (mgl_enum_t i = 0; i < part_count; ++i)
+			release_part(rd, obj, parts[i]);
+		return mrl_make_mgl_error(mglerr);
+	}
+
+	new_pso->hash = hash;
+	new_pso->ref_count = 1;
+	mgl_mem_copy(new_pso->parts, parts, sizeof(parts));
+	new_pso->next = *bucket;
+	*bucket = new_pso;
+	*pso = new_pso;
+
+	return MRL_ERROR_NONE;
+}
+
+MRL_API void mrl_destroy_pipeline_state(mrl_render_device_t* rd, mrl_pipeline_state_cache_t* cache, mrl_pipeline_state_t* pso)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && cache != NULL && pso != NULL);
+	mrl_pipeline_state_cache_obj_t* obj = (mrl_pipeline_state_cache_obj_t*)cache;
+	mrl_pipeline_state_obj_t* pso_obj = (mrl_pipeline_state_obj_t*)pso;
+
+	MGL_DEBUG_ASSERT(pso_obj->ref_count > 0);
+	if (--pso_obj->ref_count > 0)
+		return;
+
+	// Remove it from its bucket
+	mrl_pipeline_state_obj_t** it = &obj->pso_buckets[pso_obj->hash & obj->bucket_mask];
+	while (*it != pso_obj)
+		it = &(*it)->next;
+	*it = pso_obj->next;
+
+	// The states may still be set on the render device, so the next pipeline state must be set in full
+	if (obj->applied == pso_obj)
+		obj->applied = NULL;
+
+	// Release the parts in reverse order, so that the vertex array is destroyed before its shader pipeline
+	for (mgl_enum_t i = MRL_PIPELINE_STATE_PART_COUNT; i-- > 0;)
+		if (pso_obj->parts[i] != NULL)
+			release_part(rd, obj, pso_obj->parts[i]);
+
+	mrl_deallocate_object(&obj->pso_pool, pso_obj);
+}
+
+MRL_API void mrl_set_pipeline_state(mrl_render_device_t* rd, mrl_pipeline_state_cache_t* cache, mrl_pipeline_state_t* pso)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && cache != NULL && pso != NULL);
+	mrl_pipeline_state_cache_obj_t* obj = (mrl_pipeline_state_cache_obj_t*)cache;
+	mrl_pipeline_state_obj_t* pso_obj = (mrl_pipeline_state_obj_t*)pso;
+
+	if (obj->applied == pso_obj)
+		return;
+
+	// Only set the parts which changed
+	for (mgl_enum_t i = 0; i < MRL_PIPELINE_STATE_PART_COUNT; ++i)
+		if (pso_obj->parts[i] != NULL && (obj->applied == NULL || obj->applied->parts[i] != pso_obj->parts[i]))
+			set_part_object(rd, pso_obj->parts[i]);
+
+	obj->applied = pso_obj;
+}
+
+MRL_API void mrl_invalidate_pipeline_state(mrl_pipeline_state_cache_t* cache)
+{
+	MGL_DEBUG_ASSERT(cache != NULL);
+	((mrl_pipeline_state_cache_obj_t*)cache)->applied = NULL;
+}
+
+MRL_API mrl_shader_pipeline_t* mrl_get_pipeline_state_shader_pipeline(mrl_pipeline_state_t* pso)
+{
+	MGL_DEBUG_ASSERT(pso != NULL);
+	return ((mrl_pipeline_state_obj_t*)pso)->parts[MRL_PIPELINE_STATE_PART_SHADER_PIPELINE]->handle;
+}
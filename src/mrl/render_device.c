@@ -211,6 +211,66 @@ MRL_API mrl_error_t mrl_update_cube_map(mrl_render_device_t * rd, mrl_cube_map_t
 	return rd->update_cube_map(rd, cb, desc);
 }
 
+MRL_API mrl_error_t mrl_create_texture_2d_array(mrl_render_device_t * rd, mrl_texture_2d_array_t ** tex, const mrl_texture_2d_array_desc_t * desc)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && tex != NULL && desc != NULL);
+	return rd->create_texture_2d_array(rd, tex, desc);
+}
+
+MRL_API void mrl_destroy_texture_2d_array(mrl_render_device_t * rd, mrl_texture_2d_array_t * tex)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && tex != NULL);
+	rd->destroy_texture_2d_array(rd, tex);
+}
+
+MRL_API void mrl_generate_texture_2d_array_mipmaps(mrl_render_device_t * rd, mrl_texture_2d_array_t * tex)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && tex != NULL);
+	rd->generate_texture_2d_array_mipmaps(rd, tex);
+}
+
+MRL_API void mrl_bind_texture_2d_array(mrl_render_device_t * rd, mrl_shader_binding_point_t * bp, mrl_texture_2d_array_t * tex)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && bp != NULL);
+	rd->bind_texture_2d_array(rd, bp, tex);
+}
+
+MRL_API mrl_error_t mrl_update_texture_2d_array(mrl_render_device_t * rd, mrl_texture_2d_array_t * tex, const mrl_texture_2d_array_update_desc_t * desc)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && tex != NULL && desc != NULL);
+	return rd->update_texture_2d_array(rd, tex, desc);
+}
+
+MRL_API mrl_error_t mrl_create_cube_map_array(mrl_render_device_t * rd, mrl_cube_map_array_t ** tex, const mrl_cube_map_array_desc_t * desc)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && tex != NULL && desc != NULL);
+	return rd->create_cube_map_array(rd, tex, desc);
+}
+
+MRL_API void mrl_destroy_cube_map_array(mrl_render_device_t * rd, mrl_cube_map_array_t * tex)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && tex != NULL);
+	rd->destroy_cube_map_array(rd, tex);
+}
+
+MRL_API void mrl_generate_cube_map_array_mipmaps(mrl_render_device_t * rd, mrl_cube_map_array_t * tex)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && tex != NULL);
+	rd->generate_cube_map_array_mipmaps(rd, tex);
+}
+
+MRL_API void mrl_bind_cube_map_array(mrl_render_device_t * rd, mrl_shader_binding_point_t * bp, mrl_cube_map_array_t * tex)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && bp != NULL);
+	rd->bind_cube_map_array(rd, bp, tex);
+}
+
+MRL_API mrl_error_t mrl_update_cube_map_array(mrl_render_device_t * rd, mrl_cube_map_array_t * tex, const mrl_cube_map_array_update_desc_t * desc)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && tex != NULL && desc != NULL);
+	return rd->update_cube_map_array(rd, tex, desc);
+}
+
 MRL_API mrl_error_t mrl_create_constant_buffer(mrl_render_device_t * rd, mrl_constant_buffer_t ** cb, const mrl_constant_buffer_desc_t * desc)
 {
 	MGL_DEBUG_ASSERT(rd != NULL && cb != NULL && desc != NULL);
@@ -229,6 +289,12 @@ MRL_API void mrl_bind_constant_buffer(mrl_render_device_t * rd, mrl_shader_bindi
 	rd->bind_constant_buffer(rd, bp, cb);
 }
 
+MRL_API void mrl_bind_constant_buffer_range(mrl_render_device_t * rd, mrl_shader_binding_point_t * bp, mrl_constant_buffer_t * cb, mgl_u64_t offset, mgl_u64_t size)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && bp != NULL && cb != NULL && size > 0);
+	rd->bind_constant_buffer_range(rd, bp, cb, offset, size);
+}
+
 MRL_API void * mrl_map_constant_buffer(mrl_render_device_t * rd, mrl_constant_buffer_t * cb)
 {
 	MGL_DEBUG_ASSERT(rd != NULL && cb != NULL);
@@ -241,6 +307,18 @@ MRL_API void mrl_unmap_constant_buffer(mrl_render_device_t * rd, mrl_constant_bu
 	rd->unmap_constant_buffer(rd, cb);
 }
 
+MRL_API void * mrl_map_constant_buffer_range(mrl_render_device_t * rd, mrl_constant_buffer_t * cb, mgl_u64_t offset, mgl_u64_t size, mgl_u32_t flags)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && cb != NULL && size > 0);
+	return rd->map_constant_buffer_range(rd, cb, offset, size, flags);
+}
+
+MRL_API void mrl_flush_constant_buffer_range(mrl_render_device_t * rd, mrl_constant_buffer_t * cb, mgl_u64_t offset, mgl_u64_t size)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && cb != NULL);
+	rd->flush_constant_buffer_range(rd, cb, offset, size);
+}
+
 MRL_API void mrl_update_constant_buffer(mrl_render_device_t * rd, mrl_constant_buffer_t * cb, mgl_u64_t offset, mgl_u64_t size, const void * data)
 {
 	MGL_DEBUG_ASSERT(rd != NULL && cb != NULL && data != NULL);
@@ -283,12 +361,42 @@ MRL_API void mrl_unmap_index_buffer(mrl_render_device_t * rd, mrl_index_buffer_t
 	rd->unmap_index_buffer(rd, ib);
 }
 
+MRL_API void * mrl_map_index_buffer_range(mrl_render_device_t * rd, mrl_index_buffer_t * ib, mgl_u64_t offset, mgl_u64_t size, mgl_u32_t flags)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && ib != NULL && size > 0);
+	return rd->map_index_buffer_range(rd, ib, offset, size, flags);
+}
+
+MRL_API void mrl_flush_index_buffer_range(mrl_render_device_t * rd, mrl_index_buffer_t * ib, mgl_u64_t offset, mgl_u64_t size)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && ib != NULL);
+	rd->flush_index_buffer_range(rd, ib, offset, size);
+}
+
 MRL_API void mrl_update_index_buffer(mrl_render_device_t * rd, mrl_index_buffer_t * ib, mgl_u64_t offset, mgl_u64_t size, const void * data)
 {
 	MGL_DEBUG_ASSERT(rd != NULL && ib != NULL && data != NULL);
 	rd->update_index_buffer(rd, ib, offset, size, data);
 }
 
+MRL_API mrl_error_t mrl_create_indirect_buffer(mrl_render_device_t * rd, mrl_indirect_buffer_t ** ib, const mrl_indirect_buffer_desc_t * desc)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && ib != NULL && desc != NULL);
+	return rd->create_indirect_buffer(rd, ib, desc);
+}
+
+MRL_API void mrl_destroy_indirect_buffer(mrl_render_device_t * rd, mrl_indirect_buffer_t * ib)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && ib != NULL);
+	rd->destroy_indirect_buffer(rd, ib);
+}
+
+MRL_API void mrl_update_indirect_buffer(mrl_render_device_t * rd, mrl_indirect_buffer_t * ib, mgl_u64_t offset, mgl_u64_t size, const void * data)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && ib != NULL && data != NULL);
+	rd->update_indirect_buffer(rd, ib, offset, size, data);
+}
+
 MRL_API mrl_error_t mrl_create_vertex_buffer(mrl_render_device_t * rd, mrl_vertex_buffer_t ** vb, const mrl_vertex_buffer_desc_t * desc)
 {
 	MGL_DEBUG_ASSERT(rd != NULL && vb != NULL && desc != NULL);
@@ -313,6 +421,18 @@ MRL_API void mrl_unmap_vertex_buffer(mrl_render_device_t * rd, mrl_vertex_buffer
 	rd->unmap_vertex_buffer(rd, vb);
 }
 
+MRL_API void * mrl_map_vertex_buffer_range(mrl_render_device_t * rd, mrl_vertex_buffer_t * vb, mgl_u64_t offset, mgl_u64_t size, mgl_u32_t flags)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && vb != NULL && size > 0);
+	return rd->map_vertex_buffer_range(rd, vb, offset, size, flags);
+}
+
+MRL_API void mrl_flush_vertex_buffer_range(mrl_render_device_t * rd, mrl_vertex_buffer_t * vb, mgl_u64_t offset, mgl_u64_t size)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && vb != NULL);
+	rd->flush_vertex_buffer_range(rd, vb, offset, size);
+}
+
 MRL_API void mrl_update_vertex_buffer(mrl_render_device_t * rd, mrl_vertex_buffer_t * vb, mgl_u64_t offset, mgl_u64_t size, const void * data)
 {
 	MGL_DEBUG_ASSERT(rd != NULL && vb != NULL && data != NULL);
@@ -337,6 +457,84 @@ MRL_API void mrl_set_vertex_array(mrl_render_device_t * rd, mrl_vertex_array_t *
 	rd->set_vertex_array(rd, va);
 }
 
+MRL_API mrl_error_t mrl_create_stream_allocator(mrl_render_device_t * rd, mrl_stream_allocator_t ** sa, const mrl_stream_allocator_desc_t * desc)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && sa != NULL && desc != NULL);
+	return rd->create_stream_allocator(rd, sa, desc);
+}
+
+MRL_API void mrl_destroy_stream_allocator(mrl_render_device_t * rd, mrl_stream_allocator_t * sa)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && sa != NULL);
+	rd->destroy_stream_allocator(rd, sa);
+}
+
+MRL_API void * mrl_map_stream_allocation(mrl_render_device_t * rd, mrl_stream_allocator_t * sa, mgl_u64_t size, mgl_u64_t alignment, mgl_u64_t * offset)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && sa != NULL && size > 0 && offset != NULL);
+	return rd->map_stream_allocation(rd, sa, size, alignment, offset);
+}
+
+MRL_API void mrl_unmap_stream_allocation(mrl_render_device_t * rd, mrl_stream_allocator_t * sa)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && sa != NULL);
+	rd->unmap_stream_allocation(rd, sa);
+}
+
+MRL_API void mrl_end_stream_allocator_frame(mrl_render_device_t * rd, mrl_stream_allocator_t * sa)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && sa != NULL);
+	rd->end_stream_allocator_frame(rd, sa);
+}
+
+MRL_API mrl_error_t mrl_create_upload_queue(mrl_render_device_t * rd, mrl_upload_queue_t ** uq, const mrl_upload_queue_desc_t * desc)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && uq != NULL && desc != NULL);
+	return rd->create_upload_queue(rd, uq, desc);
+}
+
+MRL_API void mrl_destroy_upload_queue(mrl_render_device_t * rd, mrl_upload_queue_t * uq)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && uq != NULL);
+	rd->destroy_upload_queue(rd, uq);
+}
+
+MRL_API mrl_error_t mrl_upload_texture_1d(mrl_render_device_t * rd, mrl_upload_queue_t * uq, mrl_texture_1d_t * tex, const mrl_texture_1d_update_desc_t * desc, mgl_u64_t * token)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && uq != NULL && tex != NULL && desc != NULL && token != NULL);
+	return rd->upload_texture_1d(rd, uq, tex, desc, token);
+}
+
+MRL_API mrl_error_t mrl_upload_texture_2d(mrl_render_device_t * rd, mrl_upload_queue_t * uq, mrl_texture_2d_t * tex, const mrl_texture_2d_update_desc_t * desc, mgl_u64_t * token)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && uq != NULL && tex != NULL && desc != NULL && token != NULL);
+	return rd->upload_texture_2d(rd, uq, tex, desc, token);
+}
+
+MRL_API mrl_error_t mrl_upload_texture_3d(mrl_render_device_t * rd, mrl_upload_queue_t * uq, mrl_texture_3d_t * tex, const mrl_texture_3d_update_desc_t * desc, mgl_u64_t * token)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && uq != NULL && tex != NULL && desc != NULL && token != NULL);
+	return rd->upload_texture_3d(rd, uq, tex, desc, token);
+}
+
+MRL_API mrl_error_t mrl_upload_cube_map(mrl_render_device_t * rd, mrl_upload_queue_t * uq, mrl_cube_map_t * cb, const mrl_cube_map_update_desc_t * desc, mgl_u64_t * token)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && uq != NULL && cb != NULL && desc != NULL && token != NULL);
+	return rd->upload_cube_map(rd, uq, cb, desc, token);
+}
+
+MRL_API mgl_bool_t mrl_is_upload_complete(mrl_render_device_t * rd, mrl_upload_queue_t * uq, mgl_u64_t token)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && uq != NULL);
+	return rd->is_upload_complete(rd, uq, token);
+}
+
+MRL_API void mrl_wait_upload(mrl_render_device_t * rd, mrl_upload_queue_t * uq, mgl_u64_t token)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && uq != NULL);
+	rd->wait_upload(rd, uq, token);
+}
+
 MRL_API mrl_error_t mrl_create_shader_stage(mrl_render_device_t * rd, mrl_shader_stage_t ** stage, const mrl_shader_stage_desc_t * desc)
 {
 	MGL_DEBUG_ASSERT(rd != NULL && stage != NULL && desc != NULL);
@@ -373,6 +571,26 @@ MRL_API mrl_shader_binding_point_t * mrl_get_shader_binding_point(mrl_render_dev
 	return rd->get_shader_binding_point(rd, pipeline, name);
 }
 
+MRL_API mgl_u64_t mrl_get_shader_binding_point_id(const mgl_chr8_t * name)
+{
+	MGL_DEBUG_ASSERT(name != NULL);
+
+	// FNV-1a
+	mgl_u64_t hash = 0xCBF29CE484222325;
+	for (; *name != 0; ++name)
+	{
+		hash ^= (mgl_u8_t)*name;
+		hash *= 0x100000001B3;
+	}
+	return hash;
+}
+
+MRL_API mrl_shader_binding_point_t * mrl_get_shader_binding_point_by_id(mrl_render_device_t * rd, mrl_shader_pipeline_t * pipeline, mgl_u64_t id)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && pipeline != NULL);
+	return rd->get_shader_binding_point_by_id(rd, pipeline, id);
+}
+
 MRL_API void mrl_clear_color(mrl_render_device_t * rd, mgl_f32_t r, mgl_f32_t g, mgl_f32_t b, mgl_f32_t a)
 {
 	MGL_DEBUG_ASSERT(rd != NULL);
@@ -421,6 +639,42 @@ MRL_API void mrl_draw_triangles_indexed_instanced(mrl_render_device_t * rd, mgl_
 	rd->draw_triangles_indexed_instanced(rd, offset, count, instance_count);
 }
 
+MRL_API void mrl_draw_triangles_indexed_base_vertex(mrl_render_device_t * rd, mgl_u64_t offset, mgl_u64_t count, mgl_i64_t base_vertex)
+{
+	MGL_DEBUG_ASSERT(rd != NULL);
+	rd->draw_triangles_indexed_base_vertex(rd, offset, count, base_vertex);
+}
+
+MRL_API void mrl_draw_triangles_indexed_instanced_base_vertex(mrl_render_device_t * rd, mgl_u64_t offset, mgl_u64_t count, mgl_u64_t instance_count, mgl_i64_t base_vertex)
+{
+	MGL_DEBUG_ASSERT(rd != NULL);
+	rd->draw_triangles_indexed_instanced_base_vertex(rd, offset, count, instance_count, base_vertex);
+}
+
+MRL_API void mrl_multi_draw_triangles(mrl_render_device_t * rd, const mgl_u64_t * offsets, const mgl_u64_t * counts, mgl_u64_t draw_count)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && (draw_count == 0 || (offsets != NULL && counts != NULL)));
+	rd->multi_draw_triangles(rd, offsets, counts, draw_count);
+}
+
+MRL_API void mrl_multi_draw_triangles_indexed(mrl_render_device_t * rd, const mgl_u64_t * offsets, const mgl_u64_t * counts, const mgl_i64_t * base_vertices, mgl_u64_t draw_count)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && (draw_count == 0 || (offsets != NULL && counts != NULL)));
+	rd->multi_draw_triangles_indexed(rd, offsets, counts, base_vertices, draw_count);
+}
+
+MRL_API void mrl_draw_triangles_indirect(mrl_render_device_t * rd, mrl_indirect_buffer_t * ib, mgl_u64_t offset, mgl_u64_t draw_count)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && ib != NULL);
+	rd->draw_triangles_indirect(rd, ib, offset, draw_count);
+}
+
+MRL_API void mrl_draw_triangles_indexed_indirect(mrl_render_device_t * rd, mrl_indirect_buffer_t * ib, mgl_u64_t offset, mgl_u64_t draw_count)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && ib != NULL);
+	rd->draw_triangles_indexed_indirect(rd, ib, offset, draw_count);
+}
+
 MRL_API void mrl_set_viewport(mrl_render_device_t * rd, mgl_i32_t x, mgl_i32_t y, mgl_i32_t w, mgl_i32_t h)
 {
 	MGL_DEBUG_ASSERT(rd != NULL);
@@ -444,3 +698,9 @@ MRL_API mgl_f64_t mrl_get_property_f(mrl_render_device_t * rd, mgl_enum_t name)
 	MGL_DEBUG_ASSERT(rd != NULL);
 	return rd->get_property_f(rd, name);
 }
+
+MRL_API void mrl_get_object_pool_stats(mrl_render_device_t * rd, mgl_enum_t type, mrl_object_pool_stats_t * stats)
+{
+	MGL_DEBUG_ASSERT(rd != NULL && stats != NULL);
+	rd->get_object_pool_stats(rd, type, stats);
+}
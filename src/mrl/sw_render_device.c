@@ -0,0 +1,4479 @@
+#include <mrl/sw_render_device.h>
+#include <mrl/object_pool.h>
+#include <mrl/texture_decoder.h>
+#include <mrl/thread.h>
+
+#include <mgl/memory/allocator.h>
+#include <mgl/memory/manipulation.h>
+#include <mgl/string/manipulation.h>
+#include <mgl/stream/buffer_stream.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define MRL_SW_SSE2
+#	include <emmintrin.h>
+#endif
+
+#define MRL_SW_TILE_SIZE 64
+#define MRL_SW_CHUNKS_PER_THREAD 4
+#define MRL_SW_VERTEX_JOB_SIZE 1024
+#define MRL_SW_CLEAR_JOB_ROW_COUNT 64
+#define MRL_SW_MAX_CLIP_VERTEX_COUNT 9
+#define MRL_SW_OBJECT_POOL_COUNT 20
+#define MRL_SW_CONSTANT_BUFFER_OFFSET_ALIGNMENT 16
+
+enum
+{
+	MRL_SW_TEXTURE_1D,
+	MRL_SW_TEXTURE_2D,
+	MRL_SW_TEXTURE_3D,
+	MRL_SW_CUBE_MAP,
+	MRL_SW_TEXTURE_2D_ARRAY,
+	MRL_SW_CUBE_MAP_ARRAY,
+};
+
+enum
+{
+	MRL_SW_COMPONENT_UN8,
+	MRL_SW_COMPONENT_SN8,
+	MRL_SW_COMPONENT_UI8,
+	MRL_SW_COMPONENT_SI8,
+	MRL_SW_COMPONENT_UN16,
+	MRL_SW_COMPONENT_SN16,
+	MRL_SW_COMPONENT_UI16,
+	MRL_SW_COMPONENT_SI16,
+	MRL_SW_COMPONENT_UI32,
+	MRL_SW_COMPONENT_SI32,
+	MRL_SW_COMPONENT_F32,
+	MRL_SW_COMPONENT_DEPTH,
+	MRL_SW_COMPONENT_DEPTH_STENCIL,
+};
+
+typedef struct
+{
+	mgl_u32_t texel_size;
+	mgl_u32_t component_count;
+	mgl_enum_t component_type;
+} mrl_sw_format_info_t;
+
+typedef struct
+{
+	mgl_u8_t* data;
+	mgl_u32_t width;
+	mgl_u32_t height;
+	mgl_u32_t depth;
+} mrl_sw_image_t;
+
+typedef struct
+{
+	mgl_enum_t type;
+	mgl_enum_t format;
+	mgl_enum_t usage;
+	mrl_sw_format_info_t info;
+	mgl_u32_t mip_level_count;
+	mrl_sw_image_t levels[MRL_MAX_MIP_LEVEL_COUNT];
+} mrl_sw_texture_t;
+
+typedef struct
+{
+	mgl_u8_t* data;
+	mgl_enum_t format;
+	mrl_sw_format_info_t info;
+	mgl_u32_t width;
+	mgl_u32_t height;
+} mrl_sw_surface_t;
+
+typedef struct
+{
+	mgl_u32_t target_count;
+	mrl_sw_surface_t targets[MRL_MAX_FRAMEBUFFER_RENDER_TARGET_COUNT];
+	mrl_sw_surface_t depth_stencil;
+	mgl_u32_t width;
+	mgl_u32_t height;
+} mrl_sw_framebuffer_t;
+
+typedef struct
+{
+	mgl_bool_t cull_enabled;
+	mgl_enum_t cull_face;
+	mgl_enum_t front_face;
+	mgl_bool_t wireframe;
+} mrl_sw_raster_state_t;
+
+typedef struct
+{
+	mgl_enum_t compare;
+	mgl_enum_t fail;
+	mgl_enum_t pass;
+	mgl_enum_t depth_fail;
+} mrl_sw_stencil_face_t;
+
+typedef struct
+{
+	mgl_bool_t depth_enabled;
+	mgl_bool_t depth_write_enabled;
+	mgl_f32_t depth_near;
+	mgl_f32_t depth_far;
+	mgl_enum_t depth_compare;
+
+	mgl_bool_t stencil_enabled;
+	mgl_u32_t stencil_ref;
+	mgl_u32_t stencil_read_mask;
+	mgl_u32_t stencil_write_mask;
+	mrl_sw_stencil_face_t stencil[2];
+} mrl_sw_depth_stencil_state_t;
+
+typedef struct
+{
+	mgl_bool_t blend_enabled;
+	mgl_enum_t src_factor;
+	mgl_enum_t dst_factor;
+	mgl_enum_t op;
+	mgl_enum_t src_alpha_factor;
+	mgl_enum_t dst_alpha_factor;
+	mgl_enum_t alpha_op;
+} mrl_sw_blend_state_t;
+
+typedef struct
+{
+	mgl_f32_t border_color[4];
+	mgl_enum_t min_filter;
+	mgl_enum_t mag_filter;
+	mgl_enum_t mip_filter;
+	mgl_enum_t address[3];
+} mrl_sw_sampler_t;
+
+typedef struct
+{
+	mgl_u8_t* data;
+	mgl_u64_t size;
+	mgl_enum_t usage;
+	mgl_enum_t format;
+} mrl_sw_buffer_t;
+
+typedef struct
+{
+	const mrl_sw_buffer_t* buffer;
+	mgl_u64_t offset;
+	mgl_u64_t stride;
+	mgl_enum_t type;
+	mgl_u32_t size;
+	mgl_u32_t input;
+	mgl_u32_t instance_step_rate;
+} mrl_sw_vertex_element_t;
+
+typedef struct
+{
+	mgl_u32_t element_count;
+	mrl_sw_vertex_element_t elements[MRL_MAX_VERTEX_ARRAY_ELEMENT_COUNT];
+} mrl_sw_vertex_array_t;
+
+typedef struct
+{
+	mrl_sw_buffer_t* buffer;
+	mgl_u64_t head;
+	mgl_u64_t frame_used;
+} mrl_sw_stream_allocator_t;
+
+typedef struct
+{
+	mgl_u64_t last_token;
+} mrl_sw_upload_queue_t;
+
+typedef struct
+{
+	mgl_enum_t stage;
+	mrl_sw_shader_desc_t desc;
+} mrl_sw_shader_stage_t;
+
+typedef struct
+{
+	mgl_u64_t id;
+	const mgl_chr8_t* name;
+	const mgl_u8_t* constants;
+	mgl_u64_t constants_size;
+	const mrl_sw_texture_t* texture;
+	const mrl_sw_sampler_t* sampler;
+} mrl_sw_binding_point_t;
+
+struct mrl_sw_shader_resources_t
+{
+	const mrl_sw_binding_point_t* bps[MRL_SW_MAX_BINDING_POINT_COUNT];
+};
+
+typedef struct
+{
+	mrl_sw_vertex_shader_func_t vertex;
+	mrl_sw_pixel_shader_func_t pixel;
+	mgl_u32_t input_count;
+	const mgl_chr8_t* inputs[MRL_MAX_VERTEX_ARRAY_ELEMENT_COUNT];
+	mgl_u32_t varying_count;
+
+	// Binding points and names share a single allocation
+	mgl_u32_t bp_count;
+	mrl_sw_binding_point_t* bps;
+	mrl_sw_shader_resources_t vertex_resources;
+	mrl_sw_shader_resources_t pixel_resources;
+} mrl_sw_shader_pipeline_t;
+
+// Vertex being clipped against the view volume
+typedef struct
+{
+	mgl_f32_t position[4];
+	mgl_f32_t varyings[MRL_SW_MAX_VARYING_COUNT];
+} mrl_sw_clip_vertex_t;
+
+// Triangle ready to be rasterized.
+// Edge i is opposite to vertex i, and is evaluated from its canonical endpoint, so triangles sharing an edge
+// get exactly symmetric values and the fill rule never leaves gaps or draws a pixel twice.
+typedef struct
+{
+	struct
+	{
+		mgl_f32_t ax, ay;
+		mgl_f32_t dx, dy;
+		mgl_f32_t sign;
+		mgl_f32_t length2;
+		mgl_bool_t inclusive;
+	} edges[3];
+
+	mgl_f32_t z[3];
+	mgl_f32_t inv_w[3];
+	mgl_f32_t inv_area;
+	mgl_i32_t min_x, min_y, max_x, max_y;
+	mgl_bool_t front_facing;
+} mrl_sw_triangle_t;
+
+// Each chunk sets up a contiguous range of primitives and bins its triangles into its own tile lists.
+// Tiles walk the chunks in order, so triangles are always drawn in submission order.
+typedef struct
+{
+	mgl_u64_t first_prim;
+	mgl_u64_t prim_count;
+	mgl_bool_t overflow;
+
+	mgl_u64_t tri_count;
+	mgl_u64_t tri_capacity;
+	mrl_sw_triangle_t* tris;
+	mgl_u64_t varying_capacity;
+	mgl_f32_t* varyings;
+
+	mgl_u32_t* tile_counts;
+	mgl_u32_t* tile_starts;
+	mgl_u32_t* tile_fill;
+	mgl_u64_t bin_capacity;
+	mgl_u32_t* bins;
+} mrl_sw_chunk_t;
+
+typedef struct mrl_sw_render_device_t mrl_sw_render_device_t;
+typedef void(*mrl_sw_job_func_t)(mrl_sw_render_device_t* rd, void* data, mgl_u64_t job);
+
+// Parameters of the draw being executed, shared by every job of the draw
+typedef struct
+{
+	const mrl_sw_framebuffer_t* fb;
+	const mrl_sw_raster_state_t* rs;
+	const mrl_sw_depth_stencil_state_t* dss;
+	const mrl_sw_blend_state_t* bs;
+	const mrl_sw_shader_pipeline_t* pp;
+	const mrl_sw_vertex_array_t* va;
+
+	const mgl_u8_t* indices;
+	mgl_u32_t index_size;
+	mgl_u64_t first;
+	mgl_i64_t base_vertex;
+	mgl_u64_t vertex_min;
+	mgl_u64_t vertex_range;
+	mgl_u64_t vertex_total;
+	mgl_u64_t tri_count;
+	mgl_u64_t instance_count;
+	mgl_u64_t prim_count;
+	mgl_u32_t varying_count;
+
+	mgl_f32_t viewport[4];
+	mgl_f32_t depth_near;
+	mgl_f32_t depth_far;
+	mgl_i32_t clip_min_x, clip_min_y, clip_max_x, clip_max_y;
+	mgl_u32_t tiles_x, tiles_y;
+	mgl_u32_t chunk_count;
+} mrl_sw_draw_t;
+
+struct mrl_sw_render_device_t
+{
+	mrl_render_device_t base;
+
+	void* allocator;
+
+	struct
+	{
+		mrl_object_pool_t framebuffer;
+		mrl_object_pool_t raster_state;
+		mrl_object_pool_t depth_stencil_state;
+		mrl_object_pool_t blend_state;
+		mrl_object_pool_t sampler;
+		mrl_object_pool_t texture_1d;
+		mrl_object_pool_t texture_2d;
+		mrl_object_pool_t texture_3d;
+		mrl_object_pool_t cube_map;
+		mrl_object_pool_t constant_buffer;
+		mrl_object_pool_t index_buffer;
+		mrl_object_pool_t vertex_buffer;
+		mrl_object_pool_t vertex_array;
+		mrl_object_pool_t shader_stage;
+		mrl_object_pool_t shader_pipeline;
+		mrl_object_pool_t stream_allocator;
+		mrl_object_pool_t indirect_buffer;
+		mrl_object_pool_t upload_queue;
+		mrl_object_pool_t texture_2d_array;
+		mrl_object_pool_t cube_map_array;
+	} memory;
+
+	// Default framebuffer, which is always offscreen
+	struct
+	{
+		mgl_u32_t width;
+		mgl_u32_t height;
+		mgl_u8_t* color;
+		mgl_u8_t* depth_stencil;
+		mrl_sw_framebuffer_t fb;
+	} offscreen;
+
+	struct
+	{
+		const mrl_sw_framebuffer_t* framebuffer;
+		const mrl_sw_raster_state_t* raster_state;
+		const mrl_sw_depth_stencil_state_t* depth_stencil_state;
+		const mrl_sw_blend_state_t* blend_state;
+		const mrl_sw_shader_pipeline_t* pipeline;
+		const mrl_sw_vertex_array_t* vertex_array;
+		const mrl_sw_buffer_t* index_buffer;
+		mgl_i32_t viewport[4];
+	} state;
+
+	// Worker threads, the thread which owns the device works on the jobs too
+	struct
+	{
+		mgl_u32_t count;
+		mrl_thread_t* threads;
+		mrl_mutex_t mutex;
+		mrl_condition_t start_cond;
+		mrl_condition_t done_cond;
+		mgl_u64_t generation;
+		mgl_u32_t active_count;
+		mgl_bool_t quit;
+
+		mrl_sw_job_func_t func;
+		void* data;
+		mgl_u64_t job_count;
+		mgl_u64_t next_job;
+	} workers;
+
+	// Draw scratch memory, reused between draws
+	struct
+	{
+		mgl_u64_t vertex_capacity;
+		mrl_sw_vertex_output_t* vertices;
+		mgl_u32_t chunk_count;
+		mrl_sw_chunk_t* chunks;
+		mgl_u32_t tile_capacity;
+	} scratch;
+
+	mrl_sw_raster_state_t default_raster_state;
+	mrl_sw_depth_stencil_state_t default_depth_stencil_state;
+	mrl_sw_blend_state_t default_blend_state;
+	mrl_sw_sampler_t default_sampler;
+
+	mrl_render_device_hint_error_callback_t error_callback;
+	mrl_render_device_hint_error_callback_t warning_callback;
+};
+
+// ---------- Math ----------
+
+static mgl_f32_t min_f32(mgl_f32_t a, mgl_f32_t b) { return a < b ? a : b; }
+static mgl_f32_t max_f32(mgl_f32_t a, mgl_f32_t b) { return a > b ? a : b; }
+static mgl_f32_t clamp_f32(mgl_f32_t v, mgl_f32_t lo, mgl_f32_t hi) { return v < lo ? lo : (v > hi ? hi : v); }
+static mgl_f32_t abs_f32(mgl_f32_t v) { return v < 0.0f ? -v : v; }
+static mgl_i32_t min_i32(mgl_i32_t a, mgl_i32_t b) { return a < b ? a : b; }
+static mgl_i32_t max_i32(mgl_i32_t a, mgl_i32_t b) { return a > b ? a : b; }
+
+static mgl_i32_t floor_f32(mgl_f32_t v)
+{
+	mgl_i32_t i = (mgl_i32_t)v;
+	return (mgl_f32_t)i > v ? i - 1 : i;
+}
+
+static mgl_i32_t ceil_f32(mgl_f32_t v)
+{
+	mgl_i32_t i = (mgl_i32_t)v;
+	return (mgl_f32_t)i < v ? i + 1 : i;
+}
+
+static mgl_i32_t round_f32(mgl_f32_t v)
+{
+	return floor_f32(v + 0.5f);
+}
+
+static mgl_u64_t str_size(const mgl_chr8_t* str)
+{
+	mgl_u64_t size = 0;
+	while (str[size] != '\0')
+		++size;
+	return size;
+}
+
+// ---------- Texel formats ----------
+
+static mgl_bool_t get_format_info(mgl_enum_t format, mrl_sw_format_info_t* info)
+{
+	switch (format)
+	{
+		case MRL_TEXTURE_FORMAT_R8_UN: *info = (mrl_sw_format_info_t) { 1, 1, MRL_SW_COMPONENT_UN8 }; break;
+		case MRL_TEXTURE_FORMAT_R8_SN: *info = (mrl_sw_format_info_t) { 1, 1, MRL_SW_COMPONENT_SN8 }; break;
+		case MRL_TEXTURE_FORMAT_R8_UI: *info = (mrl_sw_format_info_t) { 1, 1, MRL_SW_COMPONENT_UI8 }; break;
+		case MRL_TEXTURE_FORMAT_R8_SI: *info = (mrl_sw_format_info_t) { 1, 1, MRL_SW_COMPONENT_SI8 }; break;
+		case MRL_TEXTURE_FORMAT_RG8_UN: *info = (mrl_sw_format_info_t) { 2, 2, MRL_SW_COMPONENT_UN8 }; break;
+		case MRL_TEXTURE_FORMAT_RG8_SN: *info = (mrl_sw_format_info_t) { 2, 2, MRL_SW_COMPONENT_SN8 }; break;
+		case MRL_TEXTURE_FORMAT_RG8_UI: *info = (mrl_sw_format_info_t) { 2, 2, MRL_SW_COMPONENT_UI8 }; break;
+		case MRL_TEXTURE_FORMAT_RG8_SI: *info = (mrl_sw_format_info_t) { 2, 2, MRL_SW_COMPONENT_SI8 }; break;
+		case MRL_TEXTURE_FORMAT_RGBA8_UN: *info = (mrl_sw_format_info_t) { 4, 4, MRL_SW_COMPONENT_UN8 }; break;
+		case MRL_TEXTURE_FORMAT_RGBA8_SN: *info = (mrl_sw_format_info_t) { 4, 4, MRL_SW_COMPONENT_SN8 }; break;
+		case MRL_TEXTURE_FORMAT_RGBA8_UI: *info = (mrl_sw_format_info_t) { 4, 4, MRL_SW_COMPONENT_UI8 }; break;
+		case MRL_TEXTURE_FORMAT_RGBA8_SI: *info = (mrl_sw_format_info_t) { 4, 4, MRL_SW_COMPONENT_SI8 }; break;
+
+		case MRL_TEXTURE_FORMAT_R16_UN: *info = (mrl_sw_format_info_t) { 2, 1, MRL_SW_COMPONENT_UN16 }; break;
+		case MRL_TEXTURE_FORMAT_R16_SN: *info = (mrl_sw_format_info_t) { 2, 1, MRL_SW_COMPONENT_SN16 }; break;
+		case MRL_TEXTURE_FORMAT_R16_UI: *info = (mrl_sw_format_info_t) { 2, 1, MRL_SW_COMPONENT_UI16 }; break;
+		case MRL_TEXTURE_FORMAT_R16_SI: *info = (mrl_sw_format_info_t) { 2, 1, MRL_SW_COMPONENT_SI16 }; break;
+		case MRL_TEXTURE_FORMAT_RG16_UN: *info = (mrl_sw_format_info_t) { 4, 2, MRL_SW_COMPONENT_UN16 }; break;
+		case MRL_TEXTURE_FORMAT_RG16_SN: *info = (mrl_sw_format_info_t) { 4, 2, MRL_SW_COMPONENT_SN16 }; break;
+		case MRL_TEXTURE_FORMAT_RG16_UI: *info = (mrl_sw_format_info_t) { 4, 2, MRL_SW_COMPONENT_UI16 }; break;
+		case MRL_TEXTURE_FORMAT_RG16_SI: *info = (mrl_sw_format_info_t) { 4, 2, MRL_SW_COMPONENT_SI16 }; break;
+		case MRL_TEXTURE_FORMAT_RGBA16_UN: *info = (mrl_sw_format_info_t) { 8, 4, MRL_SW_COMPONENT_UN16 }; break;
+		case MRL_TEXTURE_FORMAT_RGBA16_SN: *info = (mrl_sw_format_info_t) { 8, 4, MRL_SW_COMPONENT_SN16 }; break;
+		case MRL_TEXTURE_FORMAT_RGBA16_UI: *info = (mrl_sw_format_info_t) { 8, 4, MRL_SW_COMPONENT_UI16 }; break;
+		case MRL_TEXTURE_FORMAT_RGBA16_SI: *info = (mrl_sw_format_info_t) { 8, 4, MRL_SW_COMPONENT_SI16 }; break;
+
+		case MRL_TEXTURE_FORMAT_R32_UI: *info = (mrl_sw_format_info_t) { 4, 1, MRL_SW_COMPONENT_UI32 }; break;
+		case MRL_TEXTURE_FORMAT_R32_SI: *info = (mrl_sw_format_info_t) { 4, 1, MRL_SW_COMPONENT_SI32 }; break;
+		case MRL_TEXTURE_FORMAT_R32_F: *info = (mrl_sw_format_info_t) { 4, 1, MRL_SW_COMPONENT_F32 }; break;
+		case MRL_TEXTURE_FORMAT_RG32_UI: *info = (mrl_sw_format_info_t) { 8, 2, MRL_SW_COMPONENT_UI32 }; break;
+		case MRL_TEXTURE_FORMAT_RG32_SI: *info = (mrl_sw_format_info_t) { 8, 2, MRL_SW_COMPONENT_SI32 }; break;
+		case MRL_TEXTURE_FORMAT_RG32_F: *info = (mrl_sw_format_info_t) { 8, 2, MRL_SW_COMPONENT_F32 }; break;
+		case MRL_TEXTURE_FORMAT_RGBA32_UI: *info = (mrl_sw_format_info_t) { 16, 4, MRL_SW_COMPONENT_UI32 }; break;
+		case MRL_TEXTURE_FORMAT_RGBA32_SI: *info = (mrl_sw_format_info_t) { 16, 4, MRL_SW_COMPONENT_SI32 }; break;
+		case MRL_TEXTURE_FORMAT_RGBA32_F: *info = (mrl_sw_format_info_t) { 16, 4, MRL_SW_COMPONENT_F32 }; break;
+
+		// Depth is always stored as a float, and stencil as a 32-bit integer next to it
+		case MRL_TEXTURE_FORMAT_D16:
+		case MRL_TEXTURE_FORMAT_D32: *info = (mrl_sw_format_info_t) { 4, 1, MRL_SW_COMPONENT_DEPTH }; break;
+		case MRL_TEXTURE_FORMAT_D24S8:
+		case MRL_TEXTURE_FORMAT_D32S8: *info = (mrl_sw_format_info_t) { 8, 2, MRL_SW_COMPONENT_DEPTH_STENCIL }; break;
+
+		default:
+			return MGL_FALSE;
+	}
+
+	return MGL_TRUE;
+}
+
+static mgl_bool_t is_depth_format(const mrl_sw_format_info_t* info)
+{
+	return info->component_type == MRL_SW_COMPONENT_DEPTH || info->component_type == MRL_SW_COMPONENT_DEPTH_STENCIL;
+}
+
+static mgl_bool_t is_integer_format(const mrl_sw_format_info_t* info)
+{
+	switch (info->component_type)
+	{
+		case MRL_SW_COMPONENT_UI8:
+		case MRL_SW_COMPONENT_SI8:
+		case MRL_SW_COMPONENT_UI16:
+		case MRL_SW_COMPONENT_SI16:
+		case MRL_SW_COMPONENT_UI32:
+		case MRL_SW_COMPONENT_SI32:
+			return MGL_TRUE;
+		default:
+			return MGL_FALSE;
+	}
+}
+
+static void load_texel(const mrl_sw_format_info_t* info, const mgl_u8_t* texel, mgl_f32_t* out)
+{
+	out[0] = 0.0f;
+	out[1] = 0.0f;
+	out[2] = 0.0f;
+	out[3] = 1.0f;
+
+	for (mgl_u32_t i = 0; i < info->component_count; ++i)
+		switch (info->component_type)
+		{
+			case MRL_SW_COMPONENT_UN8: out[i] = (mgl_f32_t)texel[i] / 255.0f; break;
+			case MRL_SW_COMPONENT_SN8: out[i] = max_f32((mgl_f32_t)((const mgl_i8_t*)texel)[i] / 127.0f, -1.0f); break;
+			case MRL_SW_COMPONENT_UI8: out[i] = (mgl_f32_t)texel[i]; break;
+			case MRL_SW_COMPONENT_SI8: out[i] = (mgl_f32_t)((const mgl_i8_t*)texel)[i]; break;
+			case MRL_SW_COMPONENT_UN16: out[i] = (mgl_f32_t)((const mgl_u16_t*)texel)[i] / 65535.0f; break;
+			case MRL_SW_COMPONENT_SN16: out[i] = max_f32((mgl_f32_t)((const mgl_i16_t*)texel)[i] / 32767.0f, -1.0f); break;
+			case MRL_SW_COMPONENT_UI16: out[i] = (mgl_f32_t)((const mgl_u16_t*)texel)[i]; break;
+			case MRL_SW_COMPONENT_SI16: out[i] = (mgl_f32_t)((const mgl_i16_t*)texel)[i]; break;
+			case MRL_SW_COMPONENT_UI32: out[i] = (mgl_f32_t)((const mgl_u32_t*)texel)[i]; break;
+			case MRL_SW_COMPONENT_SI32: out[i] = (mgl_f32_t)((const mgl_i32_t*)texel)[i]; break;
+			case MRL_SW_COMPONENT_F32: out[i] = ((const mgl_f32_t*)texel)[i]; break;
+			case MRL_SW_COMPONENT_DEPTH: out[i] = ((const mgl_f32_t*)texel)[i]; break;
+			case MRL_SW_COMPONENT_DEPTH_STENCIL:
+				if (i == 0)
+					out[i] = ((const mgl_f32_t*)texel)[0];
+				else
+					out[i] = (mgl_f32_t)((const mgl_u32_t*)texel)[1];
+				break;
+		}
+}
+
+static void store_texel(const mrl_sw_format_info_t* info, mgl_u8_t* texel, const mgl_f32_t* in)
+{
+	for (mgl_u32_t i = 0; i < info->component_count; ++i)
+		switch (info->component_type)
+		{
+			case MRL_SW_COMPONENT_UN8: texel[i] = (mgl_u8_t)round_f32(clamp_f32(in[i], 0.0f, 1.0f) * 255.0f); break;
+			case MRL_SW_COMPONENT_SN8: ((mgl_i8_t*)texel)[i] = (mgl_i8_t)round_f32(clamp_f32(in[i], -1.0f, 1.0f) * 127.0f); break;
+			case MRL_SW_COMPONENT_UI8: texel[i] = (mgl_u8_t)clamp_f32(in[i], 0.0f, 255.0f); break;
+			case MRL_SW_COMPONENT_SI8: ((mgl_i8_t*)texel)[i] = (mgl_i8_t)clamp_f32(in[i], -128.0f, 127.0f); break;
+			case MRL_SW_COMPONENT_UN16: ((mgl_u16_t*)texel)[i] = (mgl_u16_t)round_f32(clamp_f32(in[i], 0.0f, 1.0f) * 65535.0f); break;
+			case MRL_SW_COMPONENT_SN16: ((mgl_i16_t*)texel)[i] = (mgl_i16_t)round_f32(clamp_f32(in[i], -1.0f, 1.0f) * 32767.0f); break;
+			case MRL_SW_COMPONENT_UI16: ((mgl_u16_t*)texel)[i] = (mgl_u16_t)clamp_f32(in[i], 0.0f, 65535.0f); break;
+			case MRL_SW_COMPONENT_SI16: ((mgl_i16_t*)texel)[i] = (mgl_i16_t)clamp_f32(in[i], -32768.0f, 32767.0f); break;
+			case MRL_SW_COMPONENT_UI32: ((mgl_u32_t*)texel)[i] = (mgl_u32_t)clamp_f32(in[i], 0.0f, 4294967040.0f); break;
+			case MRL_SW_COMPONENT_SI32: ((mgl_i32_t*)texel)[i] = (mgl_i32_t)clamp_f32(in[i], -2147483648.0f, 2147483520.0f); break;
+			case MRL_SW_COMPONENT_F32: ((mgl_f32_t*)texel)[i] = in[i]; break;
+			case MRL_SW_COMPONENT_DEPTH: ((mgl_f32_t*)texel)[i] = clamp_f32(in[i], 0.0f, 1.0f); break;
+			case MRL_SW_COMPONENT_DEPTH_STENCIL:
+				if (i == 0)
+					((mgl_f32_t*)texel)[0] = clamp_f32(in[i], 0.0f, 1.0f);
+				else
+					((mgl_u32_t*)texel)[1] = (mgl_u32_t)clamp_f32(in[i], 0.0f, 255.0f);
+				break;
+		}
+}
+
+// ---------- Worker threads ----------
+
+static void run_worker_jobs(mrl_sw_render_device_t* rd)
+{
+	for (;;)
+	{
+		mrl_lock_mutex(&rd->workers.mutex);
+		mgl_u64_t job = rd->workers.next_job;
+		if (job < rd->workers.job_count)
+			rd->workers.next_job += 1;
+		mrl_unlock_mutex(&rd->workers.mutex);
+
+		if (job >= rd->workers.job_count)
+			return;
+		rd->workers.func(rd, rd->workers.data, job);
+	}
+}
+
+static void worker_main(void* arg)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)arg;
+	mgl_u64_t generation = 0;
+
+	for (;;)
+	{
+		// Wait for new jobs
+		mrl_lock_mutex(&rd->workers.mutex);
+		while (rd->workers.generation == generation && !rd->workers.quit)
+			mrl_wait_condition(&rd->workers.start_cond, &rd->workers.mutex);
+		if (rd->workers.quit)
+		{
+			mrl_unlock_mutex(&rd->workers.mutex);
+			return;
+		}
+		generation = rd->workers.generation;
+		mrl_unlock_mutex(&rd->workers.mutex);
+
+		run_worker_jobs(rd);
+
+		// Notify the device thread
+		mrl_lock_mutex(&rd->workers.mutex);
+		if (--rd->workers.active_count == 0)
+			mrl_signal_condition(&rd->workers.done_cond);
+		mrl_unlock_mutex(&rd->workers.mutex);
+	}
+}
+
+static void run_jobs(mrl_sw_render_device_t* rd, mgl_u64_t job_count, mrl_sw_job_func_t func, void* data)
+{
+	if (job_count == 0)
+		return;
+
+	// Small batches aren't worth waking up the workers
+	if (job_count == 1 || rd->workers.count == 1)
+	{
+		for (mgl_u64_t i = 0; i < job_count; ++i)
+			func(rd, data, i);
+		return;
+	}
+
+	mrl_lock_mutex(&rd->workers.mutex);
+	rd->workers.func = func;
+	rd->workers.data = data;
+	rd->workers.job_count = job_count;
+	rd->workers.next_job = 0;
+	rd->workers.active_count = rd->workers.count - 1;
+	rd->workers.generation += 1;
+	mrl_broadcast_condition(&rd->workers.start_cond);
+	mrl_unlock_mutex(&rd->workers.mutex);
+
+	run_worker_jobs(rd);
+
+	// Wait for the other workers to finish
+	mrl_lock_mutex(&rd->workers.mutex);
+	while (rd->workers.active_count > 0)
+		mrl_wait_condition(&rd->workers.done_cond, &rd->workers.mutex);
+	mrl_unlock_mutex(&rd->workers.mutex);
+}
+
+static void stop_workers(mrl_sw_render_device_t* rd, mgl_u32_t started_count)
+{
+	mrl_lock_mutex(&rd->workers.mutex);
+	rd->workers.quit = MGL_TRUE;
+	mrl_broadcast_condition(&rd->workers.start_cond);
+	mrl_unlock_mutex(&rd->workers.mutex);
+
+	for (mgl_u32_t i = 0; i < started_count; ++i)
+		mrl_join_thread(&rd->workers.threads[i]);
+}
+
+static mrl_error_t start_workers(mrl_sw_render_device_t* rd, mgl_u32_t thread_count)
+{
+	rd->workers.count = thread_count < 1 ? 1 : thread_count;
+	rd->workers.threads = NULL;
+	rd->workers.generation = 0;
+	rd->workers.active_count = 0;
+	rd->workers.quit = MGL_FALSE;
+	rd->workers.job_count = 0;
+	rd->workers.next_job = 0;
+
+	mrl_init_mutex(&rd->workers.mutex);
+	mrl_init_condition(&rd->workers.start_cond);
+	mrl_init_condition(&rd->workers.done_cond);
+
+	if (rd->workers.count == 1)
+		return MRL_ERROR_NONE;
+
+	mgl_error_t mglerr = mgl_allocate(rd->allocator, sizeof(mrl_thread_t) * (rd->workers.count - 1), (void**)&rd->workers.threads);
+	if (mglerr != MGL_ERROR_NONE)
+	{
+		mrl_terminate_condition(&rd->workers.done_cond);
+		mrl_terminate_condition(&rd->workers.start_cond);
+		mrl_terminate_mutex(&rd->workers.mutex);
+		return mrl_make_mgl_error(mglerr);
+	}
+
+	for (mgl_u32_t i = 0; i < rd->workers.count - 1; ++i)
+	{
+		mrl_error_t err = mrl_start_thread(&rd->workers.threads[i], &worker_main, rd);
+		if (err != MRL_ERROR_NONE)
+		{
+			stop_workers(rd, i);
+			mgl_deallocate(rd->allocator, rd->workers.threads);
+			mrl_terminate_condition(&rd->workers.done_cond);
+			mrl_terminate_condition(&rd->workers.start_cond);
+			mrl_terminate_mutex(&rd->workers.mutex);
+			return err;
+		}
+	}
+
+	return MRL_ERROR_NONE;
+}
+
+static void terminate_workers(mrl_sw_render_device_t* rd)
+{
+	if (rd->workers.threads != NULL)
+	{
+		stop_workers(rd, rd->workers.count - 1);
+		mgl_deallocate(rd->allocator, rd->workers.threads);
+	}
+
+	mrl_terminate_condition(&rd->workers.done_cond);
+	mrl_terminate_condition(&rd->workers.start_cond);
+	mrl_terminate_mutex(&rd->workers.mutex);
+}
+
+// ---------- Framebuffers ----------
+
+static void get_level_surface(const mrl_sw_texture_t* tex, mgl_u32_t level, mgl_u32_t layer, mrl_sw_surface_t* surface)
+{
+	const mrl_sw_image_t* img = &tex->levels[level];
+	surface->data = img->data + (mgl_u64_t)layer * img->width * img->height * tex->info.texel_size;
+	surface->format = tex->format;
+	surface->info = tex->info;
+	surface->width = img->width;
+	surface->height = img->height;
+}
+
+static mrl_error_t create_framebuffer(mrl_render_device_t* brd, mrl_framebuffer_t** fb, const mrl_framebuffer_desc_t* desc)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	// Check for input errors
+	if (desc->target_count == 0)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create framebuffer: target count must be at least 1");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+	else if (desc->target_count > MRL_MAX_FRAMEBUFFER_RENDER_TARGET_COUNT)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create framebuffer: maximum target count surpassed");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	for (mgl_u32_t i = 0; i < desc->target_count; ++i)
+	{
+		if ((desc->targets[i].type == MRL_RENDER_TARGET_TYPE_TEXTURE_2D && desc->targets[i].tex_2d.handle == NULL) ||
+			(desc->targets[i].type == MRL_RENDER_TARGET_TYPE_CUBE_MAP && desc->targets[i].cube_map.handle == NULL) ||
+			(desc->targets[i].type == MRL_RENDER_TARGET_TYPE_TEXTURE_2D_ARRAY && desc->targets[i].tex_2d_array.handle == NULL))
+		{
+			if (rd->error_callback != NULL)
+				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create framebuffer: defined target cannot be NULL");
+			return MRL_ERROR_INVALID_PARAMS;
+		}
+
+		if (desc->targets[i].type == MRL_RENDER_TARGET_TYPE_CUBE_MAP &&
+			(desc->targets[i].cube_map.face < MRL_CUBE_MAP_FACE_POSITIVE_X || desc->targets[i].cube_map.face > MRL_CUBE_MAP_FACE_NEGATIVE_Z))
+		{
+			if (rd->error_callback != NULL)
+				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create framebuffer: invalid cube map target face");
+			return MRL_ERROR_INVALID_PARAMS;
+		}
+
+		if (desc->targets[i].type == MRL_RENDER_TARGET_TYPE_TEXTURE_2D_ARRAY &&
+			desc->targets[i].tex_2d_array.layer >= ((const mrl_sw_texture_t*)desc->targets[i].tex_2d_array.handle)->levels[0].depth)
+		{
+			if (rd->error_callback != NULL)
+				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create framebuffer: invalid texture array target layer");
+			return MRL_ERROR_INVALID_PARAMS;
+		}
+
+		if (desc->targets[i].type != MRL_RENDER_TARGET_TYPE_TEXTURE_2D &&
+			desc->targets[i].type != MRL_RENDER_TARGET_TYPE_CUBE_MAP &&
+			desc->targets[i].type != MRL_RENDER_TARGET_TYPE_TEXTURE_2D_ARRAY)
+		{
+			if (rd->error_callback != NULL)
+				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create framebuffer: invalid target type");
+			return MRL_ERROR_INVALID_PARAMS;
+		}
+
+		const mrl_sw_texture_t* tex;
+		if (desc->targets[i].type == MRL_RENDER_TARGET_TYPE_TEXTURE_2D)
+			tex = (const mrl_sw_texture_t*)desc->targets[i].tex_2d.handle;
+		else if (desc->targets[i].type == MRL_RENDER_TARGET_TYPE_CUBE_MAP)
+			tex = (const mrl_sw_texture_t*)desc->targets[i].cube_map.handle;
+		else
+			tex = (const mrl_sw_texture_t*)desc->targets[i].tex_2d_array.handle;
+		if (is_depth_format(&tex->info))
+		{
+			if (rd->error_callback != NULL)
+				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create framebuffer: color targets cannot have a depth format");
+			return MRL_ERROR_INVALID_PARAMS;
+		}
+	}
+
+	// The depth/stencil target is either a 2D texture or a texture array layer
+	const mrl_sw_texture_t* depth_stencil = (const mrl_sw_texture_t*)desc->depth_stencil;
+	mgl_u64_t depth_stencil_layer = 0;
+	if (depth_stencil == NULL && desc->depth_stencil_array != NULL)
+	{
+		depth_stencil = (const mrl_sw_texture_t*)desc->depth_stencil_array;
+		depth_stencil_layer = desc->depth_stencil_layer;
+		if (depth_stencil_layer >= depth_stencil->levels[0].depth)
+		{
+			if (rd->error_callback != NULL)
+				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create framebuffer: invalid depth/stencil texture array layer");
+			return MRL_ERROR_INVALID_PARAMS;
+		}
+	}
+
+	if (depth_stencil != NULL && !is_depth_format(&depth_stencil->info))
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create framebuffer: invalid depth/stencil texture format");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	// Allocate object
+	mrl_sw_framebuffer_t* obj;
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.framebuffer,
+		(void**)&obj);
+	if (err != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(err);
+
+	// Store framebuffer info, rendering always goes to the base level, like on the OpenGL device
+	obj->target_count = desc->target_count;
+	for (mgl_u32_t i = 0; i < desc->target_count; ++i)
+	{
+		if (desc->targets[i].type == MRL_RENDER_TARGET_TYPE_TEXTURE_2D)
+			get_level_surface((const mrl_sw_texture_t*)desc->targets[i].tex_2d.handle, 0, 0, &obj->targets[i]);
+		else if (desc->targets[i].type == MRL_RENDER_TARGET_TYPE_CUBE_MAP)
+			get_level_surface((const mrl_sw_texture_t*)desc->targets[i].cube_map.handle, 0, desc->targets[i].cube_map.face, &obj->targets[i]);
+		else
+			get_level_surface((const mrl_sw_texture_t*)desc->targets[i].tex_2d_array.handle, 0, (mgl_u32_t)desc->targets[i].tex_2d_array.layer, &obj->targets[i]);
+	}
+
+	if (depth_stencil != NULL)
+		get_level_surface(depth_stencil, 0, (mgl_u32_t)depth_stencil_layer, &obj->depth_stencil);
+	else
+		obj->depth_stencil.data = NULL;
+
+	// The drawable area is the intersection of every attachment
+	obj->width = obj->targets[0].width;
+	obj->height = obj->targets[0].height;
+	for (mgl_u32_t i = 1; i < obj->target_count; ++i)
+	{
+		obj->width = obj->targets[i].width < obj->width ? obj->targets[i].width : obj->width;
+		obj->height = obj->targets[i].height < obj->height ? obj->targets[i].height : obj->height;
+	}
+	if (obj->depth_stencil.data != NULL)
+	{
+		obj->width = obj->depth_stencil.width < obj->width ? obj->depth_stencil.width : obj->width;
+		obj->height = obj->depth_stencil.height < obj->height ? obj->depth_stencil.height : obj->height;
+	}
+
+	*fb = (mrl_framebuffer_t*)obj;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_framebuffer(mrl_render_device_t* brd, mrl_framebuffer_t* fb)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	mrl_sw_framebuffer_t* obj = (mrl_sw_framebuffer_t*)fb;
+
+	if (rd->state.framebuffer == obj)
+		rd->state.framebuffer = &rd->offscreen.fb;
+
+	// Deallocate object
+	mrl_deallocate_object(
+		&rd->memory.framebuffer,
+		obj);
+}
+
+static void set_framebuffer(mrl_render_device_t* brd, mrl_framebuffer_t* fb)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	// Set framebuffer
+	if (fb == NULL)
+		rd->state.framebuffer = &rd->offscreen.fb;
+	else
+		rd->state.framebuffer = (const mrl_sw_framebuffer_t*)fb;
+}
+
+// ---------- Raster states ----------
+
+static mrl_error_t create_raster_state(mrl_render_device_t* brd, mrl_raster_state_t** rs, const mrl_raster_state_desc_t* desc)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	// Check for invalid input
+	if (desc->front_face != MRL_WINDING_CW && desc->front_face != MRL_WINDING_CCW)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create raster state: invalid front face winding");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	if (desc->cull_face != MRL_FACE_FRONT && desc->cull_face != MRL_FACE_BACK && desc->cull_face != MRL_FACE_FRONT_AND_BACK)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create raster state: invalid cull face");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	if (desc->raster_mode != MRL_RASTER_MODE_FILL && desc->raster_mode != MRL_RASTER_MODE_WIREFRAME)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create raster state: invalid raster mode");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	// Allocate object
+	mrl_sw_raster_state_t* obj;
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.raster_state,
+		(void**)&obj);
+	if (err != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(err);
+
+	// Store raster state info
+	obj->cull_enabled = desc->cull_enabled;
+	obj->cull_face = desc->cull_face;
+	obj->front_face = desc->front_face;
+	obj->wireframe = desc->raster_mode == MRL_RASTER_MODE_WIREFRAME;
+	*rs = (mrl_raster_state_t*)obj;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_raster_state(mrl_render_device_t* brd, mrl_raster_state_t* rs)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	mrl_sw_raster_state_t* obj = (mrl_sw_raster_state_t*)rs;
+
+	if (rd->state.raster_state == obj)
+		rd->state.raster_state = &rd->default_raster_state;
+
+	// Deallocate object
+	mrl_deallocate_object(
+		&rd->memory.raster_state,
+		obj);
+}
+
+static void set_raster_state(mrl_render_device_t* brd, mrl_raster_state_t* rs)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	// Set raster state
+	if (rs == NULL)
+		rd->state.raster_state = &rd->default_raster_state;
+	else
+		rd->state.raster_state = (const mrl_sw_raster_state_t*)rs;
+}
+
+// ---------- Depth stencil states ----------
+
+#undef near
+#undef far
+
+static mgl_bool_t is_valid_compare(mgl_enum_t compare)
+{
+	return compare >= MRL_COMPARE_NEVER && compare <= MRL_COMPARE_ALWAYS;
+}
+
+static mgl_bool_t is_valid_action(mgl_enum_t action)
+{
+	return action >= MRL_ACTION_KEEP && action <= MRL_ACTION_INVERT;
+}
+
+static mrl_error_t create_depth_stencil_state(mrl_render_device_t* brd, mrl_depth_stencil_state_t** dss, const mrl_depth_stencil_state_desc_t* desc)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	// Check for invalid input
+	if (!is_valid_compare(desc->depth.compare))
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create depth stencil state: invalid depth compare function");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	if (!is_valid_compare(desc->stencil.front_face.compare))
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create depth stencil state: invalid front face stencil compare function");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	if (!is_valid_compare(desc->stencil.back_face.compare))
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create depth stencil state: invalid back face stencil compare function");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	if (!is_valid_action(desc->stencil.front_face.fail) ||
+		!is_valid_action(desc->stencil.front_face.pass) ||
+		!is_valid_action(desc->stencil.front_face.depth_fail))
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create depth stencil state: invalid front face stencil action");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	if (!is_valid_action(desc->stencil.back_face.fail) ||
+		!is_valid_action(desc->stencil.back_face.pass) ||
+		!is_valid_action(desc->stencil.back_face.depth_fail))
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create depth stencil state: invalid back face stencil action");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	// Allocate object
+	mrl_sw_depth_stencil_state_t* obj;
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.depth_stencil_state,
+		(void**)&obj);
+	if (err != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(err);
+
+	// Store depth state info (the depth range is clamped to [0, 1], like glDepthRange does)
+	obj->depth_enabled = desc->depth.enabled;
+	obj->depth_write_enabled = desc->depth.write_enabled;
+	obj->depth_near = clamp_f32(desc->depth.near, 0.0f, 1.0f);
+	obj->depth_far = clamp_f32(desc->depth.far, 0.0f, 1.0f);
+	obj->depth_compare = desc->depth.compare;
+
+	// Store stencil state info
+	obj->stencil_enabled = desc->stencil.enabled;
+	obj->stencil_ref = desc->stencil.ref;
+	obj->stencil_read_mask = desc->stencil.read_mask;
+	obj->stencil_write_mask = desc->stencil.write_mask;
+	obj->stencil[0].compare = desc->stencil.front_face.compare;
+	obj->stencil[0].fail = desc->stencil.front_face.fail;
+	obj->stencil[0].pass = desc->stencil.front_face.pass;
+	obj->stencil[0].depth_fail = desc->stencil.front_face.depth_fail;
+	obj->stencil[1].compare = desc->stencil.back_face.compare;
+	obj->stencil[1].fail = desc->stencil.back_face.fail;
+	obj->stencil[1].pass = desc->stencil.back_face.pass;
+	obj->stencil[1].depth_fail = desc->stencil.back_face.depth_fail;
+	*dss = (mrl_depth_stencil_state_t*)obj;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_depth_stencil_state(mrl_render_device_t* brd, mrl_depth_stencil_state_t* dss)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	mrl_sw_depth_stencil_state_t* obj = (mrl_sw_depth_stencil_state_t*)dss;
+
+	if (rd->state.depth_stencil_state == obj)
+		rd->state.depth_stencil_state = &rd->default_depth_stencil_state;
+
+	// Deallocate object
+	mrl_deallocate_object(
+		&rd->memory.depth_stencil_state,
+		obj);
+}
+
+static void set_depth_stencil_state(mrl_render_device_t* brd, mrl_depth_stencil_state_t* dss)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	// Set depth stencil state
+	if (dss == NULL)
+		rd->state.depth_stencil_state = &rd->default_depth_stencil_state;
+	else
+		rd->state.depth_stencil_state = (const mrl_sw_depth_stencil_state_t*)dss;
+}
+
+// ---------- Blend states ----------
+
+static mrl_error_t create_blend_state(mrl_render_device_t* brd, mrl_blend_state_t** bs, const mrl_blend_state_desc_t* desc)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	// Check for invalid input
+	if (desc->color.src < MRL_BLEND_FACTOR_ZERO || desc->color.src > MRL_BLEND_FACTOR_INV_DST_ALPHA ||
+		desc->color.dst < MRL_BLEND_FACTOR_ZERO || desc->color.dst > MRL_BLEND_FACTOR_INV_DST_ALPHA ||
+		desc->alpha.src < MRL_BLEND_FACTOR_ZERO || desc->alpha.src > MRL_BLEND_FACTOR_INV_DST_ALPHA ||
+		desc->alpha.dst < MRL_BLEND_FACTOR_ZERO || desc->alpha.dst > MRL_BLEND_FACTOR_INV_DST_ALPHA)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create blend state: invalid blend factor");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	if (desc->color.op < MRL_BLEND_OP_ADD || desc->color.op > MRL_BLEND_OP_MAX ||
+		desc->alpha.op < MRL_BLEND_OP_ADD || desc->alpha.op > MRL_BLEND_OP_MAX)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create blend state: invalid blend operation");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	// Allocate object
+	mrl_sw_blend_state_t* obj;
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.blend_state,
+		(void**)&obj);
+	if (err != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(err);
+
+	// Store blend state info
+	obj->blend_enabled = desc->blend_enabled;
+	obj->src_factor = desc->color.src;
+	obj->dst_factor = desc->color.dst;
+	obj->op = desc->color.op;
+	obj->src_alpha_factor = desc->alpha.src;
+	obj->dst_alpha_factor = desc->alpha.dst;
+	obj->alpha_op = desc->alpha.op;
+	*bs = (mrl_blend_state_t*)obj;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_blend_state(mrl_render_device_t* brd, mrl_blend_state_t* bs)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	mrl_sw_blend_state_t* obj = (mrl_sw_blend_state_t*)bs;
+
+	if (rd->state.blend_state == obj)
+		rd->state.blend_state = &rd->default_blend_state;
+
+	// Deallocate object
+	mrl_deallocate_object(
+		&rd->memory.blend_state,
+		obj);
+}
+
+static void set_blend_state(mrl_render_device_t* brd, mrl_blend_state_t* bs)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	// Set blend state
+	if (bs == NULL)
+		rd->state.blend_state = &rd->default_blend_state;
+	else
+		rd->state.blend_state = (const mrl_sw_blend_state_t*)bs;
+}
+
+// ---------- Samplers ----------
+
+static mrl_error_t create_sampler(mrl_render_device_t* brd, mrl_sampler_t** s, const mrl_sampler_desc_t* desc)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	// Check for invalid input
+	if (desc->address_u < MRL_SAMPLER_ADDRESS_REPEAT || desc->address_u > MRL_SAMPLER_ADDRESS_BORDER)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create sampler: invalid U address mode");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	if (desc->address_v < MRL_SAMPLER_ADDRESS_REPEAT || desc->address_v > MRL_SAMPLER_ADDRESS_BORDER)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create sampler: invalid V address mode");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	if (desc->address_w < MRL_SAMPLER_ADDRESS_REPEAT || desc->address_w > MRL_SAMPLER_ADDRESS_BORDER)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create sampler: invalid W address mode");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	if (desc->mip_filter < MRL_SAMPLER_FILTER_NONE || desc->mip_filter > MRL_SAMPLER_FILTER_LINEAR)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create sampler: invalid mipmap filter");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	if (desc->min_filter != MRL_SAMPLER_FILTER_NEAREST && desc->min_filter != MRL_SAMPLER_FILTER_LINEAR)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create sampler: invalid minifying filter");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	if (desc->mag_filter != MRL_SAMPLER_FILTER_NEAREST && desc->mag_filter != MRL_SAMPLER_FILTER_LINEAR)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create sampler: invalid magnifying filter");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	// Allocate object
+	mrl_sw_sampler_t* obj;
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.sampler,
+		(void**)&obj);
+	if (err != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(err);
+
+	// Store sampler info, there is no anisotropic filtering
+	for (mgl_u32_t i = 0; i < 4; ++i)
+		obj->border_color[i] = desc->border_color[i];
+	obj->min_filter = desc->min_filter;
+	obj->mag_filter = desc->mag_filter;
+	obj->mip_filter = desc->mip_filter;
+	obj->address[0] = desc->address_u;
+	obj->address[1] = desc->address_v;
+	obj->address[2] = desc->address_w;
+	*s = (mrl_sampler_t*)obj;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_sampler(mrl_render_device_t* brd, mrl_sampler_t* s)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	mrl_sw_sampler_t* obj = (mrl_sw_sampler_t*)s;
+
+	// Deallocate object
+	mrl_deallocate_object(
+		&rd->memory.sampler,
+		obj);
+}
+
+static void bind_sampler(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_sampler_t* s)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	mrl_sw_binding_point_t* rbp = (mrl_sw_binding_point_t*)bp;
+
+	// Bind sampler
+	if (s == NULL)
+		rbp->sampler = &rd->default_sampler;
+	else
+		rbp->sampler = (const mrl_sw_sampler_t*)s;
+}
+
+// ---------- Textures ----------
+
+static mrl_error_t texture_error(mrl_sw_render_device_t* rd, const mgl_chr8_t* action, const mgl_chr8_t* what, const mgl_chr8_t* reason)
+{
+	if (rd->error_callback != NULL)
+	{
+		mgl_chr8_t msg[256] = { 0 };
+		mgl_buffer_stream_t stream;
+		mgl_init_buffer_stream(&stream, msg, sizeof(msg));
+		mgl_print(&stream, u8"Failed to ");
+		mgl_print(&stream, action);
+		mgl_print(&stream, u8" ");
+		mgl_print(&stream, what);
+		mgl_print(&stream, u8": ");
+		mgl_print(&stream, reason);
+		rd->error_callback(MRL_ERROR_INVALID_PARAMS, msg);
+	}
+
+	return MRL_ERROR_INVALID_PARAMS;
+}
+
+static const mgl_chr8_t* get_texture_type_name(mgl_enum_t type)
+{
+	switch (type)
+	{
+		case MRL_SW_TEXTURE_1D: return u8"1D texture";
+		case MRL_SW_TEXTURE_2D: return u8"2D texture";
+		case MRL_SW_TEXTURE_3D: return u8"3D texture";
+		case MRL_SW_TEXTURE_2D_ARRAY: return u8"2D texture array";
+		case MRL_SW_CUBE_MAP_ARRAY: return u8"cube map array";
+		default: return u8"cube map";
+	}
+}
+
+static mgl_u8_t* get_texel(const mrl_sw_image_t* img, mgl_u32_t texel_size, mgl_u32_t x, mgl_u32_t y, mgl_u32_t z)
+{
+	return img->data + (((mgl_u64_t)z * img->height + y) * img->width + x) * texel_size;
+}
+
+static mrl_error_t create_texture(
+	mrl_sw_render_device_t* rd,
+	mrl_object_pool_t* pool,
+	mgl_enum_t type,
+	mgl_enum_t format,
+	mgl_enum_t usage,
+	mgl_u32_t mip_level_count,
+	mgl_u64_t width,
+	mgl_u64_t height,
+	mgl_u64_t depth,
+	mrl_sw_texture_t** out_tex)
+{
+	const mgl_chr8_t* name = get_texture_type_name(type);
+
+	// Check for invalid input, compressed textures are stored in their decoded format
+	mgl_bool_t compressed = mrl_is_compressed_format(format);
+	mrl_sw_format_info_t info;
+	if (!get_format_info(compressed ? mrl_get_decoded_format(format) : format, &info))
+		return texture_error(rd, u8"create", name, u8"invalid format");
+	if (usage != MRL_TEXTURE_USAGE_DEFAULT && usage != MRL_TEXTURE_USAGE_RENDER_TARGET)
+		return texture_error(rd, u8"create", name, u8"invalid usage mode");
+	if (compressed && (type == MRL_SW_TEXTURE_1D || type == MRL_SW_TEXTURE_3D))
+		return texture_error(rd, u8"create", name, u8"compressed formats are only supported by 2D textures, cube maps and their arrays");
+	if (compressed && usage != MRL_TEXTURE_USAGE_DEFAULT)
+		return texture_error(rd, u8"create", name, u8"compressed textures can't be render targets");
+	if (mip_level_count < 1 || mip_level_count > MRL_MAX_MIP_LEVEL_COUNT)
+		return texture_error(rd, u8"create", name, u8"invalid mip level count");
+	if (width == 0 || height == 0 || depth == 0 || width > 0xFFFF || height > 0xFFFF || depth > 0xFFFF)
+		return texture_error(rd, u8"create", name, u8"invalid size");
+
+	// Allocate object
+	mrl_sw_texture_t* tex;
+	mgl_error_t err = mrl_allocate_object(pool, (void**)&tex);
+	if (err != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(err);
+
+	tex->type = type;
+	tex->format = format;
+	tex->usage = usage;
+	tex->info = info;
+	tex->mip_level_count = mip_level_count;
+
+	// Get level sizes, cube map faces and array layers are stored as layers which aren't halved
+	mgl_u64_t total_size = 0;
+	for (mgl_u32_t i = 0; i < mip_level_count; ++i)
+	{
+		mrl_sw_image_t* img = &tex->levels[i];
+		img->width = (mgl_u32_t)(width >> i > 0 ? width >> i : 1);
+		img->height = (mgl_u32_t)(height >> i > 0 ? height >> i : 1);
+		if (type == MRL_SW_CUBE_MAP || type == MRL_SW_TEXTURE_2D_ARRAY || type == MRL_SW_CUBE_MAP_ARRAY)
+			img->depth = (mgl_u32_t)depth;
+		else
+			img->depth = (mgl_u32_t)(depth >> i > 0 ? depth >> i : 1);
+		total_size += (mgl_u64_t)img->width * img->height * img->depth * info.texel_size;
+	}
+
+	// All levels share a single allocation
+	mgl_u8_t* data;
+	err = mgl_allocate(rd->allocator, total_size, (void**)&data);
+	if (err != MGL_ERROR_NONE)
+	{
+		mrl_deallocate_object(pool, tex);
+		return mrl_make_mgl_error(err);
+	}
+
+	mgl_mem_set(data, total_size, 0);
+	for (mgl_u32_t i = 0; i < mip_level_count; ++i)
+	{
+		tex->levels[i].data = data;
+		data += (mgl_u64_t)tex->levels[i].width * tex->levels[i].height * tex->levels[i].depth * info.texel_size;
+	}
+
+	*out_tex = tex;
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_texture(mrl_sw_render_device_t* rd, mrl_object_pool_t* pool, mrl_sw_texture_t* tex)
+{
+	mgl_deallocate(rd->allocator, tex->levels[0].data);
+	mrl_deallocate_object(pool, tex);
+}
+
+static mrl_error_t update_texture(
+	mrl_sw_render_device_t* rd,
+	mrl_sw_texture_t* tex,
+	mgl_u32_t mip_level,
+	mgl_u64_t layer,
+	mgl_u64_t x,
+	mgl_u64_t y,
+	mgl_u64_t z,
+	mgl_u64_t width,
+	mgl_u64_t height,
+	mgl_u64_t depth,
+	const void* data)
+{
+	const mgl_chr8_t* name = get_texture_type_name(tex->type);
+
+	// Check for invalid input
+	if (data == NULL)
+		return texture_error(rd, u8"update", name, u8"the data pointer must not be NULL");
+	if (mip_level >= tex->mip_level_count)
+		return texture_error(rd, u8"update", name, u8"invalid mip level");
+
+	const mrl_sw_image_t* img = &tex->levels[mip_level];
+	if (x + width > img->width || y + height > img->height || z + depth > img->depth)
+		return texture_error(rd, u8"update", name, u8"the region is out of bounds");
+
+	// Data is tightly packed, with the same layout as the texture storage
+	mgl_u64_t row_size = width * tex->info.texel_size;
+	const mgl_u8_t* src = (const mgl_u8_t*)data;
+
+	// Compressed data is decoded into a temporary image first
+	mgl_u8_t* decoded = NULL;
+	if (mrl_is_compressed_format(tex->format))
+	{
+		if (x % 4 != 0 || y % 4 != 0 || (width % 4 != 0 && x + width != img->width) || (height % 4 != 0 && y + height != img->height))
+			return texture_error(rd, u8"update", name, u8"compressed regions must be aligned to 4x4 blocks");
+
+		mgl_error_t err = mgl_allocate(rd->allocator, row_size * height, (void**)&decoded);
+		if (err != MGL_ERROR_NONE)
+			return mrl_make_mgl_error(err);
+		mrl_decode_texture(tex->format, width, height, data, decoded, row_size);
+		src = decoded;
+	}
+
+	for (mgl_u64_t k = 0; k < depth; ++k)
+		for (mgl_u64_t j = 0; j < height; ++j)
+		{
+			mgl_mem_copy(get_texel(img, tex->info.texel_size, (mgl_u32_t)x, (mgl_u32_t)(y + j), (mgl_u32_t)(layer + z + k)), src, row_size);
+			src += row_size;
+		}
+
+	if (decoded != NULL)
+		mgl_deallocate(rd->allocator, decoded);
+	return MRL_ERROR_NONE;
+}
+
+static void generate_mipmaps(mrl_sw_render_device_t* rd, mrl_sw_texture_t* tex, const mgl_chr8_t* msg)
+{
+	const mrl_sw_format_info_t* info = &tex->info;
+	mgl_bool_t layered = tex->type == MRL_SW_CUBE_MAP || tex->type == MRL_SW_TEXTURE_2D_ARRAY || tex->type == MRL_SW_CUBE_MAP_ARRAY;
+
+	// Only the levels allocated on creation are generated, like on the other devices
+	if (tex->mip_level_count == 1 && (tex->levels[0].width > 1 || tex->levels[0].height > 1 || (!layered && tex->levels[0].depth > 1)))
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, msg);
+		return;
+	}
+
+	// Box filter each level from the previous one, cube map faces and array layers are filtered separately
+	for (mgl_u32_t l = 1; l < tex->mip_level_count; ++l)
+	{
+		const mrl_sw_image_t* src = &tex->levels[l - 1];
+		const mrl_sw_image_t* dst = &tex->levels[l];
+
+		for (mgl_u32_t z = 0; z < dst->depth; ++z)
+		{
+			mgl_u32_t z0 = layered ? z : (2 * z < src->depth ? 2 * z : src->depth - 1);
+			mgl_u32_t z1 = layered ? z : (2 * z + 1 < src->depth ? 2 * z + 1 : src->depth - 1);
+
+			for (mgl_u32_t y = 0; y < dst->height; ++y)
+			{
+				mgl_u32_t y0 = 2 * y < src->height ? 2 * y : src->height - 1;
+				mgl_u32_t y1 = 2 * y + 1 < src->height ? 2 * y + 1 : src->height - 1;
+
+				for (mgl_u32_t x = 0; x < dst->width; ++x)
+				{
+					mgl_u32_t x0 = 2 * x < src->width ? 2 * x : src->width - 1;
+					mgl_u32_t x1 = 2 * x + 1 < src->width ? 2 * x + 1 : src->width - 1;
+
+					mgl_f32_t sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+					mgl_f32_t v[4];
+					const mgl_u32_t xs[2] = { x0, x1 }, ys[2] = { y0, y1 }, zs[2] = { z0, z1 };
+					for (mgl_u32_t i = 0; i < 8; ++i)
+					{
+						load_texel(info, get_texel(src, info->texel_size, xs[i & 1], ys[(i >> 1) & 1], zs[i >> 2]), v);
+						for (mgl_u32_t c = 0; c < 4; ++c)
+							sum[c] += v[c];
+					}
+
+					for (mgl_u32_t c = 0; c < 4; ++c)
+						sum[c] *= 0.125f;
+					store_texel(info, get_texel(dst, info->texel_size, x, y, z), sum);
+				}
+			}
+		}
+	}
+}
+
+static void bind_texture(mrl_shader_binding_point_t* bp, const mrl_sw_texture_t* tex)
+{
+	mrl_sw_binding_point_t* rbp = (mrl_sw_binding_point_t*)bp;
+	rbp->texture = tex;
+}
+
+// ---------- Texture 1D ----------
+
+static mrl_error_t create_texture_1d(mrl_render_device_t* brd, mrl_texture_1d_t** tex, const mrl_texture_1d_desc_t* desc)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	mrl_sw_texture_t* obj;
+	mrl_error_t err = create_texture(rd, &rd->memory.texture_1d, MRL_SW_TEXTURE_1D, desc->format, desc->usage, desc->mip_level_count, desc->width, 1, 1, &obj);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	// Upload initial data
+	for (mgl_u32_t i = 0; i < obj->mip_level_count; ++i)
+		if (desc->data[i] != NULL)
+			update_texture(rd, obj, i, 0, 0, 0, 0, obj->levels[i].width, 1, 1, desc->data[i]);
+
+	*tex = (mrl_texture_1d_t*)obj;
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_texture_1d(mrl_render_device_t* brd, mrl_texture_1d_t* tex)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	destroy_texture(rd, &rd->memory.texture_1d, (mrl_sw_texture_t*)tex);
+}
+
+static void generate_texture_1d_mipmaps(mrl_render_device_t* brd, mrl_texture_1d_t* tex)
+{
+	generate_mipmaps((mrl_sw_render_device_t*)brd, (mrl_sw_texture_t*)tex, u8"Failed to generate 1D texture mipmaps: the texture was created with a single mip level");
+}
+
+static void bind_texture_1d(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_texture_1d_t* tex)
+{
+	bind_texture(bp, (const mrl_sw_texture_t*)tex);
+}
+
+static mrl_error_t update_texture_1d(mrl_render_device_t* brd, mrl_texture_1d_t* tex, const mrl_texture_1d_update_desc_t* desc)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	return update_texture(rd, (mrl_sw_texture_t*)tex, desc->mip_level, 0, desc->dst_x, 0, 0, desc->width, 1, 1, desc->data);
+}
+
+// ---------- Texture 2D ----------
+
+static mrl_error_t create_texture_2d(mrl_render_device_t* brd, mrl_texture_2d_t** tex, const mrl_texture_2d_desc_t* desc)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	mrl_sw_texture_t* obj;
+	mrl_error_t err = create_texture(rd, &rd->memory.texture_2d, MRL_SW_TEXTURE_2D, desc->format, desc->usage, desc->mip_level_count, desc->width, desc->height, 1, &obj);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	// Upload initial data
+	for (mgl_u32_t i = 0; i < obj->mip_level_count; ++i)
+		if (desc->data[i] != NULL)
+			update_texture(rd, obj, i, 0, 0, 0, 0, obj->levels[i].width, obj->levels[i].height, 1, desc->data[i]);
+
+	*tex = (mrl_texture_2d_t*)obj;
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_texture_2d(mrl_render_device_t* brd, mrl_texture_2d_t* tex)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	destroy_texture(rd, &rd->memory.texture_2d, (mrl_sw_texture_t*)tex);
+}
+
+static void generate_texture_2d_mipmaps(mrl_render_device_t* brd, mrl_texture_2d_t* tex)
+{
+	generate_mipmaps((mrl_sw_render_device_t*)brd, (mrl_sw_texture_t*)tex, u8"Failed to generate 2D texture mipmaps: the texture was created with a single mip level");
+}
+
+static void bind_texture_2d(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_texture_2d_t* tex)
+{
+	bind_texture(bp, (const mrl_sw_texture_t*)tex);
+}
+
+static mrl_error_t update_texture_2d(mrl_render_device_t* brd, mrl_texture_2d_t* tex, const mrl_texture_2d_update_desc_t* desc)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	return update_texture(rd, (mrl_sw_texture_t*)tex, desc->mip_level, 0, desc->dst_x, desc->dst_y, 0, desc->width, desc->height, 1, desc->data);
+}
+
+// ---------- Texture 3D ----------
+
+static mrl_error_t create_texture_3d(mrl_render_device_t* brd, mrl_texture_3d_t** tex, const mrl_texture_3d_desc_t* desc)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	mrl_sw_texture_t* obj;
+	mrl_error_t err = create_texture(rd, &rd->memory.texture_3d, MRL_SW_TEXTURE_3D, desc->format, desc->usage, desc->mip_level_count, desc->width, desc->height, desc->depth, &obj);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	// Upload initial data
+	for (mgl_u32_t i = 0; i < obj->mip_level_count; ++i)
+		if (desc->data[i] != NULL)
+			update_texture(rd, obj, i, 0, 0, 0, 0, obj->levels[i].width, obj->levels[i].height, obj->levels[i].depth, desc->data[i]);
+
+	*tex = (mrl_texture_3d_t*)obj;
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_texture_3d(mrl_render_device_t* brd, mrl_texture_3d_t* tex)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	destroy_texture(rd, &rd->memory.texture_3d, (mrl_sw_texture_t*)tex);
+}
+
+static void generate_texture_3d_mipmaps(mrl_render_device_t* brd, mrl_texture_3d_t* tex)
+{
+	generate_mipmaps((mrl_sw_render_device_t*)brd, (mrl_sw_texture_t*)tex, u8"Failed to generate 3D texture mipmaps: the texture was created with a single mip level");
+}
+
+static void bind_texture_3d(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_texture_3d_t* tex)
+{
+	bind_texture(bp, (const mrl_sw_texture_t*)tex);
+}
+
+static mrl_error_t update_texture_3d(mrl_render_device_t* brd, mrl_texture_3d_t* tex, const mrl_texture_3d_update_desc_t* desc)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	return update_texture(rd, (mrl_sw_texture_t*)tex, desc->mip_level, 0, desc->dst_x, desc->dst_y, desc->dst_z, desc->width, desc->height, desc->depth, desc->data);
+}
+
+// ---------- Cube maps ----------
+
+static mrl_error_t create_cube_map(mrl_render_device_t* brd, mrl_cube_map_t** cb, const mrl_cube_map_desc_t* desc)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	mrl_sw_texture_t* obj;
+	mrl_error_t err = create_texture(rd, &rd->memory.cube_map, MRL_SW_CUBE_MAP, desc->format, desc->usage, desc->mip_level_count, desc->width, desc->height, 6, &obj);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	// Upload initial data
+	for (mgl_u32_t f = 0; f < 6; ++f)
+		for (mgl_u32_t i = 0; i < obj->mip_level_count; ++i)
+			if (desc->data[f][i] != NULL)
+				update_texture(rd, obj, i, f, 0, 0, 0, obj->levels[i].width, obj->levels[i].height, 1, desc->data[f][i]);
+
+	*cb = (mrl_cube_map_t*)obj;
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_cube_map(mrl_render_device_t* brd, mrl_cube_map_t* cb)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	destroy_texture(rd, &rd->memory.cube_map, (mrl_sw_texture_t*)cb);
+}
+
+static void generate_cube_map_mipmaps(mrl_render_device_t* brd, mrl_cube_map_t* cb)
+{
+	generate_mipmaps((mrl_sw_render_device_t*)brd, (mrl_sw_texture_t*)cb, u8"Failed to generate cube map mipmaps: the texture was created with a single mip level");
+}
+
+static void bind_cube_map(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_cube_map_t* cb)
+{
+	bind_texture(bp, (const mrl_sw_texture_t*)cb);
+}
+
+static mrl_error_t update_cube_map(mrl_render_device_t* brd, mrl_cube_map_t* cb, const mrl_cube_map_update_desc_t* desc)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	if (desc->face < MRL_CUBE_MAP_FACE_POSITIVE_X || desc->face > MRL_CUBE_MAP_FACE_NEGATIVE_Z)
+		return texture_error(rd, u8"update", u8"cube map", u8"invalid face");
+
+	return update_texture(rd, (mrl_sw_texture_t*)cb, desc->mip_level, desc->face, desc->dst_x, desc->dst_y, 0, desc->width, desc->height, 1, desc->data);
+}
+
+// ---------- Texture 2D array ----------
+
+// Updates a range of layers, whose data is stored one after the other
+static mrl_error_t update_texture_layers(mrl_sw_render_device_t* rd, mrl_sw_texture_t* tex, mgl_u32_t mip_level, mgl_u64_t first_layer, mgl_u64_t layer_count, mgl_u64_t x, mgl_u64_t y, mgl_u64_t width, mgl_u64_t height, const void* data)
+{
+	if (mip_level < tex->mip_level_count && (first_layer >= tex->levels[mip_level].depth || layer_count > tex->levels[mip_level].depth - first_layer))
+		return texture_error(rd, u8"update", get_texture_type_name(tex->type), u8"the layer range is out of bounds");
+
+	// Each layer is updated on its own, so that compressed layers are decoded separately
+	mgl_u64_t layer_size = mrl_is_compressed_format(tex->format) ?
+		mrl_get_compressed_data_size(tex->format, width, height, 1) :
+		width * height * tex->info.texel_size;
+	for (mgl_u64_t i = 0; i < layer_count; ++i)
+	{
+		mrl_error_t err = update_texture(rd, tex, mip_level, first_layer + i, x, y, 0, width, height, 1, data == NULL ? NULL : (const mgl_u8_t*)data + i * layer_size);
+		if (err != MRL_ERROR_NONE)
+			return err;
+	}
+
+	return MRL_ERROR_NONE;
+}
+
+static mrl_error_t create_texture_2d_array(mrl_render_device_t* brd, mrl_texture_2d_array_t** tex, const mrl_texture_2d_array_desc_t* desc)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	if (desc->layer_count > MRL_MAX_TEXTURE_2D_ARRAY_LAYER_COUNT)
+		return texture_error(rd, u8"create", u8"2D texture array", u8"invalid layer count");
+
+	mrl_sw_texture_t* obj;
+	mrl_error_t err = create_texture(rd, &rd->memory.texture_2d_array, MRL_SW_TEXTURE_2D_ARRAY, desc->format, desc->usage, desc->mip_level_count, desc->width, desc->height, desc->layer_count, &obj);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	// Upload initial data
+	for (mgl_u32_t i = 0; i < obj->mip_level_count; ++i)
+		if (desc->data[i] != NULL)
+			update_texture_layers(rd, obj, i, 0, obj->levels[i].depth, 0, 0, obj->levels[i].width, obj->levels[i].height, desc->data[i]);
+
+	*tex = (mrl_texture_2d_array_t*)obj;
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_texture_2d_array(mrl_render_device_t* brd, mrl_texture_2d_array_t* tex)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	destroy_texture(rd, &rd->memory.texture_2d_array, (mrl_sw_texture_t*)tex);
+}
+
+static void generate_texture_2d_array_mipmaps(mrl_render_device_t* brd, mrl_texture_2d_array_t* tex)
+{
+	generate_mipmaps((mrl_sw_render_device_t*)brd, (mrl_sw_texture_t*)tex, u8"Failed to generate 2D texture array mipmaps: the texture was created with a single mip level");
+}
+
+static void bind_texture_2d_array(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_texture_2d_array_t* tex)
+{
+	bind_texture(bp, (const mrl_sw_texture_t*)tex);
+}
+
+static mrl_error_t update_texture_2d_array(mrl_render_device_t* brd, mrl_texture_2d_array_t* tex, const mrl_texture_2d_array_update_desc_t* desc)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	return update_texture_layers(rd, (mrl_sw_texture_t*)tex, desc->mip_level, desc->dst_layer, desc->layer_count, desc->dst_x, desc->dst_y, desc->width, desc->height, desc->data);
+}
+
+// ---------- Cube map arrays ----------
+
+static mrl_error_t create_cube_map_array(mrl_render_device_t* brd, mrl_cube_map_array_t** tex, const mrl_cube_map_array_desc_t* desc)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	if (desc->layer_count > MRL_MAX_CUBE_MAP_ARRAY_LAYER_COUNT)
+		return texture_error(rd, u8"create", u8"cube map array", u8"invalid layer count");
+	if (desc->usage != MRL_TEXTURE_USAGE_DEFAULT)
+		return texture_error(rd, u8"create", u8"cube map array", u8"invalid usage mode");
+
+	// Every cube is stored as six layers, one per face
+	mrl_sw_texture_t* obj;
+	mrl_error_t err = create_texture(rd, &rd->memory.cube_map_array, MRL_SW_CUBE_MAP_ARRAY, desc->format, desc->usage, desc->mip_level_count, desc->width, desc->height, desc->layer_count * 6, &obj);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	// Upload initial data
+	for (mgl_u32_t i = 0; i < obj->mip_level_count; ++i)
+		if (desc->data[i] != NULL)
+			update_texture_layers(rd, obj, i, 0, obj->levels[i].depth, 0, 0, obj->levels[i].width, obj->levels[i].height, desc->data[i]);
+
+	*tex = (mrl_cube_map_array_t*)obj;
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_cube_map_array(mrl_render_device_t* brd, mrl_cube_map_array_t* tex)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	destroy_texture(rd, &rd->memory.cube_map_array, (mrl_sw_texture_t*)tex);
+}
+
+static void generate_cube_map_array_mipmaps(mrl_render_device_t* brd, mrl_cube_map_array_t* tex)
+{
+	generate_mipmaps((mrl_sw_render_device_t*)brd, (mrl_sw_texture_t*)tex, u8"Failed to generate cube map array mipmaps: the texture was created with a single mip level");
+}
+
+static void bind_cube_map_array(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_cube_map_array_t* tex)
+{
+	bind_texture(bp, (const mrl_sw_texture_t*)tex);
+}
+
+static mrl_error_t update_cube_map_array(mrl_render_device_t* brd, mrl_cube_map_array_t* tex, const mrl_cube_map_array_update_desc_t* desc)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	return update_texture_layers(rd, (mrl_sw_texture_t*)tex, desc->mip_level, desc->dst_face, desc->face_count, desc->dst_x, desc->dst_y, desc->width, desc->height, desc->data);
+}
+
+// ---------- Buffers ----------
+
+static mrl_error_t create_buffer(mrl_sw_render_device_t* rd, mrl_object_pool_t* pool, const void* data, mgl_u64_t size, mgl_enum_t usage, mgl_enum_t format, mrl_sw_buffer_t** out_buf)
+{
+	// Allocate object
+	mrl_sw_buffer_t* buf;
+	mgl_error_t err = mrl_allocate_object(pool, (void**)&buf);
+	if (err != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(err);
+
+	// Allocate storage
+	buf->data = NULL;
+	if (size > 0)
+	{
+		err = mgl_allocate(rd->allocator, size, (void**)&buf->data);
+		if (err != MGL_ERROR_NONE)
+		{
+			mrl_deallocate_object(pool, buf);
+			return mrl_make_mgl_error(err);
+		}
+
+		if (data != NULL)
+			mgl_mem_copy(buf->data, data, size);
+		else
+			mgl_mem_set(buf->data, size, 0);
+	}
+
+	buf->size = size;
+	buf->usage = usage;
+	buf->format = format;
+	*out_buf = buf;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_buffer(mrl_sw_render_device_t* rd, mrl_object_pool_t* pool, mrl_sw_buffer_t* buf)
+{
+	if (buf->data != NULL)
+		mgl_deallocate(rd->allocator, buf->data);
+	mrl_deallocate_object(pool, buf);
+}
+
+static void* map_buffer_range(mrl_sw_render_device_t* rd, mrl_sw_buffer_t* buf, mgl_u64_t offset, mgl_u64_t size, mgl_u32_t flags)
+{
+	// Check for invalid input
+	if ((flags & (MRL_MAP_READ | MRL_MAP_WRITE)) == 0)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to map buffer range: either MRL_MAP_READ or MRL_MAP_WRITE must be set");
+		return NULL;
+	}
+
+	if ((flags & MRL_MAP_READ) && (flags & (MRL_MAP_DISCARD_RANGE | MRL_MAP_DISCARD_WHOLE)))
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to map buffer range: discard flags cannot be used with MRL_MAP_READ");
+		return NULL;
+	}
+
+	if ((flags & MRL_MAP_READ) && (flags & MRL_MAP_NO_OVERWRITE))
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to map buffer range: MRL_MAP_NO_OVERWRITE cannot be used with MRL_MAP_READ");
+		return NULL;
+	}
+
+	if ((flags & MRL_MAP_FLUSH_EXPLICIT) && !(flags & MRL_MAP_WRITE))
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to map buffer range: MRL_MAP_FLUSH_EXPLICIT requires MRL_MAP_WRITE");
+		return NULL;
+	}
+
+	if (offset > buf->size || size > buf->size - offset)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to map buffer range: the range is out of bounds");
+		return NULL;
+	}
+
+	// Draws are finished before they return, so the storage can always be accessed directly
+	return buf->data + offset;
+}
+
+static void update_buffer(mrl_sw_render_device_t* rd, mrl_sw_buffer_t* buf, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	if (offset > buf->size || size > buf->size - offset)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to update buffer: the range is out of bounds");
+		return;
+	}
+
+	mgl_mem_copy(buf->data + offset, data, size);
+}
+
+// ---------- Constant buffers ----------
+
+static mrl_error_t create_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t** cb, const mrl_constant_buffer_desc_t* desc)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	// Check for invalid input
+	if (desc->usage == MRL_CONSTANT_BUFFER_USAGE_STATIC && desc->data == NULL)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create constant buffer: when the usage mode is set to static, the pointer to the initial data must not be NULL");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	if (desc->usage < MRL_CONSTANT_BUFFER_USAGE_DEFAULT || desc->usage > MRL_CONSTANT_BUFFER_USAGE_STREAM)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create constant buffer: invalid usage mode");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	return create_buffer(rd, &rd->memory.constant_buffer, desc->data, desc->size, desc->usage, 0, (mrl_sw_buffer_t**)cb);
+}
+
+static void destroy_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t* cb)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	destroy_buffer(rd, &rd->memory.constant_buffer, (mrl_sw_buffer_t*)cb);
+}
+
+static void bind_constant_buffer(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_constant_buffer_t* cb)
+{
+	mrl_sw_buffer_t* obj = (mrl_sw_buffer_t*)cb;
+	mrl_sw_binding_point_t* rbp = (mrl_sw_binding_point_t*)bp;
+
+	// Bind constant buffer
+	if (cb == NULL)
+	{
+		rbp->constants = NULL;
+		rbp->constants_size = 0;
+	}
+	else
+	{
+		rbp->constants = obj->data;
+		rbp->constants_size = obj->size;
+	}
+}
+
+static void bind_constant_buffer_range(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	mrl_sw_buffer_t* obj = (mrl_sw_buffer_t*)cb;
+	mrl_sw_binding_point_t* rbp = (mrl_sw_binding_point_t*)bp;
+
+	// Check for invalid input
+	if (offset % MRL_SW_CONSTANT_BUFFER_OFFSET_ALIGNMENT != 0)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to bind constant buffer range: the offset isn't aligned to MRL_PROPERTY_CONSTANT_BUFFER_OFFSET_ALIGNMENT");
+		return;
+	}
+
+	if (offset > obj->size || size > obj->size - offset)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to bind constant buffer range: the range is out of bounds");
+		return;
+	}
+
+	// Bind constant buffer range
+	rbp->constants = obj->data + offset;
+	rbp->constants_size = size;
+}
+
+static void* map_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t* cb)
+{
+	return ((mrl_sw_buffer_t*)cb)->data;
+}
+
+static void unmap_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t* cb)
+{
+	// Nothing to do, the mapped pointer is the storage itself
+}
+
+static void* map_constant_buffer_range(mrl_render_device_t* brd, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size, mgl_u32_t flags)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	return map_buffer_range(rd, (mrl_sw_buffer_t*)cb, offset, size, flags);
+}
+
+static void flush_constant_buffer_range(mrl_render_device_t* brd, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size)
+{
+	// Nothing to do, writes go directly to the storage
+}
+
+static void update_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	update_buffer(rd, (mrl_sw_buffer_t*)cb, offset, size, data);
+}
+
+static void query_constant_buffer_structure(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_constant_buffer_structure_t* cbs)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	mrl_sw_binding_point_t* rbp = (mrl_sw_binding_point_t*)bp;
+
+	// Native shaders read their constants as C structures, so there is no layout to reflect
+	cbs->size = rbp->constants_size;
+	cbs->element_count = 0;
+
+	if (rd->warning_callback != NULL)
+		rd->warning_callback(MRL_ERROR_NONE, u8"Constant buffer structures can't be queried from native shaders, only the bound size is returned");
+}
+
+// ---------- Index buffers ----------
+
+static mrl_error_t create_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t** ib, const mrl_index_buffer_desc_t* desc)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	// Check for invalid input
+	if (desc->usage == MRL_INDEX_BUFFER_USAGE_STATIC && desc->data == NULL)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create index buffer: when the usage mode is set to static, the pointer to the initial data must not be NULL");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	if (desc->format != MRL_INDEX_BUFFER_FORMAT_U16 && desc->format != MRL_INDEX_BUFFER_FORMAT_U32)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create index buffer: invalid index format");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	if (desc->usage < MRL_INDEX_BUFFER_USAGE_DEFAULT || desc->usage > MRL_INDEX_BUFFER_USAGE_STREAM)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create index buffer: invalid usage mode");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	return create_buffer(rd, &rd->memory.index_buffer, desc->data, desc->size, desc->usage, desc->format, (mrl_sw_buffer_t**)ib);
+}
+
+static void destroy_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	if (rd->state.index_buffer == ib)
+		rd->state.index_buffer = NULL;
+	destroy_buffer(rd, &rd->memory.index_buffer, (mrl_sw_buffer_t*)ib);
+}
+
+static void set_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	rd->state.index_buffer = (const mrl_sw_buffer_t*)ib;
+}
+
+static void* map_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib)
+{
+	return ((mrl_sw_buffer_t*)ib)->data;
+}
+
+static void unmap_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib)
+{
+	// Nothing to do, the mapped pointer is the storage itself
+}
+
+static void* map_index_buffer_range(mrl_render_device_t* brd, mrl_index_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size, mgl_u32_t flags)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	return map_buffer_range(rd, (mrl_sw_buffer_t*)ib, offset, size, flags);
+}
+
+static void flush_index_buffer_range(mrl_render_device_t* brd, mrl_index_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size)
+{
+	// Nothing to do, writes go directly to the storage
+}
+
+static void update_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	update_buffer(rd, (mrl_sw_buffer_t*)ib, offset, size, data);
+}
+
+// ---------- Indirect buffers ----------
+
+static mrl_error_t create_indirect_buffer(mrl_render_device_t* brd, mrl_indirect_buffer_t** ib, const mrl_indirect_buffer_desc_t* desc)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	// Check for invalid input
+	if (desc->usage == MRL_INDIRECT_BUFFER_USAGE_STATIC && desc->data == NULL)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create indirect buffer: when the usage mode is set to static, the pointer to the initial data must not be NULL");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	if (desc->usage < MRL_INDIRECT_BUFFER_USAGE_DEFAULT || desc->usage > MRL_INDIRECT_BUFFER_USAGE_STREAM)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create indirect buffer: invalid usage mode");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	return create_buffer(rd, &rd->memory.indirect_buffer, desc->data, desc->size, desc->usage, 0, (mrl_sw_buffer_t**)ib);
+}
+
+static void destroy_indirect_buffer(mrl_render_device_t* brd, mrl_indirect_buffer_t* ib)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	destroy_buffer(rd, &rd->memory.indirect_buffer, (mrl_sw_buffer_t*)ib);
+}
+
+static void update_indirect_buffer(mrl_render_device_t* brd, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	update_buffer(rd, (mrl_sw_buffer_t*)ib, offset, size, data);
+}
+
+// ---------- Vertex buffers ----------
+
+static mrl_error_t create_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t** vb, const mrl_vertex_buffer_desc_t* desc)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	// Check for invalid input
+	if (desc->usage == MRL_VERTEX_BUFFER_USAGE_STATIC && desc->data == NULL)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create vertex buffer: when the usage mode is set to static, the pointer to the initial data must not be NULL");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	if (desc->usage < MRL_VERTEX_BUFFER_USAGE_DEFAULT || desc->usage > MRL_VERTEX_BUFFER_USAGE_STREAM)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create vertex buffer: invalid usage mode");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	return create_buffer(rd, &rd->memory.vertex_buffer, desc->data, desc->size, desc->usage, 0, (mrl_sw_buffer_t**)vb);
+}
+
+static void destroy_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	destroy_buffer(rd, &rd->memory.vertex_buffer, (mrl_sw_buffer_t*)vb);
+}
+
+static void* map_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb)
+{
+	return ((mrl_sw_buffer_t*)vb)->data;
+}
+
+static void unmap_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb)
+{
+	// Nothing to do, the mapped pointer is the storage itself
+}
+
+static void* map_vertex_buffer_range(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb, mgl_u64_t offset, mgl_u64_t size, mgl_u32_t flags)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	return map_buffer_range(rd, (mrl_sw_buffer_t*)vb, offset, size, flags);
+}
+
+static void flush_vertex_buffer_range(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb, mgl_u64_t offset, mgl_u64_t size)
+{
+	// Nothing to do, writes go directly to the storage
+}
+
+static void update_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	update_buffer(rd, (mrl_sw_buffer_t*)vb, offset, size, data);
+}
+
+// ---------- Vertex arrays ----------
+
+static mrl_error_t create_vertex_array(mrl_render_device_t* brd, mrl_vertex_array_t** va, const mrl_vertex_array_desc_t* desc)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	MGL_DEBUG_ASSERT(desc->shader_pipeline != NULL);
+	const mrl_sw_shader_pipeline_t* pp = (const mrl_sw_shader_pipeline_t*)desc->shader_pipeline;
+
+	MGL_DEBUG_ASSERT(desc->element_count <= MRL_MAX_VERTEX_ARRAY_ELEMENT_COUNT);
+	MGL_DEBUG_ASSERT(desc->buffer_count <= MRL_MAX_VERTEX_ARRAY_BUFFER_COUNT);
+
+	mrl_sw_vertex_array_t tmp;
+	tmp.element_count = desc->element_count;
+
+	// Link elements
+	for (mgl_u32_t i = 0; i < desc->element_count; ++i)
+	{
+		// Get buffer
+		MGL_DEBUG_ASSERT(desc->elements[i].buffer.index < desc->buffer_count);
+		const mrl_sw_buffer_t* vbo = (const mrl_sw_buffer_t*)desc->buffers[desc->elements[i].buffer.index];
+		MGL_DEBUG_ASSERT(vbo != NULL);
+
+		// Get vertex shader input
+		mgl_u32_t input;
+		for (input = 0; input < pp->input_count; ++input)
+			if (mgl_str_equal(pp->inputs[input], desc->elements[i].name))
+				break;
+
+		if (input == pp->input_count)
+		{
+			if (rd->error_callback != NULL)
+			{
+				mgl_chr8_t msg[512] = { 0 };
+				mgl_buffer_stream_t stream;
+				mgl_init_buffer_stream(&stream, msg, sizeof(msg));
+				mgl_print(&stream, u8"Failed to create vertex array, couldn't find vertex element \"");
+				mgl_print(&stream, desc->elements[i].name);
+				mgl_print(&stream, u8"\"");
+				rd->error_callback(MRL_ERROR_VERTEX_ELEMENT_NOT_FOUND, msg);
+			}
+			return MRL_ERROR_VERTEX_ELEMENT_NOT_FOUND;
+		}
+
+		// Check type
+		if (desc->elements[i].type < MRL_VERTEX_ELEMENT_TYPE_I8 || desc->elements[i].type > MRL_VERTEX_ELEMENT_TYPE_F32)
+		{
+			if (rd->error_callback != NULL)
+				rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create vertex array, invalid vertex element type");
+			return MRL_ERROR_INVALID_PARAMS;
+		}
+
+		MGL_DEBUG_ASSERT(desc->elements[i].size >= 1 && desc->elements[i].size <= 4);
+
+		tmp.elements[i].buffer = vbo;
+		tmp.elements[i].offset = desc->elements[i].buffer.offset;
+		tmp.elements[i].stride = desc->elements[i].buffer.stride;
+		tmp.elements[i].type = desc->elements[i].type;
+		tmp.elements[i].size = desc->elements[i].size;
+		tmp.elements[i].input = input;
+		tmp.elements[i].instance_step_rate = desc->elements[i].instance_step_rate;
+	}
+
+	// Allocate object
+	mrl_sw_vertex_array_t* obj;
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.vertex_array,
+		(void**)&obj);
+	if (err != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(err);
+
+	// Store vertex array info
+	*obj = tmp;
+	*va = (mrl_vertex_array_t*)obj;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_vertex_array(mrl_render_device_t* brd, mrl_vertex_array_t* va)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	mrl_sw_vertex_array_t* obj = (mrl_sw_vertex_array_t*)va;
+
+	if (rd->state.vertex_array == obj)
+		rd->state.vertex_array = NULL;
+
+	// Deallocate object
+	mrl_deallocate_object(
+		&rd->memory.vertex_array,
+		obj);
+}
+
+static void set_vertex_array(mrl_render_device_t* brd, mrl_vertex_array_t* va)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	rd->state.vertex_array = (const mrl_sw_vertex_array_t*)va;
+}
+
+// ---------- Stream allocators ----------
+
+static mrl_error_t create_stream_allocator(mrl_render_device_t* brd, mrl_stream_allocator_t** sa, const mrl_stream_allocator_desc_t* desc)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	// Check for invalid input
+	if (desc->buffer == NULL)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create stream allocator: the buffer must not be NULL");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	if (desc->buffer_type != MRL_STREAM_ALLOCATOR_BUFFER_VERTEX &&
+		desc->buffer_type != MRL_STREAM_ALLOCATOR_BUFFER_INDEX &&
+		desc->buffer_type != MRL_STREAM_ALLOCATOR_BUFFER_CONSTANT)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create stream allocator: invalid buffer type");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	// Allocate object
+	mrl_sw_stream_allocator_t* obj;
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.stream_allocator,
+		(void**)&obj);
+	if (err != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(err);
+
+	// Store stream allocator info, every buffer type shares the same representation
+	obj->buffer = (mrl_sw_buffer_t*)desc->buffer;
+	obj->head = 0;
+	obj->frame_used = 0;
+	*sa = (mrl_stream_allocator_t*)obj;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_stream_allocator(mrl_render_device_t* brd, mrl_stream_allocator_t* sa)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	// Deallocate object
+	mrl_deallocate_object(
+		&rd->memory.stream_allocator,
+		sa);
+}
+
+static void* map_stream_allocation(mrl_render_device_t* brd, mrl_stream_allocator_t* sa, mgl_u64_t size, mgl_u64_t alignment, mgl_u64_t* offset)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	mrl_sw_stream_allocator_t* obj = (mrl_sw_stream_allocator_t*)sa;
+
+	// Align head, wrapping around if the allocation doesn't fit on the end of the buffer
+	mgl_u64_t begin = obj->head;
+	if (alignment > 1 && begin % alignment != 0)
+		begin += alignment - begin % alignment;
+	if (begin + size > obj->buffer->size)
+		begin = 0;
+
+	// Draws finish before returning, so only the allocations of the current frame must be kept
+	mgl_u64_t advance = (begin >= obj->head ? begin - obj->head : obj->buffer->size - obj->head) + size;
+	if (size > obj->buffer->size || obj->frame_used + advance > obj->buffer->size)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to map stream allocation: the frame allocations don't fit on the buffer");
+		return NULL;
+	}
+
+	obj->head = begin + size;
+	obj->frame_used += advance;
+	*offset = begin;
+
+	return obj->buffer->data + begin;
+}
+
+static void unmap_stream_allocation(mrl_render_device_t* brd, mrl_stream_allocator_t* sa)
+{
+	// Nothing to do, the mapped pointer is the storage itself
+}
+
+static void end_stream_allocator_frame(mrl_render_device_t* brd, mrl_stream_allocator_t* sa)
+{
+	mrl_sw_stream_allocator_t* obj = (mrl_sw_stream_allocator_t*)sa;
+
+	// There are no fences to wait for, the frame region is free to be reused right away
+	obj->frame_used = 0;
+}
+
+// ---------- Upload queues ----------
+
+static mrl_error_t create_upload_queue(mrl_render_device_t* brd, mrl_upload_queue_t** uq, const mrl_upload_queue_desc_t* desc)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	// Allocate object
+	mrl_sw_upload_queue_t* obj;
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.upload_queue,
+		(void**)&obj);
+	if (err != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(err);
+
+	// Texels are written straight to the texture storage, so no staging memory is needed
+	obj->last_token = 0;
+	*uq = (mrl_upload_queue_t*)obj;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_upload_queue(mrl_render_device_t* brd, mrl_upload_queue_t* uq)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	// Deallocate object
+	mrl_deallocate_object(
+		&rd->memory.upload_queue,
+		uq);
+}
+
+// Uploads are performed right away, so they are complete as soon as they are issued
+static mrl_error_t finish_upload(mrl_upload_queue_t* uq, mrl_error_t err, mgl_u64_t* token)
+{
+	mrl_sw_upload_queue_t* obj = (mrl_sw_upload_queue_t*)uq;
+	if (err != MRL_ERROR_NONE)
+		return err;
+	*token = ++obj->last_token;
+	return MRL_ERROR_NONE;
+}
+
+static mrl_error_t upload_texture_1d(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mrl_texture_1d_t* tex, const mrl_texture_1d_update_desc_t* desc, mgl_u64_t* token)
+{
+	return finish_upload(uq, update_texture_1d(brd, tex, desc), token);
+}
+
+static mrl_error_t upload_texture_2d(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mrl_texture_2d_t* tex, const mrl_texture_2d_update_desc_t* desc, mgl_u64_t* token)
+{
+	return finish_upload(uq, update_texture_2d(brd, tex, desc), token);
+}
+
+static mrl_error_t upload_texture_3d(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mrl_texture_3d_t* tex, const mrl_texture_3d_update_desc_t* desc, mgl_u64_t* token)
+{
+	return finish_upload(uq, update_texture_3d(brd, tex, desc), token);
+}
+
+static mrl_error_t upload_cube_map(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mrl_cube_map_t* cb, const mrl_cube_map_update_desc_t* desc, mgl_u64_t* token)
+{
+	return finish_upload(uq, update_cube_map(brd, cb, desc), token);
+}
+
+static mgl_bool_t is_upload_complete(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mgl_u64_t token)
+{
+	return MGL_TRUE;
+}
+
+static void wait_upload(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mgl_u64_t token)
+{
+	// Nothing to wait for
+}
+
+// ---------- Shaders ----------
+
+static mrl_error_t create_shader_stage(mrl_render_device_t* brd, mrl_shader_stage_t** stage, const mrl_shader_stage_desc_t* desc)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	// Check for invalid input
+	if (desc->src_type != MRL_SHADER_SOURCE_NATIVE)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_UNSUPPORTED_SHADER_SOURCE, u8"Failed to create shader stage: the software render device only supports native shaders");
+		return MRL_ERROR_UNSUPPORTED_SHADER_SOURCE;
+	}
+
+	if (desc->stage != MRL_SHADER_STAGE_VERTEX && desc->stage != MRL_SHADER_STAGE_PIXEL)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_UNSUPPORTED_SHADER_STAGE, u8"Failed to create shader stage: unsupported shader stage");
+		return MRL_ERROR_UNSUPPORTED_SHADER_STAGE;
+	}
+
+	const mrl_sw_shader_desc_t* src = (const mrl_sw_shader_desc_t*)desc->src;
+	if (src == NULL ||
+		(desc->stage == MRL_SHADER_STAGE_VERTEX && src->vertex == NULL) ||
+		(desc->stage == MRL_SHADER_STAGE_PIXEL && src->pixel == NULL))
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create shader stage: the shader function of the stage must not be NULL");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	if (src->input_count > MRL_MAX_VERTEX_ARRAY_ELEMENT_COUNT ||
+		src->varying_count > MRL_SW_MAX_VARYING_COUNT ||
+		src->binding_point_count > MRL_SW_MAX_BINDING_POINT_COUNT)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_INVALID_PARAMS, u8"Failed to create shader stage: too many inputs, varyings or binding points");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	// Allocate object
+	mrl_sw_shader_stage_t* obj;
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.shader_stage,
+		(void**)&obj);
+	if (err != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(err);
+
+	// Store shader stage info
+	obj->stage = desc->stage;
+	obj->desc = *src;
+	*stage = (mrl_shader_stage_t*)obj;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_shader_stage(mrl_render_device_t* brd, mrl_shader_stage_t* stage)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	// Deallocate object
+	mrl_deallocate_object(
+		&rd->memory.shader_stage,
+		stage);
+}
+
+static mgl_u32_t find_binding_point_index(const mrl_sw_binding_point_t* bps, mgl_u32_t count, const mgl_chr8_t* name)
+{
+	for (mgl_u32_t i = 0; i < count; ++i)
+		if (mgl_str_equal(bps[i].name, name))
+			return i;
+	return count;
+}
+
+static mrl_error_t create_shader_pipeline(mrl_render_device_t* brd, mrl_shader_pipeline_t** pipeline, const mrl_shader_pipeline_desc_t* desc)
+{
+	MGL_DEBUG_ASSERT(desc->vertex != NULL && desc->pixel != NULL);
+
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	const mrl_sw_shader_stage_t* vs = (const mrl_sw_shader_stage_t*)desc->vertex;
+	const mrl_sw_shader_stage_t* ps = (const mrl_sw_shader_stage_t*)desc->pixel;
+
+	// Check for invalid input
+	if (vs->stage != MRL_SHADER_STAGE_VERTEX || ps->stage != MRL_SHADER_STAGE_PIXEL)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(MRL_ERROR_FAILED_TO_LINK_SHADER_PIPELINE, u8"Failed to create shader pipeline: the stages don't match their pipeline slots");
+		return MRL_ERROR_FAILED_TO_LINK_SHADER_PIPELINE;
+	}
+
+	// Get the size of the binding points and names, stages may share binding points
+	const mrl_sw_shader_desc_t* stages[2] = { &vs->desc, &ps->desc };
+	mgl_u64_t bp_count = 0;
+	mgl_u64_t names_size = 0;
+	for (mgl_u32_t s = 0; s < 2; ++s)
+		for (mgl_u32_t i = 0; i < stages[s]->binding_point_count; ++i)
+		{
+			mgl_bool_t shared = MGL_FALSE;
+			for (mgl_u32_t j = 0; j < i && !shared; ++j)
+				shared = mgl_str_equal(stages[s]->binding_points[i], stages[s]->binding_points[j]);
+			for (mgl_u32_t j = 0; s == 1 && j < stages[0]->binding_point_count && !shared; ++j)
+				shared = mgl_str_equal(stages[s]->binding_points[i], stages[0]->binding_points[j]);
+
+			if (!shared)
+			{
+				bp_count += 1;
+				names_size += str_size(stages[s]->binding_points[i]) + 1;
+			}
+		}
+
+	for (mgl_u32_t i = 0; i < vs->desc.input_count; ++i)
+		names_size += str_size(vs->desc.inputs[i]) + 1;
+
+	// Allocate object
+	mrl_sw_shader_pipeline_t* obj;
+	mgl_error_t err = mrl_allocate_object(
+		&rd->memory.shader_pipeline,
+		(void**)&obj);
+	if (err != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(err);
+
+	err = mgl_allocate(rd->allocator, bp_count * sizeof(mrl_sw_binding_point_t) + names_size, (void**)&obj->bps);
+	if (err != MGL_ERROR_NONE)
+	{
+		mrl_deallocate_object(&rd->memory.shader_pipeline, obj);
+		return mrl_make_mgl_error(err);
+	}
+
+	// Store pipeline info
+	obj->vertex = vs->desc.vertex;
+	obj->pixel = ps->desc.pixel;
+	obj->varying_count = vs->desc.varying_count;
+	obj->bp_count = 0;
+
+	mgl_chr8_t* names = (mgl_chr8_t*)(obj->bps + bp_count);
+	for (mgl_u32_t s = 0; s < 2; ++s)
+	{
+		mrl_sw_shader_resources_t* res = s == 0 ? &obj->vertex_resources : &obj->pixel_resources;
+		for (mgl_u32_t i = 0; i < MRL_SW_MAX_BINDING_POINT_COUNT; ++i)
+			res->bps[i] = NULL;
+
+		for (mgl_u32_t i = 0; i < stages[s]->binding_point_count; ++i)
+		{
+			const mgl_chr8_t* name = stages[s]->binding_points[i];
+			mgl_u32_t index = find_binding_point_index(obj->bps, obj->bp_count, name);
+			if (index == obj->bp_count)
+			{
+				mgl_u64_t size = str_size(name) + 1;
+				mgl_mem_copy(names, name, size);
+
+				mrl_sw_binding_point_t* bp = &obj->bps[obj->bp_count++];
+				bp->id = mrl_get_shader_binding_point_id(name);
+				bp->name = names;
+				bp->constants = NULL;
+				bp->constants_size = 0;
+				bp->texture = NULL;
+				bp->sampler = &rd->default_sampler;
+				names += size;
+			}
+
+			res->bps[i] = &obj->bps[index];
+		}
+	}
+
+	obj->input_count = vs->desc.input_count;
+	for (mgl_u32_t i = 0; i < vs->desc.input_count; ++i)
+	{
+		mgl_u64_t size = str_size(vs->desc.inputs[i]) + 1;
+		mgl_mem_copy(names, vs->desc.inputs[i], size);
+		obj->inputs[i] = names;
+		names += size;
+	}
+
+	*pipeline = (mrl_shader_pipeline_t*)obj;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_shader_pipeline(mrl_render_device_t* brd, mrl_shader_pipeline_t* pipeline)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	mrl_sw_shader_pipeline_t* obj = (mrl_sw_shader_pipeline_t*)pipeline;
+
+	if (rd->state.pipeline == obj)
+		rd->state.pipeline = NULL;
+
+	// Deallocate object
+	mgl_deallocate(rd->allocator, obj->bps);
+	mrl_deallocate_object(
+		&rd->memory.shader_pipeline,
+		obj);
+}
+
+static void set_shader_pipeline(mrl_render_device_t* brd, mrl_shader_pipeline_t* pipeline)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	rd->state.pipeline = (const mrl_sw_shader_pipeline_t*)pipeline;
+}
+
+static mrl_shader_binding_point_t* get_shader_binding_point(mrl_render_device_t* brd, mrl_shader_pipeline_t* pipeline, const mgl_chr8_t* name)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	mrl_sw_shader_pipeline_t* obj = (mrl_sw_shader_pipeline_t*)pipeline;
+
+	// Get binding point
+	mgl_u32_t index = find_binding_point_index(obj->bps, obj->bp_count, name);
+	if (index == obj->bp_count)
+	{
+		mgl_chr8_t msg[512] = { 0 };
+		mgl_buffer_stream_t stream;
+		mgl_init_buffer_stream(&stream, msg, sizeof(msg));
+		mgl_print(&stream, u8"Couldn't find any binding point with the name \"");
+		mgl_print(&stream, name);
+		mgl_print(&stream, u8"\"");
+
+		if (rd->warning_callback != NULL)
+			rd->warning_callback(MRL_ERROR_BINDING_POINT_NOT_FOUND, msg);
+		return NULL;
+	}
+
+	return (mrl_shader_binding_point_t*)&obj->bps[index];
+}
+
+static mrl_shader_binding_point_t* get_shader_binding_point_by_id(mrl_render_device_t* brd, mrl_shader_pipeline_t* pipeline, mgl_u64_t id)
+{
+	mrl_sw_shader_pipeline_t* obj = (mrl_sw_shader_pipeline_t*)pipeline;
+
+	// Pipelines have few binding points, a linear search is enough
+	for (mgl_u32_t i = 0; i < obj->bp_count; ++i)
+		if (obj->bps[i].id == id)
+			return (mrl_shader_binding_point_t*)&obj->bps[i];
+	return NULL;
+}
+
+// ---------- Shader resources ----------
+
+MRL_API const void* mrl_get_sw_shader_constants(const mrl_sw_shader_resources_t* res, mgl_u32_t binding_point)
+{
+	MGL_DEBUG_ASSERT(res != NULL && binding_point < MRL_SW_MAX_BINDING_POINT_COUNT);
+	MGL_DEBUG_ASSERT(res->bps[binding_point] != NULL);
+	return res->bps[binding_point]->constants;
+}
+
+static mgl_bool_t address_texel(mgl_enum_t mode, mgl_i32_t i, mgl_u32_t size, mgl_u32_t* out)
+{
+	mgl_i32_t n = (mgl_i32_t)size;
+
+	switch (mode)
+	{
+		case MRL_SAMPLER_ADDRESS_REPEAT:
+			i %= n;
+			*out = (mgl_u32_t)(i < 0 ? i + n : i);
+			return MGL_TRUE;
+
+		case MRL_SAMPLER_ADDRESS_MIRROR:
+			i %= 2 * n;
+			if (i < 0)
+				i += 2 * n;
+			*out = (mgl_u32_t)(i < n ? i : 2 * n - 1 - i);
+			return MGL_TRUE;
+
+		case MRL_SAMPLER_ADDRESS_BORDER:
+			if (i < 0 || i >= n)
+				return MGL_FALSE;
+			*out = (mgl_u32_t)i;
+			return MGL_TRUE;
+
+		default:
+			*out = (mgl_u32_t)(i < 0 ? 0 : (i >= n ? n - 1 : i));
+			return MGL_TRUE;
+	}
+}
+
+static void fetch_texel(const mrl_sw_texture_t* tex, const mrl_sw_sampler_t* s, mgl_u32_t level, mgl_u32_t layer, const mgl_i32_t* coords, mgl_u32_t dims, mgl_f32_t* out)
+{
+	const mrl_sw_image_t* img = &tex->levels[level];
+	const mgl_u32_t sizes[3] = { img->width, img->height, img->depth };
+	mgl_u32_t texel[3] = { 0, 0, layer };
+
+	// Cube map faces are always clamped to their edges
+	for (mgl_u32_t i = 0; i < dims; ++i)
+		if (!address_texel(tex->type == MRL_SW_CUBE_MAP || tex->type == MRL_SW_CUBE_MAP_ARRAY ? MRL_SAMPLER_ADDRESS_CLAMP : s->address[i], coords[i], sizes[i], &texel[i]))
+		{
+			for (mgl_u32_t c = 0; c < 4; ++c)
+				out[c] = s->border_color[c];
+			return;
+		}
+
+	load_texel(&tex->info, get_texel(img, tex->info.texel_size, texel[0], texel[1], texel[2]), out);
+}
+
+static void sample_level(const mrl_sw_texture_t* tex, const mrl_sw_sampler_t* s, mgl_u32_t level, mgl_u32_t layer, const mgl_f32_t* uvw, mgl_u32_t dims, mgl_enum_t filter, mgl_f32_t* out)
+{
+	const mrl_sw_image_t* img = &tex->levels[level];
+	const mgl_u32_t sizes[3] = { img->width, img->height, img->depth };
+
+	if (filter == MRL_SAMPLER_FILTER_NEAREST)
+	{
+		mgl_i32_t coords[3];
+		for (mgl_u32_t i = 0; i < dims; ++i)
+			coords[i] = floor_f32(uvw[i] * (mgl_f32_t)sizes[i]);
+		fetch_texel(tex, s, level, layer, coords, dims, out);
+		return;
+	}
+
+	// Linear filtering blends the 2, 4 or 8 nearest texels
+	mgl_i32_t base[3];
+	mgl_f32_t frac[3];
+	for (mgl_u32_t i = 0; i < dims; ++i)
+	{
+		mgl_f32_t v = uvw[i] * (mgl_f32_t)sizes[i] - 0.5f;
+		base[i] = floor_f32(v);
+		frac[i] = v - (mgl_f32_t)base[i];
+	}
+
+	for (mgl_u32_t c = 0; c < 4; ++c)
+		out[c] = 0.0f;
+
+	for (mgl_u32_t corner = 0; corner < (1u << dims); ++corner)
+	{
+		mgl_i32_t coords[3];
+		mgl_f32_t weight = 1.0f;
+		for (mgl_u32_t i = 0; i < dims; ++i)
+		{
+			mgl_u32_t bit = (corner >> i) & 1;
+			coords[i] = base[i] + (mgl_i32_t)bit;
+			weight *= bit ? frac[i] : 1.0f - frac[i];
+		}
+
+		mgl_f32_t v[4];
+		fetch_texel(tex, s, level, layer, coords, dims, v);
+		for (mgl_u32_t c = 0; c < 4; ++c)
+			out[c] += v[c] * weight;
+	}
+}
+
+MRL_API void mrl_sample_sw_shader_texture(const mrl_sw_shader_resources_t* res, mgl_u32_t binding_point, const mgl_f32_t* coords, mgl_f32_t lod, mgl_f32_t* out)
+{
+	MGL_DEBUG_ASSERT(res != NULL && binding_point < MRL_SW_MAX_BINDING_POINT_COUNT);
+	MGL_DEBUG_ASSERT(res->bps[binding_point] != NULL);
+	MGL_DEBUG_ASSERT(coords != NULL && out != NULL);
+
+	const mrl_sw_texture_t* tex = res->bps[binding_point]->texture;
+	const mrl_sw_sampler_t* s = res->bps[binding_point]->sampler;
+
+	// Unbound textures read as opaque black
+	if (tex == NULL)
+	{
+		out[0] = 0.0f;
+		out[1] = 0.0f;
+		out[2] = 0.0f;
+		out[3] = 1.0f;
+		return;
+	}
+
+	// Get texture coordinates and layer
+	mgl_f32_t uvw[3] = { coords[0], 0.0f, 0.0f };
+	mgl_u32_t dims;
+	mgl_u32_t layer = 0;
+
+	switch (tex->type)
+	{
+		case MRL_SW_TEXTURE_1D:
+			dims = 1;
+			break;
+
+		case MRL_SW_TEXTURE_2D:
+			uvw[1] = coords[1];
+			dims = 2;
+			break;
+
+		case MRL_SW_TEXTURE_3D:
+			uvw[1] = coords[1];
+			uvw[2] = coords[2];
+			dims = 3;
+			break;
+
+		case MRL_SW_TEXTURE_2D_ARRAY:
+		{
+			// The layer is selected by the unnormalized third coordinate, rounded and clamped to the array
+			mgl_i32_t l = floor_f32(coords[2] + 0.5f);
+			mgl_i32_t last = (mgl_i32_t)tex->levels[0].depth - 1;
+			layer = (mgl_u32_t)(l < 0 ? 0 : (l > last ? last : l));
+			uvw[1] = coords[1];
+			dims = 2;
+			break;
+		}
+
+		default:
+		{
+			// Select the cube map face from the major axis of the direction
+			mgl_f32_t ax = abs_f32(coords[0]), ay = abs_f32(coords[1]), az = abs_f32(coords[2]);
+			mgl_f32_t sc, tc, ma;
+
+			if (ax >= ay && ax >= az)
+			{
+				layer = coords[0] >= 0.0f ? MRL_CUBE_MAP_FACE_POSITIVE_X : MRL_CUBE_MAP_FACE_NEGATIVE_X;
+				sc = coords[0] >= 0.0f ? -coords[2] : coords[2];
+				tc = -coords[1];
+				ma = ax;
+			}
+			else if (ay >= az)
+			{
+				layer = coords[1] >= 0.0f ? MRL_CUBE_MAP_FACE_POSITIVE_Y : MRL_CUBE_MAP_FACE_NEGATIVE_Y;
+				sc = coords[0];
+				tc = coords[1] >= 0.0f ? coords[2] : -coords[2];
+				ma = ay;
+			}
+			else
+			{
+				layer = coords[2] >= 0.0f ? MRL_CUBE_MAP_FACE_POSITIVE_Z : MRL_CUBE_MAP_FACE_NEGATIVE_Z;
+				sc = coords[2] >= 0.0f ? coords[0] : -coords[0];
+				tc = -coords[1];
+				ma = az;
+			}
+
+			ma = ma > 0.0f ? ma : 1.0f;
+			uvw[0] = (sc / ma + 1.0f) * 0.5f;
+			uvw[1] = (tc / ma + 1.0f) * 0.5f;
+			dims = 2;
+
+			// Cube map arrays select the cube by the unnormalized fourth coordinate, like 2D texture arrays
+			if (tex->type == MRL_SW_CUBE_MAP_ARRAY)
+			{
+				mgl_i32_t l = floor_f32(coords[3] + 0.5f);
+				mgl_i32_t last = (mgl_i32_t)tex->levels[0].depth / 6 - 1;
+				layer += 6 * (mgl_u32_t)(l < 0 ? 0 : (l > last ? last : l));
+			}
+			break;
+		}
+	}
+
+	// Magnification only ever uses the base level
+	if (lod <= 0.0f || s->mip_filter == MRL_SAMPLER_FILTER_NONE || tex->mip_level_count == 1)
+	{
+		sample_level(tex, s, 0, layer, uvw, dims, lod <= 0.0f ? s->mag_filter : s->min_filter, out);
+		return;
+	}
+
+	mgl_f32_t max_lod = (mgl_f32_t)(tex->mip_level_count - 1);
+	lod = lod < max_lod ? lod : max_lod;
+
+	if (s->mip_filter == MRL_SAMPLER_FILTER_NEAREST)
+	{
+		sample_level(tex, s, (mgl_u32_t)round_f32(lod), layer, uvw, dims, s->min_filter, out);
+		return;
+	}
+
+	// Blend the two nearest levels
+	mgl_u32_t level = (mgl_u32_t)floor_f32(lod);
+	mgl_f32_t t = lod - (mgl_f32_t)level;
+	sample_level(tex, s, level, layer, uvw, dims, s->min_filter, out);
+	if (t > 0.0f)
+	{
+		mgl_f32_t next[4];
+		sample_level(tex, s, level + 1, layer, uvw, dims, s->min_filter, next);
+		for (mgl_u32_t c = 0; c < 4; ++c)
+			out[c] += (next[c] - out[c]) * t;
+	}
+}
+
+// ---------- Draw scratch memory ----------
+
+static mgl_error_t reserve_scratch(mrl_sw_render_device_t* rd, void** ptr, mgl_u64_t* capacity, mgl_u64_t required, mgl_u64_t element_size)
+{
+	if (required <= *capacity)
+		return MGL_ERROR_NONE;
+
+	// Grow geometrically, the old contents are never needed
+	mgl_u64_t new_capacity = *capacity * 2;
+	if (new_capacity < required)
+		new_capacity = required;
+
+	void* memory;
+	mgl_error_t err = mgl_allocate(rd->allocator, new_capacity * element_size, &memory);
+	if (err != MGL_ERROR_NONE)
+		return err;
+
+	if (*ptr != NULL)
+		mgl_deallocate(rd->allocator, *ptr);
+	*ptr = memory;
+	*capacity = new_capacity;
+
+	return MGL_ERROR_NONE;
+}
+
+static mgl_error_t reserve_tiles(mrl_sw_render_device_t* rd, mgl_u32_t tile_count)
+{
+	if (tile_count <= rd->scratch.tile_capacity)
+		return MGL_ERROR_NONE;
+
+	// The three tile arrays of each chunk share a single allocation
+	for (mgl_u32_t i = 0; i < rd->scratch.chunk_count; ++i)
+	{
+		mrl_sw_chunk_t* chunk = &rd->scratch.chunks[i];
+
+		mgl_u32_t* memory;
+		mgl_error_t err = mgl_allocate(rd->allocator, 3 * sizeof(mgl_u32_t) * (mgl_u64_t)tile_count, (void**)&memory);
+		if (err != MGL_ERROR_NONE)
+			return err;
+
+		if (chunk->tile_counts != NULL)
+			mgl_deallocate(rd->allocator, chunk->tile_counts);
+		chunk->tile_counts = memory;
+		chunk->tile_starts = memory + tile_count;
+		chunk->tile_fill = memory + 2 * (mgl_u64_t)tile_count;
+	}
+
+	rd->scratch.tile_capacity = tile_count;
+	return MGL_ERROR_NONE;
+}
+
+static mgl_error_t reserve_chunk(mrl_sw_render_device_t* rd, mrl_sw_chunk_t* chunk, mgl_u64_t tri_count, mgl_u32_t varying_count)
+{
+	mgl_error_t err = reserve_scratch(rd, (void**)&chunk->tris, &chunk->tri_capacity, tri_count, sizeof(mrl_sw_triangle_t));
+	if (err != MGL_ERROR_NONE)
+		return err;
+	return reserve_scratch(rd, (void**)&chunk->varyings, &chunk->varying_capacity, tri_count * 3 * varying_count, sizeof(mgl_f32_t));
+}
+
+static void destroy_scratch(mrl_sw_render_device_t* rd)
+{
+	for (mgl_u32_t i = 0; i < rd->scratch.chunk_count; ++i)
+	{
+		mrl_sw_chunk_t* chunk = &rd->scratch.chunks[i];
+		if (chunk->tris != NULL)
+			mgl_deallocate(rd->allocator, chunk->tris);
+		if (chunk->varyings != NULL)
+			mgl_deallocate(rd->allocator, chunk->varyings);
+		if (chunk->tile_counts != NULL)
+			mgl_deallocate(rd->allocator, chunk->tile_counts);
+		if (chunk->bins != NULL)
+			mgl_deallocate(rd->allocator, chunk->bins);
+	}
+
+	if (rd->scratch.chunks != NULL)
+		mgl_deallocate(rd->allocator, rd->scratch.chunks);
+	if (rd->scratch.vertices != NULL)
+		mgl_deallocate(rd->allocator, rd->scratch.vertices);
+}
+
+// ---------- Vertex processing ----------
+
+static mgl_u32_t get_vertex_component_size(mgl_enum_t type)
+{
+	switch (type)
+	{
+		case MRL_VERTEX_ELEMENT_TYPE_I8:
+		case MRL_VERTEX_ELEMENT_TYPE_U8:
+		case MRL_VERTEX_ELEMENT_TYPE_N8:
+		case MRL_VERTEX_ELEMENT_TYPE_NU8:
+			return 1;
+		case MRL_VERTEX_ELEMENT_TYPE_I16:
+		case MRL_VERTEX_ELEMENT_TYPE_U16:
+		case MRL_VERTEX_ELEMENT_TYPE_N16:
+		case MRL_VERTEX_ELEMENT_TYPE_NU16:
+			return 2;
+		default:
+			return 4;
+	}
+}
+
+static void fetch_vertex(const mrl_sw_vertex_array_t* va, mgl_u64_t vertex, mgl_u64_t instance, mrl_sw_vertex_input_t* in)
+{
+	for (mgl_u32_t i = 0; i < MRL_MAX_VERTEX_ARRAY_ELEMENT_COUNT; ++i)
+	{
+		in->inputs[i][0] = 0.0f;
+		in->inputs[i][1] = 0.0f;
+		in->inputs[i][2] = 0.0f;
+		in->inputs[i][3] = 1.0f;
+	}
+
+	for (mgl_u32_t i = 0; i < va->element_count; ++i)
+	{
+		const mrl_sw_vertex_element_t* e = &va->elements[i];
+		mgl_u32_t component_size = get_vertex_component_size(e->type);
+		mgl_u64_t stride = e->stride != 0 ? e->stride : (mgl_u64_t)component_size * e->size;
+
+		// Instance elements advance once every step rate instances
+		mgl_u64_t element = e->instance_step_rate != 0 ? instance / e->instance_step_rate : vertex;
+
+		// Out of bounds elements keep their default values. Negative base vertices wrap to huge indices, which are checked first.
+		if (element > e->buffer->size / stride)
+			continue;
+		mgl_u64_t address = e->offset + element * stride;
+		if (address + (mgl_u64_t)component_size * e->size > e->buffer->size)
+			continue;
+
+		const mgl_u8_t* src = e->buffer->data + address;
+		mgl_f32_t* out = in->inputs[e->input];
+		for (mgl_u32_t c = 0; c < e->size; ++c, src += component_size)
+		{
+			// Vertex data isn't necessarily aligned
+			union { mgl_i8_t i8; mgl_u8_t u8; mgl_i16_t i16; mgl_u16_t u16; mgl_i32_t i32; mgl_u32_t u32; mgl_f32_t f32; } v;
+			mgl_mem_copy(&v, src, component_size);
+
+			switch (e->type)
+			{
+				case MRL_VERTEX_ELEMENT_TYPE_I8: out[c] = (mgl_f32_t)v.i8; break;
+				case MRL_VERTEX_ELEMENT_TYPE_I16: out[c] = (mgl_f32_t)v.i16; break;
+				case MRL_VERTEX_ELEMENT_TYPE_I32: out[c] = (mgl_f32_t)v.i32; break;
+				case MRL_VERTEX_ELEMENT_TYPE_U8: out[c] = (mgl_f32_t)v.u8; break;
+				case MRL_VERTEX_ELEMENT_TYPE_U16: out[c] = (mgl_f32_t)v.u16; break;
+				case MRL_VERTEX_ELEMENT_TYPE_U32: out[c] = (mgl_f32_t)v.u32; break;
+				case MRL_VERTEX_ELEMENT_TYPE_N8: out[c] = max_f32((mgl_f32_t)v.i8 / 127.0f, -1.0f); break;
+				case MRL_VERTEX_ELEMENT_TYPE_N16: out[c] = max_f32((mgl_f32_t)v.i16 / 32767.0f, -1.0f); break;
+				case MRL_VERTEX_ELEMENT_TYPE_NU8: out[c] = (mgl_f32_t)v.u8 / 255.0f; break;
+				case MRL_VERTEX_ELEMENT_TYPE_NU16: out[c] = (mgl_f32_t)v.u16 / 65535.0f; break;
+				default: out[c] = v.f32; break;
+			}
+		}
+	}
+}
+
+static void shade_vertices_job(mrl_sw_render_device_t* rd, void* data, mgl_u64_t job)
+{
+	const mrl_sw_draw_t* draw = (const mrl_sw_draw_t*)data;
+
+	mgl_u64_t begin = job * MRL_SW_VERTEX_JOB_SIZE;
+	mgl_u64_t end = begin + MRL_SW_VERTEX_JOB_SIZE;
+	if (end > draw->vertex_total)
+		end = draw->vertex_total;
+
+	mrl_sw_vertex_input_t in;
+	in.resources = &draw->pp->vertex_resources;
+
+	// Vertices are shaded once per instance, in instance order
+	for (mgl_u64_t i = begin; i < end; ++i)
+	{
+		mgl_u64_t vertex = (mgl_u64_t)((mgl_i64_t)(draw->vertex_min + i % draw->vertex_range) + draw->base_vertex);
+		in.vertex_id = (mgl_u32_t)vertex;
+		in.instance_id = (mgl_u32_t)(i / draw->vertex_range);
+		fetch_vertex(draw->va, vertex, in.instance_id, &in);
+		draw->pp->vertex(&in, &rd->scratch.vertices[i]);
+	}
+}
+
+// ---------- Triangle setup ----------
+
+static mgl_f32_t get_clip_distance(const mgl_f32_t* position, mgl_u32_t plane)
+{
+	// Planes are -w <= x, x <= w, -w <= y, y <= w, -w <= z and z <= w
+	mgl_f32_t c = position[plane >> 1];
+	return (plane & 1) ? position[3] - c : position[3] + c;
+}
+
+static mgl_u32_t get_clip_mask(const mgl_f32_t* position)
+{
+	mgl_u32_t mask = 0;
+	for (mgl_u32_t plane = 0; plane < 6; ++plane)
+		if (get_clip_distance(position, plane) < 0.0f)
+			mask |= 1u << plane;
+	return mask;
+}
+
+static mgl_u32_t clip_polygon(mrl_sw_clip_vertex_t* a, mrl_sw_clip_vertex_t* b, mgl_u32_t count, mgl_u32_t varying_count, mgl_u32_t planes, mrl_sw_clip_vertex_t** out)
+{
+	mrl_sw_clip_vertex_t* src = a;
+	mrl_sw_clip_vertex_t* dst = b;
+
+	// Sutherland-Hodgman, each plane adds at most one vertex
+	for (mgl_u32_t plane = 0; plane < 6 && count >= 3; ++plane)
+	{
+		if (!(planes & (1u << plane)))
+			continue;
+
+		mgl_u32_t dst_count = 0;
+		for (mgl_u32_t i = 0; i < count; ++i)
+		{
+			const mrl_sw_clip_vertex_t* v0 = &src[i];
+			const mrl_sw_clip_vertex_t* v1 = &src[(i + 1) % count];
+			mgl_f32_t d0 = get_clip_distance(v0->position, plane);
+			mgl_f32_t d1 = get_clip_distance(v1->position, plane);
+
+			if (d0 >= 0.0f)
+				dst[dst_count++] = *v0;
+
+			if ((d0 >= 0.0f) != (d1 >= 0.0f))
+			{
+				// Always interpolate from the inside vertex, so that neighbour triangles get the same point
+				const mrl_sw_clip_vertex_t* in = d0 >= 0.0f ? v0 : v1;
+				const mrl_sw_clip_vertex_t* out_v = d0 >= 0.0f ? v1 : v0;
+				mgl_f32_t din = d0 >= 0.0f ? d0 : d1;
+				mgl_f32_t dout = d0 >= 0.0f ? d1 : d0;
+				mgl_f32_t t = din / (din - dout);
+
+				mrl_sw_clip_vertex_t* v = &dst[dst_count++];
+				for (mgl_u32_t c = 0; c < 4; ++c)
+					v->position[c] = in->position[c] + (out_v->position[c] - in->position[c]) * t;
+				for (mgl_u32_t c = 0; c < varying_count; ++c)
+					v->varyings[c] = in->varyings[c] + (out_v->varyings[c] - in->varyings[c]) * t;
+			}
+		}
+
+		mrl_sw_clip_vertex_t* tmp = src;
+		src = dst;
+		dst = tmp;
+		count = dst_count;
+	}
+
+	*out = src;
+	return count >= 3 ? count : 0;
+}
+
+static mgl_f32_t snap_coord(mgl_f32_t v)
+{
+	// Snap to 1/16 of a pixel, so that the edge functions are stable
+	return (mgl_f32_t)round_f32(v * 16.0f) * (1.0f / 16.0f);
+}
+
+// Returns MGL_FALSE if the chunk ran out of space
+static mgl_bool_t emit_triangle(const mrl_sw_draw_t* draw, mrl_sw_chunk_t* chunk, const mgl_f32_t* const* positions, const mgl_f32_t* const* varyings)
+{
+	mgl_f32_t x[3], y[3], z[3], inv_w[3];
+
+	// Get window coordinates
+	for (mgl_u32_t i = 0; i < 3; ++i)
+	{
+		if (positions[i][3] <= 0.0f)
+			return MGL_TRUE;
+
+		inv_w[i] = 1.0f / positions[i][3];
+		x[i] = snap_coord(draw->viewport[0] + (positions[i][0] * inv_w[i] + 1.0f) * 0.5f * draw->viewport[2]);
+		y[i] = snap_coord(draw->viewport[1] + (positions[i][1] * inv_w[i] + 1.0f) * 0.5f * draw->viewport[3]);
+		z[i] = draw->depth_near + (positions[i][2] * inv_w[i] + 1.0f) * 0.5f * (draw->depth_far - draw->depth_near);
+	}
+
+	// Counter clockwise triangles have a positive area
+	mgl_f32_t area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+	if (area == 0.0f)
+		return MGL_TRUE;
+
+	mgl_bool_t front_facing = (area > 0.0f) == (draw->rs->front_face == MRL_WINDING_CCW);
+	if (draw->rs->cull_enabled)
+	{
+		if (draw->rs->cull_face == MRL_FACE_FRONT_AND_BACK ||
+			(draw->rs->cull_face == MRL_FACE_FRONT && front_facing) ||
+			(draw->rs->cull_face == MRL_FACE_BACK && !front_facing))
+			return MGL_TRUE;
+	}
+
+	// Get the bounding box in pixels, clipped to the viewport and framebuffer
+	mgl_i32_t min_x = max_i32(floor_f32(min_f32(x[0], min_f32(x[1], x[2]))), draw->clip_min_x);
+	mgl_i32_t min_y = max_i32(floor_f32(min_f32(y[0], min_f32(y[1], y[2]))), draw->clip_min_y);
+	mgl_i32_t max_x = min_i32(ceil_f32(max_f32(x[0], max_f32(x[1], x[2]))), draw->clip_max_x);
+	mgl_i32_t max_y = min_i32(ceil_f32(max_f32(y[0], max_f32(y[1], y[2]))), draw->clip_max_y);
+	if (min_x >= max_x || min_y >= max_y)
+		return MGL_TRUE;
+
+	// Check for space
+	mgl_u32_t vc = draw->varying_count;
+	if (chunk->tri_count >= chunk->tri_capacity || (chunk->tri_count + 1) * 3 * vc > chunk->varying_capacity)
+		return MGL_FALSE;
+
+	mrl_sw_triangle_t* tri = &chunk->tris[chunk->tri_count];
+	mgl_f32_t orientation = area > 0.0f ? 1.0f : -1.0f;
+
+	for (mgl_u32_t i = 0; i < 3; ++i)
+	{
+		// Canonical endpoint order
+		mgl_u32_t a = (i + 1) % 3;
+		mgl_u32_t b = (i + 2) % 3;
+		mgl_f32_t flip = 1.0f;
+		if (y[b] < y[a] || (y[b] == y[a] && x[b] < x[a]))
+		{
+			mgl_u32_t tmp = a;
+			a = b;
+			b = tmp;
+			flip = -1.0f;
+		}
+
+		tri->edges[i].ax = x[a];
+		tri->edges[i].ay = y[a];
+		tri->edges[i].dx = x[b] - x[a];
+		tri->edges[i].dy = y[b] - y[a];
+		tri->edges[i].sign = flip * orientation;
+		tri->edges[i].length2 = 0.25f * (tri->edges[i].dx * tri->edges[i].dx + tri->edges[i].dy * tri->edges[i].dy);
+
+		// Fill rule, of two triangles sharing an edge exactly one owns the pixels on it
+		mgl_f32_t gx = -tri->edges[i].dy * tri->edges[i].sign;
+		mgl_f32_t gy = tri->edges[i].dx * tri->edges[i].sign;
+		tri->edges[i].inclusive = gx > 0.0f || (gx == 0.0f && gy < 0.0f);
+
+		tri->z[i] = z[i];
+		tri->inv_w[i] = inv_w[i];
+	}
+
+	tri->inv_area = 1.0f / abs_f32(area);
+	tri->min_x = min_x;
+	tri->min_y = min_y;
+	tri->max_x = max_x;
+	tri->max_y = max_y;
+	tri->front_facing = front_facing;
+
+	// Varyings are divided by w, so that they can be interpolated linearly in screen space
+	mgl_f32_t* dst = chunk->varyings + chunk->tri_count * 3 * vc;
+	for (mgl_u32_t i = 0; i < 3; ++i)
+		for (mgl_u32_t j = 0; j < vc; ++j)
+			dst[i * vc + j] = varyings[i][j] * inv_w[i];
+
+	// Count the triangle on every tile it overlaps
+	for (mgl_i32_t ty = min_y / MRL_SW_TILE_SIZE; ty <= (max_y - 1) / MRL_SW_TILE_SIZE; ++ty)
+		for (mgl_i32_t tx = min_x / MRL_SW_TILE_SIZE; tx <= (max_x - 1) / MRL_SW_TILE_SIZE; ++tx)
+			chunk->tile_counts[(mgl_u32_t)ty * draw->tiles_x + (mgl_u32_t)tx] += 1;
+
+	chunk->tri_count += 1;
+	return MGL_TRUE;
+}
+
+static mgl_bool_t setup_primitive(const mrl_sw_draw_t* draw, mrl_sw_chunk_t* chunk, const mrl_sw_vertex_output_t* const* v)
+{
+	// Trivially reject or accept the triangle
+	mgl_u32_t masks[3] = { get_clip_mask(v[0]->position), get_clip_mask(v[1]->position), get_clip_mask(v[2]->position) };
+	if (masks[0] & masks[1] & masks[2])
+		return MGL_TRUE;
+
+	if ((masks[0] | masks[1] | masks[2]) == 0)
+	{
+		const mgl_f32_t* positions[3] = { v[0]->position, v[1]->position, v[2]->position };
+		const mgl_f32_t* varyings[3] = { v[0]->varyings, v[1]->varyings, v[2]->varyings };
+		return emit_triangle(draw, chunk, positions, varyings);
+	}
+
+	// Clip against the planes the triangle crosses
+	mrl_sw_clip_vertex_t a[MRL_SW_MAX_CLIP_VERTEX_COUNT];
+	mrl_sw_clip_vertex_t b[MRL_SW_MAX_CLIP_VERTEX_COUNT];
+	for (mgl_u32_t i = 0; i < 3; ++i)
+	{
+		for (mgl_u32_t c = 0; c < 4; ++c)
+			a[i].position[c] = v[i]->position[c];
+		for (mgl_u32_t c = 0; c < draw->varying_count; ++c)
+			a[i].varyings[c] = v[i]->varyings[c];
+	}
+
+	mrl_sw_clip_vertex_t* poly;
+	mgl_u32_t count = clip_polygon(a, b, 3, draw->varying_count, masks[0] | masks[1] | masks[2], &poly);
+
+	// Triangulate the clipped polygon as a fan
+	for (mgl_u32_t i = 1; i + 1 < count; ++i)
+	{
+		const mgl_f32_t* positions[3] = { poly[0].position, poly[i].position, poly[i + 1].position };
+		const mgl_f32_t* varyings[3] = { poly[0].varyings, poly[i].varyings, poly[i + 1].varyings };
+		if (!emit_triangle(draw, chunk, positions, varyings))
+			return MGL_FALSE;
+	}
+
+	return MGL_TRUE;
+}
+
+static void setup_triangles_job(mrl_sw_render_device_t* rd, void* data, mgl_u64_t job)
+{
+	const mrl_sw_draw_t* draw = (const mrl_sw_draw_t*)data;
+	mrl_sw_chunk_t* chunk = &rd->scratch.chunks[job];
+
+	chunk->tri_count = 0;
+	chunk->overflow = MGL_FALSE;
+	mgl_mem_set(chunk->tile_counts, sizeof(mgl_u32_t) * draw->tiles_x * draw->tiles_y, 0);
+
+	for (mgl_u64_t p = chunk->first_prim; p < chunk->first_prim + chunk->prim_count; ++p)
+	{
+		mgl_u64_t instance = p / draw->tri_count;
+		mgl_u64_t first = draw->first + (p % draw->tri_count) * 3;
+
+		// Assemble triangle
+		const mrl_sw_vertex_output_t* v[3];
+		for (mgl_u32_t i = 0; i < 3; ++i)
+		{
+			mgl_u64_t index = first + i;
+			if (draw->indices != NULL)
+				index = draw->index_size == 2 ? ((const mgl_u16_t*)draw->indices)[index] : ((const mgl_u32_t*)draw->indices)[index];
+			v[i] = &rd->scratch.vertices[instance * draw->vertex_range + (index - draw->vertex_min)];
+		}
+
+		if (!setup_primitive(draw, chunk, v))
+		{
+			// The device thread grows the chunk and sets it up again
+			chunk->overflow = MGL_TRUE;
+			return;
+		}
+	}
+}
+
+static void bin_triangles_job(mrl_sw_render_device_t* rd, void* data, mgl_u64_t job)
+{
+	const mrl_sw_draw_t* draw = (const mrl_sw_draw_t*)data;
+	mrl_sw_chunk_t* chunk = &rd->scratch.chunks[job];
+
+	mgl_mem_set(chunk->tile_fill, sizeof(mgl_u32_t) * draw->tiles_x * draw->tiles_y, 0);
+
+	for (mgl_u32_t i = 0; i < (mgl_u32_t)chunk->tri_count; ++i)
+	{
+		const mrl_sw_triangle_t* tri = &chunk->tris[i];
+		for (mgl_i32_t ty = tri->min_y / MRL_SW_TILE_SIZE; ty <= (tri->max_y - 1) / MRL_SW_TILE_SIZE; ++ty)
+			for (mgl_i32_t tx = tri->min_x / MRL_SW_TILE_SIZE; tx <= (tri->max_x - 1) / MRL_SW_TILE_SIZE; ++tx)
+			{
+				mgl_u32_t tile = (mgl_u32_t)ty * draw->tiles_x + (mgl_u32_t)tx;
+				chunk->bins[chunk->tile_starts[tile] + chunk->tile_fill[tile]++] = i;
+			}
+	}
+}
+
+// ---------- Pixel processing ----------
+
+static mgl_bool_t compare_f32(mgl_enum_t compare, mgl_f32_t a, mgl_f32_t b)
+{
+	switch (compare)
+	{
+		case MRL_COMPARE_NEVER: return MGL_FALSE;
+		case MRL_COMPARE_LESS: return a < b;
+		case MRL_COMPARE_LEQUAL: return a <= b;
+		case MRL_COMPARE_GREATER: return a > b;
+		case MRL_COMPARE_GEQUAL: return a >= b;
+		case MRL_COMPARE_EQUAL: return a == b;
+		case MRL_COMPARE_NEQUAL: return a != b;
+		default: return MGL_TRUE;
+	}
+}
+
+static mgl_bool_t compare_u32(mgl_enum_t compare, mgl_u32_t a, mgl_u32_t b)
+{
+	switch (compare)
+	{
+		case MRL_COMPARE_NEVER: return MGL_FALSE;
+		case MRL_COMPARE_LESS: return a < b;
+		case MRL_COMPARE_LEQUAL: return a <= b;
+		case MRL_COMPARE_GREATER: return a > b;
+		case MRL_COMPARE_GEQUAL: return a >= b;
+		case MRL_COMPARE_EQUAL: return a == b;
+		case MRL_COMPARE_NEQUAL: return a != b;
+		default: return MGL_TRUE;
+	}
+}
+
+static void apply_stencil_action(const mrl_sw_depth_stencil_state_t* dss, mgl_enum_t action, mgl_u32_t* stencil)
+{
+	mgl_u32_t v = *stencil & 0xFF;
+	mgl_u32_t result;
+
+	switch (action)
+	{
+		case MRL_ACTION_ZERO: result = 0; break;
+		case MRL_ACTION_REPLACE: result = dss->stencil_ref & 0xFF; break;
+		case MRL_ACTION_INCREMENT: result = v < 0xFF ? v + 1 : 0xFF; break;
+		case MRL_ACTION_DECREMENT: result = v > 0 ? v - 1 : 0; break;
+		case MRL_ACTION_INCREMENT_WRAP: result = (v + 1) & 0xFF; break;
+		case MRL_ACTION_DECREMENT_WRAP: result = (v - 1) & 0xFF; break;
+		case MRL_ACTION_INVERT: result = ~v & 0xFF; break;
+		default: return;
+	}
+
+	*stencil = (v & ~dss->stencil_write_mask & 0xFF) | (result & dss->stencil_write_mask & 0xFF);
+}
+
+static mgl_f32_t get_blend_factor(mgl_enum_t factor, const mgl_f32_t* src, const mgl_f32_t* dst, mgl_u32_t c)
+{
+	switch (factor)
+	{
+		case MRL_BLEND_FACTOR_ZERO: return 0.0f;
+		case MRL_BLEND_FACTOR_SRC_COLOR: return src[c];
+		case MRL_BLEND_FACTOR_INV_SRC_COLOR: return 1.0f - src[c];
+		case MRL_BLEND_FACTOR_DST_COLOR: return dst[c];
+		case MRL_BLEND_FACTOR_INV_DST_COLOR: return 1.0f - dst[c];
+		case MRL_BLEND_FACTOR_SRC_ALPHA: return src[3];
+		case MRL_BLEND_FACTOR_INV_SRC_ALPHA: return 1.0f - src[3];
+		case MRL_BLEND_FACTOR_DST_ALPHA: return dst[3];
+		case MRL_BLEND_FACTOR_INV_DST_ALPHA: return 1.0f - dst[3];
+		default: return 1.0f;
+	}
+}
+
+static mgl_f32_t apply_blend_op(mgl_enum_t op, mgl_f32_t src, mgl_f32_t src_factor, mgl_f32_t dst, mgl_f32_t dst_factor)
+{
+	switch (op)
+	{
+		case MRL_BLEND_OP_SUBTRACT: return src * src_factor - dst * dst_factor;
+		case MRL_BLEND_OP_REV_SUBTRACT: return dst * dst_factor - src * src_factor;
+		case MRL_BLEND_OP_MIN: return min_f32(src, dst);
+		case MRL_BLEND_OP_MAX: return max_f32(src, dst);
+		default: return src * src_factor + dst * dst_factor;
+	}
+}
+
+static void blend_pixel(const mrl_sw_blend_state_t* bs, const mrl_sw_surface_t* target, mgl_u8_t* texel, const mgl_f32_t* color)
+{
+	if (!bs->blend_enabled || is_integer_format(&target->info))
+	{
+		store_texel(&target->info, texel, color);
+		return;
+	}
+
+	// Normalized formats blend with clamped source values
+	mgl_f32_t src[4];
+	for (mgl_u32_t c = 0; c < 4; ++c)
+		if (target->info.component_type == MRL_SW_COMPONENT_UN8 || target->info.component_type == MRL_SW_COMPONENT_UN16)
+			src[c] = clamp_f32(color[c], 0.0f, 1.0f);
+		else if (target->info.component_type == MRL_SW_COMPONENT_SN8 || target->info.component_type == MRL_SW_COMPONENT_SN16)
+			src[c] = clamp_f32(color[c], -1.0f, 1.0f);
+		else
+			src[c] = color[c];
+
+	mgl_f32_t dst[4];
+	load_texel(&target->info, texel, dst);
+
+	mgl_f32_t out[4];
+	for (mgl_u32_t c = 0; c < 3; ++c)
+		out[c] = apply_blend_op(bs->op, src[c], get_blend_factor(bs->src_factor, src, dst, c), dst[c], get_blend_factor(bs->dst_factor, src, dst, c));
+	out[3] = apply_blend_op(bs->alpha_op, src[3], get_blend_factor(bs->src_alpha_factor, src, dst, 3), dst[3], get_blend_factor(bs->dst_alpha_factor, src, dst, 3));
+
+	store_texel(&target->info, texel, out);
+}
+
+static void shade_pixel(const mrl_sw_draw_t* draw, const mrl_sw_triangle_t* tri, const mgl_f32_t* varyings, mgl_i32_t x, mgl_i32_t y, const mgl_f32_t* s)
+{
+	const mrl_sw_framebuffer_t* fb = draw->fb;
+	const mrl_sw_depth_stencil_state_t* dss = draw->dss;
+
+	// Interpolate depth and 1/w linearly in screen space
+	mgl_f32_t b[3] = { s[0] * tri->inv_area, s[1] * tri->inv_area, s[2] * tri->inv_area };
+	mgl_f32_t z = b[0] * tri->z[0] + b[1] * tri->z[1] + b[2] * tri->z[2];
+	mgl_f32_t inv_w = b[0] * tri->inv_w[0] + b[1] * tri->inv_w[1] + b[2] * tri->inv_w[2];
+
+	mgl_u8_t* depth_texel = NULL;
+	if (fb->depth_stencil.data != NULL)
+		depth_texel = fb->depth_stencil.data + ((mgl_u64_t)y * fb->depth_stencil.width + (mgl_u64_t)x) * fb->depth_stencil.info.texel_size;
+
+	mgl_bool_t depth_active = dss->depth_enabled && depth_texel != NULL;
+	mgl_bool_t stencil_active = dss->stencil_enabled && depth_texel != NULL && fb->depth_stencil.info.component_type == MRL_SW_COMPONENT_DEPTH_STENCIL;
+	z = clamp_f32(z, 0.0f, 1.0f);
+
+	// Without stencil, the depth test can be done before running the pixel shader
+	mgl_f32_t stored_depth = 0.0f;
+	if (depth_active)
+	{
+		mgl_mem_copy(&stored_depth, depth_texel, sizeof(mgl_f32_t));
+		if (!stencil_active && !compare_f32(dss->depth_compare, z, stored_depth))
+			return;
+	}
+
+	// Run pixel shader
+	mrl_sw_pixel_input_t in;
+	mrl_sw_pixel_output_t out;
+	in.resources = &draw->pp->pixel_resources;
+	in.frag_coord[0] = (mgl_f32_t)x + 0.5f;
+	in.frag_coord[1] = (mgl_f32_t)y + 0.5f;
+	in.frag_coord[2] = z;
+	in.frag_coord[3] = inv_w;
+	in.front_facing = tri->front_facing;
+
+	mgl_f32_t w = 1.0f / inv_w;
+	mgl_u32_t vc = draw->varying_count;
+	for (mgl_u32_t i = 0; i < vc; ++i)
+		in.varyings[i] = (b[0] * varyings[i] + b[1] * varyings[vc + i] + b[2] * varyings[2 * vc + i]) * w;
+
+	for (mgl_u32_t i = 0; i < fb->target_count; ++i)
+	{
+		out.colors[i][0] = 0.0f;
+		out.colors[i][1] = 0.0f;
+		out.colors[i][2] = 0.0f;
+		out.colors[i][3] = 1.0f;
+	}
+
+	if (!draw->pp->pixel(&in, &out))
+		return;
+
+	// Stencil test
+	if (stencil_active)
+	{
+		const mrl_sw_stencil_face_t* face = &dss->stencil[tri->front_facing ? 0 : 1];
+		mgl_u32_t stencil;
+		mgl_mem_copy(&stencil, depth_texel + 4, sizeof(mgl_u32_t));
+
+		if (!compare_u32(face->compare, dss->stencil_ref & dss->stencil_read_mask, stencil & dss->stencil_read_mask))
+		{
+			apply_stencil_action(dss, face->fail, &stencil);
+			mgl_mem_copy(depth_texel + 4, &stencil, sizeof(mgl_u32_t));
+			return;
+		}
+
+		if (depth_active && !compare_f32(dss->depth_compare, z, stored_depth))
+		{
+			apply_stencil_action(dss, face->depth_fail, &stencil);
+			mgl_mem_copy(depth_texel + 4, &stencil, sizeof(mgl_u32_t));
+			return;
+		}
+
+		apply_stencil_action(dss, face->pass, &stencil);
+		mgl_mem_copy(depth_texel + 4, &stencil, sizeof(mgl_u32_t));
+	}
+
+	if (depth_active && dss->depth_write_enabled)
+		mgl_mem_copy(depth_texel, &z, sizeof(mgl_f32_t));
+
+	// Write colors
+	for (mgl_u32_t i = 0; i < fb->target_count; ++i)
+	{
+		const mrl_sw_surface_t* target = &fb->targets[i];
+		mgl_u8_t* texel = target->data + ((mgl_u64_t)y * target->width + (mgl_u64_t)x) * target->info.texel_size;
+		blend_pixel(draw->bs, target, texel, out.colors[i]);
+	}
+}
+
+// ---------- Rasterization ----------
+
+static mgl_bool_t is_wireframe_covered(const mrl_sw_triangle_t* tri, const mgl_f32_t* s)
+{
+	// Covered pixels are inside the triangle and less than half a pixel away from one of its edges
+	mgl_bool_t near_edge = MGL_FALSE;
+	for (mgl_u32_t e = 0; e < 3; ++e)
+	{
+		mgl_bool_t on_edge = s[e] * s[e] < tri->edges[e].length2;
+		if (s[e] < 0.0f && !on_edge)
+			return MGL_FALSE;
+		near_edge |= on_edge;
+	}
+	return near_edge;
+}
+
+static void raster_triangle(const mrl_sw_draw_t* draw, const mrl_sw_triangle_t* tri, const mgl_f32_t* varyings, mgl_i32_t min_x, mgl_i32_t min_y, mgl_i32_t max_x, mgl_i32_t max_y)
+{
+	mgl_i32_t x0 = max_i32(min_x, tri->min_x);
+	mgl_i32_t y0 = max_i32(min_y, tri->min_y);
+	mgl_i32_t x1 = min_i32(max_x, tri->max_x);
+	mgl_i32_t y1 = min_i32(max_y, tri->max_y);
+	mgl_bool_t wireframe = draw->rs->wireframe;
+
+#ifdef MRL_SW_SSE2
+	const __m128 lane_offsets = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+#endif
+
+	for (mgl_i32_t y = y0; y < y1; ++y)
+	{
+		mgl_f32_t fy = (mgl_f32_t)y + 0.5f;
+
+		// The part of each edge function which only depends on the row
+		mgl_f32_t row[3];
+		for (mgl_u32_t e = 0; e < 3; ++e)
+			row[e] = tri->edges[e].dx * (fy - tri->edges[e].ay);
+
+		// Pixels are evaluated in groups of four
+		for (mgl_i32_t x = x0 & ~3; x < x1; x += 4)
+		{
+			mgl_f32_t s[3][4];
+			mgl_u32_t mask = 0xF;
+
+#ifdef MRL_SW_SSE2
+			__m128 px = _mm_add_ps(_mm_set1_ps((mgl_f32_t)x), lane_offsets);
+			for (mgl_u32_t e = 0; e < 3; ++e)
+			{
+				__m128 v = _mm_sub_ps(_mm_set1_ps(row[e]), _mm_mul_ps(_mm_set1_ps(tri->edges[e].dy), _mm_sub_ps(px, _mm_set1_ps(tri->edges[e].ax))));
+				v = _mm_mul_ps(v, _mm_set1_ps(tri->edges[e].sign));
+				_mm_storeu_ps(s[e], v);
+				if (!wireframe)
+				{
+					__m128 inside = tri->edges[e].inclusive ? _mm_cmpge_ps(v, _mm_setzero_ps()) : _mm_cmpgt_ps(v, _mm_setzero_ps());
+					mask &= (mgl_u32_t)_mm_movemask_ps(inside);
+				}
+			}
+#else
+			for (mgl_u32_t e = 0; e < 3; ++e)
+			{
+				mgl_u32_t inside = 0;
+				for (mgl_u32_t l = 0; l < 4; ++l)
+				{
+					mgl_f32_t px = (mgl_f32_t)x + ((mgl_f32_t)l + 0.5f);
+					s[e][l] = (row[e] - tri->edges[e].dy * (px - tri->edges[e].ax)) * tri->edges[e].sign;
+					if (tri->edges[e].inclusive ? s[e][l] >= 0.0f : s[e][l] > 0.0f)
+						inside |= 1u << l;
+				}
+				if (!wireframe)
+					mask &= inside;
+			}
+#endif
+
+			for (mgl_u32_t l = 0; l < 4; ++l)
+			{
+				mgl_i32_t px = x + (mgl_i32_t)l;
+				if (px < x0 || px >= x1 || !(mask & (1u << l)))
+					continue;
+
+				mgl_f32_t ls[3] = { s[0][l], s[1][l], s[2][l] };
+				if (wireframe && !is_wireframe_covered(tri, ls))
+					continue;
+
+				shade_pixel(draw, tri, varyings, px, y, ls);
+			}
+		}
+	}
+}
+
+static void raster_tile_job(mrl_sw_render_device_t* rd, void* data, mgl_u64_t job)
+{
+	const mrl_sw_draw_t* draw = (const mrl_sw_draw_t*)data;
+	mgl_u32_t tile = (mgl_u32_t)job;
+	mgl_i32_t tx = (mgl_i32_t)(tile % draw->tiles_x);
+	mgl_i32_t ty = (mgl_i32_t)(tile / draw->tiles_x);
+
+	mgl_i32_t min_x = max_i32(tx * MRL_SW_TILE_SIZE, draw->clip_min_x);
+	mgl_i32_t min_y = max_i32(ty * MRL_SW_TILE_SIZE, draw->clip_min_y);
+	mgl_i32_t max_x = min_i32((tx + 1) * MRL_SW_TILE_SIZE, draw->clip_max_x);
+	mgl_i32_t max_y = min_i32((ty + 1) * MRL_SW_TILE_SIZE, draw->clip_max_y);
+	if (min_x >= max_x || min_y >= max_y)
+		return;
+
+	// Chunks are walked in order, so triangles are drawn in submission order
+	for (mgl_u32_t c = 0; c < draw->chunk_count; ++c)
+	{
+		const mrl_sw_chunk_t* chunk = &rd->scratch.chunks[c];
+		const mgl_u32_t* bin = chunk->bins + chunk->tile_starts[tile];
+		for (mgl_u32_t i = 0; i < chunk->tile_counts[tile]; ++i)
+		{
+			mgl_u32_t t = bin[i];
+			raster_triangle(draw, &chunk->tris[t], chunk->varyings + (mgl_u64_t)t * 3 * draw->varying_count, min_x, min_y, max_x, max_y);
+		}
+	}
+}
+
+// ---------- Draw functions ----------
+
+static void draw_error(mrl_sw_render_device_t* rd, mrl_error_t err, const mgl_chr8_t* msg)
+{
+	if (rd->error_callback != NULL)
+		rd->error_callback(err, msg);
+}
+
+static void execute_draw(mrl_sw_render_device_t* rd, mgl_u64_t offset, mgl_u64_t count, mgl_u64_t instance_count, mgl_bool_t indexed, mgl_i64_t base_vertex)
+{
+	mrl_sw_draw_t draw;
+	draw.base_vertex = base_vertex;
+	draw.fb = rd->state.framebuffer;
+	draw.rs = rd->state.raster_state;
+	draw.dss = rd->state.depth_stencil_state;
+	draw.bs = rd->state.blend_state;
+	draw.pp = rd->state.pipeline;
+	draw.va = rd->state.vertex_array;
+
+	// Check for input errors
+	if (draw.pp == NULL)
+	{
+		draw_error(rd, MRL_ERROR_INVALID_PARAMS, u8"Failed to draw triangles: no shader pipeline is set");
+		return;
+	}
+	else if (draw.va == NULL)
+	{
+		draw_error(rd, MRL_ERROR_INVALID_PARAMS, u8"Failed to draw triangles: no vertex array is set");
+		return;
+	}
+
+	draw.tri_count = count / 3;
+	draw.instance_count = instance_count;
+	draw.prim_count = draw.tri_count * instance_count;
+	draw.varying_count = draw.pp->varying_count;
+	if (draw.prim_count == 0)
+		return;
+
+	if (indexed)
+	{
+		const mrl_sw_buffer_t* ib = rd->state.index_buffer;
+		if (ib == NULL)
+		{
+			draw_error(rd, MRL_ERROR_INVALID_PARAMS, u8"Failed to draw triangles: no index buffer is set");
+			return;
+		}
+
+		// Offsets are in bytes, like on the OpenGL device
+		draw.index_size = ib->format == MRL_INDEX_BUFFER_FORMAT_U16 ? 2 : 4;
+		if (offset % draw.index_size != 0 || offset + draw.tri_count * 3 * draw.index_size > ib->size)
+		{
+			draw_error(rd, MRL_ERROR_INVALID_PARAMS, u8"Failed to draw triangles: index range out of bounds");
+			return;
+		}
+
+		draw.indices = ib->data + offset;
+		draw.first = 0;
+
+		// Only the referenced vertex range is shaded
+		mgl_u64_t min = ~(mgl_u64_t)0, max = 0;
+		for (mgl_u64_t i = 0; i < draw.tri_count * 3; ++i)
+		{
+			mgl_u64_t index = draw.index_size == 2 ? ((const mgl_u16_t*)draw.indices)[i] : ((const mgl_u32_t*)draw.indices)[i];
+			min = index < min ? index : min;
+			max = index > max ? index : max;
+		}
+		draw.vertex_min = min;
+		draw.vertex_range = max - min + 1;
+	}
+	else
+	{
+		draw.indices = NULL;
+		draw.index_size = 0;
+		draw.first = offset;
+		draw.vertex_min = offset;
+		draw.vertex_range = draw.tri_count * 3;
+	}
+
+	draw.vertex_total = draw.vertex_range * instance_count;
+
+	// Get the viewport and the area which can be drawn
+	draw.viewport[0] = (mgl_f32_t)rd->state.viewport[0];
+	draw.viewport[1] = (mgl_f32_t)rd->state.viewport[1];
+	draw.viewport[2] = (mgl_f32_t)rd->state.viewport[2];
+	draw.viewport[3] = (mgl_f32_t)rd->state.viewport[3];
+	draw.depth_near = draw.dss->depth_near;
+	draw.depth_far = draw.dss->depth_far;
+	draw.clip_min_x = max_i32(rd->state.viewport[0], 0);
+	draw.clip_min_y = max_i32(rd->state.viewport[1], 0);
+	draw.clip_max_x = min_i32(rd->state.viewport[0] + rd->state.viewport[2], (mgl_i32_t)draw.fb->width);
+	draw.clip_max_y = min_i32(rd->state.viewport[1] + rd->state.viewport[3], (mgl_i32_t)draw.fb->height);
+	if (draw.clip_min_x >= draw.clip_max_x || draw.clip_min_y >= draw.clip_max_y)
+		return;
+
+	draw.tiles_x = (draw.fb->width + MRL_SW_TILE_SIZE - 1) / MRL_SW_TILE_SIZE;
+	draw.tiles_y = (draw.fb->height + MRL_SW_TILE_SIZE - 1) / MRL_SW_TILE_SIZE;
+	draw.chunk_count = draw.prim_count < rd->scratch.chunk_count ? (mgl_u32_t)draw.prim_count : rd->scratch.chunk_count;
+
+	// Reserve scratch memory
+	mgl_error_t err = reserve_scratch(rd, (void**)&rd->scratch.vertices, &rd->scratch.vertex_capacity, draw.vertex_total, sizeof(mrl_sw_vertex_output_t));
+	if (err == MGL_ERROR_NONE)
+		err = reserve_tiles(rd, draw.tiles_x * draw.tiles_y);
+	for (mgl_u32_t c = 0; c < draw.chunk_count && err == MGL_ERROR_NONE; ++c)
+	{
+		mrl_sw_chunk_t* chunk = &rd->scratch.chunks[c];
+		chunk->first_prim = draw.prim_count * c / draw.chunk_count;
+		chunk->prim_count = draw.prim_count * (c + 1) / draw.chunk_count - chunk->first_prim;
+		err = reserve_chunk(rd, chunk, chunk->prim_count + 16, draw.varying_count);
+	}
+	if (err != MGL_ERROR_NONE)
+	{
+		draw_error(rd, mrl_make_mgl_error(err), u8"Failed to draw triangles: failed to allocate scratch memory");
+		return;
+	}
+
+	// Shade vertices
+	run_jobs(rd, (draw.vertex_total + MRL_SW_VERTEX_JOB_SIZE - 1) / MRL_SW_VERTEX_JOB_SIZE, &shade_vertices_job, &draw);
+
+	// Clip and set up triangles, retrying the chunks which didn't fit
+	run_jobs(rd, draw.chunk_count, &setup_triangles_job, &draw);
+	for (mgl_u32_t c = 0; c < draw.chunk_count; ++c)
+	{
+		mrl_sw_chunk_t* chunk = &rd->scratch.chunks[c];
+		while (chunk->overflow)
+		{
+			err = reserve_chunk(rd, chunk, chunk->tri_capacity * 2, draw.varying_count);
+			if (err != MGL_ERROR_NONE)
+			{
+				draw_error(rd, mrl_make_mgl_error(err), u8"Failed to draw triangles: failed to allocate scratch memory");
+				return;
+			}
+			setup_triangles_job(rd, &draw, c);
+		}
+	}
+
+	// Bin triangles into tiles
+	for (mgl_u32_t c = 0; c < draw.chunk_count; ++c)
+	{
+		mrl_sw_chunk_t* chunk = &rd->scratch.chunks[c];
+		mgl_u64_t total = 0;
+		for (mgl_u32_t t = 0; t < draw.tiles_x * draw.tiles_y; ++t)
+		{
+			chunk->tile_starts[t] = (mgl_u32_t)total;
+			total += chunk->tile_counts[t];
+		}
+
+		err = reserve_scratch(rd, (void**)&chunk->bins, &chunk->bin_capacity, total, sizeof(mgl_u32_t));
+		if (err != MGL_ERROR_NONE)
+		{
+			draw_error(rd, mrl_make_mgl_error(err), u8"Failed to draw triangles: failed to allocate scratch memory");
+			return;
+		}
+	}
+	run_jobs(rd, draw.chunk_count, &bin_triangles_job, &draw);
+
+	// Rasterize tiles
+	run_jobs(rd, (mgl_u64_t)draw.tiles_x * draw.tiles_y, &raster_tile_job, &draw);
+}
+
+typedef struct
+{
+	const mrl_sw_surface_t* surface;
+	mgl_u32_t offset;
+	mgl_u32_t size;
+	mgl_u8_t value[16];
+} mrl_sw_clear_t;
+
+static void clear_rows_job(mrl_sw_render_device_t* rd, void* data, mgl_u64_t job)
+{
+	const mrl_sw_clear_t* clear = (const mrl_sw_clear_t*)data;
+	const mrl_sw_surface_t* surface = clear->surface;
+	mgl_u64_t texel_size = surface->info.texel_size;
+	mgl_u64_t row_size = texel_size * surface->width;
+
+	mgl_u64_t first_row = job * MRL_SW_CLEAR_JOB_ROW_COUNT;
+	mgl_u64_t last_row = first_row + MRL_SW_CLEAR_JOB_ROW_COUNT;
+	if (last_row > surface->height)
+		last_row = surface->height;
+
+	mgl_u8_t* rows = surface->data + first_row * row_size;
+	if (clear->offset == 0 && clear->size == texel_size)
+	{
+		// Fill the first row and copy it to the others
+		for (mgl_u32_t x = 0; x < surface->width; ++x)
+			mgl_mem_copy(rows + x * texel_size, clear->value, texel_size);
+		for (mgl_u64_t y = first_row + 1; y < last_row; ++y)
+			mgl_mem_copy(rows + (y - first_row) * row_size, rows, row_size);
+	}
+	else
+	{
+		for (mgl_u64_t i = 0; i < (last_row - first_row) * surface->width; ++i)
+			mgl_mem_copy(rows + i * texel_size + clear->offset, clear->value, clear->size);
+	}
+}
+
+static void clear_surface(mrl_sw_render_device_t* rd, mrl_sw_clear_t* clear)
+{
+	mgl_u64_t job_count = (clear->surface->height + MRL_SW_CLEAR_JOB_ROW_COUNT - 1) / MRL_SW_CLEAR_JOB_ROW_COUNT;
+	run_jobs(rd, job_count, &clear_rows_job, clear);
+}
+
+static void clear_color(mrl_render_device_t* brd, mgl_f32_t r, mgl_f32_t g, mgl_f32_t b, mgl_f32_t a)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	const mrl_sw_framebuffer_t* fb = rd->state.framebuffer;
+	const mgl_f32_t color[4] = { r, g, b, a };
+
+	for (mgl_u32_t i = 0; i < fb->target_count; ++i)
+	{
+		mrl_sw_clear_t clear;
+		clear.surface = &fb->targets[i];
+		clear.offset = 0;
+		clear.size = fb->targets[i].info.texel_size;
+		store_texel(&fb->targets[i].info, clear.value, color);
+		clear_surface(rd, &clear);
+	}
+}
+
+static void clear_depth(mrl_render_device_t* brd, mgl_f32_t depth)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	const mrl_sw_framebuffer_t* fb = rd->state.framebuffer;
+	if (fb->depth_stencil.data == NULL)
+		return;
+
+	mrl_sw_clear_t clear;
+	clear.surface = &fb->depth_stencil;
+	clear.offset = 0;
+	clear.size = sizeof(mgl_f32_t);
+	depth = clamp_f32(depth, 0.0f, 1.0f);
+	mgl_mem_copy(clear.value, &depth, sizeof(mgl_f32_t));
+	clear_surface(rd, &clear);
+}
+
+static void clear_stencil(mrl_render_device_t* brd, mgl_i32_t stencil)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	const mrl_sw_framebuffer_t* fb = rd->state.framebuffer;
+	if (fb->depth_stencil.data == NULL || fb->depth_stencil.info.component_type != MRL_SW_COMPONENT_DEPTH_STENCIL)
+		return;
+
+	mrl_sw_clear_t clear;
+	mgl_u32_t value = (mgl_u32_t)stencil & 0xFF;
+	clear.surface = &fb->depth_stencil;
+	clear.offset = 4;
+	clear.size = sizeof(mgl_u32_t);
+	mgl_mem_copy(clear.value, &value, sizeof(mgl_u32_t));
+	clear_surface(rd, &clear);
+}
+
+static void swap_buffers(mrl_render_device_t* brd)
+{
+	// Rendering is synchronous and the default framebuffer is never presented, so there is nothing to do
+}
+
+static void draw_triangles(mrl_render_device_t* brd, mgl_u64_t offset, mgl_u64_t count)
+{
+	execute_draw((mrl_sw_render_device_t*)brd, offset, count, 1, MGL_FALSE, 0);
+}
+
+static void draw_triangles_indexed(mrl_render_device_t* brd, mgl_u64_t offset, mgl_u64_t count)
+{
+	execute_draw((mrl_sw_render_device_t*)brd, offset, count, 1, MGL_TRUE, 0);
+}
+
+static void draw_triangles_instanced(mrl_render_device_t* brd, mgl_u64_t offset, mgl_u64_t count, mgl_u64_t instance_count)
+{
+	execute_draw((mrl_sw_render_device_t*)brd, offset, count, instance_count, MGL_FALSE, 0);
+}
+
+static void draw_triangles_indexed_instanced(mrl_render_device_t* brd, mgl_u64_t offset, mgl_u64_t count, mgl_u64_t instance_count)
+{
+	execute_draw((mrl_sw_render_device_t*)brd, offset, count, instance_count, MGL_TRUE, 0);
+}
+
+static void draw_triangles_indexed_base_vertex(mrl_render_device_t* brd, mgl_u64_t offset, mgl_u64_t count, mgl_i64_t base_vertex)
+{
+	execute_draw((mrl_sw_render_device_t*)brd, offset, count, 1, MGL_TRUE, base_vertex);
+}
+
+static void draw_triangles_indexed_instanced_base_vertex(mrl_render_device_t* brd, mgl_u64_t offset, mgl_u64_t count, mgl_u64_t instance_count, mgl_i64_t base_vertex)
+{
+	execute_draw((mrl_sw_render_device_t*)brd, offset, count, instance_count, MGL_TRUE, base_vertex);
+}
+
+static void multi_draw_triangles(mrl_render_device_t* brd, const mgl_u64_t* offsets, const mgl_u64_t* counts, mgl_u64_t draw_count)
+{
+	for (mgl_u64_t i = 0; i < draw_count; ++i)
+		execute_draw((mrl_sw_render_device_t*)brd, offsets[i], counts[i], 1, MGL_FALSE, 0);
+}
+
+static void multi_draw_triangles_indexed(mrl_render_device_t* brd, const mgl_u64_t* offsets, const mgl_u64_t* counts, const mgl_i64_t* base_vertices, mgl_u64_t draw_count)
+{
+	for (mgl_u64_t i = 0; i < draw_count; ++i)
+		execute_draw((mrl_sw_render_device_t*)brd, offsets[i], counts[i], 1, MGL_TRUE, base_vertices != NULL ? base_vertices[i] : 0);
+}
+
+static const mgl_u8_t* get_indirect_args(mrl_sw_render_device_t* rd, const mrl_sw_buffer_t* buf, mgl_u64_t offset, mgl_u64_t draw_count, mgl_u64_t stride)
+{
+	if (offset % 4 != 0 || offset > buf->size || draw_count > (buf->size - offset) / stride)
+	{
+		draw_error(rd, MRL_ERROR_INVALID_PARAMS, u8"Failed to draw triangles: indirect argument range out of bounds");
+		return NULL;
+	}
+
+	return buf->data + offset;
+}
+
+static void draw_triangles_indirect(mrl_render_device_t* brd, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t draw_count)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	const mgl_u8_t* data = get_indirect_args(rd, (const mrl_sw_buffer_t*)ib, offset, draw_count, sizeof(mrl_draw_indirect_args_t));
+	if (data == NULL)
+		return;
+
+	for (mgl_u64_t i = 0; i < draw_count; ++i)
+	{
+		mrl_draw_indirect_args_t args;
+		mgl_mem_copy(&args, data + i * sizeof(args), sizeof(args));
+		execute_draw(rd, args.first, args.count, args.instance_count, MGL_FALSE, 0);
+	}
+}
+
+static void draw_triangles_indexed_indirect(mrl_render_device_t* brd, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t draw_count)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	const mgl_u8_t* data = get_indirect_args(rd, (const mrl_sw_buffer_t*)ib, offset, draw_count, sizeof(mrl_draw_indexed_indirect_args_t));
+	if (data == NULL)
+		return;
+
+	if (rd->state.index_buffer == NULL)
+	{
+		draw_error(rd, MRL_ERROR_INVALID_PARAMS, u8"Failed to draw triangles: no index buffer is set");
+		return;
+	}
+
+	// The arguments count the first index in indices, while execute_draw takes a byte offset
+	mgl_u64_t index_size = rd->state.index_buffer->format == MRL_INDEX_BUFFER_FORMAT_U16 ? 2 : 4;
+	for (mgl_u64_t i = 0; i < draw_count; ++i)
+	{
+		mrl_draw_indexed_indirect_args_t args;
+		mgl_mem_copy(&args, data + i * sizeof(args), sizeof(args));
+		execute_draw(rd, args.first_index * index_size, args.count, args.instance_count, MGL_TRUE, args.base_vertex);
+	}
+}
+
+static void set_viewport(mrl_render_device_t* brd, mgl_i32_t x, mgl_i32_t y, mgl_i32_t w, mgl_i32_t h)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	rd->state.viewport[0] = x;
+	rd->state.viewport[1] = y;
+	rd->state.viewport[2] = w;
+	rd->state.viewport[3] = h;
+}
+
+// ---------- Getter functions ----------
+
+static const mgl_chr8_t* get_type_name(mrl_render_device_t* brd)
+{
+	return u8"sw";
+}
+
+static mgl_i64_t get_property_i(mrl_render_device_t* brd, mgl_enum_t name)
+{
+	if (name == MRL_PROPERTY_MAX_ANISTROPY)
+		return 1;
+	else if (name == MRL_PROPERTY_CONSTANT_BUFFER_OFFSET_ALIGNMENT)
+		return MRL_SW_CONSTANT_BUFFER_OFFSET_ALIGNMENT;
+	else if (name == MRL_PROPERTY_NATIVE_INDIRECT_DRAWS)
+		return 0;
+	else if (name == MRL_PROPERTY_CUBE_MAP_ARRAYS)
+		return 1;
+
+	return -1;
+}
+
+static mgl_f64_t get_property_f(mrl_render_device_t* brd, mgl_enum_t name)
+{
+	if (name == MRL_PROPERTY_MAX_ANISTROPY)
+		return 1.0;
+
+	return MGL_F64_NAN;
+}
+
+static mrl_object_pool_t* get_rd_pool(mrl_sw_render_device_t* rd, mgl_enum_t type)
+{
+	switch (type)
+	{
+		case MRL_OBJECT_FRAMEBUFFER: return &rd->memory.framebuffer;
+		case MRL_OBJECT_RASTER_STATE: return &rd->memory.raster_state;
+		case MRL_OBJECT_DEPTH_STENCIL_STATE: return &rd->memory.depth_stencil_state;
+		case MRL_OBJECT_BLEND_STATE: return &rd->memory.blend_state;
+		case MRL_OBJECT_SAMPLER: return &rd->memory.sampler;
+		case MRL_OBJECT_TEXTURE_1D: return &rd->memory.texture_1d;
+		case MRL_OBJECT_TEXTURE_2D: return &rd->memory.texture_2d;
+		case MRL_OBJECT_TEXTURE_3D: return &rd->memory.texture_3d;
+		case MRL_OBJECT_CUBE_MAP: return &rd->memory.cube_map;
+		case MRL_OBJECT_CONSTANT_BUFFER: return &rd->memory.constant_buffer;
+		case MRL_OBJECT_INDEX_BUFFER: return &rd->memory.index_buffer;
+		case MRL_OBJECT_VERTEX_BUFFER: return &rd->memory.vertex_buffer;
+		case MRL_OBJECT_VERTEX_ARRAY: return &rd->memory.vertex_array;
+		case MRL_OBJECT_SHADER_STAGE: return &rd->memory.shader_stage;
+		case MRL_OBJECT_SHADER_PIPELINE: return &rd->memory.shader_pipeline;
+		case MRL_OBJECT_STREAM_ALLOCATOR: return &rd->memory.stream_allocator;
+		case MRL_OBJECT_INDIRECT_BUFFER: return &rd->memory.indirect_buffer;
+		case MRL_OBJECT_UPLOAD_QUEUE: return &rd->memory.upload_queue;
+		case MRL_OBJECT_TEXTURE_2D_ARRAY: return &rd->memory.texture_2d_array;
+		case MRL_OBJECT_CUBE_MAP_ARRAY: return &rd->memory.cube_map_array;
+		default: return NULL;
+	}
+}
+
+static mrl_error_t create_rd_allocators(mrl_sw_render_device_t* rd, const mrl_render_device_desc_t* desc)
+{
+	// Object size and number of objects reserved up front, by object type
+	const mgl_u64_t sizes[MRL_SW_OBJECT_POOL_COUNT][2] = {
+		{ sizeof(mrl_sw_framebuffer_t), desc->max_framebuffer_count },
+		{ sizeof(mrl_sw_raster_state_t), desc->max_raster_state_count },
+		{ sizeof(mrl_sw_depth_stencil_state_t), desc->max_depth_stencil_state_count },
+		{ sizeof(mrl_sw_blend_state_t), desc->max_blend_state_count },
+		{ sizeof(mrl_sw_sampler_t), desc->max_sampler_count },
+		{ sizeof(mrl_sw_texture_t), desc->max_texture_1d_count },
+		{ sizeof(mrl_sw_texture_t), desc->max_texture_2d_count },
+		{ sizeof(mrl_sw_texture_t), desc->max_texture_3d_count },
+		{ sizeof(mrl_sw_texture_t), desc->max_cube_map_count },
+		{ sizeof(mrl_sw_buffer_t), desc->max_constant_buffer_count },
+		{ sizeof(mrl_sw_buffer_t), desc->max_index_buffer_count },
+		{ sizeof(mrl_sw_buffer_t), desc->max_vertex_buffer_count },
+		{ sizeof(mrl_sw_vertex_array_t), desc->max_vertex_array_count },
+		{ sizeof(mrl_sw_shader_stage_t), desc->max_shader_stage_count },
+		{ sizeof(mrl_sw_shader_pipeline_t), desc->max_shader_pipeline_count },
+		{ sizeof(mrl_sw_stream_allocator_t), desc->max_stream_allocator_count },
+		{ sizeof(mrl_sw_buffer_t), desc->max_indirect_buffer_count },
+		{ sizeof(mrl_sw_upload_queue_t), desc->max_upload_queue_count },
+		{ sizeof(mrl_sw_texture_t), desc->max_texture_2d_array_count },
+		{ sizeof(mrl_sw_texture_t), desc->max_cube_map_array_count },
+	};
+
+	// Create object pools
+	for (mgl_enum_t i = 0; i < MRL_SW_OBJECT_POOL_COUNT; ++i)
+	{
+		mgl_error_t err = mrl_init_object_pool(get_rd_pool(rd, i), rd->allocator, sizes[i][0], sizes[i][1]);
+		if (err != MGL_ERROR_NONE)
+		{
+			while (i-- > 0)
+				mrl_terminate_object_pool(get_rd_pool(rd, i));
+			return mrl_make_mgl_error(err);
+		}
+	}
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_rd_allocators(mrl_sw_render_device_t* rd)
+{
+	for (mgl_enum_t i = 0; i < MRL_SW_OBJECT_POOL_COUNT; ++i)
+		mrl_terminate_object_pool(get_rd_pool(rd, i));
+}
+
+static void get_object_pool_stats(mrl_render_device_t* brd, mgl_enum_t type, mrl_object_pool_stats_t* stats)
+{
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+	mrl_object_pool_t* pool = get_rd_pool(rd, type);
+	MGL_DEBUG_ASSERT(pool != NULL);
+
+	stats->count = pool->count;
+	stats->high_water_mark = pool->high_water_mark;
+	stats->capacity = pool->capacity;
+}
+
+static void set_rd_functions(mrl_sw_render_device_t* rd)
+{
+	// Framebuffer functions
+	rd->base.create_framebuffer = &create_framebuffer;
+	rd->base.destroy_framebuffer = &destroy_framebuffer;
+	rd->base.set_framebuffer = &set_framebuffer;
+
+	// Raster state functions
+	rd->base.create_raster_state = &create_raster_state;
+	rd->base.destroy_raster_state = &destroy_raster_state;
+	rd->base.set_raster_state = &set_raster_state;
+
+	// Depth stencil state functions
+	rd->base.create_depth_stencil_state = &create_depth_stencil_state;
+	rd->base.destroy_depth_stencil_state = &destroy_depth_stencil_state;
+	rd->base.set_depth_stencil_state = &set_depth_stencil_state;
+
+	// Blend state functions
+	rd->base.create_blend_state = &create_blend_state;
+	rd->base.destroy_blend_state = &destroy_blend_state;
+	rd->base.set_blend_state = &set_blend_state;
+
+	// Sampler functions
+	rd->base.create_sampler = &create_sampler;
+	rd->base.destroy_sampler = &destroy_sampler;
+	rd->base.bind_sampler = &bind_sampler;
+
+	// Texture 1D functions
+	rd->base.create_texture_1d = &create_texture_1d;
+	rd->base.destroy_texture_1d = &destroy_texture_1d;
+	rd->base.generate_texture_1d_mipmaps = &generate_texture_1d_mipmaps;
+	rd->base.bind_texture_1d = &bind_texture_1d;
+	rd->base.update_texture_1d = &update_texture_1d;
+
+	// Texture 2D functions
+	rd->base.create_texture_2d = &create_texture_2d;
+	rd->base.destroy_texture_2d = &destroy_texture_2d;
+	rd->base.generate_texture_2d_mipmaps = &generate_texture_2d_mipmaps;
+	rd->base.bind_texture_2d = &bind_texture_2d;
+	rd->base.update_texture_2d = &update_texture_2d;
+
+	// Texture 3D functions
+	rd->base.create_texture_3d = &create_texture_3d;
+	rd->base.destroy_texture_3d = &destroy_texture_3d;
+	rd->base.generate_texture_3d_mipmaps = &generate_texture_3d_mipmaps;
+	rd->base.bind_texture_3d = &bind_texture_3d;
+	rd->base.update_texture_3d = &update_texture_3d;
+
+	// Cube map functions
+	rd->base.create_cube_map = &create_cube_map;
+	rd->base.destroy_cube_map = &destroy_cube_map;
+	rd->base.generate_cube_map_mipmaps = &generate_cube_map_mipmaps;
+	rd->base.bind_cube_map = &bind_cube_map;
+	rd->base.update_cube_map = &update_cube_map;
+
+	// Texture 2D array functions
+	rd->base.create_texture_2d_array = &create_texture_2d_array;
+	rd->base.destroy_texture_2d_array = &destroy_texture_2d_array;
+	rd->base.generate_texture_2d_array_mipmaps = &generate_texture_2d_array_mipmaps;
+	rd->base.bind_texture_2d_array = &bind_texture_2d_array;
+	rd->base.update_texture_2d_array = &update_texture_2d_array;
+
+	// Cube map array functions
+	rd->base.create_cube_map_array = &create_cube_map_array;
+	rd->base.destroy_cube_map_array = &destroy_cube_map_array;
+	rd->base.generate_cube_map_array_mipmaps = &generate_cube_map_array_mipmaps;
+	rd->base.bind_cube_map_array = &bind_cube_map_array;
+	rd->base.update_cube_map_array = &update_cube_map_array;
+
+	// Constant buffer functions
+	rd->base.create_constant_buffer = &create_constant_buffer;
+	rd->base.destroy_constant_buffer = &destroy_constant_buffer;
+	rd->base.bind_constant_buffer = &bind_constant_buffer;
+	rd->base.bind_constant_buffer_range = &bind_constant_buffer_range;
+	rd->base.map_constant_buffer = &map_constant_buffer;
+	rd->base.unmap_constant_buffer = &unmap_constant_buffer;
+	rd->base.map_constant_buffer_range = &map_constant_buffer_range;
+	rd->base.flush_constant_buffer_range = &flush_constant_buffer_range;
+	rd->base.update_constant_buffer = &update_constant_buffer;
+	rd->base.query_constant_buffer_structure = &query_constant_buffer_structure;
+
+	// Index buffer functions
+	rd->base.create_index_buffer = &create_index_buffer;
+	rd->base.destroy_index_buffer = &destroy_index_buffer;
+	rd->base.set_index_buffer = &set_index_buffer;
+	rd->base.map_index_buffer = &map_index_buffer;
+	rd->base.unmap_index_buffer = &unmap_index_buffer;
+	rd->base.map_index_buffer_range = &map_index_buffer_range;
+	rd->base.flush_index_buffer_range = &flush_index_buffer_range;
+	rd->base.update_index_buffer = &update_index_buffer;
+
+	// Indirect buffer functions
+	rd->base.create_indirect_buffer = &create_indirect_buffer;
+	rd->base.destroy_indirect_buffer = &destroy_indirect_buffer;
+	rd->base.update_indirect_buffer = &update_indirect_buffer;
+
+	// Vertex buffer functions
+	rd->base.create_vertex_buffer = &create_vertex_buffer;
+	rd->base.destroy_vertex_buffer = &destroy_vertex_buffer;
+	rd->base.map_vertex_buffer = &map_vertex_buffer;
+	rd->base.unmap_vertex_buffer = &unmap_vertex_buffer;
+	rd->base.map_vertex_buffer_range = &map_vertex_buffer_range;
+	rd->base.flush_vertex_buffer_range = &flush_vertex_buffer_range;
+	rd->base.update_vertex_buffer = &update_vertex_buffer;
+
+	// Vertex array functions
+	rd->base.create_vertex_array = &create_vertex_array;
+	rd->base.destroy_vertex_array = &destroy_vertex_array;
+	rd->base.set_vertex_array = &set_vertex_array;
+
+	// Stream allocator functions
+	rd->base.create_stream_allocator = &create_stream_allocator;
+	rd->base.destroy_stream_allocator = &destroy_stream_allocator;
+	rd->base.map_stream_allocation = &map_stream_allocation;
+	rd->base.unmap_stream_allocation = &unmap_stream_allocation;
+	rd->base.end_stream_allocator_frame = &end_stream_allocator_frame;
+
+	// Upload queue functions
+	rd->base.create_upload_queue = &create_upload_queue;
+	rd->base.destroy_upload_queue = &destroy_upload_queue;
+	rd->base.upload_texture_1d = &upload_texture_1d;
+	rd->base.upload_texture_2d = &upload_texture_2d;
+	rd->base.upload_texture_3d = &upload_texture_3d;
+	rd->base.upload_cube_map = &upload_cube_map;
+	rd->base.is_upload_complete = &is_upload_complete;
+	rd->base.wait_upload = &wait_upload;
+
+	// Shader functions
+	rd->base.create_shader_stage = &create_shader_stage;
+	rd->base.destroy_shader_stage = &destroy_shader_stage;
+	rd->base.create_shader_pipeline = &create_shader_pipeline;
+	rd->base.destroy_shader_pipeline = &destroy_shader_pipeline;
+	rd->base.set_shader_pipeline = &set_shader_pipeline;
+	rd->base.get_shader_binding_point = &get_shader_binding_point;
+	rd->base.get_shader_binding_point_by_id = &get_shader_binding_point_by_id;
+
+	// Draw functions
+	rd->base.clear_color = &clear_color;
+	rd->base.clear_depth = &clear_depth;
+	rd->base.clear_stencil = &clear_stencil;
+	rd->base.swap_buffers = &swap_buffers;
+	rd->base.draw_triangles = &draw_triangles;
+	rd->base.draw_triangles_indexed = &draw_triangles_indexed;
+	rd->base.draw_triangles_instanced = &draw_triangles_instanced;
+	rd->base.draw_triangles_indexed_instanced = &draw_triangles_indexed_instanced;
+	rd->base.draw_triangles_indexed_base_vertex = &draw_triangles_indexed_base_vertex;
+	rd->base.draw_triangles_indexed_instanced_base_vertex = &draw_triangles_indexed_instanced_base_vertex;
+	rd->base.multi_draw_triangles = &multi_draw_triangles;
+	rd->base.multi_draw_triangles_indexed = &multi_draw_triangles_indexed;
+	rd->base.draw_triangles_indirect = &draw_triangles_indirect;
+	rd->base.draw_triangles_indexed_indirect = &draw_triangles_indexed_indirect;
+	rd->base.set_viewport = &set_viewport;
+
+	// Getter functions
+	rd->base.get_type_name = &get_type_name;
+	rd->base.get_property_i = &get_property_i;
+	rd->base.get_property_f = &get_property_f;
+	rd->base.get_object_pool_stats = &get_object_pool_stats;
+}
+
+static void extract_hints(mrl_sw_render_device_t* rd, const mrl_render_device_desc_t* desc)
+{
+	for (const mrl_hint_t* hint = desc->hints; hint != NULL; hint = hint->next)
+	{
+		// Check if the hint should be skipped
+		if (hint->device_type != NULL && !mgl_str_equal(hint->device_type, u8"sw"))
+			continue;
+
+		// Extract hint info
+		switch (hint->type)
+		{
+			case MRL_HINT_RENDER_DEVICE_WARNING_CALLBACK:
+				MGL_DEBUG_ASSERT(hint->data != NULL);
+				rd->warning_callback = *(const mrl_render_device_hint_warning_callback_t*)hint->data;
+				break;
+
+			case MRL_HINT_RENDER_DEVICE_ERROR_CALLBACK:
+				MGL_DEBUG_ASSERT(hint->data != NULL);
+				rd->error_callback = *(const mrl_render_device_hint_error_callback_t*)hint->data;
+				break;
+
+			case MRL_HINT_RENDER_DEVICE_OFFSCREEN_SIZE:
+				MGL_DEBUG_ASSERT(hint->data != NULL);
+				rd->offscreen.width = ((const mgl_u32_t*)hint->data)[0];
+				rd->offscreen.height = ((const mgl_u32_t*)hint->data)[1];
+				break;
+
+			case MRL_HINT_RENDER_DEVICE_THREAD_COUNT:
+				MGL_DEBUG_ASSERT(hint->data != NULL);
+				rd->workers.count = *(const mgl_u32_t*)hint->data;
+				break;
+
+			default:
+				// Unsupported hint type, ignore it
+				continue;
+		}
+	}
+}
+
+static mrl_error_t create_offscreen_framebuffer(mrl_sw_render_device_t* rd)
+{
+	mgl_u64_t texel_count = (mgl_u64_t)rd->offscreen.width * rd->offscreen.height;
+
+	// Create color and depth/stencil storage
+	mgl_error_t err = mgl_allocate(rd->allocator, texel_count * 4, (void**)&rd->offscreen.color);
+	if (err != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(err);
+
+	err = mgl_allocate(rd->allocator, texel_count * 8, (void**)&rd->offscreen.depth_stencil);
+	if (err != MGL_ERROR_NONE)
+	{
+		mgl_deallocate(rd->allocator, rd->offscreen.color);
+		return mrl_make_mgl_error(err);
+	}
+
+	mgl_mem_set(rd->offscreen.color, texel_count * 4, 0);
+	mgl_mem_set(rd->offscreen.depth_stencil, texel_count * 8, 0);
+
+	// Set up the default framebuffer
+	mrl_sw_framebuffer_t* fb = &rd->offscreen.fb;
+	fb->target_count = 1;
+	fb->targets[0].data = rd->offscreen.color;
+	fb->targets[0].format = MRL_TEXTURE_FORMAT_RGBA8_UN;
+	get_format_info(MRL_TEXTURE_FORMAT_RGBA8_UN, &fb->targets[0].info);
+	fb->targets[0].width = rd->offscreen.width;
+	fb->targets[0].height = rd->offscreen.height;
+	fb->depth_stencil.data = rd->offscreen.depth_stencil;
+	fb->depth_stencil.format = MRL_TEXTURE_FORMAT_D24S8;
+	get_format_info(MRL_TEXTURE_FORMAT_D24S8, &fb->depth_stencil.info);
+	fb->depth_stencil.width = rd->offscreen.width;
+	fb->depth_stencil.height = rd->offscreen.height;
+	fb->width = rd->offscreen.width;
+	fb->height = rd->offscreen.height;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_offscreen_framebuffer(mrl_sw_render_device_t* rd)
+{
+	mgl_deallocate(rd->allocator, rd->offscreen.depth_stencil);
+	mgl_deallocate(rd->allocator, rd->offscreen.color);
+}
+
+static mrl_error_t create_scratch(mrl_sw_render_device_t* rd)
+{
+	rd->scratch.vertex_capacity = 0;
+	rd->scratch.vertices = NULL;
+	rd->scratch.tile_capacity = 0;
+
+	// Use more chunks than threads, so that uneven chunks are balanced out
+	rd->scratch.chunk_count = rd->workers.count * MRL_SW_CHUNKS_PER_THREAD;
+	mgl_error_t err = mgl_allocate(rd->allocator, sizeof(mrl_sw_chunk_t) * rd->scratch.chunk_count, (void**)&rd->scratch.chunks);
+	if (err != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(err);
+	mgl_mem_set(rd->scratch.chunks, sizeof(mrl_sw_chunk_t) * rd->scratch.chunk_count, 0);
+
+	return MRL_ERROR_NONE;
+}
+
+MRL_API mrl_error_t mrl_init_sw_render_device(const mrl_render_device_desc_t* desc, mrl_render_device_t** out_rd)
+{
+	MGL_DEBUG_ASSERT(desc != NULL && out_rd != NULL);
+	MGL_DEBUG_ASSERT(desc->allocator != NULL);
+
+	// Only headless devices are supported
+	if (desc->window != NULL)
+		return MRL_ERROR_UNSUPPORTED_WINDOW;
+
+	// Allocate render device
+	mrl_sw_render_device_t* rd;
+	mgl_error_t mglerr = mgl_allocate(desc->allocator, sizeof(mrl_sw_render_device_t), (void**)&rd);
+	if (mglerr != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(mglerr);
+
+	rd->allocator = desc->allocator;
+	rd->error_callback = NULL;
+	rd->warning_callback = NULL;
+	rd->offscreen.width = 1280;
+	rd->offscreen.height = 720;
+	rd->workers.count = mrl_get_hardware_thread_count();
+
+	// Extract hints
+	extract_hints(rd, desc);
+
+	// Create allocators
+	mrl_error_t err = create_rd_allocators(rd, desc);
+	if (err != MRL_ERROR_NONE)
+	{
+		mgl_deallocate(rd->allocator, rd);
+		return err;
+	}
+
+	// Create default framebuffer
+	err = create_offscreen_framebuffer(rd);
+	if (err != MRL_ERROR_NONE)
+	{
+		destroy_rd_allocators(rd);
+		mgl_deallocate(rd->allocator, rd);
+		return err;
+	}
+
+	// Start worker threads
+	err = start_workers(rd, rd->workers.count);
+	if (err != MRL_ERROR_NONE)
+	{
+		destroy_offscreen_framebuffer(rd);
+		destroy_rd_allocators(rd);
+		mgl_deallocate(rd->allocator, rd);
+		return err;
+	}
+
+	err = create_scratch(rd);
+	if (err != MRL_ERROR_NONE)
+	{
+		terminate_workers(rd);
+		destroy_offscreen_framebuffer(rd);
+		destroy_rd_allocators(rd);
+		mgl_deallocate(rd->allocator, rd);
+		return err;
+	}
+
+	// Set render device funcs
+	set_rd_functions(rd);
+
+	// Set default states
+	rd->default_raster_state.cull_enabled = MGL_FALSE;
+	rd->default_raster_state.cull_face = MRL_FACE_BACK;
+	rd->default_raster_state.front_face = MRL_WINDING_CCW;
+	rd->default_raster_state.wireframe = MGL_FALSE;
+
+	rd->default_depth_stencil_state.depth_enabled = MGL_FALSE;
+	rd->default_depth_stencil_state.depth_write_enabled = MGL_TRUE;
+	rd->default_depth_stencil_state.depth_near = 0.0f;
+	rd->default_depth_stencil_state.depth_far = 1.0f;
+	rd->default_depth_stencil_state.depth_compare = MRL_COMPARE_LESS;
+	rd->default_depth_stencil_state.stencil_enabled = MGL_FALSE;
+	rd->default_depth_stencil_state.stencil_ref = 0;
+	rd->default_depth_stencil_state.stencil_read_mask = 0xFF;
+	rd->default_depth_stencil_state.stencil_write_mask = 0xFF;
+	for (mgl_u32_t i = 0; i < 2; ++i)
+	{
+		rd->default_depth_stencil_state.stencil[i].compare = MRL_COMPARE_ALWAYS;
+		rd->default_depth_stencil_state.stencil[i].fail = MRL_ACTION_KEEP;
+		rd->default_depth_stencil_state.stencil[i].pass = MRL_ACTION_KEEP;
+		rd->default_depth_stencil_state.stencil[i].depth_fail = MRL_ACTION_KEEP;
+	}
+
+	rd->default_blend_state.blend_enabled = MGL_FALSE;
+	rd->default_blend_state.src_factor = MRL_BLEND_FACTOR_ONE;
+	rd->default_blend_state.dst_factor = MRL_BLEND_FACTOR_ZERO;
+	rd->default_blend_state.op = MRL_BLEND_OP_ADD;
+	rd->default_blend_state.src_alpha_factor = MRL_BLEND_FACTOR_ONE;
+	rd->default_blend_state.dst_alpha_factor = MRL_BLEND_FACTOR_ZERO;
+	rd->default_blend_state.alpha_op = MRL_BLEND_OP_ADD;
+
+	for (mgl_u32_t i = 0; i < 4; ++i)
+		rd->default_sampler.border_color[i] = 0.0f;
+	rd->default_sampler.min_filter = MRL_SAMPLER_FILTER_NEAREST;
+	rd->default_sampler.mag_filter = MRL_SAMPLER_FILTER_NEAREST;
+	rd->default_sampler.mip_filter = MRL_SAMPLER_FILTER_NONE;
+	for (mgl_u32_t i = 0; i < 3; ++i)
+		rd->default_sampler.address[i] = MRL_SAMPLER_ADDRESS_CLAMP;
+
+	rd->state.framebuffer = &rd->offscreen.fb;
+	rd->state.raster_state = &rd->default_raster_state;
+	rd->state.depth_stencil_state = &rd->default_depth_stencil_state;
+	rd->state.blend_state = &rd->default_blend_state;
+	rd->state.pipeline = NULL;
+	rd->state.vertex_array = NULL;
+	rd->state.index_buffer = NULL;
+	rd->state.viewport[0] = 0;
+	rd->state.viewport[1] = 0;
+	rd->state.viewport[2] = (mgl_i32_t)rd->offscreen.width;
+	rd->state.viewport[3] = (mgl_i32_t)rd->offscreen.height;
+
+	*out_rd = (mrl_render_device_t*)rd;
+
+	return MRL_ERROR_NONE;
+}
+
+MRL_API void mrl_terminate_sw_render_device(mrl_render_device_t* brd)
+{
+	MGL_DEBUG_ASSERT(brd != NULL);
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	// Free draw memory and stop workers
+	destroy_scratch(rd);
+	terminate_workers(rd);
+
+	// Destroy default framebuffer
+	destroy_offscreen_framebuffer(rd);
+
+	// Destroy allocators
+	destroy_rd_allocators(rd);
+
+	// Deallocate
+	MGL_DEBUG_ASSERT(mgl_deallocate(rd->allocator, rd) == MRL_ERROR_NONE);
+}
+
+MRL_API const mgl_u8_t* mrl_get_sw_default_framebuffer_pixels(mrl_render_device_t* brd, mgl_u32_t* width, mgl_u32_t* height)
+{
+	MGL_DEBUG_ASSERT(brd != NULL);
+	mrl_sw_render_device_t* rd = (mrl_sw_render_device_t*)brd;
+
+	if (width != NULL)
+		*width = rd->offscreen.width;
+	if (height != NULL)
+		*height = rd->offscreen.height;
+	return rd->offscreen.color;
+}
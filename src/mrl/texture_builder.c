@@ -0,0 +1,852 @@
+#include <mrl/texture_builder.h>
+#include <mrl/thread.h>
+
+#include <mgl/memory/allocator.h>
+
+#include <math.h>
+
+// SSE2 and NEON are always available on x86-64 and AArch64, so they don't need runtime detection or extra compiler flags
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define MRL_BUILDER_SSE2
+#	include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#	define MRL_BUILDER_NEON
+#	include <arm_neon.h>
+#endif
+
+#define MRL_MAX_BUILD_THREAD_COUNT 16
+
+// Minimum number of texels processed by each thread, so that small images don't pay for starting threads
+#define MRL_BUILD_TEXELS_PER_THREAD 65536
+#define MRL_BUILD_CHUNKS_PER_THREAD 4
+
+// Number of texels converted at once, which fit in a stack buffer
+#define MRL_CONVERT_BATCH_SIZE 256
+
+#define MRL_MAX_FILTER_TAP_COUNT 6
+#define MRL_KAISER_ALPHA 4.0
+#define MRL_KAISER_RADIUS 3.0
+#define MRL_BUILDER_PI 3.14159265358979323846
+
+enum
+{
+	MRL_CHANNEL_UN,
+	MRL_CHANNEL_SN,
+	MRL_CHANNEL_UI,
+	MRL_CHANNEL_SI,
+	MRL_CHANNEL_F,
+};
+
+typedef struct
+{
+	mgl_u32_t channel_count;
+	mgl_u32_t channel_size;
+	mgl_enum_t channel_type;
+} mrl_builder_format_info_t;
+
+// Source texels read by each destination texel along an axis, starting at twice the destination coordinate plus the offset
+typedef struct
+{
+	mgl_u32_t count;
+	mgl_i64_t offset;
+	mgl_f64_t weights[MRL_MAX_FILTER_TAP_COUNT];
+} mrl_filter_taps_t;
+
+typedef void(*mrl_build_range_func_t)(void* job, mgl_u32_t worker, mgl_u64_t first, mgl_u64_t last);
+
+typedef struct
+{
+	mrl_build_range_func_t func;
+	void* job;
+	mgl_u64_t item_count;
+	mgl_u64_t items_per_chunk;
+	mgl_u32_t chunk_count;
+	mrl_atomic_u32_t next_chunk;
+	mrl_atomic_u32_t next_worker;
+} mrl_build_dispatch_t;
+
+typedef struct
+{
+	mrl_builder_format_info_t info;
+	mgl_u64_t texel_size;
+	const mgl_f64_t* srgb_to_linear;
+	mgl_bool_t box_fast_path;
+	mrl_filter_taps_t x_taps, y_taps;
+	const mgl_u8_t* src;
+	mgl_u8_t* dst;
+	mgl_u64_t src_width, src_height;
+	mgl_u64_t dst_width, dst_height;
+	mgl_f64_t* scratch;
+} mrl_mip_job_t;
+
+typedef struct
+{
+	mrl_builder_format_info_t src_info, dst_info;
+	const mgl_u8_t* src;
+	mgl_u8_t* dst;
+} mrl_convert_job_t;
+
+// ---------- Formats ----------
+
+static mgl_bool_t get_format_info(mgl_enum_t format, mrl_builder_format_info_t* info)
+{
+	switch (format)
+	{
+		case MRL_TEXTURE_FORMAT_R8_UN: *info = (mrl_builder_format_info_t) { 1, 1, MRL_CHANNEL_UN }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_R8_SN: *info = (mrl_builder_format_info_t) { 1, 1, MRL_CHANNEL_SN }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_R8_UI: *info = (mrl_builder_format_info_t) { 1, 1, MRL_CHANNEL_UI }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_R8_SI: *info = (mrl_builder_format_info_t) { 1, 1, MRL_CHANNEL_SI }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_RG8_UN: *info = (mrl_builder_format_info_t) { 2, 1, MRL_CHANNEL_UN }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_RG8_SN: *info = (mrl_builder_format_info_t) { 2, 1, MRL_CHANNEL_SN }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_RG8_UI: *info = (mrl_builder_format_info_t) { 2, 1, MRL_CHANNEL_UI }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_RG8_SI: *info = (mrl_builder_format_info_t) { 2, 1, MRL_CHANNEL_SI }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_RGBA8_UN: *info = (mrl_builder_format_info_t) { 4, 1, MRL_CHANNEL_UN }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_RGBA8_SN: *info = (mrl_builder_format_info_t) { 4, 1, MRL_CHANNEL_SN }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_RGBA8_UI: *info = (mrl_builder_format_info_t) { 4, 1, MRL_CHANNEL_UI }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_RGBA8_SI: *info = (mrl_builder_format_info_t) { 4, 1, MRL_CHANNEL_SI }; return MGL_TRUE;
+
+		case MRL_TEXTURE_FORMAT_R16_UN: *info = (mrl_builder_format_info_t) { 1, 2, MRL_CHANNEL_UN }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_R16_SN: *info = (mrl_builder_format_info_t) { 1, 2, MRL_CHANNEL_SN }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_R16_UI: *info = (mrl_builder_format_info_t) { 1, 2, MRL_CHANNEL_UI }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_R16_SI: *info = (mrl_builder_format_info_t) { 1, 2, MRL_CHANNEL_SI }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_RG16_UN: *info = (mrl_builder_format_info_t) { 2, 2, MRL_CHANNEL_UN }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_RG16_SN: *info = (mrl_builder_format_info_t) { 2, 2, MRL_CHANNEL_SN }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_RG16_UI: *info = (mrl_builder_format_info_t) { 2, 2, MRL_CHANNEL_UI }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_RG16_SI: *info = (mrl_builder_format_info_t) { 2, 2, MRL_CHANNEL_SI }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_RGBA16_UN: *info = (mrl_builder_format_info_t) { 4, 2, MRL_CHANNEL_UN }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_RGBA16_SN: *info = (mrl_builder_format_info_t) { 4, 2, MRL_CHANNEL_SN }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_RGBA16_UI: *info = (mrl_builder_format_info_t) { 4, 2, MRL_CHANNEL_UI }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_RGBA16_SI: *info = (mrl_builder_format_info_t) { 4, 2, MRL_CHANNEL_SI }; return MGL_TRUE;
+
+		case MRL_TEXTURE_FORMAT_R32_UI: *info = (mrl_builder_format_info_t) { 1, 4, MRL_CHANNEL_UI }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_R32_SI: *info = (mrl_builder_format_info_t) { 1, 4, MRL_CHANNEL_SI }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_R32_F: *info = (mrl_builder_format_info_t) { 1, 4, MRL_CHANNEL_F }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_RG32_UI: *info = (mrl_builder_format_info_t) { 2, 4, MRL_CHANNEL_UI }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_RG32_SI: *info = (mrl_builder_format_info_t) { 2, 4, MRL_CHANNEL_SI }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_RG32_F: *info = (mrl_builder_format_info_t) { 2, 4, MRL_CHANNEL_F }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_RGBA32_UI: *info = (mrl_builder_format_info_t) { 4, 4, MRL_CHANNEL_UI }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_RGBA32_SI: *info = (mrl_builder_format_info_t) { 4, 4, MRL_CHANNEL_SI }; return MGL_TRUE;
+		case MRL_TEXTURE_FORMAT_RGBA32_F: *info = (mrl_builder_format_info_t) { 4, 4, MRL_CHANNEL_F }; return MGL_TRUE;
+
+		default: return MGL_FALSE;
+	}
+}
+
+MRL_API mgl_u64_t mrl_get_texel_size(mgl_enum_t format)
+{
+	mrl_builder_format_info_t info;
+	if (get_format_info(format, &info))
+		return (mgl_u64_t)info.channel_count * info.channel_size;
+
+	switch (format)
+	{
+		case MRL_TEXTURE_FORMAT_D16: return 2;
+		case MRL_TEXTURE_FORMAT_D32: return 4;
+		case MRL_TEXTURE_FORMAT_D24S8: return 4;
+		case MRL_TEXTURE_FORMAT_D32S8: return 8;
+		default: return 0;
+	}
+}
+
+// ---------- Channels ----------
+
+// Normalized channels are loaded in the [0, 1] or [-1, 1] ranges, and integer channels keep their values
+static mgl_f64_t load_channel(const mrl_builder_format_info_t* info, const mgl_u8_t* data)
+{
+	switch (info->channel_type)
+	{
+		case MRL_CHANNEL_UN:
+			if (info->channel_size == 1)
+				return *data / 255.0;
+			return *(const mgl_u16_t*)data / 65535.0;
+
+		case MRL_CHANNEL_SN:
+		{
+			// Both the minimum value and the one above it map to -1
+			mgl_f64_t v = info->channel_size == 1 ? *(const mgl_i8_t*)data / 127.0 : *(const mgl_i16_t*)data / 32767.0;
+			return v < -1.0 ? -1.0 : v;
+		}
+
+		case MRL_CHANNEL_UI:
+			if (info->channel_size == 1)
+				return *data;
+			else if (info->channel_size == 2)
+				return *(const mgl_u16_t*)data;
+			return *(const mgl_u32_t*)data;
+
+		case MRL_CHANNEL_SI:
+			if (info->channel_size == 1)
+				return *(const mgl_i8_t*)data;
+			else if (info->channel_size == 2)
+				return *(const mgl_i16_t*)data;
+			return *(const mgl_i32_t*)data;
+
+		default:
+			return *(const mgl_f32_t*)data;
+	}
+}
+
+// Rounds half away from zero, after clamping to a range. NaNs are clamped to the minimum
+static mgl_f64_t round_clamped(mgl_f64_t v, mgl_f64_t min, mgl_f64_t max)
+{
+	if (!(v >= min))
+		return min;
+	if (v > max)
+		return max;
+	return v < 0.0 ? ceil(v - 0.5) : floor(v + 0.5);
+}
+
+static void store_channel(const mrl_builder_format_info_t* info, mgl_f64_t v, mgl_u8_t* data)
+{
+	switch (info->channel_type)
+	{
+		case MRL_CHANNEL_UN:
+			if (info->channel_size == 1)
+				*data = (mgl_u8_t)round_clamped(v * 255.0, 0.0, 255.0);
+			else
+				*(mgl_u16_t*)data = (mgl_u16_t)round_clamped(v * 65535.0, 0.0, 65535.0);
+			break;
+
+		case MRL_CHANNEL_SN:
+			if (info->channel_size == 1)
+				*(mgl_i8_t*)data = (mgl_i8_t)round_clamped(v * 127.0, -127.0, 127.0);
+			else
+				*(mgl_i16_t*)data = (mgl_i16_t)round_clamped(v * 32767.0, -32767.0, 32767.0);
+			break;
+
+		case MRL_CHANNEL_UI:
+			if (info->channel_size == 1)
+				*data = (mgl_u8_t)round_clamped(v, 0.0, 255.0);
+			else if (info->channel_size == 2)
+				*(mgl_u16_t*)data = (mgl_u16_t)round_clamped(v, 0.0, 65535.0);
+			else
+				*(mgl_u32_t*)data = (mgl_u32_t)round_clamped(v, 0.0, 4294967295.0);
+			break;
+
+		case MRL_CHANNEL_SI:
+			if (info->channel_size == 1)
+				*(mgl_i8_t*)data = (mgl_i8_t)round_clamped(v, -128.0, 127.0);
+			else if (info->channel_size == 2)
+				*(mgl_i16_t*)data = (mgl_i16_t)round_clamped(v, -32768.0, 32767.0);
+			else
+				*(mgl_i32_t*)data = (mgl_i32_t)round_clamped(v, -2147483648.0, 2147483647.0);
+			break;
+
+		default:
+			*(mgl_f32_t*)data = (mgl_f32_t)v;
+			break;
+	}
+}
+
+static mgl_f64_t srgb_to_linear(mgl_f64_t v)
+{
+	return v <= 0.04045 ? v / 12.92 : pow((v + 0.055) / 1.055, 2.4);
+}
+
+static mgl_f64_t linear_to_srgb(mgl_f64_t v)
+{
+	if (!(v > 0.0))
+		return 0.0;
+	if (v >= 1.0)
+		return 1.0;
+	return v <= 0.0031308 ? v * 12.92 : 1.055 * pow(v, 1.0 / 2.4) - 0.055;
+}
+
+// Loads texels as RGBA, with missing channels set to 0, except for alpha, which is set to 1.
+// If a sRGB table is passed, the color channels of 8 bit normalized texels are converted to linear space
+static void load_texels(const mrl_builder_format_info_t* info, const mgl_f64_t* srgb_table, const mgl_u8_t* data, mgl_u64_t count, mgl_f64_t* out)
+{
+	for (mgl_u64_t i = 0; i < count; ++i, out += 4)
+	{
+		for (mgl_u32_t c = 0; c < info->channel_count; ++c, data += info->channel_size)
+			out[c] = (srgb_table != NULL && c < 3) ? srgb_table[*data] : load_channel(info, data);
+		for (mgl_u32_t c = info->channel_count; c < 4; ++c)
+			out[c] = c == 3 ? 1.0 : 0.0;
+	}
+}
+
+static void store_texels(const mrl_builder_format_info_t* info, mgl_bool_t srgb, const mgl_f64_t* in, mgl_u64_t count, mgl_u8_t* data)
+{
+	for (mgl_u64_t i = 0; i < count; ++i, in += 4)
+		for (mgl_u32_t c = 0; c < info->channel_count; ++c, data += info->channel_size)
+			store_channel(info, (srgb && c < 3) ? linear_to_srgb(in[c]) : in[c], data);
+}
+
+// ---------- Dispatch ----------
+
+static mgl_u32_t get_thread_count(mgl_u64_t texel_count, mgl_u32_t max_thread_count)
+{
+	// Only start as many threads as there is enough work for
+	mgl_u64_t thread_count = texel_count / MRL_BUILD_TEXELS_PER_THREAD;
+	mgl_u32_t hardware_thread_count = mrl_get_hardware_thread_count();
+	if (thread_count > hardware_thread_count)
+		thread_count = hardware_thread_count;
+	if (max_thread_count != 0 && thread_count > max_thread_count)
+		thread_count = max_thread_count;
+	if (thread_count > MRL_MAX_BUILD_THREAD_COUNT)
+		thread_count = MRL_MAX_BUILD_THREAD_COUNT;
+	if (thread_count < 1)
+		thread_count = 1;
+	return (mgl_u32_t)thread_count;
+}
+
+static void run_chunks(void* arg)
+{
+	mrl_build_dispatch_t* dispatch = (mrl_build_dispatch_t*)arg;
+
+	// Each thread gets its own index, which selects its scratch memory
+	mgl_u32_t worker = mrl_atomic_fetch_add(&dispatch->next_worker, 1);
+	for (;;)
+	{
+		mgl_u32_t chunk = mrl_atomic_fetch_add(&dispatch->next_chunk, 1);
+		if (chunk >= dispatch->chunk_count)
+			break;
+
+		mgl_u64_t first = (mgl_u64_t)chunk * dispatch->items_per_chunk;
+		mgl_u64_t last = first + dispatch->items_per_chunk < dispatch->item_count ? first + dispatch->items_per_chunk : dispatch->item_count;
+		dispatch->func(dispatch->job, worker, first, last);
+	}
+}
+
+// Calls a function on chunks of a range of items, split between up to thread_count threads
+static void dispatch_chunks(mrl_build_range_func_t func, void* job, mgl_u64_t item_count, mgl_u32_t thread_count)
+{
+	if (item_count == 0)
+		return;
+
+	// Split the items into more chunks than threads, so that uneven chunks are balanced out
+	mrl_build_dispatch_t dispatch;
+	mgl_u64_t chunk_count = (mgl_u64_t)thread_count * MRL_BUILD_CHUNKS_PER_THREAD;
+	if (chunk_count > item_count)
+		chunk_count = item_count;
+	dispatch.func = func;
+	dispatch.job = job;
+	dispatch.item_count = item_count;
+	dispatch.items_per_chunk = (item_count + chunk_count - 1) / chunk_count;
+	dispatch.chunk_count = (mgl_u32_t)((item_count + dispatch.items_per_chunk - 1) / dispatch.items_per_chunk);
+	mrl_atomic_store(&dispatch.next_chunk, 0);
+	mrl_atomic_store(&dispatch.next_worker, 0);
+
+	// The calling thread works too, and picks up the chunks of threads which failed to start
+	mrl_thread_t threads[MRL_MAX_BUILD_THREAD_COUNT];
+	mgl_u32_t started_count = 0;
+	for (mgl_u32_t i = 1; i < thread_count; ++i)
+	{
+		if (mrl_start_thread(&threads[started_count], &run_chunks, &dispatch) != MRL_ERROR_NONE)
+			break;
+		++started_count;
+	}
+
+	run_chunks(&dispatch);
+	for (mgl_u32_t i = 0; i < started_count; ++i)
+		mrl_join_thread(&threads[i]);
+}
+
+// ---------- Filters ----------
+
+static mgl_f64_t bessel_i0(mgl_f64_t x)
+{
+	mgl_f64_t sum = 1.0, term = 1.0;
+	for (mgl_u32_t k = 1; k < 32; ++k)
+	{
+		term *= (x * x * 0.25) / ((mgl_f64_t)k * k);
+		sum += term;
+	}
+	return sum;
+}
+
+static void get_filter_taps(mgl_enum_t filter, mgl_u64_t src_size, mrl_filter_taps_t* taps)
+{
+	// Axes which are already a single texel wide aren't filtered
+	if (src_size == 1)
+	{
+		taps->count = 1;
+		taps->offset = 0;
+		taps->weights[0] = 1.0;
+	}
+	else if (filter == MRL_MIP_FILTER_BOX)
+	{
+		taps->count = 2;
+		taps->offset = 0;
+		taps->weights[0] = 0.5;
+		taps->weights[1] = 0.5;
+	}
+	else
+	{
+		// Sinc scaled to the destination texel size, windowed by a Kaiser window over the 6 closest source texels
+		taps->count = 6;
+		taps->offset = -2;
+		mgl_f64_t sum = 0.0;
+		for (mgl_u32_t i = 0; i < taps->count; ++i)
+		{
+			mgl_f64_t d = (mgl_f64_t)i - 2.5;
+			mgl_f64_t x = MRL_BUILDER_PI * d * 0.5;
+			mgl_f64_t r = d / MRL_KAISER_RADIUS;
+			taps->weights[i] = (sin(x) / x) * bessel_i0(MRL_KAISER_ALPHA * sqrt(1.0 - r * r)) / bessel_i0(MRL_KAISER_ALPHA);
+			sum += taps->weights[i];
+		}
+		for (mgl_u32_t i = 0; i < taps->count; ++i)
+			taps->weights[i] /= sum;
+	}
+}
+
+static mgl_u64_t get_tap_coord(const mrl_filter_taps_t* taps, mgl_u64_t dst_coord, mgl_u32_t tap, mgl_u64_t src_size)
+{
+	mgl_i64_t coord = (mgl_i64_t)(2 * dst_coord) + taps->offset + tap;
+	if (coord < 0)
+		return 0;
+	if ((mgl_u64_t)coord >= src_size)
+		return src_size - 1;
+	return (mgl_u64_t)coord;
+}
+
+// Filters a row, by first summing the source rows vertically and then the resulting row horizontally.
+// The scratch memory holds two rows of source texels
+static void filter_row(const mrl_mip_job_t* job, mgl_f64_t* scratch, mgl_u64_t layer, mgl_u64_t y)
+{
+	mgl_f64_t* row = scratch;
+	mgl_f64_t* sum = scratch + 4 * job->src_width;
+	for (mgl_u64_t i = 0; i < 4 * job->src_width; ++i)
+		sum[i] = 0.0;
+
+	const mgl_u8_t* src_layer = job->src + layer * job->src_height * job->src_width * job->texel_size;
+	for (mgl_u32_t t = 0; t < job->y_taps.count; ++t)
+	{
+		mgl_u64_t sy = get_tap_coord(&job->y_taps, y, t, job->src_height);
+		load_texels(&job->info, job->srgb_to_linear, src_layer + sy * job->src_width * job->texel_size, job->src_width, row);
+		for (mgl_u64_t i = 0; i < 4 * job->src_width; ++i)
+			sum[i] += job->y_taps.weights[t] * row[i];
+	}
+
+	// The source row isn't needed anymore, so the filtered texels are written over it
+	for (mgl_u64_t x = 0; x < job->dst_width; ++x)
+	{
+		mgl_f64_t v[4] = { 0.0, 0.0, 0.0, 0.0 };
+		for (mgl_u32_t t = 0; t < job->x_taps.count; ++t)
+		{
+			const mgl_f64_t* texel = sum + 4 * get_tap_coord(&job->x_taps, x, t, job->src_width);
+			for (mgl_u32_t c = 0; c < 4; ++c)
+				v[c] += job->x_taps.weights[t] * texel[c];
+		}
+		for (mgl_u32_t c = 0; c < 4; ++c)
+			row[4 * x + c] = v[c];
+	}
+
+	mgl_u8_t* dst = job->dst + (layer * job->dst_height + y) * job->dst_width * job->texel_size;
+	store_texels(&job->info, job->srgb_to_linear != NULL, row, job->dst_width, dst);
+}
+
+// Averages each 2x2 quad of 8 bit unsigned channels, rounding half up.
+// Each step reads 16 bytes from each source row and writes 8 bytes, which always hold whole texels
+static void box_filter_row_u8(const mgl_u8_t* r0, const mgl_u8_t* r1, mgl_u8_t* out, mgl_u64_t count, mgl_u32_t channel_count)
+{
+	mgl_u64_t i = 0;
+
+#if defined(MRL_BUILDER_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i two = _mm_set1_epi16(2);
+	const __m128i low_mask = _mm_set1_epi32(0xFFFF);
+	for (; i + 8 <= count; i += 8)
+	{
+		__m128i a = _mm_loadu_si128((const __m128i*)(r0 + 2 * i));
+		__m128i b = _mm_loadu_si128((const __m128i*)(r1 + 2 * i));
+		__m128i s0 = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+		__m128i s1 = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+
+		// Add the even texels to the odd texels
+		__m128i sum;
+		if (channel_count == 1)
+		{
+			__m128i sum0 = _mm_add_epi32(_mm_and_si128(s0, low_mask), _mm_srli_epi32(s0, 16));
+			__m128i sum1 = _mm_add_epi32(_mm_and_si128(s1, low_mask), _mm_srli_epi32(s1, 16));
+			sum = _mm_packs_epi32(sum0, sum1);
+		}
+		else if (channel_count == 2)
+		{
+			__m128 f0 = _mm_castsi128_ps(s0), f1 = _mm_castsi128_ps(s1);
+			__m128i even = _mm_castps_si128(_mm_shuffle_ps(f0, f1, _MM_SHUFFLE(2, 0, 2, 0)));
+			__m128i odd = _mm_castps_si128(_mm_shuffle_ps(f0, f1, _MM_SHUFFLE(3, 1, 3, 1)));
+			sum = _mm_add_epi16(even, odd);
+		}
+		else
+			sum = _mm_add_epi16(_mm_unpacklo_epi64(s0, s1), _mm_unpackhi_epi64(s0, s1));
+
+		sum = _mm_srli_epi16(_mm_add_epi16(sum, two), 2);
+		_mm_storel_epi64((__m128i*)(out + i), _mm_packus_epi16(sum, sum));
+	}
+#elif defined(MRL_BUILDER_NEON)
+	for (; i + 8 <= count; i += 8)
+	{
+		uint8x16_t a = vld1q_u8(r0 + 2 * i);
+		uint8x16_t b = vld1q_u8(r1 + 2 * i);
+		uint16x8_t s0 = vaddl_u8(vget_low_u8(a), vget_low_u8(b));
+		uint16x8_t s1 = vaddl_high_u8(a, b);
+
+		// Add the even texels to the odd texels
+		uint16x8_t sum;
+		if (channel_count == 1)
+			sum = vpaddq_u16(s0, s1);
+		else if (channel_count == 2)
+		{
+			uint32x4_t w0 = vreinterpretq_u32_u16(s0), w1 = vreinterpretq_u32_u16(s1);
+			sum = vaddq_u16(vreinterpretq_u16_u32(vuzp1q_u32(w0, w1)), vreinterpretq_u16_u32(vuzp2q_u32(w0, w1)));
+		}
+		else
+			sum = vaddq_u16(vcombine_u16(vget_low_u16(s0), vget_low_u16(s1)), vcombine_u16(vget_high_u16(s0), vget_high_u16(s1)));
+
+		vst1_u8(out + i, vrshrn_n_u16(sum, 2));
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		mgl_u32_t c = (mgl_u32_t)(i % channel_count);
+		mgl_u64_t j = 2 * (i - c) + c;
+		out[i] = (mgl_u8_t)((r0[j] + r0[j + channel_count] + r1[j] + r1[j + channel_count] + 2) >> 2);
+	}
+}
+
+// Averages each 2x2 quad of float channels, summing the rows first.
+// Each step reads 8 floats from each source row and writes 4 floats, which always hold whole texels
+static void box_filter_row_f32(const mgl_f32_t* r0, const mgl_f32_t* r1, mgl_f32_t* out, mgl_u64_t count, mgl_u32_t channel_count)
+{
+	mgl_u64_t i = 0;
+
+#if defined(MRL_BUILDER_SSE2)
+	const __m128 quarter = _mm_set1_ps(0.25f);
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 s0 = _mm_add_ps(_mm_loadu_ps(r0 + 2 * i), _mm_loadu_ps(r1 + 2 * i));
+		__m128 s1 = _mm_add_ps(_mm_loadu_ps(r0 + 2 * i + 4), _mm_loadu_ps(r1 + 2 * i + 4));
+
+		__m128 even, odd;
+		if (channel_count == 1)
+		{
+			even = _mm_shuffle_ps(s0, s1, _MM_SHUFFLE(2, 0, 2, 0));
+			odd = _mm_shuffle_ps(s0, s1, _MM_SHUFFLE(3, 1, 3, 1));
+		}
+		else if (channel_count == 2)
+		{
+			even = _mm_shuffle_ps(s0, s1, _MM_SHUFFLE(1, 0, 1, 0));
+			odd = _mm_shuffle_ps(s0, s1, _MM_SHUFFLE(3, 2, 3, 2));
+		}
+		else
+		{
+			even = s0;
+			odd = s1;
+		}
+
+		_mm_storeu_ps(out + i, _mm_mul_ps(_mm_add_ps(even, odd), quarter));
+	}
+#elif defined(MRL_BUILDER_NEON)
+	for (; i + 4 <= count; i += 4)
+	{
+		float32x4_t s0 = vaddq_f32(vld1q_f32(r0 + 2 * i), vld1q_f32(r1 + 2 * i));
+		float32x4_t s1 = vaddq_f32(vld1q_f32(r0 + 2 * i + 4), vld1q_f32(r1 + 2 * i + 4));
+
+		float32x4_t even, odd;
+		if (channel_count == 1)
+		{
+			even = vuzp1q_f32(s0, s1);
+			odd = vuzp2q_f32(s0, s1);
+		}
+		else if (channel_count == 2)
+		{
+			uint64x2_t d0 = vreinterpretq_u64_f32(s0), d1 = vreinterpretq_u64_f32(s1);
+			even = vreinterpretq_f32_u64(vuzp1q_u64(d0, d1));
+			odd = vreinterpretq_f32_u64(vuzp2q_u64(d0, d1));
+		}
+		else
+		{
+			even = s0;
+			odd = s1;
+		}
+
+		vst1q_f32(out + i, vmulq_n_f32(vaddq_f32(even, odd), 0.25f));
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		mgl_u32_t c = (mgl_u32_t)(i % channel_count);
+		mgl_u64_t j = 2 * (i - c) + c;
+		out[i] = ((r0[j] + r1[j]) + (r0[j + channel_count] + r1[j + channel_count])) * 0.25f;
+	}
+}
+
+static void filter_rows(void* arg, mgl_u32_t worker, mgl_u64_t first, mgl_u64_t last)
+{
+	const mrl_mip_job_t* job = (const mrl_mip_job_t*)arg;
+
+	for (mgl_u64_t r = first; r < last; ++r)
+	{
+		mgl_u64_t layer = r / job->dst_height;
+		mgl_u64_t y = r % job->dst_height;
+
+		if (!job->box_fast_path)
+		{
+			filter_row(job, job->scratch + (mgl_u64_t)worker * 8 * job->src_width, layer, y);
+			continue;
+		}
+
+		mgl_u64_t src_pitch = job->src_width * job->texel_size;
+		const mgl_u8_t* r0 = job->src + (layer * job->src_height + 2 * y) * src_pitch;
+		const mgl_u8_t* r1 = r0 + src_pitch;
+		mgl_u8_t* out = job->dst + (layer * job->dst_height + y) * job->dst_width * job->texel_size;
+		if (job->info.channel_type == MRL_CHANNEL_F)
+			box_filter_row_f32((const mgl_f32_t*)r0, (const mgl_f32_t*)r1, (mgl_f32_t*)out, job->dst_width * job->info.channel_count, job->info.channel_count);
+		else
+			box_filter_row_u8(r0, r1, out, job->dst_width * job->info.channel_count, job->info.channel_count);
+	}
+}
+
+// ---------- Mip chains ----------
+
+static mgl_u64_t get_level_size(mgl_u64_t size, mgl_u32_t level)
+{
+	size >>= level;
+	return size == 0 ? 1 : size;
+}
+
+MRL_API mrl_error_t mrl_build_mip_chain(const mrl_mip_chain_desc_t* desc, mrl_mip_chain_t* chain)
+{
+	MGL_DEBUG_ASSERT(desc != NULL && chain != NULL);
+
+	// Check for input errors
+	mrl_builder_format_info_t info;
+	if (desc->data == NULL || desc->width == 0 || desc->height == 0 || desc->layer_count == 0 ||
+		!get_format_info(desc->format, &info) ||
+		(desc->filter != MRL_MIP_FILTER_BOX && desc->filter != MRL_MIP_FILTER_KAISER) ||
+		(desc->srgb && (info.channel_type != MRL_CHANNEL_UN || info.channel_size != 1)))
+		return MRL_ERROR_INVALID_PARAMS;
+
+	mgl_u32_t max_mip_level_count = 1;
+	for (mgl_u64_t size = desc->width > desc->height ? desc->width : desc->height; size > 1; size >>= 1)
+		++max_mip_level_count;
+	if (max_mip_level_count > MRL_MAX_MIP_LEVEL_COUNT)
+		max_mip_level_count = MRL_MAX_MIP_LEVEL_COUNT;
+
+	mgl_u32_t mip_level_count = desc->mip_level_count == 0 ? max_mip_level_count : desc->mip_level_count;
+	if (mip_level_count > max_mip_level_count)
+		return MRL_ERROR_INVALID_PARAMS;
+
+	// Allocate every generated level at once
+	mgl_u64_t texel_size = (mgl_u64_t)info.channel_count * info.channel_size;
+	mgl_u64_t memory_size = 0;
+	for (mgl_u32_t i = 1; i < mip_level_count; ++i)
+		memory_size += get_level_size(desc->width, i) * get_level_size(desc->height, i) * desc->layer_count * texel_size;
+
+	chain->allocator = desc->allocator;
+	chain->memory = NULL;
+	chain->mip_level_count = mip_level_count;
+	for (mgl_u32_t i = 0; i < MRL_MAX_MIP_LEVEL_COUNT; ++i)
+		chain->data[i] = NULL;
+	chain->data[0] = desc->data;
+	if (memory_size == 0)
+		return MRL_ERROR_NONE;
+
+	mgl_error_t err = mgl_allocate(desc->allocator, memory_size, &chain->memory);
+	if (err != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(err);
+
+	mgl_f64_t srgb_table[256];
+	if (desc->srgb)
+		for (mgl_u32_t i = 0; i < 256; ++i)
+			srgb_table[i] = srgb_to_linear(i / 255.0);
+
+	mrl_mip_job_t job;
+	job.info = info;
+	job.texel_size = texel_size;
+	job.srgb_to_linear = desc->srgb ? srgb_table : NULL;
+
+	// Each level is filtered from the previous one
+	mgl_u8_t* level = (mgl_u8_t*)chain->memory;
+	for (mgl_u32_t i = 1; i < mip_level_count; ++i)
+	{
+		job.src = (const mgl_u8_t*)chain->data[i - 1];
+		job.dst = level;
+		job.src_width = get_level_size(desc->width, i - 1);
+		job.src_height = get_level_size(desc->height, i - 1);
+		job.dst_width = get_level_size(desc->width, i);
+		job.dst_height = get_level_size(desc->height, i);
+		get_filter_taps(desc->filter, job.src_width, &job.x_taps);
+		get_filter_taps(desc->filter, job.src_height, &job.y_taps);
+
+		// The vectorized box filter only handles levels which shrink along both axes
+		job.box_fast_path = desc->filter == MRL_MIP_FILTER_BOX && !desc->srgb &&
+			job.src_width > 1 && job.src_height > 1 &&
+			((info.channel_size == 1 && (info.channel_type == MRL_CHANNEL_UN || info.channel_type == MRL_CHANNEL_UI)) ||
+			 info.channel_type == MRL_CHANNEL_F);
+
+		mgl_u64_t row_count = job.dst_height * desc->layer_count;
+		mgl_u32_t thread_count = get_thread_count(row_count * job.dst_width, desc->max_thread_count);
+
+		// Every thread filters its rows in its own scratch memory
+		job.scratch = NULL;
+		if (!job.box_fast_path)
+		{
+			err = mgl_allocate(desc->allocator, (mgl_u64_t)thread_count * 8 * job.src_width * sizeof(mgl_f64_t), (void**)&job.scratch);
+			if (err != MGL_ERROR_NONE)
+			{
+				mgl_deallocate(desc->allocator, chain->memory);
+				chain->memory = NULL;
+				return mrl_make_mgl_error(err);
+			}
+		}
+
+		dispatch_chunks(&filter_rows, &job, row_count, thread_count);
+		if (job.scratch != NULL)
+			mgl_deallocate(desc->allocator, job.scratch);
+
+		chain->data[i] = level;
+		level += row_count * job.dst_width * texel_size;
+	}
+
+	return MRL_ERROR_NONE;
+}
+
+MRL_API void mrl_free_mip_chain(mrl_mip_chain_t* chain)
+{
+	MGL_DEBUG_ASSERT(chain != NULL);
+	if (chain->memory != NULL)
+		mgl_deallocate(chain->allocator, chain->memory);
+	chain->memory = NULL;
+}
+
+// ---------- Conversion ----------
+
+// Converts 8 bit unsigned normalized channels to floats
+static void convert_un8_to_f32(const mgl_u8_t* src, mgl_f32_t* dst, mgl_u64_t count)
+{
+	mgl_u64_t i = 0;
+
+#if defined(MRL_BUILDER_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128 max = _mm_set1_ps(255.0f);
+	for (; i + 16 <= count; i += 16)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+		__m128i lo = _mm_unpacklo_epi8(v, zero);
+		__m128i hi = _mm_unpackhi_epi8(v, zero);
+		_mm_storeu_ps(dst + i, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), max));
+		_mm_storeu_ps(dst + i + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), max));
+		_mm_storeu_ps(dst + i + 8, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), max));
+		_mm_storeu_ps(dst + i + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), max));
+	}
+#elif defined(MRL_BUILDER_NEON)
+	const float32x4_t max = vdupq_n_f32(255.0f);
+	for (; i + 16 <= count; i += 16)
+	{
+		uint8x16_t v = vld1q_u8(src + i);
+		uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+		uint16x8_t hi = vmovl_high_u8(v);
+		vst1q_f32(dst + i, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo))), max));
+		vst1q_f32(dst + i + 4, vdivq_f32(vcvtq_f32_u32(vmovl_high_u16(lo)), max));
+		vst1q_f32(dst + i + 8, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi))), max));
+		vst1q_f32(dst + i + 12, vdivq_f32(vcvtq_f32_u32(vmovl_high_u16(hi)), max));
+	}
+#endif
+
+	for (; i < count; ++i)
+		dst[i] = (mgl_f32_t)src[i] / 255.0f;
+}
+
+// Converts floats to 8 bit unsigned normalized channels, clamping them to [0, 1] and rounding half up
+static void convert_f32_to_un8(const mgl_f32_t* src, mgl_u8_t* dst, mgl_u64_t count)
+{
+	mgl_u64_t i = 0;
+
+#if defined(MRL_BUILDER_SSE2)
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 max = _mm_set1_ps(255.0f);
+	const __m128 half = _mm_set1_ps(0.5f);
+	for (; i + 16 <= count; i += 16)
+	{
+		// The value is the first operand of max, so that NaNs become 0
+		__m128i v[4];
+		for (mgl_u32_t j = 0; j < 4; ++j)
+		{
+			__m128 f = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + 4 * j), zero), one);
+			v[j] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(f, max), half));
+		}
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(_mm_packs_epi32(v[0], v[1]), _mm_packs_epi32(v[2], v[3])));
+	}
+#elif defined(MRL_BUILDER_NEON)
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+	const float32x4_t one = vdupq_n_f32(1.0f);
+	const float32x4_t half = vdupq_n_f32(0.5f);
+	for (; i + 16 <= count; i += 16)
+	{
+		// vmaxnm returns the number when the other operand is a NaN
+		uint32x4_t v[4];
+		for (mgl_u32_t j = 0; j < 4; ++j)
+		{
+			float32x4_t f = vminq_f32(vmaxnmq_f32(vld1q_f32(src + i + 4 * j), zero), one);
+			v[j] = vcvtq_u32_f32(vaddq_f32(vmulq_n_f32(f, 255.0f), half));
+		}
+		uint16x8_t lo = vcombine_u16(vmovn_u32(v[0]), vmovn_u32(v[1]));
+		uint16x8_t hi = vcombine_u16(vmovn_u32(v[2]), vmovn_u32(v[3]));
+		vst1q_u8(dst + i, vcombine_u8(vmovn_u16(lo), vmovn_u16(hi)));
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		mgl_f32_t f = src[i];
+		if (!(f > 0.0f))
+			f = 0.0f;
+		else if (f > 1.0f)
+			f = 1.0f;
+		dst[i] = (mgl_u8_t)(f * 255.0f + 0.5f);
+	}
+}
+
+static void convert_texels(void* arg, mgl_u32_t worker, mgl_u64_t first, mgl_u64_t last)
+{
+	const mrl_convert_job_t* job = (const mrl_convert_job_t*)arg;
+	mgl_u64_t src_texel_size = (mgl_u64_t)job->src_info.channel_count * job->src_info.channel_size;
+	mgl_u64_t dst_texel_size = (mgl_u64_t)job->dst_info.channel_count * job->dst_info.channel_size;
+	const mgl_u8_t* src = job->src + first * src_texel_size;
+	mgl_u8_t* dst = job->dst + first * dst_texel_size;
+
+	// Conversions between 8 bit normalized and float formats with the same channels are vectorized
+	if (job->src_info.channel_count == job->dst_info.channel_count)
+	{
+		mgl_u64_t count = (last - first) * job->src_info.channel_count;
+		if (job->src_info.channel_type == MRL_CHANNEL_UN && job->src_info.channel_size == 1 && job->dst_info.channel_type == MRL_CHANNEL_F)
+		{
+			convert_un8_to_f32(src, (mgl_f32_t*)dst, count);
+			return;
+		}
+		else if (job->src_info.channel_type == MRL_CHANNEL_F && job->dst_info.channel_type == MRL_CHANNEL_UN && job->dst_info.channel_size == 1)
+		{
+			convert_f32_to_un8((const mgl_f32_t*)src, dst, count);
+			return;
+		}
+	}
+
+	mgl_f64_t texels[4 * MRL_CONVERT_BATCH_SIZE];
+	for (mgl_u64_t i = first; i < last; i += MRL_CONVERT_BATCH_SIZE)
+	{
+		mgl_u64_t count = last - i < MRL_CONVERT_BATCH_SIZE ? last - i : MRL_CONVERT_BATCH_SIZE;
+		load_texels(&job->src_info, NULL, src, count, texels);
+		store_texels(&job->dst_info, MGL_FALSE, texels, count, dst);
+		src += count * src_texel_size;
+		dst += count * dst_texel_size;
+	}
+}
+
+MRL_API mrl_error_t mrl_convert_texels(mgl_enum_t src_format, const void* src, mgl_enum_t dst_format, void* dst, mgl_u64_t texel_count)
+{
+	MGL_DEBUG_ASSERT(src != NULL && dst != NULL);
+
+	mrl_convert_job_t job;
+	if (!get_format_info(src_format, &job.src_info) || !get_format_info(dst_format, &job.dst_info))
+		return MRL_ERROR_INVALID_PARAMS;
+
+	job.src = (const mgl_u8_t*)src;
+	job.dst = (mgl_u8_t*)dst;
+	dispatch_chunks(&convert_texels, &job, texel_count, get_thread_count(texel_count, 0));
+	return MRL_ERROR_NONE;
+}
@@ -0,0 +1,1099 @@
+#include <mrl/texture_decoder.h>
+#include <mrl/thread.h>
+
+#include <mgl/memory/manipulation.h>
+
+// Minimum number of blocks decoded by each thread, so that small images don't pay for starting threads
+#define MRL_DECODE_BLOCKS_PER_THREAD 4096
+#define MRL_DECODE_CHUNKS_PER_THREAD 4
+
+typedef struct
+{
+	mgl_enum_t format;
+	mgl_u64_t width, height;
+	mgl_u64_t block_size, texel_size;
+	mgl_u64_t blocks_per_row, block_row_count;
+	const mgl_u8_t* data;
+	mgl_u8_t* out;
+	mgl_u64_t out_row_pitch;
+	mgl_u32_t rows_per_chunk, chunk_count;
+	mrl_atomic_u32_t next_chunk;
+} mrl_decode_job_t;
+
+// ---------- Formats ----------
+
+mgl_bool_t mrl_is_compressed_format(mgl_enum_t format)
+{
+	return format >= MRL_TEXTURE_FORMAT_BC1_UN && format <= MRL_TEXTURE_FORMAT_ETC2_RGBA8_UN;
+}
+
+static mgl_u64_t get_block_size(mgl_enum_t format)
+{
+	switch (format)
+	{
+		case MRL_TEXTURE_FORMAT_BC1_UN:
+		case MRL_TEXTURE_FORMAT_BC4_UN:
+		case MRL_TEXTURE_FORMAT_BC4_SN:
+		case MRL_TEXTURE_FORMAT_ETC2_RGB8_UN:
+		case MRL_TEXTURE_FORMAT_ETC2_RGB8A1_UN:
+			return 8;
+
+		default:
+			return 16;
+	}
+}
+
+mgl_u64_t mrl_get_compressed_data_size(mgl_enum_t format, mgl_u64_t width, mgl_u64_t height, mgl_u64_t depth)
+{
+	return ((width + 3) / 4) * ((height + 3) / 4) * depth * get_block_size(format);
+}
+
+mgl_enum_t mrl_get_decoded_format(mgl_enum_t format)
+{
+	switch (format)
+	{
+		case MRL_TEXTURE_FORMAT_BC4_UN: return MRL_TEXTURE_FORMAT_R8_UN;
+		case MRL_TEXTURE_FORMAT_BC4_SN: return MRL_TEXTURE_FORMAT_R8_SN;
+		case MRL_TEXTURE_FORMAT_BC5_UN: return MRL_TEXTURE_FORMAT_RG8_UN;
+		case MRL_TEXTURE_FORMAT_BC5_SN: return MRL_TEXTURE_FORMAT_RG8_SN;
+		case MRL_TEXTURE_FORMAT_BC6H_UF:
+		case MRL_TEXTURE_FORMAT_BC6H_SF: return MRL_TEXTURE_FORMAT_RGBA32_F;
+		default: return MRL_TEXTURE_FORMAT_RGBA8_UN;
+	}
+}
+
+mgl_u64_t mrl_get_decoded_texel_size(mgl_enum_t format)
+{
+	switch (mrl_get_decoded_format(format))
+	{
+		case MRL_TEXTURE_FORMAT_R8_UN:
+		case MRL_TEXTURE_FORMAT_R8_SN: return 1;
+		case MRL_TEXTURE_FORMAT_RG8_UN:
+		case MRL_TEXTURE_FORMAT_RG8_SN: return 2;
+		case MRL_TEXTURE_FORMAT_RGBA32_F: return 16;
+		default: return 4;
+	}
+}
+
+// ---------- Utilities ----------
+
+static mgl_u8_t clamp_u8(mgl_i32_t v)
+{
+	return (mgl_u8_t)(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+static mgl_u64_t read_u64_le(const mgl_u8_t* data)
+{
+	mgl_u64_t v = 0;
+	for (mgl_u32_t i = 0; i < 8; ++i)
+		v |= (mgl_u64_t)data[i] << (8 * i);
+	return v;
+}
+
+static mgl_u64_t read_u64_be(const mgl_u8_t* data)
+{
+	mgl_u64_t v = 0;
+	for (mgl_u32_t i = 0; i < 8; ++i)
+		v = (v << 8) | data[i];
+	return v;
+}
+
+// Reads bits from a 128-bit block, starting from the least significant bit of the first byte
+typedef struct
+{
+	const mgl_u8_t* data;
+	mgl_u32_t offset;
+} mrl_bit_reader_t;
+
+static mgl_u32_t read_bits(mrl_bit_reader_t* reader, mgl_u32_t count)
+{
+	mgl_u32_t v = 0;
+	for (mgl_u32_t i = 0; i < count; ++i, ++reader->offset)
+		v |= (mgl_u32_t)((reader->data[reader->offset >> 3] >> (reader->offset & 7)) & 1) << i;
+	return v;
+}
+
+static mgl_f32_t half_to_float(mgl_u16_t h)
+{
+	mgl_u32_t sign = (mgl_u32_t)(h & 0x8000) << 16;
+	mgl_u32_t exponent = (h >> 10) & 0x1F;
+	mgl_u32_t mantissa = h & 0x3FF;
+	mgl_u32_t bits;
+
+	if (exponent == 0x1F)
+		bits = sign | 0x7F800000 | (mantissa << 13);
+	else if (exponent != 0)
+		bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+	else if (mantissa == 0)
+		bits = sign;
+	else
+	{
+		// Normalize subnormal values
+		exponent = 113;
+		while ((mantissa & 0x400) == 0)
+		{
+			mantissa <<= 1;
+			--exponent;
+		}
+		bits = sign | (exponent << 23) | ((mantissa & 0x3FF) << 13);
+	}
+
+	mgl_f32_t f;
+	mgl_mem_copy(&f, &bits, sizeof(f));
+	return f;
+}
+
+// ---------- BC1 - BC5 ----------
+
+// Decodes the color part of BC1, BC2 and BC3 blocks. BC2 and BC3 colors are always in 4 color mode
+static void decode_bc1_colors(const mgl_u8_t* block, mgl_bool_t allow_alpha, mgl_u8_t* out)
+{
+	mgl_u32_t c0 = block[0] | ((mgl_u32_t)block[1] << 8);
+	mgl_u32_t c1 = block[2] | ((mgl_u32_t)block[3] << 8);
+
+	// Expand the RGB565 endpoints
+	mgl_u8_t colors[4][4];
+	const mgl_u32_t endpoints[2] = { c0, c1 };
+	for (mgl_u32_t i = 0; i < 2; ++i)
+	{
+		mgl_u32_t r = (endpoints[i] >> 11) & 0x1F, g = (endpoints[i] >> 5) & 0x3F, b = endpoints[i] & 0x1F;
+		colors[i][0] = (mgl_u8_t)((r << 3) | (r >> 2));
+		colors[i][1] = (mgl_u8_t)((g << 2) | (g >> 4));
+		colors[i][2] = (mgl_u8_t)((b << 3) | (b >> 2));
+		colors[i][3] = 255;
+	}
+
+	for (mgl_u32_t c = 0; c < 3; ++c)
+		if (c0 > c1 || !allow_alpha)
+		{
+			colors[2][c] = (mgl_u8_t)((2 * colors[0][c] + colors[1][c] + 1) / 3);
+			colors[3][c] = (mgl_u8_t)((colors[0][c] + 2 * colors[1][c] + 1) / 3);
+		}
+		else
+		{
+			colors[2][c] = (mgl_u8_t)((colors[0][c] + colors[1][c] + 1) / 2);
+			colors[3][c] = 0;
+		}
+	colors[2][3] = 255;
+	colors[3][3] = (c0 > c1 || !allow_alpha) ? 255 : 0;
+
+	mgl_u32_t indices = block[4] | ((mgl_u32_t)block[5] << 8) | ((mgl_u32_t)block[6] << 16) | ((mgl_u32_t)block[7] << 24);
+	for (mgl_u32_t i = 0; i < 16; ++i)
+		mgl_mem_copy(out + i * 4, colors[(indices >> (2 * i)) & 3], 4);
+}
+
+// Decodes a BC4 block, which is also the alpha part of BC3 blocks, to one component with the given stride
+static void decode_bc4_component(const mgl_u8_t* block, mgl_bool_t is_signed, mgl_u8_t* out, mgl_u32_t stride)
+{
+	mgl_i32_t values[8];
+	if (is_signed)
+	{
+		values[0] = (mgl_i8_t)block[0] < -127 ? -127 : (mgl_i8_t)block[0];
+		values[1] = (mgl_i8_t)block[1] < -127 ? -127 : (mgl_i8_t)block[1];
+	}
+	else
+	{
+		values[0] = block[0];
+		values[1] = block[1];
+	}
+
+	if (values[0] > values[1])
+		for (mgl_i32_t i = 1; i < 7; ++i)
+		{
+			mgl_i32_t v = (7 - i) * values[0] + i * values[1];
+			values[i + 1] = v >= 0 ? (v + 3) / 7 : -((3 - v) / 7);
+		}
+	else
+	{
+		for (mgl_i32_t i = 1; i < 5; ++i)
+		{
+			mgl_i32_t v = (5 - i) * values[0] + i * values[1];
+			values[i + 1] = v >= 0 ? (v + 2) / 5 : -((2 - v) / 5);
+		}
+		values[6] = is_signed ? -127 : 0;
+		values[7] = is_signed ? 127 : 255;
+	}
+
+	// 16 indices of 3 bits each
+	mgl_u64_t indices = 0;
+	for (mgl_u32_t i = 0; i < 6; ++i)
+		indices |= (mgl_u64_t)block[2 + i] << (8 * i);
+	for (mgl_u32_t i = 0; i < 16; ++i)
+		out[i * stride] = (mgl_u8_t)values[(indices >> (3 * i)) & 7];
+}
+
+static void decode_bc1(const mgl_u8_t* block, void* out)
+{
+	decode_bc1_colors(block, MGL_TRUE, (mgl_u8_t*)out);
+}
+
+static void decode_bc2(const mgl_u8_t* block, void* out)
+{
+	mgl_u8_t* texels = (mgl_u8_t*)out;
+	decode_bc1_colors(block + 8, MGL_FALSE, texels);
+
+	mgl_u64_t alpha = read_u64_le(block);
+	for (mgl_u32_t i = 0; i < 16; ++i)
+		texels[i * 4 + 3] = (mgl_u8_t)(((alpha >> (4 * i)) & 0xF) * 17);
+}
+
+static void decode_bc3(const mgl_u8_t* block, void* out)
+{
+	mgl_u8_t* texels = (mgl_u8_t*)out;
+	decode_bc1_colors(block + 8, MGL_FALSE, texels);
+	decode_bc4_component(block, MGL_FALSE, texels + 3, 4);
+}
+
+static void decode_bc4_un(const mgl_u8_t* block, void* out)
+{
+	decode_bc4_component(block, MGL_FALSE, (mgl_u8_t*)out, 1);
+}
+
+static void decode_bc4_sn(const mgl_u8_t* block, void* out)
+{
+	decode_bc4_component(block, MGL_TRUE, (mgl_u8_t*)out, 1);
+}
+
+static void decode_bc5_un(const mgl_u8_t* block, void* out)
+{
+	decode_bc4_component(block, MGL_FALSE, (mgl_u8_t*)out, 2);
+	decode_bc4_component(block + 8, MGL_FALSE, (mgl_u8_t*)out + 1, 2);
+}
+
+static void decode_bc5_sn(const mgl_u8_t* block, void* out)
+{
+	decode_bc4_component(block, MGL_TRUE, (mgl_u8_t*)out, 2);
+	decode_bc4_component(block + 8, MGL_TRUE, (mgl_u8_t*)out + 1, 2);
+}
+
+// ---------- BC6H and BC7 ----------
+
+// Subset 1 bit masks of the 2 subset partitions, indexed by texel
+static const mgl_u16_t bptc_partitions_2[64] = {
+	0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80,
+	0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+	0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE,
+	0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+	0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+	0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+	0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C,
+	0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+};
+
+// Subsets of the 3 subset partitions, 2 bits per texel
+static const mgl_u32_t bptc_partitions_3[64] = {
+	0xAA685050, 0x6A5A5040, 0x5A5A4200, 0x5450A0A8, 0xA5A50000, 0xA0A05050, 0x5555A0A0, 0x5A5A5050,
+	0xAA550000, 0xAA555500, 0xAAAA5500, 0x90909090, 0x94949494, 0xA4A4A4A4, 0xA9A59450, 0x2A0A4250,
+	0xA5945040, 0x0A425054, 0xA5A5A500, 0x55A0A0A0, 0xA8A85454, 0x6A6A4040, 0xA4A45000, 0x1A1A0500,
+	0x0050A4A4, 0xAAA59090, 0x14696914, 0x69691400, 0xA08585A0, 0xAA821414, 0x50A4A450, 0x6A5A0200,
+	0xA9A58000, 0x5090A0A8, 0xA8A09050, 0x24242424, 0x00AA5500, 0x24924924, 0x24499224, 0x50A50A50,
+	0x500AA550, 0xAAAA4444, 0x66660000, 0xA5A0A5A0, 0x50A050A0, 0x69286928, 0x44AAAA44, 0x66666600,
+	0xAA444444, 0x54A854A8, 0x95809580, 0x96969600, 0xA85454A8, 0x80959580, 0xAA141414, 0x96960000,
+	0xAAAA1414, 0xA05050A0, 0xA0A5A5A0, 0x96000000, 0x40804080, 0xA9A8A9A8, 0xAAAAAA44, 0x2A4A5254,
+};
+
+// Anchor texel of subset 1 of the 2 subset partitions
+static const mgl_u8_t bptc_anchors_2[64] = {
+	15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+	15, 2, 8, 2, 2, 8, 8, 15, 2, 8, 2, 2, 8, 8, 2, 2,
+	15, 15, 6, 8, 2, 8, 15, 15, 2, 8, 2, 2, 2, 15, 15, 6,
+	6, 2, 6, 8, 15, 15, 2, 2, 15, 15, 15, 15, 15, 2, 2, 15,
+};
+
+// Anchor texels of subsets 1 and 2 of the 3 subset partitions
+static const mgl_u8_t bptc_anchors_3[2][64] = {
+	{
+		3, 3, 15, 15, 8, 3, 15, 15, 8, 8, 6, 6, 6, 5, 3, 3,
+		3, 3, 8, 15, 3, 3, 6, 10, 5, 8, 8, 6, 8, 5, 15, 15,
+		8, 15, 3, 5, 6, 10, 8, 15, 15, 3, 15, 5, 15, 15, 15, 15,
+		3, 15, 5, 5, 5, 8, 5, 10, 5, 10, 8, 13, 15, 12, 3, 3,
+	},
+	{
+		15, 8, 8, 3, 15, 15, 3, 8, 15, 15, 15, 15, 15, 15, 15, 8,
+		15, 8, 15, 3, 15, 8, 15, 8, 3, 15, 6, 10, 15, 15, 10, 8,
+		15, 3, 15, 10, 10, 8, 9, 10, 6, 15, 8, 15, 3, 6, 6, 8,
+		15, 3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 3, 15, 15, 8,
+	},
+};
+
+static const mgl_u32_t bptc_weights_2[4] = { 0, 21, 43, 64 };
+static const mgl_u32_t bptc_weights_3[8] = { 0, 9, 18, 27, 37, 46, 55, 64 };
+static const mgl_u32_t bptc_weights_4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+static mgl_u32_t get_bptc_subset(mgl_u32_t subset_count, mgl_u32_t partition, mgl_u32_t texel)
+{
+	if (subset_count == 1)
+		return 0;
+	else if (subset_count == 2)
+		return (bptc_partitions_2[partition] >> texel) & 1;
+	else
+		return (bptc_partitions_3[partition] >> (2 * texel)) & 3;
+}
+
+static mgl_bool_t is_bptc_anchor(mgl_u32_t subset_count, mgl_u32_t partition, mgl_u32_t texel)
+{
+	if (texel == 0)
+		return MGL_TRUE;
+	else if (subset_count == 2)
+		return texel == bptc_anchors_2[partition];
+	else if (subset_count == 3)
+		return texel == bptc_anchors_3[0][partition] || texel == bptc_anchors_3[1][partition];
+	return MGL_FALSE;
+}
+
+static const mgl_u32_t* get_bptc_weights(mgl_u32_t index_bits)
+{
+	return index_bits == 2 ? bptc_weights_2 : (index_bits == 3 ? bptc_weights_3 : bptc_weights_4);
+}
+
+// Reads the indices of every texel, anchor texels have their most significant bit implied as 0
+static void read_bptc_indices(mrl_bit_reader_t* reader, mgl_u32_t subset_count, mgl_u32_t partition, mgl_u32_t index_bits, mgl_u8_t* indices)
+{
+	for (mgl_u32_t i = 0; i < 16; ++i)
+		indices[i] = (mgl_u8_t)read_bits(reader, is_bptc_anchor(subset_count, partition, i) ? index_bits - 1 : index_bits);
+}
+
+typedef struct
+{
+	mgl_u8_t subset_count, partition_bits, rotation_bits, index_selection_bits;
+	mgl_u8_t color_bits, alpha_bits, endpoint_p_bits, shared_p_bits;
+	mgl_u8_t index_bits, secondary_index_bits;
+} mrl_bc7_mode_t;
+
+static const mrl_bc7_mode_t bc7_modes[8] = {
+	{ 3, 4, 0, 0, 4, 0, 1, 0, 3, 0 },
+	{ 2, 6, 0, 0, 6, 0, 0, 1, 3, 0 },
+	{ 3, 6, 0, 0, 5, 0, 0, 0, 2, 0 },
+	{ 2, 6, 0, 0, 7, 0, 1, 0, 2, 0 },
+	{ 1, 0, 2, 1, 5, 6, 0, 0, 2, 3 },
+	{ 1, 0, 2, 0, 7, 8, 0, 0, 2, 2 },
+	{ 1, 0, 0, 0, 7, 7, 1, 0, 4, 0 },
+	{ 2, 6, 0, 0, 5, 5, 1, 0, 2, 0 },
+};
+
+static void decode_bc7(const mgl_u8_t* block, void* out)
+{
+	mgl_u8_t* texels = (mgl_u8_t*)out;
+	mrl_bit_reader_t reader = { block, 0 };
+
+	// The mode is the number of zeros before the first set bit, blocks without set bits are invalid
+	mgl_u32_t mode = 0;
+	while (mode < 8 && read_bits(&reader, 1) == 0)
+		++mode;
+	if (mode == 8)
+	{
+		mgl_mem_set(texels, 64, 0);
+		return;
+	}
+
+	const mrl_bc7_mode_t* m = &bc7_modes[mode];
+	mgl_u32_t partition = read_bits(&reader, m->partition_bits);
+	mgl_u32_t rotation = read_bits(&reader, m->rotation_bits);
+	mgl_u32_t index_selection = read_bits(&reader, m->index_selection_bits);
+
+	// Endpoints are stored component by component
+	mgl_u32_t endpoints[6][4];
+	mgl_u32_t endpoint_count = m->subset_count * 2;
+	for (mgl_u32_t c = 0; c < 3; ++c)
+		for (mgl_u32_t e = 0; e < endpoint_count; ++e)
+			endpoints[e][c] = read_bits(&reader, m->color_bits);
+	for (mgl_u32_t e = 0; e < endpoint_count; ++e)
+		endpoints[e][3] = m->alpha_bits > 0 ? read_bits(&reader, m->alpha_bits) : 255;
+
+	// P-bits are appended as the least significant bit of every component
+	mgl_u32_t color_bits = m->color_bits, alpha_bits = m->alpha_bits;
+	if (m->endpoint_p_bits || m->shared_p_bits)
+	{
+		mgl_u32_t p_bits[6];
+		if (m->endpoint_p_bits)
+			for (mgl_u32_t e = 0; e < endpoint_count; ++e)
+				p_bits[e] = read_bits(&reader, 1);
+		else
+			for (mgl_u32_t s = 0; s < m->subset_count; ++s)
+				p_bits[2 * s] = p_bits[2 * s + 1] = read_bits(&reader, 1);
+
+		for (mgl_u32_t e = 0; e < endpoint_count; ++e)
+			for (mgl_u32_t c = 0; c < 4; ++c)
+				if (c < 3 || alpha_bits > 0)
+					endpoints[e][c] = (endpoints[e][c] << 1) | p_bits[e];
+		color_bits += 1;
+		if (alpha_bits > 0)
+			alpha_bits += 1;
+	}
+
+	// Expand the endpoints to 8 bits by replicating their most significant bits
+	for (mgl_u32_t e = 0; e < endpoint_count; ++e)
+		for (mgl_u32_t c = 0; c < 4; ++c)
+		{
+			mgl_u32_t bits = c < 3 ? color_bits : alpha_bits;
+			if (bits > 0 && bits < 8)
+				endpoints[e][c] = ((endpoints[e][c] << (8 - bits)) | (endpoints[e][c] >> (2 * bits - 8))) & 0xFF;
+		}
+
+	mgl_u8_t indices[16], secondary_indices[16];
+	read_bptc_indices(&reader, m->subset_count, partition, m->index_bits, indices);
+	if (m->secondary_index_bits > 0)
+		read_bptc_indices(&reader, 1, 0, m->secondary_index_bits, secondary_indices);
+
+	for (mgl_u32_t i = 0; i < 16; ++i)
+	{
+		mgl_u32_t subset = get_bptc_subset(m->subset_count, partition, i);
+		const mgl_u32_t* e0 = endpoints[2 * subset];
+		const mgl_u32_t* e1 = endpoints[2 * subset + 1];
+
+		// Modes with secondary indices interpolate color and alpha separately, the index selection bit swaps them
+		mgl_u32_t color_weight, alpha_weight;
+		if (m->secondary_index_bits == 0)
+			color_weight = alpha_weight = get_bptc_weights(m->index_bits)[indices[i]];
+		else if (index_selection == 0)
+		{
+			color_weight = get_bptc_weights(m->index_bits)[indices[i]];
+			alpha_weight = get_bptc_weights(m->secondary_index_bits)[secondary_indices[i]];
+		}
+		else
+		{
+			color_weight = get_bptc_weights(m->secondary_index_bits)[secondary_indices[i]];
+			alpha_weight = get_bptc_weights(m->index_bits)[indices[i]];
+		}
+
+		mgl_u8_t* texel = texels + i * 4;
+		for (mgl_u32_t c = 0; c < 3; ++c)
+			texel[c] = (mgl_u8_t)(((64 - color_weight) * e0[c] + color_weight * e1[c] + 32) >> 6);
+		texel[3] = (mgl_u8_t)(((64 - alpha_weight) * e0[3] + alpha_weight * e1[3] + 32) >> 6);
+
+		// Rotation swaps alpha with one of the color components
+		if (rotation > 0)
+		{
+			mgl_u8_t tmp = texel[3];
+			texel[3] = texel[rotation - 1];
+			texel[rotation - 1] = tmp;
+		}
+	}
+}
+
+// Describes where the bits of each BC6H endpoint component are stored.
+// Each field is a component (0 - 11, as endpoint * 3 + channel), its first bit, bit count, and if its bits are stored reversed.
+typedef struct
+{
+	mgl_u8_t component, first_bit, bit_count, reversed;
+} mrl_bc6h_field_t;
+
+typedef struct
+{
+	mgl_u8_t subset_count, transformed;
+	mgl_u8_t endpoint_bits, delta_bits[3];
+	mgl_u8_t field_count;
+	mrl_bc6h_field_t fields[24];
+} mrl_bc6h_mode_t;
+
+#define MRL_BC6H_R(e) ((e) * 3 + 0)
+#define MRL_BC6H_G(e) ((e) * 3 + 1)
+#define MRL_BC6H_B(e) ((e) * 3 + 2)
+
+// Modes 1 to 14, by the order of the BC6H specification
+static const mrl_bc6h_mode_t bc6h_modes[14] = {
+	{ 2, 1, 10, { 5, 5, 5 }, 19, {
+		{ MRL_BC6H_G(2), 4, 1, 0 }, { MRL_BC6H_B(2), 4, 1, 0 }, { MRL_BC6H_B(3), 4, 1, 0 },
+		{ MRL_BC6H_R(0), 0, 10, 0 }, { MRL_BC6H_G(0), 0, 10, 0 }, { MRL_BC6H_B(0), 0, 10, 0 },
+		{ MRL_BC6H_R(1), 0, 5, 0 }, { MRL_BC6H_G(3), 4, 1, 0 }, { MRL_BC6H_G(2), 0, 4, 0 },
+		{ MRL_BC6H_G(1), 0, 5, 0 }, { MRL_BC6H_B(3), 0, 1, 0 }, { MRL_BC6H_G(3), 0, 4, 0 },
+		{ MRL_BC6H_B(1), 0, 5, 0 }, { MRL_BC6H_B(3), 1, 1, 0 }, { MRL_BC6H_B(2), 0, 4, 0 },
+		{ MRL_BC6H_R(2), 0, 5, 0 }, { MRL_BC6H_B(3), 2, 1, 0 }, { MRL_BC6H_R(3), 0, 5, 0 },
+		{ MRL_BC6H_B(3), 3, 1, 0 },
+	} },
+	{ 2, 1, 7, { 6, 6, 6 }, 23, {
+		{ MRL_BC6H_G(2), 5, 1, 0 }, { MRL_BC6H_G(3), 4, 1, 0 }, { MRL_BC6H_G(3), 5, 1, 0 },
+		{ MRL_BC6H_R(0), 0, 7, 0 }, { MRL_BC6H_B(3), 0, 1, 0 }, { MRL_BC6H_B(3), 1, 1, 0 },
+		{ MRL_BC6H_B(2), 4, 1, 0 }, { MRL_BC6H_G(0), 0, 7, 0 }, { MRL_BC6H_B(2), 5, 1, 0 },
+		{ MRL_BC6H_B(3), 2, 1, 0 }, { MRL_BC6H_G(2), 4, 1, 0 }, { MRL_BC6H_B(0), 0, 7, 0 },
+		{ MRL_BC6H_B(3), 3, 1, 0 }, { MRL_BC6H_B(3), 5, 1, 0 }, { MRL_BC6H_B(3), 4, 1, 0 },
+		{ MRL_BC6H_R(1), 0, 6, 0 }, { MRL_BC6H_G(2), 0, 4, 0 }, { MRL_BC6H_G(1), 0, 6, 0 },
+		{ MRL_BC6H_G(3), 0, 4, 0 }, { MRL_BC6H_B(1), 0, 6, 0 }, { MRL_BC6H_B(2), 0, 4, 0 },
+		{ MRL_BC6H_R(2), 0, 6, 0 }, { MRL_BC6H_R(3), 0, 6, 0 },
+	} },
+	{ 2, 1, 11, { 5, 4, 4 }, 18, {
+		{ MRL_BC6H_R(0), 0, 10, 0 }, { MRL_BC6H_G(0), 0, 10, 0 }, { MRL_BC6H_B(0), 0, 10, 0 },
+		{ MRL_BC6H_R(1), 0, 5, 0 }, { MRL_BC6H_R(0), 10, 1, 0 }, { MRL_BC6H_G(2), 0, 4, 0 },
+		{ MRL_BC6H_G(1), 0, 4, 0 }, { MRL_BC6H_G(0), 10, 1, 0 }, { MRL_BC6H_B(3), 0, 1, 0 },
+		{ MRL_BC6H_G(3), 0, 4, 0 }, { MRL_BC6H_B(1), 0, 4, 0 }, { MRL_BC6H_B(0), 10, 1, 0 },
+		{ MRL_BC6H_B(3), 1, 1, 0 }, { MRL_BC6H_B(2), 0, 4, 0 }, { MRL_BC6H_R(2), 0, 5, 0 },
+		{ MRL_BC6H_B(3), 2, 1, 0 }, { MRL_BC6H_R(3), 0, 5, 0 }, { MRL_BC6H_B(3), 3, 1, 0 },
+	} },
+	{ 2, 1, 11, { 4, 5, 4 }, 20, {
+		{ MRL_BC6H_R(0), 0, 10, 0 }, { MRL_BC6H_G(0), 0, 10, 0 }, { MRL_BC6H_B(0), 0, 10, 0 },
+		{ MRL_BC6H_R(1), 0, 4, 0 }, { MRL_BC6H_R(0), 10, 1, 0 }, { MRL_BC6H_G(3), 4, 1, 0 },
+		{ MRL_BC6H_G(2), 0, 4, 0 }, { MRL_BC6H_G(1), 0, 5, 0 }, { MRL_BC6H_G(0), 10, 1, 0 },
+		{ MRL_BC6H_G(3), 0, 4, 0 }, { MRL_BC6H_B(1), 0, 4, 0 }, { MRL_BC6H_B(0), 10, 1, 0 },
+		{ MRL_BC6H_B(3), 1, 1, 0 }, { MRL_BC6H_B(2), 0, 4, 0 }, { MRL_BC6H_R(2), 0, 4, 0 },
+		{ MRL_BC6H_B(3), 0, 1, 0 }, { MRL_BC6H_B(3), 2, 1, 0 }, { MRL_BC6H_R(3), 0, 4, 0 },
+		{ MRL_BC6H_G(2), 4, 1, 0 }, { MRL_BC6H_B(3), 3, 1, 0 },
+	} },
+	{ 2, 1, 11, { 4, 4, 5 }, 20, {
+		{ MRL_BC6H_R(0), 0, 10, 0 }, { MRL_BC6H_G(0), 0, 10, 0 }, { MRL_BC6H_B(0), 0, 10, 0 },
+		{ MRL_BC6H_R(1), 0, 4, 0 }, { MRL_BC6H_R(0), 10, 1, 0 }, { MRL_BC6H_B(2), 4, 1, 0 },
+		{ MRL_BC6H_G(2), 0, 4, 0 }, { MRL_BC6H_G(1), 0, 4, 0 }, { MRL_BC6H_G(0), 10, 1, 0 },
+		{ MRL_BC6H_B(3), 0, 1, 0 }, { MRL_BC6H_G(3), 0, 4, 0 }, { MRL_BC6H_B(1), 0, 5, 0 },
+		{ MRL_BC6H_B(0), 10, 1, 0 }, { MRL_BC6H_B(2), 0, 4, 0 }, { MRL_BC6H_R(2), 0, 4, 0 },
+		{ MRL_BC6H_B(3), 1, 1, 0 }, { MRL_BC6H_B(3), 2, 1, 0 }, { MRL_BC6H_R(3), 0, 4, 0 },
+		{ MRL_BC6H_B(3), 4, 1, 0 }, { MRL_BC6H_B(3), 3, 1, 0 },
+	} },
+	{ 2, 1, 9, { 5, 5, 5 }, 19, {
+		{ MRL_BC6H_R(0), 0, 9, 0 }, { MRL_BC6H_B(2), 4, 1, 0 }, { MRL_BC6H_G(0), 0, 9, 0 },
+		{ MRL_BC6H_G(2), 4, 1, 0 }, { MRL_BC6H_B(0), 0, 9, 0 }, { MRL_BC6H_B(3), 4, 1, 0 },
+		{ MRL_BC6H_R(1), 0, 5, 0 }, { MRL_BC6H_G(3), 4, 1, 0 }, { MRL_BC6H_G(2), 0, 4, 0 },
+		{ MRL_BC6H_G(1), 0, 5, 0 }, { MRL_BC6H_B(3), 0, 1, 0 }, { MRL_BC6H_G(3), 0, 4, 0 },
+		{ MRL_BC6H_B(1), 0, 5, 0 }, { MRL_BC6H_B(3), 1, 1, 0 }, { MRL_BC6H_B(2), 0, 4, 0 },
+		{ MRL_BC6H_R(2), 0, 5, 0 }, { MRL_BC6H_B(3), 2, 1, 0 }, { MRL_BC6H_R(3), 0, 5, 0 },
+		{ MRL_BC6H_B(3), 3, 1, 0 },
+	} },
+	{ 2, 1, 8, { 6, 5, 5 }, 19, {
+		{ MRL_BC6H_R(0), 0, 8, 0 }, { MRL_BC6H_G(3), 4, 1, 0 }, { MRL_BC6H_B(2), 4, 1, 0 },
+		{ MRL_BC6H_G(0), 0, 8, 0 }, { MRL_BC6H_B(3), 2, 1, 0 }, { MRL_BC6H_G(2), 4, 1, 0 },
+		{ MRL_BC6H_B(0), 0, 8, 0 }, { MRL_BC6H_B(3), 3, 1, 0 }, { MRL_BC6H_B(3), 4, 1, 0 },
+		{ MRL_BC6H_R(1), 0, 6, 0 }, { MRL_BC6H_G(2), 0, 4, 0 }, { MRL_BC6H_G(1), 0, 5, 0 },
+		{ MRL_BC6H_B(3), 0, 1, 0 }, { MRL_BC6H_G(3), 0, 4, 0 }, { MRL_BC6H_B(1), 0, 5, 0 },
+		{ MRL_BC6H_B(3), 1, 1, 0 }, { MRL_BC6H_B(2), 0, 4, 0 }, { MRL_BC6H_R(2), 0, 6, 0 },
+		{ MRL_BC6H_R(3), 0, 6, 0 },
+	} },
+	{ 2, 1, 8, { 5, 6, 5 }, 21, {
+		{ MRL_BC6H_R(0), 0, 8, 0 }, { MRL_BC6H_B(3), 0, 1, 0 }, { MRL_BC6H_B(2), 4, 1, 0 },
+		{ MRL_BC6H_G(0), 0, 8, 0 }, { MRL_BC6H_G(2), 5, 1, 0 }, { MRL_BC6H_G(2), 4, 1, 0 },
+		{ MRL_BC6H_B(0), 0, 8, 0 }, { MRL_BC6H_G(3), 5, 1, 0 }, { MRL_BC6H_B(3), 4, 1, 0 },
+		{ MRL_BC6H_R(1), 0, 5, 0 }, { MRL_BC6H_G(3), 4, 1, 0 }, { MRL_BC6H_G(2), 0, 4, 0 },
+		{ MRL_BC6H_G(1), 0, 6, 0 }, { MRL_BC6H_G(3), 0, 4, 0 }, { MRL_BC6H_B(1), 0, 5, 0 },
+		{ MRL_BC6H_B(3), 1, 1, 0 }, { MRL_BC6H_B(2), 0, 4, 0 }, { MRL_BC6H_R(2), 0, 5, 0 },
+		{ MRL_BC6H_B(3), 2, 1, 0 }, { MRL_BC6H_R(3), 0, 5, 0 }, { MRL_BC6H_B(3), 3, 1, 0 },
+	} },
+	{ 2, 1, 8, { 5, 5, 6 }, 21, {
+		{ MRL_BC6H_R(0), 0, 8, 0 }, { MRL_BC6H_B(3), 1, 1, 0 }, { MRL_BC6H_B(2), 4, 1, 0 },
+		{ MRL_BC6H_G(0), 0, 8, 0 }, { MRL_BC6H_B(2), 5, 1, 0 }, { MRL_BC6H_G(2), 4, 1, 0 },
+		{ MRL_BC6H_B(0), 0, 8, 0 }, { MRL_BC6H_B(3), 5, 1, 0 }, { MRL_BC6H_B(3), 4, 1, 0 },
+		{ MRL_BC6H_R(1), 0, 5, 0 }, { MRL_BC6H_G(3), 4, 1, 0 }, { MRL_BC6H_G(2), 0, 4, 0 },
+		{ MRL_BC6H_G(1), 0, 5, 0 }, { MRL_BC6H_B(3), 0, 1, 0 }, { MRL_BC6H_G(3), 0, 4, 0 },
+		{ MRL_BC6H_B(1), 0, 6, 0 }, { MRL_BC6H_B(2), 0, 4, 0 }, { MRL_BC6H_R(2), 0, 5, 0 },
+		{ MRL_BC6H_B(3), 2, 1, 0 }, { MRL_BC6H_R(3), 0, 5, 0 }, { MRL_BC6H_B(3), 3, 1, 0 },
+	} },
+	{ 2, 0, 6, { 6, 6, 6 }, 23, {
+		{ MRL_BC6H_R(0), 0, 6, 0 }, { MRL_BC6H_G(3), 4, 1, 0 }, { MRL_BC6H_B(3), 0, 1, 0 },
+		{ MRL_BC6H_B(3), 1, 1, 0 }, { MRL_BC6H_B(2), 4, 1, 0 }, { MRL_BC6H_G(0), 0, 6, 0 },
+		{ MRL_BC6H_G(2), 5, 1, 0 }, { MRL_BC6H_B(2), 5, 1, 0 }, { MRL_BC6H_B(3), 2, 1, 0 },
+		{ MRL_BC6H_G(2), 4, 1, 0 }, { MRL_BC6H_B(0), 0, 6, 0 }, { MRL_BC6H_G(3), 5, 1, 0 },
+		{ MRL_BC6H_B(3), 3, 1, 0 }, { MRL_BC6H_B(3), 5, 1, 0 }, { MRL_BC6H_B(3), 4, 1, 0 },
+		{ MRL_BC6H_R(1), 0, 6, 0 }, { MRL_BC6H_G(2), 0, 4, 0 }, { MRL_BC6H_G(1), 0, 6, 0 },
+		{ MRL_BC6H_G(3), 0, 4, 0 }, { MRL_BC6H_B(1), 0, 6, 0 }, { MRL_BC6H_B(2), 0, 4, 0 },
+		{ MRL_BC6H_R(2), 0, 6, 0 }, { MRL_BC6H_R(3), 0, 6, 0 },
+	} },
+	{ 1, 0, 10, { 10, 10, 10 }, 6, {
+		{ MRL_BC6H_R(0), 0, 10, 0 }, { MRL_BC6H_G(0), 0, 10, 0 }, { MRL_BC6H_B(0), 0, 10, 0 },
+		{ MRL_BC6H_R(1), 0, 10, 0 }, { MRL_BC6H_G(1), 0, 10, 0 }, { MRL_BC6H_B(1), 0, 10, 0 },
+	} },
+	{ 1, 1, 11, { 9, 9, 9 }, 9, {
+		{ MRL_BC6H_R(0), 0, 10, 0 }, { MRL_BC6H_G(0), 0, 10, 0 }, { MRL_BC6H_B(0), 0, 10, 0 },
+		{ MRL_BC6H_R(1), 0, 9, 0 }, { MRL_BC6H_R(0), 10, 1, 0 }, { MRL_BC6H_G(1), 0, 9, 0 },
+		{ MRL_BC6H_G(0), 10, 1, 0 }, { MRL_BC6H_B(1), 0, 9, 0 }, { MRL_BC6H_B(0), 10, 1, 0 },
+	} },
+	{ 1, 1, 12, { 8, 8, 8 }, 9, {
+		{ MRL_BC6H_R(0), 0, 10, 0 }, { MRL_BC6H_G(0), 0, 10, 0 }, { MRL_BC6H_B(0), 0, 10, 0 },
+		{ MRL_BC6H_R(1), 0, 8, 0 }, { MRL_BC6H_R(0), 10, 2, 1 }, { MRL_BC6H_G(1), 0, 8, 0 },
+		{ MRL_BC6H_G(0), 10, 2, 1 }, { MRL_BC6H_B(1), 0, 8, 0 }, { MRL_BC6H_B(0), 10, 2, 1 },
+	} },
+	{ 1, 1, 16, { 4, 4, 4 }, 9, {
+		{ MRL_BC6H_R(0), 0, 10, 0 }, { MRL_BC6H_G(0), 0, 10, 0 }, { MRL_BC6H_B(0), 0, 10, 0 },
+		{ MRL_BC6H_R(1), 0, 4, 0 }, { MRL_BC6H_R(0), 10, 6, 1 }, { MRL_BC6H_G(1), 0, 4, 0 },
+		{ MRL_BC6H_G(0), 10, 6, 1 }, { MRL_BC6H_B(1), 0, 4, 0 }, { MRL_BC6H_B(0), 10, 6, 1 },
+	} },
+};
+
+static mgl_i32_t sign_extend(mgl_u32_t v, mgl_u32_t bits)
+{
+	return (mgl_i32_t)(v << (32 - bits)) >> (32 - bits);
+}
+
+// Scales an endpoint component to 16 bits
+static mgl_i32_t unquantize_bc6h(mgl_i32_t v, mgl_u32_t bits, mgl_bool_t is_signed)
+{
+	if (!is_signed)
+	{
+		if (bits >= 15 || v == 0)
+			return v;
+		if (v == (1 << bits) - 1)
+			return 0xFFFF;
+		return ((v << 16) + 0x8000) >> bits;
+	}
+
+	if (bits >= 16)
+		return v;
+	mgl_bool_t negative = v < 0;
+	if (negative)
+		v = -v;
+	mgl_i32_t u;
+	if (v == 0)
+		u = 0;
+	else if (v >= (1 << (bits - 1)) - 1)
+		u = 0x7FFF;
+	else
+		u = ((v << 15) + 0x4000) >> (bits - 1);
+	return negative ? -u : u;
+}
+
+// Scales an interpolated component to the half float range
+static mgl_f32_t finish_unquantize_bc6h(mgl_i32_t v, mgl_bool_t is_signed)
+{
+	if (!is_signed)
+		return half_to_float((mgl_u16_t)((v * 31) >> 6));
+	else if (v < 0)
+		return half_to_float((mgl_u16_t)(0x8000 | (((-v) * 31) >> 5)));
+	else
+		return half_to_float((mgl_u16_t)((v * 31) >> 5));
+}
+
+static void decode_bc6h(const mgl_u8_t* block, mgl_bool_t is_signed, mgl_f32_t* out)
+{
+	mrl_bit_reader_t reader = { block, 0 };
+
+	// Modes 1 and 2 have 2 mode bits, the others have 5
+	mgl_i32_t mode_index = -1;
+	mgl_u32_t mode_bits = read_bits(&reader, 2);
+	if (mode_bits < 2)
+		mode_index = (mgl_i32_t)mode_bits;
+	else
+		switch (mode_bits | (read_bits(&reader, 3) << 2))
+		{
+			case 0x02: mode_index = 2; break;
+			case 0x06: mode_index = 3; break;
+			case 0x0A: mode_index = 4; break;
+			case 0x0E: mode_index = 5; break;
+			case 0x12: mode_index = 6; break;
+			case 0x16: mode_index = 7; break;
+			case 0x1A: mode_index = 8; break;
+			case 0x1E: mode_index = 9; break;
+			case 0x03: mode_index = 10; break;
+			case 0x07: mode_index = 11; break;
+			case 0x0B: mode_index = 12; break;
+			case 0x0F: mode_index = 13; break;
+			default: break;
+		}
+
+	// Reserved modes decode to black
+	if (mode_index < 0)
+	{
+		for (mgl_u32_t i = 0; i < 16; ++i)
+		{
+			out[i * 4 + 0] = out[i * 4 + 1] = out[i * 4 + 2] = 0.0f;
+			out[i * 4 + 3] = 1.0f;
+		}
+		return;
+	}
+
+	const mrl_bc6h_mode_t* m = &bc6h_modes[mode_index];
+	mgl_u32_t raw[12] = { 0 };
+	for (mgl_u32_t f = 0; f < m->field_count; ++f)
+	{
+		const mrl_bc6h_field_t* field = &m->fields[f];
+		for (mgl_u32_t b = 0; b < field->bit_count; ++b)
+		{
+			mgl_u32_t bit = field->reversed ? field->first_bit + field->bit_count - 1 - b : field->first_bit + b;
+			raw[field->component] |= read_bits(&reader, 1) << bit;
+		}
+	}
+
+	// The mode and endpoint bits take 77 bits in two subset modes, followed by the partition, and 65 bits in one subset modes
+	MGL_DEBUG_ASSERT(reader.offset == (m->subset_count == 2 ? 77u : 65u));
+	mgl_u32_t partition = m->subset_count == 2 ? read_bits(&reader, 5) : 0;
+
+	// Apply the delta transform and sign extension
+	mgl_u32_t endpoint_count = m->subset_count * 2;
+	mgl_i32_t endpoints[4][3];
+	mgl_u32_t mask = (1u << m->endpoint_bits) - 1;
+	for (mgl_u32_t c = 0; c < 3; ++c)
+	{
+		endpoints[0][c] = is_signed ? sign_extend(raw[c], m->endpoint_bits) : (mgl_i32_t)raw[c];
+		for (mgl_u32_t e = 1; e < endpoint_count; ++e)
+		{
+			mgl_u32_t v = raw[e * 3 + c];
+			if (m->transformed)
+				v = ((mgl_u32_t)sign_extend(v, m->delta_bits[c]) + raw[c]) & mask;
+			endpoints[e][c] = is_signed ? sign_extend(v, m->endpoint_bits) : (mgl_i32_t)v;
+		}
+	}
+
+	for (mgl_u32_t e = 0; e < endpoint_count; ++e)
+		for (mgl_u32_t c = 0; c < 3; ++c)
+			endpoints[e][c] = unquantize_bc6h(endpoints[e][c], m->endpoint_bits, is_signed);
+
+	mgl_u32_t index_bits = m->subset_count == 2 ? 3 : 4;
+	mgl_u8_t indices[16];
+	read_bptc_indices(&reader, m->subset_count, partition, index_bits, indices);
+
+	const mgl_u32_t* weights = get_bptc_weights(index_bits);
+	for (mgl_u32_t i = 0; i < 16; ++i)
+	{
+		mgl_u32_t subset = get_bptc_subset(m->subset_count, partition, i);
+		mgl_i32_t w = (mgl_i32_t)weights[indices[i]];
+		for (mgl_u32_t c = 0; c < 3; ++c)
+		{
+			mgl_i32_t v = ((64 - w) * endpoints[2 * subset][c] + w * endpoints[2 * subset + 1][c] + 32) >> 6;
+			out[i * 4 + c] = finish_unquantize_bc6h(v, is_signed);
+		}
+		out[i * 4 + 3] = 1.0f;
+	}
+}
+
+static void decode_bc6h_uf(const mgl_u8_t* block, void* out)
+{
+	decode_bc6h(block, MGL_FALSE, (mgl_f32_t*)out);
+}
+
+static void decode_bc6h_sf(const mgl_u8_t* block, void* out)
+{
+	decode_bc6h(block, MGL_TRUE, (mgl_f32_t*)out);
+}
+
+// ---------- ETC2 ----------
+
+static const mgl_i32_t etc_modifiers[8][2] = {
+	{ 2, 8 }, { 5, 17 }, { 9, 29 }, { 13, 42 }, { 18, 60 }, { 24, 80 }, { 33, 106 }, { 47, 183 },
+};
+
+static const mgl_i32_t etc_distances[8] = { 3, 6, 11, 16, 23, 32, 41, 64 };
+
+static const mgl_i32_t eac_modifiers[16][8] = {
+	{ -3, -6, -9, -15, 2, 5, 8, 14 },
+	{ -3, -7, -10, -13, 2, 6, 9, 12 },
+	{ -2, -5, -8, -13, 1, 4, 7, 12 },
+	{ -2, -4, -6, -13, 1, 3, 5, 12 },
+	{ -3, -6, -8, -12, 2, 5, 7, 11 },
+	{ -3, -7, -9, -11, 2, 6, 8, 10 },
+	{ -4, -7, -8, -11, 3, 6, 7, 10 },
+	{ -3, -5, -8, -11, 2, 4, 7, 10 },
+	{ -2, -6, -8, -10, 1, 5, 7, 9 },
+	{ -2, -5, -8, -10, 1, 4, 7, 9 },
+	{ -2, -4, -8, -10, 1, 3, 7, 9 },
+	{ -2, -5, -7, -10, 1, 4, 6, 9 },
+	{ -3, -4, -7, -10, 2, 3, 6, 9 },
+	{ -1, -2, -3, -10, 0, 1, 2, 9 },
+	{ -4, -6, -8, -9, 3, 5, 7, 8 },
+	{ -3, -5, -7, -9, 2, 4, 6, 8 },
+};
+
+static mgl_i32_t expand_4(mgl_u32_t v)
+{
+	return (mgl_i32_t)((v << 4) | v);
+}
+
+static mgl_i32_t expand_5(mgl_u32_t v)
+{
+	return (mgl_i32_t)((v << 3) | (v >> 2));
+}
+
+static mgl_i32_t expand_6(mgl_u32_t v)
+{
+	return (mgl_i32_t)((v << 2) | (v >> 4));
+}
+
+static mgl_i32_t expand_7(mgl_u32_t v)
+{
+	return (mgl_i32_t)((v << 1) | (v >> 6));
+}
+
+static void set_etc_texel(mgl_u8_t* texels, mgl_u32_t x, mgl_u32_t y, const mgl_i32_t* color, mgl_u8_t alpha)
+{
+	mgl_u8_t* texel = texels + (y * 4 + x) * 4;
+	texel[0] = clamp_u8(color[0]);
+	texel[1] = clamp_u8(color[1]);
+	texel[2] = clamp_u8(color[2]);
+	texel[3] = alpha;
+}
+
+// Decodes an ETC2 color block. Punchthrough blocks use the differential bit as an opaque bit, and always use differential mode
+static void decode_etc2_colors(const mgl_u8_t* block, mgl_bool_t punchthrough, mgl_u8_t* out)
+{
+	mgl_u64_t bits = read_u64_be(block);
+	mgl_u32_t indices = (mgl_u32_t)bits;
+	mgl_bool_t differential = punchthrough || ((bits >> 33) & 1);
+	mgl_bool_t opaque = !punchthrough || ((bits >> 33) & 1);
+
+	// Texel indices are stored column by column, split in a most and a least significant bit plane
+	mgl_u32_t texel_indices[16];
+	for (mgl_u32_t i = 0; i < 16; ++i)
+		texel_indices[i] = (((indices >> (16 + i)) & 1) << 1) | ((indices >> i) & 1);
+
+	mgl_i32_t r = (mgl_i32_t)(block[0] >> 3), dr = sign_extend(block[0] & 7, 3);
+	mgl_i32_t g = (mgl_i32_t)(block[1] >> 3), dg = sign_extend(block[1] & 7, 3);
+	mgl_i32_t b = (mgl_i32_t)(block[2] >> 3), db = sign_extend(block[2] & 7, 3);
+
+	if (differential && (r + dr < 0 || r + dr > 31))
+	{
+		// T mode
+		mgl_i32_t c0[3] = {
+			expand_4(((block[0] >> 1) & 0xC) | (block[0] & 3)),
+			expand_4(block[1] >> 4),
+			expand_4(block[1] & 0xF),
+		};
+		mgl_i32_t c1[3] = { expand_4(block[2] >> 4), expand_4(block[2] & 0xF), expand_4(block[3] >> 4) };
+		mgl_i32_t d = etc_distances[((block[3] >> 1) & 6) | (block[3] & 1)];
+
+		mgl_i32_t paint[4][3];
+		for (mgl_u32_t c = 0; c < 3; ++c)
+		{
+			paint[0][c] = c0[c];
+			paint[1][c] = c1[c] + d;
+			paint[2][c] = c1[c];
+			paint[3][c] = c1[c] - d;
+		}
+
+		for (mgl_u32_t i = 0; i < 16; ++i)
+		{
+			mgl_bool_t transparent = !opaque && texel_indices[i] == 2;
+			const mgl_i32_t black[3] = { 0, 0, 0 };
+			set_etc_texel(out, i / 4, i % 4, transparent ? black : paint[texel_indices[i]], transparent ? 0 : 255);
+		}
+	}
+	else if (differential && (g + dg < 0 || g + dg > 31))
+	{
+		// H mode
+		mgl_u32_t r0 = (block[0] >> 3) & 0xF;
+		mgl_u32_t g0 = ((block[0] & 7) << 1) | ((block[1] >> 4) & 1);
+		mgl_u32_t b0 = (block[1] & 8) | ((block[1] & 3) << 1) | (block[2] >> 7);
+		mgl_u32_t r1 = (block[2] >> 3) & 0xF;
+		mgl_u32_t g1 = ((block[2] & 7) << 1) | (block[3] >> 7);
+		mgl_u32_t b1 = (block[3] >> 3) & 0xF;
+
+		// The least significant bit of the distance comes from the order of the base colors
+		mgl_u32_t distance = (block[3] & 4) | ((block[3] & 1) << 1);
+		if (((r0 << 8) | (g0 << 4) | b0) >= ((r1 << 8) | (g1 << 4) | b1))
+			distance |= 1;
+		mgl_i32_t d = etc_distances[distance];
+
+		mgl_i32_t c0[3] = { expand_4(r0), expand_4(g0), expand_4(b0) };
+		mgl_i32_t c1[3] = { expand_4(r1), expand_4(g1), expand_4(b1) };
+		mgl_i32_t paint[4][3];
+		for (mgl_u32_t c = 0; c < 3; ++c)
+		{
+			paint[0][c] = c0[c] + d;
+			paint[1][c] = c0[c] - d;
+			paint[2][c] = c1[c] + d;
+			paint[3][c] = c1[c] - d;
+		}
+
+		for (mgl_u32_t i = 0; i < 16; ++i)
+		{
+			mgl_bool_t transparent = !opaque && texel_indices[i] == 2;
+			const mgl_i32_t black[3] = { 0, 0, 0 };
+			set_etc_texel(out, i / 4, i % 4, transparent ? black : paint[texel_indices[i]], transparent ? 0 : 255);
+		}
+	}
+	else if (differential && (b + db < 0 || b + db > 31))
+	{
+		// Planar mode, which is always opaque
+		mgl_u32_t low = (mgl_u32_t)bits;
+		mgl_i32_t o[3] = {
+			expand_6((block[0] >> 1) & 0x3F),
+			expand_7(((block[0] & 1) << 6) | ((block[1] >> 1) & 0x3F)),
+			expand_6(((block[1] & 1) << 5) | (((block[2] >> 3) & 3) << 3) | ((block[2] & 3) << 1) | (block[3] >> 7)),
+		};
+		mgl_i32_t h[3] = {
+			expand_6((((block[3] >> 2) & 0x1F) << 1) | (block[3] & 1)),
+			expand_7((low >> 25) & 0x7F),
+			expand_6((low >> 19) & 0x3F),
+		};
+		mgl_i32_t v[3] = {
+			expand_6((low >> 13) & 0x3F),
+			expand_7((low >> 6) & 0x7F),
+			expand_6(low & 0x3F),
+		};
+
+		for (mgl_u32_t y = 0; y < 4; ++y)
+			for (mgl_u32_t x = 0; x < 4; ++x)
+			{
+				mgl_i32_t color[3];
+				for (mgl_u32_t c = 0; c < 3; ++c)
+					color[c] = ((mgl_i32_t)x * (h[c] - o[c]) + (mgl_i32_t)y * (v[c] - o[c]) + 4 * o[c] + 2) >> 2;
+				set_etc_texel(out, x, y, color, 255);
+			}
+	}
+	else
+	{
+		// Individual or differential mode, with two subblocks of 2x4 or 4x2 texels
+		mgl_i32_t base[2][3];
+		if (differential)
+		{
+			base[0][0] = expand_5((mgl_u32_t)r);
+			base[0][1] = expand_5((mgl_u32_t)g);
+			base[0][2] = expand_5((mgl_u32_t)b);
+			base[1][0] = expand_5((mgl_u32_t)(r + dr));
+			base[1][1] = expand_5((mgl_u32_t)(g + dg));
+			base[1][2] = expand_5((mgl_u32_t)(b + db));
+		}
+		else
+			for (mgl_u32_t c = 0; c < 3; ++c)
+			{
+				base[0][c] = expand_4(block[c] >> 4);
+				base[1][c] = expand_4(block[c] & 0xF);
+			}
+
+		mgl_u32_t tables[2] = { block[3] >> 5, (block[3] >> 2) & 7 };
+		mgl_bool_t flip = block[3] & 1;
+		for (mgl_u32_t i = 0; i < 16; ++i)
+		{
+			mgl_u32_t x = i / 4, y = i % 4;
+			mgl_u32_t subblock = flip ? (y >= 2) : (x >= 2);
+
+			// Transparent punchthrough blocks replace the smallest modifier with the base color
+			mgl_i32_t modifier;
+			switch (texel_indices[i])
+			{
+				case 0: modifier = opaque ? etc_modifiers[tables[subblock]][0] : 0; break;
+				case 1: modifier = etc_modifiers[tables[subblock]][1]; break;
+				case 2: modifier = opaque ? -etc_modifiers[tables[subblock]][0] : 0; break;
+				default: modifier = -etc_modifiers[tables[subblock]][1]; break;
+			}
+
+			mgl_bool_t transparent = !opaque && texel_indices[i] == 2;
+			mgl_i32_t color[3];
+			for (mgl_u32_t c = 0; c < 3; ++c)
+				color[c] = transparent ? 0 : base[subblock][c] + modifier;
+			set_etc_texel(out, x, y, color, transparent ? 0 : 255);
+		}
+	}
+}
+
+static void decode_etc2_rgb8(const mgl_u8_t* block, void* out)
+{
+	decode_etc2_colors(block, MGL_FALSE, (mgl_u8_t*)out);
+}
+
+static void decode_etc2_rgb8a1(const mgl_u8_t* block, void* out)
+{
+	decode_etc2_colors(block, MGL_TRUE, (mgl_u8_t*)out);
+}
+
+static void decode_etc2_rgba8(const mgl_u8_t* block, void* out)
+{
+	mgl_u8_t* texels = (mgl_u8_t*)out;
+	decode_etc2_colors(block + 8, MGL_FALSE, texels);
+
+	// EAC alpha, with 3-bit indices stored column by column from the most significant bit
+	mgl_u64_t bits = read_u64_be(block);
+	mgl_i32_t base = block[0];
+	mgl_i32_t multiplier = block[1] >> 4;
+	const mgl_i32_t* modifiers = eac_modifiers[block[1] & 0xF];
+	for (mgl_u32_t i = 0; i < 16; ++i)
+	{
+		mgl_u32_t index = (mgl_u32_t)(bits >> (45 - 3 * i)) & 7;
+		texels[((i % 4) * 4 + i / 4) * 4 + 3] = clamp_u8(base + modifiers[index] * multiplier);
+	}
+}
+
+// ---------- Decoding ----------
+
+typedef void(*mrl_decode_block_func_t)(const mgl_u8_t* block, void* out);
+
+static mrl_decode_block_func_t get_decode_block_func(mgl_enum_t format)
+{
+	switch (format)
+	{
+		case MRL_TEXTURE_FORMAT_BC1_UN: return &decode_bc1;
+		case MRL_TEXTURE_FORMAT_BC2_UN: return &decode_bc2;
+		case MRL_TEXTURE_FORMAT_BC3_UN: return &decode_bc3;
+		case MRL_TEXTURE_FORMAT_BC4_UN: return &decode_bc4_un;
+		case MRL_TEXTURE_FORMAT_BC4_SN: return &decode_bc4_sn;
+		case MRL_TEXTURE_FORMAT_BC5_UN: return &decode_bc5_un;
+		case MRL_TEXTURE_FORMAT_BC5_SN: return &decode_bc5_sn;
+		case MRL_TEXTURE_FORMAT_BC6H_UF: return &decode_bc6h_uf;
+		case MRL_TEXTURE_FORMAT_BC6H_SF: return &decode_bc6h_sf;
+		case MRL_TEXTURE_FORMAT_BC7_UN: return &decode_bc7;
+		case MRL_TEXTURE_FORMAT_ETC2_RGB8_UN: return &decode_etc2_rgb8;
+		case MRL_TEXTURE_FORMAT_ETC2_RGB8A1_UN: return &decode_etc2_rgb8a1;
+		default: return &decode_etc2_rgba8;
+	}
+}
+
+static void decode_block_row(const mrl_decode_job_t* job, mrl_decode_block_func_t func, mgl_u64_t row)
+{
+	// Large enough for 16 RGBA32_F texels
+	mgl_f32_t texels[64];
+	const mgl_u8_t* block = job->data + row * job->blocks_per_row * job->block_size;
+	mgl_u64_t y = row * 4;
+	mgl_u64_t height = job->height - y < 4 ? job->height - y : 4;
+
+	for (mgl_u64_t i = 0; i < job->blocks_per_row; ++i, block += job->block_size)
+	{
+		func(block, texels);
+
+		// Partial blocks on the right and bottom edges are cropped
+		mgl_u64_t x = i * 4;
+		mgl_u64_t width = job->width - x < 4 ? job->width - x : 4;
+		for (mgl_u64_t j = 0; j < height; ++j)
+			mgl_mem_copy(job->out + (y + j) * job->out_row_pitch + x * job->texel_size, (const mgl_u8_t*)texels + j * 4 * job->texel_size, width * job->texel_size);
+	}
+}
+
+static void decode_chunks(void* arg)
+{
+	mrl_decode_job_t* job = (mrl_decode_job_t*)arg;
+	mrl_decode_block_func_t func = get_decode_block_func(job->format);
+
+	for (;;)
+	{
+		mgl_u32_t chunk = mrl_atomic_fetch_add(&job->next_chunk, 1);
+		if (chunk >= job->chunk_count)
+			break;
+
+		mgl_u64_t first = (mgl_u64_t)chunk * job->rows_per_chunk;
+		mgl_u64_t last = first + job->rows_per_chunk < job->block_row_count ? first + job->rows_per_chunk : job->block_row_count;
+		for (mgl_u64_t row = first; row < last; ++row)
+			decode_block_row(job, func, row);
+	}
+}
+
+void mrl_decode_texture(mgl_enum_t format, mgl_u64_t width, mgl_u64_t height, const void* data, void* out, mgl_u64_t out_row_pitch)
+{
+	MGL_DEBUG_ASSERT(mrl_is_compressed_format(format) && data != NULL && out != NULL);
+
+	mrl_decode_job_t job;
+	job.format = format;
+	job.width = width;
+	job.height = height;
+	job.block_size = get_block_size(format);
+	job.texel_size = mrl_get_decoded_texel_size(format);
+	job.blocks_per_row = (width + 3) / 4;
+	job.block_row_count = (height + 3) / 4;
+	job.data = (const mgl_u8_t*)data;
+	job.out = (mgl_u8_t*)out;
+	job.out_row_pitch = out_row_pitch;
+	if (job.block_row_count == 0)
+		return;
+
+	// Only start as many threads as there is enough work for
+	mgl_u64_t thread_count = job.blocks_per_row * job.block_row_count / MRL_DECODE_BLOCKS_PER_THREAD;
+	mgl_u32_t hardware_thread_count = mrl_get_hardware_thread_count();
+	if (thread_count > hardware_thread_count)
+		thread_count = hardware_thread_count;
+	if (thread_count > MRL_MAX_DECODE_THREAD_COUNT)
+		thread_count = MRL_MAX_DECODE_THREAD_COUNT;
+	if (thread_count < 1)
+		thread_count = 1;
+
+	// Split the rows into more chunks than threads, so that uneven chunks are balanced out
+	mgl_u64_t chunk_count = thread_count * MRL_DECODE_CHUNKS_PER_THREAD;
+	if (chunk_count > job.block_row_count)
+		chunk_count = job.block_row_count;
+	job.rows_per_chunk = (mgl_u32_t)((job.block_row_count + chunk_count - 1) / chunk_count);
+	job.chunk_count = (mgl_u32_t)((job.block_row_count + job.rows_per_chunk - 1) / job.rows_per_chunk);
+	mrl_atomic_store(&job.next_chunk, 0);
+
+	// The calling thread decodes too, and picks up the chunks of threads which failed to start
+	mrl_thread_t threads[MRL_MAX_DECODE_THREAD_COUNT];
+	mgl_u32_t started_count = 0;
+	for (mgl_u32_t i = 1; i < thread_count; ++i)
+	{
+		if (mrl_start_thread(&threads[started_count], &decode_chunks, &job) != MRL_ERROR_NONE)
+			break;
+		++started_count;
+	}
+
+	decode_chunks(&job);
+	for (mgl_u32_t i = 0; i < started_count; ++i)
+		mrl_join_thread(&threads[i]);
+}
@@ -0,0 +1,53 @@
+#ifndef MRL_TEXTURE_DECODER_H
+#define MRL_TEXTURE_DECODER_H
+
+#include <mrl/render_device.h>
+
+#define MRL_MAX_DECODE_THREAD_COUNT 16
+
+/// <summary>
+///		Checks if a texture format is block compressed.
+/// </summary>
+/// <param name="format">Texture format</param>
+/// <returns>True if the format is compressed, otherwise false</returns>
+mgl_bool_t mrl_is_compressed_format(mgl_enum_t format);
+
+/// <summary>
+///		Gets the size in bytes of the compressed data of a texture region.
+///		Each 4x4 block of the region takes the same number of bytes, and partial blocks on the edges are stored whole.
+/// </summary>
+/// <param name="format">Compressed texture format</param>
+/// <param name="width">Region width</param>
+/// <param name="height">Region height</param>
+/// <param name="depth">Region depth</param>
+/// <returns>Data size in bytes</returns>
+mgl_u64_t mrl_get_compressed_data_size(mgl_enum_t format, mgl_u64_t width, mgl_u64_t height, mgl_u64_t depth);
+
+/// <summary>
+///		Gets the uncompressed format to which a compressed format is decoded.
+///		BC4 and BC5 are decoded to R8 and RG8, BC6H to RGBA32_F and every other format to RGBA8_UN.
+/// </summary>
+/// <param name="format">Compressed texture format</param>
+/// <returns>Decoded texture format</returns>
+mgl_enum_t mrl_get_decoded_format(mgl_enum_t format);
+
+/// <summary>
+///		Gets the size in bytes of a decoded texel.
+/// </summary>
+/// <param name="format">Compressed texture format</param>
+/// <returns>Decoded texel size</returns>
+mgl_u64_t mrl_get_decoded_texel_size(mgl_enum_t format);
+
+/// <summary>
+///		Decodes a compressed 2D image.
+///		Large images are split into rows of blocks which are decoded on multiple threads.
+/// </summary>
+/// <param name="format">Compressed texture format</param>
+/// <param name="width">Image width</param>
+/// <param name="height">Image height</param>
+/// <param name="data">Compressed data</param>
+/// <param name="out">Decoded data, in the format returned by mrl_get_decoded_format</param>
+/// <param name="out_row_pitch">Size in bytes of each row of the decoded data</param>
+void mrl_decode_texture(mgl_enum_t format, mgl_u64_t width, mgl_u64_t height, const void* data, void* out, mgl_u64_t out_row_pitch);
+
+#endif
@@ -0,0 +1,187 @@
+#include <mrl/thread.h>
+
+#ifndef MGL_SYSTEM_WINDOWS
+#	include <unistd.h>
+#endif
+
+// ---------- Threads ----------
+
+#ifdef MGL_SYSTEM_WINDOWS
+static DWORD WINAPI thread_entry(LPVOID param)
+{
+	mrl_thread_t* thread = (mrl_thread_t*)param;
+	thread->func(thread->arg);
+	return 0;
+}
+#else
+static void* thread_entry(void* param)
+{
+	mrl_thread_t* thread = (mrl_thread_t*)param;
+	thread->func(thread->arg);
+	return NULL;
+}
+#endif
+
+mrl_error_t mrl_start_thread(mrl_thread_t* thread, mrl_thread_func_t func, void* arg)
+{
+	MGL_DEBUG_ASSERT(thread != NULL && func != NULL);
+
+	thread->func = func;
+	thread->arg = arg;
+
+#ifdef MGL_SYSTEM_WINDOWS
+	thread->handle = CreateThread(NULL, 0, &thread_entry, thread, 0, NULL);
+	if (thread->handle == NULL)
+		return MRL_ERROR_EXTERNAL;
+#else
+	if (pthread_create(&thread->handle, NULL, &thread_entry, thread) != 0)
+		return MRL_ERROR_EXTERNAL;
+#endif
+
+	return MRL_ERROR_NONE;
+}
+
+void mrl_join_thread(mrl_thread_t* thread)
+{
+	MGL_DEBUG_ASSERT(thread != NULL);
+
+#ifdef MGL_SYSTEM_WINDOWS
+	WaitForSingleObject(thread->handle, INFINITE);
+	CloseHandle(thread->handle);
+#else
+	pthread_join(thread->handle, NULL);
+#endif
+}
+
+mgl_u32_t mrl_get_hardware_thread_count(void)
+{
+#ifdef MGL_SYSTEM_WINDOWS
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return info.dwNumberOfProcessors > 0 ? (mgl_u32_t)info.dwNumberOfProcessors : 1;
+#else
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 0 ? (mgl_u32_t)count : 1;
+#endif
+}
+
+// ---------- Mutexes ----------
+
+void mrl_init_mutex(mrl_mutex_t* mutex)
+{
+#ifdef MGL_SYSTEM_WINDOWS
+	InitializeSRWLock(&mutex->lock);
+#else
+	pthread_mutex_init(&mutex->mutex, NULL);
+#endif
+}
+
+void mrl_terminate_mutex(mrl_mutex_t* mutex)
+{
+#ifndef MGL_SYSTEM_WINDOWS
+	pthread_mutex_destroy(&mutex->mutex);
+#endif
+}
+
+void mrl_lock_mutex(mrl_mutex_t* mutex)
+{
+#ifdef MGL_SYSTEM_WINDOWS
+	AcquireSRWLockExclusive(&mutex->lock);
+#else
+	pthread_mutex_lock(&mutex->mutex);
+#endif
+}
+
+void mrl_unlock_mutex(mrl_mutex_t* mutex)
+{
+#ifdef MGL_SYSTEM_WINDOWS
+	ReleaseSRWLockExclusive(&mutex->lock);
+#else
+	pthread_mutex_unlock(&mutex->mutex);
+#endif
+}
+
+// ---------- Condition variables ----------
+
+void mrl_init_condition(mrl_condition_t* cond)
+{
+#ifdef MGL_SYSTEM_WINDOWS
+	InitializeConditionVariable(&cond->cv);
+#else
+	pthread_cond_init(&cond->cv, NULL);
+#endif
+}
+
+void mrl_terminate_condition(mrl_condition_t* cond)
+{
+#ifndef MGL_SYSTEM_WINDOWS
+	pthread_cond_destroy(&cond->cv);
+#endif
+}
+
+void mrl_wait_condition(mrl_condition_t* cond, mrl_mutex_t* mutex)
+{
+#ifdef MGL_SYSTEM_WINDOWS
+	SleepConditionVariableSRW(&cond->cv, &mutex->lock, INFINITE, 0);
+#else
+	pthread_cond_wait(&cond->cv, &mutex->mutex);
+#endif
+}
+
+void mrl_signal_condition(mrl_condition_t* cond)
+{
+#ifdef MGL_SYSTEM_WINDOWS
+	WakeConditionVariable(&cond->cv);
+#else
+	pthread_cond_signal(&cond->cv);
+#endif
+}
+
+void mrl_broadcast_condition(mrl_condition_t* cond)
+{
+#ifdef MGL_SYSTEM_WINDOWS
+	WakeAllConditionVariable(&cond->cv);
+#else
+	pthread_cond_broadcast(&cond->cv);
+#endif
+}
+
+// ---------- Atomics ----------
+
+mgl_u32_t mrl_atomic_load(const mrl_atomic_u32_t* atomic)
+{
+#ifdef MGL_SYSTEM_WINDOWS
+	mgl_u32_t value = atomic->value;
+	MemoryBarrier();
+	return value;
+#else
+	return __atomic_load_n(&atomic->value, __ATOMIC_ACQUIRE);
+#endif
+}
+
+void mrl_atomic_store(mrl_atomic_u32_t* atomic, mgl_u32_t value)
+{
+#ifdef MGL_SYSTEM_WINDOWS
+	InterlockedExchange((volatile LONG*)&atomic->value, (LONG)value);
+#else
+	__atomic_store_n(&atomic->value, value, __ATOMIC_RELEASE);
+#endif
+}
+
+mgl_u32_t mrl_atomic_fetch_add(mrl_atomic_u32_t* atomic, mgl_u32_t value)
+{
+#ifdef MGL_SYSTEM_WINDOWS
+	return (mgl_u32_t)InterlockedExchangeAdd((volatile LONG*)&atomic->value, (LONG)value);
+#else
+	return __atomic_fetch_add(&atomic->value, value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+mgl_bool_t mrl_atomic_compare_exchange(mrl_atomic_u32_t* atomic, mgl_u32_t expected, mgl_u32_t desired)
+{
+#ifdef MGL_SYSTEM_WINDOWS
+	return (mgl_u32_t)InterlockedCompareExchange((volatile LONG*)&atomic->value, (LONG)desired, (LONG)expected) == expected;
+#else
+	return __atomic_compare_exchange_n(&atomic->value, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#endif
+}
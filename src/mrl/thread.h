@@ -0,0 +1,93 @@
+#ifndef MRL_THREAD_H
+#define MRL_THREAD_H
+
+#include <mrl/error.h>
+
+#ifdef MGL_SYSTEM_WINDOWS
+#	ifndef WIN32_LEAN_AND_MEAN
+#		define WIN32_LEAN_AND_MEAN
+#	endif
+#	include <Windows.h>
+#else
+#	include <pthread.h>
+#endif
+
+typedef void(*mrl_thread_func_t)(void* arg);
+
+typedef struct
+{
+	mrl_thread_func_t func;
+	void* arg;
+#	ifdef MGL_SYSTEM_WINDOWS
+	HANDLE handle;
+#	else
+	pthread_t handle;
+#	endif
+} mrl_thread_t;
+
+typedef struct
+{
+#	ifdef MGL_SYSTEM_WINDOWS
+	SRWLOCK lock;
+#	else
+	pthread_mutex_t mutex;
+#	endif
+} mrl_mutex_t;
+
+typedef struct
+{
+	volatile mgl_u32_t value;
+} mrl_atomic_u32_t;
+
+typedef struct
+{
+#	ifdef MGL_SYSTEM_WINDOWS
+	CONDITION_VARIABLE cv;
+#	else
+	pthread_cond_t cv;
+#	endif
+} mrl_condition_t;
+
+/// <summary>
+///		Starts a new thread.
+///		The thread object must stay at the same address until the thread is joined.
+/// </summary>
+/// <param name="thread">Thread object</param>
+/// <param name="func">Thread entry function</param>
+/// <param name="arg">Argument passed to the entry function</param>
+/// <returns>Error code</returns>
+mrl_error_t mrl_start_thread(mrl_thread_t* thread, mrl_thread_func_t func, void* arg);
+
+/// <summary>
+///		Waits for a thread to finish.
+/// </summary>
+/// <param name="thread">Thread object</param>
+void mrl_join_thread(mrl_thread_t* thread);
+
+/// <summary>
+///		Gets the number of hardware threads available.
+/// </summary>
+/// <returns>Hardware thread count (at least 1)</returns>
+mgl_u32_t mrl_get_hardware_thread_count(void);
+
+void mrl_init_mutex(mrl_mutex_t* mutex);
+void mrl_terminate_mutex(mrl_mutex_t* mutex);
+void mrl_lock_mutex(mrl_mutex_t* mutex);
+void mrl_unlock_mutex(mrl_mutex_t* mutex);
+
+void mrl_init_condition(mrl_condition_t* cond);
+void mrl_terminate_condition(mrl_condition_t* cond);
+void mrl_wait_condition(mrl_condition_t* cond, mrl_mutex_t* mutex);
+void mrl_signal_condition(mrl_condition_t* cond);
+void mrl_broadcast_condition(mrl_condition_t* cond);
+
+/// <summary>
+///		Atomic operations. Loads have acquire semantics, stores have release semantics,
+///		and read-modify-write operations are sequentially consistent.
+/// </summary>
+mgl_u32_t mrl_atomic_load(const mrl_atomic_u32_t* atomic);
+void mrl_atomic_store(mrl_atomic_u32_t* atomic, mgl_u32_t value);
+mgl_u32_t mrl_atomic_fetch_add(mrl_atomic_u32_t* atomic, mgl_u32_t value);
+mgl_bool_t mrl_atomic_compare_exchange(mrl_atomic_u32_t* atomic, mgl_u32_t expected, mgl_u32_t desired);
+
+#endif
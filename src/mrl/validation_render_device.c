@@ -0,0 +1,2422 @@
+#include <mrl/validation_render_device.h>
+#include <mrl/object_pool.h>
+#include <mrl/texture_decoder.h>
+
+#include <mgl/memory/allocator.h>
+#include <mgl/string/manipulation.h>
+
+#define MRL_VALIDATION_OBJECT_POOL_COUNT 20
+
+// Tags stored on live objects, made of this value ORed with the object type
+#define MRL_VALIDATION_TAG 0x4D524C00
+#define MRL_VALIDATION_BINDING_POINT 0xFF
+
+// Every object starts with the handle of the target device object, followed by its tag.
+// The object pool overwrites the first bytes of freed objects, but the tag is kept, and cleared on destruction.
+typedef struct
+{
+	void* handle;
+	mgl_u32_t tag;
+} mrl_validation_object_t;
+
+typedef struct
+{
+	void* handle;
+	mgl_u32_t tag;
+	mgl_enum_t format;
+	mgl_enum_t usage;
+	mgl_u32_t mip_level_count;
+	mgl_u64_t width;
+	mgl_u64_t height;
+	mgl_u64_t depth;
+	mgl_u64_t layer_count;
+} mrl_validation_texture_t;
+
+typedef struct
+{
+	void* handle;
+	mgl_u32_t tag;
+	mgl_enum_t usage;
+	mgl_u64_t size;
+
+	// Range currently mapped
+	mgl_bool_t mapped;
+	mgl_u64_t map_size;
+	mgl_u32_t map_flags;
+} mrl_validation_buffer_t;
+
+typedef struct
+{
+	void* handle;
+	mgl_u32_t tag;
+	mrl_validation_buffer_t* buffer;
+	mgl_enum_t buffer_object;
+	mgl_bool_t mapped;
+} mrl_validation_stream_allocator_t;
+
+typedef struct
+{
+	void* handle;
+	mgl_u32_t tag;
+	mgl_u64_t last_token;
+} mrl_validation_upload_queue_t;
+
+typedef struct
+{
+	void* handle;
+	mgl_u32_t tag;
+	mgl_enum_t stage;
+} mrl_validation_shader_stage_t;
+
+// Kind of resource used with a binding point
+enum
+{
+	MRL_VALIDATION_BINDING_NONE,
+	MRL_VALIDATION_BINDING_SAMPLER,
+	MRL_VALIDATION_BINDING_TEXTURE_1D,
+	MRL_VALIDATION_BINDING_TEXTURE_2D,
+	MRL_VALIDATION_BINDING_TEXTURE_3D,
+	MRL_VALIDATION_BINDING_CUBE_MAP,
+	MRL_VALIDATION_BINDING_TEXTURE_2D_ARRAY,
+	MRL_VALIDATION_BINDING_CUBE_MAP_ARRAY,
+	MRL_VALIDATION_BINDING_CONSTANT_BUFFER,
+};
+
+typedef struct mrl_validation_binding_point_t mrl_validation_binding_point_t;
+
+struct mrl_validation_binding_point_t
+{
+	void* handle;
+	mgl_u32_t tag;
+	mgl_enum_t kind;
+	mrl_validation_binding_point_t* next;
+};
+
+typedef struct
+{
+	void* handle;
+	mgl_u32_t tag;
+
+	// Binding points queried so far, allocated from the binding point pool
+	mrl_validation_binding_point_t* bps;
+} mrl_validation_shader_pipeline_t;
+
+typedef struct
+{
+	mrl_render_device_t base;
+
+	void* allocator;
+	mrl_render_device_t* target;
+
+	struct
+	{
+		mrl_object_pool_t framebuffer;
+		mrl_object_pool_t raster_state;
+		mrl_object_pool_t depth_stencil_state;
+		mrl_object_pool_t blend_state;
+		mrl_object_pool_t sampler;
+		mrl_object_pool_t texture_1d;
+		mrl_object_pool_t texture_2d;
+		mrl_object_pool_t texture_3d;
+		mrl_object_pool_t cube_map;
+		mrl_object_pool_t constant_buffer;
+		mrl_object_pool_t index_buffer;
+		mrl_object_pool_t vertex_buffer;
+		mrl_object_pool_t vertex_array;
+		mrl_object_pool_t shader_stage;
+		mrl_object_pool_t shader_pipeline;
+		mrl_object_pool_t stream_allocator;
+		mrl_object_pool_t indirect_buffer;
+		mrl_object_pool_t upload_queue;
+		mrl_object_pool_t texture_2d_array;
+		mrl_object_pool_t cube_map_array;
+
+		// Binding points belong to their pipelines, so they aren't indexed by object type
+		mrl_object_pool_t binding_point;
+	} memory;
+
+	// Objects currently set, which are cleared when destroyed
+	struct
+	{
+		const void* shader_pipeline;
+		const void* vertex_array;
+		const void* index_buffer;
+		mgl_u64_t mapped_buffer_count;
+	} state;
+
+	struct
+	{
+		mgl_u64_t constant_buffer_offset_alignment;
+	} limits;
+
+	mrl_render_device_hint_error_callback_t error_callback;
+	mrl_render_device_hint_error_callback_t warning_callback;
+} mrl_validation_render_device_t;
+
+// ---------- Checks ----------
+
+static mgl_bool_t report(mrl_validation_render_device_t* rd, const mgl_chr8_t* msg)
+{
+	if (rd->error_callback != NULL)
+		rd->error_callback(MRL_ERROR_INVALID_PARAMS, msg);
+	return MGL_FALSE;
+}
+
+static void warn(mrl_validation_render_device_t* rd, const mgl_chr8_t* msg)
+{
+	if (rd->warning_callback != NULL)
+		rd->warning_callback(MRL_ERROR_NONE, msg);
+}
+
+static mgl_u32_t make_tag(mgl_enum_t type)
+{
+	return MRL_VALIDATION_TAG | type;
+}
+
+static mgl_bool_t is_alive(const void* obj, mgl_enum_t type)
+{
+	return obj != NULL && ((const mrl_validation_object_t*)obj)->tag == make_tag(type);
+}
+
+static mgl_bool_t check_object(mrl_validation_render_device_t* rd, const void* obj, mgl_enum_t type, const mgl_chr8_t* msg)
+{
+	return is_alive(obj, type) ? MGL_TRUE : report(rd, msg);
+}
+
+static mgl_bool_t check_optional_object(mrl_validation_render_device_t* rd, const void* obj, mgl_enum_t type, const mgl_chr8_t* msg)
+{
+	return obj == NULL || check_object(rd, obj, type, msg);
+}
+
+static void* get_handle(const void* obj)
+{
+	return obj == NULL ? NULL : ((const mrl_validation_object_t*)obj)->handle;
+}
+
+static mgl_bool_t is_depth_format(mgl_enum_t format)
+{
+	return format >= MRL_TEXTURE_FORMAT_D16 && format <= MRL_TEXTURE_FORMAT_D32S8;
+}
+
+// Checks if [offset, offset + size) fits in [0, max), without overflowing
+static mgl_bool_t is_range_valid(mgl_u64_t offset, mgl_u64_t size, mgl_u64_t max)
+{
+	return size <= max && offset <= max - size;
+}
+
+// ---------- Objects ----------
+
+static mrl_error_t create_object(mrl_object_pool_t* pool, mgl_enum_t type, void** out)
+{
+	// Allocate object
+	mrl_validation_object_t* obj;
+	mgl_error_t err = mrl_allocate_object(pool, (void**)&obj);
+	if (err != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(err);
+
+	obj->handle = NULL;
+	obj->tag = make_tag(type);
+	*out = obj;
+
+	return MRL_ERROR_NONE;
+}
+
+// Keeps the object if the target device created it, or deallocates it otherwise
+static mrl_error_t finish_object(mrl_object_pool_t* pool, mrl_error_t target_err, void* obj, void** out)
+{
+	if (target_err != MRL_ERROR_NONE)
+	{
+		((mrl_validation_object_t*)obj)->tag = 0;
+		mrl_deallocate_object(pool, obj);
+		return target_err;
+	}
+
+	*out = obj;
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_object(mrl_object_pool_t* pool, void* obj)
+{
+	// Clear the tag, so that uses after destruction are detected
+	((mrl_validation_object_t*)obj)->tag = 0;
+	mrl_deallocate_object(pool, obj);
+}
+
+// ---------- Framebuffers ----------
+
+static mrl_error_t create_framebuffer(mrl_render_device_t* brd, mrl_framebuffer_t** fb, const mrl_framebuffer_desc_t* desc)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+
+	// Check render targets
+	if (desc->target_count == 0 || desc->target_count > MRL_MAX_FRAMEBUFFER_RENDER_TARGET_COUNT)
+	{
+		report(rd, u8"Failed to create framebuffer: target count must be between 1 and MRL_MAX_FRAMEBUFFER_RENDER_TARGET_COUNT");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	mrl_framebuffer_desc_t target_desc = *desc;
+	for (mgl_u32_t i = 0; i < desc->target_count; ++i)
+	{
+		const mrl_validation_texture_t* tex;
+		if (desc->targets[i].type == MRL_RENDER_TARGET_TYPE_TEXTURE_2D)
+		{
+			if (!check_object(rd, desc->targets[i].tex_2d.handle, MRL_OBJECT_TEXTURE_2D, u8"Failed to create framebuffer: invalid render target texture 2D handle"))
+				return MRL_ERROR_INVALID_PARAMS;
+			tex = (const mrl_validation_texture_t*)desc->targets[i].tex_2d.handle;
+			target_desc.targets[i].tex_2d.handle = tex->handle;
+		}
+		else if (desc->targets[i].type == MRL_RENDER_TARGET_TYPE_CUBE_MAP)
+		{
+			if (!check_object(rd, desc->targets[i].cube_map.handle, MRL_OBJECT_CUBE_MAP, u8"Failed to create framebuffer: invalid render target cube map handle"))
+				return MRL_ERROR_INVALID_PARAMS;
+			if (desc->targets[i].cube_map.face > MRL_CUBE_MAP_FACE_NEGATIVE_Z)
+			{
+				report(rd, u8"Failed to create framebuffer: invalid render target cube map face");
+				return MRL_ERROR_INVALID_PARAMS;
+			}
+			tex = (const mrl_validation_texture_t*)desc->targets[i].cube_map.handle;
+			target_desc.targets[i].cube_map.handle = tex->handle;
+		}
+		else if (desc->targets[i].type == MRL_RENDER_TARGET_TYPE_TEXTURE_2D_ARRAY)
+		{
+			if (!check_object(rd, desc->targets[i].tex_2d_array.handle, MRL_OBJECT_TEXTURE_2D_ARRAY, u8"Failed to create framebuffer: invalid render target texture 2D array handle"))
+				return MRL_ERROR_INVALID_PARAMS;
+			tex = (const mrl_validation_texture_t*)desc->targets[i].tex_2d_array.handle;
+			if (desc->targets[i].tex_2d_array.layer >= tex->layer_count)
+			{
+				report(rd, u8"Failed to create framebuffer: render target texture array layer out of range");
+				return MRL_ERROR_INVALID_PARAMS;
+			}
+			target_desc.targets[i].tex_2d_array.handle = tex->handle;
+		}
+		else
+		{
+			report(rd, u8"Failed to create framebuffer: invalid render target type");
+			return MRL_ERROR_INVALID_PARAMS;
+		}
+
+		if (tex->usage != MRL_TEXTURE_USAGE_RENDER_TARGET)
+		{
+			report(rd, u8"Failed to create framebuffer: render target usage must be MRL_TEXTURE_USAGE_RENDER_TARGET");
+			return MRL_ERROR_INVALID_PARAMS;
+		}
+
+		if (is_depth_format(tex->format))
+		{
+			report(rd, u8"Failed to create framebuffer: render targets can't have depth/stencil formats");
+			return MRL_ERROR_INVALID_PARAMS;
+		}
+
+		if (desc->targets[i].mip_level >= tex->mip_level_count)
+		{
+			report(rd, u8"Failed to create framebuffer: render target mip level out of range");
+			return MRL_ERROR_INVALID_PARAMS;
+		}
+	}
+
+	// Check depth stencil texture
+	if (desc->depth_stencil != NULL)
+	{
+		if (!check_object(rd, desc->depth_stencil, MRL_OBJECT_TEXTURE_2D, u8"Failed to create framebuffer: invalid depth/stencil texture handle"))
+			return MRL_ERROR_INVALID_PARAMS;
+
+		const mrl_validation_texture_t* tex = (const mrl_validation_texture_t*)desc->depth_stencil;
+		if (!is_depth_format(tex->format))
+		{
+			report(rd, u8"Failed to create framebuffer: the depth/stencil texture must have a depth/stencil format");
+			return MRL_ERROR_INVALID_PARAMS;
+		}
+
+		if (tex->usage != MRL_TEXTURE_USAGE_RENDER_TARGET)
+		{
+			report(rd, u8"Failed to create framebuffer: depth/stencil texture usage must be MRL_TEXTURE_USAGE_RENDER_TARGET");
+			return MRL_ERROR_INVALID_PARAMS;
+		}
+
+		target_desc.depth_stencil = tex->handle;
+	}
+
+	// Check depth stencil texture array
+	if (desc->depth_stencil_array != NULL)
+	{
+		if (desc->depth_stencil != NULL)
+		{
+			report(rd, u8"Failed to create framebuffer: depth/stencil texture and texture array can't be both set");
+			return MRL_ERROR_INVALID_PARAMS;
+		}
+
+		if (!check_object(rd, desc->depth_stencil_array, MRL_OBJECT_TEXTURE_2D_ARRAY, u8"Failed to create framebuffer: invalid depth/stencil texture array handle"))
+			return MRL_ERROR_INVALID_PARAMS;
+
+		const mrl_validation_texture_t* tex = (const mrl_validation_texture_t*)desc->depth_stencil_array;
+		if (!is_depth_format(tex->format))
+		{
+			report(rd, u8"Failed to create framebuffer: the depth/stencil texture array must have a depth/stencil format");
+			return MRL_ERROR_INVALID_PARAMS;
+		}
+
+		if (tex->usage != MRL_TEXTURE_USAGE_RENDER_TARGET)
+		{
+			report(rd, u8"Failed to create framebuffer: depth/stencil texture array usage must be MRL_TEXTURE_USAGE_RENDER_TARGET");
+			return MRL_ERROR_INVALID_PARAMS;
+		}
+
+		if (desc->depth_stencil_layer >= tex->layer_count)
+		{
+			report(rd, u8"Failed to create framebuffer: depth/stencil texture array layer out of range");
+			return MRL_ERROR_INVALID_PARAMS;
+		}
+
+		target_desc.depth_stencil_array = tex->handle;
+	}
+
+	mrl_validation_object_t* obj;
+	mrl_error_t err = create_object(&rd->memory.framebuffer, MRL_OBJECT_FRAMEBUFFER, (void**)&obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.framebuffer, rd->target->create_framebuffer(rd->target, (mrl_framebuffer_t**)&obj->handle, &target_desc), obj, (void**)fb);
+	return err;
+}
+
+static void destroy_framebuffer(mrl_render_device_t* brd, mrl_framebuffer_t* fb)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, fb, MRL_OBJECT_FRAMEBUFFER, u8"Failed to destroy framebuffer: invalid framebuffer handle"))
+		return;
+	rd->target->destroy_framebuffer(rd->target, get_handle(fb));
+	destroy_object(&rd->memory.framebuffer, fb);
+}
+
+static void set_framebuffer(mrl_render_device_t* brd, mrl_framebuffer_t* fb)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_optional_object(rd, fb, MRL_OBJECT_FRAMEBUFFER, u8"Failed to set framebuffer: invalid framebuffer handle"))
+		return;
+	rd->target->set_framebuffer(rd->target, get_handle(fb));
+}
+
+// ---------- Raster states ----------
+
+static mrl_error_t create_raster_state(mrl_render_device_t* brd, mrl_raster_state_t** rs, const mrl_raster_state_desc_t* desc)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+
+	mrl_validation_object_t* obj;
+	mrl_error_t err = create_object(&rd->memory.raster_state, MRL_OBJECT_RASTER_STATE, (void**)&obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.raster_state, rd->target->create_raster_state(rd->target, (mrl_raster_state_t**)&obj->handle, desc), obj, (void**)rs);
+	return err;
+}
+
+static void destroy_raster_state(mrl_render_device_t* brd, mrl_raster_state_t* rs)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, rs, MRL_OBJECT_RASTER_STATE, u8"Failed to destroy raster state: invalid raster state handle"))
+		return;
+	rd->target->destroy_raster_state(rd->target, get_handle(rs));
+	destroy_object(&rd->memory.raster_state, rs);
+}
+
+static void set_raster_state(mrl_render_device_t* brd, mrl_raster_state_t* rs)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_optional_object(rd, rs, MRL_OBJECT_RASTER_STATE, u8"Failed to set raster state: invalid raster state handle"))
+		return;
+	rd->target->set_raster_state(rd->target, get_handle(rs));
+}
+
+// ---------- Depth stencil states ----------
+
+static mrl_error_t create_depth_stencil_state(mrl_render_device_t* brd, mrl_depth_stencil_state_t** dss, const mrl_depth_stencil_state_desc_t* desc)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+
+	mrl_validation_object_t* obj;
+	mrl_error_t err = create_object(&rd->memory.depth_stencil_state, MRL_OBJECT_DEPTH_STENCIL_STATE, (void**)&obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.depth_stencil_state, rd->target->create_depth_stencil_state(rd->target, (mrl_depth_stencil_state_t**)&obj->handle, desc), obj, (void**)dss);
+	return err;
+}
+
+static void destroy_depth_stencil_state(mrl_render_device_t* brd, mrl_depth_stencil_state_t* dss)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, dss, MRL_OBJECT_DEPTH_STENCIL_STATE, u8"Failed to destroy depth stencil state: invalid depth stencil state handle"))
+		return;
+	rd->target->destroy_depth_stencil_state(rd->target, get_handle(dss));
+	destroy_object(&rd->memory.depth_stencil_state, dss);
+}
+
+static void set_depth_stencil_state(mrl_render_device_t* brd, mrl_depth_stencil_state_t* dss)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_optional_object(rd, dss, MRL_OBJECT_DEPTH_STENCIL_STATE, u8"Failed to set depth stencil state: invalid depth stencil state handle"))
+		return;
+	rd->target->set_depth_stencil_state(rd->target, get_handle(dss));
+}
+
+// ---------- Blend states ----------
+
+static mrl_error_t create_blend_state(mrl_render_device_t* brd, mrl_blend_state_t** bs, const mrl_blend_state_desc_t* desc)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+
+	mrl_validation_object_t* obj;
+	mrl_error_t err = create_object(&rd->memory.blend_state, MRL_OBJECT_BLEND_STATE, (void**)&obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.blend_state, rd->target->create_blend_state(rd->target, (mrl_blend_state_t**)&obj->handle, desc), obj, (void**)bs);
+	return err;
+}
+
+static void destroy_blend_state(mrl_render_device_t* brd, mrl_blend_state_t* bs)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, bs, MRL_OBJECT_BLEND_STATE, u8"Failed to destroy blend state: invalid blend state handle"))
+		return;
+	rd->target->destroy_blend_state(rd->target, get_handle(bs));
+	destroy_object(&rd->memory.blend_state, bs);
+}
+
+static void set_blend_state(mrl_render_device_t* brd, mrl_blend_state_t* bs)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_optional_object(rd, bs, MRL_OBJECT_BLEND_STATE, u8"Failed to set blend state: invalid blend state handle"))
+		return;
+	rd->target->set_blend_state(rd->target, get_handle(bs));
+}
+
+// ---------- Binding points ----------
+
+// The target devices don't expose the types of their binding points, so each binding point takes the kind of the first resource used with it
+static mgl_bool_t check_binding_point(mrl_validation_render_device_t* rd, mrl_shader_binding_point_t* bp, mgl_enum_t kind, const mgl_chr8_t* invalid_msg, const mgl_chr8_t* kind_msg)
+{
+	if (!is_alive(bp, MRL_VALIDATION_BINDING_POINT))
+		return report(rd, invalid_msg);
+
+	mrl_validation_binding_point_t* obj = (mrl_validation_binding_point_t*)bp;
+	if (obj->kind == MRL_VALIDATION_BINDING_NONE || obj->kind == kind)
+	{
+		obj->kind = kind;
+		return MGL_TRUE;
+	}
+
+	// Samplers are bound to the same binding points as textures
+	if (kind == MRL_VALIDATION_BINDING_SAMPLER && obj->kind != MRL_VALIDATION_BINDING_CONSTANT_BUFFER)
+		return MGL_TRUE;
+	if (obj->kind == MRL_VALIDATION_BINDING_SAMPLER && kind != MRL_VALIDATION_BINDING_CONSTANT_BUFFER)
+	{
+		obj->kind = kind;
+		return MGL_TRUE;
+	}
+
+	return report(rd, kind_msg);
+}
+
+// ---------- Samplers ----------
+
+static mrl_error_t create_sampler(mrl_render_device_t* brd, mrl_sampler_t** s, const mrl_sampler_desc_t* desc)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+
+	if (desc->max_anisotropy < 1)
+	{
+		report(rd, u8"Failed to create sampler: max anisotropy must be at least 1");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	mrl_validation_object_t* obj;
+	mrl_error_t err = create_object(&rd->memory.sampler, MRL_OBJECT_SAMPLER, (void**)&obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.sampler, rd->target->create_sampler(rd->target, (mrl_sampler_t**)&obj->handle, desc), obj, (void**)s);
+	return err;
+}
+
+static void destroy_sampler(mrl_render_device_t* brd, mrl_sampler_t* s)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, s, MRL_OBJECT_SAMPLER, u8"Failed to destroy sampler: invalid sampler handle"))
+		return;
+	rd->target->destroy_sampler(rd->target, get_handle(s));
+	destroy_object(&rd->memory.sampler, s);
+}
+
+static void bind_sampler(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_sampler_t* s)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_optional_object(rd, s, MRL_OBJECT_SAMPLER, u8"Failed to bind sampler: invalid sampler handle") ||
+		!check_binding_point(rd, bp, MRL_VALIDATION_BINDING_SAMPLER, u8"Failed to bind sampler: invalid binding point", u8"Failed to bind sampler: the binding point is used for constant buffers"))
+		return;
+	rd->target->bind_sampler(rd->target, get_handle(bp), get_handle(s));
+}
+
+// ---------- Textures ----------
+
+static mgl_u64_t get_mip_size(mgl_u64_t size, mgl_u32_t level)
+{
+	size >>= level;
+	return size == 0 ? 1 : size;
+}
+
+static mgl_bool_t check_texture_desc(mrl_validation_render_device_t* rd, mgl_u32_t mip_level_count, mgl_u64_t width, mgl_u64_t height, mgl_u64_t depth, mgl_enum_t usage, mgl_enum_t format, mgl_bool_t allow_depth, mgl_bool_t allow_compressed)
+{
+	if (width == 0 || height == 0 || depth == 0)
+		return report(rd, u8"Failed to create texture: texture size must not be zero");
+
+	if (usage != MRL_TEXTURE_USAGE_DEFAULT && usage != MRL_TEXTURE_USAGE_RENDER_TARGET)
+		return report(rd, u8"Failed to create texture: invalid usage mode");
+
+	if (format > MRL_TEXTURE_FORMAT_ETC2_RGBA8_UN)
+		return report(rd, u8"Failed to create texture: invalid format");
+
+	if (!allow_depth && is_depth_format(format))
+		return report(rd, u8"Failed to create texture: depth/stencil formats are only supported by 2D textures");
+
+	if (mrl_is_compressed_format(format))
+	{
+		if (!allow_compressed)
+			return report(rd, u8"Failed to create texture: compressed formats are only supported by 2D textures and cube maps");
+		if (usage != MRL_TEXTURE_USAGE_DEFAULT)
+			return report(rd, u8"Failed to create texture: compressed textures can't be render targets");
+	}
+
+	// The smallest mip level is 1x1x1
+	mgl_u64_t max_size = width;
+	if (height > max_size)
+		max_size = height;
+	if (depth > max_size)
+		max_size = depth;
+	mgl_u32_t max_mip_level_count = 1;
+	while (max_size > 1)
+	{
+		max_size >>= 1;
+		++max_mip_level_count;
+	}
+
+	if (mip_level_count == 0 || mip_level_count > MRL_MAX_MIP_LEVEL_COUNT || mip_level_count > max_mip_level_count)
+		return report(rd, u8"Failed to create texture: mip level count out of range for the texture size");
+
+	return MGL_TRUE;
+}
+
+static mgl_bool_t check_texture_update(mrl_validation_render_device_t* rd, const mrl_validation_texture_t* tex, mgl_u32_t mip_level, mgl_u64_t x, mgl_u64_t y, mgl_u64_t z, mgl_u64_t width, mgl_u64_t height, mgl_u64_t depth, const void* data)
+{
+	if (data == NULL)
+		return report(rd, u8"Failed to update texture: data must not be NULL");
+
+	if (mip_level >= tex->mip_level_count)
+		return report(rd, u8"Failed to update texture: mip level out of range");
+
+	if (!is_range_valid(x, width, get_mip_size(tex->width, mip_level)) ||
+		!is_range_valid(y, height, get_mip_size(tex->height, mip_level)) ||
+		!is_range_valid(z, depth, get_mip_size(tex->depth, mip_level)))
+		return report(rd, u8"Failed to update texture: region out of the mip level bounds");
+
+	// Compressed textures are updated in whole blocks, except for the blocks cut by the mip level edges
+	if (mrl_is_compressed_format(tex->format) &&
+		(x % 4 != 0 || y % 4 != 0 ||
+		(width % 4 != 0 && x + width != get_mip_size(tex->width, mip_level)) ||
+		(height % 4 != 0 && y + height != get_mip_size(tex->height, mip_level))))
+		return report(rd, u8"Failed to update texture: compressed texture regions must be aligned to 4x4 blocks");
+
+	return MGL_TRUE;
+}
+
+// The target devices can't grow the storage of a texture, so generating mipmaps needs the whole chain allocated
+static mgl_bool_t check_mip_generation(mrl_validation_render_device_t* rd, const mrl_validation_texture_t* tex, const mgl_chr8_t* msg)
+{
+	if (tex->mip_level_count == 1 && (tex->width > 1 || tex->height > 1 || tex->depth > 1))
+		return report(rd, msg);
+	return MGL_TRUE;
+}
+
+static mrl_error_t create_texture(mrl_validation_render_device_t* rd, mrl_object_pool_t* pool, mgl_enum_t type, mgl_u32_t mip_level_count, mgl_u64_t width, mgl_u64_t height, mgl_u64_t depth, mgl_enum_t usage, mgl_enum_t format, mrl_validation_texture_t** out)
+{
+	mrl_error_t err = create_object(pool, type, (void**)out);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	(*out)->format = format;
+	(*out)->usage = usage;
+	(*out)->mip_level_count = mip_level_count;
+	(*out)->width = width;
+	(*out)->height = height;
+	(*out)->depth = depth;
+	(*out)->layer_count = 1;
+
+	return MRL_ERROR_NONE;
+}
+
+// ---------- 1D Textures ----------
+
+static mrl_error_t create_texture_1d(mrl_render_device_t* brd, mrl_texture_1d_t** tex, const mrl_texture_1d_desc_t* desc)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_texture_desc(rd, desc->mip_level_count, desc->width, 1, 1, desc->usage, desc->format, MGL_FALSE, MGL_FALSE))
+		return MRL_ERROR_INVALID_PARAMS;
+
+	mrl_validation_texture_t* obj;
+	mrl_error_t err = create_texture(rd, &rd->memory.texture_1d, MRL_OBJECT_TEXTURE_1D, desc->mip_level_count, desc->width, 1, 1, desc->usage, desc->format, &obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.texture_1d, rd->target->create_texture_1d(rd->target, (mrl_texture_1d_t**)&obj->handle, desc), obj, (void**)tex);
+	return err;
+}
+
+static void destroy_texture_1d(mrl_render_device_t* brd, mrl_texture_1d_t* tex)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, tex, MRL_OBJECT_TEXTURE_1D, u8"Failed to destroy texture 1D: invalid texture handle"))
+		return;
+	rd->target->destroy_texture_1d(rd->target, get_handle(tex));
+	destroy_object(&rd->memory.texture_1d, tex);
+}
+
+static void generate_texture_1d_mipmaps(mrl_render_device_t* brd, mrl_texture_1d_t* tex)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, tex, MRL_OBJECT_TEXTURE_1D, u8"Failed to generate texture 1D mipmaps: invalid texture handle") ||
+		!check_mip_generation(rd, (const mrl_validation_texture_t*)tex, u8"Failed to generate texture 1D mipmaps: the texture was created with a single mip level"))
+		return;
+	rd->target->generate_texture_1d_mipmaps(rd->target, get_handle(tex));
+}
+
+static void bind_texture_1d(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_texture_1d_t* tex)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_optional_object(rd, tex, MRL_OBJECT_TEXTURE_1D, u8"Failed to bind texture 1D: invalid texture handle") ||
+		!check_binding_point(rd, bp, MRL_VALIDATION_BINDING_TEXTURE_1D, u8"Failed to bind texture 1D: invalid binding point", u8"Failed to bind texture 1D: the binding point is used for another resource type"))
+		return;
+	rd->target->bind_texture_1d(rd->target, get_handle(bp), get_handle(tex));
+}
+
+static mrl_error_t update_texture_1d(mrl_render_device_t* brd, mrl_texture_1d_t* tex, const mrl_texture_1d_update_desc_t* desc)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, tex, MRL_OBJECT_TEXTURE_1D, u8"Failed to update texture 1D: invalid texture handle") ||
+		!check_texture_update(rd, (const mrl_validation_texture_t*)tex, desc->mip_level, desc->dst_x, 0, 0, desc->width, 1, 1, desc->data))
+		return MRL_ERROR_INVALID_PARAMS;
+	return rd->target->update_texture_1d(rd->target, get_handle(tex), desc);
+}
+
+// ---------- 2D Textures ----------
+
+static mrl_error_t create_texture_2d(mrl_render_device_t* brd, mrl_texture_2d_t** tex, const mrl_texture_2d_desc_t* desc)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_texture_desc(rd, desc->mip_level_count, desc->width, desc->height, 1, desc->usage, desc->format, MGL_TRUE, MGL_TRUE))
+		return MRL_ERROR_INVALID_PARAMS;
+
+	mrl_validation_texture_t* obj;
+	mrl_error_t err = create_texture(rd, &rd->memory.texture_2d, MRL_OBJECT_TEXTURE_2D, desc->mip_level_count, desc->width, desc->height, 1, desc->usage, desc->format, &obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.texture_2d, rd->target->create_texture_2d(rd->target, (mrl_texture_2d_t**)&obj->handle, desc), obj, (void**)tex);
+	return err;
+}
+
+static void destroy_texture_2d(mrl_render_device_t* brd, mrl_texture_2d_t* tex)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, tex, MRL_OBJECT_TEXTURE_2D, u8"Failed to destroy texture 2D: invalid texture handle"))
+		return;
+	rd->target->destroy_texture_2d(rd->target, get_handle(tex));
+	destroy_object(&rd->memory.texture_2d, tex);
+}
+
+static void generate_texture_2d_mipmaps(mrl_render_device_t* brd, mrl_texture_2d_t* tex)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, tex, MRL_OBJECT_TEXTURE_2D, u8"Failed to generate texture 2D mipmaps: invalid texture handle") ||
+		!check_mip_generation(rd, (const mrl_validation_texture_t*)tex, u8"Failed to generate texture 2D mipmaps: the texture was created with a single mip level"))
+		return;
+	if (is_depth_format(((const mrl_validation_texture_t*)tex)->format))
+	{
+		report(rd, u8"Failed to generate texture 2D mipmaps: mipmaps can't be generated for depth/stencil formats");
+		return;
+	}
+	if (mrl_is_compressed_format(((const mrl_validation_texture_t*)tex)->format))
+	{
+		report(rd, u8"Failed to generate texture 2D mipmaps: mipmaps can't be generated for compressed formats");
+		return;
+	}
+	rd->target->generate_texture_2d_mipmaps(rd->target, get_handle(tex));
+}
+
+static void bind_texture_2d(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_texture_2d_t* tex)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_optional_object(rd, tex, MRL_OBJECT_TEXTURE_2D, u8"Failed to bind texture 2D: invalid texture handle") ||
+		!check_binding_point(rd, bp, MRL_VALIDATION_BINDING_TEXTURE_2D, u8"Failed to bind texture 2D: invalid binding point", u8"Failed to bind texture 2D: the binding point is used for another resource type"))
+		return;
+	rd->target->bind_texture_2d(rd->target, get_handle(bp), get_handle(tex));
+}
+
+static mrl_error_t update_texture_2d(mrl_render_device_t* brd, mrl_texture_2d_t* tex, const mrl_texture_2d_update_desc_t* desc)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, tex, MRL_OBJECT_TEXTURE_2D, u8"Failed to update texture 2D: invalid texture handle") ||
+		!check_texture_update(rd, (const mrl_validation_texture_t*)tex, desc->mip_level, desc->dst_x, desc->dst_y, 0, desc->width, desc->height, 1, desc->data))
+		return MRL_ERROR_INVALID_PARAMS;
+	return rd->target->update_texture_2d(rd->target, get_handle(tex), desc);
+}
+
+// ---------- 3D Textures ----------
+
+static mrl_error_t create_texture_3d(mrl_render_device_t* brd, mrl_texture_3d_t** tex, const mrl_texture_3d_desc_t* desc)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_texture_desc(rd, desc->mip_level_count, desc->width, desc->height, desc->depth, desc->usage, desc->format, MGL_FALSE, MGL_FALSE))
+		return MRL_ERROR_INVALID_PARAMS;
+
+	mrl_validation_texture_t* obj;
+	mrl_error_t err = create_texture(rd, &rd->memory.texture_3d, MRL_OBJECT_TEXTURE_3D, desc->mip_level_count, desc->width, desc->height, desc->depth, desc->usage, desc->format, &obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.texture_3d, rd->target->create_texture_3d(rd->target, (mrl_texture_3d_t**)&obj->handle, desc), obj, (void**)tex);
+	return err;
+}
+
+static void destroy_texture_3d(mrl_render_device_t* brd, mrl_texture_3d_t* tex)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, tex, MRL_OBJECT_TEXTURE_3D, u8"Failed to destroy texture 3D: invalid texture handle"))
+		return;
+	rd->target->destroy_texture_3d(rd->target, get_handle(tex));
+	destroy_object(&rd->memory.texture_3d, tex);
+}
+
+static void generate_texture_3d_mipmaps(mrl_render_device_t* brd, mrl_texture_3d_t* tex)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, tex, MRL_OBJECT_TEXTURE_3D, u8"Failed to generate texture 3D mipmaps: invalid texture handle") ||
+		!check_mip_generation(rd, (const mrl_validation_texture_t*)tex, u8"Failed to generate texture 3D mipmaps: the texture was created with a single mip level"))
+		return;
+	rd->target->generate_texture_3d_mipmaps(rd->target, get_handle(tex));
+}
+
+static void bind_texture_3d(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_texture_3d_t* tex)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_optional_object(rd, tex, MRL_OBJECT_TEXTURE_3D, u8"Failed to bind texture 3D: invalid texture handle") ||
+		!check_binding_point(rd, bp, MRL_VALIDATION_BINDING_TEXTURE_3D, u8"Failed to bind texture 3D: invalid binding point", u8"Failed to bind texture 3D: the binding point is used for another resource type"))
+		return;
+	rd->target->bind_texture_3d(rd->target, get_handle(bp), get_handle(tex));
+}
+
+static mrl_error_t update_texture_3d(mrl_render_device_t* brd, mrl_texture_3d_t* tex, const mrl_texture_3d_update_desc_t* desc)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, tex, MRL_OBJECT_TEXTURE_3D, u8"Failed to update texture 3D: invalid texture handle") ||
+		!check_texture_update(rd, (const mrl_validation_texture_t*)tex, desc->mip_level, desc->dst_x, desc->dst_y, desc->dst_z, desc->width, desc->height, desc->depth, desc->data))
+		return MRL_ERROR_INVALID_PARAMS;
+	return rd->target->update_texture_3d(rd->target, get_handle(tex), desc);
+}
+
+// ---------- Cube maps ----------
+
+static mrl_error_t create_cube_map(mrl_render_device_t* brd, mrl_cube_map_t** cb, const mrl_cube_map_desc_t* desc)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_texture_desc(rd, desc->mip_level_count, desc->width, desc->height, 1, desc->usage, desc->format, MGL_FALSE, MGL_TRUE))
+		return MRL_ERROR_INVALID_PARAMS;
+
+	if (desc->width != desc->height)
+	{
+		report(rd, u8"Failed to create cube map: faces must be square");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	mrl_validation_texture_t* obj;
+	mrl_error_t err = create_texture(rd, &rd->memory.cube_map, MRL_OBJECT_CUBE_MAP, desc->mip_level_count, desc->width, desc->height, 1, desc->usage, desc->format, &obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.cube_map, rd->target->create_cube_map(rd->target, (mrl_cube_map_t**)&obj->handle, desc), obj, (void**)cb);
+	return err;
+}
+
+static void destroy_cube_map(mrl_render_device_t* brd, mrl_cube_map_t* cb)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, cb, MRL_OBJECT_CUBE_MAP, u8"Failed to destroy cube map: invalid cube map handle"))
+		return;
+	rd->target->destroy_cube_map(rd->target, get_handle(cb));
+	destroy_object(&rd->memory.cube_map, cb);
+}
+
+static void generate_cube_map_mipmaps(mrl_render_device_t* brd, mrl_cube_map_t* cb)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, cb, MRL_OBJECT_CUBE_MAP, u8"Failed to generate cube map mipmaps: invalid cube map handle") ||
+		!check_mip_generation(rd, (const mrl_validation_texture_t*)cb, u8"Failed to generate cube map mipmaps: the texture was created with a single mip level"))
+		return;
+	if (mrl_is_compressed_format(((const mrl_validation_texture_t*)cb)->format))
+	{
+		report(rd, u8"Failed to generate cube map mipmaps: mipmaps can't be generated for compressed formats");
+		return;
+	}
+	rd->target->generate_cube_map_mipmaps(rd->target, get_handle(cb));
+}
+
+static void bind_cube_map(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_cube_map_t* cb)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_optional_object(rd, cb, MRL_OBJECT_CUBE_MAP, u8"Failed to bind cube map: invalid cube map handle") ||
+		!check_binding_point(rd, bp, MRL_VALIDATION_BINDING_CUBE_MAP, u8"Failed to bind cube map: invalid binding point", u8"Failed to bind cube map: the binding point is used for another resource type"))
+		return;
+	rd->target->bind_cube_map(rd->target, get_handle(bp), get_handle(cb));
+}
+
+static mrl_error_t update_cube_map(mrl_render_device_t* brd, mrl_cube_map_t* cb, const mrl_cube_map_update_desc_t* desc)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, cb, MRL_OBJECT_CUBE_MAP, u8"Failed to update cube map: invalid cube map handle") ||
+		!check_texture_update(rd, (const mrl_validation_texture_t*)cb, desc->mip_level, desc->dst_x, desc->dst_y, 0, desc->width, desc->height, 1, desc->data))
+		return MRL_ERROR_INVALID_PARAMS;
+
+	if (desc->face > MRL_CUBE_MAP_FACE_NEGATIVE_Z)
+	{
+		report(rd, u8"Failed to update cube map: invalid face");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	return rd->target->update_cube_map(rd->target, get_handle(cb), desc);
+}
+
+// ---------- 2D Texture arrays ----------
+
+static mrl_error_t create_texture_2d_array(mrl_render_device_t* brd, mrl_texture_2d_array_t** tex, const mrl_texture_2d_array_desc_t* desc)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_texture_desc(rd, desc->mip_level_count, desc->width, desc->height, 1, desc->usage, desc->format, MGL_TRUE, MGL_TRUE))
+		return MRL_ERROR_INVALID_PARAMS;
+
+	if (desc->layer_count == 0 || desc->layer_count > MRL_MAX_TEXTURE_2D_ARRAY_LAYER_COUNT)
+	{
+		report(rd, u8"Failed to create texture 2D array: layer count must be between 1 and MRL_MAX_TEXTURE_2D_ARRAY_LAYER_COUNT");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	mrl_validation_texture_t* obj;
+	mrl_error_t err = create_texture(rd, &rd->memory.texture_2d_array, MRL_OBJECT_TEXTURE_2D_ARRAY, desc->mip_level_count, desc->width, desc->height, 1, desc->usage, desc->format, &obj);
+	if (err != MRL_ERROR_NONE)
+		return err;
+	obj->layer_count = desc->layer_count;
+	return finish_object(&rd->memory.texture_2d_array, rd->target->create_texture_2d_array(rd->target, (mrl_texture_2d_array_t**)&obj->handle, desc), obj, (void**)tex);
+}
+
+static void destroy_texture_2d_array(mrl_render_device_t* brd, mrl_texture_2d_array_t* tex)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, tex, MRL_OBJECT_TEXTURE_2D_ARRAY, u8"Failed to destroy texture 2D array: invalid texture handle"))
+		return;
+	rd->target->destroy_texture_2d_array(rd->target, get_handle(tex));
+	destroy_object(&rd->memory.texture_2d_array, tex);
+}
+
+static void generate_texture_2d_array_mipmaps(mrl_render_device_t* brd, mrl_texture_2d_array_t* tex)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, tex, MRL_OBJECT_TEXTURE_2D_ARRAY, u8"Failed to generate texture 2D array mipmaps: invalid texture handle") ||
+		!check_mip_generation(rd, (const mrl_validation_texture_t*)tex, u8"Failed to generate texture 2D array mipmaps: the texture was created with a single mip level"))
+		return;
+	if (is_depth_format(((const mrl_validation_texture_t*)tex)->format))
+	{
+		report(rd, u8"Failed to generate texture 2D array mipmaps: mipmaps can't be generated for depth/stencil formats");
+		return;
+	}
+	if (mrl_is_compressed_format(((const mrl_validation_texture_t*)tex)->format))
+	{
+		report(rd, u8"Failed to generate texture 2D array mipmaps: mipmaps can't be generated for compressed formats");
+		return;
+	}
+	rd->target->generate_texture_2d_array_mipmaps(rd->target, get_handle(tex));
+}
+
+static void bind_texture_2d_array(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_texture_2d_array_t* tex)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_optional_object(rd, tex, MRL_OBJECT_TEXTURE_2D_ARRAY, u8"Failed to bind texture 2D array: invalid texture handle") ||
+		!check_binding_point(rd, bp, MRL_VALIDATION_BINDING_TEXTURE_2D_ARRAY, u8"Failed to bind texture 2D array: invalid binding point", u8"Failed to bind texture 2D array: the binding point is used for another resource type"))
+		return;
+	rd->target->bind_texture_2d_array(rd->target, get_handle(bp), get_handle(tex));
+}
+
+static mrl_error_t update_texture_2d_array(mrl_render_device_t* brd, mrl_texture_2d_array_t* tex, const mrl_texture_2d_array_update_desc_t* desc)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, tex, MRL_OBJECT_TEXTURE_2D_ARRAY, u8"Failed to update texture 2D array: invalid texture handle") ||
+		!check_texture_update(rd, (const mrl_validation_texture_t*)tex, desc->mip_level, desc->dst_x, desc->dst_y, 0, desc->width, desc->height, 1, desc->data))
+		return MRL_ERROR_INVALID_PARAMS;
+
+	// Layers don't shrink with the mip level, so they are checked separately
+	if (desc->layer_count == 0 || !is_range_valid(desc->dst_layer, desc->layer_count, ((const mrl_validation_texture_t*)tex)->layer_count))
+	{
+		report(rd, u8"Failed to update texture 2D array: layer range out of bounds");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	return rd->target->update_texture_2d_array(rd->target, get_handle(tex), desc);
+}
+
+// ---------- Cube map arrays ----------
+
+static mrl_error_t create_cube_map_array(mrl_render_device_t* brd, mrl_cube_map_array_t** tex, const mrl_cube_map_array_desc_t* desc)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_texture_desc(rd, desc->mip_level_count, desc->width, desc->height, 1, desc->usage, desc->format, MGL_FALSE, MGL_TRUE))
+		return MRL_ERROR_INVALID_PARAMS;
+
+	if (desc->width != desc->height)
+	{
+		report(rd, u8"Failed to create cube map array: faces must be square");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	if (desc->usage != MRL_TEXTURE_USAGE_DEFAULT)
+	{
+		report(rd, u8"Failed to create cube map array: usage must be MRL_TEXTURE_USAGE_DEFAULT");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	if (desc->layer_count == 0 || desc->layer_count > MRL_MAX_CUBE_MAP_ARRAY_LAYER_COUNT)
+	{
+		report(rd, u8"Failed to create cube map array: layer count must be between 1 and MRL_MAX_CUBE_MAP_ARRAY_LAYER_COUNT");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	mrl_validation_texture_t* obj;
+	mrl_error_t err = create_texture(rd, &rd->memory.cube_map_array, MRL_OBJECT_CUBE_MAP_ARRAY, desc->mip_level_count, desc->width, desc->height, 1, desc->usage, desc->format, &obj);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	// Updates address faces, so the face count is stored instead of the cube count
+	obj->layer_count = desc->layer_count * 6;
+	return finish_object(&rd->memory.cube_map_array, rd->target->create_cube_map_array(rd->target, (mrl_cube_map_array_t**)&obj->handle, desc), obj, (void**)tex);
+}
+
+static void destroy_cube_map_array(mrl_render_device_t* brd, mrl_cube_map_array_t* tex)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, tex, MRL_OBJECT_CUBE_MAP_ARRAY, u8"Failed to destroy cube map array: invalid cube map array handle"))
+		return;
+	rd->target->destroy_cube_map_array(rd->target, get_handle(tex));
+	destroy_object(&rd->memory.cube_map_array, tex);
+}
+
+static void generate_cube_map_array_mipmaps(mrl_render_device_t* brd, mrl_cube_map_array_t* tex)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, tex, MRL_OBJECT_CUBE_MAP_ARRAY, u8"Failed to generate cube map array mipmaps: invalid cube map array handle") ||
+		!check_mip_generation(rd, (const mrl_validation_texture_t*)tex, u8"Failed to generate cube map array mipmaps: the texture was created with a single mip level"))
+		return;
+	if (mrl_is_compressed_format(((const mrl_validation_texture_t*)tex)->format))
+	{
+		report(rd, u8"Failed to generate cube map array mipmaps: mipmaps can't be generated for compressed formats");
+		return;
+	}
+	rd->target->generate_cube_map_array_mipmaps(rd->target, get_handle(tex));
+}
+
+static void bind_cube_map_array(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_cube_map_array_t* tex)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_optional_object(rd, tex, MRL_OBJECT_CUBE_MAP_ARRAY, u8"Failed to bind cube map array: invalid cube map array handle") ||
+		!check_binding_point(rd, bp, MRL_VALIDATION_BINDING_CUBE_MAP_ARRAY, u8"Failed to bind cube map array: invalid binding point", u8"Failed to bind cube map array: the binding point is used for another resource type"))
+		return;
+	rd->target->bind_cube_map_array(rd->target, get_handle(bp), get_handle(tex));
+}
+
+static mrl_error_t update_cube_map_array(mrl_render_device_t* brd, mrl_cube_map_array_t* tex, const mrl_cube_map_array_update_desc_t* desc)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, tex, MRL_OBJECT_CUBE_MAP_ARRAY, u8"Failed to update cube map array: invalid cube map array handle") ||
+		!check_texture_update(rd, (const mrl_validation_texture_t*)tex, desc->mip_level, desc->dst_x, desc->dst_y, 0, desc->width, desc->height, 1, desc->data))
+		return MRL_ERROR_INVALID_PARAMS;
+
+	if (desc->face_count == 0 || !is_range_valid(desc->dst_face, desc->face_count, ((const mrl_validation_texture_t*)tex)->layer_count))
+	{
+		report(rd, u8"Failed to update cube map array: face range out of bounds");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	return rd->target->update_cube_map_array(rd->target, get_handle(tex), desc);
+}
+
+// ---------- Buffers ----------
+
+// Every buffer type has the same usage modes
+static mgl_bool_t check_buffer_desc(mrl_validation_render_device_t* rd, mgl_u64_t size, mgl_enum_t usage, const void* data)
+{
+	if (size == 0)
+		return report(rd, u8"Failed to create buffer: size must not be zero");
+
+	if (usage > MRL_VERTEX_BUFFER_USAGE_STREAM)
+		return report(rd, u8"Failed to create buffer: invalid usage mode");
+
+	if (usage == MRL_VERTEX_BUFFER_USAGE_STATIC && data == NULL)
+		return report(rd, u8"Failed to create buffer: static buffers must be created with initial data");
+
+	return MGL_TRUE;
+}
+
+static mrl_error_t create_buffer(mrl_object_pool_t* pool, mgl_enum_t type, mgl_u64_t size, mgl_enum_t usage, mrl_validation_buffer_t** out)
+{
+	mrl_error_t err = create_object(pool, type, (void**)out);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	(*out)->usage = usage;
+	(*out)->size = size;
+	(*out)->mapped = MGL_FALSE;
+	(*out)->map_size = 0;
+	(*out)->map_flags = 0;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_buffer(mrl_validation_render_device_t* rd, mrl_object_pool_t* pool, mrl_validation_buffer_t* buf)
+{
+	if (buf->mapped)
+	{
+		warn(rd, u8"Buffer destroyed while mapped");
+		rd->state.mapped_buffer_count -= 1;
+	}
+
+	if (rd->state.index_buffer == buf)
+		rd->state.index_buffer = NULL;
+
+	destroy_object(pool, buf);
+}
+
+static mgl_bool_t check_map_buffer(mrl_validation_render_device_t* rd, const mrl_validation_buffer_t* buf, mgl_u64_t offset, mgl_u64_t size, mgl_u32_t flags)
+{
+	if (buf->mapped)
+		return report(rd, u8"Failed to map buffer: the buffer is already mapped");
+
+	if (buf->usage == MRL_VERTEX_BUFFER_USAGE_STATIC)
+		return report(rd, u8"Failed to map buffer: static buffers can't be mapped");
+
+	if (!is_range_valid(offset, size, buf->size))
+		return report(rd, u8"Failed to map buffer: range out of the buffer bounds");
+
+	if ((flags & (MRL_MAP_READ | MRL_MAP_WRITE)) == 0)
+		return report(rd, u8"Failed to map buffer: MRL_MAP_READ or MRL_MAP_WRITE must be set");
+
+	if ((flags & MRL_MAP_READ) && (flags & (MRL_MAP_DISCARD_RANGE | MRL_MAP_DISCARD_WHOLE)))
+		return report(rd, u8"Failed to map buffer: discarding can't be combined with MRL_MAP_READ");
+
+	if ((flags & MRL_MAP_READ) && (flags & MRL_MAP_NO_OVERWRITE))
+		return report(rd, u8"Failed to map buffer: MRL_MAP_NO_OVERWRITE can't be combined with MRL_MAP_READ");
+
+	if ((flags & MRL_MAP_FLUSH_EXPLICIT) && !(flags & MRL_MAP_WRITE))
+		return report(rd, u8"Failed to map buffer: MRL_MAP_FLUSH_EXPLICIT requires MRL_MAP_WRITE");
+
+	return MGL_TRUE;
+}
+
+static void* map_buffer(mrl_validation_render_device_t* rd, mrl_validation_buffer_t* buf, void* mapped, mgl_u64_t size, mgl_u32_t flags)
+{
+	if (mapped == NULL)
+		return NULL;
+
+	buf->mapped = MGL_TRUE;
+	buf->map_size = size;
+	buf->map_flags = flags;
+	rd->state.mapped_buffer_count += 1;
+	return mapped;
+}
+
+static mgl_bool_t check_unmap_buffer(mrl_validation_render_device_t* rd, mrl_validation_buffer_t* buf)
+{
+	if (!buf->mapped)
+		return report(rd, u8"Failed to unmap buffer: the buffer isn't mapped");
+
+	buf->mapped = MGL_FALSE;
+	rd->state.mapped_buffer_count -= 1;
+	return MGL_TRUE;
+}
+
+static mgl_bool_t check_flush_buffer(mrl_validation_render_device_t* rd, const mrl_validation_buffer_t* buf, mgl_u64_t offset, mgl_u64_t size)
+{
+	if (!buf->mapped || !(buf->map_flags & MRL_MAP_FLUSH_EXPLICIT))
+		return report(rd, u8"Failed to flush buffer range: the buffer isn't mapped with MRL_MAP_FLUSH_EXPLICIT");
+
+	// Flushed ranges are relative to the mapped range
+	if (!is_range_valid(offset, size, buf->map_size))
+		return report(rd, u8"Failed to flush buffer range: range out of the mapped range bounds");
+
+	return MGL_TRUE;
+}
+
+static mgl_bool_t check_update_buffer(mrl_validation_render_device_t* rd, const mrl_validation_buffer_t* buf, mgl_u64_t offset, mgl_u64_t size)
+{
+	if (buf->mapped)
+		return report(rd, u8"Failed to update buffer: the buffer is mapped");
+
+	if (buf->usage == MRL_VERTEX_BUFFER_USAGE_STATIC)
+		return report(rd, u8"Failed to update buffer: static buffers can't be updated");
+
+	if (!is_range_valid(offset, size, buf->size))
+		return report(rd, u8"Failed to update buffer: range out of the buffer bounds");
+
+	return MGL_TRUE;
+}
+
+// ---------- Constant buffers ----------
+
+static mrl_error_t create_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t** cb, const mrl_constant_buffer_desc_t* desc)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_buffer_desc(rd, desc->size, desc->usage, desc->data))
+		return MRL_ERROR_INVALID_PARAMS;
+
+	mrl_validation_buffer_t* obj;
+	mrl_error_t err = create_buffer(&rd->memory.constant_buffer, MRL_OBJECT_CONSTANT_BUFFER, desc->size, desc->usage, &obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.constant_buffer, rd->target->create_constant_buffer(rd->target, (mrl_constant_buffer_t**)&obj->handle, desc), obj, (void**)cb);
+	return err;
+}
+
+static void destroy_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t* cb)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, cb, MRL_OBJECT_CONSTANT_BUFFER, u8"Failed to destroy constant buffer: invalid constant buffer handle"))
+		return;
+	rd->target->destroy_constant_buffer(rd->target, get_handle(cb));
+	destroy_buffer(rd, &rd->memory.constant_buffer, (mrl_validation_buffer_t*)cb);
+}
+
+static void bind_constant_buffer(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_constant_buffer_t* cb)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_optional_object(rd, cb, MRL_OBJECT_CONSTANT_BUFFER, u8"Failed to bind constant buffer: invalid constant buffer handle") ||
+		!check_binding_point(rd, bp, MRL_VALIDATION_BINDING_CONSTANT_BUFFER, u8"Failed to bind constant buffer: invalid binding point", u8"Failed to bind constant buffer: the binding point is used for textures"))
+		return;
+	rd->target->bind_constant_buffer(rd->target, get_handle(bp), get_handle(cb));
+}
+
+static void bind_constant_buffer_range(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, cb, MRL_OBJECT_CONSTANT_BUFFER, u8"Failed to bind constant buffer range: invalid constant buffer handle") ||
+		!check_binding_point(rd, bp, MRL_VALIDATION_BINDING_CONSTANT_BUFFER, u8"Failed to bind constant buffer range: invalid binding point", u8"Failed to bind constant buffer range: the binding point is used for textures"))
+		return;
+
+	if (!is_range_valid(offset, size, ((const mrl_validation_buffer_t*)cb)->size))
+	{
+		report(rd, u8"Failed to bind constant buffer range: range out of the buffer bounds");
+		return;
+	}
+
+	if (offset % rd->limits.constant_buffer_offset_alignment != 0)
+	{
+		report(rd, u8"Failed to bind constant buffer range: offset isn't a multiple of MRL_PROPERTY_CONSTANT_BUFFER_OFFSET_ALIGNMENT");
+		return;
+	}
+
+	rd->target->bind_constant_buffer_range(rd->target, get_handle(bp), get_handle(cb), offset, size);
+}
+
+static void* map_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t* cb)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	mrl_validation_buffer_t* buf = (mrl_validation_buffer_t*)cb;
+	if (!check_object(rd, cb, MRL_OBJECT_CONSTANT_BUFFER, u8"Failed to map constant buffer: invalid constant buffer handle") ||
+		!check_map_buffer(rd, buf, 0, buf->size, MRL_MAP_READ | MRL_MAP_WRITE))
+		return NULL;
+	return map_buffer(rd, buf, rd->target->map_constant_buffer(rd->target, buf->handle), buf->size, MRL_MAP_READ | MRL_MAP_WRITE);
+}
+
+static void unmap_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t* cb)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, cb, MRL_OBJECT_CONSTANT_BUFFER, u8"Failed to unmap constant buffer: invalid constant buffer handle") ||
+		!check_unmap_buffer(rd, (mrl_validation_buffer_t*)cb))
+		return;
+	rd->target->unmap_constant_buffer(rd->target, get_handle(cb));
+}
+
+static void* map_constant_buffer_range(mrl_render_device_t* brd, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size, mgl_u32_t flags)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	mrl_validation_buffer_t* buf = (mrl_validation_buffer_t*)cb;
+	if (!check_object(rd, cb, MRL_OBJECT_CONSTANT_BUFFER, u8"Failed to map constant buffer range: invalid constant buffer handle") ||
+		!check_map_buffer(rd, buf, offset, size, flags))
+		return NULL;
+	return map_buffer(rd, buf, rd->target->map_constant_buffer_range(rd->target, buf->handle, offset, size, flags), size, flags);
+}
+
+static void flush_constant_buffer_range(mrl_render_device_t* brd, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, cb, MRL_OBJECT_CONSTANT_BUFFER, u8"Failed to flush constant buffer range: invalid constant buffer handle") ||
+		!check_flush_buffer(rd, (const mrl_validation_buffer_t*)cb, offset, size))
+		return;
+	rd->target->flush_constant_buffer_range(rd->target, get_handle(cb), offset, size);
+}
+
+static void update_constant_buffer(mrl_render_device_t* brd, mrl_constant_buffer_t* cb, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, cb, MRL_OBJECT_CONSTANT_BUFFER, u8"Failed to update constant buffer: invalid constant buffer handle") ||
+		!check_update_buffer(rd, (const mrl_validation_buffer_t*)cb, offset, size))
+		return;
+	rd->target->update_constant_buffer(rd->target, get_handle(cb), offset, size, data);
+}
+
+static void query_constant_buffer_structure(mrl_render_device_t* brd, mrl_shader_binding_point_t* bp, mrl_constant_buffer_structure_t* cbs)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_binding_point(rd, bp, MRL_VALIDATION_BINDING_CONSTANT_BUFFER, u8"Failed to query constant buffer structure: invalid binding point", u8"Failed to query constant buffer structure: the binding point is used for textures"))
+		return;
+	rd->target->query_constant_buffer_structure(rd->target, get_handle(bp), cbs);
+}
+
+// ---------- Index buffers ----------
+
+static mrl_error_t create_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t** ib, const mrl_index_buffer_desc_t* desc)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_buffer_desc(rd, desc->size, desc->usage, desc->data))
+		return MRL_ERROR_INVALID_PARAMS;
+
+	if (desc->format != MRL_INDEX_BUFFER_FORMAT_U16 && desc->format != MRL_INDEX_BUFFER_FORMAT_U32)
+	{
+		report(rd, u8"Failed to create index buffer: invalid format");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	mrl_validation_buffer_t* obj;
+	mrl_error_t err = create_buffer(&rd->memory.index_buffer, MRL_OBJECT_INDEX_BUFFER, desc->size, desc->usage, &obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.index_buffer, rd->target->create_index_buffer(rd->target, (mrl_index_buffer_t**)&obj->handle, desc), obj, (void**)ib);
+	return err;
+}
+
+static void destroy_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, ib, MRL_OBJECT_INDEX_BUFFER, u8"Failed to destroy index buffer: invalid index buffer handle"))
+		return;
+	rd->target->destroy_index_buffer(rd->target, get_handle(ib));
+	destroy_buffer(rd, &rd->memory.index_buffer, (mrl_validation_buffer_t*)ib);
+}
+
+static void set_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, ib, MRL_OBJECT_INDEX_BUFFER, u8"Failed to set index buffer: invalid index buffer handle"))
+		return;
+	rd->state.index_buffer = ib;
+	rd->target->set_index_buffer(rd->target, get_handle(ib));
+}
+
+static void* map_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	mrl_validation_buffer_t* buf = (mrl_validation_buffer_t*)ib;
+	if (!check_object(rd, ib, MRL_OBJECT_INDEX_BUFFER, u8"Failed to map index buffer: invalid index buffer handle") ||
+		!check_map_buffer(rd, buf, 0, buf->size, MRL_MAP_READ | MRL_MAP_WRITE))
+		return NULL;
+	return map_buffer(rd, buf, rd->target->map_index_buffer(rd->target, buf->handle), buf->size, MRL_MAP_READ | MRL_MAP_WRITE);
+}
+
+static void unmap_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, ib, MRL_OBJECT_INDEX_BUFFER, u8"Failed to unmap index buffer: invalid index buffer handle") ||
+		!check_unmap_buffer(rd, (mrl_validation_buffer_t*)ib))
+		return;
+	rd->target->unmap_index_buffer(rd->target, get_handle(ib));
+}
+
+static void* map_index_buffer_range(mrl_render_device_t* brd, mrl_index_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size, mgl_u32_t flags)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	mrl_validation_buffer_t* buf = (mrl_validation_buffer_t*)ib;
+	if (!check_object(rd, ib, MRL_OBJECT_INDEX_BUFFER, u8"Failed to map index buffer range: invalid index buffer handle") ||
+		!check_map_buffer(rd, buf, offset, size, flags))
+		return NULL;
+	return map_buffer(rd, buf, rd->target->map_index_buffer_range(rd->target, buf->handle, offset, size, flags), size, flags);
+}
+
+static void flush_index_buffer_range(mrl_render_device_t* brd, mrl_index_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, ib, MRL_OBJECT_INDEX_BUFFER, u8"Failed to flush index buffer range: invalid index buffer handle") ||
+		!check_flush_buffer(rd, (const mrl_validation_buffer_t*)ib, offset, size))
+		return;
+	rd->target->flush_index_buffer_range(rd->target, get_handle(ib), offset, size);
+}
+
+static void update_index_buffer(mrl_render_device_t* brd, mrl_index_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, ib, MRL_OBJECT_INDEX_BUFFER, u8"Failed to update index buffer: invalid index buffer handle") ||
+		!check_update_buffer(rd, (const mrl_validation_buffer_t*)ib, offset, size))
+		return;
+	rd->target->update_index_buffer(rd->target, get_handle(ib), offset, size, data);
+}
+
+// ---------- Indirect buffers ----------
+
+static mrl_error_t create_indirect_buffer(mrl_render_device_t* brd, mrl_indirect_buffer_t** ib, const mrl_indirect_buffer_desc_t* desc)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_buffer_desc(rd, desc->size, desc->usage, desc->data))
+		return MRL_ERROR_INVALID_PARAMS;
+
+	mrl_validation_buffer_t* obj;
+	mrl_error_t err = create_buffer(&rd->memory.indirect_buffer, MRL_OBJECT_INDIRECT_BUFFER, desc->size, desc->usage, &obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.indirect_buffer, rd->target->create_indirect_buffer(rd->target, (mrl_indirect_buffer_t**)&obj->handle, desc), obj, (void**)ib);
+	return err;
+}
+
+static void destroy_indirect_buffer(mrl_render_device_t* brd, mrl_indirect_buffer_t* ib)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, ib, MRL_OBJECT_INDIRECT_BUFFER, u8"Failed to destroy indirect buffer: invalid indirect buffer handle"))
+		return;
+	rd->target->destroy_indirect_buffer(rd->target, get_handle(ib));
+	destroy_buffer(rd, &rd->memory.indirect_buffer, (mrl_validation_buffer_t*)ib);
+}
+
+static void update_indirect_buffer(mrl_render_device_t* brd, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, ib, MRL_OBJECT_INDIRECT_BUFFER, u8"Failed to update indirect buffer: invalid indirect buffer handle") ||
+		!check_update_buffer(rd, (const mrl_validation_buffer_t*)ib, offset, size))
+		return;
+	rd->target->update_indirect_buffer(rd->target, get_handle(ib), offset, size, data);
+}
+
+// ---------- Vertex buffers ----------
+
+static mrl_error_t create_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t** vb, const mrl_vertex_buffer_desc_t* desc)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_buffer_desc(rd, desc->size, desc->usage, desc->data))
+		return MRL_ERROR_INVALID_PARAMS;
+
+	mrl_validation_buffer_t* obj;
+	mrl_error_t err = create_buffer(&rd->memory.vertex_buffer, MRL_OBJECT_VERTEX_BUFFER, desc->size, desc->usage, &obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.vertex_buffer, rd->target->create_vertex_buffer(rd->target, (mrl_vertex_buffer_t**)&obj->handle, desc), obj, (void**)vb);
+	return err;
+}
+
+static void destroy_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, vb, MRL_OBJECT_VERTEX_BUFFER, u8"Failed to destroy vertex buffer: invalid vertex buffer handle"))
+		return;
+	rd->target->destroy_vertex_buffer(rd->target, get_handle(vb));
+	destroy_buffer(rd, &rd->memory.vertex_buffer, (mrl_validation_buffer_t*)vb);
+}
+
+static void* map_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	mrl_validation_buffer_t* buf = (mrl_validation_buffer_t*)vb;
+	if (!check_object(rd, vb, MRL_OBJECT_VERTEX_BUFFER, u8"Failed to map vertex buffer: invalid vertex buffer handle") ||
+		!check_map_buffer(rd, buf, 0, buf->size, MRL_MAP_READ | MRL_MAP_WRITE))
+		return NULL;
+	return map_buffer(rd, buf, rd->target->map_vertex_buffer(rd->target, buf->handle), buf->size, MRL_MAP_READ | MRL_MAP_WRITE);
+}
+
+static void unmap_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, vb, MRL_OBJECT_VERTEX_BUFFER, u8"Failed to unmap vertex buffer: invalid vertex buffer handle") ||
+		!check_unmap_buffer(rd, (mrl_validation_buffer_t*)vb))
+		return;
+	rd->target->unmap_vertex_buffer(rd->target, get_handle(vb));
+}
+
+static void* map_vertex_buffer_range(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb, mgl_u64_t offset, mgl_u64_t size, mgl_u32_t flags)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	mrl_validation_buffer_t* buf = (mrl_validation_buffer_t*)vb;
+	if (!check_object(rd, vb, MRL_OBJECT_VERTEX_BUFFER, u8"Failed to map vertex buffer range: invalid vertex buffer handle") ||
+		!check_map_buffer(rd, buf, offset, size, flags))
+		return NULL;
+	return map_buffer(rd, buf, rd->target->map_vertex_buffer_range(rd->target, buf->handle, offset, size, flags), size, flags);
+}
+
+static void flush_vertex_buffer_range(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb, mgl_u64_t offset, mgl_u64_t size)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, vb, MRL_OBJECT_VERTEX_BUFFER, u8"Failed to flush vertex buffer range: invalid vertex buffer handle") ||
+		!check_flush_buffer(rd, (const mrl_validation_buffer_t*)vb, offset, size))
+		return;
+	rd->target->flush_vertex_buffer_range(rd->target, get_handle(vb), offset, size);
+}
+
+static void update_vertex_buffer(mrl_render_device_t* brd, mrl_vertex_buffer_t* vb, mgl_u64_t offset, mgl_u64_t size, const void* data)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, vb, MRL_OBJECT_VERTEX_BUFFER, u8"Failed to update vertex buffer: invalid vertex buffer handle") ||
+		!check_update_buffer(rd, (const mrl_validation_buffer_t*)vb, offset, size))
+		return;
+	rd->target->update_vertex_buffer(rd->target, get_handle(vb), offset, size, data);
+}
+
+// ---------- Vertex arrays ----------
+
+static mrl_error_t create_vertex_array(mrl_render_device_t* brd, mrl_vertex_array_t** va, const mrl_vertex_array_desc_t* desc)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+
+	if (desc->element_count > MRL_MAX_VERTEX_ARRAY_ELEMENT_COUNT || desc->buffer_count > MRL_MAX_VERTEX_ARRAY_BUFFER_COUNT)
+	{
+		report(rd, u8"Failed to create vertex array: too many elements or buffers");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	if (!check_object(rd, desc->shader_pipeline, MRL_OBJECT_SHADER_PIPELINE, u8"Failed to create vertex array: invalid shader pipeline handle"))
+		return MRL_ERROR_INVALID_PARAMS;
+
+	// Replace the validation handles with the target handles
+	mrl_vertex_array_desc_t target_desc = *desc;
+	for (mgl_u32_t i = 0; i < desc->buffer_count; ++i)
+	{
+		if (!check_object(rd, desc->buffers[i], MRL_OBJECT_VERTEX_BUFFER, u8"Failed to create vertex array: invalid vertex buffer handle"))
+			return MRL_ERROR_INVALID_PARAMS;
+		target_desc.buffers[i] = get_handle(desc->buffers[i]);
+	}
+	target_desc.shader_pipeline = get_handle(desc->shader_pipeline);
+
+	for (mgl_u32_t i = 0; i < desc->element_count; ++i)
+	{
+		if (desc->elements[i].type > MRL_VERTEX_ELEMENT_TYPE_F32)
+		{
+			report(rd, u8"Failed to create vertex array: invalid vertex element type");
+			return MRL_ERROR_INVALID_PARAMS;
+		}
+
+		if (desc->elements[i].size < 1 || desc->elements[i].size > 4)
+		{
+			report(rd, u8"Failed to create vertex array: vertex element size must be between 1 and 4");
+			return MRL_ERROR_INVALID_PARAMS;
+		}
+
+		if (desc->elements[i].buffer.index >= desc->buffer_count)
+		{
+			report(rd, u8"Failed to create vertex array: vertex element buffer index out of range");
+			return MRL_ERROR_INVALID_PARAMS;
+		}
+	}
+
+	mrl_validation_object_t* obj;
+	mrl_error_t err = create_object(&rd->memory.vertex_array, MRL_OBJECT_VERTEX_ARRAY, (void**)&obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.vertex_array, rd->target->create_vertex_array(rd->target, (mrl_vertex_array_t**)&obj->handle, &target_desc), obj, (void**)va);
+	return err;
+}
+
+static void destroy_vertex_array(mrl_render_device_t* brd, mrl_vertex_array_t* va)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, va, MRL_OBJECT_VERTEX_ARRAY, u8"Failed to destroy vertex array: invalid vertex array handle"))
+		return;
+	if (rd->state.vertex_array == va)
+		rd->state.vertex_array = NULL;
+	rd->target->destroy_vertex_array(rd->target, get_handle(va));
+	destroy_object(&rd->memory.vertex_array, va);
+}
+
+static void set_vertex_array(mrl_render_device_t* brd, mrl_vertex_array_t* va)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, va, MRL_OBJECT_VERTEX_ARRAY, u8"Failed to set vertex array: invalid vertex array handle"))
+		return;
+	rd->state.vertex_array = va;
+	rd->target->set_vertex_array(rd->target, get_handle(va));
+}
+
+// ---------- Stream allocators ----------
+
+static mrl_error_t create_stream_allocator(mrl_render_device_t* brd, mrl_stream_allocator_t** sa, const mrl_stream_allocator_desc_t* desc)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+
+	mgl_enum_t buffer_object;
+	switch (desc->buffer_type)
+	{
+		case MRL_STREAM_ALLOCATOR_BUFFER_VERTEX: buffer_object = MRL_OBJECT_VERTEX_BUFFER; break;
+		case MRL_STREAM_ALLOCATOR_BUFFER_INDEX: buffer_object = MRL_OBJECT_INDEX_BUFFER; break;
+		case MRL_STREAM_ALLOCATOR_BUFFER_CONSTANT: buffer_object = MRL_OBJECT_CONSTANT_BUFFER; break;
+		default:
+			report(rd, u8"Failed to create stream allocator: invalid buffer type");
+			return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	if (!check_object(rd, desc->buffer, buffer_object, u8"Failed to create stream allocator: invalid buffer handle or buffer type mismatch"))
+		return MRL_ERROR_INVALID_PARAMS;
+
+	mrl_stream_allocator_desc_t target_desc = *desc;
+	target_desc.buffer = get_handle(desc->buffer);
+
+	mrl_validation_stream_allocator_t* obj;
+	mrl_error_t err = create_object(&rd->memory.stream_allocator, MRL_OBJECT_STREAM_ALLOCATOR, (void**)&obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.stream_allocator, rd->target->create_stream_allocator(rd->target, (mrl_stream_allocator_t**)&obj->handle, &target_desc), obj, (void**)sa);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	obj->buffer = (mrl_validation_buffer_t*)desc->buffer;
+	obj->buffer_object = buffer_object;
+	obj->mapped = MGL_FALSE;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_stream_allocator(mrl_render_device_t* brd, mrl_stream_allocator_t* sa)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, sa, MRL_OBJECT_STREAM_ALLOCATOR, u8"Failed to destroy stream allocator: invalid stream allocator handle"))
+		return;
+	if (((const mrl_validation_stream_allocator_t*)sa)->mapped)
+		warn(rd, u8"Stream allocator destroyed while an allocation is mapped");
+	rd->target->destroy_stream_allocator(rd->target, get_handle(sa));
+	destroy_object(&rd->memory.stream_allocator, sa);
+}
+
+static void* map_stream_allocation(mrl_render_device_t* brd, mrl_stream_allocator_t* sa, mgl_u64_t size, mgl_u64_t alignment, mgl_u64_t* offset)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	mrl_validation_stream_allocator_t* obj = (mrl_validation_stream_allocator_t*)sa;
+	if (!check_object(rd, sa, MRL_OBJECT_STREAM_ALLOCATOR, u8"Failed to map stream allocation: invalid stream allocator handle"))
+		return NULL;
+
+	if (obj->mapped)
+	{
+		report(rd, u8"Failed to map stream allocation: the previous allocation is still mapped");
+		return NULL;
+	}
+
+	if ((alignment & (alignment - 1)) != 0)
+	{
+		report(rd, u8"Failed to map stream allocation: alignment must be a power of two");
+		return NULL;
+	}
+
+	if (!is_alive(obj->buffer, obj->buffer_object) || obj->buffer->mapped)
+	{
+		report(rd, u8"Failed to map stream allocation: the buffer was destroyed or is mapped");
+		return NULL;
+	}
+
+	void* data = rd->target->map_stream_allocation(rd->target, obj->handle, size, alignment, offset);
+	obj->mapped = data != NULL;
+	return data;
+}
+
+static void unmap_stream_allocation(mrl_render_device_t* brd, mrl_stream_allocator_t* sa)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	mrl_validation_stream_allocator_t* obj = (mrl_validation_stream_allocator_t*)sa;
+	if (!check_object(rd, sa, MRL_OBJECT_STREAM_ALLOCATOR, u8"Failed to unmap stream allocation: invalid stream allocator handle"))
+		return;
+
+	if (!obj->mapped)
+	{
+		report(rd, u8"Failed to unmap stream allocation: no allocation is mapped");
+		return;
+	}
+
+	obj->mapped = MGL_FALSE;
+	rd->target->unmap_stream_allocation(rd->target, obj->handle);
+}
+
+static void end_stream_allocator_frame(mrl_render_device_t* brd, mrl_stream_allocator_t* sa)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, sa, MRL_OBJECT_STREAM_ALLOCATOR, u8"Failed to end stream allocator frame: invalid stream allocator handle"))
+		return;
+
+	if (((const mrl_validation_stream_allocator_t*)sa)->mapped)
+	{
+		report(rd, u8"Failed to end stream allocator frame: an allocation is still mapped");
+		return;
+	}
+
+	rd->target->end_stream_allocator_frame(rd->target, get_handle(sa));
+}
+
+// ---------- Upload queues ----------
+
+static mrl_error_t create_upload_queue(mrl_render_device_t* brd, mrl_upload_queue_t** uq, const mrl_upload_queue_desc_t* desc)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+
+	mrl_validation_upload_queue_t* obj;
+	mrl_error_t err = create_object(&rd->memory.upload_queue, MRL_OBJECT_UPLOAD_QUEUE, (void**)&obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.upload_queue, rd->target->create_upload_queue(rd->target, (mrl_upload_queue_t**)&obj->handle, desc), obj, (void**)uq);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	obj->last_token = 0;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_upload_queue(mrl_render_device_t* brd, mrl_upload_queue_t* uq)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, uq, MRL_OBJECT_UPLOAD_QUEUE, u8"Failed to destroy upload queue: invalid upload queue handle"))
+		return;
+	rd->target->destroy_upload_queue(rd->target, get_handle(uq));
+	destroy_object(&rd->memory.upload_queue, uq);
+}
+
+// Remembers the last token returned, so that tokens which were never returned are detected
+static mrl_error_t finish_upload(mrl_upload_queue_t* uq, mrl_error_t err, mgl_u64_t* token)
+{
+	if (err == MRL_ERROR_NONE)
+		((mrl_validation_upload_queue_t*)uq)->last_token = *token;
+	return err;
+}
+
+static mrl_error_t upload_texture_1d(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mrl_texture_1d_t* tex, const mrl_texture_1d_update_desc_t* desc, mgl_u64_t* token)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, uq, MRL_OBJECT_UPLOAD_QUEUE, u8"Failed to upload texture 1D: invalid upload queue handle") ||
+		!check_object(rd, tex, MRL_OBJECT_TEXTURE_1D, u8"Failed to upload texture 1D: invalid texture handle") ||
+		!check_texture_update(rd, (const mrl_validation_texture_t*)tex, desc->mip_level, desc->dst_x, 0, 0, desc->width, 1, 1, desc->data))
+		return MRL_ERROR_INVALID_PARAMS;
+	return finish_upload(uq, rd->target->upload_texture_1d(rd->target, get_handle(uq), get_handle(tex), desc, token), token);
+}
+
+static mrl_error_t upload_texture_2d(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mrl_texture_2d_t* tex, const mrl_texture_2d_update_desc_t* desc, mgl_u64_t* token)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, uq, MRL_OBJECT_UPLOAD_QUEUE, u8"Failed to upload texture 2D: invalid upload queue handle") ||
+		!check_object(rd, tex, MRL_OBJECT_TEXTURE_2D, u8"Failed to upload texture 2D: invalid texture handle") ||
+		!check_texture_update(rd, (const mrl_validation_texture_t*)tex, desc->mip_level, desc->dst_x, desc->dst_y, 0, desc->width, desc->height, 1, desc->data))
+		return MRL_ERROR_INVALID_PARAMS;
+	return finish_upload(uq, rd->target->upload_texture_2d(rd->target, get_handle(uq), get_handle(tex), desc, token), token);
+}
+
+static mrl_error_t upload_texture_3d(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mrl_texture_3d_t* tex, const mrl_texture_3d_update_desc_t* desc, mgl_u64_t* token)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, uq, MRL_OBJECT_UPLOAD_QUEUE, u8"Failed to upload texture 3D: invalid upload queue handle") ||
+		!check_object(rd, tex, MRL_OBJECT_TEXTURE_3D, u8"Failed to upload texture 3D: invalid texture handle") ||
+		!check_texture_update(rd, (const mrl_validation_texture_t*)tex, desc->mip_level, desc->dst_x, desc->dst_y, desc->dst_z, desc->width, desc->height, desc->depth, desc->data))
+		return MRL_ERROR_INVALID_PARAMS;
+	return finish_upload(uq, rd->target->upload_texture_3d(rd->target, get_handle(uq), get_handle(tex), desc, token), token);
+}
+
+static mrl_error_t upload_cube_map(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mrl_cube_map_t* cb, const mrl_cube_map_update_desc_t* desc, mgl_u64_t* token)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, uq, MRL_OBJECT_UPLOAD_QUEUE, u8"Failed to upload cube map: invalid upload queue handle") ||
+		!check_object(rd, cb, MRL_OBJECT_CUBE_MAP, u8"Failed to upload cube map: invalid cube map handle") ||
+		!check_texture_update(rd, (const mrl_validation_texture_t*)cb, desc->mip_level, desc->dst_x, desc->dst_y, 0, desc->width, desc->height, 1, desc->data))
+		return MRL_ERROR_INVALID_PARAMS;
+
+	if (desc->face > MRL_CUBE_MAP_FACE_NEGATIVE_Z)
+	{
+		report(rd, u8"Failed to upload cube map: invalid face");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	return finish_upload(uq, rd->target->upload_cube_map(rd->target, get_handle(uq), get_handle(cb), desc, token), token);
+}
+
+static mgl_bool_t check_upload_token(mrl_validation_render_device_t* rd, mrl_upload_queue_t* uq, mgl_u64_t token, const mgl_chr8_t* msg)
+{
+	if (token > ((const mrl_validation_upload_queue_t*)uq)->last_token)
+		return report(rd, msg);
+	return MGL_TRUE;
+}
+
+static mgl_bool_t is_upload_complete(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mgl_u64_t token)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, uq, MRL_OBJECT_UPLOAD_QUEUE, u8"Failed to check upload: invalid upload queue handle") ||
+		!check_upload_token(rd, uq, token, u8"Failed to check upload: the token wasn't returned by this upload queue"))
+		return MGL_FALSE;
+	return rd->target->is_upload_complete(rd->target, get_handle(uq), token);
+}
+
+static void wait_upload(mrl_render_device_t* brd, mrl_upload_queue_t* uq, mgl_u64_t token)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, uq, MRL_OBJECT_UPLOAD_QUEUE, u8"Failed to wait upload: invalid upload queue handle") ||
+		!check_upload_token(rd, uq, token, u8"Failed to wait upload: the token wasn't returned by this upload queue"))
+		return;
+	rd->target->wait_upload(rd->target, get_handle(uq), token);
+}
+
+// ---------- Shaders ----------
+
+static mrl_error_t create_shader_stage(mrl_render_device_t* brd, mrl_shader_stage_t** stage, const mrl_shader_stage_desc_t* desc)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+
+	if (desc->stage != MRL_SHADER_STAGE_VERTEX && desc->stage != MRL_SHADER_STAGE_PIXEL)
+	{
+		report(rd, u8"Failed to create shader stage: invalid stage");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	if (desc->src == NULL)
+	{
+		report(rd, u8"Failed to create shader stage: source must not be NULL");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	mrl_validation_shader_stage_t* obj;
+	mrl_error_t err = create_object(&rd->memory.shader_stage, MRL_OBJECT_SHADER_STAGE, (void**)&obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.shader_stage, rd->target->create_shader_stage(rd->target, (mrl_shader_stage_t**)&obj->handle, desc), obj, (void**)stage);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	obj->stage = desc->stage;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_shader_stage(mrl_render_device_t* brd, mrl_shader_stage_t* stage)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, stage, MRL_OBJECT_SHADER_STAGE, u8"Failed to destroy shader stage: invalid shader stage handle"))
+		return;
+	rd->target->destroy_shader_stage(rd->target, get_handle(stage));
+	destroy_object(&rd->memory.shader_stage, stage);
+}
+
+static mrl_error_t create_shader_pipeline(mrl_render_device_t* brd, mrl_shader_pipeline_t** pipeline, const mrl_shader_pipeline_desc_t* desc)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+
+	if (!check_object(rd, desc->vertex, MRL_OBJECT_SHADER_STAGE, u8"Failed to create shader pipeline: invalid vertex shader stage handle") ||
+		!check_object(rd, desc->pixel, MRL_OBJECT_SHADER_STAGE, u8"Failed to create shader pipeline: invalid pixel shader stage handle"))
+		return MRL_ERROR_INVALID_PARAMS;
+
+	if (((const mrl_validation_shader_stage_t*)desc->vertex)->stage != MRL_SHADER_STAGE_VERTEX ||
+		((const mrl_validation_shader_stage_t*)desc->pixel)->stage != MRL_SHADER_STAGE_PIXEL)
+	{
+		report(rd, u8"Failed to create shader pipeline: the stages don't match their slots");
+		return MRL_ERROR_INVALID_PARAMS;
+	}
+
+	mrl_shader_pipeline_desc_t target_desc = *desc;
+	target_desc.vertex = get_handle(desc->vertex);
+	target_desc.pixel = get_handle(desc->pixel);
+
+	mrl_validation_shader_pipeline_t* obj;
+	mrl_error_t err = create_object(&rd->memory.shader_pipeline, MRL_OBJECT_SHADER_PIPELINE, (void**)&obj);
+	if (err == MRL_ERROR_NONE)
+		err = finish_object(&rd->memory.shader_pipeline, rd->target->create_shader_pipeline(rd->target, (mrl_shader_pipeline_t**)&obj->handle, &target_desc), obj, (void**)pipeline);
+	if (err != MRL_ERROR_NONE)
+		return err;
+
+	// Binding points are added as they are queried
+	obj->bps = NULL;
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_shader_pipeline(mrl_render_device_t* brd, mrl_shader_pipeline_t* pipeline)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, pipeline, MRL_OBJECT_SHADER_PIPELINE, u8"Failed to destroy shader pipeline: invalid shader pipeline handle"))
+		return;
+
+	// The binding points die with the pipeline
+	mrl_validation_shader_pipeline_t* pp = (mrl_validation_shader_pipeline_t*)pipeline;
+	mrl_validation_binding_point_t* bp = pp->bps;
+	while (bp != NULL)
+	{
+		mrl_validation_binding_point_t* next = bp->next;
+		destroy_object(&rd->memory.binding_point, bp);
+		bp = next;
+	}
+
+	if (rd->state.shader_pipeline == pp)
+		rd->state.shader_pipeline = NULL;
+
+	rd->target->destroy_shader_pipeline(rd->target, pp->handle);
+	destroy_object(&rd->memory.shader_pipeline, pp);
+}
+
+static void set_shader_pipeline(mrl_render_device_t* brd, mrl_shader_pipeline_t* pipeline)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, pipeline, MRL_OBJECT_SHADER_PIPELINE, u8"Failed to set shader pipeline: invalid shader pipeline handle"))
+		return;
+	rd->state.shader_pipeline = pipeline;
+	rd->target->set_shader_pipeline(rd->target, get_handle(pipeline));
+}
+
+static mrl_validation_binding_point_t* wrap_binding_point(mrl_validation_render_device_t* rd, mrl_validation_shader_pipeline_t* pp, void* handle)
+{
+	if (handle == NULL)
+		return NULL;
+
+	for (mrl_validation_binding_point_t* bp = pp->bps; bp != NULL; bp = bp->next)
+		if (bp->handle == handle)
+			return bp;
+
+	mrl_validation_binding_point_t* bp;
+	mgl_error_t err = mrl_allocate_object(&rd->memory.binding_point, (void**)&bp);
+	if (err != MGL_ERROR_NONE)
+	{
+		if (rd->error_callback != NULL)
+			rd->error_callback(mrl_make_mgl_error(err), u8"Failed to get shader binding point: failed to allocate binding point");
+		return NULL;
+	}
+
+	bp->handle = handle;
+	bp->tag = make_tag(MRL_VALIDATION_BINDING_POINT);
+	bp->kind = MRL_VALIDATION_BINDING_NONE;
+	bp->next = pp->bps;
+	pp->bps = bp;
+	return bp;
+}
+
+static mrl_shader_binding_point_t* get_shader_binding_point(mrl_render_device_t* brd, mrl_shader_pipeline_t* pipeline, const mgl_chr8_t* name)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, pipeline, MRL_OBJECT_SHADER_PIPELINE, u8"Failed to get shader binding point: invalid shader pipeline handle"))
+		return NULL;
+	mrl_validation_shader_pipeline_t* pp = (mrl_validation_shader_pipeline_t*)pipeline;
+	return (mrl_shader_binding_point_t*)wrap_binding_point(rd, pp, rd->target->get_shader_binding_point(rd->target, pp->handle, name));
+}
+
+static mrl_shader_binding_point_t* get_shader_binding_point_by_id(mrl_render_device_t* brd, mrl_shader_pipeline_t* pipeline, mgl_u64_t id)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_object(rd, pipeline, MRL_OBJECT_SHADER_PIPELINE, u8"Failed to get shader binding point: invalid shader pipeline handle"))
+		return NULL;
+	mrl_validation_shader_pipeline_t* pp = (mrl_validation_shader_pipeline_t*)pipeline;
+	return (mrl_shader_binding_point_t*)wrap_binding_point(rd, pp, rd->target->get_shader_binding_point_by_id(rd->target, pp->handle, id));
+}
+
+// ---------- Draw functions ----------
+
+static mgl_bool_t check_draw(mrl_validation_render_device_t* rd, mgl_bool_t indexed)
+{
+	if (rd->state.shader_pipeline == NULL)
+		return report(rd, u8"Failed to draw: no shader pipeline is set");
+
+	if (rd->state.vertex_array == NULL)
+		return report(rd, u8"Failed to draw: no vertex array is set");
+
+	if (indexed && rd->state.index_buffer == NULL)
+		return report(rd, u8"Failed to draw: no index buffer is set");
+
+	// Drawing from a mapped buffer is an error, but it isn't known which buffers the draw reads
+	if (rd->state.mapped_buffer_count > 0)
+		warn(rd, u8"Drawing while a buffer is mapped");
+
+	return MGL_TRUE;
+}
+
+static mgl_bool_t check_indirect_draw(mrl_validation_render_device_t* rd, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t draw_count, mgl_u64_t stride, mgl_bool_t indexed)
+{
+	if (!check_object(rd, ib, MRL_OBJECT_INDIRECT_BUFFER, u8"Failed to draw: invalid indirect buffer handle"))
+		return MGL_FALSE;
+
+	if (offset % 4 != 0)
+		return report(rd, u8"Failed to draw: the indirect buffer offset must be a multiple of 4");
+
+	const mrl_validation_buffer_t* buf = (const mrl_validation_buffer_t*)ib;
+	if (offset > buf->size || draw_count > (buf->size - offset) / stride)
+		return report(rd, u8"Failed to draw: indirect arguments out of the buffer bounds");
+
+	return check_draw(rd, indexed);
+}
+
+static void clear_color(mrl_render_device_t* brd, mgl_f32_t r, mgl_f32_t g, mgl_f32_t b, mgl_f32_t a)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	rd->target->clear_color(rd->target, r, g, b, a);
+}
+
+static void clear_depth(mrl_render_device_t* brd, mgl_f32_t depth)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	rd->target->clear_depth(rd->target, depth);
+}
+
+static void clear_stencil(mrl_render_device_t* brd, mgl_i32_t stencil)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	rd->target->clear_stencil(rd->target, stencil);
+}
+
+static void swap_buffers(mrl_render_device_t* brd)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	rd->target->swap_buffers(rd->target);
+}
+
+static void draw_triangles(mrl_render_device_t* brd, mgl_u64_t offset, mgl_u64_t count)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_draw(rd, MGL_FALSE))
+		return;
+	rd->target->draw_triangles(rd->target, offset, count);
+}
+
+static void draw_triangles_indexed(mrl_render_device_t* brd, mgl_u64_t offset, mgl_u64_t count)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_draw(rd, MGL_TRUE))
+		return;
+	rd->target->draw_triangles_indexed(rd->target, offset, count);
+}
+
+static void draw_triangles_instanced(mrl_render_device_t* brd, mgl_u64_t offset, mgl_u64_t count, mgl_u64_t instance_count)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_draw(rd, MGL_FALSE))
+		return;
+	rd->target->draw_triangles_instanced(rd->target, offset, count, instance_count);
+}
+
+static void draw_triangles_indexed_instanced(mrl_render_device_t* brd, mgl_u64_t offset, mgl_u64_t count, mgl_u64_t instance_count)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_draw(rd, MGL_TRUE))
+		return;
+	rd->target->draw_triangles_indexed_instanced(rd->target, offset, count, instance_count);
+}
+
+static void draw_triangles_indexed_base_vertex(mrl_render_device_t* brd, mgl_u64_t offset, mgl_u64_t count, mgl_i64_t base_vertex)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_draw(rd, MGL_TRUE))
+		return;
+	rd->target->draw_triangles_indexed_base_vertex(rd->target, offset, count, base_vertex);
+}
+
+static void draw_triangles_indexed_instanced_base_vertex(mrl_render_device_t* brd, mgl_u64_t offset, mgl_u64_t count, mgl_u64_t instance_count, mgl_i64_t base_vertex)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_draw(rd, MGL_TRUE))
+		return;
+	rd->target->draw_triangles_indexed_instanced_base_vertex(rd->target, offset, count, instance_count, base_vertex);
+}
+
+static void multi_draw_triangles(mrl_render_device_t* brd, const mgl_u64_t* offsets, const mgl_u64_t* counts, mgl_u64_t draw_count)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_draw(rd, MGL_FALSE))
+		return;
+	rd->target->multi_draw_triangles(rd->target, offsets, counts, draw_count);
+}
+
+static void multi_draw_triangles_indexed(mrl_render_device_t* brd, const mgl_u64_t* offsets, const mgl_u64_t* counts, const mgl_i64_t* base_vertices, mgl_u64_t draw_count)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_draw(rd, MGL_TRUE))
+		return;
+	rd->target->multi_draw_triangles_indexed(rd->target, offsets, counts, base_vertices, draw_count);
+}
+
+static void draw_triangles_indirect(mrl_render_device_t* brd, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t draw_count)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_indirect_draw(rd, ib, offset, draw_count, sizeof(mrl_draw_indirect_args_t), MGL_FALSE))
+		return;
+	rd->target->draw_triangles_indirect(rd->target, get_handle(ib), offset, draw_count);
+}
+
+static void draw_triangles_indexed_indirect(mrl_render_device_t* brd, mrl_indirect_buffer_t* ib, mgl_u64_t offset, mgl_u64_t draw_count)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (!check_indirect_draw(rd, ib, offset, draw_count, sizeof(mrl_draw_indexed_indirect_args_t), MGL_TRUE))
+		return;
+	rd->target->draw_triangles_indexed_indirect(rd->target, get_handle(ib), offset, draw_count);
+}
+
+static void set_viewport(mrl_render_device_t* brd, mgl_i32_t x, mgl_i32_t y, mgl_i32_t w, mgl_i32_t h)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	if (w < 0 || h < 0)
+	{
+		report(rd, u8"Failed to set viewport: size must not be negative");
+		return;
+	}
+	rd->target->set_viewport(rd->target, x, y, w, h);
+}
+
+// ---------- Getter functions ----------
+
+// The validation device is transparent, so the application takes the same code paths as with the target device
+static const mgl_chr8_t* get_type_name(mrl_render_device_t* brd)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	return rd->target->get_type_name(rd->target);
+}
+
+static mgl_i64_t get_property_i(mrl_render_device_t* brd, mgl_enum_t name)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	return rd->target->get_property_i(rd->target, name);
+}
+
+static mgl_f64_t get_property_f(mrl_render_device_t* brd, mgl_enum_t name)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	return rd->target->get_property_f(rd->target, name);
+}
+
+static void get_object_pool_stats(mrl_render_device_t* brd, mgl_enum_t type, mrl_object_pool_stats_t* stats)
+{
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+	rd->target->get_object_pool_stats(rd->target, type, stats);
+}
+
+static mrl_object_pool_t* get_rd_pool(mrl_validation_render_device_t* rd, mgl_enum_t type)
+{
+	switch (type)
+	{
+		case MRL_OBJECT_FRAMEBUFFER: return &rd->memory.framebuffer;
+		case MRL_OBJECT_RASTER_STATE: return &rd->memory.raster_state;
+		case MRL_OBJECT_DEPTH_STENCIL_STATE: return &rd->memory.depth_stencil_state;
+		case MRL_OBJECT_BLEND_STATE: return &rd->memory.blend_state;
+		case MRL_OBJECT_SAMPLER: return &rd->memory.sampler;
+		case MRL_OBJECT_TEXTURE_1D: return &rd->memory.texture_1d;
+		case MRL_OBJECT_TEXTURE_2D: return &rd->memory.texture_2d;
+		case MRL_OBJECT_TEXTURE_3D: return &rd->memory.texture_3d;
+		case MRL_OBJECT_CUBE_MAP: return &rd->memory.cube_map;
+		case MRL_OBJECT_CONSTANT_BUFFER: return &rd->memory.constant_buffer;
+		case MRL_OBJECT_INDEX_BUFFER: return &rd->memory.index_buffer;
+		case MRL_OBJECT_VERTEX_BUFFER: return &rd->memory.vertex_buffer;
+		case MRL_OBJECT_VERTEX_ARRAY: return &rd->memory.vertex_array;
+		case MRL_OBJECT_SHADER_STAGE: return &rd->memory.shader_stage;
+		case MRL_OBJECT_SHADER_PIPELINE: return &rd->memory.shader_pipeline;
+		case MRL_OBJECT_STREAM_ALLOCATOR: return &rd->memory.stream_allocator;
+		case MRL_OBJECT_INDIRECT_BUFFER: return &rd->memory.indirect_buffer;
+		case MRL_OBJECT_UPLOAD_QUEUE: return &rd->memory.upload_queue;
+		case MRL_OBJECT_TEXTURE_2D_ARRAY: return &rd->memory.texture_2d_array;
+		case MRL_OBJECT_CUBE_MAP_ARRAY: return &rd->memory.cube_map_array;
+		default: return NULL;
+	}
+}
+
+static mrl_error_t create_rd_allocators(mrl_validation_render_device_t* rd, const mrl_render_device_desc_t* desc)
+{
+	// Object size and number of objects reserved up front, by object type
+	const mgl_u64_t sizes[MRL_VALIDATION_OBJECT_POOL_COUNT][2] = {
+		{ sizeof(mrl_validation_object_t), desc->max_framebuffer_count },
+		{ sizeof(mrl_validation_object_t), desc->max_raster_state_count },
+		{ sizeof(mrl_validation_object_t), desc->max_depth_stencil_state_count },
+		{ sizeof(mrl_validation_object_t), desc->max_blend_state_count },
+		{ sizeof(mrl_validation_object_t), desc->max_sampler_count },
+		{ sizeof(mrl_validation_texture_t), desc->max_texture_1d_count },
+		{ sizeof(mrl_validation_texture_t), desc->max_texture_2d_count },
+		{ sizeof(mrl_validation_texture_t), desc->max_texture_3d_count },
+		{ sizeof(mrl_validation_texture_t), desc->max_cube_map_count },
+		{ sizeof(mrl_validation_buffer_t), desc->max_constant_buffer_count },
+		{ sizeof(mrl_validation_buffer_t), desc->max_index_buffer_count },
+		{ sizeof(mrl_validation_buffer_t), desc->max_vertex_buffer_count },
+		{ sizeof(mrl_validation_object_t), desc->max_vertex_array_count },
+		{ sizeof(mrl_validation_shader_stage_t), desc->max_shader_stage_count },
+		{ sizeof(mrl_validation_shader_pipeline_t), desc->max_shader_pipeline_count },
+		{ sizeof(mrl_validation_stream_allocator_t), desc->max_stream_allocator_count },
+		{ sizeof(mrl_validation_buffer_t), desc->max_indirect_buffer_count },
+		{ sizeof(mrl_validation_upload_queue_t), desc->max_upload_queue_count },
+		{ sizeof(mrl_validation_texture_t), desc->max_texture_2d_array_count },
+		{ sizeof(mrl_validation_texture_t), desc->max_cube_map_array_count },
+	};
+
+	// Create object pools
+	for (mgl_enum_t i = 0; i < MRL_VALIDATION_OBJECT_POOL_COUNT; ++i)
+	{
+		mgl_error_t err = mrl_init_object_pool(get_rd_pool(rd, i), rd->allocator, sizes[i][0], sizes[i][1]);
+		if (err != MGL_ERROR_NONE)
+		{
+			while (i-- > 0)
+				mrl_terminate_object_pool(get_rd_pool(rd, i));
+			return mrl_make_mgl_error(err);
+		}
+	}
+
+	// Nothing is reserved for binding points, so initializing their pool can't fail
+	mrl_init_object_pool(&rd->memory.binding_point, rd->allocator, sizeof(mrl_validation_binding_point_t), 0);
+
+	return MRL_ERROR_NONE;
+}
+
+static void destroy_rd_allocators(mrl_validation_render_device_t* rd)
+{
+	for (mgl_enum_t i = 0; i < MRL_VALIDATION_OBJECT_POOL_COUNT; ++i)
+		mrl_terminate_object_pool(get_rd_pool(rd, i));
+	mrl_terminate_object_pool(&rd->memory.binding_point);
+}
+
+static void set_rd_functions(mrl_validation_render_device_t* rd)
+{
+	// Framebuffer functions
+	rd->base.create_framebuffer = &create_framebuffer;
+	rd->base.destroy_framebuffer = &destroy_framebuffer;
+	rd->base.set_framebuffer = &set_framebuffer;
+
+	// Raster state functions
+	rd->base.create_raster_state = &create_raster_state;
+	rd->base.destroy_raster_state = &destroy_raster_state;
+	rd->base.set_raster_state = &set_raster_state;
+
+	// Depth stencil state functions
+	rd->base.create_depth_stencil_state = &create_depth_stencil_state;
+	rd->base.destroy_depth_stencil_state = &destroy_depth_stencil_state;
+	rd->base.set_depth_stencil_state = &set_depth_stencil_state;
+
+	// Blend state functions
+	rd->base.create_blend_state = &create_blend_state;
+	rd->base.destroy_blend_state = &destroy_blend_state;
+	rd->base.set_blend_state = &set_blend_state;
+
+	// Sampler functions
+	rd->base.create_sampler = &create_sampler;
+	rd->base.destroy_sampler = &destroy_sampler;
+	rd->base.bind_sampler = &bind_sampler;
+
+	// Texture 1D functions
+	rd->base.create_texture_1d = &create_texture_1d;
+	rd->base.destroy_texture_1d = &destroy_texture_1d;
+	rd->base.generate_texture_1d_mipmaps = &generate_texture_1d_mipmaps;
+	rd->base.bind_texture_1d = &bind_texture_1d;
+	rd->base.update_texture_1d = &update_texture_1d;
+
+	// Texture 2D functions
+	rd->base.create_texture_2d = &create_texture_2d;
+	rd->base.destroy_texture_2d = &destroy_texture_2d;
+	rd->base.generate_texture_2d_mipmaps = &generate_texture_2d_mipmaps;
+	rd->base.bind_texture_2d = &bind_texture_2d;
+	rd->base.update_texture_2d = &update_texture_2d;
+
+	// Texture 3D functions
+	rd->base.create_texture_3d = &create_texture_3d;
+	rd->base.destroy_texture_3d = &destroy_texture_3d;
+	rd->base.generate_texture_3d_mipmaps = &generate_texture_3d_mipmaps;
+	rd->base.bind_texture_3d = &bind_texture_3d;
+	rd->base.update_texture_3d = &update_texture_3d;
+
+	// Cube map functions
+	rd->base.create_cube_map = &create_cube_map;
+	rd->base.destroy_cube_map = &destroy_cube_map;
+	rd->base.generate_cube_map_mipmaps = &generate_cube_map_mipmaps;
+	rd->base.bind_cube_map = &bind_cube_map;
+	rd->base.update_cube_map = &update_cube_map;
+
+	// Texture 2D array functions
+	rd->base.create_texture_2d_array = &create_texture_2d_array;
+	rd->base.destroy_texture_2d_array = &destroy_texture_2d_array;
+	rd->base.generate_texture_2d_array_mipmaps = &generate_texture_2d_array_mipmaps;
+	rd->base.bind_texture_2d_array = &bind_texture_2d_array;
+	rd->base.update_texture_2d_array = &update_texture_2d_array;
+
+	// Cube map array functions
+	rd->base.create_cube_map_array = &create_cube_map_array;
+	rd->base.destroy_cube_map_array = &destroy_cube_map_array;
+	rd->base.generate_cube_map_array_mipmaps = &generate_cube_map_array_mipmaps;
+	rd->base.bind_cube_map_array = &bind_cube_map_array;
+	rd->base.update_cube_map_array = &update_cube_map_array;
+
+	// Constant buffer functions
+	rd->base.create_constant_buffer = &create_constant_buffer;
+	rd->base.destroy_constant_buffer = &destroy_constant_buffer;
+	rd->base.bind_constant_buffer = &bind_constant_buffer;
+	rd->base.bind_constant_buffer_range = &bind_constant_buffer_range;
+	rd->base.map_constant_buffer = &map_constant_buffer;
+	rd->base.unmap_constant_buffer = &unmap_constant_buffer;
+	rd->base.map_constant_buffer_range = &map_constant_buffer_range;
+	rd->base.flush_constant_buffer_range = &flush_constant_buffer_range;
+	rd->base.update_constant_buffer = &update_constant_buffer;
+	rd->base.query_constant_buffer_structure = &query_constant_buffer_structure;
+
+	// Index buffer functions
+	rd->base.create_index_buffer = &create_index_buffer;
+	rd->base.destroy_index_buffer = &destroy_index_buffer;
+	rd->base.set_index_buffer = &set_index_buffer;
+	rd->base.map_index_buffer = &map_index_buffer;
+	rd->base.unmap_index_buffer = &unmap_index_buffer;
+	rd->base.map_index_buffer_range = &map_index_buffer_range;
+	rd->base.flush_index_buffer_range = &flush_index_buffer_range;
+	rd->base.update_index_buffer = &update_index_buffer;
+
+	// Indirect buffer functions
+	rd->base.create_indirect_buffer = &create_indirect_buffer;
+	rd->base.destroy_indirect_buffer = &destroy_indirect_buffer;
+	rd->base.update_indirect_buffer = &update_indirect_buffer;
+
+	// Vertex buffer functions
+	rd->base.create_vertex_buffer = &create_vertex_buffer;
+	rd->base.destroy_vertex_buffer = &destroy_vertex_buffer;
+	rd->base.map_vertex_buffer = &map_vertex_buffer;
+	rd->base.unmap_vertex_buffer = &unmap_vertex_buffer;
+	rd->base.map_vertex_buffer_range = &map_vertex_buffer_range;
+	rd->base.flush_vertex_buffer_range = &flush_vertex_buffer_range;
+	rd->base.update_vertex_buffer = &update_vertex_buffer;
+
+	// Vertex array functions
+	rd->base.create_vertex_array = &create_vertex_array;
+	rd->base.destroy_vertex_array = &destroy_vertex_array;
+	rd->base.set_vertex_array = &set_vertex_array;
+
+	// Stream allocator functions
+	rd->base.create_stream_allocator = &create_stream_allocator;
+	rd->base.destroy_stream_allocator = &destroy_stream_allocator;
+	rd->base.map_stream_allocation = &map_stream_allocation;
+	rd->base.unmap_stream_allocation = &unmap_stream_allocation;
+	rd->base.end_stream_allocator_frame = &end_stream_allocator_frame;
+
+	// Upload queue functions
+	rd->base.create_upload_queue = &create_upload_queue;
+	rd->base.destroy_upload_queue = &destroy_upload_queue;
+	rd->base.upload_texture_1d = &upload_texture_1d;
+	rd->base.upload_texture_2d = &upload_texture_2d;
+	rd->base.upload_texture_3d = &upload_texture_3d;
+	rd->base.upload_cube_map = &upload_cube_map;
+	rd->base.is_upload_complete = &is_upload_complete;
+	rd->base.wait_upload = &wait_upload;
+
+	// Shader functions
+	rd->base.create_shader_stage = &create_shader_stage;
+	rd->base.destroy_shader_stage = &destroy_shader_stage;
+	rd->base.create_shader_pipeline = &create_shader_pipeline;
+	rd->base.destroy_shader_pipeline = &destroy_shader_pipeline;
+	rd->base.set_shader_pipeline = &set_shader_pipeline;
+	rd->base.get_shader_binding_point = &get_shader_binding_point;
+	rd->base.get_shader_binding_point_by_id = &get_shader_binding_point_by_id;
+
+	// Draw functions
+	rd->base.clear_color = &clear_color;
+	rd->base.clear_depth = &clear_depth;
+	rd->base.clear_stencil = &clear_stencil;
+	rd->base.swap_buffers = &swap_buffers;
+	rd->base.draw_triangles = &draw_triangles;
+	rd->base.draw_triangles_indexed = &draw_triangles_indexed;
+	rd->base.draw_triangles_instanced = &draw_triangles_instanced;
+	rd->base.draw_triangles_indexed_instanced = &draw_triangles_indexed_instanced;
+	rd->base.draw_triangles_indexed_base_vertex = &draw_triangles_indexed_base_vertex;
+	rd->base.draw_triangles_indexed_instanced_base_vertex = &draw_triangles_indexed_instanced_base_vertex;
+	rd->base.multi_draw_triangles = &multi_draw_triangles;
+	rd->base.multi_draw_triangles_indexed = &multi_draw_triangles_indexed;
+	rd->base.draw_triangles_indirect = &draw_triangles_indirect;
+	rd->base.draw_triangles_indexed_indirect = &draw_triangles_indexed_indirect;
+	rd->base.set_viewport = &set_viewport;
+
+	// Getter functions
+	rd->base.get_type_name = &get_type_name;
+	rd->base.get_property_i = &get_property_i;
+	rd->base.get_property_f = &get_property_f;
+	rd->base.get_object_pool_stats = &get_object_pool_stats;
+}
+
+static void extract_hints(mrl_validation_render_device_t* rd, const mrl_render_device_desc_t* desc)
+{
+	for (const mrl_hint_t* hint = desc->hints; hint != NULL; hint = hint->next)
+	{
+		// Check if the hint should be skipped
+		if (hint->device_type != NULL && !mgl_str_equal(hint->device_type, u8"validation"))
+			continue;
+
+		// Extract hint info
+		switch (hint->type)
+		{
+			case MRL_HINT_RENDER_DEVICE_WARNING_CALLBACK:
+				MGL_DEBUG_ASSERT(hint->data != NULL);
+				rd->warning_callback = *(const mrl_render_device_hint_warning_callback_t*)hint->data;
+				break;
+
+			case MRL_HINT_RENDER_DEVICE_ERROR_CALLBACK:
+				MGL_DEBUG_ASSERT(hint->data != NULL);
+				rd->error_callback = *(const mrl_render_device_hint_error_callback_t*)hint->data;
+				break;
+
+			default:
+				// Unsupported hint type, ignore it
+				continue;
+		}
+	}
+}
+
+MRL_API mrl_error_t mrl_init_validation_render_device(const mrl_render_device_desc_t* desc, mrl_render_device_t* target, mrl_render_device_t** out_rd)
+{
+	MGL_DEBUG_ASSERT(desc != NULL && target != NULL && out_rd != NULL);
+	MGL_DEBUG_ASSERT(desc->allocator != NULL);
+
+	// Allocate render device
+	mrl_validation_render_device_t* rd;
+	mgl_error_t mglerr = mgl_allocate(desc->allocator, sizeof(mrl_validation_render_device_t), (void**)&rd);
+	if (mglerr != MGL_ERROR_NONE)
+		return mrl_make_mgl_error(mglerr);
+
+	rd->allocator = desc->allocator;
+	rd->target = target;
+	rd->state.shader_pipeline = NULL;
+	rd->state.vertex_array = NULL;
+	rd->state.index_buffer = NULL;
+	rd->state.mapped_buffer_count = 0;
+	rd->error_callback = NULL;
+	rd->warning_callback = NULL;
+
+	// Query limits
+	mgl_i64_t alignment = target->get_property_i(target, MRL_PROPERTY_CONSTANT_BUFFER_OFFSET_ALIGNMENT);
+	rd->limits.constant_buffer_offset_alignment = alignment < 1 ? 1 : (mgl_u64_t)alignment;
+
+	// Extract hints
+	extract_hints(rd, desc);
+
+	// Create allocators
+	mrl_error_t err = create_rd_allocators(rd, desc);
+	if (err != MRL_ERROR_NONE)
+	{
+		mgl_deallocate(rd->allocator, rd);
+		return err;
+	}
+
+	// Set render device funcs
+	set_rd_functions(rd);
+
+	*out_rd = (mrl_render_device_t*)rd;
+
+	return MRL_ERROR_NONE;
+}
+
+MRL_API void mrl_terminate_validation_render_device(mrl_render_device_t* brd)
+{
+	MGL_DEBUG_ASSERT(brd != NULL);
+	mrl_validation_render_device_t* rd = (mrl_validation_render_device_t*)brd;
+
+	// Report leaked objects
+	static const mgl_chr8_t* const leak_msgs[MRL_VALIDATION_OBJECT_POOL_COUNT] = {
+		u8"Render device terminated with framebuffers still alive",
+		u8"Render device terminated with raster states still alive",
+		u8"Render device terminated with depth stencil states still alive",
+		u8"Render device terminated with blend states still alive",
+		u8"Render device terminated with samplers still alive",
+		u8"Render device terminated with 1D textures still alive",
+		u8"Render device terminated with 2D textures still alive",
+		u8"Render device terminated with 3D textures still alive",
+		u8"Render device terminated with cube maps still alive",
+		u8"Render device terminated with constant buffers still alive",
+		u8"Render device terminated with index buffers still alive",
+		u8"Render device terminated with vertex buffers still alive",
+		u8"Render device terminated with vertex arrays still alive",
+		u8"Render device terminated with shader stages still alive",
+		u8"Render device terminated with shader pipelines still alive",
+		u8"Render device terminated with stream allocators still alive",
+		u8"Render device terminated with indirect buffers still alive",
+		u8"Render device terminated with upload queues still alive",
+		u8"Render device terminated with 2D texture arrays still alive",
+		u8"Render device terminated with cube map arrays still alive",
+	};
+	for (mgl_enum_t i = 0; i < MRL_VALIDATION_OBJECT_POOL_COUNT; ++i)
+		if (get_rd_pool(rd, i)->count > 0)
+			warn(rd, leak_msgs[i]);
+
+	// Destroy allocators
+	destroy_rd_allocators(rd);
+
+	// Deallocate
+	MGL_DEBUG_ASSERT(mgl_deallocate(rd->allocator, rd) == MRL_ERROR_NONE);
+}
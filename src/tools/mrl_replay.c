@@ -0,0 +1,173 @@
+#include <mrl/capture_render_device.h>
+#include <mrl/null_render_device.h>
+#ifdef MRL_BUILD_OGL_330
+#include <mrl/ogl_330_render_device.h>
+#endif
+#include <mgl/memory/allocator.h>
+#include <mgl/string/manipulation.h>
+#include <mgl/entry.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Replays a trace written by a capture render device and reports the time taken by each frame.
+// Usage: mrl_replay <trace> [device] [loop count]
+// The device may be 'ogl_330' or 'null' (default), and is always created headless.
+// The software device isn't offered, since it only runs native shaders, which can't be captured.
+
+struct
+{
+	struct timespec last;
+	mgl_f64_t min;
+	mgl_f64_t max;
+	mgl_f64_t total;
+	mgl_u64_t count;
+	mgl_bool_t verbose;
+} frames;
+
+static mgl_f64_t get_elapsed_ms(const struct timespec* from, const struct timespec* to)
+{
+	return (mgl_f64_t)(to->tv_sec - from->tv_sec) * 1000.0 + (mgl_f64_t)(to->tv_nsec - from->tv_nsec) / 1000000.0;
+}
+
+static void on_frame(void* user_data, mgl_u64_t frame)
+{
+	struct timespec now;
+	timespec_get(&now, TIME_UTC);
+	mgl_f64_t ms = get_elapsed_ms(&frames.last, &now);
+	frames.last = now;
+
+	if (frames.count == 0 || ms < frames.min)
+		frames.min = ms;
+	if (frames.count == 0 || ms > frames.max)
+		frames.max = ms;
+	frames.total += ms;
+	frames.count += 1;
+
+	if (frames.verbose)
+		printf("frame %llu: %.3f ms\n", (unsigned long long)frame, ms);
+}
+
+static void on_warning(mrl_error_t error, const mgl_chr8_t* msg)
+{
+	fprintf(stderr, "warning: %s\n", (const char*)msg);
+}
+
+static mgl_u8_t* read_trace(const char* path, mgl_u64_t* size)
+{
+	FILE* file = fopen(path, "rb");
+	if (file == NULL)
+		return NULL;
+
+	fseek(file, 0, SEEK_END);
+	long file_size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	// malloc returns memory aligned for any type, so the trace can be read in place
+	mgl_u8_t* data = file_size > 0 ? (mgl_u8_t*)malloc((size_t)file_size) : NULL;
+	if (data != NULL && fread(data, 1, (size_t)file_size, file) != (size_t)file_size)
+	{
+		free(data);
+		data = NULL;
+	}
+
+	fclose(file);
+	*size = (mgl_u64_t)file_size;
+	return data;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		fprintf(stderr, "usage: %s <trace> [ogl_330|null] [loop count]\n", argv[0]);
+		return 1;
+	}
+
+	const char* device = argc >= 3 ? argv[2] : "null";
+	int loops = argc >= 4 ? atoi(argv[3]) : 1;
+	if (loops < 1)
+		loops = 1;
+
+	mgl_u64_t size;
+	mgl_u8_t* trace = read_trace(argv[1], &size);
+	if (trace == NULL)
+	{
+		fprintf(stderr, "failed to read trace '%s'\n", argv[1]);
+		return 1;
+	}
+
+	if (mgl_init() != MGL_ERROR_NONE)
+	{
+		fprintf(stderr, "mgl_init() failed\n");
+		free(trace);
+		return 1;
+	}
+
+	// Create render device
+	mrl_render_device_hint_warning_callback_t warning_callback = &on_warning;
+	mrl_hint_t hint = MRL_DEFAULT_HINT;
+	hint.type = MRL_HINT_RENDER_DEVICE_WARNING_CALLBACK;
+	hint.data = &warning_callback;
+
+	mrl_render_device_desc_t desc = MRL_DEFAULT_RENDER_DEVICE_DESC;
+	desc.allocator = mgl_standard_allocator;
+	desc.window = NULL;
+	desc.hints = &hint;
+
+	mrl_render_device_t* rd = NULL;
+	mrl_error_t err = MRL_ERROR_UNSUPPORTED_DEVICE;
+	void(*terminate)(mrl_render_device_t*) = NULL;
+	if (mgl_str_equal((const mgl_chr8_t*)device, u8"null"))
+	{
+		err = mrl_init_null_render_device(&desc, &rd);
+		terminate = &mrl_terminate_null_render_device;
+	}
+#ifdef MRL_BUILD_OGL_330
+	else if (mgl_str_equal((const mgl_chr8_t*)device, u8"ogl_330"))
+	{
+		err = mrl_init_ogl_330_render_device(&desc, &rd);
+		terminate = &mrl_terminate_ogl_330_render_device;
+	}
+#endif
+
+	if (err != MRL_ERROR_NONE)
+	{
+		fprintf(stderr, "failed to create '%s' render device: %s\n", device, (const char*)mrl_get_error_string(err));
+		mgl_terminate();
+		free(trace);
+		return 1;
+	}
+
+	// Replay
+	mrl_replay_desc_t replay_desc = MRL_DEFAULT_REPLAY_DESC;
+	replay_desc.allocator = mgl_standard_allocator;
+	replay_desc.frame_callback = &on_frame;
+	replay_desc.warning_callback = &on_warning;
+
+	frames.verbose = loops == 1;
+	struct timespec begin;
+	timespec_get(&begin, TIME_UTC);
+	for (int i = 0; i < loops && err == MRL_ERROR_NONE; ++i)
+	{
+		timespec_get(&frames.last, TIME_UTC);
+		err = mrl_replay_trace(rd, trace, size, &replay_desc);
+	}
+	struct timespec end;
+	timespec_get(&end, TIME_UTC);
+
+	if (err != MRL_ERROR_NONE)
+		fprintf(stderr, "failed to replay trace: %s\n", (const char*)mrl_get_error_string(err));
+
+	printf("device: %s\n", (const char*)rd->get_type_name(rd));
+	printf("frames: %llu\n", (unsigned long long)frames.count);
+	printf("total: %.3f ms\n", get_elapsed_ms(&begin, &end));
+	if (frames.count > 0)
+		printf("frame time: avg %.3f ms, min %.3f ms, max %.3f ms\n", frames.total / (mgl_f64_t)frames.count, frames.min, frames.max);
+
+	terminate(rd);
+	mgl_terminate();
+	free(trace);
+	return err == MRL_ERROR_NONE ? 0 : 1;
+}